@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// This sketch runs random states, round counts, and messages through the
+// back end for this board and compares them against a plain reference
+// implementation of the permutation.  The multi-state permutations and
+// the batch kernels are also checked.  The same checks can be run on a
+// host system with "ascon-conformance" for each back end.
+
+#include "ascon-conformance.h"
+
+#define ITERATIONS 200
+
+conformance_results_t results;
+uint32_t seed;
+
+static void report(const char *name, unsigned long failures)
+{
+    Serial.print(name);
+    Serial.print(" ... ");
+    if (failures) {
+        Serial.print("failed (");
+        Serial.print(failures);
+        Serial.println(")");
+    } else {
+        Serial.println("ok");
+    }
+}
+
+void setup()
+{
+    Serial.begin(9600);
+    Serial.println();
+
+    Serial.print("Back end: ");
+    Serial.println(ascon_backend_name());
+    // Vary the seed between runs; print it so that failures can be
+    // reproduced on the host with "ascon-conformance 200 <seed>".
+    seed = micros() | 1;
+    Serial.print("Running ");
+    Serial.print(ITERATIONS);
+    Serial.print(" iterations with seed ");
+    Serial.print(seed);
+    Serial.println(" ...");
+
+    conformance_run(ITERATIONS, seed, &results);
+
+    report("Permutation", results.permute);
+    report("Add Bytes", results.bytes);
+    report("Permutation x2", results.x2);
+    report("Permutation x4", results.x4);
+    report("Permutation x8", results.x8);
+    report("ASCON-HASH Many", results.hash_many);
+    report("ASCON-HASHA Many", results.hasha_many);
+    report("ASCON-128a Batch", results.aead_batch);
+    report("SP 800-232 Modes", results.sp800_232);
+
+    Serial.println();
+    if (conformance_failures(&results))
+        Serial.println("FAILED");
+    else
+        Serial.println("All tests passed");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_CONFORMANCE_H
+#define ASCON_CONFORMANCE_H
+
+/* Differential conformance harness for the ASCON back ends.
+ *
+ * Random states, round counts, and inputs are run through the back end
+ * that the library was compiled with and compared against a plain
+ * reference implementation of the permutation from the specification.
+ * The multi-state permutations and the batch hash and AEAD kernels are
+ * also checked against the reference or the single-message functions.
+ * The NIST SP 800-232 modes are checked against a reference of the
+ * standardized sponge and known answers from the standard.
+ *
+ * This file is shared by the "Backend_Conformance" sketch, which runs the
+ * harness on the device, and by "host/ascon-conformance.c", which is built
+ * once for each back end that can be forced on the host. */
+
+#include <ASCON.h>
+#include <string.h>
+
+#define CONF_MAX_MSG    48
+#define CONF_MAX_BATCH  4
+
+/* Results of a conformance run, as the number of failures per check */
+typedef struct
+{
+    unsigned long permute;
+    unsigned long x2;
+    unsigned long x4;
+    unsigned long x8;
+    unsigned long bytes;
+    unsigned long hash_many;
+    unsigned long hasha_many;
+    unsigned long aead_batch;
+    unsigned long sp800_232;
+
+} conformance_results_t;
+
+static uint32_t conf_rng;
+
+static uint32_t conf_random(void)
+{
+    /* xorshift32, which is good enough to generate test inputs */
+    conf_rng ^= conf_rng << 13;
+    conf_rng ^= conf_rng >> 17;
+    conf_rng ^= conf_rng << 5;
+    return conf_rng;
+}
+
+static void conf_random_bytes(unsigned char *buf, unsigned len)
+{
+    while (len > 0) {
+        *buf++ = (unsigned char)(conf_random() >> 24);
+        --len;
+    }
+}
+
+/* Reference permutation on the canonical 40-byte form of the state */
+
+#define CONF_ROR(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static void conf_ref_permute(unsigned char s[40], uint8_t first_round)
+{
+    uint64_t x[5], t[5];
+    unsigned i, j;
+    for (i = 0; i < 5; ++i) {
+        x[i] = 0;
+        for (j = 0; j < 8; ++j)
+            x[i] = (x[i] << 8) | s[i * 8 + j];
+    }
+    for (i = first_round; i < 12; ++i) {
+        x[2] ^= (uint64_t)(((0x0F - i) << 4) | i);
+        x[0] ^= x[4];
+        x[4] ^= x[3];
+        x[2] ^= x[1];
+        for (j = 0; j < 5; ++j)
+            t[j] = x[j] ^ (~x[(j + 1) % 5] & x[(j + 2) % 5]);
+        t[1] ^= t[0];
+        t[0] ^= t[4];
+        t[3] ^= t[2];
+        t[2] = ~t[2];
+        x[0] = t[0] ^ CONF_ROR(t[0], 19) ^ CONF_ROR(t[0], 28);
+        x[1] = t[1] ^ CONF_ROR(t[1], 61) ^ CONF_ROR(t[1], 39);
+        x[2] = t[2] ^ CONF_ROR(t[2], 1)  ^ CONF_ROR(t[2], 6);
+        x[3] = t[3] ^ CONF_ROR(t[3], 10) ^ CONF_ROR(t[3], 17);
+        x[4] = t[4] ^ CONF_ROR(t[4], 7)  ^ CONF_ROR(t[4], 41);
+    }
+    for (i = 0; i < 5; ++i) {
+        for (j = 0; j < 8; ++j)
+            s[i * 8 + j] = (unsigned char)(x[i] >> (56 - j * 8));
+    }
+}
+
+/* Reference ASCON-HASH (rounds == 0) or ASCON-HASHA (rounds == 4) */
+static void conf_ref_hash
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     uint8_t rounds)
+{
+    unsigned char s[40];
+    unsigned i;
+    memset(s, 0, sizeof(s));
+    s[1] = 0x40;
+    s[2] = 0x0C;
+    s[3] = rounds;
+    s[6] = 0x01;
+    conf_ref_permute(s, 0);
+    while (inlen >= 8) {
+        for (i = 0; i < 8; ++i)
+            s[i] ^= in[i];
+        conf_ref_permute(s, rounds);
+        in += 8;
+        inlen -= 8;
+    }
+    for (i = 0; i < inlen; ++i)
+        s[i] ^= in[i];
+    s[inlen] ^= 0x80;
+    conf_ref_permute(s, 0);
+    for (i = 0; i < ASCON_HASH_SIZE; i += 8) {
+        if (i)
+            conf_ref_permute(s, rounds);
+        memcpy(out + i, s, 8);
+    }
+}
+
+/* Initialization vectors for Ascon-Hash256 and Ascon-XOF128 */
+static unsigned char const conf_iv_hash256[8] =
+    {0x00, 0x00, 0x08, 0x01, 0x00, 0xcc, 0x00, 0x02};
+static unsigned char const conf_iv_xof128[8] =
+    {0x00, 0x00, 0x08, 0x00, 0x00, 0xcc, 0x00, 0x03};
+
+/* Reference Ascon-Hash256 or Ascon-XOF128, which load the data in
+ * little-endian byte order, on the canonical form of the state */
+static void conf_ref_xof128
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen, const unsigned char iv[8])
+{
+    unsigned char s[40];
+    size_t posn;
+    memset(s, 0, sizeof(s));
+    memcpy(s, iv, 8);
+    conf_ref_permute(s, 0);
+    for (posn = 0; posn < inlen; ++posn) {
+        s[7 - (posn % 8)] ^= in[posn];
+        if ((posn % 8) == 7)
+            conf_ref_permute(s, 0);
+    }
+    s[7 - (inlen % 8)] ^= 0x01;
+    for (posn = 0; posn < outlen; ++posn) {
+        if ((posn % 8) == 0)
+            conf_ref_permute(s, 0);
+        out[posn] = s[7 - (posn % 8)];
+    }
+}
+
+/* Known answers for the NIST SP 800-232 modes with empty inputs, and
+ * with a key and nonce of 000102...0F for Ascon-AEAD128 */
+static unsigned char const conf_kat_hash256[32] = {
+    0x0b, 0x3b, 0xe5, 0x85, 0x0f, 0x2f, 0x6b, 0x98,
+    0xca, 0xf2, 0x9f, 0x8f, 0xde, 0xa8, 0x9b, 0x64,
+    0xa1, 0xfa, 0x70, 0xaa, 0x24, 0x9b, 0x8f, 0x83,
+    0x9b, 0xd5, 0x3b, 0xaa, 0x30, 0x4d, 0x92, 0xb2
+};
+static unsigned char const conf_kat_xof128[32] = {
+    0x47, 0x3d, 0x5e, 0x61, 0x64, 0xf5, 0x8b, 0x39,
+    0xdf, 0xd8, 0x4a, 0xac, 0xdb, 0x8a, 0xe4, 0x2e,
+    0xc2, 0xd9, 0x1f, 0xed, 0x33, 0x38, 0x8e, 0xe0,
+    0xd9, 0x60, 0xd9, 0xb3, 0x99, 0x32, 0x95, 0xc6
+};
+static unsigned char const conf_kat_cxof128[32] = {
+    0x4f, 0x50, 0x15, 0x9e, 0xf7, 0x0b, 0xb3, 0xda,
+    0xd8, 0x80, 0x7e, 0x03, 0x4e, 0xae, 0xbd, 0x44,
+    0xc4, 0xfa, 0x2c, 0xbb, 0xc8, 0xcf, 0x1f, 0x05,
+    0x51, 0x1a, 0xb6, 0x6c, 0xdc, 0xc5, 0x29, 0x90
+};
+static unsigned char const conf_kat_aead128[16] = {
+    0x44, 0x27, 0xd6, 0x4b, 0x8e, 0x1e, 0x14, 0x51,
+    0xfc, 0x44, 0x59, 0x60, 0xf0, 0x83, 0x9b, 0xb0
+};
+
+/* Checks the NIST SP 800-232 modes against the known answers */
+static int conf_check_sp800_232_kats(void)
+{
+    unsigned char out[32];
+    unsigned char key[16];
+    size_t len;
+    unsigned i;
+    int failed = 0;
+    for (i = 0; i < 16; ++i)
+        key[i] = (unsigned char)i;
+    ascon_hash256(out, 0, 0);
+    failed |= memcmp(out, conf_kat_hash256, 32) != 0;
+    ascon_xof128(out, 32, 0, 0);
+    failed |= memcmp(out, conf_kat_xof128, 32) != 0;
+    ascon_cxof128(out, 32, 0, 0, 0, 0);
+    failed |= memcmp(out, conf_kat_cxof128, 32) != 0;
+    ascon_aead128_encrypt(out, &len, 0, 0, 0, 0, key, key);
+    failed |= len != 16 || memcmp(out, conf_kat_aead128, 16) != 0;
+    return failed;
+}
+
+/* Loads a canonical state into an acquired back end state */
+static void conf_load(ascon_state_t *state, const unsigned char s[40])
+{
+    ascon_overwrite_bytes(state, s, 0, 40);
+}
+
+/* Compares an acquired back end state against a canonical state */
+static int conf_compare(ascon_state_t *state, const unsigned char s[40])
+{
+    unsigned char actual[40];
+    ascon_extract_bytes(state, actual, 0, 40);
+    return memcmp(actual, s, 40) != 0;
+}
+
+/* Permutes "count" random states with one of the multi-state functions
+ * and returns non-zero if any of them differ from the reference */
+static int conf_check_multi(unsigned count)
+{
+    static unsigned char expected[8][40];
+    ascon_state_t states[8];
+    ascon_state_t *ptrs[8];
+    uint8_t first_round = (uint8_t)(conf_random() % 12);
+    unsigned i;
+    int failed = 0;
+    for (i = 0; i < count; ++i) {
+        ascon_init(&(states[i]));
+        ptrs[i] = &(states[i]);
+        conf_random_bytes(expected[i], 40);
+        conf_load(&(states[i]), expected[i]);
+        conf_ref_permute(expected[i], first_round);
+    }
+    if (count == 2)
+        ascon_permute_x2(ptrs[0], ptrs[1], first_round);
+    else if (count == 4)
+        ascon_permute_x4(ptrs[0], ptrs[1], ptrs[2], ptrs[3], first_round);
+    else
+        ascon_permute_x8(ptrs, first_round);
+    for (i = 0; i < count; ++i) {
+        failed |= conf_compare(&(states[i]), expected[i]);
+        ascon_free(&(states[i]));
+    }
+    return failed;
+}
+
+/* Runs "iterations" rounds of random tests starting from "seed" */
+static void conformance_run
+    (unsigned long iterations, uint32_t seed, conformance_results_t *results)
+{
+    static unsigned char msgs[CONF_MAX_BATCH][CONF_MAX_MSG];
+    static unsigned char outs[CONF_MAX_BATCH][CONF_MAX_MSG + 16];
+    static unsigned char hashes[CONF_MAX_BATCH * ASCON_HASH_SIZE];
+    static unsigned char key[16], nonce[16];
+    const unsigned char *ptrs[CONF_MAX_BATCH];
+    size_t lens[CONF_MAX_BATCH];
+    ascon_aead_batch_t batch[CONF_MAX_BATCH];
+    unsigned char expected[40];
+    unsigned char data[40];
+    unsigned char single[CONF_MAX_MSG + 16];
+    ascon_state_t state;
+    unsigned long iter;
+    unsigned i, offset, len, count;
+    uint8_t first_round;
+    size_t clen;
+
+    memset(results, 0, sizeof(conformance_results_t));
+    conf_rng = seed ? seed : 1;
+    if (conf_check_sp800_232_kats())
+        ++(results->sp800_232);
+    for (iter = 0; iter < iterations; ++iter) {
+        /* Single permutation with a random number of rounds */
+        first_round = (uint8_t)(conf_random() % 12);
+        conf_random_bytes(expected, 40);
+        ascon_init(&state);
+        conf_load(&state, expected);
+        ascon_permute(&state, first_round);
+        conf_ref_permute(expected, first_round);
+        if (conf_compare(&state, expected))
+            ++(results->permute);
+
+        /* Add bytes at a random offset and check the state */
+        offset = conf_random() % 40;
+        len = conf_random() % (41 - offset);
+        conf_random_bytes(data, len);
+        ascon_add_bytes(&state, data, offset, len);
+        for (i = 0; i < len; ++i)
+            expected[offset + i] ^= data[i];
+        if (conf_compare(&state, expected))
+            ++(results->bytes);
+        ascon_free(&state);
+
+        /* Multi-state permutations */
+        if (conf_check_multi(2))
+            ++(results->x2);
+        if (conf_check_multi(4))
+            ++(results->x4);
+        if (conf_check_multi(8))
+            ++(results->x8);
+
+        /* Batch hashing of messages with different lengths */
+        count = 1 + conf_random() % CONF_MAX_BATCH;
+        for (i = 0; i < count; ++i) {
+            lens[i] = conf_random() % (CONF_MAX_MSG + 1);
+            conf_random_bytes(msgs[i], (unsigned)(lens[i]));
+            ptrs[i] = msgs[i];
+        }
+        ascon_hash_many(hashes, ptrs, lens, count);
+        for (i = 0; i < count; ++i) {
+            conf_ref_hash(single, msgs[i], lens[i], 0);
+            if (memcmp(single, hashes + i * ASCON_HASH_SIZE,
+                       ASCON_HASH_SIZE) != 0) {
+                ++(results->hash_many);
+                break;
+            }
+        }
+        ascon_hasha_many(hashes, ptrs, lens, count);
+        for (i = 0; i < count; ++i) {
+            conf_ref_hash(single, msgs[i], lens[i], 4);
+            if (memcmp(single, hashes + i * ASCON_HASHA_SIZE,
+                       ASCON_HASHA_SIZE) != 0) {
+                ++(results->hasha_many);
+                break;
+            }
+        }
+
+        /* Batch AEAD against the single-message function, which has
+         * already been checked against the reference permutation */
+        conf_random_bytes(key, sizeof(key));
+        conf_random_bytes(nonce, sizeof(nonce));
+        for (i = 0; i < count; ++i) {
+            batch[i].out = outs[i];
+            batch[i].in = msgs[i];
+            batch[i].inlen = lens[i];
+            batch[i].ad = msgs[(i + 1) % count];
+            batch[i].adlen = lens[(i + 1) % count];
+            batch[i].npub = nonce;
+            batch[i].k = key;
+        }
+        ascon128a_aead_encrypt_batch(batch, count);
+        for (i = 0; i < count; ++i) {
+            ascon128a_aead_encrypt
+                (single, &clen, batch[i].in, batch[i].inlen,
+                 batch[i].ad, batch[i].adlen, nonce, key);
+            if (clen != batch[i].outlen ||
+                    memcmp(single, outs[i], clen) != 0) {
+                ++(results->aead_batch);
+                break;
+            }
+        }
+
+        /* NIST SP 800-232 modes against the reference sponge, and an
+         * Ascon-AEAD128 round trip with random lengths */
+        len = (unsigned)(lens[0] % 33);
+        ascon_hash256(hashes, msgs[0], lens[0]);
+        conf_ref_xof128
+            (single, ASCON_HASH256_SIZE, msgs[0], lens[0], conf_iv_hash256);
+        if (memcmp(single, hashes, ASCON_HASH256_SIZE) != 0)
+            ++(results->sp800_232);
+        ascon_xof128(hashes, len, msgs[0], lens[0]);
+        conf_ref_xof128(single, len, msgs[0], lens[0], conf_iv_xof128);
+        if (memcmp(single, hashes, len) != 0)
+            ++(results->sp800_232);
+        ascon_aead128_encrypt
+            (outs[0], &clen, msgs[0], lens[0], msgs[1], len, nonce, key);
+        if (ascon_aead128_decrypt
+                (single, &clen, outs[0], clen, msgs[1], len,
+                 nonce, key) != 0 ||
+                clen != lens[0] || memcmp(single, msgs[0], clen) != 0)
+            ++(results->sp800_232);
+    }
+}
+
+/* Returns the total number of failures in a set of results */
+static unsigned long conformance_failures(const conformance_results_t *results)
+{
+    return results->permute + results->x2 + results->x4 + results->x8 +
+           results->bytes + results->hash_many + results->hasha_many +
+           results->aead_batch + results->sp800_232;
+}
+
+#endif
@@ -0,0 +1,632 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// This sketch runs a structured benchmark of the ASCON primitives across
+// a range of message sizes and prints the results in CSV form:
+//
+//      mode,primitive,bytes,loops,unit,per_op,per_byte
+//
+// The unit is "cycles" on platforms with a cycle counter (Cortex-M3 and
+// higher via the DWT, Xtensa via CCOUNT, x86 via the TSC), "ns" on other
+// hosts with clock_gettime(), and "us" everywhere else.
+//
+// The first line of output describes the build profile that was selected
+// in "ascon-config.h" so that results from different profiles can be
+// compared side by side.  Code size for each profile is reported by the
+// build tools at the end of compilation rather than by the sketch.
+//
+// To measure the effect of running the hot kernels from RAM instead of
+// flash, run the sketch once with and once without ASCON_FAST_RAM defined
+// in "ascon-config.h".  The profile line ends in ",ram" when the kernels
+// were placed in RAM.
+//
+// Uncomment BENCH_STACK below to measure the stack high-water mark of
+// each primitive instead of its speed.  The results are printed as:
+//
+//      mode,primitive,bytes,stack_bytes
+//
+// where the mode is always "stack".
+// The measurement paints a region of the stack with a known pattern,
+// runs the primitive once, and then counts how much of the pattern was
+// overwritten.  The figure includes the small wrapper function that calls
+// the primitive, so it is a slight over-estimate of the library's usage.
+
+//#define BENCH_STACK 1
+
+// Uncomment BENCH_CALIBRATE below to time the permutation kernels at
+// startup with ascon_backend_calibrate() and bind the fastest ones before
+// the benchmarks are run.  The measurements are printed as:
+//
+//      mode,kernel,permutations,us,selected
+//
+// where the mode is always "calibrate".
+//#define BENCH_CALIBRATE 1
+
+// Uncomment BENCH_COMPARE below to add ChaCha20-Poly1305 and AES-128-GCM
+// to the benchmarks, with the same message sizes and output format, so
+// that ASCON can be compared with the usual alternatives on the same
+// board.  The software versions come from the "Crypto" library in
+// https://github.com/rweather/arduinolibs, which must be installed.
+// On ESP32, AES-128-GCM is also measured through mbedTLS, which uses the
+// AES accelerator in the chip.  Other boards with AES hardware, such as
+// the SAMD51, do not expose it through their Arduino core, so only the
+// software versions are measured there.  The mode for these rows is
+// "compare".
+//#define BENCH_COMPARE 1
+
+#include <ASCON.h>
+#include <string.h>
+#if defined(BENCH_COMPARE)
+#include <Crypto.h>
+#include <ChaChaPoly.h>
+#include <AES.h>
+#include <GCM.h>
+#if defined(ESP32)
+#include "mbedtls/gcm.h"
+#define BENCH_COMPARE_HW_AES 1
+#endif
+#endif
+
+#if defined(ESP8266)
+extern "C" void system_soft_wdt_feed(void);
+#define crypto_feed_watchdog() system_soft_wdt_feed()
+#else
+#define crypto_feed_watchdog() do { ; } while (0)
+#endif
+
+// Select the cycle counter for the platform.
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__)
+#define BENCH_UNIT "cycles"
+#define BENCH_DEMCR      (*((volatile uint32_t *)0xE000EDFCU))
+#define BENCH_DWT_CTRL   (*((volatile uint32_t *)0xE0001000U))
+#define BENCH_DWT_CYCCNT (*((volatile uint32_t *)0xE0001004U))
+typedef uint32_t bench_counter_t;
+static void bench_counter_init()
+{
+    BENCH_DEMCR |= 0x01000000U;     // Enable the trace unit.
+    BENCH_DWT_CYCCNT = 0;
+    BENCH_DWT_CTRL |= 0x00000001U;  // Enable the cycle counter.
+}
+static inline bench_counter_t bench_counter()
+{
+    return BENCH_DWT_CYCCNT;
+}
+#elif defined(__XTENSA__)
+#define BENCH_UNIT "cycles"
+typedef uint32_t bench_counter_t;
+static void bench_counter_init() {}
+static inline bench_counter_t bench_counter()
+{
+    uint32_t count;
+    __asm__ __volatile__ ("rsr %0, ccount" : "=a"(count));
+    return count;
+}
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+typedef uint64_t bench_counter_t;
+static void bench_counter_init() {}
+static inline bench_counter_t bench_counter()
+{
+    return __rdtsc();
+}
+#elif defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#define BENCH_UNIT "ns"
+typedef uint64_t bench_counter_t;
+static void bench_counter_init() {}
+static inline bench_counter_t bench_counter()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+#else
+#define BENCH_UNIT "us"
+typedef unsigned long bench_counter_t;
+static void bench_counter_init() {}
+static inline bench_counter_t bench_counter()
+{
+    return micros();
+}
+#endif
+
+// Largest message size to test, limited by the RAM on the device.
+#if defined(ARDUINO_AVR_UNO)
+#define BENCH_MAX_SIZE 128
+#elif defined(__AVR__)
+#define BENCH_MAX_SIZE 256
+#elif defined(ESP8266) || (defined(ARDUINO_ARCH_SAMD) && !defined(__SAMD51__))
+#define BENCH_MAX_SIZE 4096
+#else
+#define BENCH_MAX_SIZE 16384
+#endif
+
+// Minimum time to run each measurement for, in milliseconds.
+#define BENCH_TIME_MS 200
+
+// Maximum number of loops for a measurement, to avoid counter wrap-around.
+#define BENCH_MAX_LOOPS 65536UL
+
+#define BENCH_TAG_SIZE 16
+
+// Size of the stack region to paint when measuring the stack usage.
+#if defined(__AVR__)
+#define BENCH_STACK_SIZE 768
+#else
+#define BENCH_STACK_SIZE 4096
+#endif
+
+// Pattern that is used to paint the stack.
+#define BENCH_STACK_PATTERN 0xA5
+
+// Size of the message to use when measuring the stack usage.
+#define BENCH_STACK_MSG_SIZE 64
+
+static size_t const bench_sizes[] = {
+    0, 16, 64, 256, 1024, 4096, 16384
+};
+
+static unsigned char const key[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+static unsigned char const nonce[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+static unsigned char input[BENCH_MAX_SIZE];
+static unsigned char output[BENCH_MAX_SIZE + BENCH_TAG_SIZE];
+static unsigned char cipher[BENCH_MAX_SIZE + BENCH_TAG_SIZE];
+static size_t cipher_len;
+
+static ascon_state_t perm_state;
+#if ASCON_ENABLE_ISAP
+static ascon128_isap_aead_key_t isap128_key;
+static ascon128a_isap_aead_key_t isap128a_key;
+#endif
+#if ASCON_ENABLE_MASKING
+static ascon_masked_key_128_t masked128_key;
+static ascon_masked_key_160_t masked160_key;
+#endif
+
+// Information about a primitive to be benchmarked.  The "prepare"
+// function is called once for each size before the timing starts.
+typedef struct
+{
+    const char *mode;
+    const char *name;
+    void (*prepare)(size_t size);
+    void (*run)(size_t size);
+    size_t max_size;
+
+} BenchInfo;
+
+// Defines the wrappers for an AEAD mode with encryption and decryption.
+#define BENCH_AEAD(name, encrypt, decrypt, k) \
+    static void name##_encrypt(size_t size) \
+    { \
+        size_t len; \
+        encrypt(output, &len, input, size, 0, 0, nonce, (k)); \
+    } \
+    static void name##_prepare(size_t size) \
+    { \
+        encrypt(cipher, &cipher_len, input, size, 0, 0, nonce, (k)); \
+    } \
+    static void name##_decrypt(size_t size) \
+    { \
+        size_t len; \
+        decrypt(output, &len, cipher, cipher_len, 0, 0, nonce, (k)); \
+    }
+
+#if defined(BENCH_COMPARE)
+
+// Size of the nonce for the comparison ciphers.
+#define BENCH_COMPARE_NONCE_SIZE 12
+
+// Defines the wrappers for an authenticated cipher from the Crypto library.
+// The key is set up on every call, as for the one-shot ASCON functions.
+#define BENCH_AUTH_CIPHER(name, type, key_size) \
+    static type name##_cipher; \
+    static void name##_encrypt(size_t size) \
+    { \
+        name##_cipher.setKey(key, (key_size)); \
+        name##_cipher.setIV(nonce, BENCH_COMPARE_NONCE_SIZE); \
+        name##_cipher.encrypt(output, input, size); \
+        name##_cipher.computeTag(output + size, BENCH_TAG_SIZE); \
+    } \
+    static void name##_prepare(size_t size) \
+    { \
+        name##_encrypt(size); \
+        cipher_len = size + BENCH_TAG_SIZE; \
+        memcpy(cipher, output, cipher_len); \
+    } \
+    static void name##_decrypt(size_t size) \
+    { \
+        name##_cipher.setKey(key, (key_size)); \
+        name##_cipher.setIV(nonce, BENCH_COMPARE_NONCE_SIZE); \
+        name##_cipher.decrypt(output, cipher, size); \
+        name##_cipher.checkTag(cipher + size, BENCH_TAG_SIZE); \
+    }
+
+BENCH_AUTH_CIPHER(chachapoly, ChaChaPoly, 32)
+BENCH_AUTH_CIPHER(aesgcm, GCM<AES128>, 16)
+
+#if defined(BENCH_COMPARE_HW_AES)
+
+static mbedtls_gcm_context hwgcm_context;
+
+static void hwgcm_encrypt(size_t size)
+{
+    mbedtls_gcm_setkey(&hwgcm_context, MBEDTLS_CIPHER_ID_AES, key, 128);
+    mbedtls_gcm_crypt_and_tag
+        (&hwgcm_context, MBEDTLS_GCM_ENCRYPT, size,
+         nonce, BENCH_COMPARE_NONCE_SIZE, 0, 0, input, output,
+         BENCH_TAG_SIZE, output + size);
+}
+
+static void hwgcm_prepare(size_t size)
+{
+    hwgcm_encrypt(size);
+    cipher_len = size + BENCH_TAG_SIZE;
+    memcpy(cipher, output, cipher_len);
+}
+
+static void hwgcm_decrypt(size_t size)
+{
+    mbedtls_gcm_setkey(&hwgcm_context, MBEDTLS_CIPHER_ID_AES, key, 128);
+    mbedtls_gcm_auth_decrypt
+        (&hwgcm_context, size, nonce, BENCH_COMPARE_NONCE_SIZE, 0, 0,
+         cipher + size, BENCH_TAG_SIZE, cipher, output);
+}
+
+#endif
+
+#endif
+
+// Permutation timings are reported per call, independent of the size.
+static void permute12_run(size_t size) { ascon_permute(&perm_state, 0); }
+static void permute8_run(size_t size) { ascon_permute(&perm_state, 4); }
+static void permute6_run(size_t size) { ascon_permute(&perm_state, 6); }
+
+#if ASCON_ENABLE_AEAD
+BENCH_AEAD(aead128, ascon128_aead_encrypt, ascon128_aead_decrypt, key)
+BENCH_AEAD(aead128a, ascon128a_aead_encrypt, ascon128a_aead_decrypt, key)
+BENCH_AEAD(aead80pq, ascon80pq_aead_encrypt, ascon80pq_aead_decrypt, key)
+BENCH_AEAD(siv128, ascon128_siv_encrypt, ascon128_siv_decrypt, key)
+BENCH_AEAD(siv128a, ascon128a_siv_encrypt, ascon128a_siv_decrypt, key)
+BENCH_AEAD(siv80pq, ascon80pq_siv_encrypt, ascon80pq_siv_decrypt, key)
+#endif
+#if ASCON_ENABLE_ISAP
+BENCH_AEAD(isap128, ascon128_isap_aead_encrypt,
+           ascon128_isap_aead_decrypt, &isap128_key)
+BENCH_AEAD(isap128a, ascon128a_isap_aead_encrypt,
+           ascon128a_isap_aead_decrypt, &isap128a_key)
+#endif
+#if ASCON_ENABLE_MASKING
+BENCH_AEAD(masked128, ascon128_masked_aead_encrypt,
+           ascon128_masked_aead_decrypt, &masked128_key)
+BENCH_AEAD(masked128a, ascon128a_masked_aead_encrypt,
+           ascon128a_masked_aead_decrypt, &masked128_key)
+BENCH_AEAD(masked80pq, ascon80pq_masked_aead_encrypt,
+           ascon80pq_masked_aead_decrypt, &masked160_key)
+#endif
+
+#if ASCON_ENABLE_HASH
+static void hash_run(size_t size) { ascon_hash(output, input, size); }
+static void hasha_run(size_t size) { ascon_hasha(output, input, size); }
+static void xof_run(size_t size) { ascon_xof(output, input, size); }
+static void xofa_run(size_t size) { ascon_xofa(output, input, size); }
+
+static void kmac_run(size_t size)
+{
+    ascon_kmac(key, 16, input, size, 0, 0, output, ASCON_KMAC_SIZE);
+}
+
+static void kmaca_run(size_t size)
+{
+    ascon_kmaca(key, 16, input, size, 0, 0, output, ASCON_KMAC_SIZE);
+}
+
+static void hmac_run(size_t size)
+{
+    ascon_hmac(output, key, 16, input, size);
+}
+
+static void hmaca_run(size_t size)
+{
+    ascon_hmaca(output, key, 16, input, size);
+}
+
+static void prf_run(size_t size)
+{
+    ascon_prf(output, 16, input, size, key);
+}
+
+static void mac_run(size_t size)
+{
+    ascon_mac(output, input, size, key);
+}
+
+// PBKDF2 is measured by output size with a fixed password and salt.
+static void pbkdf2_run(size_t size)
+{
+    ascon_pbkdf2(output, size, key, 16, nonce, 16, 16);
+}
+#endif
+
+static BenchInfo const benchmarks[] = {
+    {"permute", "ASCON-p12", 0, permute12_run, 0},
+    {"permute", "ASCON-p8",  0, permute8_run, 0},
+    {"permute", "ASCON-p6",  0, permute6_run, 0},
+#if ASCON_ENABLE_AEAD
+    {"aead",   "ASCON-128-encrypt",  0, aead128_encrypt, BENCH_MAX_SIZE},
+    {"aead",   "ASCON-128-decrypt",  aead128_prepare, aead128_decrypt, BENCH_MAX_SIZE},
+    {"aead",   "ASCON-128a-encrypt", 0, aead128a_encrypt, BENCH_MAX_SIZE},
+    {"aead",   "ASCON-128a-decrypt", aead128a_prepare, aead128a_decrypt, BENCH_MAX_SIZE},
+    {"aead",   "ASCON-80pq-encrypt", 0, aead80pq_encrypt, BENCH_MAX_SIZE},
+    {"aead",   "ASCON-80pq-decrypt", aead80pq_prepare, aead80pq_decrypt, BENCH_MAX_SIZE},
+    {"siv",    "ASCON-128-SIV-encrypt",  0, siv128_encrypt, BENCH_MAX_SIZE},
+    {"siv",    "ASCON-128-SIV-decrypt",  siv128_prepare, siv128_decrypt, BENCH_MAX_SIZE},
+    {"siv",    "ASCON-128a-SIV-encrypt", 0, siv128a_encrypt, BENCH_MAX_SIZE},
+    {"siv",    "ASCON-128a-SIV-decrypt", siv128a_prepare, siv128a_decrypt, BENCH_MAX_SIZE},
+    {"siv",    "ASCON-80pq-SIV-encrypt", 0, siv80pq_encrypt, BENCH_MAX_SIZE},
+    {"siv",    "ASCON-80pq-SIV-decrypt", siv80pq_prepare, siv80pq_decrypt, BENCH_MAX_SIZE},
+#endif
+#if ASCON_ENABLE_ISAP
+    {"isap",   "ISAP-A-128-encrypt",  0, isap128_encrypt, BENCH_MAX_SIZE},
+    {"isap",   "ISAP-A-128-decrypt",  isap128_prepare, isap128_decrypt, BENCH_MAX_SIZE},
+    {"isap",   "ISAP-A-128A-encrypt", 0, isap128a_encrypt, BENCH_MAX_SIZE},
+    {"isap",   "ISAP-A-128A-decrypt", isap128a_prepare, isap128a_decrypt, BENCH_MAX_SIZE},
+#endif
+#if ASCON_ENABLE_MASKING
+    {"masked", "ASCON-128-masked-encrypt",  0, masked128_encrypt, BENCH_MAX_SIZE},
+    {"masked", "ASCON-128-masked-decrypt",  masked128_prepare, masked128_decrypt, BENCH_MAX_SIZE},
+    {"masked", "ASCON-128a-masked-encrypt", 0, masked128a_encrypt, BENCH_MAX_SIZE},
+    {"masked", "ASCON-128a-masked-decrypt", masked128a_prepare, masked128a_decrypt, BENCH_MAX_SIZE},
+    {"masked", "ASCON-80pq-masked-encrypt", 0, masked80pq_encrypt, BENCH_MAX_SIZE},
+    {"masked", "ASCON-80pq-masked-decrypt", masked80pq_prepare, masked80pq_decrypt, BENCH_MAX_SIZE},
+#endif
+#if ASCON_ENABLE_HASH
+    {"hash",   "ASCON-HASH",  0, hash_run, BENCH_MAX_SIZE},
+    {"hash",   "ASCON-HASHA", 0, hasha_run, BENCH_MAX_SIZE},
+    {"xof",    "ASCON-XOF",   0, xof_run, BENCH_MAX_SIZE},
+    {"xof",    "ASCON-XOFA",  0, xofa_run, BENCH_MAX_SIZE},
+    {"kmac",   "ASCON-KMAC",  0, kmac_run, BENCH_MAX_SIZE},
+    {"kmac",   "ASCON-KMACA", 0, kmaca_run, BENCH_MAX_SIZE},
+    {"hmac",   "ASCON-HMAC",  0, hmac_run, BENCH_MAX_SIZE},
+    {"hmac",   "ASCON-HMACA", 0, hmaca_run, BENCH_MAX_SIZE},
+    {"prf",    "ASCON-PRF",   0, prf_run, BENCH_MAX_SIZE},
+    {"prf",    "ASCON-MAC",   0, mac_run, BENCH_MAX_SIZE},
+    {"pbkdf2", "ASCON-PBKDF2", 0, pbkdf2_run, 256},
+#endif
+#if defined(BENCH_COMPARE)
+    {"compare", "ChaCha20-Poly1305-encrypt", 0, chachapoly_encrypt, BENCH_MAX_SIZE},
+    {"compare", "ChaCha20-Poly1305-decrypt", chachapoly_prepare, chachapoly_decrypt, BENCH_MAX_SIZE},
+    {"compare", "AES-128-GCM-encrypt", 0, aesgcm_encrypt, BENCH_MAX_SIZE},
+    {"compare", "AES-128-GCM-decrypt", aesgcm_prepare, aesgcm_decrypt, BENCH_MAX_SIZE},
+#if defined(BENCH_COMPARE_HW_AES)
+    {"compare", "AES-128-GCM-hw-encrypt", 0, hwgcm_encrypt, BENCH_MAX_SIZE},
+    {"compare", "AES-128-GCM-hw-decrypt", hwgcm_prepare, hwgcm_decrypt, BENCH_MAX_SIZE},
+#endif
+#endif
+};
+
+void benchmark(const BenchInfo *info, size_t size)
+{
+    unsigned long loops = 1;
+    unsigned long count;
+    unsigned long start_ms;
+    bench_counter_t start;
+    bench_counter_t elapsed;
+    double per_op;
+
+    if (info->prepare)
+        info->prepare(size);
+
+    // Double the number of loops until the run takes long enough to
+    // get a stable measurement.
+    for (;;) {
+        crypto_feed_watchdog();
+        start_ms = millis();
+        start = bench_counter();
+        for (count = 0; count < loops; ++count)
+            info->run(size);
+        elapsed = bench_counter() - start;
+        if ((millis() - start_ms) >= BENCH_TIME_MS ||
+                loops >= BENCH_MAX_LOOPS)
+            break;
+        loops *= 2;
+    }
+
+    per_op = ((double)elapsed) / loops;
+    Serial.print(info->mode);
+    Serial.print(',');
+    Serial.print(info->name);
+    Serial.print(',');
+    Serial.print((unsigned long)size);
+    Serial.print(',');
+    Serial.print(loops);
+    Serial.print(',');
+    Serial.print(BENCH_UNIT);
+    Serial.print(',');
+    Serial.print(per_op, 2);
+    Serial.print(',');
+    if (size > 0)
+        Serial.print(per_op / size, 2);
+    Serial.println();
+}
+
+#if defined(BENCH_STACK)
+
+// Paints the region of the stack below the caller's frame.
+static void __attribute__((noinline)) bench_stack_paint()
+{
+    volatile unsigned char buf[BENCH_STACK_SIZE];
+    size_t posn;
+    for (posn = 0; posn < sizeof(buf); ++posn)
+        buf[posn] = BENCH_STACK_PATTERN;
+}
+
+// Determines how much of the painted region was overwritten.  This
+// function must have the same frame layout as bench_stack_paint() so
+// that "buf" lands on the same region of the stack.
+static size_t __attribute__((noinline)) bench_stack_used()
+{
+    volatile unsigned char buf[BENCH_STACK_SIZE];
+    size_t posn;
+    for (posn = 0; posn < sizeof(buf); ++posn) {
+        if (buf[posn] != BENCH_STACK_PATTERN)
+            break;
+    }
+    return sizeof(buf) - posn;
+}
+
+void benchmark_stack(const BenchInfo *info)
+{
+    size_t size = BENCH_STACK_MSG_SIZE;
+    size_t used;
+
+    if (size > info->max_size)
+        size = info->max_size;
+    if (info->prepare)
+        info->prepare(size);
+
+    crypto_feed_watchdog();
+    bench_stack_paint();
+    info->run(size);
+    used = bench_stack_used();
+
+    Serial.print("stack,");
+    Serial.print(info->name);
+    Serial.print(',');
+    Serial.print((unsigned long)size);
+    Serial.print(',');
+    if (used >= BENCH_STACK_SIZE)
+        Serial.print('>');
+    Serial.print((unsigned long)used);
+    Serial.println();
+}
+
+#endif
+
+void setup()
+{
+    unsigned index, size_index;
+    size_t count;
+
+    Serial.begin(9600);
+    Serial.println();
+
+    bench_counter_init();
+    for (count = 0; count < BENCH_MAX_SIZE; ++count)
+        input[count] = (unsigned char)count;
+#if ASCON_ENABLE_ISAP
+    ascon128_isap_aead_init(&isap128_key, key);
+    ascon128a_isap_aead_init(&isap128a_key, key);
+#endif
+#if ASCON_ENABLE_MASKING
+    ascon_masked_key_128_init(&masked128_key, key);
+    ascon_masked_key_160_init(&masked160_key, key);
+#endif
+#if defined(BENCH_COMPARE_HW_AES)
+    mbedtls_gcm_init(&hwgcm_context);
+#endif
+
+    // Report the build profile so that the trade-off between code size
+    // and speed can be compared across profiles.
+    Serial.print("profile");
+#if defined(ASCON_SMALL)
+    Serial.print(",small");
+#endif
+    if (ascon_backend_features() & ASCON_FEATURE_FAST_RAM)
+        Serial.print(",ram");
+    Serial.print(",aead=");
+    Serial.print(ASCON_ENABLE_AEAD);
+    Serial.print(",hash=");
+    Serial.print(ASCON_ENABLE_HASH);
+    Serial.print(",isap=");
+    Serial.print(ASCON_ENABLE_ISAP);
+    Serial.print(",masking=");
+    Serial.print(ASCON_ENABLE_MASKING);
+    Serial.println();
+
+#if defined(BENCH_CALIBRATE)
+    {
+        ascon_calibration_t cal[ASCON_CALIBRATION_MAX_RESULTS];
+        unsigned ncal = ascon_backend_calibrate
+            (micros, 2000, cal, ASCON_CALIBRATION_MAX_RESULTS);
+        Serial.println("mode,kernel,permutations,us,selected");
+        for (index = 0; index < ncal; ++index) {
+            Serial.print("calibrate,");
+            Serial.print(cal[index].name);
+            Serial.print(',');
+            Serial.print(cal[index].permutations);
+            Serial.print(',');
+            Serial.print(cal[index].elapsed);
+            Serial.print(',');
+            Serial.println(cal[index].selected);
+        }
+    }
+#endif
+
+#if defined(BENCH_STACK)
+    Serial.println("mode,primitive,bytes,stack_bytes");
+    for (index = 0; index < sizeof(benchmarks) / sizeof(benchmarks[0]);
+            ++index) {
+        benchmark_stack(&benchmarks[index]);
+    }
+    (void)size_index;
+#else
+    Serial.println("mode,primitive,bytes,loops,unit,per_op,per_byte");
+    for (index = 0; index < sizeof(benchmarks) / sizeof(benchmarks[0]);
+            ++index) {
+        for (size_index = 0;
+                size_index < sizeof(bench_sizes) / sizeof(bench_sizes[0]);
+                ++size_index) {
+            if (bench_sizes[size_index] > benchmarks[index].max_size)
+                break;
+            benchmark(&benchmarks[index], bench_sizes[size_index]);
+        }
+    }
+#endif
+    Serial.println("done");
+
+#if ASCON_ENABLE_ISAP
+    ascon128_isap_aead_free(&isap128_key);
+    ascon128a_isap_aead_free(&isap128a_key);
+#endif
+#if ASCON_ENABLE_MASKING
+    ascon_masked_key_128_free(&masked128_key);
+    ascon_masked_key_160_free(&masked160_key);
+#endif
+#if defined(BENCH_COMPARE_HW_AES)
+    mbedtls_gcm_free(&hwgcm_context);
+#endif
+}
+
+void loop()
+{
+}
@@ -21,8 +21,21 @@
  */
 
 // This sketch runs performance tests on the ASCON primitives.
+//
+// For battery-powered devices, the sketch can also measure energy.
+// Define ENERGY_MARKER_PIN to raise a GPIO pin for the duration of each
+// timed loop, so that an external power analyzer can integrate the supply
+// current over the marked interval.  Define ENERGY_INA219_ADDR to the I2C
+// address of an INA219 current sensor on the supply rail, and the sketch
+// will report the energy per byte and per message itself.
+
+//#define ENERGY_MARKER_PIN 2
+//#define ENERGY_INA219_ADDR 0x40
 
 #include <ASCON.h>
+#if defined(ENERGY_INA219_ADDR)
+#include <Wire.h>
+#endif
 
 #if defined(ESP8266)
 extern "C" void system_soft_wdt_feed(void);
@@ -84,6 +97,102 @@ static unsigned char const nonce[16] = {
 static unsigned char plaintext[MAX_DATA_SIZE];
 static unsigned char ciphertext[MAX_DATA_SIZE + MAX_TAG_SIZE];
 
+#if defined(ENERGY_INA219_ADDR)
+
+// Resistance of the INA219 shunt in ohms; 0.1 on most breakout boards.
+#if !defined(ENERGY_SHUNT_OHMS)
+#define ENERGY_SHUNT_OHMS 0.1
+#endif
+
+// The INA219 is configured to average 32 samples, which takes 17.02ms.
+// Reading the power at the end of a timed loop gives the average over the
+// last part of the loop, so the loop should run for longer than this.
+#define ENERGY_WINDOW_US 17020UL
+
+static void ina219Write(uint8_t reg, uint16_t value)
+{
+    Wire.beginTransmission(ENERGY_INA219_ADDR);
+    Wire.write(reg);
+    Wire.write((uint8_t)(value >> 8));
+    Wire.write((uint8_t)value);
+    Wire.endTransmission();
+}
+
+static uint16_t ina219Read(uint8_t reg)
+{
+    uint16_t value;
+    Wire.beginTransmission(ENERGY_INA219_ADDR);
+    Wire.write(reg);
+    Wire.endTransmission();
+    Wire.requestFrom(ENERGY_INA219_ADDR, 2);
+    value = ((uint16_t)Wire.read()) << 8;
+    value |= Wire.read();
+    return value;
+}
+
+#endif
+
+void energyInit()
+{
+#if defined(ENERGY_MARKER_PIN)
+    pinMode(ENERGY_MARKER_PIN, OUTPUT);
+    digitalWrite(ENERGY_MARKER_PIN, LOW);
+#endif
+#if defined(ENERGY_INA219_ADDR)
+    // 32V bus range, 320mV shunt range, 32 sample averaging on the
+    // shunt and bus voltages, continuous conversion.
+    Wire.begin();
+    ina219Write(0x00, 0x3EEF);
+#endif
+}
+
+void energyBegin()
+{
+#if defined(ENERGY_MARKER_PIN)
+    digitalWrite(ENERGY_MARKER_PIN, HIGH);
+#endif
+}
+
+// Ends a timed loop and returns the average power in watts, or a
+// negative value if there is no current sensor.
+double energyEnd()
+{
+    double power = -1.0;
+#if defined(ENERGY_INA219_ADDR)
+    double shunt = ((int16_t)ina219Read(0x01)) * 0.00001;
+    double bus = (ina219Read(0x02) >> 3) * 0.004;
+    power = bus * shunt / ENERGY_SHUNT_OHMS;
+#endif
+#if defined(ENERGY_MARKER_PIN)
+    digitalWrite(ENERGY_MARKER_PIN, LOW);
+#endif
+    return power;
+}
+
+// Reports the time and energy for a timed loop.
+void perfReport
+    (unsigned long elapsed, double bytes, int messages, double power)
+{
+    Serial.print(elapsed / bytes);
+    Serial.print("us per byte, ");
+    Serial.print((bytes * 1000000.0) / elapsed);
+    Serial.print(" bytes per second");
+    if (power >= 0) {
+        // Watts times microseconds gives microjoules.
+        double energy = power * elapsed;
+        Serial.print(", ");
+        Serial.print(energy / bytes, 4);
+        Serial.print("uJ per byte, ");
+        Serial.print(energy / messages, 3);
+        Serial.print("uJ per message");
+#if defined(ENERGY_WINDOW_US)
+        if (elapsed < ENERGY_WINDOW_US)
+            Serial.print(" (loop shorter than sensor window)");
+#endif
+    }
+    Serial.println();
+}
+
 void perfCipherEncrypt128
     (aead_cipher_encrypt_t encrypt,
      unsigned key_size,
@@ -94,6 +203,7 @@ void perfCipherEncrypt128
     unsigned char pk[key_size + 8];
     unsigned long start;
     unsigned long elapsed;
+    double power;
     size_t len;
     int count;
 
@@ -107,19 +217,18 @@ void perfCipherEncrypt128
         k = pk;
     }
 
+    energyBegin();
     start = micros();
     for (count = 0; count < PERF_LOOPS; ++count) {
         encrypt(ciphertext, &len, plaintext, 128, 0, 0, nonce, k);
     }
     elapsed = micros() - start;
+    power = energyEnd();
 
     if (free_key)
         free_key(pk);
 
-    Serial.print(elapsed / (128.0 * PERF_LOOPS));
-    Serial.print("us per byte, ");
-    Serial.print((128.0 * PERF_LOOPS * 1000000.0) / elapsed);
-    Serial.println(" bytes per second");
+    perfReport(elapsed, 128.0 * PERF_LOOPS, PERF_LOOPS, power);
 }
 
 void perfCipherDecrypt128
@@ -133,6 +242,7 @@ void perfCipherDecrypt128
     unsigned char pk[key_size + 8];
     unsigned long start;
     unsigned long elapsed;
+    double power;
     size_t clen;
     size_t plen;
     int count;
@@ -148,19 +258,18 @@ void perfCipherDecrypt128
         k = pk;
     }
 
+    energyBegin();
     start = micros();
     for (count = 0; count < PERF_LOOPS; ++count) {
         decrypt(plaintext, &plen, ciphertext, clen, 0, 0, nonce, k);
     }
     elapsed = micros() - start;
+    power = energyEnd();
 
     if (free_key)
         free_key(pk);
 
-    Serial.print(elapsed / (128.0 * PERF_LOOPS));
-    Serial.print("us per byte, ");
-    Serial.print((128.0 * PERF_LOOPS * 1000000.0) / elapsed);
-    Serial.println(" bytes per second");
+    perfReport(elapsed, 128.0 * PERF_LOOPS, PERF_LOOPS, power);
 }
 
 void perfCipherEncrypt16
@@ -173,6 +282,7 @@ void perfCipherEncrypt16
     unsigned char pk[key_size + 8];
     unsigned long start;
     unsigned long elapsed;
+    double power;
     size_t len;
     int count;
 
@@ -186,19 +296,18 @@ void perfCipherEncrypt16
         k = pk;
     }
 
+    energyBegin();
     start = micros();
     for (count = 0; count < PERF_LOOPS_16; ++count) {
         encrypt(ciphertext, &len, plaintext, 16, 0, 0, nonce, k);
     }
     elapsed = micros() - start;
+    power = energyEnd();
 
     if (free_key)
         free_key(pk);
 
-    Serial.print(elapsed / (16.0 * PERF_LOOPS_16));
-    Serial.print("us per byte, ");
-    Serial.print((16.0 * PERF_LOOPS_16 * 1000000.0) / elapsed);
-    Serial.println(" bytes per second");
+    perfReport(elapsed, 16.0 * PERF_LOOPS_16, PERF_LOOPS_16, power);
 }
 
 void perfCipherDecrypt16
@@ -212,6 +321,7 @@ void perfCipherDecrypt16
     unsigned char pk[key_size + 8];
     unsigned long start;
     unsigned long elapsed;
+    double power;
     size_t clen;
     size_t plen;
     int count;
@@ -227,19 +337,18 @@ void perfCipherDecrypt16
         k = pk;
     }
 
+    energyBegin();
     start = micros();
     for (count = 0; count < PERF_LOOPS_16; ++count) {
         decrypt(plaintext, &plen, ciphertext, clen, 0, 0, nonce, k);
     }
     elapsed = micros() - start;
+    power = energyEnd();
 
     if (free_key)
         free_key(pk);
 
-    Serial.print(elapsed / (16.0 * PERF_LOOPS_16));
-    Serial.print("us per byte, ");
-    Serial.print((16.0 * PERF_LOOPS_16 * 1000000.0) / elapsed);
-    Serial.println(" bytes per second");
+    perfReport(elapsed, 16.0 * PERF_LOOPS_16, PERF_LOOPS_16, power);
 }
 
 bool equal_hex(const char *expected, const unsigned char *actual, unsigned len)
@@ -358,6 +467,7 @@ void perfHash_N(aead_hash_t hash_func, int size)
 {
     unsigned long start;
     unsigned long elapsed;
+    double power;
     unsigned long long len;
     int count, loops;
 
@@ -380,16 +490,15 @@ void perfHash_N(aead_hash_t hash_func, int size)
     else
         loops = PERF_HASH_LOOPS;
 
+    energyBegin();
     start = micros();
     for (count = 0; count < loops; ++count) {
         hash_func(ciphertext, hash_buffer, size);
     }
     elapsed = micros() - start;
+    power = energyEnd();
 
-    Serial.print(elapsed / (((double)size) * loops));
-    Serial.print("us per byte, ");
-    Serial.print((1000000.0 * size * loops) / elapsed);
-    Serial.println(" bytes per second");
+    perfReport(elapsed, ((double)size) * loops, loops, power);
 }
 
 void perfHash(const char *name, aead_hash_t hash_func)
@@ -410,6 +519,7 @@ void setup()
 {
     Serial.begin(9600);
     Serial.println();
+    energyInit();
 
     // The test vectors are for doing a quick sanity check that the
     // algorithm appears to be working correctly.  The test vector is:
@@ -455,6 +565,19 @@ void setup()
                  (aead_cipher_pk_init_t)ascon_masked_key_160_init,
                  (aead_cipher_pk_free_t)ascon_masked_key_160_free,
                  "368D3F1F3BA75BA929D4A5327E8DE42A55383F238CCC04F75BF026EF5BE70D67741B339B908B04");
+
+    perfCipherPK("ISAP-A-128A", sizeof(ascon128a_isap_aead_key_t),
+                 (aead_cipher_encrypt_t)ascon128a_isap_aead_encrypt,
+                 (aead_cipher_decrypt_t)ascon128a_isap_aead_decrypt,
+                 (aead_cipher_pk_init_t)ascon128a_isap_aead_init,
+                 (aead_cipher_pk_free_t)ascon128a_isap_aead_free,
+                 "2CDE28DBBBD9131EBC568D77725B25937CF8EDB8A8F50A51312527CC6AEA52AED910035253C093");
+    perfCipherPK("ISAP-A-128", sizeof(ascon128_isap_aead_key_t),
+                 (aead_cipher_encrypt_t)ascon128_isap_aead_encrypt,
+                 (aead_cipher_decrypt_t)ascon128_isap_aead_decrypt,
+                 (aead_cipher_pk_init_t)ascon128_isap_aead_init,
+                 (aead_cipher_pk_free_t)ascon128_isap_aead_free,
+                 "B8529BCE1B3F9D0DB7A9C8DD43DD35D18E41801A814A2946E3500BD4A77E3EFF16EFABD6CCA575");
 }
 
 void loop()
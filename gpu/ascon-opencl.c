@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-opencl.h"
+#include "ascon-utility.h"
+#define CL_TARGET_OPENCL_VERSION 120
+#if defined(__APPLE__)
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Default locations of the kernel source and "ascon-vec.h", which are
+ * normally set by the CMake build to point into the source tree */
+#if !defined(ASCON_OPENCL_KERNEL_DIR)
+#define ASCON_OPENCL_KERNEL_DIR "."
+#endif
+#if !defined(ASCON_OPENCL_INCLUDE_DIR)
+#define ASCON_OPENCL_INCLUDE_DIR ASCON_OPENCL_KERNEL_DIR
+#endif
+
+/* Maximum number of OpenCL platforms to search for a GPU */
+#define ASCON_OPENCL_MAX_PLATFORMS 8
+
+struct ascon_opencl_s
+{
+    cl_context context;
+    cl_command_queue queue;
+    cl_program program;
+    cl_kernel kernel;
+};
+
+/**
+ * \brief Reads the kernel source from a directory.
+ *
+ * \param dir The directory containing "ascon-opencl.cl".
+ * \param len Returns the length of the source.
+ *
+ * \return The source, which must be freed with free(), or NULL on error.
+ */
+static char *ascon_opencl_read_kernel(const char *dir, size_t *len)
+{
+    char *path;
+    char *source = 0;
+    FILE *file;
+    long size;
+
+    path = (char *)malloc(strlen(dir) + 32);
+    if (!path)
+        return 0;
+    sprintf(path, "%s/ascon-opencl.cl", dir);
+    file = fopen(path, "rb");
+    free(path);
+    if (!file)
+        return 0;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 &&
+            fseek(file, 0, SEEK_SET) == 0) {
+        source = (char *)malloc((size_t)size + 1);
+        if (source && fread(source, 1, (size_t)size, file) == (size_t)size) {
+            source[size] = '\0';
+            *len = (size_t)size;
+        } else {
+            free(source);
+            source = 0;
+        }
+    }
+    fclose(file);
+    return source;
+}
+
+/**
+ * \brief Finds the first GPU on any OpenCL platform.
+ *
+ * \param device Returns the device identifier.
+ *
+ * \return Non-zero if a GPU was found.
+ */
+static int ascon_opencl_find_gpu(cl_device_id *device)
+{
+    cl_platform_id platforms[ASCON_OPENCL_MAX_PLATFORMS];
+    cl_uint num_platforms = 0;
+    cl_uint index;
+    if (clGetPlatformIDs(ASCON_OPENCL_MAX_PLATFORMS, platforms,
+                         &num_platforms) != CL_SUCCESS)
+        return 0;
+    if (num_platforms > ASCON_OPENCL_MAX_PLATFORMS)
+        num_platforms = ASCON_OPENCL_MAX_PLATFORMS;
+    for (index = 0; index < num_platforms; ++index) {
+        if (clGetDeviceIDs(platforms[index], CL_DEVICE_TYPE_GPU,
+                           1, device, 0) == CL_SUCCESS)
+            return 1;
+    }
+    return 0;
+}
+
+ascon_opencl_t *ascon_opencl_open(void)
+{
+    ascon_opencl_t *cl;
+    cl_device_id device;
+    const char *dir;
+    char *source;
+    char *options;
+    size_t len = 0;
+    cl_int err;
+
+    /* Find a GPU and load the kernel source */
+    if (!ascon_opencl_find_gpu(&device))
+        return 0;
+    dir = getenv("ASCON_OPENCL_KERNEL_DIR");
+    if (!dir || *dir == '\0')
+        dir = ASCON_OPENCL_KERNEL_DIR;
+    source = ascon_opencl_read_kernel(dir, &len);
+    if (!source)
+        return 0;
+    options = (char *)malloc
+        (strlen(dir) + strlen(ASCON_OPENCL_INCLUDE_DIR) + 16);
+    cl = (ascon_opencl_t *)calloc(1, sizeof(ascon_opencl_t));
+    if (!options || !cl) {
+        free(options);
+        free(source);
+        free(cl);
+        return 0;
+    }
+    sprintf(options, "-I \"%s\" -I \"%s\"", dir, ASCON_OPENCL_INCLUDE_DIR);
+
+    /* Create the context and compile the kernel for the device */
+    cl->context = clCreateContext(0, 1, &device, 0, 0, &err);
+    if (err == CL_SUCCESS)
+        cl->queue = clCreateCommandQueue(cl->context, device, 0, &err);
+    if (err == CL_SUCCESS) {
+        cl->program = clCreateProgramWithSource
+            (cl->context, 1, (const char **)&source, &len, &err);
+    }
+    if (err == CL_SUCCESS)
+        err = clBuildProgram(cl->program, 1, &device, options, 0, 0);
+    if (err == CL_SUCCESS) {
+        cl->kernel = clCreateKernel
+            (cl->program, "ascon128a_decrypt_kernel", &err);
+    }
+    free(options);
+    free(source);
+    if (err != CL_SUCCESS) {
+        ascon_opencl_close(cl);
+        return 0;
+    }
+    return cl;
+}
+
+void ascon_opencl_close(ascon_opencl_t *cl)
+{
+    if (cl) {
+        if (cl->kernel)
+            clReleaseKernel(cl->kernel);
+        if (cl->program)
+            clReleaseProgram(cl->program);
+        if (cl->queue)
+            clReleaseCommandQueue(cl->queue);
+        if (cl->context)
+            clReleaseContext(cl->context);
+        free(cl);
+    }
+}
+
+/* Host-side copies of the buffers that are passed to the kernel */
+typedef struct
+{
+    unsigned char *input;
+    uint32_t *desc;
+    unsigned char *keys;
+    unsigned char *output;
+    int *results;
+    size_t input_size;
+    size_t output_size;
+
+} ascon_opencl_batch_t;
+
+/**
+ * \brief Packs a batch of messages into host buffers for the kernel.
+ *
+ * \param batch Returns the packed buffers.
+ * \param msgs Points to the messages.
+ * \param count Number of messages.
+ *
+ * \return Non-zero if the batch was packed, or zero if it cannot be
+ * offloaded because a message is invalid or the batch is too large.
+ */
+static int ascon_opencl_pack
+    (ascon_opencl_batch_t *batch, const ascon_aead_batch_t *msgs,
+     size_t count)
+{
+    size_t in_size = 0;
+    size_t out_size = 0;
+    size_t index;
+
+    /* Determine the buffer sizes, which must fit in 32-bit offsets */
+    memset(batch, 0, sizeof(ascon_opencl_batch_t));
+    for (index = 0; index < count; ++index) {
+        const ascon_aead_batch_t *msg = &(msgs[index]);
+        if (msg->inlen < ASCON128_TAG_SIZE)
+            return 0;
+        in_size += msg->adlen + msg->inlen;
+        out_size += msg->inlen - ASCON128_TAG_SIZE;
+        if (in_size > 0xFFFFFFFFU || out_size > 0xFFFFFFFFU)
+            return 0;
+    }
+    if (count > 0xFFFFFFFFU / 4U)
+        return 0;
+
+    /* Allocate the buffers.  OpenCL does not allow empty buffers. */
+    batch->input_size = in_size ? in_size : 1;
+    batch->output_size = out_size ? out_size : 1;
+    batch->input = (unsigned char *)malloc(batch->input_size);
+    batch->desc = (uint32_t *)malloc(count * 4 * sizeof(uint32_t));
+    batch->keys = (unsigned char *)malloc(count * 32);
+    batch->output = (unsigned char *)malloc(batch->output_size);
+    batch->results = (int *)malloc(count * sizeof(int));
+    if (!batch->input || !batch->desc || !batch->keys ||
+            !batch->output || !batch->results)
+        return 0;
+
+    /* Copy the associated data, ciphertext, keys, and nonces */
+    in_size = 0;
+    out_size = 0;
+    for (index = 0; index < count; ++index) {
+        const ascon_aead_batch_t *msg = &(msgs[index]);
+        batch->desc[index * 4] = (uint32_t)in_size;
+        batch->desc[index * 4 + 1] = (uint32_t)(msg->adlen);
+        batch->desc[index * 4 + 2] = (uint32_t)(msg->inlen);
+        batch->desc[index * 4 + 3] = (uint32_t)out_size;
+        if (msg->adlen > 0)
+            memcpy(batch->input + in_size, msg->ad, msg->adlen);
+        memcpy(batch->input + in_size + msg->adlen, msg->in, msg->inlen);
+        memcpy(batch->keys + index * 32, msg->k, ASCON128_KEY_SIZE);
+        memcpy(batch->keys + index * 32 + 16, msg->npub, ASCON128_NONCE_SIZE);
+        in_size += msg->adlen + msg->inlen;
+        out_size += msg->inlen - ASCON128_TAG_SIZE;
+    }
+    return 1;
+}
+
+/**
+ * \brief Frees the host buffers for a batch and destroys the keys
+ * and plaintext.
+ *
+ * \param batch The buffers to free.
+ * \param count Number of messages in the batch.
+ */
+static void ascon_opencl_free_batch(ascon_opencl_batch_t *batch, size_t count)
+{
+    if (batch->keys)
+        ascon_clean(batch->keys, (unsigned)(count * 32));
+    if (batch->output)
+        ascon_clean(batch->output, (unsigned)(batch->output_size));
+    free(batch->input);
+    free(batch->desc);
+    free(batch->keys);
+    free(batch->output);
+    free(batch->results);
+}
+
+/**
+ * \brief Runs the kernel on a packed batch.
+ *
+ * \param cl The device context.
+ * \param batch The packed batch; the output and results are filled in.
+ * \param count Number of messages in the batch.
+ *
+ * \return Non-zero if the kernel ran successfully.
+ */
+static int ascon_opencl_run
+    (ascon_opencl_t *cl, ascon_opencl_batch_t *batch, size_t count)
+{
+    cl_mem buffers[5] = {0, 0, 0, 0, 0};
+    cl_uint num = (cl_uint)count;
+    size_t global = count;
+    cl_int err;
+    int ok = 0;
+    int index;
+
+    /* Create the device buffers and copy the inputs to them */
+    buffers[0] = clCreateBuffer
+        (cl->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+         batch->input_size, batch->input, &err);
+    if (err == CL_SUCCESS) {
+        buffers[1] = clCreateBuffer
+            (cl->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+             count * 4 * sizeof(uint32_t), batch->desc, &err);
+    }
+    if (err == CL_SUCCESS) {
+        buffers[2] = clCreateBuffer
+            (cl->context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+             count * 32, batch->keys, &err);
+    }
+    if (err == CL_SUCCESS) {
+        buffers[3] = clCreateBuffer
+            (cl->context, CL_MEM_WRITE_ONLY, batch->output_size, 0, &err);
+    }
+    if (err == CL_SUCCESS) {
+        buffers[4] = clCreateBuffer
+            (cl->context, CL_MEM_WRITE_ONLY, count * sizeof(int), 0, &err);
+    }
+
+    /* Run the kernel and read back the plaintext and the results */
+    for (index = 0; index < 5 && err == CL_SUCCESS; ++index) {
+        err = clSetKernelArg
+            (cl->kernel, (cl_uint)index, sizeof(cl_mem), &(buffers[index]));
+    }
+    if (err == CL_SUCCESS)
+        err = clSetKernelArg(cl->kernel, 5, sizeof(cl_uint), &num);
+    if (err == CL_SUCCESS) {
+        err = clEnqueueNDRangeKernel
+            (cl->queue, cl->kernel, 1, 0, &global, 0, 0, 0, 0);
+    }
+    if (err == CL_SUCCESS) {
+        err = clEnqueueReadBuffer
+            (cl->queue, buffers[3], CL_TRUE, 0, batch->output_size,
+             batch->output, 0, 0, 0);
+    }
+    if (err == CL_SUCCESS) {
+        err = clEnqueueReadBuffer
+            (cl->queue, buffers[4], CL_TRUE, 0, count * sizeof(int),
+             batch->results, 0, 0, 0);
+    }
+    if (err == CL_SUCCESS)
+        ok = 1;
+
+    /* Clean up the device buffers */
+    for (index = 0; index < 5; ++index) {
+        if (buffers[index])
+            clReleaseMemObject(buffers[index]);
+    }
+    return ok;
+}
+
+int ascon128a_aead_decrypt_batch_opencl
+    (ascon_opencl_t *cl, ascon_aead_batch_t *msgs, size_t count)
+{
+    ascon_opencl_batch_t batch;
+    size_t index;
+    size_t posn = 0;
+    int result = 0;
+
+    /* Fall back to the CPU if there is no GPU or the batch is unsuitable */
+    if (!cl || count == 0)
+        return ascon128a_aead_decrypt_batch(msgs, count);
+    if (!ascon_opencl_pack(&batch, msgs, count) ||
+            !ascon_opencl_run(cl, &batch, count)) {
+        ascon_opencl_free_batch(&batch, count);
+        return ascon128a_aead_decrypt_batch(msgs, count);
+    }
+
+    /* Copy the plaintext and results back to the messages */
+    for (index = 0; index < count; ++index) {
+        ascon_aead_batch_t *msg = &(msgs[index]);
+        msg->outlen = msg->inlen - ASCON128_TAG_SIZE;
+        if (msg->outlen > 0)
+            memcpy(msg->out, batch.output + posn, msg->outlen);
+        msg->result = batch.results[index];
+        if (msg->result != 0)
+            result = -1;
+        posn += msg->outlen;
+    }
+    ascon_opencl_free_batch(&batch, count);
+    return result;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* OpenCL kernel that decrypts and verifies a batch of ASCON-128a packets
+ * with one work item per packet.  The round constants and the round
+ * function are shared with the CPU back ends via "ascon-vec.h".
+ *
+ * The host packs the associated data and ciphertext for each packet
+ * into a single input buffer.  Each packet is then described by four
+ * words in the "desc" buffer:
+ *
+ *     desc[0]  Offset of the associated data in "input".
+ *     desc[1]  Length of the associated data; the ciphertext follows.
+ *     desc[2]  Length of the ciphertext, including the 16 byte tag.
+ *     desc[3]  Offset of the plaintext in "output".
+ *
+ * The key and nonce for each packet are 32 bytes in "keys". */
+
+#include "ascon-vec.h"
+
+#define ascon_xor_cl(a, b)      ((a) ^ (b))
+#define ascon_andnot_cl(a, b)   (~(a) & (b))
+#define ascon_ror_cl(x, n)      (((x) >> (n)) | ((x) << (64 - (n))))
+
+/* Initialization vector for ASCON-128a */
+#define ASCON128A_IV 0x80800c0800000000UL
+
+/* Permutes a state that is held as five 64-bit words */
+void ascon_permute_cl(ulong *s, uint first_round)
+{
+    ulong x0 = s[0];
+    ulong x1 = s[1];
+    ulong x2 = ~s[2];
+    ulong x3 = s[3];
+    ulong x4 = s[4];
+    while (first_round < 12) {
+        ascon_vec_round(ulong, ascon_xor_cl, ascon_andnot_cl, ascon_ror_cl,
+                        x0, x1, x2, x3, x4, ascon_vec_rc[first_round]);
+        ++first_round;
+    }
+    s[0] = x0;
+    s[1] = x1;
+    s[2] = ~x2;
+    s[3] = x3;
+    s[4] = x4;
+}
+
+/* Loads up to 8 bytes as a big-endian word, padding with zeroes */
+ulong ascon_load_cl(__global const uchar *p, uint len)
+{
+    ulong x = 0;
+    uint i;
+    for (i = 0; i < len; ++i)
+        x |= ((ulong)(p[i])) << (56 - i * 8);
+    return x;
+}
+
+/* Stores a word in big-endian byte order */
+void ascon_store_cl(__global uchar *p, ulong x)
+{
+    uint i;
+    for (i = 0; i < 8; ++i)
+        p[i] = (uchar)(x >> (56 - i * 8));
+}
+
+/* Adds the padding byte at a position within the 16 byte rate */
+#define ascon_pad_cl(s, posn) \
+    ((s)[(posn) / 8] ^= 0x80UL << (56 - ((posn) % 8) * 8))
+
+__kernel void ascon128a_decrypt_kernel
+    (__global const uchar *input, __global const uint *desc,
+     __global const uchar *keys, __global uchar *output,
+     __global int *results, uint count)
+{
+    uint id = get_global_id(0);
+    __global const uchar *ad;
+    __global const uchar *c;
+    __global const uchar *k;
+    __global uchar *m;
+    ulong s[5];
+    ulong k0, k1, c0, c1;
+    uint adlen, mlen, len, i, shift;
+    uchar diff;
+
+    if (id >= count)
+        return;
+    ad = input + desc[id * 4];
+    adlen = desc[id * 4 + 1];
+    c = ad + adlen;
+    mlen = desc[id * 4 + 2] - 16;
+    m = output + desc[id * 4 + 3];
+    k = keys + id * 32;
+
+    /* Initialize the state with the IV, key, and nonce */
+    k0 = ascon_load_cl(k, 8);
+    k1 = ascon_load_cl(k + 8, 8);
+    s[0] = ASCON128A_IV;
+    s[1] = k0;
+    s[2] = k1;
+    s[3] = ascon_load_cl(k + 16, 8);
+    s[4] = ascon_load_cl(k + 24, 8);
+    ascon_permute_cl(s, 0);
+    s[3] ^= k0;
+    s[4] ^= k1;
+
+    /* Absorb the associated data */
+    if (adlen > 0) {
+        while (adlen >= 16) {
+            s[0] ^= ascon_load_cl(ad, 8);
+            s[1] ^= ascon_load_cl(ad + 8, 8);
+            ascon_permute_cl(s, 4);
+            ad += 16;
+            adlen -= 16;
+        }
+        if (adlen >= 8) {
+            s[0] ^= ascon_load_cl(ad, 8);
+            s[1] ^= ascon_load_cl(ad + 8, adlen - 8);
+        } else {
+            s[0] ^= ascon_load_cl(ad, adlen);
+        }
+        ascon_pad_cl(s, adlen);
+        ascon_permute_cl(s, 4);
+    }
+    s[4] ^= 0x01;
+
+    /* Decrypt the full blocks of the ciphertext */
+    len = mlen;
+    while (len >= 16) {
+        c0 = ascon_load_cl(c, 8);
+        c1 = ascon_load_cl(c + 8, 8);
+        ascon_store_cl(m, s[0] ^ c0);
+        ascon_store_cl(m + 8, s[1] ^ c1);
+        s[0] = c0;
+        s[1] = c1;
+        ascon_permute_cl(s, 4);
+        c += 16;
+        m += 16;
+        len -= 16;
+    }
+
+    /* Decrypt the last partial block, replacing the state bytes
+     * with the ciphertext bytes and then padding the block */
+    for (i = 0; i < len; ++i) {
+        shift = 56 - (i % 8) * 8;
+        m[i] = (uchar)(s[i / 8] >> shift) ^ c[i];
+        s[i / 8] = (s[i / 8] & ~(0xFFUL << shift)) | (((ulong)(c[i])) << shift);
+    }
+    ascon_pad_cl(s, len);
+
+    /* Finalize and check the authentication tag in constant time */
+    s[2] ^= k0;
+    s[3] ^= k1;
+    ascon_permute_cl(s, 0);
+    s[3] ^= k0;
+    s[4] ^= k1;
+    c += len;
+    diff = 0;
+    for (i = 0; i < 16; ++i) {
+        shift = 56 - (i % 8) * 8;
+        diff |= (uchar)(s[3 + i / 8] >> shift) ^ c[i];
+    }
+
+    /* Destroy the plaintext if the tag was incorrect */
+    results[id] = diff ? -1 : 0;
+    if (diff) {
+        m = output + desc[id * 4 + 3];
+        for (i = 0; i < mlen; ++i)
+            m[i] = 0;
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_OPENCL_H
+#define ASCON_OPENCL_H
+
+/**
+ * \file ascon-opencl.h
+ * \brief Offloads batches of ASCON-128a packet verification to a GPU
+ * with OpenCL.
+ *
+ * This module is intended for servers that verify very large numbers of
+ * packets at once.  It is built as the separate "ascon_opencl" library
+ * when the CMake option ASCON_BUILD_OPENCL is enabled.  It is not part
+ * of the Arduino library.
+ *
+ * The kernel is compiled at runtime from "ascon-opencl.cl", which is
+ * looked for in the directory named by the ASCON_OPENCL_KERNEL_DIR
+ * environment variable, or in the source tree if it is not set.
+ *
+ * If OpenCL is not available, or a GPU operation fails, then the batch
+ * falls back to ascon128a_aead_decrypt_batch() on the CPU, which uses the
+ * best multi-state permutation for the host's back end.
+ */
+
+#include "ascon-aead.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Opaque type for an OpenCL device context.
+ */
+typedef struct ascon_opencl_s ascon_opencl_t;
+
+/**
+ * \brief Opens the first OpenCL GPU on the system and compiles the kernel.
+ *
+ * \return The device context, or NULL if there is no usable GPU.
+ *
+ * It is safe to pass NULL to the other functions in this module,
+ * in which case they will use the CPU.
+ *
+ * \sa ascon_opencl_close()
+ */
+ascon_opencl_t *ascon_opencl_open(void);
+
+/**
+ * \brief Closes an OpenCL device context.
+ *
+ * \param cl The device context to close, which may be NULL.
+ *
+ * \sa ascon_opencl_open()
+ */
+void ascon_opencl_close(ascon_opencl_t *cl);
+
+/**
+ * \brief Decrypts and authenticates a batch of independent messages
+ * with ASCON-128a on a GPU.
+ *
+ * \param cl The device context, or NULL to use the CPU.
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * \return 0 if all messages were decrypted successfully, or -1 if the
+ * authentication tag was incorrect for at least one message.
+ *
+ * The results are the same as for ascon128a_aead_decrypt_batch().
+ * The \a result field of each message is set to the result for that
+ * message and the plaintext for messages that fail to authenticate
+ * is zeroed.
+ *
+ * The packets are copied into device buffers, decrypted with one work
+ * item per packet, and then copied back.  Small batches are usually
+ * faster on the CPU because of the transfer overhead.
+ */
+int ascon128a_aead_decrypt_batch_opencl
+    (ascon_opencl_t *cl, ascon_aead_batch_t *msgs, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
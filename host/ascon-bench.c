@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Host-side benchmark for the ASCON primitives.  The back end can be
+ * forced at build time with ASCON_FORCE_C32, ASCON_FORCE_C64, or
+ * ASCON_FORCE_DIRECT_XOR so that the back ends can be compared on the
+ * same machine.  Results are printed in CSV form:
+ *
+ *      backend,primitive,bytes,loops,ns_per_op,ns_per_byte
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "ASCON.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_SIZE 16384
+#define BENCH_TIME_NS 200000000ULL
+#define BENCH_TAG_SIZE 16
+
+static unsigned char const key[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+static unsigned char const nonce[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+static unsigned char input[BENCH_MAX_SIZE];
+static unsigned char output[BENCH_MAX_SIZE + BENCH_TAG_SIZE];
+static unsigned char cipher[BENCH_MAX_SIZE + BENCH_TAG_SIZE];
+static size_t cipher_len;
+static ascon_state_t perm_state;
+static ascon_table_hash_key_t table_key;
+static ascon128_siv_kek_t siv_kek;
+static volatile uint64_t table_hash;
+
+#define BENCH_TABLE_BATCH 8
+
+/* Number of 128-bit keys to wrap in each key wrapping operation */
+#define BENCH_WRAP_BATCH 64
+
+static size_t const bench_sizes[] = {0, 16, 64, 256, 1024, 4096, 16384};
+
+typedef struct
+{
+    const char *name;
+    void (*prepare)(size_t size);
+    void (*run)(size_t size);
+    int sized;
+
+} bench_info_t;
+
+static unsigned long long bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((unsigned long long)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+static void permute12_run(size_t size)
+{
+    (void)size;
+    ascon_permute(&perm_state, 0);
+}
+
+static void permute8_run(size_t size)
+{
+    (void)size;
+    ascon_permute(&perm_state, 4);
+}
+
+static void permute6_run(size_t size)
+{
+    (void)size;
+    ascon_permute(&perm_state, 6);
+}
+
+#define BENCH_AEAD(name, encrypt, decrypt) \
+    static void name##_encrypt(size_t size) \
+    { \
+        size_t len; \
+        encrypt(output, &len, input, size, 0, 0, nonce, key); \
+    } \
+    static void name##_prepare(size_t size) \
+    { \
+        encrypt(cipher, &cipher_len, input, size, 0, 0, nonce, key); \
+    } \
+    static void name##_decrypt(size_t size) \
+    { \
+        size_t len; \
+        (void)size; \
+        decrypt(output, &len, cipher, cipher_len, 0, 0, nonce, key); \
+    }
+
+BENCH_AEAD(aead128, ascon128_aead_encrypt, ascon128_aead_decrypt)
+BENCH_AEAD(aead128a, ascon128a_aead_encrypt, ascon128a_aead_decrypt)
+BENCH_AEAD(aead80pq, ascon80pq_aead_encrypt, ascon80pq_aead_decrypt)
+BENCH_AEAD(siv128, ascon128_siv_encrypt, ascon128_siv_decrypt)
+BENCH_AEAD(siv128a, ascon128a_siv_encrypt, ascon128a_siv_decrypt)
+BENCH_AEAD(aead128std, ascon_aead128_encrypt, ascon_aead128_decrypt)
+
+static void hash_run(size_t size) { ascon_hash(output, input, size); }
+static void hasha_run(size_t size) { ascon_hasha(output, input, size); }
+static void xof_run(size_t size) { ascon_xof(output, input, size); }
+static void xofa_run(size_t size) { ascon_xofa(output, input, size); }
+static void hash256_run(size_t size) { ascon_hash256(output, input, size); }
+
+static void xof128_run(size_t size)
+{
+    ascon_xof128(output, ASCON_HASH256_SIZE, input, size);
+}
+
+static void cxof128_run(size_t size)
+{
+    ascon_cxof128(output, ASCON_HASH256_SIZE, input, size, key, 16);
+}
+
+static void cxof128_custom_run(size_t size)
+{
+    static ascon_cxof128_custom_t custom;
+    static int custom_ready = 0;
+    ascon_xof128_state_t state;
+    if (!custom_ready) {
+        ascon_cxof128_init_custom(&custom, key, 16);
+        custom_ready = 1;
+    }
+    ascon_cxof128_init_from_custom(&state, &custom);
+    ascon_xof128_absorb(&state, input, size);
+    ascon_xof128_squeeze(&state, output, ASCON_HASH256_SIZE);
+    ascon_xof128_free(&state);
+}
+
+static void kmac_run(size_t size)
+{
+    ascon_kmac(key, 16, input, size, 0, 0, output, ASCON_KMAC_SIZE);
+}
+
+static void hmac_run(size_t size)
+{
+    ascon_hmac(output, key, 16, input, size);
+}
+
+static void prf_run(size_t size)
+{
+    ascon_prf(output, 16, input, size, key);
+}
+
+static void siv_wrap_run(size_t size)
+{
+    /* Wrap the keys one at a time for comparison with the batch API */
+    size_t len, index;
+    (void)size;
+    for (index = 0; index < BENCH_WRAP_BATCH; ++index) {
+        ascon128_siv_encrypt
+            (output + index * (ASCON128_SIV_WRAP_KEY_SIZE + 16), &len,
+             input + index * ASCON128_SIV_WRAP_KEY_SIZE,
+             ASCON128_SIV_WRAP_KEY_SIZE, 0, 0, nonce, key);
+    }
+}
+
+static void siv_wrap_batch_run(size_t size)
+{
+    (void)size;
+    ascon128_siv_wrap_batch
+        (output, input, ASCON128_SIV_WRAP_KEY_SIZE, BENCH_WRAP_BATCH,
+         &siv_kek);
+}
+
+static void mac_run(size_t size)
+{
+    ascon_mac(output, input, size, key);
+}
+
+static void table_hash_run(size_t size)
+{
+    table_hash = ascon_table_hash(&table_key, input, size);
+}
+
+static void table_hash_batch_run(size_t size)
+{
+    /* Hash a batch of keys of the same size as a probe would */
+    const unsigned char *in[BENCH_TABLE_BATCH];
+    size_t inlen[BENCH_TABLE_BATCH];
+    uint64_t out[BENCH_TABLE_BATCH];
+    size_t index;
+    for (index = 0; index < BENCH_TABLE_BATCH; ++index) {
+        if ((size + index) <= BENCH_MAX_SIZE)
+            in[index] = input + index;
+        else
+            in[index] = input;
+        inlen[index] = size;
+    }
+    ascon_table_hash_batch(out, &table_key, in, inlen, BENCH_TABLE_BATCH);
+    table_hash = out[0];
+}
+
+/* Reference SipHash-2-4 for comparison with the hash table hash */
+#define SIP_ROTL(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+#define SIP_ROUND() \
+    do { \
+        v0 += v1; v1 = SIP_ROTL(v1, 13); v1 ^= v0; v0 = SIP_ROTL(v0, 32); \
+        v2 += v3; v3 = SIP_ROTL(v3, 16); v3 ^= v2; \
+        v0 += v3; v3 = SIP_ROTL(v3, 21); v3 ^= v0; \
+        v2 += v1; v1 = SIP_ROTL(v1, 17); v1 ^= v2; v2 = SIP_ROTL(v2, 32); \
+    } while (0)
+
+static uint64_t sip_load64(const unsigned char *p)
+{
+    return ((uint64_t)p[0])       | (((uint64_t)p[1]) << 8)  |
+           (((uint64_t)p[2]) << 16) | (((uint64_t)p[3]) << 24) |
+           (((uint64_t)p[4]) << 32) | (((uint64_t)p[5]) << 40) |
+           (((uint64_t)p[6]) << 48) | (((uint64_t)p[7]) << 56);
+}
+
+static uint64_t siphash24
+    (const unsigned char *k, const unsigned char *in, size_t inlen)
+{
+    uint64_t k0 = sip_load64(k);
+    uint64_t k1 = sip_load64(k + 8);
+    uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+    uint64_t b = ((uint64_t)inlen) << 56;
+    uint64_t m;
+    size_t left;
+    while (inlen >= 8) {
+        m = sip_load64(in);
+        v3 ^= m;
+        SIP_ROUND();
+        SIP_ROUND();
+        v0 ^= m;
+        in += 8;
+        inlen -= 8;
+    }
+    for (left = 0; left < inlen; ++left)
+        b |= ((uint64_t)(in[left])) << (left * 8);
+    v3 ^= b;
+    SIP_ROUND();
+    SIP_ROUND();
+    v0 ^= b;
+    v2 ^= 0xff;
+    SIP_ROUND();
+    SIP_ROUND();
+    SIP_ROUND();
+    SIP_ROUND();
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+static void siphash_run(size_t size)
+{
+    table_hash = siphash24(key, input, size);
+}
+
+static bench_info_t const benchmarks[] = {
+    {"permute12",              0, permute12_run, 0},
+    {"permute8",               0, permute8_run, 0},
+    {"permute6",               0, permute6_run, 0},
+    {"ASCON-128-encrypt",      0, aead128_encrypt, 1},
+    {"ASCON-128-decrypt",      aead128_prepare, aead128_decrypt, 1},
+    {"ASCON-128a-encrypt",     0, aead128a_encrypt, 1},
+    {"ASCON-128a-decrypt",     aead128a_prepare, aead128a_decrypt, 1},
+    {"ASCON-80pq-encrypt",     0, aead80pq_encrypt, 1},
+    {"ASCON-80pq-decrypt",     aead80pq_prepare, aead80pq_decrypt, 1},
+    {"ASCON-128-SIV-encrypt",  0, siv128_encrypt, 1},
+    {"ASCON-128-SIV-decrypt",  siv128_prepare, siv128_decrypt, 1},
+    {"ASCON-128-SIV-WRAP-x64", 0, siv_wrap_run, 0},
+    {"ASCON-128-SIV-WRAP-BATCH-x64", 0, siv_wrap_batch_run, 0},
+    {"ASCON-128a-SIV-encrypt", 0, siv128a_encrypt, 1},
+    {"ASCON-128a-SIV-decrypt", siv128a_prepare, siv128a_decrypt, 1},
+    {"Ascon-AEAD128-encrypt",  0, aead128std_encrypt, 1},
+    {"Ascon-AEAD128-decrypt",  aead128std_prepare, aead128std_decrypt, 1},
+    {"ASCON-HASH",             0, hash_run, 1},
+    {"ASCON-HASHA",            0, hasha_run, 1},
+    {"ASCON-XOF",              0, xof_run, 1},
+    {"ASCON-XOFA",             0, xofa_run, 1},
+    {"Ascon-Hash256",          0, hash256_run, 1},
+    {"Ascon-XOF128",           0, xof128_run, 1},
+    {"Ascon-CXOF128",          0, cxof128_run, 1},
+    {"Ascon-CXOF128-cached",   0, cxof128_custom_run, 1},
+    {"ASCON-KMAC",             0, kmac_run, 1},
+    {"ASCON-HMAC",             0, hmac_run, 1},
+    {"ASCON-PRF",              0, prf_run, 1},
+    {"ASCON-MAC",              0, mac_run, 1},
+    {"ASCON-TABLE-HASH",       0, table_hash_run, 1},
+    {"ASCON-TABLE-HASH-BATCH", 0, table_hash_batch_run, 1},
+    {"SipHash-2-4",            0, siphash_run, 1}
+};
+
+static void benchmark(const bench_info_t *info, size_t size)
+{
+    unsigned long long start, elapsed;
+    unsigned long loops = 1;
+    unsigned long count;
+    double per_op;
+#if defined(ASCON_STATS)
+    ascon_stats_t stats = {0, 0, 0, 0};
+    ascon_stats_t *prev;
+#endif
+
+    if (info->prepare)
+        info->prepare(size);
+
+#if defined(ASCON_STATS)
+    /* Count the permutation calls for a single operation */
+    prev = ascon_stats_select(&stats);
+    info->run(size);
+    ascon_stats_select(prev);
+#endif
+
+    /* Double the number of loops until the run takes long enough */
+    for (;;) {
+        start = bench_now();
+        for (count = 0; count < loops; ++count)
+            info->run(size);
+        elapsed = bench_now() - start;
+        if (elapsed >= BENCH_TIME_NS)
+            break;
+        loops *= 2;
+    }
+
+    per_op = ((double)elapsed) / loops;
+    printf("%s,%s,%lu,%lu,%.2f,", ascon_backend_name(), info->name,
+           (unsigned long)size, loops, per_op);
+    if (size > 0)
+        printf("%.3f", per_op / size);
+#if defined(ASCON_STATS)
+    printf(",%lu,%lu,%lu,%lu", (unsigned long)stats.permutations,
+           (unsigned long)stats.rounds, (unsigned long)stats.absorbed,
+           (unsigned long)stats.squeezed);
+#endif
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    size_t index, size_index;
+    const char *filter = (argc > 1) ? argv[1] : 0;
+
+    for (index = 0; index < BENCH_MAX_SIZE; ++index)
+        input[index] = (unsigned char)index;
+    ascon_init(&perm_state);
+    ascon_table_hash_init_key(&table_key, key);
+    ascon128_siv_init_kek(&siv_kek, key, nonce);
+
+#if defined(ASCON_STATS)
+    printf("backend,primitive,bytes,loops,ns_per_op,ns_per_byte,"
+           "permutations,rounds,absorbed,squeezed\n");
+#else
+    printf("backend,primitive,bytes,loops,ns_per_op,ns_per_byte\n");
+#endif
+    for (index = 0; index < sizeof(benchmarks) / sizeof(benchmarks[0]);
+            ++index) {
+        if (filter && !strstr(benchmarks[index].name, filter))
+            continue;
+        if (!benchmarks[index].sized) {
+            benchmark(&benchmarks[index], 0);
+            continue;
+        }
+        for (size_index = 0;
+                size_index < sizeof(bench_sizes) / sizeof(bench_sizes[0]);
+                ++size_index) {
+            benchmark(&benchmarks[index], bench_sizes[size_index]);
+        }
+    }
+
+    ascon_table_hash_free_key(&table_key);
+    ascon128_siv_free_kek(&siv_kek);
+    ascon_free(&perm_state);
+    return 0;
+}
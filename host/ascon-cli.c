@@ -0,0 +1,479 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Command-line tool for bulk encryption and hashing of large files.
+ *
+ *      ascon hash [-j threads] [-c chunk-size] file...
+ *      ascon encrypt [-j threads] [-s segment-size] -k key input output
+ *      ascon decrypt [-j threads] -k key input output
+ *
+ * Files are memory-mapped and split into segments that are processed on
+ * a pool of threads.  Hashing uses the ASCON-XOF tree hashing mode with
+ * a 32 byte output, so the result matches ascon_xof_tree().  Encryption
+ * uses ASCON-128a in the segmented STREAM format from "ascon-aead-stream.h"
+ * with the following file layout:
+ *
+ *      "ASCS" || segment size (32-bit big-endian) || 11 byte nonce prefix
+ *      segment 0 || tag 0 || segment 1 || tag 1 || ... || last || tag
+ *
+ * The 19 byte header is passed as associated data to every segment so that
+ * it cannot be altered.  The key is given as 32 hexadecimal digits.
+ * The throughput in MB/s is reported on stderr. */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ASCON.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CLI_MAGIC "ASCS"
+#define CLI_HEADER_SIZE (4 + 4 + ASCON_STREAM_PREFIX_SIZE)
+#define CLI_DEFAULT_SEGMENT_SIZE (1024 * 1024)
+#define CLI_MAX_THREADS 256
+
+/* Memory-mapped view of a file */
+typedef struct
+{
+    unsigned char *data;
+    size_t size;
+    int fd;
+
+} cli_map_t;
+
+/* Work description for one thread in the pool */
+typedef struct
+{
+    /* Shared parameters for the operation */
+    const unsigned char *in;
+    unsigned char *out;
+    size_t in_size;
+    size_t unit_size;
+    const ascon128a_stream_state_t *stream;
+    const unsigned char *header;
+
+    /* Range of segments or chunks for this thread */
+    size_t first;
+    size_t count;
+
+    /* Result: 0 for success, -1 for an authentication failure */
+    int result;
+
+} cli_job_t;
+
+static unsigned long long cli_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((unsigned long long)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+static void cli_report(const char *op, const char *name,
+                       size_t bytes, unsigned long long start)
+{
+    double secs = (cli_now() - start) / 1e9;
+    double mb = bytes / (1024.0 * 1024.0);
+    fprintf(stderr, "%s %s: %.1f MB in %.3f s, %.1f MB/s\n",
+            op, name, mb, secs, secs > 0 ? mb / secs : 0.0);
+}
+
+static int cli_map_input(cli_map_t *map, const char *name)
+{
+    struct stat st;
+    map->data = 0;
+    map->size = 0;
+    map->fd = open(name, O_RDONLY);
+    if (map->fd < 0 || fstat(map->fd, &st) < 0) {
+        perror(name);
+        return 0;
+    }
+    map->size = (size_t)st.st_size;
+    if (map->size > 0) {
+        map->data = mmap(0, map->size, PROT_READ, MAP_SHARED, map->fd, 0);
+        if (map->data == MAP_FAILED) {
+            perror(name);
+            map->data = 0;
+            close(map->fd);
+            return 0;
+        }
+        posix_madvise(map->data, map->size, POSIX_MADV_SEQUENTIAL);
+    }
+    return 1;
+}
+
+static int cli_map_output(cli_map_t *map, const char *name, size_t size)
+{
+    map->data = 0;
+    map->size = size;
+    map->fd = open(name, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (map->fd < 0 || ftruncate(map->fd, (off_t)size) < 0) {
+        perror(name);
+        return 0;
+    }
+    if (size > 0) {
+        map->data = mmap(0, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, map->fd, 0);
+        if (map->data == MAP_FAILED) {
+            perror(name);
+            map->data = 0;
+            close(map->fd);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void cli_unmap(cli_map_t *map)
+{
+    if (map->data)
+        munmap(map->data, map->size);
+    if (map->fd >= 0)
+        close(map->fd);
+}
+
+/* Runs a worker function over "units" segments or chunks on a pool of
+ * threads, giving each thread a contiguous range of units */
+static int cli_run_jobs(void *(*worker)(void *), const cli_job_t *proto,
+                        size_t units, int threads)
+{
+    pthread_t ids[CLI_MAX_THREADS];
+    cli_job_t jobs[CLI_MAX_THREADS];
+    int started[CLI_MAX_THREADS];
+    int result = 0;
+    int index;
+    if ((size_t)threads > units)
+        threads = units > 0 ? (int)units : 1;
+    for (index = 0; index < threads; ++index) {
+        jobs[index] = *proto;
+        jobs[index].first = (units * index) / threads;
+        jobs[index].count =
+            (units * (index + 1)) / threads - jobs[index].first;
+        jobs[index].result = 0;
+        started[index] = (index > 0 &&
+            pthread_create(&ids[index], 0, worker, &jobs[index]) == 0);
+    }
+    worker(&jobs[0]);
+    for (index = 0; index < threads; ++index) {
+        if (started[index])
+            pthread_join(ids[index], 0);
+        else if (index > 0)
+            worker(&jobs[index]);
+        if (jobs[index].result != 0)
+            result = jobs[index].result;
+    }
+    return result;
+}
+
+static void *cli_hash_worker(void *arg)
+{
+    cli_job_t *job = (cli_job_t *)arg;
+    ascon_xof_tree_hash_chunks
+        (job->out + job->first * ASCON_XOF_TREE_CV_SIZE,
+         job->in + job->first * job->unit_size, job->count, job->unit_size);
+    return 0;
+}
+
+static int cli_hash(const char *name, size_t chunk_size, int threads)
+{
+    ascon_xof_tree_state_t state;
+    unsigned char hash[ASCON_HASH_SIZE];
+    unsigned char *cvs;
+    cli_job_t job;
+    cli_map_t map;
+    size_t chunks, index;
+    unsigned long long start = cli_now();
+    if (!cli_map_input(&map, name))
+        return 0;
+    chunks = map.size / chunk_size;
+    cvs = malloc(chunks * ASCON_XOF_TREE_CV_SIZE + 1);
+    if (!cvs) {
+        fprintf(stderr, "%s: out of memory\n", name);
+        cli_unmap(&map);
+        return 0;
+    }
+    memset(&job, 0, sizeof(job));
+    job.in = map.data;
+    job.out = cvs;
+    job.unit_size = chunk_size;
+    cli_run_jobs(cli_hash_worker, &job, chunks, threads);
+    ascon_xof_tree_init(&state, chunk_size, ASCON_HASH_SIZE);
+    ascon_xof_tree_absorb_cvs(&state, cvs, chunks);
+    ascon_xof_tree_absorb
+        (&state, map.data + chunks * chunk_size, map.size % chunk_size);
+    ascon_xof_tree_squeeze(&state, hash, sizeof(hash));
+    ascon_xof_tree_free(&state);
+    for (index = 0; index < sizeof(hash); ++index)
+        printf("%02x", hash[index]);
+    printf("  %s\n", name);
+    cli_report("hash", name, map.size, start);
+    free(cvs);
+    cli_unmap(&map);
+    return 1;
+}
+
+static void *cli_encrypt_worker(void *arg)
+{
+    cli_job_t *job = (cli_job_t *)arg;
+    ascon128a_stream_state_t stream = *(job->stream);
+    size_t segments = (job->in_size / job->unit_size) + 1;
+    size_t index, offset, len, clen;
+    ascon128a_stream_seek(&stream, (uint32_t)(job->first));
+    for (index = job->first; index < job->first + job->count; ++index) {
+        offset = index * job->unit_size;
+        len = job->in_size - offset;
+        if (len > job->unit_size)
+            len = job->unit_size;
+        ascon128a_stream_encrypt
+            (&stream, job->out + ASCON_STREAM_SEGMENT_OFFSET
+                (job->unit_size, index), &clen, job->in + offset, len,
+             job->header, CLI_HEADER_SIZE, index == (segments - 1));
+    }
+    ascon_clean(&stream, sizeof(stream));
+    return 0;
+}
+
+static void *cli_decrypt_worker(void *arg)
+{
+    cli_job_t *job = (cli_job_t *)arg;
+    ascon128a_stream_state_t stream = *(job->stream);
+    size_t record = job->unit_size + ASCON_STREAM_TAG_SIZE;
+    size_t segments = (job->in_size + record - 1) / record;
+    size_t index, offset, clen, mlen;
+    for (index = job->first; index < job->first + job->count; ++index) {
+        offset = ASCON_STREAM_SEGMENT_OFFSET(job->unit_size, index);
+        clen = job->in_size - offset;
+        if (clen > record)
+            clen = record;
+        if (ascon128a_stream_decrypt_at
+                (&stream, (uint32_t)index, job->out + index * job->unit_size,
+                 &mlen, job->in + offset, clen, job->header,
+                 CLI_HEADER_SIZE, index == (segments - 1)) != 0) {
+            job->result = -1;
+            break;
+        }
+    }
+    ascon_clean(&stream, sizeof(stream));
+    return 0;
+}
+
+static int cli_fill_prefix(unsigned char *prefix)
+{
+    FILE *file = fopen("/dev/urandom", "rb");
+    int ok = 0;
+    if (file) {
+        ok = fread(prefix, 1, ASCON_STREAM_PREFIX_SIZE, file) ==
+             ASCON_STREAM_PREFIX_SIZE;
+        fclose(file);
+    }
+    if (!ok)
+        ok = ascon_random(prefix, ASCON_STREAM_PREFIX_SIZE) >= 0;
+    return ok;
+}
+
+static int cli_encrypt(const char *in_name, const char *out_name,
+                       const unsigned char *key, size_t segment_size,
+                       int threads)
+{
+    ascon128a_stream_state_t stream;
+    unsigned char header[CLI_HEADER_SIZE];
+    cli_map_t in, out;
+    cli_job_t job;
+    size_t segments, out_size;
+    unsigned long long start = cli_now();
+    int ok = 0;
+    if (!cli_map_input(&in, in_name))
+        return 0;
+    segments = in.size / segment_size + 1;
+    if (segments > 0xFFFFFFFFU) {
+        fprintf(stderr, "%s: too many segments\n", in_name);
+        cli_unmap(&in);
+        return 0;
+    }
+    out_size = CLI_HEADER_SIZE + in.size + segments * ASCON_STREAM_TAG_SIZE;
+    memcpy(header, CLI_MAGIC, 4);
+    header[4] = (unsigned char)(segment_size >> 24);
+    header[5] = (unsigned char)(segment_size >> 16);
+    header[6] = (unsigned char)(segment_size >> 8);
+    header[7] = (unsigned char)segment_size;
+    if (!cli_fill_prefix(header + 8)) {
+        fprintf(stderr, "%s: cannot generate nonce prefix\n", in_name);
+    } else if (cli_map_output(&out, out_name, out_size)) {
+        ascon128a_stream_init(&stream, segment_size, header + 8, key);
+        memcpy(out.data, header, CLI_HEADER_SIZE);
+        memset(&job, 0, sizeof(job));
+        job.in = in.data;
+        job.out = out.data + CLI_HEADER_SIZE;
+        job.in_size = in.size;
+        job.unit_size = segment_size;
+        job.stream = &stream;
+        job.header = header;
+        cli_run_jobs(cli_encrypt_worker, &job, segments, threads);
+        ascon_clean(&stream, sizeof(stream));
+        cli_unmap(&out);
+        cli_report("encrypt", in_name, in.size, start);
+        ok = 1;
+    }
+    cli_unmap(&in);
+    return ok;
+}
+
+static int cli_decrypt(const char *in_name, const char *out_name,
+                       const unsigned char *key, int threads)
+{
+    ascon128a_stream_state_t stream;
+    cli_map_t in, out;
+    cli_job_t job;
+    size_t segment_size, segments, body, out_size;
+    unsigned long long start = cli_now();
+    int ok = 0;
+    if (!cli_map_input(&in, in_name))
+        return 0;
+    if (in.size < CLI_HEADER_SIZE + ASCON_STREAM_TAG_SIZE ||
+            memcmp(in.data, CLI_MAGIC, 4) != 0) {
+        fprintf(stderr, "%s: not an encrypted file\n", in_name);
+        cli_unmap(&in);
+        return 0;
+    }
+    segment_size = (((size_t)(in.data[4])) << 24) |
+                   (((size_t)(in.data[5])) << 16) |
+                   (((size_t)(in.data[6])) << 8) |
+                     ((size_t)(in.data[7]));
+    body = in.size - CLI_HEADER_SIZE;
+    segments = body / (segment_size + ASCON_STREAM_TAG_SIZE) + 1;
+    out_size = body - segments * ASCON_STREAM_TAG_SIZE;
+    if (segment_size == 0 || body < segments * ASCON_STREAM_TAG_SIZE ||
+            (out_size / segment_size + 1) != segments) {
+        fprintf(stderr, "%s: truncated or corrupt file\n", in_name);
+        cli_unmap(&in);
+        return 0;
+    }
+    if (cli_map_output(&out, out_name, out_size)) {
+        ascon128a_stream_init(&stream, segment_size, in.data + 8, key);
+        memset(&job, 0, sizeof(job));
+        job.in = in.data + CLI_HEADER_SIZE;
+        job.out = out.data;
+        job.in_size = body;
+        job.unit_size = segment_size;
+        job.stream = &stream;
+        job.header = in.data;
+        ok = cli_run_jobs(cli_decrypt_worker, &job, segments, threads) == 0;
+        ascon_clean(&stream, sizeof(stream));
+        cli_unmap(&out);
+        if (ok) {
+            cli_report("decrypt", in_name, out_size, start);
+        } else {
+            /* Do not leave unauthenticated plaintext behind */
+            fprintf(stderr, "%s: authentication failed\n", in_name);
+            unlink(out_name);
+        }
+    }
+    cli_unmap(&in);
+    return ok;
+}
+
+static int cli_parse_key(unsigned char *key, const char *hex)
+{
+    size_t index;
+    unsigned value;
+    if (!hex || strlen(hex) != ASCON128_KEY_SIZE * 2)
+        return 0;
+    for (index = 0; index < ASCON128_KEY_SIZE; ++index) {
+        if (sscanf(hex + index * 2, "%2x", &value) != 1)
+            return 0;
+        key[index] = (unsigned char)value;
+    }
+    return 1;
+}
+
+static void cli_usage(void)
+{
+    fprintf(stderr,
+        "Usage: ascon hash [-j threads] [-c chunk-size] file...\n"
+        "       ascon encrypt [-j threads] [-s segment-size] -k key "
+        "input output\n"
+        "       ascon decrypt [-j threads] -k key input output\n");
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned char key[ASCON128_KEY_SIZE];
+    const char *key_hex = 0;
+    const char *command;
+    size_t chunk_size = ASCON_XOF_TREE_CHUNK_SIZE;
+    size_t segment_size = CLI_DEFAULT_SEGMENT_SIZE;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int ok = 1;
+    int opt;
+    if (argc < 2) {
+        cli_usage();
+        return 1;
+    }
+    command = argv[1];
+    optind = 2;
+    while ((opt = getopt(argc, argv, "j:c:s:k:")) != -1) {
+        switch (opt) {
+        case 'j': threads = strtol(optarg, 0, 10); break;
+        case 'c': chunk_size = (size_t)strtoul(optarg, 0, 0); break;
+        case 's': segment_size = (size_t)strtoul(optarg, 0, 0); break;
+        case 'k': key_hex = optarg; break;
+        default:  cli_usage(); return 1;
+        }
+    }
+    if (threads < 1)
+        threads = 1;
+    else if (threads > CLI_MAX_THREADS)
+        threads = CLI_MAX_THREADS;
+    if (!strcmp(command, "hash") && optind < argc && chunk_size > 0) {
+        for (; optind < argc; ++optind)
+            ok &= cli_hash(argv[optind], chunk_size, (int)threads);
+    } else if ((!strcmp(command, "encrypt") || !strcmp(command, "decrypt"))
+                    && (argc - optind) == 2) {
+        if (!cli_parse_key(key, key_hex)) {
+            fprintf(stderr, "The key must be %d hexadecimal digits\n",
+                    ASCON128_KEY_SIZE * 2);
+            return 1;
+        }
+        if (segment_size == 0 || segment_size > 0xFFFFFFFFU) {
+            fprintf(stderr, "Invalid segment size\n");
+            return 1;
+        }
+        if (command[0] == 'e') {
+            ok = cli_encrypt(argv[optind], argv[optind + 1], key,
+                             segment_size, (int)threads);
+        } else {
+            ok = cli_decrypt(argv[optind], argv[optind + 1], key,
+                             (int)threads);
+        }
+        ascon_clean(key, sizeof(key));
+    } else {
+        cli_usage();
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
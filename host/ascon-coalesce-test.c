@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Host-side test for the coalescing scheduler in "ascon-coalesce.h".
+ *
+ *      ascon-coalesce-test
+ *
+ * Partial batches of every operation are compared with the one-shot
+ * functions, and hash requests are submitted from several threads at
+ * once while the main thread polls.  The exit status is non-zero if
+ * any check failed. */
+
+#include <ASCON.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_MAX_MSG        64
+#define TEST_MAX_LANES      8
+#define TEST_THREADS        4
+#define TEST_PER_THREAD     500
+#define TEST_DEADLINE       100
+
+/* Fake clock that only moves when the test advances it */
+static unsigned long test_now;
+
+static unsigned long test_clock(void)
+{
+    return __atomic_load_n(&test_now, __ATOMIC_RELAXED);
+}
+
+static void report(const char *name, unsigned long failures)
+{
+    printf("%s,%s,%lu\n", name, failures ? "FAILED" : "ok", failures);
+}
+
+/* Counts the number of times that each request has been completed */
+static void test_callback(ascon_coalesce_request_t *request)
+{
+    ++(*((unsigned *)(request->user_data)));
+}
+
+/* Fills in a request with a message and a callback */
+static void test_request
+    (ascon_coalesce_request_t *request, unsigned char *in, size_t inlen,
+     unsigned char *out, unsigned *completions)
+{
+    memset(request, 0, sizeof(ascon_coalesce_request_t));
+    request->msg.in = in;
+    request->msg.inlen = inlen;
+    request->msg.out = out;
+    request->callback = test_callback;
+    request->user_data = completions;
+    *completions = 0;
+}
+
+/* Runs a partial batch of "count" requests through the scheduler and
+ * returns the number of requests that did not match the one-shot
+ * function.  With "deadline" set, the batch is dispatched by its age
+ * rather than by flushing. */
+static unsigned long check_partial(int op, unsigned count, int deadline)
+{
+    static unsigned char msgs[TEST_MAX_LANES][TEST_MAX_MSG + 16];
+    static unsigned char outs[TEST_MAX_LANES][TEST_MAX_MSG + 16];
+    static unsigned char expected[TEST_MAX_MSG + 16];
+    static unsigned char key[16], nonce[16];
+    ascon_coalesce_request_t requests[TEST_MAX_LANES];
+    unsigned completions[TEST_MAX_LANES];
+    ascon_coalesce_t sched;
+    unsigned long failures = 0;
+    unsigned completed, i;
+    size_t len, explen;
+    int result;
+
+    if (ascon_coalesce_init(&sched, op, TEST_DEADLINE, test_clock) < 0)
+        return 0;
+    for (i = 0; i < 16; ++i) {
+        key[i] = (unsigned char)(op * 16 + i);
+        nonce[i] = (unsigned char)(0xA0 + i);
+    }
+    for (i = 0; i < count; ++i) {
+        len = (i * 13 + (unsigned)op * 7) % (TEST_MAX_MSG + 1);
+        memset(msgs[i], (int)(i + 1), len);
+        if (op == ASCON_COALESCE_ASCON128_DECRYPT ||
+                op == ASCON_COALESCE_ASCON128A_DECRYPT) {
+            /* Encrypt the message first to get something to decrypt,
+             * and corrupt the tag of the last one */
+            memcpy(expected, msgs[i], len);
+            if (op == ASCON_COALESCE_ASCON128_DECRYPT) {
+                ascon128_aead_encrypt
+                    (msgs[i], &len, expected, len, key, 8, nonce, key);
+            } else {
+                ascon128a_aead_encrypt
+                    (msgs[i], &len, expected, len, key, 8, nonce, key);
+            }
+            if (i == (count - 1))
+                msgs[i][len - 1] ^= 0x01;
+        }
+        test_request(&requests[i], msgs[i], len, outs[i], &completions[i]);
+        requests[i].msg.ad = key;
+        requests[i].msg.adlen = 8;
+        requests[i].msg.npub = nonce;
+        requests[i].msg.k = key;
+        ascon_coalesce_submit(&sched, &requests[i]);
+    }
+
+    /* A partial batch must wait for the deadline or a flush */
+    completed = ascon_coalesce_poll(&sched, 0);
+    if (count < sched.lanes && completed != 0)
+        ++failures;
+    if (deadline) {
+        __atomic_add_fetch(&test_now, TEST_DEADLINE, __ATOMIC_RELAXED);
+        completed += ascon_coalesce_poll(&sched, 0);
+    } else {
+        completed += ascon_coalesce_poll(&sched, 1);
+    }
+    if (completed != count)
+        ++failures;
+
+    /* Compare the results with the one-shot functions */
+    for (i = 0; i < count; ++i) {
+        ascon_aead_batch_t *msg = &(requests[i].msg);
+        result = 0;
+        switch (op) {
+        case ASCON_COALESCE_ASCON128_ENCRYPT:
+            ascon128_aead_encrypt
+                (expected, &explen, msg->in, msg->inlen, key, 8, nonce, key);
+            break;
+        case ASCON_COALESCE_ASCON128A_ENCRYPT:
+            ascon128a_aead_encrypt
+                (expected, &explen, msg->in, msg->inlen, key, 8, nonce, key);
+            break;
+        case ASCON_COALESCE_ASCON128_DECRYPT:
+            result = ascon128_aead_decrypt
+                (expected, &explen, msg->in, msg->inlen, key, 8, nonce, key);
+            break;
+        case ASCON_COALESCE_ASCON128A_DECRYPT:
+            result = ascon128a_aead_decrypt
+                (expected, &explen, msg->in, msg->inlen, key, 8, nonce, key);
+            break;
+        case ASCON_COALESCE_HASH:
+            ascon_hash(expected, msg->in, msg->inlen);
+            explen = ASCON_HASH_SIZE;
+            break;
+        default:
+            ascon_hasha(expected, msg->in, msg->inlen);
+            explen = ASCON_HASHA_SIZE;
+            break;
+        }
+        if (completions[i] != 1 || msg->result != result ||
+                msg->outlen != explen ||
+                (result == 0 && memcmp(outs[i], expected, explen) != 0))
+            ++failures;
+    }
+    ascon_coalesce_free(&sched);
+    return failures;
+}
+
+/* State for the threads that submit hash requests */
+typedef struct
+{
+    ascon_coalesce_t *sched;
+    ascon_coalesce_request_t requests[TEST_PER_THREAD];
+    unsigned char msgs[TEST_PER_THREAD][TEST_MAX_MSG];
+    unsigned char outs[TEST_PER_THREAD][ASCON_HASH_SIZE];
+    unsigned completions[TEST_PER_THREAD];
+    unsigned thread;
+
+} test_thread_t;
+
+static void *test_submit_thread(void *arg)
+{
+    test_thread_t *t = (test_thread_t *)arg;
+    unsigned i;
+    for (i = 0; i < TEST_PER_THREAD; ++i) {
+        memset(t->msgs[i], (int)(t->thread * 31 + i), TEST_MAX_MSG);
+        t->msgs[i][0] = (unsigned char)(i >> 8);
+        t->msgs[i][1] = (unsigned char)(t->thread);
+        test_request(&(t->requests[i]), t->msgs[i], i % (TEST_MAX_MSG + 1),
+                     t->outs[i], &(t->completions[i]));
+        ascon_coalesce_submit(t->sched, &(t->requests[i]));
+    }
+    return 0;
+}
+
+/* Submits hash requests from several threads while this thread polls */
+static unsigned long check_threads(void)
+{
+    static test_thread_t threads[TEST_THREADS];
+    pthread_t ids[TEST_THREADS];
+    ascon_coalesce_t sched;
+    unsigned char expected[ASCON_HASH_SIZE];
+    unsigned long failures = 0;
+    unsigned long completed = 0;
+    unsigned t, i;
+
+    if (ascon_coalesce_init(&sched, ASCON_COALESCE_HASH, 0, test_clock) < 0)
+        return 0;
+    for (t = 0; t < TEST_THREADS; ++t) {
+        threads[t].sched = &sched;
+        threads[t].thread = t;
+        if (pthread_create(&ids[t], 0, test_submit_thread, &threads[t]) != 0)
+            return 1;
+    }
+    while (completed < (unsigned long)TEST_THREADS * TEST_PER_THREAD)
+        completed += ascon_coalesce_poll(&sched, 0);
+    for (t = 0; t < TEST_THREADS; ++t)
+        pthread_join(ids[t], 0);
+    completed += ascon_coalesce_poll(&sched, 1);
+    ascon_coalesce_free(&sched);
+    if (completed != (unsigned long)TEST_THREADS * TEST_PER_THREAD)
+        ++failures;
+
+    /* Every request must be completed exactly once with the right hash */
+    for (t = 0; t < TEST_THREADS; ++t) {
+        for (i = 0; i < TEST_PER_THREAD; ++i) {
+            ascon_aead_batch_t *msg = &(threads[t].requests[i].msg);
+            ascon_hash(expected, msg->in, msg->inlen);
+            if (threads[t].completions[i] != 1 ||
+                    msg->outlen != ASCON_HASH_SIZE ||
+                    memcmp(threads[t].outs[i], expected,
+                           ASCON_HASH_SIZE) != 0)
+                ++failures;
+        }
+    }
+    return failures;
+}
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        int op;
+    } ops[] = {
+        {"ascon128-encrypt", ASCON_COALESCE_ASCON128_ENCRYPT},
+        {"ascon128-decrypt", ASCON_COALESCE_ASCON128_DECRYPT},
+        {"ascon128a-encrypt", ASCON_COALESCE_ASCON128A_ENCRYPT},
+        {"ascon128a-decrypt", ASCON_COALESCE_ASCON128A_DECRYPT},
+        {"hash", ASCON_COALESCE_HASH},
+        {"hasha", ASCON_COALESCE_HASHA}
+    };
+    unsigned long failures;
+    unsigned long total = 0;
+    unsigned index, count;
+
+    printf("check,status,failures\n");
+    for (index = 0; index < sizeof(ops) / sizeof(ops[0]); ++index) {
+        /* Every batch size up to a full one, flushed or timed out */
+        failures = 0;
+        for (count = 1; count <= TEST_MAX_LANES; ++count) {
+            failures += check_partial(ops[index].op, count, 0);
+            failures += check_partial(ops[index].op, count, 1);
+        }
+        report(ops[index].name, failures);
+        total += failures;
+    }
+    failures = check_threads();
+    report("threads", failures);
+    total += failures;
+    return total ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Host-side differential conformance test for the ASCON back ends.
+ * This is built once for each back end that can be forced on the host,
+ * and once for the default back end, which may be a SIMD back end.
+ *
+ *      ascon-conformance [iterations [seed]]
+ *
+ * The exit status is non-zero if any check failed. */
+
+#include "ascon-conformance.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CONF_DEFAULT_ITERATIONS 10000UL
+
+/* Large batches of messages with the same length, to exercise the
+ * bitsliced engine for uniform batches on 64-bit scalar back ends.
+ * One more group than the engine holds is left over for the lanes. */
+#define CONF_UNIFORM_BATCH 70
+#define CONF_UNIFORM_MSG 40
+
+static unsigned long check_uniform_batch(void)
+{
+    static unsigned char msgs[CONF_UNIFORM_BATCH][CONF_UNIFORM_MSG];
+    static unsigned char outs[CONF_UNIFORM_BATCH][CONF_UNIFORM_MSG + 16];
+    static unsigned char plain[CONF_UNIFORM_BATCH][CONF_UNIFORM_MSG];
+    static unsigned char keys[CONF_UNIFORM_BATCH][16];
+    static unsigned char hashes[CONF_UNIFORM_BATCH * ASCON_HASH_SIZE];
+    const unsigned char *ptrs[CONF_UNIFORM_BATCH];
+    size_t lens[CONF_UNIFORM_BATCH];
+    ascon_aead_batch_t batch[CONF_UNIFORM_BATCH];
+    unsigned char single[CONF_UNIFORM_MSG + 16];
+    unsigned long failures = 0;
+    unsigned len = conf_random() % (CONF_UNIFORM_MSG + 1);
+    unsigned adlen = conf_random() % (CONF_UNIFORM_MSG + 1);
+    unsigned variant, i;
+    size_t clen;
+    int result;
+
+    for (i = 0; i < CONF_UNIFORM_BATCH; ++i) {
+        conf_random_bytes(msgs[i], CONF_UNIFORM_MSG);
+        conf_random_bytes(keys[i], 16);
+        ptrs[i] = msgs[i];
+        lens[i] = len;
+    }
+    ascon_hash_many(hashes, ptrs, lens, CONF_UNIFORM_BATCH);
+    for (i = 0; i < CONF_UNIFORM_BATCH; ++i) {
+        conf_ref_hash(single, msgs[i], len, 0);
+        if (memcmp(single, hashes + i * ASCON_HASH_SIZE, ASCON_HASH_SIZE))
+            ++failures;
+    }
+    ascon_hasha_many(hashes, ptrs, lens, CONF_UNIFORM_BATCH);
+    for (i = 0; i < CONF_UNIFORM_BATCH; ++i) {
+        conf_ref_hash(single, msgs[i], len, 4);
+        if (memcmp(single, hashes + i * ASCON_HASHA_SIZE, ASCON_HASHA_SIZE))
+            ++failures;
+    }
+
+    /* ASCON-128 and ASCON-128a with a different key for each message,
+     * and then decryption with one corrupted tag */
+    for (variant = 0; variant < 2; ++variant) {
+        for (i = 0; i < CONF_UNIFORM_BATCH; ++i) {
+            batch[i].out = outs[i];
+            batch[i].in = msgs[i];
+            batch[i].inlen = len;
+            batch[i].ad = msgs[(i + 1) % CONF_UNIFORM_BATCH];
+            batch[i].adlen = adlen;
+            batch[i].npub = keys[(i + 2) % CONF_UNIFORM_BATCH];
+            batch[i].k = keys[i];
+        }
+        if (variant)
+            ascon128a_aead_encrypt_batch(batch, CONF_UNIFORM_BATCH);
+        else
+            ascon128_aead_encrypt_batch(batch, CONF_UNIFORM_BATCH);
+        for (i = 0; i < CONF_UNIFORM_BATCH; ++i) {
+            if (variant) {
+                ascon128a_aead_encrypt
+                    (single, &clen, batch[i].in, len, batch[i].ad, adlen,
+                     batch[i].npub, batch[i].k);
+            } else {
+                ascon128_aead_encrypt
+                    (single, &clen, batch[i].in, len, batch[i].ad, adlen,
+                     batch[i].npub, batch[i].k);
+            }
+            if (clen != batch[i].outlen || memcmp(single, outs[i], clen))
+                ++failures;
+            batch[i].in = outs[i];
+            batch[i].inlen = clen;
+            batch[i].out = plain[i];
+        }
+        outs[3][len] ^= 0x01;
+        if (variant)
+            result = ascon128a_aead_decrypt_batch(batch, CONF_UNIFORM_BATCH);
+        else
+            result = ascon128_aead_decrypt_batch(batch, CONF_UNIFORM_BATCH);
+        if (result != -1)
+            ++failures;
+        for (i = 0; i < CONF_UNIFORM_BATCH; ++i) {
+            if (batch[i].result != (i == 3 ? -1 : 0) ||
+                    batch[i].outlen != len)
+                ++failures;
+            else if (i != 3 && memcmp(plain[i], msgs[i], len) != 0)
+                ++failures;
+        }
+    }
+    return failures;
+}
+
+static void report(const char *name, unsigned long failures)
+{
+    printf("%s,%s,%s,%lu\n", ascon_backend_name(), name,
+           failures ? "FAILED" : "ok", failures);
+}
+
+int main(int argc, char *argv[])
+{
+    conformance_results_t results;
+    unsigned long iterations = CONF_DEFAULT_ITERATIONS;
+    unsigned long uniform = 0;
+    unsigned long iter;
+    uint32_t seed = 0x41534F4EUL;
+
+    if (argc > 1)
+        iterations = strtoul(argv[1], 0, 0);
+    if (argc > 2)
+        seed = (uint32_t)strtoul(argv[2], 0, 0);
+
+    conformance_run(iterations, seed, &results);
+    for (iter = 0; iter < iterations; iter += 100)
+        uniform += check_uniform_batch();
+
+    printf("backend,check,status,failures\n");
+    report("permute", results.permute);
+    report("add-bytes", results.bytes);
+    report("permute-x2", results.x2);
+    report("permute-x4", results.x4);
+    report("permute-x8", results.x8);
+    report("hash-many", results.hash_many);
+    report("hasha-many", results.hasha_many);
+    report("aead-128a-batch", results.aead_batch);
+    report("uniform-batch", uniform);
+    report("sp800-232", results.sp800_232);
+    return (conformance_failures(&results) || uniform) ? 1 : 0;
+}
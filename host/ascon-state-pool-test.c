@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Host-side test for the private state pool in "ascon-state-pool.h".
+ *
+ *      ascon-state-pool-test
+ *
+ * No built-in back end needs more than 40 bytes of state, so this is
+ * built with ASCON_BACKEND_PRIVATE_SIZE and ASCON_STATE_POOL_NO_MALLOC
+ * defined to compile the pool on its own.  It checks allocation and
+ * freeing, exhaustion of the static arena, the allocator registered
+ * with ascon_set_state_allocator(), and allocation from several threads
+ * at once.  The exit status is non-zero if any check failed. */
+
+#include <ASCON.h>
+#include "utility/ascon-state-pool.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(ASCON_BACKEND_PRIVATE_SIZE) || \
+    !defined(ASCON_STATE_POOL_NO_MALLOC)
+#error "Build with ASCON_BACKEND_PRIVATE_SIZE and ASCON_STATE_POOL_NO_MALLOC"
+#endif
+
+#define TEST_THREADS        4
+#define TEST_ITERATIONS     100000
+
+static void report(const char *name, unsigned long failures)
+{
+    printf("%s,%s,%lu\n", name, failures ? "FAILED" : "ok", failures);
+}
+
+/* Returns non-zero if all bytes of a private state are "value" */
+static int all_bytes(const void *ptr, unsigned char value)
+{
+    const unsigned char *p = (const unsigned char *)ptr;
+    unsigned i;
+    for (i = 0; i < ASCON_BACKEND_PRIVATE_SIZE; ++i) {
+        if (p[i] != value)
+            return 0;
+    }
+    return 1;
+}
+
+/* Allocates every entry in the arena, checks that the arena is then
+ * empty, and that the entries are cleaned and reused after being freed */
+static unsigned long check_arena(void)
+{
+    void *entries[ASCON_STATE_POOL_SIZE];
+    unsigned long failures = 0;
+    unsigned i, j;
+    void *ptr;
+
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i) {
+        entries[i] = ascon_state_pool_alloc();
+        if (!entries[i] || ((size_t)(entries[i]) % sizeof(void *)) != 0) {
+            ++failures;
+            continue;
+        }
+        for (j = 0; j < i; ++j) {
+            if (entries[j] == entries[i])
+                ++failures;
+        }
+        memset(entries[i], 0xA5, ASCON_BACKEND_PRIVATE_SIZE);
+    }
+    if (failures)
+        return failures;
+
+    /* The arena is exhausted and there is no heap fallback */
+    if (ascon_state_pool_alloc() != 0)
+        ++failures;
+
+    /* A freed entry is cleaned and is the next one to be handed out */
+    ascon_state_pool_free(entries[1]);
+    if (!all_bytes(entries[1], 0))
+        ++failures;
+    ptr = ascon_state_pool_alloc();
+    if (ptr != entries[1])
+        ++failures;
+    if (ascon_state_pool_alloc() != 0)
+        ++failures;
+
+    /* Free everything and check that the whole arena can be reused */
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i)
+        ascon_state_pool_free(entries[i]);
+    ascon_state_pool_free(0);
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i) {
+        entries[i] = ascon_state_pool_alloc();
+        if (!entries[i])
+            ++failures;
+    }
+    if (ascon_state_pool_alloc() != 0)
+        ++failures;
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i)
+        ascon_state_pool_free(entries[i]);
+    return failures;
+}
+
+/* Allocator that counts its calls and checks that states are cleaned */
+static unsigned custom_allocs;
+static unsigned custom_deallocs;
+static unsigned custom_bad;
+
+static void *custom_alloc(size_t size)
+{
+    ++custom_allocs;
+    if (size != ASCON_BACKEND_PRIVATE_SIZE)
+        ++custom_bad;
+    return malloc(size);
+}
+
+static void custom_dealloc(void *ptr, size_t size)
+{
+    ++custom_deallocs;
+    if (size != ASCON_BACKEND_PRIVATE_SIZE || !all_bytes(ptr, 0))
+        ++custom_bad;
+    free(ptr);
+}
+
+/* Checks that a registered allocator replaces the arena, and that
+ * removing it goes back to the arena */
+static unsigned long check_custom(void)
+{
+    void *entries[ASCON_STATE_POOL_SIZE + 2];
+    unsigned long failures = 0;
+    unsigned i;
+
+    ascon_set_state_allocator(custom_alloc, custom_dealloc);
+    for (i = 0; i < ASCON_STATE_POOL_SIZE + 2; ++i) {
+        entries[i] = ascon_state_pool_alloc();
+        if (!entries[i])
+            ++failures;
+        else
+            memset(entries[i], 0x5A, ASCON_BACKEND_PRIVATE_SIZE);
+    }
+    for (i = 0; i < ASCON_STATE_POOL_SIZE + 2; ++i)
+        ascon_state_pool_free(entries[i]);
+    if (custom_allocs != ASCON_STATE_POOL_SIZE + 2 ||
+            custom_deallocs != ASCON_STATE_POOL_SIZE + 2 || custom_bad)
+        ++failures;
+
+    /* Registering only one of the functions resets to the arena */
+    ascon_set_state_allocator(custom_alloc, 0);
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i) {
+        entries[i] = ascon_state_pool_alloc();
+        if (!entries[i])
+            ++failures;
+    }
+    if (ascon_state_pool_alloc() != 0)
+        ++failures;
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i)
+        ascon_state_pool_free(entries[i]);
+    if (custom_allocs != ASCON_STATE_POOL_SIZE + 2 ||
+            custom_deallocs != ASCON_STATE_POOL_SIZE + 2)
+        ++failures;
+    return failures;
+}
+
+/* Each thread repeatedly allocates an entry, fills it with its own
+ * pattern, and checks that no other thread wrote to it before freeing.
+ * Entries are cleaned when they are freed, so an entry that was handed
+ * to two threads at once also shows up as not being zero on allocation. */
+static unsigned long thread_failures[TEST_THREADS];
+
+static void *test_thread(void *arg)
+{
+    unsigned thread = (unsigned)(size_t)arg;
+    unsigned char pattern = (unsigned char)(thread + 1);
+    unsigned long i;
+    void *ptr;
+    for (i = 0; i < TEST_ITERATIONS; ++i) {
+        ptr = ascon_state_pool_alloc();
+        if (!ptr)
+            continue; /* Other threads have the rest of the arena */
+        if (!all_bytes(ptr, 0))
+            ++(thread_failures[thread]);
+        memset(ptr, pattern, ASCON_BACKEND_PRIVATE_SIZE);
+        if (!all_bytes(ptr, pattern))
+            ++(thread_failures[thread]);
+        ascon_state_pool_free(ptr);
+    }
+    return 0;
+}
+
+static unsigned long check_threads(void)
+{
+    pthread_t threads[TEST_THREADS];
+    void *entries[ASCON_STATE_POOL_SIZE];
+    unsigned long failures = 0;
+    unsigned i;
+    for (i = 0; i < TEST_THREADS; ++i)
+        pthread_create(&threads[i], 0, test_thread, (void *)(size_t)i);
+    for (i = 0; i < TEST_THREADS; ++i) {
+        pthread_join(threads[i], 0);
+        failures += thread_failures[i];
+    }
+
+    /* Every entry must be back on the free list exactly once */
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i) {
+        entries[i] = ascon_state_pool_alloc();
+        if (!entries[i] || !all_bytes(entries[i], 0))
+            ++failures;
+    }
+    if (ascon_state_pool_alloc() != 0)
+        ++failures;
+    for (i = 0; i < ASCON_STATE_POOL_SIZE; ++i)
+        ascon_state_pool_free(entries[i]);
+    return failures;
+}
+
+int main(void)
+{
+    unsigned long failures;
+    unsigned long total = 0;
+
+    failures = check_arena();
+    report("arena", failures);
+    total += failures;
+
+    failures = check_custom();
+    report("custom-allocator", failures);
+    total += failures;
+
+    failures = check_threads();
+    report("threads", failures);
+    total += failures;
+
+    return total ? 1 : 0;
+}
@@ -0,0 +1,969 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* OpenSSL 3 provider that exposes the ASCON algorithms through the EVP
+ * interfaces.  Load it with "-provider ascon" on the command line or
+ * OSSL_PROVIDER_load(NULL, "ascon") in code.  The following algorithms
+ * are registered:
+ *
+ *     EVP_CIPHER   ASCON-128, ASCON-128A, ASCON-80PQ
+ *     EVP_MD       ASCON-HASH, ASCON-HASHA, ASCON-XOF, ASCON-XOFA
+ *     EVP_MAC      ASCON-MAC, ASCON-PRF
+ *
+ * The ciphers are AEAD ciphers with a 16 byte nonce and tag that are
+ * used like AES-GCM: associated data is passed to EVP_CipherUpdate()
+ * with a NULL output buffer, and the tag is retrieved or set with the
+ * OSSL_CIPHER_PARAM_AEAD_TAG parameter.  The payload is processed with
+ * the incremental AEAD functions, which use the fastest back end that
+ * the library was compiled with. */
+
+#include "ASCON.h"
+#include <openssl/core.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+#include <openssl/proverr.h>
+#include <openssl/evp.h>
+#include <string.h>
+
+/* Version string that is reported by the provider */
+#ifndef ASCON_PROV_VERSION
+#define ASCON_PROV_VERSION "0.1.0"
+#endif
+
+/* ---------------------------------------------------------------- */
+/*                          AEAD ciphers                            */
+/* ---------------------------------------------------------------- */
+
+/* Operations on the incremental state for one of the AEAD variants */
+typedef struct
+{
+    size_t key_size;
+    void (*start_ad)(void *state, const unsigned char *npub,
+                     const unsigned char *k);
+    void (*ad_update)(void *state, const unsigned char *ad, size_t adlen);
+    void (*ad_finish)(void *state);
+    void (*abort)(void *state);
+    void (*encrypt_block)(void *state, const unsigned char *in,
+                          unsigned char *out, size_t len);
+    void (*encrypt_finalize)(void *state, unsigned char *tag);
+    void (*decrypt_block)(void *state, const unsigned char *in,
+                          unsigned char *out, size_t len);
+    int (*decrypt_finalize)(void *state, const unsigned char *tag);
+
+} ascon_prov_aead_ops_t;
+
+/* Defines the wrappers and the operations table for an AEAD variant */
+#define ASCON_PROV_AEAD_OPS(alg, state_type, key_size) \
+    static void alg##_prov_start_ad \
+        (void *state, const unsigned char *npub, const unsigned char *k) \
+    { \
+        alg##_start_ad((state_type *)state, npub, k); \
+    } \
+    static void alg##_prov_ad_update \
+        (void *state, const unsigned char *ad, size_t adlen) \
+    { \
+        alg##_ad_update((state_type *)state, ad, adlen); \
+    } \
+    static void alg##_prov_ad_finish(void *state) \
+    { \
+        alg##_ad_finish((state_type *)state); \
+    } \
+    static void alg##_prov_abort(void *state) \
+    { \
+        alg##_abort((state_type *)state); \
+    } \
+    static void alg##_prov_encrypt_block \
+        (void *state, const unsigned char *in, unsigned char *out, \
+         size_t len) \
+    { \
+        alg##_encrypt_block((state_type *)state, in, out, len); \
+    } \
+    static void alg##_prov_encrypt_finalize(void *state, unsigned char *tag) \
+    { \
+        alg##_encrypt_finalize((state_type *)state, tag); \
+    } \
+    static void alg##_prov_decrypt_block \
+        (void *state, const unsigned char *in, unsigned char *out, \
+         size_t len) \
+    { \
+        alg##_decrypt_block((state_type *)state, in, out, len); \
+    } \
+    static int alg##_prov_decrypt_finalize \
+        (void *state, const unsigned char *tag) \
+    { \
+        return alg##_decrypt_finalize((state_type *)state, tag); \
+    } \
+    static const ascon_prov_aead_ops_t alg##_prov_ops = { \
+        (key_size), \
+        alg##_prov_start_ad, \
+        alg##_prov_ad_update, \
+        alg##_prov_ad_finish, \
+        alg##_prov_abort, \
+        alg##_prov_encrypt_block, \
+        alg##_prov_encrypt_finalize, \
+        alg##_prov_decrypt_block, \
+        alg##_prov_decrypt_finalize \
+    }
+
+ASCON_PROV_AEAD_OPS(ascon128_aead, ascon128_state_t, ASCON128_KEY_SIZE);
+ASCON_PROV_AEAD_OPS(ascon128a_aead, ascon128a_state_t, ASCON128_KEY_SIZE);
+ASCON_PROV_AEAD_OPS(ascon80pq_aead, ascon80pq_state_t, ASCON80PQ_KEY_SIZE);
+
+/* Context for an AEAD cipher operation */
+typedef struct
+{
+    const ascon_prov_aead_ops_t *ops;
+    union {
+        ascon128_state_t s128;
+        ascon128a_state_t s128a;
+        ascon80pq_state_t s80pq;
+    } state;
+    unsigned char key[ASCON80PQ_KEY_SIZE];
+    unsigned char nonce[ASCON128_NONCE_SIZE];
+    unsigned char tag[ASCON128_TAG_SIZE];
+    unsigned char have_key;
+    unsigned char have_nonce;
+    unsigned char have_tag;
+    unsigned char started;
+    unsigned char ad_finished;
+    unsigned char finalized;
+    unsigned char encrypt;
+
+} ascon_prov_cipher_t;
+
+static void *ascon_prov_cipher_newctx(const ascon_prov_aead_ops_t *ops)
+{
+    ascon_prov_cipher_t *ctx = OPENSSL_zalloc(sizeof(ascon_prov_cipher_t));
+    if (ctx)
+        ctx->ops = ops;
+    return ctx;
+}
+
+static void ascon_prov_cipher_freectx(void *vctx)
+{
+    ascon_prov_cipher_t *ctx = (ascon_prov_cipher_t *)vctx;
+    if (ctx) {
+        if (ctx->started)
+            ctx->ops->abort(&(ctx->state));
+        OPENSSL_clear_free(ctx, sizeof(ascon_prov_cipher_t));
+    }
+}
+
+static void *ascon_prov_cipher_dupctx(void *vctx)
+{
+    ascon_prov_cipher_t *ctx = (ascon_prov_cipher_t *)vctx;
+    ascon_prov_cipher_t *dup = OPENSSL_malloc(sizeof(ascon_prov_cipher_t));
+    if (dup) {
+        /* The permutation state is always the first member of the
+         * incremental state, so ascon_copy() can copy any variant */
+        memcpy(dup, ctx, sizeof(ascon_prov_cipher_t));
+        if (ctx->started) {
+            ascon_copy(&(dup->state.s128.state),
+                       &(ctx->state.s128.state));
+        }
+    }
+    return dup;
+}
+
+static int ascon_prov_cipher_set_ctx_params
+    (void *vctx, const OSSL_PARAM params[]);
+
+static int ascon_prov_cipher_init
+    (ascon_prov_cipher_t *ctx, const unsigned char *key, size_t keylen,
+     const unsigned char *iv, size_t ivlen, const OSSL_PARAM params[],
+     int encrypt)
+{
+    if (key) {
+        if (keylen != ctx->ops->key_size) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+            return 0;
+        }
+        memcpy(ctx->key, key, keylen);
+        ctx->have_key = 1;
+    }
+    if (iv) {
+        if (ivlen != ASCON128_NONCE_SIZE) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_IV_LENGTH);
+            return 0;
+        }
+        memcpy(ctx->nonce, iv, ivlen);
+        ctx->have_nonce = 1;
+    }
+    ctx->encrypt = (unsigned char)encrypt;
+
+    /* Restart the operation once we have both the key and the nonce */
+    if (ctx->have_key && ctx->have_nonce && (key || iv)) {
+        if (ctx->started)
+            ctx->ops->abort(&(ctx->state));
+        ctx->ops->start_ad(&(ctx->state), ctx->nonce, ctx->key);
+        ctx->started = 1;
+        ctx->ad_finished = 0;
+        ctx->finalized = 0;
+        ctx->have_tag = 0;
+    }
+    return ascon_prov_cipher_set_ctx_params(ctx, params);
+}
+
+static int ascon_prov_cipher_encrypt_init
+    (void *vctx, const unsigned char *key, size_t keylen,
+     const unsigned char *iv, size_t ivlen, const OSSL_PARAM params[])
+{
+    return ascon_prov_cipher_init
+        ((ascon_prov_cipher_t *)vctx, key, keylen, iv, ivlen, params, 1);
+}
+
+static int ascon_prov_cipher_decrypt_init
+    (void *vctx, const unsigned char *key, size_t keylen,
+     const unsigned char *iv, size_t ivlen, const OSSL_PARAM params[])
+{
+    return ascon_prov_cipher_init
+        ((ascon_prov_cipher_t *)vctx, key, keylen, iv, ivlen, params, 0);
+}
+
+static int ascon_prov_cipher_update
+    (void *vctx, unsigned char *out, size_t *outl, size_t outsize,
+     const unsigned char *in, size_t inl)
+{
+    ascon_prov_cipher_t *ctx = (ascon_prov_cipher_t *)vctx;
+    if (!ctx->started || ctx->finalized) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_NO_KEY_SET);
+        return 0;
+    }
+    if (!out) {
+        /* A NULL output buffer indicates associated data, as with GCM */
+        if (ctx->ad_finished) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_STATE);
+            return 0;
+        }
+        ctx->ops->ad_update(&(ctx->state), in, inl);
+        *outl = inl;
+        return 1;
+    }
+    if (outsize < inl) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    if (!ctx->ad_finished) {
+        ctx->ops->ad_finish(&(ctx->state));
+        ctx->ad_finished = 1;
+    }
+    if (ctx->encrypt)
+        ctx->ops->encrypt_block(&(ctx->state), in, out, inl);
+    else
+        ctx->ops->decrypt_block(&(ctx->state), in, out, inl);
+    *outl = inl;
+    return 1;
+}
+
+static int ascon_prov_cipher_final
+    (void *vctx, unsigned char *out, size_t *outl, size_t outsize)
+{
+    ascon_prov_cipher_t *ctx = (ascon_prov_cipher_t *)vctx;
+    int result;
+    (void)out;
+    (void)outsize;
+    if (!ctx->started || ctx->finalized) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_NO_KEY_SET);
+        return 0;
+    }
+    if (!ctx->encrypt && !ctx->have_tag) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_TAG_NOT_SET);
+        return 0;
+    }
+    if (!ctx->ad_finished) {
+        ctx->ops->ad_finish(&(ctx->state));
+        ctx->ad_finished = 1;
+    }
+    if (ctx->encrypt) {
+        ctx->ops->encrypt_finalize(&(ctx->state), ctx->tag);
+        ctx->have_tag = 1;
+        result = 0;
+    } else {
+        result = ctx->ops->decrypt_finalize(&(ctx->state), ctx->tag);
+    }
+    ctx->started = 0;
+    ctx->finalized = 1;
+    *outl = 0;
+    return result == 0;
+}
+
+static int ascon_prov_cipher_cipher
+    (void *vctx, unsigned char *out, size_t *outl, size_t outsize,
+     const unsigned char *in, size_t inl)
+{
+    /* EVP_Cipher() finishes the operation with a NULL input */
+    if (!in)
+        return ascon_prov_cipher_final(vctx, out, outl, outsize);
+    return ascon_prov_cipher_update(vctx, out, outl, outsize, in, inl);
+}
+
+static int ascon_prov_cipher_get_params(OSSL_PARAM params[], size_t keylen)
+{
+    OSSL_PARAM *p;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_MODE);
+    if (p && !OSSL_PARAM_set_uint(p, EVP_CIPH_STREAM_CIPHER))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_KEYLEN);
+    if (p && !OSSL_PARAM_set_size_t(p, keylen))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IVLEN);
+    if (p && !OSSL_PARAM_set_size_t(p, ASCON128_NONCE_SIZE))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_BLOCK_SIZE);
+    if (p && !OSSL_PARAM_set_size_t(p, 1))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_AEAD);
+    if (p && !OSSL_PARAM_set_int(p, 1))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_CUSTOM_IV);
+    if (p && !OSSL_PARAM_set_int(p, 1))
+        return 0;
+    return 1;
+}
+
+static const OSSL_PARAM ascon_prov_cipher_known_gettable_params[] = {
+    OSSL_PARAM_uint(OSSL_CIPHER_PARAM_MODE, NULL),
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_KEYLEN, NULL),
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_IVLEN, NULL),
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_BLOCK_SIZE, NULL),
+    OSSL_PARAM_int(OSSL_CIPHER_PARAM_AEAD, NULL),
+    OSSL_PARAM_int(OSSL_CIPHER_PARAM_CUSTOM_IV, NULL),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ascon_prov_cipher_gettable_params(void *provctx)
+{
+    (void)provctx;
+    return ascon_prov_cipher_known_gettable_params;
+}
+
+static int ascon_prov_cipher_get_ctx_params(void *vctx, OSSL_PARAM params[])
+{
+    ascon_prov_cipher_t *ctx = (ascon_prov_cipher_t *)vctx;
+    OSSL_PARAM *p;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_KEYLEN);
+    if (p && !OSSL_PARAM_set_size_t(p, ctx->ops->key_size))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IVLEN);
+    if (p && !OSSL_PARAM_set_size_t(p, ASCON128_NONCE_SIZE))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_AEAD_TAGLEN);
+    if (p && !OSSL_PARAM_set_size_t(p, ASCON128_TAG_SIZE))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_AEAD_TAG);
+    if (p) {
+        /* The tag can only be retrieved after encryption has finished */
+        if (!ctx->encrypt || !ctx->finalized || !ctx->have_tag ||
+                p->data_size == 0 || p->data_size > ASCON128_TAG_SIZE) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_TAG);
+            return 0;
+        }
+        if (!OSSL_PARAM_set_octet_string(p, ctx->tag, p->data_size))
+            return 0;
+    }
+    return 1;
+}
+
+static const OSSL_PARAM ascon_prov_cipher_known_gettable_ctx_params[] = {
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_KEYLEN, NULL),
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_IVLEN, NULL),
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_AEAD_TAGLEN, NULL),
+    OSSL_PARAM_octet_string(OSSL_CIPHER_PARAM_AEAD_TAG, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ascon_prov_cipher_gettable_ctx_params
+    (void *cctx, void *provctx)
+{
+    (void)cctx;
+    (void)provctx;
+    return ascon_prov_cipher_known_gettable_ctx_params;
+}
+
+static int ascon_prov_cipher_set_ctx_params
+    (void *vctx, const OSSL_PARAM params[])
+{
+    ascon_prov_cipher_t *ctx = (ascon_prov_cipher_t *)vctx;
+    const OSSL_PARAM *p;
+    size_t len;
+    if (!params)
+        return 1;
+    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_AEAD_TAG);
+    if (p) {
+        /* Only the expected tag for decryption can be set, and only the
+         * full 16 byte tag is supported */
+        void *tag = ctx->tag;
+        if (p->data_type != OSSL_PARAM_OCTET_STRING ||
+                p->data_size != ASCON128_TAG_SIZE || ctx->encrypt ||
+                !OSSL_PARAM_get_octet_string
+                    (p, &tag, ASCON128_TAG_SIZE, &len)) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_TAG);
+            return 0;
+        }
+        ctx->have_tag = 1;
+    }
+    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_AEAD_IVLEN);
+    if (p) {
+        if (!OSSL_PARAM_get_size_t(p, &len) || len != ASCON128_NONCE_SIZE) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_IV_LENGTH);
+            return 0;
+        }
+    }
+    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_KEYLEN);
+    if (p) {
+        if (!OSSL_PARAM_get_size_t(p, &len) || len != ctx->ops->key_size) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static const OSSL_PARAM ascon_prov_cipher_known_settable_ctx_params[] = {
+    OSSL_PARAM_octet_string(OSSL_CIPHER_PARAM_AEAD_TAG, NULL, 0),
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_AEAD_IVLEN, NULL),
+    OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_KEYLEN, NULL),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ascon_prov_cipher_settable_ctx_params
+    (void *cctx, void *provctx)
+{
+    (void)cctx;
+    (void)provctx;
+    return ascon_prov_cipher_known_settable_ctx_params;
+}
+
+/* Defines the dispatch table for an AEAD cipher */
+#define ASCON_PROV_CIPHER(alg, key_size) \
+    static void *alg##_prov_newctx(void *provctx) \
+    { \
+        (void)provctx; \
+        return ascon_prov_cipher_newctx(&alg##_prov_ops); \
+    } \
+    static int alg##_prov_get_params(OSSL_PARAM params[]) \
+    { \
+        return ascon_prov_cipher_get_params(params, (key_size)); \
+    } \
+    static const OSSL_DISPATCH alg##_prov_functions[] = { \
+        { OSSL_FUNC_CIPHER_NEWCTX, (void (*)(void))alg##_prov_newctx }, \
+        { OSSL_FUNC_CIPHER_FREECTX, \
+          (void (*)(void))ascon_prov_cipher_freectx }, \
+        { OSSL_FUNC_CIPHER_DUPCTX, \
+          (void (*)(void))ascon_prov_cipher_dupctx }, \
+        { OSSL_FUNC_CIPHER_ENCRYPT_INIT, \
+          (void (*)(void))ascon_prov_cipher_encrypt_init }, \
+        { OSSL_FUNC_CIPHER_DECRYPT_INIT, \
+          (void (*)(void))ascon_prov_cipher_decrypt_init }, \
+        { OSSL_FUNC_CIPHER_UPDATE, \
+          (void (*)(void))ascon_prov_cipher_update }, \
+        { OSSL_FUNC_CIPHER_FINAL, (void (*)(void))ascon_prov_cipher_final }, \
+        { OSSL_FUNC_CIPHER_CIPHER, \
+          (void (*)(void))ascon_prov_cipher_cipher }, \
+        { OSSL_FUNC_CIPHER_GET_PARAMS, \
+          (void (*)(void))alg##_prov_get_params }, \
+        { OSSL_FUNC_CIPHER_GETTABLE_PARAMS, \
+          (void (*)(void))ascon_prov_cipher_gettable_params }, \
+        { OSSL_FUNC_CIPHER_GET_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_cipher_get_ctx_params }, \
+        { OSSL_FUNC_CIPHER_GETTABLE_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_cipher_gettable_ctx_params }, \
+        { OSSL_FUNC_CIPHER_SET_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_cipher_set_ctx_params }, \
+        { OSSL_FUNC_CIPHER_SETTABLE_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_cipher_settable_ctx_params }, \
+        { 0, NULL } \
+    }
+
+ASCON_PROV_CIPHER(ascon128_aead, ASCON128_KEY_SIZE);
+ASCON_PROV_CIPHER(ascon128a_aead, ASCON128_KEY_SIZE);
+ASCON_PROV_CIPHER(ascon80pq_aead, ASCON80PQ_KEY_SIZE);
+
+/* ---------------------------------------------------------------- */
+/*                     Hash and XOF digests                         */
+/* ---------------------------------------------------------------- */
+
+/* Context for a digest operation.  ASCON-HASH and ASCON-HASHA are
+ * implemented on top of the XOF state with a fixed output length. */
+typedef struct
+{
+    ascon_xof_state_t xof;
+    size_t xoflen;
+
+} ascon_prov_digest_t;
+
+typedef struct
+{
+    ascon_xofa_state_t xof;
+    size_t xoflen;
+
+} ascon_prov_digesta_t;
+
+static int ascon_prov_digest_get_params
+    (OSSL_PARAM params[], size_t size, int xof)
+{
+    OSSL_PARAM *p;
+    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_BLOCK_SIZE);
+    if (p && !OSSL_PARAM_set_size_t(p, 8))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_SIZE);
+    if (p && !OSSL_PARAM_set_size_t(p, size))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_XOF);
+    if (p && !OSSL_PARAM_set_int(p, xof))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_ALGID_ABSENT);
+    if (p && !OSSL_PARAM_set_int(p, 1))
+        return 0;
+    return 1;
+}
+
+static const OSSL_PARAM ascon_prov_digest_known_gettable_params[] = {
+    OSSL_PARAM_size_t(OSSL_DIGEST_PARAM_BLOCK_SIZE, NULL),
+    OSSL_PARAM_size_t(OSSL_DIGEST_PARAM_SIZE, NULL),
+    OSSL_PARAM_int(OSSL_DIGEST_PARAM_XOF, NULL),
+    OSSL_PARAM_int(OSSL_DIGEST_PARAM_ALGID_ABSENT, NULL),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ascon_prov_digest_gettable_params(void *provctx)
+{
+    (void)provctx;
+    return ascon_prov_digest_known_gettable_params;
+}
+
+static const OSSL_PARAM ascon_prov_digest_known_settable_ctx_params[] = {
+    OSSL_PARAM_size_t(OSSL_DIGEST_PARAM_XOFLEN, NULL),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ascon_prov_digest_settable_ctx_params
+    (void *dctx, void *provctx)
+{
+    (void)dctx;
+    (void)provctx;
+    return ascon_prov_digest_known_settable_ctx_params;
+}
+
+/* Defines the dispatch table for a digest.  "fn" is the prefix of the
+ * underlying XOF functions, "init" is the statement that initializes
+ * the state, and "is_xof" is non-zero if the output length is variable. */
+#define ASCON_PROV_DIGEST(name, ctx_type, fn, init, is_xof) \
+    static void *name##_prov_newctx(void *provctx) \
+    { \
+        (void)provctx; \
+        return OPENSSL_zalloc(sizeof(ctx_type)); \
+    } \
+    static void name##_prov_freectx(void *vctx) \
+    { \
+        ctx_type *ctx = (ctx_type *)vctx; \
+        if (ctx) { \
+            fn##_free(&(ctx->xof)); \
+            OPENSSL_clear_free(ctx, sizeof(ctx_type)); \
+        } \
+    } \
+    static void *name##_prov_dupctx(void *vctx) \
+    { \
+        ctx_type *ctx = (ctx_type *)vctx; \
+        ctx_type *dup = OPENSSL_zalloc(sizeof(ctx_type)); \
+        if (dup) { \
+            fn##_copy(&(dup->xof), &(ctx->xof)); \
+            dup->xoflen = ctx->xoflen; \
+        } \
+        return dup; \
+    } \
+    static int name##_prov_set_ctx_params \
+        (void *vctx, const OSSL_PARAM params[]) \
+    { \
+        ctx_type *ctx = (ctx_type *)vctx; \
+        const OSSL_PARAM *p; \
+        if (!params) \
+            return 1; \
+        p = OSSL_PARAM_locate_const(params, OSSL_DIGEST_PARAM_XOFLEN); \
+        if (p && (!(is_xof) || !OSSL_PARAM_get_size_t(p, &(ctx->xoflen)))) \
+            return 0; \
+        return 1; \
+    } \
+    static int name##_prov_init(void *vctx, const OSSL_PARAM params[]) \
+    { \
+        ctx_type *ctx = (ctx_type *)vctx; \
+        init; \
+        ctx->xoflen = ASCON_HASH_SIZE; \
+        return name##_prov_set_ctx_params(vctx, params); \
+    } \
+    static int name##_prov_update \
+        (void *vctx, const unsigned char *in, size_t inl) \
+    { \
+        ctx_type *ctx = (ctx_type *)vctx; \
+        fn##_absorb(&(ctx->xof), in, inl); \
+        return 1; \
+    } \
+    static int name##_prov_final \
+        (void *vctx, unsigned char *out, size_t *outl, size_t outsz) \
+    { \
+        ctx_type *ctx = (ctx_type *)vctx; \
+        size_t len = (is_xof) ? ctx->xoflen : ASCON_HASH_SIZE; \
+        if (outsz < len) \
+            return 0; \
+        fn##_squeeze(&(ctx->xof), out, len); \
+        *outl = len; \
+        return 1; \
+    } \
+    static int name##_prov_get_params(OSSL_PARAM params[]) \
+    { \
+        return ascon_prov_digest_get_params \
+            (params, ASCON_HASH_SIZE, (is_xof)); \
+    } \
+    static const OSSL_DISPATCH name##_prov_functions[] = { \
+        { OSSL_FUNC_DIGEST_NEWCTX, (void (*)(void))name##_prov_newctx }, \
+        { OSSL_FUNC_DIGEST_FREECTX, (void (*)(void))name##_prov_freectx }, \
+        { OSSL_FUNC_DIGEST_DUPCTX, (void (*)(void))name##_prov_dupctx }, \
+        { OSSL_FUNC_DIGEST_INIT, (void (*)(void))name##_prov_init }, \
+        { OSSL_FUNC_DIGEST_UPDATE, (void (*)(void))name##_prov_update }, \
+        { OSSL_FUNC_DIGEST_FINAL, (void (*)(void))name##_prov_final }, \
+        { OSSL_FUNC_DIGEST_GET_PARAMS, \
+          (void (*)(void))name##_prov_get_params }, \
+        { OSSL_FUNC_DIGEST_GETTABLE_PARAMS, \
+          (void (*)(void))ascon_prov_digest_gettable_params }, \
+        { OSSL_FUNC_DIGEST_SET_CTX_PARAMS, \
+          (void (*)(void))name##_prov_set_ctx_params }, \
+        { OSSL_FUNC_DIGEST_SETTABLE_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_digest_settable_ctx_params }, \
+        { 0, NULL } \
+    }
+
+ASCON_PROV_DIGEST(ascon_hash, ascon_prov_digest_t, ascon_xof,
+                  ascon_xof_init_fixed(&(ctx->xof), ASCON_HASH_SIZE), 0);
+ASCON_PROV_DIGEST(ascon_hasha, ascon_prov_digesta_t, ascon_xofa,
+                  ascon_xofa_init_fixed(&(ctx->xof), ASCON_HASH_SIZE), 0);
+ASCON_PROV_DIGEST(ascon_xof, ascon_prov_digest_t, ascon_xof,
+                  ascon_xof_init(&(ctx->xof)), 1);
+ASCON_PROV_DIGEST(ascon_xofa, ascon_prov_digesta_t, ascon_xofa,
+                  ascon_xofa_init(&(ctx->xof)), 1);
+
+/* ---------------------------------------------------------------- */
+/*                         PRF and MAC                              */
+/* ---------------------------------------------------------------- */
+
+/* Context for an ASCON-Prf or ASCON-Mac operation */
+typedef struct
+{
+    ascon_prf_state_t prf;
+    unsigned char key[ASCON_PRF_KEY_SIZE];
+    size_t size;
+    unsigned char have_key;
+    unsigned char started;
+    unsigned char is_mac;
+
+} ascon_prov_mac_t;
+
+static void *ascon_prov_mac_newctx(int is_mac)
+{
+    ascon_prov_mac_t *ctx = OPENSSL_zalloc(sizeof(ascon_prov_mac_t));
+    if (ctx) {
+        ctx->size = ASCON_PRF_TAG_SIZE;
+        ctx->is_mac = (unsigned char)is_mac;
+    }
+    return ctx;
+}
+
+static void *ascon_prov_mac_newctx_mac(void *provctx)
+{
+    (void)provctx;
+    return ascon_prov_mac_newctx(1);
+}
+
+static void *ascon_prov_mac_newctx_prf(void *provctx)
+{
+    (void)provctx;
+    return ascon_prov_mac_newctx(0);
+}
+
+static void ascon_prov_mac_freectx(void *vctx)
+{
+    ascon_prov_mac_t *ctx = (ascon_prov_mac_t *)vctx;
+    if (ctx) {
+        if (ctx->started)
+            ascon_prf_free(&(ctx->prf));
+        OPENSSL_clear_free(ctx, sizeof(ascon_prov_mac_t));
+    }
+}
+
+static void *ascon_prov_mac_dupctx(void *vctx)
+{
+    ascon_prov_mac_t *ctx = (ascon_prov_mac_t *)vctx;
+    ascon_prov_mac_t *dup = OPENSSL_malloc(sizeof(ascon_prov_mac_t));
+    if (dup) {
+        memcpy(dup, ctx, sizeof(ascon_prov_mac_t));
+        if (ctx->started)
+            ascon_copy(&(dup->prf.state), &(ctx->prf.state));
+    }
+    return dup;
+}
+
+static int ascon_prov_mac_set_ctx_params
+    (void *vctx, const OSSL_PARAM params[])
+{
+    ascon_prov_mac_t *ctx = (ascon_prov_mac_t *)vctx;
+    const OSSL_PARAM *p;
+    if (!params)
+        return 1;
+    p = OSSL_PARAM_locate_const(params, OSSL_MAC_PARAM_SIZE);
+    if (p) {
+        /* ASCON-Mac always has a 16 byte tag.  ASCON-Prf can have
+         * any non-zero length of output. */
+        size_t size;
+        if (!OSSL_PARAM_get_size_t(p, &size) || size == 0 ||
+                (ctx->is_mac && size != ASCON_MAC_TAG_SIZE))
+            return 0;
+        ctx->size = size;
+    }
+    p = OSSL_PARAM_locate_const(params, OSSL_MAC_PARAM_KEY);
+    if (p) {
+        if (p->data_type != OSSL_PARAM_OCTET_STRING ||
+                p->data_size != ASCON_PRF_KEY_SIZE) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+            return 0;
+        }
+        memcpy(ctx->key, p->data, ASCON_PRF_KEY_SIZE);
+        ctx->have_key = 1;
+    }
+    return 1;
+}
+
+static int ascon_prov_mac_init
+    (void *vctx, const unsigned char *key, size_t keylen,
+     const OSSL_PARAM params[])
+{
+    ascon_prov_mac_t *ctx = (ascon_prov_mac_t *)vctx;
+    if (!ascon_prov_mac_set_ctx_params(vctx, params))
+        return 0;
+    if (key) {
+        if (keylen != ASCON_PRF_KEY_SIZE) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+            return 0;
+        }
+        memcpy(ctx->key, key, keylen);
+        ctx->have_key = 1;
+    }
+    if (!ctx->have_key) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_NO_KEY_SET);
+        return 0;
+    }
+    if (ctx->started)
+        ascon_prf_free(&(ctx->prf));
+    ascon_prf_fixed_init
+        (&(ctx->prf), ctx->key, ctx->is_mac ? ASCON_MAC_TAG_SIZE : 0);
+    ctx->started = 1;
+    return 1;
+}
+
+static int ascon_prov_mac_update
+    (void *vctx, const unsigned char *in, size_t inl)
+{
+    ascon_prov_mac_t *ctx = (ascon_prov_mac_t *)vctx;
+    if (!ctx->started)
+        return 0;
+    ascon_prf_absorb(&(ctx->prf), in, inl);
+    return 1;
+}
+
+static int ascon_prov_mac_final
+    (void *vctx, unsigned char *out, size_t *outl, size_t outsize)
+{
+    ascon_prov_mac_t *ctx = (ascon_prov_mac_t *)vctx;
+    if (!ctx->started || outsize < ctx->size)
+        return 0;
+    ascon_prf_squeeze(&(ctx->prf), out, ctx->size);
+    ascon_prf_free(&(ctx->prf));
+    ctx->started = 0;
+    *outl = ctx->size;
+    return 1;
+}
+
+static int ascon_prov_mac_get_ctx_params(void *vctx, OSSL_PARAM params[])
+{
+    ascon_prov_mac_t *ctx = (ascon_prov_mac_t *)vctx;
+    OSSL_PARAM *p = OSSL_PARAM_locate(params, OSSL_MAC_PARAM_SIZE);
+    if (p && !OSSL_PARAM_set_size_t(p, ctx->size))
+        return 0;
+    return 1;
+}
+
+static const OSSL_PARAM ascon_prov_mac_known_gettable_ctx_params[] = {
+    OSSL_PARAM_size_t(OSSL_MAC_PARAM_SIZE, NULL),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ascon_prov_mac_gettable_ctx_params
+    (void *mctx, void *provctx)
+{
+    (void)mctx;
+    (void)provctx;
+    return ascon_prov_mac_known_gettable_ctx_params;
+}
+
+static const OSSL_PARAM ascon_prov_mac_known_settable_ctx_params[] = {
+    OSSL_PARAM_size_t(OSSL_MAC_PARAM_SIZE, NULL),
+    OSSL_PARAM_octet_string(OSSL_MAC_PARAM_KEY, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ascon_prov_mac_settable_ctx_params
+    (void *mctx, void *provctx)
+{
+    (void)mctx;
+    (void)provctx;
+    return ascon_prov_mac_known_settable_ctx_params;
+}
+
+/* Defines the dispatch table for a MAC */
+#define ASCON_PROV_MAC(name, newctx) \
+    static const OSSL_DISPATCH name##_prov_functions[] = { \
+        { OSSL_FUNC_MAC_NEWCTX, (void (*)(void))newctx }, \
+        { OSSL_FUNC_MAC_FREECTX, (void (*)(void))ascon_prov_mac_freectx }, \
+        { OSSL_FUNC_MAC_DUPCTX, (void (*)(void))ascon_prov_mac_dupctx }, \
+        { OSSL_FUNC_MAC_INIT, (void (*)(void))ascon_prov_mac_init }, \
+        { OSSL_FUNC_MAC_UPDATE, (void (*)(void))ascon_prov_mac_update }, \
+        { OSSL_FUNC_MAC_FINAL, (void (*)(void))ascon_prov_mac_final }, \
+        { OSSL_FUNC_MAC_GET_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_mac_get_ctx_params }, \
+        { OSSL_FUNC_MAC_GETTABLE_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_mac_gettable_ctx_params }, \
+        { OSSL_FUNC_MAC_SET_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_mac_set_ctx_params }, \
+        { OSSL_FUNC_MAC_SETTABLE_CTX_PARAMS, \
+          (void (*)(void))ascon_prov_mac_settable_ctx_params }, \
+        { 0, NULL } \
+    }
+
+ASCON_PROV_MAC(ascon_mac, ascon_prov_mac_newctx_mac);
+ASCON_PROV_MAC(ascon_prf, ascon_prov_mac_newctx_prf);
+
+/* ---------------------------------------------------------------- */
+/*                        Provider entry point                      */
+/* ---------------------------------------------------------------- */
+
+#define ASCON_PROV_PROPERTIES "provider=ascon"
+
+static const OSSL_ALGORITHM ascon_prov_ciphers[] = {
+    { "ASCON-128", ASCON_PROV_PROPERTIES, ascon128_aead_prov_functions,
+      "ASCON-128 AEAD" },
+    { "ASCON-128A", ASCON_PROV_PROPERTIES, ascon128a_aead_prov_functions,
+      "ASCON-128a AEAD" },
+    { "ASCON-80PQ", ASCON_PROV_PROPERTIES, ascon80pq_aead_prov_functions,
+      "ASCON-80pq AEAD" },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM ascon_prov_digests[] = {
+    { "ASCON-HASH", ASCON_PROV_PROPERTIES, ascon_hash_prov_functions,
+      "ASCON-HASH" },
+    { "ASCON-HASHA", ASCON_PROV_PROPERTIES, ascon_hasha_prov_functions,
+      "ASCON-HASHA" },
+    { "ASCON-XOF", ASCON_PROV_PROPERTIES, ascon_xof_prov_functions,
+      "ASCON-XOF" },
+    { "ASCON-XOFA", ASCON_PROV_PROPERTIES, ascon_xofa_prov_functions,
+      "ASCON-XOFA" },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM ascon_prov_macs[] = {
+    { "ASCON-MAC", ASCON_PROV_PROPERTIES, ascon_mac_prov_functions,
+      "ASCON-Mac" },
+    { "ASCON-PRF", ASCON_PROV_PROPERTIES, ascon_prf_prov_functions,
+      "ASCON-Prf" },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM *ascon_prov_query
+    (void *provctx, int operation_id, int *no_cache)
+{
+    (void)provctx;
+    *no_cache = 0;
+    switch (operation_id) {
+    case OSSL_OP_CIPHER:    return ascon_prov_ciphers;
+    case OSSL_OP_DIGEST:    return ascon_prov_digests;
+    case OSSL_OP_MAC:       return ascon_prov_macs;
+    default:                break;
+    }
+    return NULL;
+}
+
+static const OSSL_PARAM *ascon_prov_gettable_params(void *provctx)
+{
+    static const OSSL_PARAM params[] = {
+        OSSL_PARAM_utf8_ptr(OSSL_PROV_PARAM_NAME, NULL, 0),
+        OSSL_PARAM_utf8_ptr(OSSL_PROV_PARAM_VERSION, NULL, 0),
+        OSSL_PARAM_utf8_ptr(OSSL_PROV_PARAM_BUILDINFO, NULL, 0),
+        OSSL_PARAM_int(OSSL_PROV_PARAM_STATUS, NULL),
+        OSSL_PARAM_END
+    };
+    (void)provctx;
+    return params;
+}
+
+static int ascon_prov_get_params(void *provctx, OSSL_PARAM params[])
+{
+    OSSL_PARAM *p;
+    (void)provctx;
+    p = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_NAME);
+    if (p && !OSSL_PARAM_set_utf8_ptr(p, "ASCON provider"))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_VERSION);
+    if (p && !OSSL_PARAM_set_utf8_ptr(p, ASCON_PROV_VERSION))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_BUILDINFO);
+    if (p && !OSSL_PARAM_set_utf8_ptr(p, ascon_backend_name()))
+        return 0;
+    p = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_STATUS);
+    if (p && !OSSL_PARAM_set_int(p, 1))
+        return 0;
+    return 1;
+}
+
+static void ascon_prov_teardown(void *provctx)
+{
+    (void)provctx;
+}
+
+static const OSSL_DISPATCH ascon_prov_dispatch[] = {
+    { OSSL_FUNC_PROVIDER_TEARDOWN, (void (*)(void))ascon_prov_teardown },
+    { OSSL_FUNC_PROVIDER_GETTABLE_PARAMS,
+      (void (*)(void))ascon_prov_gettable_params },
+    { OSSL_FUNC_PROVIDER_GET_PARAMS, (void (*)(void))ascon_prov_get_params },
+    { OSSL_FUNC_PROVIDER_QUERY_OPERATION, (void (*)(void))ascon_prov_query },
+    { 0, NULL }
+};
+
+OPENSSL_EXPORT int OSSL_provider_init
+    (const OSSL_CORE_HANDLE *handle, const OSSL_DISPATCH *in,
+     const OSSL_DISPATCH **out, void **provctx)
+{
+    (void)in;
+    *provctx = (void *)handle;
+    *out = ascon_prov_dispatch;
+    return 1;
+}
@@ -0,0 +1,466 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-psa-driver.h"
+#include "ascon-utility.h"
+#include <string.h>
+
+/**
+ * \brief Checks that a key and algorithm can be handled by this driver.
+ *
+ * \param attributes Attributes of the key.
+ * \param key_buffer_size Size of the raw key in bytes.
+ * \param alg AEAD algorithm to use.
+ *
+ * \return PSA_SUCCESS if the combination is valid.
+ */
+static psa_status_t ascon_psa_check_key
+    (const psa_key_attributes_t *attributes, size_t key_buffer_size,
+     psa_algorithm_t alg)
+{
+    size_t key_size;
+    if (psa_get_key_type(attributes) != ASCON_PSA_KEY_TYPE_ASCON)
+        return PSA_ERROR_NOT_SUPPORTED;
+    if (alg == ASCON_PSA_ALG_ASCON128 || alg == ASCON_PSA_ALG_ASCON128A)
+        key_size = ASCON128_KEY_SIZE;
+    else if (alg == ASCON_PSA_ALG_ASCON80PQ)
+        key_size = ASCON80PQ_KEY_SIZE;
+    else
+        return PSA_ERROR_NOT_SUPPORTED;
+    if (key_buffer_size != key_size)
+        return PSA_ERROR_INVALID_ARGUMENT;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_aead_encrypt
+    (const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg,
+     const uint8_t *nonce, size_t nonce_length,
+     const uint8_t *additional_data, size_t additional_data_length,
+     const uint8_t *plaintext, size_t plaintext_length,
+     uint8_t *ciphertext, size_t ciphertext_size,
+     size_t *ciphertext_length)
+{
+    psa_status_t status =
+        ascon_psa_check_key(attributes, key_buffer_size, alg);
+    if (status != PSA_SUCCESS)
+        return status;
+    if (nonce_length != ASCON128_NONCE_SIZE)
+        return PSA_ERROR_INVALID_ARGUMENT;
+    if (ciphertext_size < ASCON128_TAG_SIZE ||
+            (ciphertext_size - ASCON128_TAG_SIZE) < plaintext_length)
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    if (alg == ASCON_PSA_ALG_ASCON128) {
+        ascon128_aead_encrypt
+            (ciphertext, ciphertext_length, plaintext, plaintext_length,
+             additional_data, additional_data_length, nonce, key_buffer);
+    } else if (alg == ASCON_PSA_ALG_ASCON128A) {
+        ascon128a_aead_encrypt
+            (ciphertext, ciphertext_length, plaintext, plaintext_length,
+             additional_data, additional_data_length, nonce, key_buffer);
+    } else {
+        ascon80pq_aead_encrypt
+            (ciphertext, ciphertext_length, plaintext, plaintext_length,
+             additional_data, additional_data_length, nonce, key_buffer);
+    }
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_aead_decrypt
+    (const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg,
+     const uint8_t *nonce, size_t nonce_length,
+     const uint8_t *additional_data, size_t additional_data_length,
+     const uint8_t *ciphertext, size_t ciphertext_length,
+     uint8_t *plaintext, size_t plaintext_size, size_t *plaintext_length)
+{
+    int result;
+    psa_status_t status =
+        ascon_psa_check_key(attributes, key_buffer_size, alg);
+    if (status != PSA_SUCCESS)
+        return status;
+    if (nonce_length != ASCON128_NONCE_SIZE ||
+            ciphertext_length < ASCON128_TAG_SIZE)
+        return PSA_ERROR_INVALID_ARGUMENT;
+    if (plaintext_size < (ciphertext_length - ASCON128_TAG_SIZE))
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    if (alg == ASCON_PSA_ALG_ASCON128) {
+        result = ascon128_aead_decrypt
+            (plaintext, plaintext_length, ciphertext, ciphertext_length,
+             additional_data, additional_data_length, nonce, key_buffer);
+    } else if (alg == ASCON_PSA_ALG_ASCON128A) {
+        result = ascon128a_aead_decrypt
+            (plaintext, plaintext_length, ciphertext, ciphertext_length,
+             additional_data, additional_data_length, nonce, key_buffer);
+    } else {
+        result = ascon80pq_aead_decrypt
+            (plaintext, plaintext_length, ciphertext, ciphertext_length,
+             additional_data, additional_data_length, nonce, key_buffer);
+    }
+    return result == 0 ? PSA_SUCCESS : PSA_ERROR_INVALID_SIGNATURE;
+}
+
+/**
+ * \brief Common setup for multi-part AEAD encryption and decryption.
+ *
+ * \param operation The operation context to set up.
+ * \param attributes Attributes of the key.
+ * \param key_buffer Points to the raw key.
+ * \param key_buffer_size Size of the raw key in bytes.
+ * \param alg AEAD algorithm to use.
+ * \param encrypt Non-zero for encryption, zero for decryption.
+ *
+ * \return The PSA status code.
+ */
+static psa_status_t ascon_psa_aead_setup
+    (ascon_psa_aead_operation_t *operation,
+     const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg, int encrypt)
+{
+    psa_status_t status =
+        ascon_psa_check_key(attributes, key_buffer_size, alg);
+    if (status != PSA_SUCCESS)
+        return status;
+    memset(operation, 0, sizeof(ascon_psa_aead_operation_t));
+    memcpy(operation->key, key_buffer, key_buffer_size);
+    operation->alg = alg;
+    operation->encrypt = (unsigned char)encrypt;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_aead_encrypt_setup
+    (ascon_psa_aead_operation_t *operation,
+     const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg)
+{
+    return ascon_psa_aead_setup
+        (operation, attributes, key_buffer, key_buffer_size, alg, 1);
+}
+
+psa_status_t ascon_psa_aead_decrypt_setup
+    (ascon_psa_aead_operation_t *operation,
+     const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg)
+{
+    return ascon_psa_aead_setup
+        (operation, attributes, key_buffer, key_buffer_size, alg, 0);
+}
+
+psa_status_t ascon_psa_aead_set_nonce
+    (ascon_psa_aead_operation_t *operation,
+     const uint8_t *nonce, size_t nonce_length)
+{
+    if (operation->alg == 0 || operation->started)
+        return PSA_ERROR_BAD_STATE;
+    if (nonce_length != ASCON128_NONCE_SIZE)
+        return PSA_ERROR_INVALID_ARGUMENT;
+    if (operation->alg == ASCON_PSA_ALG_ASCON128) {
+        ascon128_aead_start_ad
+            (&(operation->state.ascon128), nonce, operation->key);
+    } else if (operation->alg == ASCON_PSA_ALG_ASCON128A) {
+        ascon128a_aead_start_ad
+            (&(operation->state.ascon128a), nonce, operation->key);
+    } else {
+        ascon80pq_aead_start_ad
+            (&(operation->state.ascon80pq), nonce, operation->key);
+    }
+    operation->started = 1;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_aead_set_lengths
+    (ascon_psa_aead_operation_t *operation,
+     size_t ad_length, size_t plaintext_length)
+{
+    if (operation->alg == 0 || operation->lengths_set ||
+            operation->ad_processed || operation->ad_finished)
+        return PSA_ERROR_BAD_STATE;
+    operation->ad_length = ad_length;
+    operation->text_length = plaintext_length;
+    operation->lengths_set = 1;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_aead_update_ad
+    (ascon_psa_aead_operation_t *operation,
+     const uint8_t *input, size_t input_length)
+{
+    if (!operation->started || operation->ad_finished)
+        return PSA_ERROR_BAD_STATE;
+    if (operation->lengths_set &&
+            input_length > (operation->ad_length - operation->ad_processed))
+        return PSA_ERROR_INVALID_ARGUMENT;
+    if (operation->alg == ASCON_PSA_ALG_ASCON128) {
+        ascon128_aead_ad_update
+            (&(operation->state.ascon128), input, input_length);
+    } else if (operation->alg == ASCON_PSA_ALG_ASCON128A) {
+        ascon128a_aead_ad_update
+            (&(operation->state.ascon128a), input, input_length);
+    } else {
+        ascon80pq_aead_ad_update
+            (&(operation->state.ascon80pq), input, input_length);
+    }
+    operation->ad_processed += input_length;
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Finishes the associated data if it has not been finished yet.
+ *
+ * \param operation The operation context.
+ *
+ * \return PSA_SUCCESS, or PSA_ERROR_INVALID_ARGUMENT if less associated
+ * data than declared with ascon_psa_aead_set_lengths() was supplied.
+ */
+static psa_status_t ascon_psa_aead_finish_ad
+    (ascon_psa_aead_operation_t *operation)
+{
+    if (operation->ad_finished)
+        return PSA_SUCCESS;
+    if (operation->lengths_set &&
+            operation->ad_processed != operation->ad_length)
+        return PSA_ERROR_INVALID_ARGUMENT;
+    if (operation->alg == ASCON_PSA_ALG_ASCON128)
+        ascon128_aead_ad_finish(&(operation->state.ascon128));
+    else if (operation->alg == ASCON_PSA_ALG_ASCON128A)
+        ascon128a_aead_ad_finish(&(operation->state.ascon128a));
+    else
+        ascon80pq_aead_ad_finish(&(operation->state.ascon80pq));
+    operation->ad_finished = 1;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_aead_update
+    (ascon_psa_aead_operation_t *operation,
+     const uint8_t *input, size_t input_length,
+     uint8_t *output, size_t output_size, size_t *output_length)
+{
+    psa_status_t status;
+    if (!operation->started)
+        return PSA_ERROR_BAD_STATE;
+    if (operation->lengths_set &&
+            input_length >
+                (operation->text_length - operation->text_processed))
+        return PSA_ERROR_INVALID_ARGUMENT;
+    if (output_size < input_length)
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    status = ascon_psa_aead_finish_ad(operation);
+    if (status != PSA_SUCCESS)
+        return status;
+    if (operation->encrypt) {
+        if (operation->alg == ASCON_PSA_ALG_ASCON128) {
+            ascon128_aead_encrypt_block
+                (&(operation->state.ascon128), input, output, input_length);
+        } else if (operation->alg == ASCON_PSA_ALG_ASCON128A) {
+            ascon128a_aead_encrypt_block
+                (&(operation->state.ascon128a), input, output, input_length);
+        } else {
+            ascon80pq_aead_encrypt_block
+                (&(operation->state.ascon80pq), input, output, input_length);
+        }
+    } else {
+        if (operation->alg == ASCON_PSA_ALG_ASCON128) {
+            ascon128_aead_decrypt_block
+                (&(operation->state.ascon128), input, output, input_length);
+        } else if (operation->alg == ASCON_PSA_ALG_ASCON128A) {
+            ascon128a_aead_decrypt_block
+                (&(operation->state.ascon128a), input, output, input_length);
+        } else {
+            ascon80pq_aead_decrypt_block
+                (&(operation->state.ascon80pq), input, output, input_length);
+        }
+    }
+    operation->text_processed += input_length;
+    *output_length = input_length;
+    return PSA_SUCCESS;
+}
+
+/**
+ * \brief Checks that the operation is ready to finish.
+ *
+ * \param operation The operation context.
+ * \param encrypt Non-zero if finishing encryption, zero for decryption.
+ *
+ * \return The PSA status code.
+ */
+static psa_status_t ascon_psa_aead_check_finish
+    (ascon_psa_aead_operation_t *operation, int encrypt)
+{
+    if (!operation->started || operation->encrypt != encrypt)
+        return PSA_ERROR_BAD_STATE;
+    if (operation->lengths_set &&
+            operation->text_processed != operation->text_length)
+        return PSA_ERROR_INVALID_ARGUMENT;
+    return ascon_psa_aead_finish_ad(operation);
+}
+
+psa_status_t ascon_psa_aead_finish
+    (ascon_psa_aead_operation_t *operation,
+     uint8_t *ciphertext, size_t ciphertext_size, size_t *ciphertext_length,
+     uint8_t *tag, size_t tag_size, size_t *tag_length)
+{
+    psa_status_t status = ascon_psa_aead_check_finish(operation, 1);
+    (void)ciphertext;
+    (void)ciphertext_size;
+    if (status != PSA_SUCCESS)
+        return status;
+    if (tag_size < ASCON128_TAG_SIZE)
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    if (operation->alg == ASCON_PSA_ALG_ASCON128)
+        ascon128_aead_encrypt_finalize(&(operation->state.ascon128), tag);
+    else if (operation->alg == ASCON_PSA_ALG_ASCON128A)
+        ascon128a_aead_encrypt_finalize(&(operation->state.ascon128a), tag);
+    else
+        ascon80pq_aead_encrypt_finalize(&(operation->state.ascon80pq), tag);
+    operation->started = 0;
+    *ciphertext_length = 0;
+    *tag_length = ASCON128_TAG_SIZE;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_aead_verify
+    (ascon_psa_aead_operation_t *operation,
+     uint8_t *plaintext, size_t plaintext_size, size_t *plaintext_length,
+     const uint8_t *tag, size_t tag_length)
+{
+    int result;
+    psa_status_t status = ascon_psa_aead_check_finish(operation, 0);
+    (void)plaintext;
+    (void)plaintext_size;
+    if (status != PSA_SUCCESS)
+        return status;
+    if (tag_length != ASCON128_TAG_SIZE)
+        return PSA_ERROR_INVALID_SIGNATURE;
+    if (operation->alg == ASCON_PSA_ALG_ASCON128) {
+        result = ascon128_aead_decrypt_finalize
+            (&(operation->state.ascon128), tag);
+    } else if (operation->alg == ASCON_PSA_ALG_ASCON128A) {
+        result = ascon128a_aead_decrypt_finalize
+            (&(operation->state.ascon128a), tag);
+    } else {
+        result = ascon80pq_aead_decrypt_finalize
+            (&(operation->state.ascon80pq), tag);
+    }
+    operation->started = 0;
+    *plaintext_length = 0;
+    return result == 0 ? PSA_SUCCESS : PSA_ERROR_INVALID_SIGNATURE;
+}
+
+psa_status_t ascon_psa_aead_abort(ascon_psa_aead_operation_t *operation)
+{
+    if (operation->started) {
+        if (operation->alg == ASCON_PSA_ALG_ASCON128)
+            ascon128_aead_abort(&(operation->state.ascon128));
+        else if (operation->alg == ASCON_PSA_ALG_ASCON128A)
+            ascon128a_aead_abort(&(operation->state.ascon128a));
+        else
+            ascon80pq_aead_abort(&(operation->state.ascon80pq));
+    }
+    ascon_clean(operation, (unsigned)sizeof(ascon_psa_aead_operation_t));
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_hash_compute
+    (psa_algorithm_t alg, const uint8_t *input, size_t input_length,
+     uint8_t *hash, size_t hash_size, size_t *hash_length)
+{
+    if (alg != ASCON_PSA_ALG_ASCON_HASH && alg != ASCON_PSA_ALG_ASCON_HASHA)
+        return PSA_ERROR_NOT_SUPPORTED;
+    if (hash_size < ASCON_HASH_SIZE)
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    if (alg == ASCON_PSA_ALG_ASCON_HASH)
+        ascon_hash(hash, input, input_length);
+    else
+        ascon_hasha(hash, input, input_length);
+    *hash_length = ASCON_HASH_SIZE;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_hash_setup
+    (ascon_psa_hash_operation_t *operation, psa_algorithm_t alg)
+{
+    if (alg == ASCON_PSA_ALG_ASCON_HASH)
+        ascon_xof_init_fixed(&(operation->state.xof), ASCON_HASH_SIZE);
+    else if (alg == ASCON_PSA_ALG_ASCON_HASHA)
+        ascon_xofa_init_fixed(&(operation->state.xofa), ASCON_HASH_SIZE);
+    else
+        return PSA_ERROR_NOT_SUPPORTED;
+    operation->alg = alg;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_hash_clone
+    (const ascon_psa_hash_operation_t *source_operation,
+     ascon_psa_hash_operation_t *target_operation)
+{
+    if (source_operation->alg == ASCON_PSA_ALG_ASCON_HASH) {
+        ascon_xof_copy(&(target_operation->state.xof),
+                       &(source_operation->state.xof));
+    } else if (source_operation->alg == ASCON_PSA_ALG_ASCON_HASHA) {
+        ascon_xofa_copy(&(target_operation->state.xofa),
+                        &(source_operation->state.xofa));
+    } else {
+        return PSA_ERROR_BAD_STATE;
+    }
+    target_operation->alg = source_operation->alg;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_hash_update
+    (ascon_psa_hash_operation_t *operation,
+     const uint8_t *input, size_t input_length)
+{
+    if (operation->alg == ASCON_PSA_ALG_ASCON_HASH)
+        ascon_xof_absorb(&(operation->state.xof), input, input_length);
+    else if (operation->alg == ASCON_PSA_ALG_ASCON_HASHA)
+        ascon_xofa_absorb(&(operation->state.xofa), input, input_length);
+    else
+        return PSA_ERROR_BAD_STATE;
+    return PSA_SUCCESS;
+}
+
+psa_status_t ascon_psa_hash_finish
+    (ascon_psa_hash_operation_t *operation,
+     uint8_t *hash, size_t hash_size, size_t *hash_length)
+{
+    if (operation->alg != ASCON_PSA_ALG_ASCON_HASH &&
+            operation->alg != ASCON_PSA_ALG_ASCON_HASHA)
+        return PSA_ERROR_BAD_STATE;
+    if (hash_size < ASCON_HASH_SIZE)
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    if (operation->alg == ASCON_PSA_ALG_ASCON_HASH)
+        ascon_xof_squeeze(&(operation->state.xof), hash, ASCON_HASH_SIZE);
+    else
+        ascon_xofa_squeeze(&(operation->state.xofa), hash, ASCON_HASH_SIZE);
+    *hash_length = ASCON_HASH_SIZE;
+    return ascon_psa_hash_abort(operation);
+}
+
+psa_status_t ascon_psa_hash_abort(ascon_psa_hash_operation_t *operation)
+{
+    if (operation->alg == ASCON_PSA_ALG_ASCON_HASH)
+        ascon_xof_free(&(operation->state.xof));
+    else if (operation->alg == ASCON_PSA_ALG_ASCON_HASHA)
+        ascon_xofa_free(&(operation->state.xofa));
+    operation->alg = 0;
+    return PSA_SUCCESS;
+}
@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_PSA_DRIVER_H
+#define ASCON_PSA_DRIVER_H
+
+/**
+ * \file ascon-psa-driver.h
+ * \brief PSA Crypto transparent driver for the ASCON AEAD and hash
+ * algorithms.
+ *
+ * This module lets mbedTLS based platforms such as ESP-IDF and Zephyr
+ * reach ASCON through the PSA Crypto API.  The entry points follow the
+ * PSA Cryptoprocessor Driver Interface and are called from the platform's
+ * driver wrapper when the key type or algorithm is one of the ASCON values
+ * defined below.  It is not part of the Arduino library; add
+ * "psa/ascon-psa-driver.c" and the library sources to the platform build.
+ *
+ * The multi-part operations map directly onto the incremental functions
+ * in "ascon-aead.h" and "ascon-xof.h".  PSA input and output buffers are
+ * passed straight through, so there is no intermediate copy of the
+ * payload.  The permutation back end is selected when the library is
+ * compiled, which picks the Xtensa or ARMv7-M assembly code automatically
+ * on those targets.
+ *
+ * The algorithm and key type identifiers are in the PSA vendor-defined
+ * ranges, as ASCON has no standard PSA identifiers yet.  Only the full
+ * 16 byte tag is supported.
+ */
+
+#include "ascon-aead.h"
+#include "ascon-hash.h"
+#include "ascon-xof.h"
+#include <psa/crypto.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Vendor-defined PSA key type for ASCON keys.
+ *
+ * The key size determines the variant: 128 bits for ASCON-128 and
+ * ASCON-128a, or 160 bits for ASCON-80pq.
+ */
+#define ASCON_PSA_KEY_TYPE_ASCON ((psa_key_type_t)0xA0A1)
+
+/**
+ * \brief Vendor-defined PSA algorithm identifier for ASCON-128.
+ */
+#define ASCON_PSA_ALG_ASCON128 ((psa_algorithm_t)0x85100A01)
+
+/**
+ * \brief Vendor-defined PSA algorithm identifier for ASCON-128a.
+ */
+#define ASCON_PSA_ALG_ASCON128A ((psa_algorithm_t)0x85100A02)
+
+/**
+ * \brief Vendor-defined PSA algorithm identifier for ASCON-80pq.
+ */
+#define ASCON_PSA_ALG_ASCON80PQ ((psa_algorithm_t)0x85100A03)
+
+/**
+ * \brief Vendor-defined PSA algorithm identifier for ASCON-HASH.
+ */
+#define ASCON_PSA_ALG_ASCON_HASH ((psa_algorithm_t)0x82000A01)
+
+/**
+ * \brief Vendor-defined PSA algorithm identifier for ASCON-HASHA.
+ */
+#define ASCON_PSA_ALG_ASCON_HASHA ((psa_algorithm_t)0x82000A02)
+
+/**
+ * \brief Driver context for a multi-part AEAD operation.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Incremental state for the variant that is in use */
+    union {
+        ascon128_state_t ascon128;
+        ascon128a_state_t ascon128a;
+        ascon80pq_state_t ascon80pq;
+    } state;
+
+    /** Key that was passed to the setup function */
+    unsigned char key[ASCON80PQ_KEY_SIZE];
+
+    /** Algorithm that is in use */
+    psa_algorithm_t alg;
+
+    /** Expected length of the associated data if lengths were set */
+    size_t ad_length;
+
+    /** Expected length of the plaintext if lengths were set */
+    size_t text_length;
+
+    /** Number of associated data bytes that have been processed */
+    size_t ad_processed;
+
+    /** Number of plaintext bytes that have been processed */
+    size_t text_processed;
+
+    /** Non-zero for encryption, zero for decryption */
+    unsigned char encrypt;
+
+    /** Non-zero once the nonce has been set and the state started */
+    unsigned char started;
+
+    /** Non-zero once the associated data has been finished */
+    unsigned char ad_finished;
+
+    /** Non-zero if the lengths have been set */
+    unsigned char lengths_set;
+
+} ascon_psa_aead_operation_t;
+
+/**
+ * \brief Driver context for a multi-part hash operation.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Incremental XOF state for the algorithm that is in use */
+    union {
+        ascon_xof_state_t xof;
+        ascon_xofa_state_t xofa;
+    } state;
+
+    /** Algorithm that is in use */
+    psa_algorithm_t alg;
+
+} ascon_psa_hash_operation_t;
+
+/**
+ * \brief Encrypts a message in one step (PSA "aead_encrypt" entry point).
+ *
+ * \param attributes Attributes of the key.
+ * \param key_buffer Points to the raw key.
+ * \param key_buffer_size Size of the raw key in bytes.
+ * \param alg AEAD algorithm to use.
+ * \param nonce Points to the nonce.
+ * \param nonce_length Length of the nonce, which must be 16.
+ * \param additional_data Points to the associated data.
+ * \param additional_data_length Length of the associated data.
+ * \param plaintext Points to the plaintext.
+ * \param plaintext_length Length of the plaintext.
+ * \param ciphertext Buffer to receive the ciphertext and tag.
+ * \param ciphertext_size Size of the \a ciphertext buffer.
+ * \param ciphertext_length Set to the length of the ciphertext and tag.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_NOT_SUPPORTED if \a alg or the key is
+ * not handled by this driver, PSA_ERROR_INVALID_ARGUMENT if the key or
+ * nonce has the wrong size, or PSA_ERROR_BUFFER_TOO_SMALL.
+ */
+psa_status_t ascon_psa_aead_encrypt
+    (const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg,
+     const uint8_t *nonce, size_t nonce_length,
+     const uint8_t *additional_data, size_t additional_data_length,
+     const uint8_t *plaintext, size_t plaintext_length,
+     uint8_t *ciphertext, size_t ciphertext_size,
+     size_t *ciphertext_length);
+
+/**
+ * \brief Decrypts a message in one step (PSA "aead_decrypt" entry point).
+ *
+ * \param attributes Attributes of the key.
+ * \param key_buffer Points to the raw key.
+ * \param key_buffer_size Size of the raw key in bytes.
+ * \param alg AEAD algorithm to use.
+ * \param nonce Points to the nonce.
+ * \param nonce_length Length of the nonce, which must be 16.
+ * \param additional_data Points to the associated data.
+ * \param additional_data_length Length of the associated data.
+ * \param ciphertext Points to the ciphertext and tag.
+ * \param ciphertext_length Length of the ciphertext and tag.
+ * \param plaintext Buffer to receive the plaintext.
+ * \param plaintext_size Size of the \a plaintext buffer.
+ * \param plaintext_length Set to the length of the plaintext.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_INVALID_SIGNATURE if the tag is
+ * incorrect, or one of the errors from ascon_psa_aead_encrypt().
+ */
+psa_status_t ascon_psa_aead_decrypt
+    (const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg,
+     const uint8_t *nonce, size_t nonce_length,
+     const uint8_t *additional_data, size_t additional_data_length,
+     const uint8_t *ciphertext, size_t ciphertext_length,
+     uint8_t *plaintext, size_t plaintext_size, size_t *plaintext_length);
+
+/**
+ * \brief Sets up a multi-part AEAD encryption operation.
+ *
+ * \param operation The operation context to set up.
+ * \param attributes Attributes of the key.
+ * \param key_buffer Points to the raw key.
+ * \param key_buffer_size Size of the raw key in bytes.
+ * \param alg AEAD algorithm to use.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_NOT_SUPPORTED, or
+ * PSA_ERROR_INVALID_ARGUMENT.
+ *
+ * The key is copied into \a operation, so the caller's key buffer does
+ * not need to remain valid.
+ */
+psa_status_t ascon_psa_aead_encrypt_setup
+    (ascon_psa_aead_operation_t *operation,
+     const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg);
+
+/**
+ * \brief Sets up a multi-part AEAD decryption operation.
+ *
+ * \param operation The operation context to set up.
+ * \param attributes Attributes of the key.
+ * \param key_buffer Points to the raw key.
+ * \param key_buffer_size Size of the raw key in bytes.
+ * \param alg AEAD algorithm to use.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_NOT_SUPPORTED, or
+ * PSA_ERROR_INVALID_ARGUMENT.
+ */
+psa_status_t ascon_psa_aead_decrypt_setup
+    (ascon_psa_aead_operation_t *operation,
+     const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+     size_t key_buffer_size, psa_algorithm_t alg);
+
+/**
+ * \brief Sets the nonce for a multi-part AEAD operation.
+ *
+ * \param operation The operation context.
+ * \param nonce Points to the nonce.
+ * \param nonce_length Length of the nonce, which must be 16.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_INVALID_ARGUMENT, or
+ * PSA_ERROR_BAD_STATE if the nonce has already been set.
+ */
+psa_status_t ascon_psa_aead_set_nonce
+    (ascon_psa_aead_operation_t *operation,
+     const uint8_t *nonce, size_t nonce_length);
+
+/**
+ * \brief Declares the lengths of the associated data and plaintext.
+ *
+ * \param operation The operation context.
+ * \param ad_length Total length of the associated data.
+ * \param plaintext_length Total length of the plaintext.
+ *
+ * \return PSA_SUCCESS or PSA_ERROR_BAD_STATE.
+ *
+ * ASCON does not need the lengths in advance.  If they are set, they are
+ * checked against the amount of data that is actually processed.
+ */
+psa_status_t ascon_psa_aead_set_lengths
+    (ascon_psa_aead_operation_t *operation,
+     size_t ad_length, size_t plaintext_length);
+
+/**
+ * \brief Absorbs more associated data into a multi-part AEAD operation.
+ *
+ * \param operation The operation context.
+ * \param input Points to the associated data.
+ * \param input_length Length of the associated data.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_BAD_STATE, or
+ * PSA_ERROR_INVALID_ARGUMENT if more than the declared length is given.
+ */
+psa_status_t ascon_psa_aead_update_ad
+    (ascon_psa_aead_operation_t *operation,
+     const uint8_t *input, size_t input_length);
+
+/**
+ * \brief Encrypts or decrypts more payload in a multi-part AEAD operation.
+ *
+ * \param operation The operation context.
+ * \param input Points to the input payload.
+ * \param input_length Length of the input payload.
+ * \param output Buffer to receive the output, which may be the same
+ * as \a input.
+ * \param output_size Size of the \a output buffer.
+ * \param output_length Set to the number of bytes that were written,
+ * which is always \a input_length on success.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_BAD_STATE, PSA_ERROR_INVALID_ARGUMENT,
+ * or PSA_ERROR_BUFFER_TOO_SMALL.
+ *
+ * The data is not buffered, so the output is produced immediately.
+ * When decrypting, the caller must not use the output until
+ * ascon_psa_aead_verify() has succeeded.
+ */
+psa_status_t ascon_psa_aead_update
+    (ascon_psa_aead_operation_t *operation,
+     const uint8_t *input, size_t input_length,
+     uint8_t *output, size_t output_size, size_t *output_length);
+
+/**
+ * \brief Finishes a multi-part AEAD encryption operation.
+ *
+ * \param operation The operation context.
+ * \param ciphertext Buffer for any remaining ciphertext; not used.
+ * \param ciphertext_size Size of the \a ciphertext buffer.
+ * \param ciphertext_length Always set to zero.
+ * \param tag Buffer to receive the authentication tag.
+ * \param tag_size Size of the \a tag buffer.
+ * \param tag_length Set to the length of the tag.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_BAD_STATE, PSA_ERROR_INVALID_ARGUMENT,
+ * or PSA_ERROR_BUFFER_TOO_SMALL.
+ */
+psa_status_t ascon_psa_aead_finish
+    (ascon_psa_aead_operation_t *operation,
+     uint8_t *ciphertext, size_t ciphertext_size, size_t *ciphertext_length,
+     uint8_t *tag, size_t tag_size, size_t *tag_length);
+
+/**
+ * \brief Finishes a multi-part AEAD decryption operation and checks
+ * the tag.
+ *
+ * \param operation The operation context.
+ * \param plaintext Buffer for any remaining plaintext; not used.
+ * \param plaintext_size Size of the \a plaintext buffer.
+ * \param plaintext_length Always set to zero.
+ * \param tag Points to the authentication tag to check.
+ * \param tag_length Length of the tag, which must be 16.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_INVALID_SIGNATURE if the tag is
+ * incorrect, PSA_ERROR_BAD_STATE, or PSA_ERROR_INVALID_ARGUMENT.
+ */
+psa_status_t ascon_psa_aead_verify
+    (ascon_psa_aead_operation_t *operation,
+     uint8_t *plaintext, size_t plaintext_size, size_t *plaintext_length,
+     const uint8_t *tag, size_t tag_length);
+
+/**
+ * \brief Aborts a multi-part AEAD operation and destroys the key copy.
+ *
+ * \param operation The operation context.
+ *
+ * \return PSA_SUCCESS.
+ */
+psa_status_t ascon_psa_aead_abort(ascon_psa_aead_operation_t *operation);
+
+/**
+ * \brief Hashes a message in one step (PSA "hash_compute" entry point).
+ *
+ * \param alg Hash algorithm to use.
+ * \param input Points to the input data.
+ * \param input_length Length of the input data.
+ * \param hash Buffer to receive the hash value.
+ * \param hash_size Size of the \a hash buffer.
+ * \param hash_length Set to the length of the hash value.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_NOT_SUPPORTED, or
+ * PSA_ERROR_BUFFER_TOO_SMALL.
+ */
+psa_status_t ascon_psa_hash_compute
+    (psa_algorithm_t alg, const uint8_t *input, size_t input_length,
+     uint8_t *hash, size_t hash_size, size_t *hash_length);
+
+/**
+ * \brief Sets up a multi-part hash operation.
+ *
+ * \param operation The operation context to set up.
+ * \param alg Hash algorithm to use.
+ *
+ * \return PSA_SUCCESS or PSA_ERROR_NOT_SUPPORTED.
+ */
+psa_status_t ascon_psa_hash_setup
+    (ascon_psa_hash_operation_t *operation, psa_algorithm_t alg);
+
+/**
+ * \brief Clones a multi-part hash operation.
+ *
+ * \param source_operation The operation to clone.
+ * \param target_operation The operation to receive the clone.
+ *
+ * \return PSA_SUCCESS or PSA_ERROR_BAD_STATE.
+ */
+psa_status_t ascon_psa_hash_clone
+    (const ascon_psa_hash_operation_t *source_operation,
+     ascon_psa_hash_operation_t *target_operation);
+
+/**
+ * \brief Absorbs more input into a multi-part hash operation.
+ *
+ * \param operation The operation context.
+ * \param input Points to the input data.
+ * \param input_length Length of the input data.
+ *
+ * \return PSA_SUCCESS or PSA_ERROR_BAD_STATE.
+ */
+psa_status_t ascon_psa_hash_update
+    (ascon_psa_hash_operation_t *operation,
+     const uint8_t *input, size_t input_length);
+
+/**
+ * \brief Finishes a multi-part hash operation.
+ *
+ * \param operation The operation context.
+ * \param hash Buffer to receive the hash value.
+ * \param hash_size Size of the \a hash buffer.
+ * \param hash_length Set to the length of the hash value.
+ *
+ * \return PSA_SUCCESS, PSA_ERROR_BAD_STATE, or PSA_ERROR_BUFFER_TOO_SMALL.
+ */
+psa_status_t ascon_psa_hash_finish
+    (ascon_psa_hash_operation_t *operation,
+     uint8_t *hash, size_t hash_size, size_t *hash_length);
+
+/**
+ * \brief Aborts a multi-part hash operation.
+ *
+ * \param operation The operation context.
+ *
+ * \return PSA_SUCCESS.
+ */
+psa_status_t ascon_psa_hash_abort(ascon_psa_hash_operation_t *operation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
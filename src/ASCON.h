@@ -30,20 +30,37 @@
  * References: https://ascon.iaik.tugraz.at/
  */
 
+#include "ascon-config.h"
+#include "ascon-accel.h"
 #include "ascon-aead.h"
 #include "ascon-aead-masked.h"
+#include "ascon-aead-stream.h"
+#include "ascon-coalesce.h"
 #include "ascon-hash.h"
 #include "ascon-hkdf.h"
 #include "ascon-hmac.h"
 #include "ascon-isap.h"
 #include "ascon-kmac.h"
+#include "ascon-latency.h"
+#include "ascon-merkle.h"
+#include "ascon-nonce.h"
+#include "ascon-parallel.h"
 #include "ascon-pbkdf2.h"
 #include "ascon-prf.h"
+#include "ascon-prf-masked.h"
 #include "ascon-permutation.h"
 #include "ascon-random.h"
+#include "ascon-session.h"
 #include "ascon-siv.h"
+#include "ascon-sp800-232.h"
 #include "ascon-utility.h"
 #include "ascon-version.h"
 #include "ascon-xof.h"
 
+#ifdef __cplusplus
+#include "ascon-constexpr.h"
+#include "ascon-cpp.h"
+#include "ascon-stream-adapter.h"
+#endif
+
 #endif
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* The bulk operations in this file are the back end's own versions */
+#define ASCON_ACCEL_INTERNAL 1
+
+#include "ascon-accel.h"
+#include "ascon-permutation.h"
+#include "ascon-utility.h"
+#include "utility/ascon-bulk.h"
+
+/**
+ * \def ASCON_ACCEL_THREADS
+ * \brief Define to 1 if jobs may be submitted and completed on several
+ * threads, or 0 if there is a single thread of execution.
+ */
+#if !defined(ASCON_ACCEL_THREADS)
+#if defined(ESP32) || defined(ESP_PLATFORM)
+#define ASCON_ACCEL_THREADS 1
+#elif !defined(ARDUINO) && (defined(__linux__) || defined(__APPLE__) || \
+    defined(__unix__) || defined(_WIN32))
+#define ASCON_ACCEL_THREADS 1
+#else
+#define ASCON_ACCEL_THREADS 0
+#endif
+#endif
+
+static const ascon_accel_driver_t *ascon_accel_driver = 0;
+
+/* Atomic access to the registered driver and the job status.  With a
+ * single thread of execution, plain accesses are enough; the status is
+ * declared volatile because drivers may update it from an interrupt. */
+#if ASCON_ACCEL_THREADS && defined(_MSC_VER)
+#include <intrin.h>
+#define ascon_accel_load_driver() \
+    ((const ascon_accel_driver_t *)_InterlockedCompareExchangePointer \
+        ((void * volatile *)&ascon_accel_driver, 0, 0))
+#define ascon_accel_store_driver(driver) \
+    ((void)_InterlockedExchangePointer \
+        ((void * volatile *)&ascon_accel_driver, (void *)(driver)))
+#define ascon_accel_load_status(job) \
+    ((int)_InterlockedOr((volatile long *)&((job)->status), 0))
+#define ascon_accel_store_status(job, value) \
+    ((void)_InterlockedExchange((volatile long *)&((job)->status), (value)))
+#elif ASCON_ACCEL_THREADS
+#define ascon_accel_load_driver() \
+    (__atomic_load_n(&ascon_accel_driver, __ATOMIC_ACQUIRE))
+#define ascon_accel_store_driver(driver) \
+    (__atomic_store_n(&ascon_accel_driver, (driver), __ATOMIC_RELEASE))
+#define ascon_accel_load_status(job) \
+    (__atomic_load_n(&((job)->status), __ATOMIC_ACQUIRE))
+#define ascon_accel_store_status(job, value) \
+    (__atomic_store_n(&((job)->status), (value), __ATOMIC_RELEASE))
+#else
+#define ascon_accel_load_driver() (ascon_accel_driver)
+#define ascon_accel_store_driver(driver) (ascon_accel_driver = (driver))
+#define ascon_accel_load_status(job) ((job)->status)
+#define ascon_accel_store_status(job, value) ((job)->status = (value))
+#endif
+
+void ascon_accel_register(const ascon_accel_driver_t *driver)
+{
+    ascon_accel_store_driver(driver);
+}
+
+const ascon_accel_driver_t *ascon_accel_get_driver(void)
+{
+    return ascon_accel_load_driver();
+}
+
+void ascon_accel_run_cpu(ascon_accel_job_t *job)
+{
+    ascon_state_t state;
+    size_t blocks;
+    ascon_init(&state);
+    ascon_overwrite_bytes(&state, job->state, 0, ASCON_ACCEL_STATE_SIZE);
+    switch (job->op) {
+    case ASCON_ACCEL_ABSORB:
+        ascon_absorb_blocks
+            (&state, job->src, job->blocks, job->rate, job->first_round);
+        break;
+
+    case ASCON_ACCEL_ENCRYPT:
+        ascon_encrypt_blocks
+            (&state, job->dest, job->src, job->blocks, job->rate,
+             job->first_round);
+        break;
+
+    case ASCON_ACCEL_DECRYPT:
+        ascon_decrypt_blocks
+            (&state, job->dest, job->src, job->blocks, job->rate,
+             job->first_round);
+        break;
+
+    default:
+        for (blocks = job->blocks; blocks > 0; --blocks)
+            ascon_permute(&state, job->first_round);
+        break;
+    }
+    ascon_extract_bytes(&state, job->state, 0, ASCON_ACCEL_STATE_SIZE);
+    ascon_free(&state);
+}
+
+/**
+ * \brief Marks a job as done and calls its callback.
+ *
+ * \param job The job.
+ */
+static void ascon_accel_finish(ascon_accel_job_t *job)
+{
+    ascon_accel_store_status(job, ASCON_ACCEL_DONE);
+    if (job->callback)
+        (*(job->callback))(job);
+}
+
+/**
+ * \brief Waits for the accelerator to finish with a job.
+ *
+ * \param driver The driver that accepted the job.
+ * \param job The job.
+ *
+ * \return The final status of the job.
+ */
+static int ascon_accel_poll_until_done
+    (const ascon_accel_driver_t *driver, ascon_accel_job_t *job)
+{
+    int status;
+    for (;;) {
+        status = ascon_accel_load_status(job);
+        if (status != ASCON_ACCEL_PENDING)
+            return status;
+        if (driver && driver->poll)
+            (*(driver->poll))(driver->ctx);
+    }
+}
+
+int ascon_accel_submit(ascon_accel_job_t *job)
+{
+    const ascon_accel_driver_t *driver = ascon_accel_get_driver();
+    job->next = 0;
+    ascon_accel_store_status(job, ASCON_ACCEL_PENDING);
+    if (driver && driver->submit && (*(driver->submit))(driver->ctx, job) == 0)
+        return 0;
+    ascon_accel_run_cpu(job);
+    ascon_accel_finish(job);
+    return 1;
+}
+
+int ascon_accel_wait(ascon_accel_job_t *job)
+{
+    if (ascon_accel_poll_until_done(ascon_accel_get_driver(), job)
+            != ASCON_ACCEL_DONE) {
+        ascon_accel_run_cpu(job);
+        ascon_accel_finish(job);
+    }
+    return ASCON_ACCEL_DONE;
+}
+
+void ascon_accel_complete(ascon_accel_job_t *job, int status)
+{
+    if (status == ASCON_ACCEL_DONE) {
+        ascon_accel_finish(job);
+    } else {
+        ascon_accel_store_status(job, ASCON_ACCEL_FAILED);
+    }
+}
+
+#if defined(ASCON_ACCEL)
+
+/**
+ * \brief Offloads a run of rate blocks to the accelerator and waits
+ * for it to complete.
+ *
+ * \param state The ASCON state in "operational" form.
+ * \param dest Destination for encryption and decryption, or NULL.
+ * \param src Points to the source rate blocks.
+ * \param blocks Number of rate blocks.
+ * \param rate Number of bytes in each block, 8 or 16.
+ * \param first_round First round of the permutation to apply each block.
+ * \param op The operation; e.g. ASCON_ACCEL_ABSORB.
+ *
+ * \return Non-zero if the accelerator processed the blocks, or zero if
+ * the caller should process them on the CPU instead.
+ */
+static int ascon_accel_offload
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round, uint8_t op)
+{
+    const ascon_accel_driver_t *driver = ascon_accel_get_driver();
+    ascon_accel_job_t job;
+    int status;
+    if (!driver || !(driver->submit) || blocks < driver->min_blocks)
+        return 0;
+    ascon_extract_bytes(state, job.state, 0, ASCON_ACCEL_STATE_SIZE);
+    job.src = src;
+    job.dest = dest;
+    job.blocks = blocks;
+    job.op = op;
+    job.rate = (uint8_t)rate;
+    job.first_round = first_round;
+    job.callback = 0;
+    job.user_data = 0;
+    job.next = 0;
+    job.status = ASCON_ACCEL_PENDING;
+    if ((*(driver->submit))(driver->ctx, &job) == 0) {
+        status = ascon_accel_poll_until_done(driver, &job);
+        if (status == ASCON_ACCEL_DONE) {
+            ascon_overwrite_bytes
+                (state, job.state, 0, ASCON_ACCEL_STATE_SIZE);
+        }
+    } else {
+        status = ASCON_ACCEL_FAILED;
+    }
+    ascon_clean(job.state, sizeof(job.state));
+    return status == ASCON_ACCEL_DONE;
+}
+
+void ascon_accel_absorb_blocks
+    (ascon_state_t *state, const unsigned char *data, size_t blocks,
+     unsigned rate, uint8_t first_round)
+{
+    if (!ascon_accel_offload
+            (state, 0, data, blocks, rate, first_round, ASCON_ACCEL_ABSORB))
+        ascon_absorb_blocks(state, data, blocks, rate, first_round);
+}
+
+void ascon_accel_encrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round)
+{
+    if (!ascon_accel_offload
+            (state, dest, src, blocks, rate, first_round,
+             ASCON_ACCEL_ENCRYPT))
+        ascon_encrypt_blocks(state, dest, src, blocks, rate, first_round);
+}
+
+void ascon_accel_decrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round)
+{
+    if (!ascon_accel_offload
+            (state, dest, src, blocks, rate, first_round,
+             ASCON_ACCEL_DECRYPT))
+        ascon_decrypt_blocks(state, dest, src, blocks, rate, first_round);
+}
+
+#endif /* ASCON_ACCEL */
@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_ACCEL_H
+#define ASCON_ACCEL_H
+
+/**
+ * \file ascon-accel.h
+ * \brief Offloading bulk work to an ASCON hardware accelerator.
+ *
+ * Some FPGA SoC's and microcontrollers have an ASCON peripheral that can
+ * permute a state, or stream a run of rate blocks through a state with
+ * DMA, without using the CPU.  The platform describes its peripheral with
+ * an ascon_accel_driver_t and registers it with ascon_accel_register().
+ *
+ * Work is handed to the driver as an ascon_accel_job_t, which carries the
+ * state in the standard big-endian byte order of the ASCON specification
+ * rather than the back end's operational form.  The driver starts the job
+ * and returns; when the hardware finishes, the driver's interrupt handler
+ * or poll function calls ascon_accel_complete().  If no driver is
+ * registered or the driver declines the job, the job is run on the CPU
+ * instead, so callers never need a second code path.
+ *
+ * Applications can submit jobs directly with ascon_accel_submit() and
+ * overlap other work with the accelerator.  When the library is compiled
+ * with ASCON_ACCEL defined, the AEAD modes also send their full rate
+ * blocks of associated data, plaintext, and ciphertext to the driver
+ * whenever a run is at least ascon_accel_driver_t::min_blocks long.
+ * Those calls wait for the job to complete, and shorter runs stay on the
+ * CPU where the cost of converting the state would dominate.
+ *
+ * \code
+ * static int my_submit(void *ctx, ascon_accel_job_t *job)
+ * {
+ *     if (ascon_ip_busy())
+ *         return -1; // The CPU will do it instead.
+ *     ascon_ip_load_state(job->state);
+ *     ascon_ip_start_dma(job->op, job->src, job->dest, job->blocks,
+ *                        job->rate, job->first_round);
+ *     current_job = job;
+ *     return 0;
+ * }
+ *
+ * void ASCON_IP_IRQHandler(void)
+ * {
+ *     ascon_ip_read_state(current_job->state);
+ *     ascon_accel_complete(current_job, ASCON_ACCEL_DONE);
+ * }
+ *
+ * static const ascon_accel_driver_t my_driver = {
+ *     "ascon-ip", 0, my_submit, 0, 8
+ * };
+ *
+ * ascon_accel_register(&my_driver);
+ * \endcode
+ *
+ * The \a src and \a dest buffers of a job are used directly by the
+ * driver, so on platforms with data caches or restricted DMA regions the
+ * driver is responsible for cache maintenance or for bouncing the data
+ * through memory that the DMA engine can reach.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Permute the state \a blocks times without any data */
+#define ASCON_ACCEL_PERMUTE     0
+
+/** XOR each block of \a src into the rate and then permute */
+#define ASCON_ACCEL_ABSORB      1
+
+/** XOR each block of \a src into the rate, write the rate to \a dest,
+ *  and then permute */
+#define ASCON_ACCEL_ENCRYPT     2
+
+/** Write \a src XOR the rate to \a dest, replace the rate with the
+ *  block of \a src, and then permute */
+#define ASCON_ACCEL_DECRYPT     3
+
+/** The job has completed successfully */
+#define ASCON_ACCEL_DONE        0
+
+/** The job is still in progress */
+#define ASCON_ACCEL_PENDING     1
+
+/** The accelerator failed to complete the job */
+#define ASCON_ACCEL_FAILED      (-1)
+
+/** Size of the state in a job */
+#define ASCON_ACCEL_STATE_SIZE  40
+
+typedef struct ascon_accel_job_s ascon_accel_job_t;
+
+/**
+ * \brief Function that is called when a job completes.
+ *
+ * \param job The job that has completed.
+ *
+ * This may be called from the driver's interrupt handler.
+ */
+typedef void (*ascon_accel_callback_t)(ascon_accel_job_t *job);
+
+/**
+ * \brief Job that streams a run of rate blocks through an ASCON state.
+ */
+struct ascon_accel_job_s
+{
+    /** State in standard big-endian byte order, updated in place */
+    uint8_t state[ASCON_ACCEL_STATE_SIZE];
+
+    /** Source rate blocks, or NULL for ASCON_ACCEL_PERMUTE */
+    const unsigned char *src;
+
+    /** Destination rate blocks for encryption and decryption */
+    unsigned char *dest;
+
+    /** Number of rate blocks, or permutations for ASCON_ACCEL_PERMUTE */
+    size_t blocks;
+
+    /** Operation to perform; e.g. ASCON_ACCEL_ABSORB */
+    uint8_t op;
+
+    /** Number of bytes in each rate block, 8 or 16 */
+    uint8_t rate;
+
+    /** First round of the permutation after each block, 0 to 11 */
+    uint8_t first_round;
+
+    /** Status of the job; e.g. ASCON_ACCEL_PENDING or ASCON_ACCEL_DONE */
+    volatile int status;
+
+    /** Function to call on completion, or NULL */
+    ascon_accel_callback_t callback;
+
+    /** Application data for the callback */
+    void *user_data;
+
+    /** Link for the driver's queue of jobs, if it has one */
+    ascon_accel_job_t *next;
+};
+
+/**
+ * \brief Description of an ASCON hardware accelerator.
+ */
+typedef struct
+{
+    /** Name of the accelerator, for diagnostics */
+    const char *name;
+
+    /** Context pointer to pass to the driver functions */
+    void *ctx;
+
+    /**
+     * \brief Starts a job on the accelerator.
+     *
+     * \param ctx The driver's context pointer.
+     * \param job The job to start, with its status set to
+     * ASCON_ACCEL_PENDING.
+     *
+     * \return Zero if the job was accepted, in which case the driver must
+     * call ascon_accel_complete() when it is done, or -1 if the job cannot
+     * be accepted now and should be run on the CPU instead.
+     *
+     * A job that is reported as ASCON_ACCEL_FAILED is run again on the
+     * CPU, so the driver must not write to the job's state or \a dest
+     * buffer unless the job is going to succeed.
+     */
+    int (*submit)(void *ctx, ascon_accel_job_t *job);
+
+    /**
+     * \brief Checks the accelerator for completed jobs.
+     *
+     * \param ctx The driver's context pointer.
+     *
+     * This is called repeatedly while waiting for a job.  It may be NULL
+     * if completions are reported by an interrupt handler or thread.
+     */
+    void (*poll)(void *ctx);
+
+    /** Smallest number of blocks that the AEAD modes will offload */
+    size_t min_blocks;
+
+} ascon_accel_driver_t;
+
+/**
+ * \brief Registers the hardware accelerator driver.
+ *
+ * \param driver The driver, or NULL to run all jobs on the CPU.
+ * The structure must stay valid until it is replaced.
+ *
+ * The driver must not be replaced while jobs are pending on it.
+ */
+void ascon_accel_register(const ascon_accel_driver_t *driver);
+
+/**
+ * \brief Gets the hardware accelerator driver that is registered.
+ *
+ * \return The driver, or NULL if jobs are run on the CPU.
+ */
+const ascon_accel_driver_t *ascon_accel_get_driver(void);
+
+/**
+ * \brief Submits a job to the accelerator.
+ *
+ * \param job The job to submit.  Every field except \a status and
+ * \a next must be filled in by the caller.
+ *
+ * \return Zero if the job was started on the accelerator, or 1 if
+ * it was run on the CPU and has already completed.
+ *
+ * The callback is called on completion in both cases.  The job and its
+ * buffers must stay valid until then.
+ *
+ * \sa ascon_accel_wait()
+ */
+int ascon_accel_submit(ascon_accel_job_t *job);
+
+/**
+ * \brief Waits for a job to complete.
+ *
+ * \param job The job that was submitted with ascon_accel_submit().
+ *
+ * \return ASCON_ACCEL_DONE once the job has completed.
+ *
+ * If the accelerator reports that the job failed, the job is run again
+ * on the CPU and then the callback is called.
+ */
+int ascon_accel_wait(ascon_accel_job_t *job);
+
+/**
+ * \brief Reports that a job has completed.
+ *
+ * \param job The job that has completed.
+ * \param status ASCON_ACCEL_DONE, or ASCON_ACCEL_FAILED if the
+ * accelerator could not complete the job.
+ *
+ * This is called by the driver, possibly from an interrupt handler.
+ * The job's callback is called if the job succeeded.  Failed jobs are
+ * completed on the CPU by ascon_accel_wait() instead.
+ */
+void ascon_accel_complete(ascon_accel_job_t *job, int status);
+
+/**
+ * \brief Runs a job on the CPU.
+ *
+ * \param job The job to run.  Its status is not modified and its
+ * callback is not called.
+ *
+ * This is the software reference for the operations and can be used by
+ * drivers for operations that their hardware does not support.
+ */
+void ascon_accel_run_cpu(ascon_accel_job_t *job);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,65 +20,81 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
+#include "ascon-latency.h"
 #include "utility/ascon-aead-common.h"
 #include "utility/ascon-util-snp.h"
 #include <string.h>
 
+#if ASCON_ENABLE_AEAD
+
 /* Initialization vector for ASCON-128 */
 static uint8_t const ASCON128_IV[8] =
     {0x80, 0x40, 0x0c, 0x06, 0x00, 0x00, 0x00, 0x00};
 
-void ascon128_aead_encrypt
+void ascon128_aead_encrypt_ex
     (unsigned char *c, size_t *clen,
      const unsigned char *m, size_t mlen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const unsigned char *k, ascon_state_t *workspace)
 {
-    ascon_state_t state;
     unsigned char partial;
+    ascon_latency_begin();
 
     /* Set the length of the returned ciphertext */
     *clen = mlen + ASCON128_TAG_SIZE;
 
     /* Initialize the ASCON state */
-    ascon_init(&state);
-    ascon_overwrite_bytes(&state, ASCON128_IV, 0, 8);
-    ascon_overwrite_bytes(&state, k, 8, ASCON128_KEY_SIZE);
-    ascon_overwrite_bytes(&state, npub, 24, ASCON128_NONCE_SIZE);
-    ascon_permute(&state, 0);
-    ascon_absorb_16(&state, k, 24);
+    ascon_init(workspace);
+    ascon_overwrite_bytes(workspace, ASCON128_IV, 0, 8);
+    ascon_overwrite_bytes(workspace, k, 8, ASCON128_KEY_SIZE);
+    ascon_overwrite_bytes(workspace, npub, 24, ASCON128_NONCE_SIZE);
+    ascon_permute(workspace, 0);
+    ascon_absorb_16(workspace, k, 24);
 
     /* Absorb the associated data into the state */
     if (adlen > 0)
-        ascon_aead_absorb_8(&state, ad, adlen, 6, 1);
+        ascon_aead_absorb_8(workspace, ad, adlen, 6, 1);
 
     /* Separator between the associated data and the payload */
-    ascon_separator(&state);
+    ascon_separator(workspace);
 
     /* Encrypt the plaintext to create the ciphertext */
-    partial = ascon_aead_encrypt_8(&state, c, m, mlen, 6, 0);
-    ascon_pad(&state, partial);
+    partial = ascon_aead_encrypt_8(workspace, c, m, mlen, 6, 0);
+    ascon_pad(workspace, partial);
 
     /* Finalize and compute the authentication tag */
-    ascon_absorb_16(&state, k, 8);
-    ascon_permute(&state, 0);
-    ascon_absorb_16(&state, k, 24);
-    ascon_squeeze_partial(&state, c + mlen, 24, ASCON128_TAG_SIZE);
-    ascon_free(&state);
+    ascon_absorb_16(workspace, k, 8);
+    ascon_permute(workspace, 0);
+    ascon_absorb_16(workspace, k, 24);
+    ascon_squeeze_partial(workspace, c + mlen, 24, ASCON128_TAG_SIZE);
+    ascon_free(workspace);
+    ascon_latency_end(ASCON_LATENCY_AEAD);
 }
 
-int ascon128_aead_decrypt
-    (unsigned char *m, size_t *mlen,
-     const unsigned char *c, size_t clen,
+void ascon128_aead_encrypt
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
      const unsigned char *k)
 {
     ascon_state_t state;
+    ascon128_aead_encrypt_ex(c, clen, m, mlen, ad, adlen, npub, k, &state);
+}
+
+int ascon128_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace)
+{
     unsigned char tag[ASCON128_TAG_SIZE];
     unsigned char partial;
     int result;
+    ascon_latency_begin();
 
     /* Set the length of the returned plaintext */
     if (clen < ASCON128_TAG_SIZE)
@@ -86,31 +102,46 @@ int ascon128_aead_decrypt
     *mlen = clen - ASCON128_TAG_SIZE;
 
     /* Initialize the ASCON state */
-    ascon_init(&state);
-    ascon_overwrite_bytes(&state, ASCON128_IV, 0, 8);
-    ascon_overwrite_bytes(&state, k, 8, ASCON128_KEY_SIZE);
-    ascon_overwrite_bytes(&state, npub, 24, ASCON128_NONCE_SIZE);
-    ascon_permute(&state, 0);
-    ascon_absorb_16(&state, k, 24);
+    ascon_init(workspace);
+    ascon_overwrite_bytes(workspace, ASCON128_IV, 0, 8);
+    ascon_overwrite_bytes(workspace, k, 8, ASCON128_KEY_SIZE);
+    ascon_overwrite_bytes(workspace, npub, 24, ASCON128_NONCE_SIZE);
+    ascon_permute(workspace, 0);
+    ascon_absorb_16(workspace, k, 24);
 
     /* Absorb the associated data into the state */
     if (adlen > 0)
-        ascon_aead_absorb_8(&state, ad, adlen, 6, 1);
+        ascon_aead_absorb_8(workspace, ad, adlen, 6, 1);
 
     /* Separator between the associated data and the payload */
-    ascon_separator(&state);
+    ascon_separator(workspace);
 
     /* Decrypt the ciphertext to create the plaintext */
-    partial = ascon_aead_decrypt_8(&state, m, c, *mlen, 6, 0);
-    ascon_pad(&state, partial);
+    partial = ascon_aead_decrypt_8(workspace, m, c, *mlen, 6, 0);
+    ascon_pad(workspace, partial);
 
     /* Finalize and check the authentication tag */
-    ascon_absorb_16(&state, k, 8);
-    ascon_permute(&state, 0);
-    ascon_absorb_16(&state, k, 24);
-    ascon_squeeze_16(&state, tag, 24);
+    ascon_absorb_16(workspace, k, 8);
+    ascon_permute(workspace, 0);
+    ascon_absorb_16(workspace, k, 24);
+    ascon_squeeze_16(workspace, tag, 24);
     result = ascon_aead_check_tag(m, *mlen, tag, c + *mlen, ASCON128_TAG_SIZE);
     ascon_clean(tag, sizeof(tag));
-    ascon_free(&state);
+    ascon_free(workspace);
+    ascon_latency_end(ASCON_LATENCY_AEAD);
     return result;
 }
+
+int ascon128_aead_decrypt
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    return ascon128_aead_decrypt_ex
+        (m, mlen, c, clen, ad, adlen, npub, k, &state);
+}
+
+#endif /* ASCON_ENABLE_AEAD */
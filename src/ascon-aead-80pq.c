@@ -20,98 +20,215 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
+#include "ascon-latency.h"
 #include "utility/ascon-aead-common.h"
 #include "utility/ascon-util-snp.h"
 #include <string.h>
 
+#if ASCON_ENABLE_AEAD
+
 /**
  * \brief Initialization vector for ASCON-80pq.
  */
 static uint8_t const ASCON80PQ_IV[4] = {0xa0, 0x40, 0x0c, 0x06};
 
-void ascon80pq_aead_encrypt
+/**
+ * \brief Initializes the ASCON-80pq state and absorbs the associated data.
+ *
+ * \param state The state to initialize.
+ * \param ad Points to the associated data.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the nonce.
+ * \param k Points to the key.
+ */
+static void ascon80pq_aead_init_state
+    (ascon_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const unsigned char *k)
+{
+    ascon_init(state);
+    ascon_overwrite_bytes(state, ASCON80PQ_IV, 0, 4);
+    ascon_overwrite_bytes(state, k, 4, ASCON80PQ_KEY_SIZE);
+    ascon_overwrite_bytes(state, npub, 24, ASCON80PQ_NONCE_SIZE);
+    ascon_permute(state, 0);
+    ascon_absorb_partial(state, k, 20, ASCON80PQ_KEY_SIZE);
+    if (adlen > 0)
+        ascon_aead_absorb_8(state, ad, adlen, 6, 1);
+    ascon_separator(state);
+}
+
+/**
+ * \brief Finalizes the ASCON-80pq state and checks the authentication tag.
+ *
+ * \param state The state to finalize, which is also freed.
+ * \param partial Length of the partial block at the end of the payload.
+ * \param k Points to the key.
+ * \param expected Points to the expected authentication tag.
+ *
+ * \return 0 if the tag is correct, or -1 if it is incorrect.
+ */
+static int ascon80pq_aead_check
+    (ascon_state_t *state, unsigned char partial, const unsigned char *k,
+     const unsigned char *expected)
+{
+    unsigned char tag[ASCON80PQ_TAG_SIZE];
+    int result;
+    ascon_pad(state, partial);
+    ascon_absorb_partial(state, k, 8, ASCON80PQ_KEY_SIZE);
+    ascon_permute(state, 0);
+    ascon_absorb_16(state, k + 4, 24);
+    ascon_squeeze_16(state, tag, 24);
+    result = ascon_aead_check_tag(0, 0, tag, expected, ASCON80PQ_TAG_SIZE);
+    ascon_clean(tag, sizeof(tag));
+    ascon_free(state);
+    return result;
+}
+
+void ascon80pq_aead_encrypt_ex
     (unsigned char *c, size_t *clen,
      const unsigned char *m, size_t mlen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
-     const unsigned char *k)
+     const unsigned char *k, ascon_state_t *workspace)
 {
-    ascon_state_t state;
     unsigned char partial;
+    ascon_latency_begin();
 
     /* Set the length of the returned ciphertext */
     *clen = mlen + ASCON80PQ_TAG_SIZE;
 
-    /* Initialize the ASCON state */
-    ascon_init(&state);
-    ascon_overwrite_bytes(&state, ASCON80PQ_IV, 0, 4);
-    ascon_overwrite_bytes(&state, k, 4, ASCON80PQ_KEY_SIZE);
-    ascon_overwrite_bytes(&state, npub, 24, ASCON80PQ_NONCE_SIZE);
-    ascon_permute(&state, 0);
-    ascon_absorb_partial(&state, k, 20, ASCON80PQ_KEY_SIZE);
-
-    /* Absorb the associated data into the state */
-    if (adlen > 0)
-        ascon_aead_absorb_8(&state, ad, adlen, 6, 1);
-
-    /* Separator between the associated data and the payload */
-    ascon_separator(&state);
+    /* Initialize the ASCON state and absorb the associated data */
+    ascon80pq_aead_init_state(workspace, ad, adlen, npub, k);
 
     /* Encrypt the plaintext to create the ciphertext */
-    partial = ascon_aead_encrypt_8(&state, c, m, mlen, 6, 0);
-    ascon_pad(&state, partial);
+    partial = ascon_aead_encrypt_8(workspace, c, m, mlen, 6, 0);
+    ascon_pad(workspace, partial);
 
     /* Finalize and compute the authentication tag */
-    ascon_absorb_partial(&state, k, 8, ASCON80PQ_KEY_SIZE);
-    ascon_permute(&state, 0);
-    ascon_absorb_16(&state, k + 4, 24);
-    ascon_squeeze_16(&state, c + mlen, 24);
-    ascon_free(&state);
+    ascon_absorb_partial(workspace, k, 8, ASCON80PQ_KEY_SIZE);
+    ascon_permute(workspace, 0);
+    ascon_absorb_16(workspace, k + 4, 24);
+    ascon_squeeze_16(workspace, c + mlen, 24);
+    ascon_free(workspace);
+    ascon_latency_end(ASCON_LATENCY_AEAD);
 }
 
-int ascon80pq_aead_decrypt
-    (unsigned char *m, size_t *mlen,
-     const unsigned char *c, size_t clen,
+void ascon80pq_aead_encrypt
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
      const unsigned char *k)
 {
     ascon_state_t state;
+    ascon80pq_aead_encrypt_ex(c, clen, m, mlen, ad, adlen, npub, k, &state);
+}
+
+int ascon80pq_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace)
+{
     unsigned char tag[ASCON80PQ_TAG_SIZE];
     unsigned char partial;
     int result;
+    ascon_latency_begin();
 
     /* Set the length of the returned plaintext */
     if (clen < ASCON80PQ_TAG_SIZE)
         return -1;
     *mlen = clen - ASCON80PQ_TAG_SIZE;
 
-    /* Initialize the ASCON state */
-    ascon_init(&state);
-    ascon_overwrite_bytes(&state, ASCON80PQ_IV, 0, 4);
-    ascon_overwrite_bytes(&state, k, 4, ASCON80PQ_KEY_SIZE);
-    ascon_overwrite_bytes(&state, npub, 24, ASCON80PQ_NONCE_SIZE);
-    ascon_permute(&state, 0);
-    ascon_absorb_partial(&state, k, 20, ASCON80PQ_KEY_SIZE);
-
-    /* Absorb the associated data into the state */
-    if (adlen > 0)
-        ascon_aead_absorb_8(&state, ad, adlen, 6, 1);
-
-    /* Separator between the associated data and the payload */
-    ascon_separator(&state);
+    /* Initialize the ASCON state and absorb the associated data */
+    ascon80pq_aead_init_state(workspace, ad, adlen, npub, k);
 
     /* Decrypt the ciphertext to create the plaintext */
-    partial = ascon_aead_decrypt_8(&state, m, c, *mlen, 6, 0);
-    ascon_pad(&state, partial);
+    partial = ascon_aead_decrypt_8(workspace, m, c, *mlen, 6, 0);
+    ascon_pad(workspace, partial);
 
     /* Finalize and check the authentication tag */
-    ascon_absorb_partial(&state, k, 8, ASCON80PQ_KEY_SIZE);
-    ascon_permute(&state, 0);
-    ascon_absorb_16(&state, k + 4, 24);
-    ascon_squeeze_16(&state, tag, 24);
+    ascon_absorb_partial(workspace, k, 8, ASCON80PQ_KEY_SIZE);
+    ascon_permute(workspace, 0);
+    ascon_absorb_16(workspace, k + 4, 24);
+    ascon_squeeze_16(workspace, tag, 24);
     result = ascon_aead_check_tag(m, *mlen, tag, c + *mlen, ASCON80PQ_TAG_SIZE);
     ascon_clean(tag, sizeof(tag));
-    ascon_free(&state);
+    ascon_free(workspace);
+    ascon_latency_end(ASCON_LATENCY_AEAD);
     return result;
 }
+
+int ascon80pq_aead_decrypt
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    return ascon80pq_aead_decrypt_ex
+        (m, mlen, c, clen, ad, adlen, npub, k, &state);
+}
+
+int ascon80pq_aead_verify
+    (const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    unsigned char partial;
+    size_t len;
+
+    /* Validate the length of the input */
+    if (clen < ASCON80PQ_TAG_SIZE)
+        return -1;
+    len = clen - ASCON80PQ_TAG_SIZE;
+
+    /* Absorb the ciphertext and check the tag */
+    ascon80pq_aead_init_state(&state, ad, adlen, npub, k);
+    partial = ascon_aead_verify_8(&state, c, len, 6);
+    return ascon80pq_aead_check(&state, partial, k, c + len);
+}
+
+int ascon80pq_aead_decrypt_two_pass
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    ascon_state_t saved;
+    unsigned char partial;
+    size_t len;
+    int result;
+
+    /* Validate the length of the input */
+    if (clen < ASCON80PQ_TAG_SIZE)
+        return -1;
+    len = clen - ASCON80PQ_TAG_SIZE;
+
+    /* Process the associated data once and save the state for pass two */
+    ascon80pq_aead_init_state(&state, ad, adlen, npub, k);
+    ascon_init(&saved);
+    ascon_copy(&saved, &state);
+
+    /* First pass: check the tag without writing any plaintext */
+    partial = ascon_aead_verify_8(&state, c, len, 6);
+    result = ascon80pq_aead_check(&state, partial, k, c + len);
+    if (result != 0) {
+        ascon_free(&saved);
+        return result;
+    }
+
+    /* Second pass: decrypt the ciphertext now that we know it is genuine */
+    *mlen = len;
+    ascon_aead_decrypt_8(&saved, m, c, len, 6, 0);
+    ascon_free(&saved);
+    return 0;
+}
+
+#endif /* ASCON_ENABLE_AEAD */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2021 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-aead.h"
+
+#if ASCON_ENABLE_AEAD
+
+/* Initialization vector for ASCON-128 */
+static uint8_t const ASCON128_IV[8] =
+    {0x80, 0x40, 0x0c, 0x06, 0x00, 0x00, 0x00, 0x00};
+
+#define AEAD_ALG_NAME ascon128_aead
+#define AEAD_IV ASCON128_IV
+#define AEAD_RATE ASCON128_RATE
+#define AEAD_FIRST_ROUND 6
+#include "utility/ascon-aead-batch-common.h"
+
+#endif /* ASCON_ENABLE_AEAD */
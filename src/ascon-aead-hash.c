@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-hash.h"
+#include "utility/ascon-aead-common.h"
+#include "utility/ascon-util-snp.h"
+#include <string.h>
+
+#if ASCON_ENABLE_AEAD && ASCON_ENABLE_HASH
+
+/* Initialization vector for ASCON-128a */
+static uint8_t const ASCON128a_IV[8] =
+    {0x80, 0x80, 0x0c, 0x08, 0x00, 0x00, 0x00, 0x00};
+
+/**
+ * \brief Initializes the ASCON-128a state and absorbs the associated data.
+ *
+ * \param state The state to initialize.
+ * \param ad Points to the associated data.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the nonce.
+ * \param k Points to the key.
+ */
+static void ascon128a_aead_hash_start
+    (ascon_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const unsigned char *k)
+{
+    ascon_init(state);
+    ascon_overwrite_bytes(state, ASCON128a_IV, 0, 8);
+    ascon_overwrite_bytes(state, k, 8, ASCON128_KEY_SIZE);
+    ascon_overwrite_bytes(state, npub, 24, ASCON128_NONCE_SIZE);
+    ascon_permute(state, 0);
+    ascon_absorb_16(state, k, 24);
+    if (adlen > 0)
+        ascon_aead_absorb_16(state, ad, adlen, 4, 1);
+    ascon_separator(state);
+}
+
+/**
+ * \brief Finalizes the ASCON-128a state and squeezes the tag.
+ *
+ * \param state The state to finalize, which is also freed.
+ * \param partial Length of the partial block at the end of the payload.
+ * \param k Points to the key.
+ * \param tag Returns the authentication tag.
+ */
+static void ascon128a_aead_hash_finish
+    (ascon_state_t *state, unsigned char partial, const unsigned char *k,
+     unsigned char *tag)
+{
+    ascon_pad(state, partial);
+    ascon_absorb_16(state, k, 16);
+    ascon_permute(state, 0);
+    ascon_absorb_16(state, k, 24);
+    ascon_squeeze_16(state, tag, 24);
+    ascon_free(state);
+}
+
+/**
+ * \brief Permutes the AEAD and hash states after a block of the payload.
+ *
+ * \param aead The AEAD state, which always uses 8 rounds.
+ * \param hash The hash state.
+ * \param hash_round First round of the hash permutation; 0 or 4.
+ *
+ * ASCON-HASHA uses the same number of rounds as the ASCON-128a payload,
+ * so both states can be permuted together with the interleaved
+ * two-state permutation.
+ */
+#define ascon128a_aead_hash_permute(aead, hash, hash_round) \
+    do { \
+        if ((hash_round) == 4) { \
+            ascon_permute_x2((aead), (hash), 4); \
+        } else { \
+            ascon_permute((aead), 4); \
+            ascon_permute((hash), (hash_round)); \
+        } \
+    } while (0)
+
+/**
+ * \brief Encrypts the full 16-byte blocks of the payload and absorbs
+ * the plaintext into a hash state at the same time.
+ *
+ * \param aead The AEAD state.
+ * \param hash The hash state, with no bytes absorbed into the current block.
+ * \param c Points to the ciphertext output buffer.
+ * \param m Points to the plaintext input buffer.
+ * \param mlen Length of the plaintext; must be a multiple of 16.
+ * \param hash_round First round of the hash permutation; 0 or 4.
+ */
+static void ascon128a_aead_hash_encrypt_blocks
+    (ascon_state_t *aead, ascon_state_t *hash, unsigned char *c,
+     const unsigned char *m, size_t mlen, uint8_t hash_round)
+{
+    while (mlen > 0) {
+        /* Absorb the plaintext into the hash before encrypting it
+         * in case the encryption is being performed in-place */
+        ascon_absorb_8(hash, m, 0);
+        ascon_permute(hash, hash_round);
+        ascon_absorb_8(hash, m + 8, 0);
+        ascon_encrypt_16(aead, c, m, 0);
+        ascon128a_aead_hash_permute(aead, hash, hash_round);
+        c += 16;
+        m += 16;
+        mlen -= 16;
+    }
+}
+
+/**
+ * \brief Decrypts the full 16-byte blocks of the payload and absorbs
+ * the plaintext into a hash state at the same time.
+ *
+ * \param aead The AEAD state.
+ * \param hash The hash state, with no bytes absorbed into the current block.
+ * \param m Points to the plaintext output buffer.
+ * \param c Points to the ciphertext input buffer.
+ * \param clen Length of the ciphertext; must be a multiple of 16.
+ * \param hash_round First round of the hash permutation; 0 or 4.
+ */
+static void ascon128a_aead_hash_decrypt_blocks
+    (ascon_state_t *aead, ascon_state_t *hash, unsigned char *m,
+     const unsigned char *c, size_t clen, uint8_t hash_round)
+{
+    while (clen > 0) {
+        ascon_decrypt_16(aead, m, c, 0);
+        ascon_absorb_8(hash, m, 0);
+        ascon_permute(hash, hash_round);
+        ascon_absorb_8(hash, m + 8, 0);
+        ascon128a_aead_hash_permute(aead, hash, hash_round);
+        c += 16;
+        m += 16;
+        clen -= 16;
+    }
+}
+
+#define AEAD_HASH_NAME ascon128a_aead_encrypt_and_hash
+#define AEAD_UNHASH_NAME ascon128a_aead_decrypt_and_hash
+#define HASH_ALG_NAME ascon_hash
+#define HASH_STATE_TYPE ascon_hash_state_t
+#define HASH_FIRST_ROUND 0
+#include "utility/ascon-aead-hash-common.h"
+
+#define AEAD_HASH_NAME ascon128a_aead_encrypt_and_hasha
+#define AEAD_UNHASH_NAME ascon128a_aead_decrypt_and_hasha
+#define HASH_ALG_NAME ascon_hasha
+#define HASH_STATE_TYPE ascon_hasha_state_t
+#define HASH_FIRST_ROUND 4
+#include "utility/ascon-aead-hash-common.h"
+
+#endif /* ASCON_ENABLE_AEAD && ASCON_ENABLE_HASH */
@@ -20,19 +20,21 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "utility/ascon-aead-common.h"
 #include "utility/ascon-util-snp.h"
 #include <string.h>
 
+#if ASCON_ENABLE_AEAD
+
 /* Initialization vector for ASCON-128 */
 static uint8_t const ASCON128_IV[8] =
     {0x80, 0x40, 0x0c, 0x06, 0x00, 0x00, 0x00, 0x00};
 
-void ascon128_aead_start
-    (ascon128_state_t *state, const unsigned char *ad, size_t adlen,
-     const unsigned char *npub, const unsigned char *k)
+static void ascon128_aead_init_state
+    (ascon128_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
 {
-    /* Initialize the ASCON state */
     memcpy(state->key, k, ASCON128_KEY_SIZE);
     ascon_init(&(state->state));
     ascon_overwrite_bytes(&(state->state), ASCON128_IV, 0, 8);
@@ -40,6 +42,14 @@ void ascon128_aead_start
     ascon_overwrite_bytes(&(state->state), npub, 24, ASCON128_NONCE_SIZE);
     ascon_permute(&(state->state), 0);
     ascon_absorb_16(&(state->state), state->key, 24);
+}
+
+void ascon128_aead_start
+    (ascon128_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const unsigned char *k)
+{
+    /* Initialize the ASCON state */
+    ascon128_aead_init_state(state, npub, k);
 
     /* Absorb the associated data into the state */
     if (adlen > 0)
@@ -51,6 +61,50 @@ void ascon128_aead_start
     /* Prepare for encryption or decryption */
     ascon_release(&(state->state));
     state->posn = 0;
+    state->has_ad = 0;
+}
+
+void ascon128_aead_start_ad
+    (ascon128_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    /* Initialize the ASCON state */
+    ascon128_aead_init_state(state, npub, k);
+
+    /* Prepare to absorb the associated data */
+    ascon_release(&(state->state));
+    state->posn = 0;
+    state->has_ad = 0;
+}
+
+void ascon128_aead_ad_update
+    (ascon128_state_t *state, const unsigned char *ad, size_t adlen)
+{
+    if (adlen > 0) {
+        ascon_acquire(&(state->state));
+        state->posn = ascon_aead_absorb_stream_8
+            (&(state->state), ad, adlen, 6, state->posn);
+        ascon_release(&(state->state));
+        state->has_ad = 1;
+    }
+}
+
+void ascon128_aead_ad_finish(ascon128_state_t *state)
+{
+    /* Pad and permute the last block of associated data, if any */
+    ascon_acquire(&(state->state));
+    if (state->has_ad) {
+        ascon_pad(&(state->state), state->posn);
+        ascon_permute(&(state->state), 6);
+    }
+
+    /* Separator between the associated data and the payload */
+    ascon_separator(&(state->state));
+
+    /* Prepare for encryption or decryption */
+    ascon_release(&(state->state));
+    state->posn = 0;
+    state->has_ad = 0;
 }
 
 void ascon128_aead_abort(ascon128_state_t *state)
@@ -123,3 +177,5 @@ int ascon128_aead_decrypt_finalize
     ascon_clean(state, sizeof(ascon128_state_t));
     return result;
 }
+
+#endif /* ASCON_ENABLE_AEAD */
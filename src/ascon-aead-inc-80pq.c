@@ -20,18 +20,20 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "utility/ascon-aead-common.h"
 #include "utility/ascon-util-snp.h"
 #include <string.h>
 
+#if ASCON_ENABLE_AEAD
+
 /* Initialization vector for ASCON-80pq */
 static uint8_t const ASCON80PQ_IV[4] = {0xa0, 0x40, 0x0c, 0x06};
 
-void ascon80pq_aead_start
-    (ascon80pq_state_t *state, const unsigned char *ad, size_t adlen,
-     const unsigned char *npub, const unsigned char *k)
+static void ascon80pq_aead_init_state
+    (ascon80pq_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
 {
-    /* Initialize the ASCON state */
     memcpy(state->key, k, ASCON80PQ_KEY_SIZE);
     ascon_init(&(state->state));
     ascon_overwrite_bytes(&(state->state), ASCON80PQ_IV, 0, 4);
@@ -39,6 +41,14 @@ void ascon80pq_aead_start
     ascon_overwrite_bytes(&(state->state), npub, 24, ASCON80PQ_NONCE_SIZE);
     ascon_permute(&(state->state), 0);
     ascon_absorb_partial(&(state->state), state->key, 20, ASCON80PQ_KEY_SIZE);
+}
+
+void ascon80pq_aead_start
+    (ascon80pq_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const unsigned char *k)
+{
+    /* Initialize the ASCON state */
+    ascon80pq_aead_init_state(state, npub, k);
 
     /* Absorb the associated data into the state */
     if (adlen > 0)
@@ -50,6 +60,50 @@ void ascon80pq_aead_start
     /* Prepare for encryption or decryption */
     ascon_release(&(state->state));
     state->posn = 0;
+    state->has_ad = 0;
+}
+
+void ascon80pq_aead_start_ad
+    (ascon80pq_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    /* Initialize the ASCON state */
+    ascon80pq_aead_init_state(state, npub, k);
+
+    /* Prepare to absorb the associated data */
+    ascon_release(&(state->state));
+    state->posn = 0;
+    state->has_ad = 0;
+}
+
+void ascon80pq_aead_ad_update
+    (ascon80pq_state_t *state, const unsigned char *ad, size_t adlen)
+{
+    if (adlen > 0) {
+        ascon_acquire(&(state->state));
+        state->posn = ascon_aead_absorb_stream_8
+            (&(state->state), ad, adlen, 6, state->posn);
+        ascon_release(&(state->state));
+        state->has_ad = 1;
+    }
+}
+
+void ascon80pq_aead_ad_finish(ascon80pq_state_t *state)
+{
+    /* Pad and permute the last block of associated data, if any */
+    ascon_acquire(&(state->state));
+    if (state->has_ad) {
+        ascon_pad(&(state->state), state->posn);
+        ascon_permute(&(state->state), 6);
+    }
+
+    /* Separator between the associated data and the payload */
+    ascon_separator(&(state->state));
+
+    /* Prepare for encryption or decryption */
+    ascon_release(&(state->state));
+    state->posn = 0;
+    state->has_ad = 0;
 }
 
 void ascon80pq_aead_abort(ascon80pq_state_t *state)
@@ -122,3 +176,5 @@ int ascon80pq_aead_decrypt_finalize
     ascon_clean(state, sizeof(ascon80pq_state_t));
     return result;
 }
+
+#endif /* ASCON_ENABLE_AEAD */
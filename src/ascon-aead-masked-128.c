@@ -20,9 +20,13 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
+#include "ascon-latency.h"
 #include "utility/ascon-aead-masked-common.h"
 #include "utility/ascon-util-snp.h"
 
+#if ASCON_ENABLE_MASKING
+
 /* Initialization vector for ASCON-128 */
 static uint8_t const ASCON128_IV[8] =
     {0x80, 0x40, 0x0c, 0x06, 0x00, 0x00, 0x00, 0x00};
@@ -30,10 +34,7 @@ static uint8_t const ASCON128_IV[8] =
 /* Absorb the key and nonce, and then convert the state from the
  * number of key shares into the number of data shares */
 static void ascon128_masked_aead_init
-    (ascon_masked_state_t *state,
-#if ASCON_MASKED_DATA_SHARES == 1
-    ascon_state_t *state_x1,
-#endif
+    (ascon_masked_state_t *state, ascon_state_t *state_x1, unsigned shares,
     ascon_trng_state_t *trng, ascon_masked_word_t *word,
     uint64_t *preserve, const unsigned char *npub,
     const ascon_masked_key_128_t *k)
@@ -66,23 +67,12 @@ static void ascon128_masked_aead_init
     ascon_masked_key_xor(&(state->M[4]), &(k->k[1]));
 
     /* Convert the key shares form into the data shares form */
-#if ASCON_MASKED_DATA_SHARES == 1
-    ascon_copy_key_to_x1(state_x1, state);
-#elif ASCON_MASKED_DATA_SHARES == 2
-    ascon_copy_key_to_x2(state, trng);
-#elif ASCON_MASKED_DATA_SHARES == 3
-    ascon_copy_key_to_x3(state, trng);
-#else
-    ascon_copy_key_to_x4(state, trng);
-#endif
+    ascon_masked_aead_key_to_data(state, state_x1, shares, trng);
 }
 
 /* Finalize and generate the authentication tag in the state */
 static void ascon128_masked_aead_finalize
-    (ascon_masked_state_t *state,
-#if ASCON_MASKED_DATA_SHARES == 1
-    ascon_state_t *state_x1,
-#endif
+    (ascon_masked_state_t *state, ascon_state_t *state_x1, unsigned shares,
     ascon_trng_state_t *trng, uint64_t *preserve,
     const ascon_masked_key_128_t *k, unsigned char *tag)
 {
@@ -99,15 +89,7 @@ static void ascon128_masked_aead_finalize
 #endif
 
     /* Convert the data shares form back into the key shares form */
-#if ASCON_MASKED_DATA_SHARES == 1
-    ascon_copy_key_from_x1(state, state_x1, trng);
-#elif ASCON_MASKED_DATA_SHARES == 2
-    ascon_copy_key_from_x2(state, trng);
-#elif ASCON_MASKED_DATA_SHARES == 3
-    ascon_copy_key_from_x3(state, trng);
-#else
-    ascon_copy_key_from_x4(state, trng);
-#endif
+    ascon_masked_aead_data_to_key(state, state_x1, shares, trng);
 
     /* Finalize the state and generate the tag */
     ascon_masked_key_xor(&(state->M[1]), &(k->k[0]));
@@ -119,141 +101,180 @@ static void ascon128_masked_aead_finalize
     ascon_masked_key_store(tag + 8, &(state->M[4]));
 }
 
-void ascon128_masked_aead_encrypt
+static void ascon128_masked_aead_encrypt_core
     (unsigned char *c, size_t *clen,
      const unsigned char *m, size_t mlen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
-     const ascon_masked_key_128_t *k)
+     const ascon_masked_key_128_t *k,
+     ascon_masked_state_t *state, ascon_state_t *state_x1,
+     ascon_trng_state_t *trng, ascon_masked_word_t *word, uint64_t *preserve)
 {
-    ascon_masked_state_t state;
 #if ASCON_MASKED_DATA_SHARES == 1
-    ascon_state_t state_x1;
     unsigned char partial;
 #endif
-    ascon_trng_state_t trng;
-    ascon_masked_word_t word;
-    uint64_t preserve[ASCON_MASKED_KEY_SHARES - 1];
+    ascon_latency_begin();
 
     /* Set the length of the returned ciphertext */
     *clen = mlen + ASCON128_TAG_SIZE;
 
-    /* Initialize the random number generator */
-    ascon_trng_init(&trng);
-
 #if ASCON_MASKED_DATA_SHARES == 1
     /* Initialize the ASCON state */
     ascon128_masked_aead_init
-        (&state, &state_x1, &trng, &word, preserve, npub, k);
+        (state, state_x1, 1, trng, word, preserve, npub, k);
 
     /* Absorb the associated data into the state */
     if (adlen > 0)
-        ascon_aead_absorb_8(&state_x1, ad, adlen, 6, 1);
+        ascon_aead_absorb_8(state_x1, ad, adlen, 6, 1);
 
     /* Separator between the associated data and the payload */
-    ascon_separator(&state_x1);
+    ascon_separator(state_x1);
 
     /* Encrypt the plaintext to create the ciphertext */
-    partial = ascon_aead_encrypt_8(&state_x1, c, m, mlen, 6, 0);
-    ascon_pad(&state_x1, partial);
+    partial = ascon_aead_encrypt_8(state_x1, c, m, mlen, 6, 0);
+    ascon_pad(state_x1, partial);
 
     /* Convert the state back into key masked form and finalize */
     ascon128_masked_aead_finalize
-        (&state, &state_x1, &trng, preserve, k, c + mlen);
+        (state, state_x1, 1, trng, preserve, k, c + mlen);
 #else
+    (void)state_x1;
+
     /* Initialize the ASCON state */
-    ascon128_masked_aead_init(&state, &trng, &word, preserve, npub, k);
+    ascon128_masked_aead_init
+        (state, 0, ASCON_MASKED_DATA_SHARES, trng, word, preserve, npub, k);
 
     /* Absorb the associated data into the state */
     if (adlen > 0) {
         ascon_masked_aead_absorb_8
-            (&state, ad, adlen, 6, &word, preserve, &trng);
+            (state, ad, adlen, 6, word, preserve, trng);
     }
 
     /* Separator between the associated data and the payload */
-    ascon_masked_word_separator(&(state.M[4]));
+    ascon_masked_word_separator(&(state->M[4]));
 
     /* Encrypt the plaintext to create the ciphertext */
     ascon_masked_aead_encrypt_8
-        (&state, c, m, mlen, 6, &word, preserve, &trng);
+        (state, c, m, mlen, 6, word, preserve, trng);
 
     /* Convert the state back into key masked form and finalize */
-    ascon128_masked_aead_finalize(&state, &trng, preserve, k, c + mlen);
+    ascon128_masked_aead_finalize
+        (state, 0, ASCON_MASKED_DATA_SHARES, trng, preserve, k, c + mlen);
 #endif
 
     /* Clean up */
 #if ASCON_MASKED_DATA_SHARES == 1
-    ascon_free(&state_x1);
+    ascon_free(state_x1);
 #endif
-    ascon_masked_state_free(&state);
-    ascon_clean(&word, sizeof(word));
-    ascon_clean(preserve, sizeof(preserve));
-    ascon_trng_free(&trng);
+    ascon_masked_state_free(state);
+    ascon_clean(word, sizeof(ascon_masked_word_t));
+    ascon_clean(preserve, sizeof(uint64_t) * (ASCON_MASKED_KEY_SHARES - 1));
+    ascon_latency_end(ASCON_LATENCY_MASKED_AEAD);
 }
 
-int ascon128_masked_aead_decrypt
-    (unsigned char *m, size_t *mlen,
-     const unsigned char *c, size_t clen,
+void ascon128_masked_aead_encrypt
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
      const ascon_masked_key_128_t *k)
 {
     ascon_masked_state_t state;
 #if ASCON_MASKED_DATA_SHARES == 1
-    ascon_state_t state_x1;
-    unsigned char partial;
+    ascon_state_t x1;
+    ascon_state_t *state_x1 = &x1;
+#else
+    ascon_state_t *state_x1 = 0;
 #endif
     ascon_trng_state_t trng;
     ascon_masked_word_t word;
     uint64_t preserve[ASCON_MASKED_KEY_SHARES - 1];
+
+    ascon_trng_init(&trng);
+    ascon128_masked_aead_encrypt_core
+        (c, clen, m, mlen, ad, adlen, npub, k,
+         &state, state_x1, &trng, &word, preserve);
+    ascon_trng_free(&trng);
+}
+
+void ascon128_masked_aead_encrypt_ex
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_aead_workspace_t *workspace)
+{
+    ascon128_masked_aead_encrypt_core
+        (c, clen, m, mlen, ad, adlen, npub, k,
+         ascon_masked_inc_state(workspace), &(workspace->state_x1),
+         ascon_masked_inc_trng(workspace),
+         (ascon_masked_word_t *)&(workspace->word), workspace->preserve);
+}
+
+static int ascon128_masked_aead_decrypt_core
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_state_t *state, ascon_state_t *state_x1,
+     ascon_trng_state_t *trng, ascon_masked_word_t *word, uint64_t *preserve)
+{
+#if ASCON_MASKED_DATA_SHARES == 1
+    unsigned char partial;
+#endif
     unsigned char tag[ASCON128_TAG_SIZE];
     int result;
+    ascon_latency_begin();
 
     /* Set the length of the returned plaintext */
     if (clen < ASCON128_TAG_SIZE)
         return -1;
     *mlen = clen - ASCON128_TAG_SIZE;
 
-    /* Initialize the random number generator */
-    ascon_trng_init(&trng);
-
 #if ASCON_MASKED_DATA_SHARES == 1
     /* Initialize the ASCON state */
     ascon128_masked_aead_init
-        (&state, &state_x1, &trng, &word, preserve, npub, k);
+        (state, state_x1, 1, trng, word, preserve, npub, k);
 
     /* Absorb the associated data into the state */
     if (adlen > 0)
-        ascon_aead_absorb_8(&state_x1, ad, adlen, 6, 1);
+        ascon_aead_absorb_8(state_x1, ad, adlen, 6, 1);
 
     /* Separator between the associated data and the payload */
-    ascon_separator(&state_x1);
+    ascon_separator(state_x1);
 
     /* Decrypt the ciphertext to create the plaintext */
-    partial = ascon_aead_decrypt_8(&state_x1, m, c, *mlen, 6, 0);
-    ascon_pad(&state_x1, partial);
+    partial = ascon_aead_decrypt_8(state_x1, m, c, *mlen, 6, 0);
+    ascon_pad(state_x1, partial);
 
     /* Convert the state back into key masked form and finalize */
-    ascon128_masked_aead_finalize(&state, &state_x1, &trng, preserve, k, tag);
+    ascon128_masked_aead_finalize
+        (state, state_x1, 1, trng, preserve, k, tag);
 #else
+    (void)state_x1;
+
     /* Initialize the ASCON state */
-    ascon128_masked_aead_init(&state, &trng, &word, preserve, npub, k);
+    ascon128_masked_aead_init
+        (state, 0, ASCON_MASKED_DATA_SHARES, trng, word, preserve, npub, k);
 
     /* Absorb the associated data into the state */
     if (adlen > 0) {
         ascon_masked_aead_absorb_8
-            (&state, ad, adlen, 6, &word, preserve, &trng);
+            (state, ad, adlen, 6, word, preserve, trng);
     }
 
     /* Separator between the associated data and the payload */
-    ascon_masked_word_separator(&(state.M[4]));
+    ascon_masked_word_separator(&(state->M[4]));
 
     /* Decrypt the ciphertext to create the plaintext */
     ascon_masked_aead_decrypt_8
-        (&state, m, c, *mlen, 6, &word, preserve, &trng);
+        (state, m, c, *mlen, 6, word, preserve, trng);
 
     /* Convert the state back into key masked form and finalize */
-    ascon128_masked_aead_finalize(&state, &trng, preserve, k, tag);
+    ascon128_masked_aead_finalize
+        (state, 0, ASCON_MASKED_DATA_SHARES, trng, preserve, k, tag);
 #endif
 
     /* Check the authentication tag */
@@ -261,12 +282,257 @@ int ascon128_masked_aead_decrypt
 
     /* Clean up */
 #if ASCON_MASKED_DATA_SHARES == 1
-    ascon_free(&state_x1);
+    ascon_free(state_x1);
 #endif
-    ascon_masked_state_free(&state);
-    ascon_clean(&word, sizeof(word));
-    ascon_clean(preserve, sizeof(preserve));
+    ascon_masked_state_free(state);
+    ascon_clean(word, sizeof(ascon_masked_word_t));
+    ascon_clean(preserve, sizeof(uint64_t) * (ASCON_MASKED_KEY_SHARES - 1));
     ascon_clean(tag, sizeof(tag));
+    ascon_latency_end(ASCON_LATENCY_MASKED_AEAD);
+    return result;
+}
+
+int ascon128_masked_aead_decrypt
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k)
+{
+    ascon_masked_state_t state;
+#if ASCON_MASKED_DATA_SHARES == 1
+    ascon_state_t x1;
+    ascon_state_t *state_x1 = &x1;
+#else
+    ascon_state_t *state_x1 = 0;
+#endif
+    ascon_trng_state_t trng;
+    ascon_masked_word_t word;
+    uint64_t preserve[ASCON_MASKED_KEY_SHARES - 1];
+    int result;
+
+    ascon_trng_init(&trng);
+    result = ascon128_masked_aead_decrypt_core
+        (m, mlen, c, clen, ad, adlen, npub, k,
+         &state, state_x1, &trng, &word, preserve);
     ascon_trng_free(&trng);
     return result;
 }
+
+int ascon128_masked_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_aead_workspace_t *workspace)
+{
+    return ascon128_masked_aead_decrypt_core
+        (m, mlen, c, clen, ad, adlen, npub, k,
+         ascon_masked_inc_state(workspace), &(workspace->state_x1),
+         ascon_masked_inc_trng(workspace),
+         (ascon_masked_word_t *)&(workspace->word), workspace->preserve);
+}
+
+void ascon128_masked_aead_state_init(ascon128_masked_state_t *state)
+{
+    ascon_trng_state_t *trng = ascon_masked_inc_trng(state);
+    memset(state, 0, sizeof(ascon128_masked_state_t));
+    ascon_trng_init(trng);
+    ascon_trng_attach_pool(trng, state->pool, ASCON_MASKED_POOL_WORDS);
+    ascon_trng_refill_pool(trng);
+    state->data_shares = ASCON_MASKED_DATA_SHARES;
+}
+
+int ascon128_masked_aead_set_data_shares
+    (ascon128_masked_state_t *state, unsigned shares)
+{
+    if (shares < 1 || shares > ASCON_MASKED_KEY_SHARES)
+        return -2;
+    state->data_shares = (unsigned char)shares;
+    return 0;
+}
+
+void ascon128_masked_aead_refill(ascon128_masked_state_t *state)
+{
+    ascon_trng_refill_pool(ascon_masked_inc_trng(state));
+}
+
+void ascon128_masked_aead_state_free(ascon128_masked_state_t *state)
+{
+    if (state) {
+        ascon_trng_free(ascon_masked_inc_trng(state));
+        ascon_clean(state, sizeof(ascon128_masked_state_t));
+    }
+}
+
+void ascon128_masked_aead_start
+    (ascon128_masked_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const ascon_masked_key_128_t *k)
+{
+    ascon_masked_state_t *mstate = ascon_masked_inc_state(state);
+    ascon_trng_state_t *trng = ascon_masked_inc_trng(state);
+    unsigned shares = state->data_shares;
+    ascon_masked_word_t word;
+
+    /* Keep a copy of the masked key for finalization */
+    memcpy(&(state->key), k, sizeof(ascon_masked_key_128_t));
+    state->padded = 0;
+    state->active_shares = (unsigned char)shares;
+
+    /* Initialize the ASCON state */
+    ascon128_masked_aead_init
+        (mstate, &(state->state_x1), shares, trng, &word,
+         state->preserve, npub, k);
+
+    if (shares == 1) {
+        /* Absorb the associated data into the state */
+        if (adlen > 0)
+            ascon_aead_absorb_8(&(state->state_x1), ad, adlen, 6, 1);
+
+        /* Separator between the associated data and the payload */
+        ascon_separator(&(state->state_x1));
+        ascon_release(&(state->state_x1));
+    } else {
+        /* Absorb the associated data into the state */
+        if (adlen > 0) {
+            ascon_masked_aead_dispatch
+                (shares, ascon_masked_aead_absorb_8,
+                 (mstate, ad, adlen, 6, &word, state->preserve, trng));
+        }
+
+        /* Separator between the associated data and the payload */
+        ascon_masked_word_separator(&(mstate->M[4]));
+    }
+    ascon_clean(&word, sizeof(word));
+}
+
+void ascon128_masked_aead_abort(ascon128_masked_state_t *state)
+{
+    if (state) {
+        if (state->active_shares == 1) {
+            ascon_acquire(&(state->state_x1));
+            ascon_free(&(state->state_x1));
+        }
+        ascon_masked_state_free(ascon_masked_inc_state(state));
+        ascon_clean(&(state->state_x1), sizeof(state->state_x1));
+        ascon_clean(state->preserve, sizeof(state->preserve));
+        ascon_clean(&(state->key), sizeof(state->key));
+        state->padded = 0;
+        state->active_shares = 0;
+    }
+}
+
+/* Processes a block of payload data in incremental mode */
+static int ascon128_masked_aead_crypt_block
+    (ascon128_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len, int encrypt)
+{
+    ascon_masked_state_t *mstate = ascon_masked_inc_state(state);
+    ascon_trng_state_t *trng = ascon_masked_inc_trng(state);
+    unsigned shares = state->active_shares;
+    ascon_masked_word_t word;
+    unsigned char partial;
+    if (state->padded)
+        return -2;
+    if (shares == 1) {
+        ascon_acquire(&(state->state_x1));
+        if (encrypt) {
+            partial = ascon_aead_encrypt_8
+                (&(state->state_x1), out, in, len, 6, 0);
+        } else {
+            partial = ascon_aead_decrypt_8
+                (&(state->state_x1), out, in, len, 6, 0);
+        }
+        if (partial != 0) {
+            ascon_pad(&(state->state_x1), partial);
+            state->padded = 1;
+        }
+        ascon_release(&(state->state_x1));
+        return 0;
+    }
+    if ((len % 8U) == 0) {
+        /* Whole blocks only, so the payload may continue afterwards */
+        if (encrypt) {
+            ascon_masked_aead_dispatch
+                (shares, ascon_masked_aead_encrypt_blocks_8,
+                 (mstate, out, in, len / 8U, 6, &word,
+                  state->preserve, trng));
+        } else {
+            ascon_masked_aead_dispatch
+                (shares, ascon_masked_aead_decrypt_blocks_8,
+                 (mstate, out, in, len / 8U, 6, &word,
+                  state->preserve, trng));
+        }
+    } else {
+        /* Partial block on the end, so this is the last of the payload */
+        if (encrypt) {
+            ascon_masked_aead_dispatch
+                (shares, ascon_masked_aead_encrypt_8,
+                 (mstate, out, in, len, 6, &word,
+                  state->preserve, trng));
+        } else {
+            ascon_masked_aead_dispatch
+                (shares, ascon_masked_aead_decrypt_8,
+                 (mstate, out, in, len, 6, &word,
+                  state->preserve, trng));
+        }
+        state->padded = 1;
+    }
+    ascon_clean(&word, sizeof(word));
+    return 0;
+}
+
+/* Pads the payload if necessary and computes the authentication tag */
+static void ascon128_masked_aead_compute_tag
+    (ascon128_masked_state_t *state, unsigned char *tag)
+{
+    ascon_masked_state_t *mstate = ascon_masked_inc_state(state);
+    ascon_trng_state_t *trng = ascon_masked_inc_trng(state);
+    unsigned shares = state->active_shares;
+    if (shares == 1) {
+        ascon_acquire(&(state->state_x1));
+        if (!state->padded)
+            ascon_pad(&(state->state_x1), 0);
+    } else {
+        if (!state->padded)
+            ascon_masked_word_pad(&(mstate->M[0]), 0);
+    }
+    ascon128_masked_aead_finalize
+        (mstate, &(state->state_x1), shares, trng, state->preserve,
+         &(state->key), tag);
+    ascon128_masked_aead_abort(state);
+}
+
+int ascon128_masked_aead_encrypt_block
+    (ascon128_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len)
+{
+    return ascon128_masked_aead_crypt_block(state, in, out, len, 1);
+}
+
+void ascon128_masked_aead_encrypt_finalize
+    (ascon128_masked_state_t *state, unsigned char *tag)
+{
+    ascon128_masked_aead_compute_tag(state, tag);
+}
+
+int ascon128_masked_aead_decrypt_block
+    (ascon128_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len)
+{
+    return ascon128_masked_aead_crypt_block(state, in, out, len, 0);
+}
+
+int ascon128_masked_aead_decrypt_finalize
+    (ascon128_masked_state_t *state, const unsigned char *tag)
+{
+    unsigned char tag2[ASCON128_TAG_SIZE];
+    int result;
+    ascon128_masked_aead_compute_tag(state, tag2);
+    result = ascon_aead_check_tag(0, 0, tag2, tag, ASCON128_TAG_SIZE);
+    ascon_clean(tag2, sizeof(tag2));
+    return result;
+}
+
+#endif /* ASCON_ENABLE_MASKING */
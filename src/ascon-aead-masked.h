@@ -193,6 +193,995 @@ int ascon80pq_masked_aead_decrypt
      const unsigned char *npub,
      const ascon_masked_key_160_t *k);
 
+/* ---------------------------------------------------------------- */
+/*          Caller-provided workspace API's for masked AEAD         */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Reusable workspace for the one-shot masked AEAD modes.
+ *
+ * The one-shot masked functions above place several masked states and
+ * the TRNG state on the stack, and initialize the TRNG on every call.
+ * The "_ex" variants below use this workspace instead, which is
+ * initialized once with ascon_masked_aead_workspace_init() and can then
+ * be reused for any number of packets.  This allows tasks with small
+ * stacks to use masking and avoids the cost of setting up the TRNG
+ * for every packet.
+ *
+ * The masked state is destroyed at the end of every call, but the TRNG
+ * state is preserved until ascon_masked_aead_workspace_free() is called.
+ * A workspace must not be used by more than one thread at a time.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Masked permutation state, with room for the maximum number
+     *  of shares that the library supports */
+    ascon_masked_key_word_t M[5];
+
+    /** Regular permutation state for when the data is not masked */
+    ascon_state_t state_x1;
+
+    /** Temporary masked word for loading data into the state */
+    ascon_masked_key_word_t word;
+
+    /** Preserved randomness between calls to the permutation */
+    uint64_t preserve[3];
+
+    /** Storage for the random number source, which is opaque */
+    uint64_t trng[8];
+
+} ascon_masked_aead_workspace_t;
+
+/**
+ * \brief Initializes a workspace for the one-shot masked AEAD modes.
+ *
+ * \param workspace The workspace to initialize.
+ *
+ * \sa ascon_masked_aead_workspace_free()
+ */
+void ascon_masked_aead_workspace_init(ascon_masked_aead_workspace_t *workspace);
+
+/**
+ * \brief Frees a workspace for the one-shot masked AEAD modes and
+ * destroys any sensitive material in it.
+ *
+ * \param workspace The workspace to free.
+ *
+ * \sa ascon_masked_aead_workspace_init()
+ */
+void ascon_masked_aead_workspace_free(ascon_masked_aead_workspace_t *workspace);
+
+/**
+ * \brief Encrypts and authenticates a packet with masked ASCON-128
+ * using a caller-provided workspace.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 128-bit key.
+ * \param workspace Points to a workspace that was initialized with
+ * ascon_masked_aead_workspace_init().
+ *
+ * \sa ascon128_masked_aead_encrypt(), ascon128_masked_aead_decrypt_ex()
+ */
+void ascon128_masked_aead_encrypt_ex
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_aead_workspace_t *workspace);
+
+/**
+ * \brief Decrypts and authenticates a packet with masked ASCON-128
+ * using a caller-provided workspace.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 128-bit key.
+ * \param workspace Points to a workspace that was initialized with
+ * ascon_masked_aead_workspace_init().
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128_masked_aead_decrypt(), ascon128_masked_aead_encrypt_ex()
+ */
+int ascon128_masked_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_aead_workspace_t *workspace);
+
+/**
+ * \brief Encrypts and authenticates a packet with masked ASCON-128a
+ * using a caller-provided workspace.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 128-bit key.
+ * \param workspace Points to a workspace that was initialized with
+ * ascon_masked_aead_workspace_init().
+ *
+ * \sa ascon128a_masked_aead_encrypt(), ascon128a_masked_aead_decrypt_ex()
+ */
+void ascon128a_masked_aead_encrypt_ex
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_aead_workspace_t *workspace);
+
+/**
+ * \brief Decrypts and authenticates a packet with masked ASCON-128a
+ * using a caller-provided workspace.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 128-bit key.
+ * \param workspace Points to a workspace that was initialized with
+ * ascon_masked_aead_workspace_init().
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128a_masked_aead_decrypt(), ascon128a_masked_aead_encrypt_ex()
+ */
+int ascon128a_masked_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_aead_workspace_t *workspace);
+
+/**
+ * \brief Encrypts and authenticates a packet with masked ASCON-80pq
+ * using a caller-provided workspace.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 160-bit key.
+ * \param workspace Points to a workspace that was initialized with
+ * ascon_masked_aead_workspace_init().
+ *
+ * \sa ascon80pq_masked_aead_encrypt(), ascon80pq_masked_aead_decrypt_ex()
+ */
+void ascon80pq_masked_aead_encrypt_ex
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_160_t *k,
+     ascon_masked_aead_workspace_t *workspace);
+
+/**
+ * \brief Decrypts and authenticates a packet with masked ASCON-80pq
+ * using a caller-provided workspace.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 160-bit key.
+ * \param workspace Points to a workspace that was initialized with
+ * ascon_masked_aead_workspace_init().
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon80pq_masked_aead_decrypt(), ascon80pq_masked_aead_encrypt_ex()
+ */
+int ascon80pq_masked_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon_masked_key_160_t *k,
+     ascon_masked_aead_workspace_t *workspace);
+
+/* ---------------------------------------------------------------- */
+/*         Incremental API's for the masked AEAD modes below        */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Number of 32-bit words in the randomness pool of the incremental
+ * masked AEAD states.
+ *
+ * The pool is filled in bulk by ascon128_masked_aead_refill() and
+ * friends when the application is not on the time-critical path,
+ * and then drained by the masked permutation during packet processing.
+ */
+#define ASCON_MASKED_POOL_WORDS 64
+
+/**
+ * \brief State information for the incremental version of masked ASCON-128.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Masked permutation state, with room for the maximum number
+     *  of shares that the library supports */
+    ascon_masked_key_word_t M[5];
+
+    /** Regular permutation state for when the data is not masked */
+    ascon_state_t state_x1;
+
+    /** Preserved randomness between calls to the permutation */
+    uint64_t preserve[3];
+
+    /** Storage for the random number source, which is opaque */
+    uint64_t trng[8];
+
+    /** Pool of prefilled randomness for masking the next packet */
+    uint32_t pool[ASCON_MASKED_POOL_WORDS];
+
+    /** Masked key to use to authenticate the payload during finalization */
+    ascon_masked_key_128_t key;
+
+    /** Non-zero once a partial block has padded the payload */
+    unsigned char padded;
+
+    /** Number of data shares to use for the next packet */
+    unsigned char data_shares;
+
+    /** Number of data shares that are in use for the current packet */
+    unsigned char active_shares;
+
+} ascon128_masked_state_t;
+
+/**
+ * \brief Initializes a state for incremental masked ASCON-128 operations.
+ *
+ * \param state State to initialize.
+ *
+ * The system random number source is initialized once and then reused for
+ * masking every packet that is processed with \a state, rather than
+ * being re-initialized for each packet.
+ * The randomness pool in \a state is also filled so that the first packet
+ * does not need to wait on the random number source.
+ *
+ * The following sequence can be used to encrypt a list of i plaintext
+ * message blocks (m) to produce i ciphertext message blocks (c)
+ * and an authentication tag (t).
+ *
+ * \code
+ * ascon128_masked_state_t state;
+ * ascon128_masked_aead_state_init(&state);
+ * ascon128_masked_aead_start(&state, ad, adlen, npub, k);
+ * ascon128_masked_aead_encrypt_block(&state, m1, c1, m1_len);
+ * ascon128_masked_aead_encrypt_block(&state, m2, c2, m2_len);
+ * ...;
+ * ascon128_masked_aead_encrypt_block(&state, mi, ci, mi_len);
+ * ascon128_masked_aead_encrypt_finalize(&state, t);
+ * ...; // more packets
+ * ascon128_masked_aead_state_free(&state);
+ * \endcode
+ *
+ * Decryption uses a similar sequence:
+ *
+ * \code
+ * ascon128_masked_aead_start(&state, ad, adlen, npub, k);
+ * ascon128_masked_aead_decrypt_block(&state, c1, m1, c1_len);
+ * ascon128_masked_aead_decrypt_block(&state, c2, m2, c2_len);
+ * ...;
+ * ascon128_masked_aead_decrypt_block(&state, ci, mi, ci_len);
+ * if (ascon128_masked_aead_decrypt_finalize(&state, t) < 0)
+ *     ...; // decryption has failed!
+ * \endcode
+ *
+ * Because the payload is masked one rate block at a time, every block
+ * except the last must be a multiple of 8 bytes in length.
+ *
+ * It is very important that the plaintext output from decryption be
+ * discarded if the authentication tag fails to verify.  Applications
+ * should not use any of the data before verifying the tag.
+ *
+ * \sa ascon128_masked_aead_start(), ascon128_masked_aead_state_free()
+ */
+void ascon128_masked_aead_state_init(ascon128_masked_state_t *state);
+
+/**
+ * \brief Frees a state for incremental masked ASCON-128 operations,
+ * including the random number source.
+ *
+ * \param state State to free.
+ *
+ * \sa ascon128_masked_aead_state_init()
+ */
+void ascon128_masked_aead_state_free(ascon128_masked_state_t *state);
+
+/**
+ * \brief Starts encrypting or decrypting a packet with masked ASCON-128
+ * in incremental mode.
+ *
+ * \param state State that was initialized with
+ * ascon128_masked_aead_state_init().
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 128-bit key.
+ *
+ * \sa ascon128_masked_aead_encrypt_block(),
+ * ascon128_masked_aead_decrypt_block()
+ */
+void ascon128_masked_aead_start
+    (ascon128_masked_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const ascon_masked_key_128_t *k);
+
+/**
+ * \brief Aborts the current packet with masked ASCON-128 in
+ * incremental mode.
+ *
+ * \param state State to abort.
+ *
+ * The packet material in \a state is destroyed but the random number
+ * source is retained so that ascon128_masked_aead_start() can be
+ * called again for the next packet.
+ */
+void ascon128_masked_aead_abort(ascon128_masked_state_t *state);
+
+/**
+ * \brief Refills the randomness pool for incremental masked ASCON-128
+ * operations.
+ *
+ * \param state State that was initialized with
+ * ascon128_masked_aead_state_init().
+ *
+ * The pool is full after ascon128_masked_aead_state_init() returns.
+ * Call this function between packets, when the application is not on
+ * a time-critical path, to replace the randomness that was consumed by
+ * the previous packet.  Masking falls back to drawing from the system
+ * random number source directly if the pool runs out mid-packet.
+ *
+ * \sa ascon128_masked_aead_state_init()
+ */
+void ascon128_masked_aead_refill(ascon128_masked_state_t *state);
+
+/**
+ * \brief Selects the number of shares to use to mask the associated data
+ * and payload of packets that are processed with an incremental masked
+ * ASCON-128 state.
+ *
+ * \param state State that was initialized with
+ * ascon128_masked_aead_state_init().
+ * \param shares Number of data shares, between 1 and the number of key
+ * shares that the library was built with.
+ *
+ * \return 0 on success, or -2 if \a shares is out of range.
+ *
+ * The key and the initialization and finalization steps are always masked
+ * with the number of key shares that the library was built with, because
+ * the format of masked keys depends upon it.  Reducing the number of data
+ * shares trades protection of the associated data and payload for higher
+ * throughput; e.g. a channel that carries bulk data can use 2 data shares
+ * while another channel uses 4.  A value of 1 disables masking of the
+ * data entirely.  The default is the number of data shares that the
+ * library was built with.
+ *
+ * The new value takes effect when the next packet is started with
+ * ascon128_masked_aead_start().
+ */
+int ascon128_masked_aead_set_data_shares
+    (ascon128_masked_state_t *state, unsigned shares);
+
+/**
+ * \brief Encrypts a block of data with masked ASCON-128 in incremental mode.
+ *
+ * \param state State to use for masked ASCON-128 encryption operations.
+ * \param in Buffer that contains the plaintext to encrypt.
+ * \param out Buffer to receive the ciphertext output.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the plaintext and ciphertext in bytes.
+ *
+ * \return 0 on success, or -2 if a previous block for this packet was
+ * not a multiple of 8 bytes in length.
+ *
+ * \sa ascon128_masked_aead_start(), ascon128_masked_aead_encrypt_finalize()
+ */
+int ascon128_masked_aead_encrypt_block
+    (ascon128_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finalizes an incremental masked ASCON-128 encryption operation
+ * and generates the authentication tag.
+ *
+ * \param state State to use for masked ASCON-128 encryption operations.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * The packet material in \a state will be destroyed by this function
+ * but the random number source is retained for the next packet.
+ *
+ * \sa ascon128_masked_aead_encrypt_block()
+ */
+void ascon128_masked_aead_encrypt_finalize
+    (ascon128_masked_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Decrypts a block of data with masked ASCON-128 in incremental mode.
+ *
+ * \param state State to use for masked ASCON-128 decryption operations.
+ * \param in Buffer that contains the ciphertext to decrypt.
+ * \param out Buffer to receive the plaintext output.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the plaintext and ciphertext in bytes.
+ *
+ * \return 0 on success, or -2 if a previous block for this packet was
+ * not a multiple of 8 bytes in length.
+ *
+ * \sa ascon128_masked_aead_start(), ascon128_masked_aead_decrypt_finalize()
+ */
+int ascon128_masked_aead_decrypt_block
+    (ascon128_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finalizes an incremental masked ASCON-128 decryption operation
+ * and checks the authentication tag.
+ *
+ * \param state State to use for masked ASCON-128 decryption operations.
+ * \param tag Points to the buffer containing the ciphertext's
+ * authentication tag.  Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The packet material in \a state will be destroyed by this function
+ * but the random number source is retained for the next packet.
+ *
+ * \sa ascon128_masked_aead_decrypt_block()
+ */
+int ascon128_masked_aead_decrypt_finalize
+    (ascon128_masked_state_t *state, const unsigned char *tag);
+
+/**
+ * \brief State information for the incremental version of masked ASCON-128a.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Masked permutation state, with room for the maximum number
+     *  of shares that the library supports */
+    ascon_masked_key_word_t M[5];
+
+    /** Regular permutation state for when the data is not masked */
+    ascon_state_t state_x1;
+
+    /** Preserved randomness between calls to the permutation */
+    uint64_t preserve[3];
+
+    /** Storage for the random number source, which is opaque */
+    uint64_t trng[8];
+
+    /** Pool of prefilled randomness for masking the next packet */
+    uint32_t pool[ASCON_MASKED_POOL_WORDS];
+
+    /** Masked key to use to authenticate the payload during finalization */
+    ascon_masked_key_128_t key;
+
+    /** Non-zero once a partial block has padded the payload */
+    unsigned char padded;
+
+    /** Number of data shares to use for the next packet */
+    unsigned char data_shares;
+
+    /** Number of data shares that are in use for the current packet */
+    unsigned char active_shares;
+
+} ascon128a_masked_state_t;
+
+/**
+ * \brief Initializes a state for incremental masked ASCON-128a operations.
+ *
+ * \param state State to initialize.
+ *
+ * The system random number source is initialized once and then reused for
+ * masking every packet that is processed with \a state, rather than
+ * being re-initialized for each packet.
+ * The randomness pool in \a state is also filled so that the first packet
+ * does not need to wait on the random number source.
+ *
+ * The following sequence can be used to encrypt a list of i plaintext
+ * message blocks (m) to produce i ciphertext message blocks (c)
+ * and an authentication tag (t).
+ *
+ * \code
+ * ascon128a_masked_state_t state;
+ * ascon128a_masked_aead_state_init(&state);
+ * ascon128a_masked_aead_start(&state, ad, adlen, npub, k);
+ * ascon128a_masked_aead_encrypt_block(&state, m1, c1, m1_len);
+ * ascon128a_masked_aead_encrypt_block(&state, m2, c2, m2_len);
+ * ...;
+ * ascon128a_masked_aead_encrypt_block(&state, mi, ci, mi_len);
+ * ascon128a_masked_aead_encrypt_finalize(&state, t);
+ * ...; // more packets
+ * ascon128a_masked_aead_state_free(&state);
+ * \endcode
+ *
+ * Decryption uses a similar sequence:
+ *
+ * \code
+ * ascon128a_masked_aead_start(&state, ad, adlen, npub, k);
+ * ascon128a_masked_aead_decrypt_block(&state, c1, m1, c1_len);
+ * ascon128a_masked_aead_decrypt_block(&state, c2, m2, c2_len);
+ * ...;
+ * ascon128a_masked_aead_decrypt_block(&state, ci, mi, ci_len);
+ * if (ascon128a_masked_aead_decrypt_finalize(&state, t) < 0)
+ *     ...; // decryption has failed!
+ * \endcode
+ *
+ * Because the payload is masked one rate block at a time, every block
+ * except the last must be a multiple of 16 bytes in length.
+ *
+ * It is very important that the plaintext output from decryption be
+ * discarded if the authentication tag fails to verify.  Applications
+ * should not use any of the data before verifying the tag.
+ *
+ * \sa ascon128a_masked_aead_start(), ascon128a_masked_aead_state_free()
+ */
+void ascon128a_masked_aead_state_init(ascon128a_masked_state_t *state);
+
+/**
+ * \brief Frees a state for incremental masked ASCON-128a operations,
+ * including the random number source.
+ *
+ * \param state State to free.
+ *
+ * \sa ascon128a_masked_aead_state_init()
+ */
+void ascon128a_masked_aead_state_free(ascon128a_masked_state_t *state);
+
+/**
+ * \brief Starts encrypting or decrypting a packet with masked ASCON-128a
+ * in incremental mode.
+ *
+ * \param state State that was initialized with
+ * ascon128a_masked_aead_state_init().
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 128-bit key.
+ *
+ * \sa ascon128a_masked_aead_encrypt_block(),
+ * ascon128a_masked_aead_decrypt_block()
+ */
+void ascon128a_masked_aead_start
+    (ascon128a_masked_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const ascon_masked_key_128_t *k);
+
+/**
+ * \brief Aborts the current packet with masked ASCON-128a in
+ * incremental mode.
+ *
+ * \param state State to abort.
+ *
+ * The packet material in \a state is destroyed but the random number
+ * source is retained so that ascon128a_masked_aead_start() can be
+ * called again for the next packet.
+ */
+void ascon128a_masked_aead_abort(ascon128a_masked_state_t *state);
+
+/**
+ * \brief Refills the randomness pool for incremental masked ASCON-128a
+ * operations.
+ *
+ * \param state State that was initialized with
+ * ascon128a_masked_aead_state_init().
+ *
+ * The pool is full after ascon128a_masked_aead_state_init() returns.
+ * Call this function between packets, when the application is not on
+ * a time-critical path, to replace the randomness that was consumed by
+ * the previous packet.  Masking falls back to drawing from the system
+ * random number source directly if the pool runs out mid-packet.
+ *
+ * \sa ascon128a_masked_aead_state_init()
+ */
+void ascon128a_masked_aead_refill(ascon128a_masked_state_t *state);
+
+/**
+ * \brief Selects the number of shares to use to mask the associated data
+ * and payload of packets that are processed with an incremental masked
+ * ASCON-128a state.
+ *
+ * \param state State that was initialized with
+ * ascon128a_masked_aead_state_init().
+ * \param shares Number of data shares, between 1 and the number of key
+ * shares that the library was built with.
+ *
+ * \return 0 on success, or -2 if \a shares is out of range.
+ *
+ * The key and the initialization and finalization steps are always masked
+ * with the number of key shares that the library was built with, because
+ * the format of masked keys depends upon it.  Reducing the number of data
+ * shares trades protection of the associated data and payload for higher
+ * throughput; e.g. a channel that carries bulk data can use 2 data shares
+ * while another channel uses 4.  A value of 1 disables masking of the
+ * data entirely.  The default is the number of data shares that the
+ * library was built with.
+ *
+ * The new value takes effect when the next packet is started with
+ * ascon128a_masked_aead_start().
+ */
+int ascon128a_masked_aead_set_data_shares
+    (ascon128a_masked_state_t *state, unsigned shares);
+
+/**
+ * \brief Encrypts a block of data with masked ASCON-128a in incremental mode.
+ *
+ * \param state State to use for masked ASCON-128a encryption operations.
+ * \param in Buffer that contains the plaintext to encrypt.
+ * \param out Buffer to receive the ciphertext output.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the plaintext and ciphertext in bytes.
+ *
+ * \return 0 on success, or -2 if a previous block for this packet was
+ * not a multiple of 16 bytes in length.
+ *
+ * \sa ascon128a_masked_aead_start(), ascon128a_masked_aead_encrypt_finalize()
+ */
+int ascon128a_masked_aead_encrypt_block
+    (ascon128a_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finalizes an incremental masked ASCON-128a encryption operation
+ * and generates the authentication tag.
+ *
+ * \param state State to use for masked ASCON-128a encryption operations.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * The packet material in \a state will be destroyed by this function
+ * but the random number source is retained for the next packet.
+ *
+ * \sa ascon128a_masked_aead_encrypt_block()
+ */
+void ascon128a_masked_aead_encrypt_finalize
+    (ascon128a_masked_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Decrypts a block of data with masked ASCON-128a in incremental mode.
+ *
+ * \param state State to use for masked ASCON-128a decryption operations.
+ * \param in Buffer that contains the ciphertext to decrypt.
+ * \param out Buffer to receive the plaintext output.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the plaintext and ciphertext in bytes.
+ *
+ * \return 0 on success, or -2 if a previous block for this packet was
+ * not a multiple of 16 bytes in length.
+ *
+ * \sa ascon128a_masked_aead_start(), ascon128a_masked_aead_decrypt_finalize()
+ */
+int ascon128a_masked_aead_decrypt_block
+    (ascon128a_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finalizes an incremental masked ASCON-128a decryption operation
+ * and checks the authentication tag.
+ *
+ * \param state State to use for masked ASCON-128a decryption operations.
+ * \param tag Points to the buffer containing the ciphertext's
+ * authentication tag.  Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The packet material in \a state will be destroyed by this function
+ * but the random number source is retained for the next packet.
+ *
+ * \sa ascon128a_masked_aead_decrypt_block()
+ */
+int ascon128a_masked_aead_decrypt_finalize
+    (ascon128a_masked_state_t *state, const unsigned char *tag);
+
+/**
+ * \brief State information for the incremental version of masked ASCON-80pq.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Masked permutation state, with room for the maximum number
+     *  of shares that the library supports */
+    ascon_masked_key_word_t M[5];
+
+    /** Regular permutation state for when the data is not masked */
+    ascon_state_t state_x1;
+
+    /** Preserved randomness between calls to the permutation */
+    uint64_t preserve[3];
+
+    /** Storage for the random number source, which is opaque */
+    uint64_t trng[8];
+
+    /** Pool of prefilled randomness for masking the next packet */
+    uint32_t pool[ASCON_MASKED_POOL_WORDS];
+
+    /** Masked key to use to authenticate the payload during finalization */
+    ascon_masked_key_160_t key;
+
+    /** Non-zero once a partial block has padded the payload */
+    unsigned char padded;
+
+    /** Number of data shares to use for the next packet */
+    unsigned char data_shares;
+
+    /** Number of data shares that are in use for the current packet */
+    unsigned char active_shares;
+
+} ascon80pq_masked_state_t;
+
+/**
+ * \brief Initializes a state for incremental masked ASCON-80pq operations.
+ *
+ * \param state State to initialize.
+ *
+ * The system random number source is initialized once and then reused for
+ * masking every packet that is processed with \a state, rather than
+ * being re-initialized for each packet.
+ * The randomness pool in \a state is also filled so that the first packet
+ * does not need to wait on the random number source.
+ *
+ * The following sequence can be used to encrypt a list of i plaintext
+ * message blocks (m) to produce i ciphertext message blocks (c)
+ * and an authentication tag (t).
+ *
+ * \code
+ * ascon80pq_masked_state_t state;
+ * ascon80pq_masked_aead_state_init(&state);
+ * ascon80pq_masked_aead_start(&state, ad, adlen, npub, k);
+ * ascon80pq_masked_aead_encrypt_block(&state, m1, c1, m1_len);
+ * ascon80pq_masked_aead_encrypt_block(&state, m2, c2, m2_len);
+ * ...;
+ * ascon80pq_masked_aead_encrypt_block(&state, mi, ci, mi_len);
+ * ascon80pq_masked_aead_encrypt_finalize(&state, t);
+ * ...; // more packets
+ * ascon80pq_masked_aead_state_free(&state);
+ * \endcode
+ *
+ * Decryption uses a similar sequence:
+ *
+ * \code
+ * ascon80pq_masked_aead_start(&state, ad, adlen, npub, k);
+ * ascon80pq_masked_aead_decrypt_block(&state, c1, m1, c1_len);
+ * ascon80pq_masked_aead_decrypt_block(&state, c2, m2, c2_len);
+ * ...;
+ * ascon80pq_masked_aead_decrypt_block(&state, ci, mi, ci_len);
+ * if (ascon80pq_masked_aead_decrypt_finalize(&state, t) < 0)
+ *     ...; // decryption has failed!
+ * \endcode
+ *
+ * Because the payload is masked one rate block at a time, every block
+ * except the last must be a multiple of 8 bytes in length.
+ *
+ * It is very important that the plaintext output from decryption be
+ * discarded if the authentication tag fails to verify.  Applications
+ * should not use any of the data before verifying the tag.
+ *
+ * \sa ascon80pq_masked_aead_start(), ascon80pq_masked_aead_state_free()
+ */
+void ascon80pq_masked_aead_state_init(ascon80pq_masked_state_t *state);
+
+/**
+ * \brief Frees a state for incremental masked ASCON-80pq operations,
+ * including the random number source.
+ *
+ * \param state State to free.
+ *
+ * \sa ascon80pq_masked_aead_state_init()
+ */
+void ascon80pq_masked_aead_state_free(ascon80pq_masked_state_t *state);
+
+/**
+ * \brief Starts encrypting or decrypting a packet with masked ASCON-80pq
+ * in incremental mode.
+ *
+ * \param state State that was initialized with
+ * ascon80pq_masked_aead_state_init().
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the masked 160-bit key.
+ *
+ * \sa ascon80pq_masked_aead_encrypt_block(),
+ * ascon80pq_masked_aead_decrypt_block()
+ */
+void ascon80pq_masked_aead_start
+    (ascon80pq_masked_state_t *state, const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const ascon_masked_key_160_t *k);
+
+/**
+ * \brief Aborts the current packet with masked ASCON-80pq in
+ * incremental mode.
+ *
+ * \param state State to abort.
+ *
+ * The packet material in \a state is destroyed but the random number
+ * source is retained so that ascon80pq_masked_aead_start() can be
+ * called again for the next packet.
+ */
+void ascon80pq_masked_aead_abort(ascon80pq_masked_state_t *state);
+
+/**
+ * \brief Refills the randomness pool for incremental masked ASCON-80pq
+ * operations.
+ *
+ * \param state State that was initialized with
+ * ascon80pq_masked_aead_state_init().
+ *
+ * The pool is full after ascon80pq_masked_aead_state_init() returns.
+ * Call this function between packets, when the application is not on
+ * a time-critical path, to replace the randomness that was consumed by
+ * the previous packet.  Masking falls back to drawing from the system
+ * random number source directly if the pool runs out mid-packet.
+ *
+ * \sa ascon80pq_masked_aead_state_init()
+ */
+void ascon80pq_masked_aead_refill(ascon80pq_masked_state_t *state);
+
+/**
+ * \brief Selects the number of shares to use to mask the associated data
+ * and payload of packets that are processed with an incremental masked
+ * ASCON-80pq state.
+ *
+ * \param state State that was initialized with
+ * ascon80pq_masked_aead_state_init().
+ * \param shares Number of data shares, between 1 and the number of key
+ * shares that the library was built with.
+ *
+ * \return 0 on success, or -2 if \a shares is out of range.
+ *
+ * The key and the initialization and finalization steps are always masked
+ * with the number of key shares that the library was built with, because
+ * the format of masked keys depends upon it.  Reducing the number of data
+ * shares trades protection of the associated data and payload for higher
+ * throughput; e.g. a channel that carries bulk data can use 2 data shares
+ * while another channel uses 4.  A value of 1 disables masking of the
+ * data entirely.  The default is the number of data shares that the
+ * library was built with.
+ *
+ * The new value takes effect when the next packet is started with
+ * ascon80pq_masked_aead_start().
+ */
+int ascon80pq_masked_aead_set_data_shares
+    (ascon80pq_masked_state_t *state, unsigned shares);
+
+/**
+ * \brief Encrypts a block of data with masked ASCON-80pq in incremental mode.
+ *
+ * \param state State to use for masked ASCON-80pq encryption operations.
+ * \param in Buffer that contains the plaintext to encrypt.
+ * \param out Buffer to receive the ciphertext output.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the plaintext and ciphertext in bytes.
+ *
+ * \return 0 on success, or -2 if a previous block for this packet was
+ * not a multiple of 8 bytes in length.
+ *
+ * \sa ascon80pq_masked_aead_start(), ascon80pq_masked_aead_encrypt_finalize()
+ */
+int ascon80pq_masked_aead_encrypt_block
+    (ascon80pq_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finalizes an incremental masked ASCON-80pq encryption operation
+ * and generates the authentication tag.
+ *
+ * \param state State to use for masked ASCON-80pq encryption operations.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON80PQ_TAG_SIZE bytes in length.
+ *
+ * The packet material in \a state will be destroyed by this function
+ * but the random number source is retained for the next packet.
+ *
+ * \sa ascon80pq_masked_aead_encrypt_block()
+ */
+void ascon80pq_masked_aead_encrypt_finalize
+    (ascon80pq_masked_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Decrypts a block of data with masked ASCON-80pq in incremental mode.
+ *
+ * \param state State to use for masked ASCON-80pq decryption operations.
+ * \param in Buffer that contains the ciphertext to decrypt.
+ * \param out Buffer to receive the plaintext output.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the plaintext and ciphertext in bytes.
+ *
+ * \return 0 on success, or -2 if a previous block for this packet was
+ * not a multiple of 8 bytes in length.
+ *
+ * \sa ascon80pq_masked_aead_start(), ascon80pq_masked_aead_decrypt_finalize()
+ */
+int ascon80pq_masked_aead_decrypt_block
+    (ascon80pq_masked_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finalizes an incremental masked ASCON-80pq decryption operation
+ * and checks the authentication tag.
+ *
+ * \param state State to use for masked ASCON-80pq decryption operations.
+ * \param tag Points to the buffer containing the ciphertext's
+ * authentication tag.  Must be at least ASCON80PQ_TAG_SIZE bytes in length.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The packet material in \a state will be destroyed by this function
+ * but the random number source is retained for the next packet.
+ *
+ * \sa ascon80pq_masked_aead_decrypt_block()
+ */
+int ascon80pq_masked_aead_decrypt_finalize
+    (ascon80pq_masked_state_t *state, const unsigned char *tag);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-aead.h"
+
+#if ASCON_ENABLE_AEAD
+
+void ascon_aead_step_init
+    (ascon_aead_step_t *step, const unsigned char *in,
+     unsigned char *out, size_t len)
+{
+    step->in = in;
+    step->out = out;
+    step->remaining = len;
+    step->done = 0;
+}
+
+#define AEAD_ALG_NAME ascon128_aead
+#define AEAD_STATE_TYPE ascon128_state_t
+#define AEAD_RATE ASCON128_RATE
+#include "utility/ascon-aead-step-common.h"
+
+#define AEAD_ALG_NAME ascon128a_aead
+#define AEAD_STATE_TYPE ascon128a_state_t
+#define AEAD_RATE ASCON128A_RATE
+#include "utility/ascon-aead-step-common.h"
+
+#define AEAD_ALG_NAME ascon80pq_aead
+#define AEAD_STATE_TYPE ascon80pq_state_t
+#define AEAD_RATE ASCON80PQ_RATE
+#include "utility/ascon-aead-step-common.h"
+
+#endif /* ASCON_ENABLE_AEAD */
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-aead-stream.h"
+
+#if ASCON_ENABLE_AEAD
+
+#define STREAM_ALG_NAME ascon128
+#define STREAM_STATE_TYPE ascon128_stream_state_t
+#define STREAM_TAG_SIZE ASCON128_TAG_SIZE
+#include "utility/ascon-aead-stream-common.h"
+
+#define STREAM_ALG_NAME ascon128a
+#define STREAM_STATE_TYPE ascon128a_stream_state_t
+#define STREAM_TAG_SIZE ASCON128_TAG_SIZE
+#include "utility/ascon-aead-stream-common.h"
+
+#define STREAM_ALG_NAME ascon80pq
+#define STREAM_STATE_TYPE ascon80pq_stream_state_t
+#define STREAM_TAG_SIZE ASCON80PQ_TAG_SIZE
+#include "utility/ascon-aead-stream-common.h"
+
+#endif /* ASCON_ENABLE_AEAD */
@@ -0,0 +1,560 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_AEAD_STREAM_H
+#define ASCON_AEAD_STREAM_H
+
+/**
+ * \file ascon-aead-stream.h
+ * \brief Segmented streaming encryption with the ASCON AEAD modes.
+ *
+ * Long messages such as log files and firmware images can be split into
+ * segments that are encrypted and authenticated separately using the
+ * STREAM construction of Hoang, Reyhanitabar, Rogaway, and Vizar.
+ * The receiver can verify and release each segment as it arrives with
+ * a constant amount of memory, instead of buffering the entire message
+ * or releasing plaintext before the final tag has been checked.
+ *
+ * The nonce for each segment is formed from an 11-byte nonce prefix
+ * that is unique to the stream, a 32-bit big-endian segment counter,
+ * and a final byte that is 1 for the last segment and 0 otherwise:
+ *
+ * \code
+ * nonce = prefix || counter || last
+ * \endcode
+ *
+ * This prevents segments from being reordered, dropped, or duplicated.
+ * Truncation of the stream is detected because the last segment must
+ * have been processed for the stream to finish successfully.
+ *
+ * All segments except the last must contain exactly the segment size
+ * that was supplied when the stream was initialized.  The last segment
+ * may be shorter, including zero length.  Each encrypted segment is
+ * the same length as its plaintext plus the 16-byte tag.
+ *
+ * \code
+ * ascon128a_stream_state_t state;
+ * ascon128a_stream_init(&state, 4096, prefix, k);
+ * while (more data) {
+ *     read a segment into m, with "last" set for the final one;
+ *     ascon128a_stream_encrypt(&state, c, &clen, m, mlen, 0, 0, last);
+ *     write clen bytes from c;
+ * }
+ * ascon128a_stream_finish(&state);
+ * \endcode
+ *
+ * Because every segment has its own nonce and tag, any segment can be
+ * decrypted and verified on its own given its index, without first
+ * processing the segments before it.  This allows records to be read
+ * out of a large encrypted archive at a cost that depends only on the
+ * segment size.  ASCON_STREAM_SEGMENT_OFFSET() gives the position of
+ * an encrypted segment within the stream.
+ */
+
+#include "ascon-aead.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of the nonce prefix for a segmented stream.
+ */
+#define ASCON_STREAM_PREFIX_SIZE 11
+
+/**
+ * \brief Size of the authentication tag on each segment of a stream.
+ */
+#define ASCON_STREAM_TAG_SIZE 16
+
+/**
+ * \brief Computes the byte offset of an encrypted segment within a stream.
+ *
+ * \param segment_size Size of each plaintext segment except the last.
+ * \param index Index of the segment, starting at zero.
+ *
+ * \return The offset of the segment as a 64-bit value.
+ */
+#define ASCON_STREAM_SEGMENT_OFFSET(segment_size, index) \
+    (((uint64_t)(index)) * ((segment_size) + ASCON_STREAM_TAG_SIZE))
+
+/**
+ * \brief State information for segmented streaming with ASCON-128.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Key for encrypting or decrypting the segments */
+    unsigned char key[ASCON128_KEY_SIZE];
+
+    /** Nonce for the next segment, including the counter */
+    unsigned char nonce[ASCON128_NONCE_SIZE];
+
+    /** Size of each segment except the last, in bytes */
+    size_t segment_size;
+
+    /** Number of segments that have been processed so far */
+    uint32_t counter;
+
+    /** Non-zero once the last segment has been processed */
+    unsigned char finished;
+
+} ascon128_stream_state_t;
+
+/**
+ * \brief State information for segmented streaming with ASCON-128a.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Key for encrypting or decrypting the segments */
+    unsigned char key[ASCON128_KEY_SIZE];
+
+    /** Nonce for the next segment, including the counter */
+    unsigned char nonce[ASCON128_NONCE_SIZE];
+
+    /** Size of each segment except the last, in bytes */
+    size_t segment_size;
+
+    /** Number of segments that have been processed so far */
+    uint32_t counter;
+
+    /** Non-zero once the last segment has been processed */
+    unsigned char finished;
+
+} ascon128a_stream_state_t;
+
+/**
+ * \brief State information for segmented streaming with ASCON-80pq.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Key for encrypting or decrypting the segments */
+    unsigned char key[ASCON80PQ_KEY_SIZE];
+
+    /** Nonce for the next segment, including the counter */
+    unsigned char nonce[ASCON80PQ_NONCE_SIZE];
+
+    /** Size of each segment except the last, in bytes */
+    size_t segment_size;
+
+    /** Number of segments that have been processed so far */
+    uint32_t counter;
+
+    /** Non-zero once the last segment has been processed */
+    unsigned char finished;
+
+} ascon80pq_stream_state_t;
+
+/**
+ * \brief Initializes a segmented stream for ASCON-128.
+ *
+ * \param state The stream state to initialize.
+ * \param segment_size Size of each segment except the last, in bytes.
+ * \param prefix Points to the ASCON_STREAM_PREFIX_SIZE bytes of the
+ * nonce prefix, which must be unique for each stream under \a k.
+ * \param k Points to the 16 bytes of the key.
+ *
+ * \return 0 on success, or -2 if \a segment_size is zero.
+ *
+ * The same state type is used for both encryption and decryption,
+ * but a single state must not be used for both.
+ *
+ * \sa ascon128_stream_encrypt(), ascon128_stream_decrypt(),
+ * ascon128_stream_finish()
+ */
+int ascon128_stream_init
+    (ascon128_stream_state_t *state, size_t segment_size,
+     const unsigned char *prefix, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates the next segment of a stream
+ * with ASCON-128.
+ *
+ * \param state The stream state.
+ * \param c Buffer to receive the encrypted segment, which must have room
+ * for \a mlen plus the 16 byte authentication tag.
+ * \param clen On exit, set to the length of the encrypted segment.
+ * \param m Buffer that contains the plaintext for the segment.
+ * \param mlen Length of the plaintext for the segment in bytes.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, or -2 if the last segment has already been
+ * encrypted, the segment counter has been exhausted, or \a mlen is not
+ * valid for the segment size.
+ *
+ * \sa ascon128_stream_decrypt()
+ */
+int ascon128_stream_encrypt
+    (ascon128_stream_state_t *state, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Decrypts and verifies the next segment of a stream
+ * with ASCON-128.
+ *
+ * \param state The stream state.
+ * \param m Buffer to receive the plaintext for the segment.
+ * \param mlen On exit, set to the length of the plaintext.
+ * \param c Buffer that contains the encrypted segment.
+ * \param clen Length of the encrypted segment in bytes, including the tag.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the last segment has already been decrypted, the segment
+ * counter has been exhausted, or \a clen is not valid for the segment
+ * size.
+ *
+ * The plaintext for the segment can be released to the application
+ * as soon as this function returns 0.  If the tag is incorrect, then
+ * the plaintext is zeroed and the stream does not advance.
+ *
+ * \sa ascon128_stream_encrypt()
+ */
+int ascon128_stream_decrypt
+    (ascon128_stream_state_t *state, unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Decrypts and verifies an arbitrary segment of a stream
+ * with ASCON-128.
+ *
+ * \param state The stream state.
+ * \param index Index of the segment to decrypt, starting at zero.
+ * \param m Buffer to receive the plaintext for the segment.
+ * \param mlen On exit, set to the length of the plaintext.
+ * \param c Buffer that contains the encrypted segment.
+ * \param clen Length of the encrypted segment in bytes, including the tag.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if \a clen is not valid for the segment size.
+ *
+ * This function does not change the position of the stream, so it can
+ * be used for random access to the segments of an encrypted archive.
+ * The caller must know whether the segment is the last one, usually
+ * from the total length of the stream.
+ *
+ * \sa ascon128_stream_decrypt(), ascon128_stream_seek()
+ */
+int ascon128_stream_decrypt_at
+    (ascon128_stream_state_t *state, uint32_t index,
+     unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Moves the position of a ASCON-128 stream to a specific segment.
+ *
+ * \param state The stream state.
+ * \param index Index of the next segment to encrypt or decrypt,
+ * starting at zero.
+ *
+ * This can be used to resume sequential decryption part-way through
+ * a stream.  Encryption should not be resumed at a segment that has
+ * already been encrypted with different contents.
+ */
+void ascon128_stream_seek(ascon128_stream_state_t *state, uint32_t index);
+
+/**
+ * \brief Finishes a segmented stream for ASCON-128.
+ *
+ * \param state The stream state, which will be freed.
+ *
+ * \return 0 if the last segment of the stream was processed, or -1 if
+ * the stream ended early, which may indicate that it was truncated.
+ */
+int ascon128_stream_finish(ascon128_stream_state_t *state);
+
+/**
+ * \brief Initializes a segmented stream for ASCON-128a.
+ *
+ * \param state The stream state to initialize.
+ * \param segment_size Size of each segment except the last, in bytes.
+ * \param prefix Points to the ASCON_STREAM_PREFIX_SIZE bytes of the
+ * nonce prefix, which must be unique for each stream under \a k.
+ * \param k Points to the 16 bytes of the key.
+ *
+ * \return 0 on success, or -2 if \a segment_size is zero.
+ *
+ * The same state type is used for both encryption and decryption,
+ * but a single state must not be used for both.
+ *
+ * \sa ascon128a_stream_encrypt(), ascon128a_stream_decrypt(),
+ * ascon128a_stream_finish()
+ */
+int ascon128a_stream_init
+    (ascon128a_stream_state_t *state, size_t segment_size,
+     const unsigned char *prefix, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates the next segment of a stream
+ * with ASCON-128a.
+ *
+ * \param state The stream state.
+ * \param c Buffer to receive the encrypted segment, which must have room
+ * for \a mlen plus the 16 byte authentication tag.
+ * \param clen On exit, set to the length of the encrypted segment.
+ * \param m Buffer that contains the plaintext for the segment.
+ * \param mlen Length of the plaintext for the segment in bytes.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, or -2 if the last segment has already been
+ * encrypted, the segment counter has been exhausted, or \a mlen is not
+ * valid for the segment size.
+ *
+ * \sa ascon128a_stream_decrypt()
+ */
+int ascon128a_stream_encrypt
+    (ascon128a_stream_state_t *state, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Decrypts and verifies the next segment of a stream
+ * with ASCON-128a.
+ *
+ * \param state The stream state.
+ * \param m Buffer to receive the plaintext for the segment.
+ * \param mlen On exit, set to the length of the plaintext.
+ * \param c Buffer that contains the encrypted segment.
+ * \param clen Length of the encrypted segment in bytes, including the tag.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the last segment has already been decrypted, the segment
+ * counter has been exhausted, or \a clen is not valid for the segment
+ * size.
+ *
+ * The plaintext for the segment can be released to the application
+ * as soon as this function returns 0.  If the tag is incorrect, then
+ * the plaintext is zeroed and the stream does not advance.
+ *
+ * \sa ascon128a_stream_encrypt()
+ */
+int ascon128a_stream_decrypt
+    (ascon128a_stream_state_t *state, unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Decrypts and verifies an arbitrary segment of a stream
+ * with ASCON-128a.
+ *
+ * \param state The stream state.
+ * \param index Index of the segment to decrypt, starting at zero.
+ * \param m Buffer to receive the plaintext for the segment.
+ * \param mlen On exit, set to the length of the plaintext.
+ * \param c Buffer that contains the encrypted segment.
+ * \param clen Length of the encrypted segment in bytes, including the tag.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if \a clen is not valid for the segment size.
+ *
+ * This function does not change the position of the stream, so it can
+ * be used for random access to the segments of an encrypted archive.
+ * The caller must know whether the segment is the last one, usually
+ * from the total length of the stream.
+ *
+ * \sa ascon128a_stream_decrypt(), ascon128a_stream_seek()
+ */
+int ascon128a_stream_decrypt_at
+    (ascon128a_stream_state_t *state, uint32_t index,
+     unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Moves the position of a ASCON-128a stream to a specific segment.
+ *
+ * \param state The stream state.
+ * \param index Index of the next segment to encrypt or decrypt,
+ * starting at zero.
+ *
+ * This can be used to resume sequential decryption part-way through
+ * a stream.  Encryption should not be resumed at a segment that has
+ * already been encrypted with different contents.
+ */
+void ascon128a_stream_seek(ascon128a_stream_state_t *state, uint32_t index);
+
+/**
+ * \brief Finishes a segmented stream for ASCON-128a.
+ *
+ * \param state The stream state, which will be freed.
+ *
+ * \return 0 if the last segment of the stream was processed, or -1 if
+ * the stream ended early, which may indicate that it was truncated.
+ */
+int ascon128a_stream_finish(ascon128a_stream_state_t *state);
+
+/**
+ * \brief Initializes a segmented stream for ASCON-80pq.
+ *
+ * \param state The stream state to initialize.
+ * \param segment_size Size of each segment except the last, in bytes.
+ * \param prefix Points to the ASCON_STREAM_PREFIX_SIZE bytes of the
+ * nonce prefix, which must be unique for each stream under \a k.
+ * \param k Points to the 20 bytes of the key.
+ *
+ * \return 0 on success, or -2 if \a segment_size is zero.
+ *
+ * The same state type is used for both encryption and decryption,
+ * but a single state must not be used for both.
+ *
+ * \sa ascon80pq_stream_encrypt(), ascon80pq_stream_decrypt(),
+ * ascon80pq_stream_finish()
+ */
+int ascon80pq_stream_init
+    (ascon80pq_stream_state_t *state, size_t segment_size,
+     const unsigned char *prefix, const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates the next segment of a stream
+ * with ASCON-80pq.
+ *
+ * \param state The stream state.
+ * \param c Buffer to receive the encrypted segment, which must have room
+ * for \a mlen plus the 16 byte authentication tag.
+ * \param clen On exit, set to the length of the encrypted segment.
+ * \param m Buffer that contains the plaintext for the segment.
+ * \param mlen Length of the plaintext for the segment in bytes.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, or -2 if the last segment has already been
+ * encrypted, the segment counter has been exhausted, or \a mlen is not
+ * valid for the segment size.
+ *
+ * \sa ascon80pq_stream_decrypt()
+ */
+int ascon80pq_stream_encrypt
+    (ascon80pq_stream_state_t *state, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Decrypts and verifies the next segment of a stream
+ * with ASCON-80pq.
+ *
+ * \param state The stream state.
+ * \param m Buffer to receive the plaintext for the segment.
+ * \param mlen On exit, set to the length of the plaintext.
+ * \param c Buffer that contains the encrypted segment.
+ * \param clen Length of the encrypted segment in bytes, including the tag.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the last segment has already been decrypted, the segment
+ * counter has been exhausted, or \a clen is not valid for the segment
+ * size.
+ *
+ * The plaintext for the segment can be released to the application
+ * as soon as this function returns 0.  If the tag is incorrect, then
+ * the plaintext is zeroed and the stream does not advance.
+ *
+ * \sa ascon80pq_stream_encrypt()
+ */
+int ascon80pq_stream_decrypt
+    (ascon80pq_stream_state_t *state, unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Decrypts and verifies an arbitrary segment of a stream
+ * with ASCON-80pq.
+ *
+ * \param state The stream state.
+ * \param index Index of the segment to decrypt, starting at zero.
+ * \param m Buffer to receive the plaintext for the segment.
+ * \param mlen On exit, set to the length of the plaintext.
+ * \param c Buffer that contains the encrypted segment.
+ * \param clen Length of the encrypted segment in bytes, including the tag.
+ * \param ad Buffer that contains associated data for the segment.
+ * \param adlen Length of the associated data for the segment in bytes.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if \a clen is not valid for the segment size.
+ *
+ * This function does not change the position of the stream, so it can
+ * be used for random access to the segments of an encrypted archive.
+ * The caller must know whether the segment is the last one, usually
+ * from the total length of the stream.
+ *
+ * \sa ascon80pq_stream_decrypt(), ascon80pq_stream_seek()
+ */
+int ascon80pq_stream_decrypt_at
+    (ascon80pq_stream_state_t *state, uint32_t index,
+     unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last);
+
+/**
+ * \brief Moves the position of a ASCON-80pq stream to a specific segment.
+ *
+ * \param state The stream state.
+ * \param index Index of the next segment to encrypt or decrypt,
+ * starting at zero.
+ *
+ * This can be used to resume sequential decryption part-way through
+ * a stream.  Encryption should not be resumed at a segment that has
+ * already been encrypted with different contents.
+ */
+void ascon80pq_stream_seek(ascon80pq_stream_state_t *state, uint32_t index);
+
+/**
+ * \brief Finishes a segmented stream for ASCON-80pq.
+ *
+ * \param state The stream state, which will be freed.
+ *
+ * \return 0 if the last segment of the stream was processed, or -1 if
+ * the stream ended early, which may indicate that it was truncated.
+ */
+int ascon80pq_stream_finish(ascon80pq_stream_state_t *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
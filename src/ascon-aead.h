@@ -94,6 +94,12 @@ extern "C" {
  */
 #define ASCON80PQ_RATE 8
 
+/**
+ * \brief Maximum length of the payload and associated data for the
+ * short-message AEAD functions such as ascon128_aead_encrypt_short().
+ */
+#define ASCON_AEAD_SHORT_MAX 16
+
 /**
  * \brief Encrypts and authenticates a packet with ASCON-128.
  *
@@ -250,6 +256,979 @@ int ascon80pq_aead_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/**
+ * \brief Verifies the authentication tag on a packet with ASCON-80pq
+ * without decrypting it.
+ *
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to verify.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to verify the packet.
+ *
+ * \return 0 if the authentication tag is correct, -1 if the
+ * authentication tag was incorrect, or some other negative number
+ * if there was an error in the parameters.
+ *
+ * The ciphertext is absorbed directly into the state, so this is
+ * cheaper than ascon80pq_aead_decrypt() and needs no output buffer.
+ *
+ * \sa ascon80pq_aead_decrypt_two_pass()
+ */
+int ascon80pq_aead_verify
+    (const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-80pq, checking
+ * the authentication tag before any plaintext is written.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The first pass computes the tag from the ciphertext and the second
+ * pass decrypts the ciphertext into \a m only if the tag is correct.
+ * Forged packets are rejected without touching \a m, at the cost
+ * of processing the ciphertext twice for genuine packets.  The state
+ * after the associated data is saved, so the initialization and the
+ * associated data are only processed once.
+ *
+ * \sa ascon80pq_aead_decrypt(), ascon80pq_aead_verify()
+ */
+int ascon80pq_aead_decrypt_two_pass
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/* ---------------------------------------------------------------- */
+/*              Caller-provided workspace API's for AEAD            */
+/* ---------------------------------------------------------------- */
+
+/*
+ * The one-shot AEAD functions above keep an ascon_state_t on the stack,
+ * and the decryption functions also keep a 16 byte tag buffer there.
+ * The "_ex" variants below take the ascon_state_t from the caller
+ * instead so that the largest object can be placed in static memory or
+ * a pre-allocated buffer and the RAM usage can be budgeted in advance.
+ * The workspace is cleared before the functions return and can be
+ * reused for the next call.
+ */
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-128 using a
+ * caller-provided workspace.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ * \param workspace Points to the permutation state to use while
+ * encrypting the packet.
+ *
+ * \sa ascon128_aead_encrypt(), ascon128_aead_decrypt_ex()
+ */
+void ascon128_aead_encrypt_ex
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-128 using a
+ * caller-provided workspace.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ * \param workspace Points to the permutation state to use while
+ * decrypting the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128_aead_decrypt(), ascon128_aead_encrypt_ex()
+ */
+int ascon128_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace);
+
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-128a using a
+ * caller-provided workspace.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ * \param workspace Points to the permutation state to use while
+ * encrypting the packet.
+ *
+ * \sa ascon128a_aead_encrypt(), ascon128a_aead_decrypt_ex()
+ */
+void ascon128a_aead_encrypt_ex
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-128a using a
+ * caller-provided workspace.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ * \param workspace Points to the permutation state to use while
+ * decrypting the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128a_aead_decrypt(), ascon128a_aead_encrypt_ex()
+ */
+int ascon128a_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace);
+
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-80pq using a
+ * caller-provided workspace.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to encrypt the packet.
+ * \param workspace Points to the permutation state to use while
+ * encrypting the packet.
+ *
+ * \sa ascon80pq_aead_encrypt(), ascon80pq_aead_decrypt_ex()
+ */
+void ascon80pq_aead_encrypt_ex
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-80pq using a
+ * caller-provided workspace.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to decrypt the packet.
+ * \param workspace Points to the permutation state to use while
+ * decrypting the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon80pq_aead_decrypt(), ascon80pq_aead_encrypt_ex()
+ */
+int ascon80pq_aead_decrypt_ex
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, ascon_state_t *workspace);
+
+/**
+ * \brief Encrypts and authenticates a short packet with ASCON-128.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ *
+ * \return 0 on success or -2 if \a mlen or \a adlen is too long.
+ *
+ * The output is identical to ascon128_aead_encrypt().  The block loops
+ * are unrolled for messages of this size, which reduces the per-packet
+ * latency on small 8-bit and 32-bit microcontrollers.
+ *
+ * \sa ascon128_aead_decrypt_short(), ascon128_aead_encrypt()
+ */
+int ascon128_aead_encrypt_short
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a short packet with ASCON-128.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.  The ciphertext must
+ * be at most ASCON_AEAD_SHORT_MAX bytes in length.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the ciphertext or associated data is too long.
+ *
+ * \sa ascon128_aead_encrypt_short(), ascon128_aead_decrypt()
+ */
+int ascon128_aead_decrypt_short
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a short packet with ASCON-128a.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ *
+ * \return 0 on success or -2 if \a mlen or \a adlen is too long.
+ *
+ * The output is identical to ascon128a_aead_encrypt().  The block loops
+ * are unrolled for messages of this size, which reduces the per-packet
+ * latency on small 8-bit and 32-bit microcontrollers.
+ *
+ * \sa ascon128a_aead_decrypt_short(), ascon128a_aead_encrypt()
+ */
+int ascon128a_aead_encrypt_short
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a short packet with ASCON-128a.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.  The ciphertext must
+ * be at most ASCON_AEAD_SHORT_MAX bytes in length.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the ciphertext or associated data is too long.
+ *
+ * \sa ascon128a_aead_encrypt_short(), ascon128a_aead_decrypt()
+ */
+int ascon128a_aead_decrypt_short
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a short packet with ASCON-80pq.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to encrypt the packet.
+ *
+ * \return 0 on success or -2 if \a mlen or \a adlen is too long.
+ *
+ * The output is identical to ascon80pq_aead_encrypt().  The block loops
+ * are unrolled for messages of this size, which reduces the per-packet
+ * latency on small 8-bit and 32-bit microcontrollers.
+ *
+ * \sa ascon80pq_aead_decrypt_short(), ascon80pq_aead_encrypt()
+ */
+int ascon80pq_aead_encrypt_short
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a short packet with ASCON-80pq.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.  The ciphertext must
+ * be at most ASCON_AEAD_SHORT_MAX bytes in length.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes, which must be
+ * at most ASCON_AEAD_SHORT_MAX.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the ciphertext or associated data is too long.
+ *
+ * \sa ascon80pq_aead_encrypt_short(), ascon80pq_aead_decrypt()
+ */
+int ascon80pq_aead_decrypt_short
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-128a and
+ * hashes the plaintext with ASCON-HASH in a single pass.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ * \param hash Buffer to receive the 32 bytes of the ASCON-HASH output
+ * for the plaintext.
+ *
+ * The output is the same as ascon128a_aead_encrypt() followed by
+ * ascon_hash(), but the plaintext is only read once with each block
+ * being encrypted and hashed while it is in the cache.
+ *
+ * \sa ascon128a_aead_decrypt_and_hash()
+ */
+void ascon128a_aead_encrypt_and_hash
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned char *hash);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-128a and
+ * hashes the plaintext with ASCON-HASH in a single pass.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ * \param hash Buffer to receive the 32 bytes of the ASCON-HASH output
+ * for the plaintext.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ * The plaintext and \a hash are zeroed if the tag was incorrect.
+ *
+ * \sa ascon128a_aead_encrypt_and_hash()
+ */
+int ascon128a_aead_decrypt_and_hash
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned char *hash);
+
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-128a and
+ * hashes the plaintext with ASCON-HASHA in a single pass.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ * \param hash Buffer to receive the 32 bytes of the ASCON-HASHA output
+ * for the plaintext.
+ *
+ * The output is the same as ascon128a_aead_encrypt() followed by
+ * ascon_hasha(), but the plaintext is only read once with each block
+ * being encrypted and hashed while it is in the cache.  ASCON-HASHA
+ * and ASCON-128a use the same number of rounds, so both states are
+ * permuted together with ascon_permute_x2().
+ *
+ * \sa ascon128a_aead_decrypt_and_hasha()
+ */
+void ascon128a_aead_encrypt_and_hasha
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned char *hash);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-128a and
+ * hashes the plaintext with ASCON-HASHA in a single pass.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ * \param hash Buffer to receive the 32 bytes of the ASCON-HASHA output
+ * for the plaintext.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ * The plaintext and \a hash are zeroed if the tag was incorrect.
+ *
+ * \sa ascon128a_aead_encrypt_and_hasha()
+ */
+int ascon128a_aead_decrypt_and_hasha
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned char *hash);
+
+/* ---------------------------------------------------------------- */
+/*           Pre-computed key API's for the AEAD modes below        */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Pre-computed key information for ASCON-128.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** ASCON permutation state with the IV and key pre-loaded */
+    ascon_state_t state;
+
+} ascon128_aead_key_t;
+
+/**
+ * \brief Pre-computed key information for ASCON-128a.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** ASCON permutation state with the IV and key pre-loaded */
+    ascon_state_t state;
+
+} ascon128a_aead_key_t;
+
+/**
+ * \brief Pre-computed key information for ASCON-80pq.
+ *
+ * The 160-bit key straddles the 64-bit words of the state at every point
+ * where it is used, so it is stored pre-split at each of those offsets.
+ * The key can then be added to the state with aligned word XOR's.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** ASCON permutation state with the IV and key pre-loaded */
+    ascon_state_t state;
+
+    /** Key at byte offset 8 in the state, for finalization */
+    ascon_state_t key8;
+
+    /** Key at byte offset 20 in the state, for the end of initialization
+     *  and the authentication tag */
+    ascon_state_t key20;
+
+} ascon80pq_aead_key_t;
+
+/**
+ * \brief Initializes a pre-computed key for ASCON-128.
+ *
+ * \param pk Points to the object to receive the pre-computed key value.
+ * \param k Points to the 16 bytes of the key.
+ *
+ * The key is converted into the operational form of the permutation
+ * back end once, which reduces the cost of setting up the state for
+ * each packet when the same key is used for many packets.
+ *
+ * \sa ascon128_aead_free_key(), ascon128_aead_encrypt_pk(),
+ * ascon128_aead_decrypt_pk()
+ */
+void ascon128_aead_init_key
+    (ascon128_aead_key_t *pk, const unsigned char *k);
+
+/**
+ * \brief Frees a pre-computed key for ASCON-128 and destroys any
+ * sensitive material.
+ *
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon128_aead_init_key()
+ */
+void ascon128_aead_free_key(ascon128_aead_key_t *pk);
+
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-128 and a
+ * pre-computed key.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon128_aead_decrypt_pk(), ascon128_aead_init_key()
+ */
+void ascon128_aead_encrypt_pk
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128_aead_key_t *pk);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-128 and a
+ * pre-computed key.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128_aead_encrypt_pk(), ascon128_aead_init_key()
+ */
+int ascon128_aead_decrypt_pk
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128_aead_key_t *pk);
+
+/**
+ * \brief Initializes a pre-computed key for ASCON-128a.
+ *
+ * \param pk Points to the object to receive the pre-computed key value.
+ * \param k Points to the 16 bytes of the key.
+ *
+ * The key is converted into the operational form of the permutation
+ * back end once, which reduces the cost of setting up the state for
+ * each packet when the same key is used for many packets.
+ *
+ * \sa ascon128a_aead_free_key(), ascon128a_aead_encrypt_pk(),
+ * ascon128a_aead_decrypt_pk()
+ */
+void ascon128a_aead_init_key
+    (ascon128a_aead_key_t *pk, const unsigned char *k);
+
+/**
+ * \brief Frees a pre-computed key for ASCON-128a and destroys any
+ * sensitive material.
+ *
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon128a_aead_init_key()
+ */
+void ascon128a_aead_free_key(ascon128a_aead_key_t *pk);
+
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-128a and a
+ * pre-computed key.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon128a_aead_decrypt_pk(), ascon128a_aead_init_key()
+ */
+void ascon128a_aead_encrypt_pk
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128a_aead_key_t *pk);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-128a and a
+ * pre-computed key.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128a_aead_encrypt_pk(), ascon128a_aead_init_key()
+ */
+int ascon128a_aead_decrypt_pk
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128a_aead_key_t *pk);
+
+/**
+ * \brief Initializes a pre-computed key for ASCON-80pq.
+ *
+ * \param pk Points to the object to receive the pre-computed key value.
+ * \param k Points to the 20 bytes of the key.
+ *
+ * The key is converted into the operational form of the permutation
+ * back end once, at each of the offsets where it is used, which reduces
+ * the cost of setting up and finalizing the state for each packet when
+ * the same key is used for many packets.
+ *
+ * \sa ascon80pq_aead_free_key(), ascon80pq_aead_encrypt_pk(),
+ * ascon80pq_aead_decrypt_pk()
+ */
+void ascon80pq_aead_init_key
+    (ascon80pq_aead_key_t *pk, const unsigned char *k);
+
+/**
+ * \brief Frees a pre-computed key for ASCON-80pq and destroys any
+ * sensitive material.
+ *
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon80pq_aead_init_key()
+ */
+void ascon80pq_aead_free_key(ascon80pq_aead_key_t *pk);
+
+/**
+ * \brief Encrypts and authenticates a packet with ASCON-80pq and a
+ * pre-computed key.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon80pq_aead_decrypt_pk(), ascon80pq_aead_init_key()
+ */
+void ascon80pq_aead_encrypt_pk
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon80pq_aead_key_t *pk);
+
+/**
+ * \brief Decrypts and authenticates a packet with ASCON-80pq and a
+ * pre-computed key.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon80pq_aead_encrypt_pk(), ascon80pq_aead_init_key()
+ */
+int ascon80pq_aead_decrypt_pk
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon80pq_aead_key_t *pk);
+
+/* ---------------------------------------------------------------- */
+/*               Batch API's for the AEAD modes below               */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Description of a single message in a batch AEAD operation.
+ *
+ * For encryption, \a in and \a inlen describe the plaintext and
+ * \a out must have room for \a inlen plus the tag size.  For decryption,
+ * \a in and \a inlen describe the ciphertext including the tag and
+ * \a out must have room for \a inlen minus the tag size.
+ *
+ * \sa ascon128_aead_encrypt_batch(), ascon128_aead_decrypt_batch()
+ */
+typedef struct
+{
+    /** Buffer to receive the output */
+    unsigned char *out;
+
+    /** Set on exit to the number of bytes that were written to \a out */
+    size_t outlen;
+
+    /** Buffer that contains the input to encrypt or decrypt */
+    const unsigned char *in;
+
+    /** Length of the input in bytes */
+    size_t inlen;
+
+    /** Buffer that contains the associated data */
+    const unsigned char *ad;
+
+    /** Length of the associated data in bytes */
+    size_t adlen;
+
+    /** Points to the 16 bytes of the nonce for the message */
+    const unsigned char *npub;
+
+    /** Points to the 16 bytes of the key for the message */
+    const unsigned char *k;
+
+    /** Set on exit to 0 on success, or -1 if the authentication tag
+     *  for the message was incorrect */
+    int result;
+
+} ascon_aead_batch_t;
+
+/**
+ * \brief Encrypts and authenticates a batch of independent messages
+ * with ASCON-128.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * The output for each message is the same as if ascon128_aead_encrypt()
+ * had been called on the message separately.  The messages may have
+ * different lengths, keys, and nonces.  On back ends that can permute
+ * several states at once, the messages are processed side by side.
+ *
+ * \sa ascon128_aead_decrypt_batch(), ascon128_aead_encrypt()
+ */
+void ascon128_aead_encrypt_batch(ascon_aead_batch_t *msgs, size_t count);
+
+/**
+ * \brief Decrypts and authenticates a batch of independent messages
+ * with ASCON-128.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * \return 0 if all messages were decrypted successfully, or -1 if the
+ * authentication tag was incorrect for at least one message.
+ *
+ * The \a result field of each message is set to the result that
+ * ascon128_aead_decrypt() would have returned for that message.
+ * The plaintext for messages that fail to authenticate is zeroed.
+ *
+ * \sa ascon128_aead_encrypt_batch(), ascon128_aead_decrypt()
+ */
+int ascon128_aead_decrypt_batch(ascon_aead_batch_t *msgs, size_t count);
+
+/**
+ * \brief Encrypts and authenticates a batch of independent messages
+ * with ASCON-128a.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * The output for each message is the same as if ascon128a_aead_encrypt()
+ * had been called on the message separately.  The messages may have
+ * different lengths, keys, and nonces.  On back ends that can permute
+ * several states at once, the messages are processed side by side.
+ *
+ * \sa ascon128a_aead_decrypt_batch(), ascon128a_aead_encrypt()
+ */
+void ascon128a_aead_encrypt_batch(ascon_aead_batch_t *msgs, size_t count);
+
+/**
+ * \brief Decrypts and authenticates a batch of independent messages
+ * with ASCON-128a.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * \return 0 if all messages were decrypted successfully, or -1 if the
+ * authentication tag was incorrect for at least one message.
+ *
+ * The \a result field of each message is set to the result that
+ * ascon128a_aead_decrypt() would have returned for that message.
+ * The plaintext for messages that fail to authenticate is zeroed.
+ *
+ * \sa ascon128a_aead_encrypt_batch(), ascon128a_aead_decrypt()
+ */
+int ascon128a_aead_decrypt_batch(ascon_aead_batch_t *msgs, size_t count);
+
 /* ---------------------------------------------------------------- */
 /*            Incremental API's for the AEAD modes below            */
 /* ---------------------------------------------------------------- */
@@ -270,6 +1249,9 @@ typedef struct
     /** Position within the current block for partial blocks */
     unsigned char posn;
 
+    /** Non-zero if associated data has been absorbed incrementally */
+    unsigned char has_ad;
+
 } ascon128_state_t;
 
 /**
@@ -288,6 +1270,9 @@ typedef struct
     /** Position within the current block for partial blocks */
     unsigned char posn;
 
+    /** Non-zero if associated data has been absorbed incrementally */
+    unsigned char has_ad;
+
 } ascon128a_state_t;
 
 /**
@@ -306,6 +1291,9 @@ typedef struct
     /** Position within the current block for partial blocks */
     unsigned char posn;
 
+    /** Non-zero if associated data has been absorbed incrementally */
+    unsigned char has_ad;
+
 } ascon80pq_state_t;
 
 /**
@@ -358,6 +1346,67 @@ void ascon128_aead_start
     (ascon128_state_t *state, const unsigned char *ad, size_t adlen,
      const unsigned char *npub, const unsigned char *k);
 
+/**
+ * \brief Starts encrypting or decrypting a packet with ASCON-128 in
+ * incremental mode, with the associated data to be supplied incrementally.
+ *
+ * \param state State to initialize for ASCON-128 operations.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ *
+ * This function should be followed by zero or more calls to
+ * ascon128_aead_ad_update() and then a call to ascon128_aead_ad_finish().
+ * After that, the payload can be processed with the block functions
+ * in the same way as after ascon128_aead_start().
+ *
+ * \code
+ * ascon128_state_t state;
+ * ascon128_aead_start_ad(&state, npub, k);
+ * ascon128_aead_ad_update(&state, ad1, ad1_len);
+ * ascon128_aead_ad_update(&state, ad2, ad2_len);
+ * ...;
+ * ascon128_aead_ad_finish(&state);
+ * ascon128_aead_encrypt_block(&state, m1, c1, m1_len);
+ * ...;
+ * ascon128_aead_encrypt_finalize(&state, t);
+ * \endcode
+ *
+ * \sa ascon128_aead_ad_update(), ascon128_aead_ad_finish(),
+ * ascon128_aead_start()
+ */
+void ascon128_aead_start_ad
+    (ascon128_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental ASCON-128 state.
+ *
+ * \param state State to use for ASCON-128 operations.
+ * \param ad Buffer that contains the next chunk of associated data.
+ * \param adlen Length of the associated data chunk in bytes.
+ *
+ * The chunks can be of any length.  The result is the same as if all of
+ * the chunks had been concatenated and passed to ascon128_aead_start().
+ *
+ * \sa ascon128_aead_start_ad(), ascon128_aead_ad_finish()
+ */
+void ascon128_aead_ad_update
+    (ascon128_state_t *state, const unsigned char *ad, size_t adlen);
+
+/**
+ * \brief Finishes absorbing the associated data into an incremental
+ * ASCON-128 state.
+ *
+ * \param state State to use for ASCON-128 operations.
+ *
+ * After this function returns, the state is ready to encrypt or
+ * decrypt the payload.
+ *
+ * \sa ascon128_aead_start_ad(), ascon128_aead_ad_update()
+ */
+void ascon128_aead_ad_finish(ascon128_state_t *state);
+
 /**
  * \brief Aborts use of ASCON-128 in incremental mode.
  *
@@ -486,6 +1535,67 @@ void ascon128a_aead_start
     (ascon128a_state_t *state, const unsigned char *ad, size_t adlen,
      const unsigned char *npub, const unsigned char *k);
 
+/**
+ * \brief Starts encrypting or decrypting a packet with ASCON-128a in
+ * incremental mode, with the associated data to be supplied incrementally.
+ *
+ * \param state State to initialize for ASCON-128a operations.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ *
+ * This function should be followed by zero or more calls to
+ * ascon128a_aead_ad_update() and then a call to ascon128a_aead_ad_finish().
+ * After that, the payload can be processed with the block functions
+ * in the same way as after ascon128a_aead_start().
+ *
+ * \code
+ * ascon128a_state_t state;
+ * ascon128a_aead_start_ad(&state, npub, k);
+ * ascon128a_aead_ad_update(&state, ad1, ad1_len);
+ * ascon128a_aead_ad_update(&state, ad2, ad2_len);
+ * ...;
+ * ascon128a_aead_ad_finish(&state);
+ * ascon128a_aead_encrypt_block(&state, m1, c1, m1_len);
+ * ...;
+ * ascon128a_aead_encrypt_finalize(&state, t);
+ * \endcode
+ *
+ * \sa ascon128a_aead_ad_update(), ascon128a_aead_ad_finish(),
+ * ascon128a_aead_start()
+ */
+void ascon128a_aead_start_ad
+    (ascon128a_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental ASCON-128a state.
+ *
+ * \param state State to use for ASCON-128a operations.
+ * \param ad Buffer that contains the next chunk of associated data.
+ * \param adlen Length of the associated data chunk in bytes.
+ *
+ * The chunks can be of any length.  The result is the same as if all of
+ * the chunks had been concatenated and passed to ascon128a_aead_start().
+ *
+ * \sa ascon128a_aead_start_ad(), ascon128a_aead_ad_finish()
+ */
+void ascon128a_aead_ad_update
+    (ascon128a_state_t *state, const unsigned char *ad, size_t adlen);
+
+/**
+ * \brief Finishes absorbing the associated data into an incremental
+ * ASCON-128a state.
+ *
+ * \param state State to use for ASCON-128a operations.
+ *
+ * After this function returns, the state is ready to encrypt or
+ * decrypt the payload.
+ *
+ * \sa ascon128a_aead_start_ad(), ascon128a_aead_ad_update()
+ */
+void ascon128a_aead_ad_finish(ascon128a_state_t *state);
+
 /**
  * \brief Aborts use of ASCON-128a in incremental mode.
  *
@@ -614,6 +1724,67 @@ void ascon80pq_aead_start
     (ascon80pq_state_t *state, const unsigned char *ad, size_t adlen,
      const unsigned char *npub, const unsigned char *k);
 
+/**
+ * \brief Starts encrypting or decrypting a packet with ASCON-80pq in
+ * incremental mode, with the associated data to be supplied incrementally.
+ *
+ * \param state State to initialize for ASCON-80pq operations.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to encrypt the packet.
+ *
+ * This function should be followed by zero or more calls to
+ * ascon80pq_aead_ad_update() and then a call to ascon80pq_aead_ad_finish().
+ * After that, the payload can be processed with the block functions
+ * in the same way as after ascon80pq_aead_start().
+ *
+ * \code
+ * ascon80pq_state_t state;
+ * ascon80pq_aead_start_ad(&state, npub, k);
+ * ascon80pq_aead_ad_update(&state, ad1, ad1_len);
+ * ascon80pq_aead_ad_update(&state, ad2, ad2_len);
+ * ...;
+ * ascon80pq_aead_ad_finish(&state);
+ * ascon80pq_aead_encrypt_block(&state, m1, c1, m1_len);
+ * ...;
+ * ascon80pq_aead_encrypt_finalize(&state, t);
+ * \endcode
+ *
+ * \sa ascon80pq_aead_ad_update(), ascon80pq_aead_ad_finish(),
+ * ascon80pq_aead_start()
+ */
+void ascon80pq_aead_start_ad
+    (ascon80pq_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an incremental ASCON-80pq state.
+ *
+ * \param state State to use for ASCON-80pq operations.
+ * \param ad Buffer that contains the next chunk of associated data.
+ * \param adlen Length of the associated data chunk in bytes.
+ *
+ * The chunks can be of any length.  The result is the same as if all of
+ * the chunks had been concatenated and passed to ascon80pq_aead_start().
+ *
+ * \sa ascon80pq_aead_start_ad(), ascon80pq_aead_ad_finish()
+ */
+void ascon80pq_aead_ad_update
+    (ascon80pq_state_t *state, const unsigned char *ad, size_t adlen);
+
+/**
+ * \brief Finishes absorbing the associated data into an incremental
+ * ASCON-80pq state.
+ *
+ * \param state State to use for ASCON-80pq operations.
+ *
+ * After this function returns, the state is ready to encrypt or
+ * decrypt the payload.
+ *
+ * \sa ascon80pq_aead_start_ad(), ascon80pq_aead_ad_update()
+ */
+void ascon80pq_aead_ad_finish(ascon80pq_state_t *state);
+
 /**
  * \brief Aborts use of ASCON-80pq in incremental mode.
  *
@@ -692,6 +1863,428 @@ void ascon80pq_aead_decrypt_block
 int ascon80pq_aead_decrypt_finalize
     (ascon80pq_state_t *state, const unsigned char *tag);
 
+/* ---------------------------------------------------------------- */
+/*       Step-wise API's for the incremental AEAD modes below      */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Progress information for a step-wise encryption or decryption
+ * operation on one chunk of payload data.
+ *
+ * A step-wise operation processes a bounded number of rate blocks per
+ * call so that the work can be spread across several invocations of an
+ * RTOS task or deferred interrupt handler.  This allows encryption to
+ * overlap with I/O, such as a DMA engine that is still transmitting the
+ * previous packet.
+ *
+ * The step functions are built on top of the incremental AEAD state,
+ * which must have been started with the regular start functions.
+ * Once all chunks are done, the regular finalize functions are used
+ * to compute or check the authentication tag.
+ *
+ * \code
+ * ascon128a_state_t state;
+ * ascon_aead_step_t step;
+ * ascon128a_aead_start(&state, ad, adlen, npub, k);
+ * ascon_aead_step_init(&step, m, c, mlen);
+ * while (ascon128a_aead_encrypt_step(&state, &step, 4) > 0) {
+ *     // yield to other tasks
+ * }
+ * ascon128a_aead_encrypt_finalize(&state, t);
+ * \endcode
+ *
+ * This structure should be treated as opaque by the application,
+ * except for the \a done field which may be read to monitor progress.
+ *
+ * \sa ascon_aead_step_init(), ascon128a_aead_encrypt_step()
+ */
+typedef struct
+{
+    /** Points to the next input byte to be processed */
+    const unsigned char *in;
+
+    /** Points to where the next output byte should be written */
+    unsigned char *out;
+
+    /** Number of bytes that remain to be processed */
+    size_t remaining;
+
+    /** Number of bytes that have been processed so far */
+    size_t done;
+
+} ascon_aead_step_t;
+
+/**
+ * \brief Initializes a step-wise encryption or decryption operation on
+ * a chunk of payload data.
+ *
+ * \param step The step-wise progress information to initialize.
+ * \param in Buffer that contains the input to encrypt or decrypt.
+ * \param out Buffer to receive the output.  Can be the same buffer
+ * as \a in.
+ * \param len Length of the input and output in bytes.
+ *
+ * The \a in and \a out buffers must remain valid until the operation
+ * has completed.  The same \a step can be re-initialized for the next
+ * chunk of payload data once the previous chunk has been completed.
+ */
+void ascon_aead_step_init
+    (ascon_aead_step_t *step, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Encrypts some of the data in a chunk of payload with ASCON-128 in
+ * step-wise mode.
+ *
+ * \param state State to use for ASCON-128 operations, which must have
+ * been started with ascon128_aead_start() or ascon128_aead_start_ad().
+ * \param step The step-wise progress information for the chunk.
+ * \param max_blocks Maximum number of 8-byte rate blocks to process
+ * in this call, or zero to process all remaining data.
+ *
+ * \return The number of bytes in the chunk that remain to be processed,
+ * or zero once the chunk is complete.
+ *
+ * If the previous chunk ended part-way through a rate block, then the
+ * first call processes fewer bytes so that subsequent calls start on
+ * a rate block boundary.
+ *
+ * \sa ascon128_aead_decrypt_step(), ascon_aead_step_init(),
+ * ascon128_aead_encrypt_finalize()
+ */
+size_t ascon128_aead_encrypt_step
+    (ascon128_state_t *state, ascon_aead_step_t *step, unsigned max_blocks);
+
+/**
+ * \brief Decrypts some of the data in a chunk of payload with ASCON-128 in
+ * step-wise mode.
+ *
+ * \param state State to use for ASCON-128 operations, which must have
+ * been started with ascon128_aead_start() or ascon128_aead_start_ad().
+ * \param step The step-wise progress information for the chunk.
+ * \param max_blocks Maximum number of 8-byte rate blocks to process
+ * in this call, or zero to process all remaining data.
+ *
+ * \return The number of bytes in the chunk that remain to be processed,
+ * or zero once the chunk is complete.
+ *
+ * If the previous chunk ended part-way through a rate block, then the
+ * first call processes fewer bytes so that subsequent calls start on
+ * a rate block boundary.
+ *
+ * \sa ascon128_aead_encrypt_step(), ascon_aead_step_init(),
+ * ascon128_aead_decrypt_finalize()
+ */
+size_t ascon128_aead_decrypt_step
+    (ascon128_state_t *state, ascon_aead_step_t *step, unsigned max_blocks);
+
+/**
+ * \brief Encrypts some of the data in a chunk of payload with ASCON-128a in
+ * step-wise mode.
+ *
+ * \param state State to use for ASCON-128a operations, which must have
+ * been started with ascon128a_aead_start() or ascon128a_aead_start_ad().
+ * \param step The step-wise progress information for the chunk.
+ * \param max_blocks Maximum number of 16-byte rate blocks to process
+ * in this call, or zero to process all remaining data.
+ *
+ * \return The number of bytes in the chunk that remain to be processed,
+ * or zero once the chunk is complete.
+ *
+ * If the previous chunk ended part-way through a rate block, then the
+ * first call processes fewer bytes so that subsequent calls start on
+ * a rate block boundary.
+ *
+ * \sa ascon128a_aead_decrypt_step(), ascon_aead_step_init(),
+ * ascon128a_aead_encrypt_finalize()
+ */
+size_t ascon128a_aead_encrypt_step
+    (ascon128a_state_t *state, ascon_aead_step_t *step, unsigned max_blocks);
+
+/**
+ * \brief Decrypts some of the data in a chunk of payload with ASCON-128a in
+ * step-wise mode.
+ *
+ * \param state State to use for ASCON-128a operations, which must have
+ * been started with ascon128a_aead_start() or ascon128a_aead_start_ad().
+ * \param step The step-wise progress information for the chunk.
+ * \param max_blocks Maximum number of 16-byte rate blocks to process
+ * in this call, or zero to process all remaining data.
+ *
+ * \return The number of bytes in the chunk that remain to be processed,
+ * or zero once the chunk is complete.
+ *
+ * If the previous chunk ended part-way through a rate block, then the
+ * first call processes fewer bytes so that subsequent calls start on
+ * a rate block boundary.
+ *
+ * \sa ascon128a_aead_encrypt_step(), ascon_aead_step_init(),
+ * ascon128a_aead_decrypt_finalize()
+ */
+size_t ascon128a_aead_decrypt_step
+    (ascon128a_state_t *state, ascon_aead_step_t *step, unsigned max_blocks);
+
+/**
+ * \brief Encrypts some of the data in a chunk of payload with ASCON-80pq in
+ * step-wise mode.
+ *
+ * \param state State to use for ASCON-80pq operations, which must have
+ * been started with ascon80pq_aead_start() or ascon80pq_aead_start_ad().
+ * \param step The step-wise progress information for the chunk.
+ * \param max_blocks Maximum number of 8-byte rate blocks to process
+ * in this call, or zero to process all remaining data.
+ *
+ * \return The number of bytes in the chunk that remain to be processed,
+ * or zero once the chunk is complete.
+ *
+ * If the previous chunk ended part-way through a rate block, then the
+ * first call processes fewer bytes so that subsequent calls start on
+ * a rate block boundary.
+ *
+ * \sa ascon80pq_aead_decrypt_step(), ascon_aead_step_init(),
+ * ascon80pq_aead_encrypt_finalize()
+ */
+size_t ascon80pq_aead_encrypt_step
+    (ascon80pq_state_t *state, ascon_aead_step_t *step, unsigned max_blocks);
+
+/**
+ * \brief Decrypts some of the data in a chunk of payload with ASCON-80pq in
+ * step-wise mode.
+ *
+ * \param state State to use for ASCON-80pq operations, which must have
+ * been started with ascon80pq_aead_start() or ascon80pq_aead_start_ad().
+ * \param step The step-wise progress information for the chunk.
+ * \param max_blocks Maximum number of 8-byte rate blocks to process
+ * in this call, or zero to process all remaining data.
+ *
+ * \return The number of bytes in the chunk that remain to be processed,
+ * or zero once the chunk is complete.
+ *
+ * If the previous chunk ended part-way through a rate block, then the
+ * first call processes fewer bytes so that subsequent calls start on
+ * a rate block boundary.
+ *
+ * \sa ascon80pq_aead_encrypt_step(), ascon_aead_step_init(),
+ * ascon80pq_aead_decrypt_finalize()
+ */
+size_t ascon80pq_aead_decrypt_step
+    (ascon80pq_state_t *state, ascon_aead_step_t *step, unsigned max_blocks);
+
+/* ---------------------------------------------------------------- */
+/*           Scatter/gather API's for the AEAD modes below          */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Describes a single fragment of a scatter/gather buffer.
+ *
+ * For input fragments, the data is only read and never modified.
+ * For output fragments, the data is written.  Zero-length fragments
+ * are permitted and are skipped.
+ *
+ * \sa ascon128_aead_encrypt_iov(), ascon128_aead_decrypt_iov()
+ */
+typedef struct
+{
+    /** Points to the data in the fragment */
+    unsigned char *data;
+
+    /** Length of the fragment in bytes */
+    size_t len;
+
+} ascon_iovec_t;
+
+/**
+ * \brief Encrypts and authenticates a fragmented packet with ASCON-128.
+ *
+ * \param out Array of fragments to receive the ciphertext output.
+ * \param outcnt Number of fragments in \a out.
+ * \param in Array of fragments that contain the plaintext to encrypt.
+ * \param incnt Number of fragments in \a in.
+ * \param ad Array of fragments that contain the associated data.
+ * \param adcnt Number of fragments in \a ad.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON128_TAG_SIZE bytes in length.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ *
+ * \return 0 on success, or -2 if the total length of the \a out
+ * fragments is less than the total length of the \a in fragments.
+ *
+ * The output is the same as for ascon128_aead_encrypt() on the
+ * concatenation of the fragments, except that the tag is written to
+ * a separate buffer.  The fragment boundaries in \a out do not need
+ * to line up with those in \a in.
+ *
+ * \sa ascon128_aead_decrypt_iov(), ascon128_aead_encrypt()
+ */
+int ascon128_aead_encrypt_iov
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a fragmented packet with ASCON-128.
+ *
+ * \param out Array of fragments to receive the plaintext output.
+ * \param outcnt Number of fragments in \a out.
+ * \param in Array of fragments that contain the ciphertext to decrypt,
+ * not including the authentication tag.
+ * \param incnt Number of fragments in \a in.
+ * \param ad Array of fragments that contain the associated data.
+ * \param adcnt Number of fragments in \a ad.
+ * \param tag Points to the authentication tag to check, which must be
+ * ASCON128_TAG_SIZE bytes in length.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the total length of the \a out fragments is less than the
+ * total length of the \a in fragments.
+ *
+ * If the authentication tag is incorrect, then the plaintext that was
+ * written to \a out will be zeroed.
+ *
+ * \sa ascon128_aead_encrypt_iov(), ascon128_aead_decrypt()
+ */
+int ascon128_aead_decrypt_iov
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     const unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a fragmented packet with ASCON-128a.
+ *
+ * \param out Array of fragments to receive the ciphertext output.
+ * \param outcnt Number of fragments in \a out.
+ * \param in Array of fragments that contain the plaintext to encrypt.
+ * \param incnt Number of fragments in \a in.
+ * \param ad Array of fragments that contain the associated data.
+ * \param adcnt Number of fragments in \a ad.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON128_TAG_SIZE bytes in length.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ *
+ * \return 0 on success, or -2 if the total length of the \a out
+ * fragments is less than the total length of the \a in fragments.
+ *
+ * The output is the same as for ascon128a_aead_encrypt() on the
+ * concatenation of the fragments, except that the tag is written to
+ * a separate buffer.  The fragment boundaries in \a out do not need
+ * to line up with those in \a in.
+ *
+ * \sa ascon128a_aead_decrypt_iov(), ascon128a_aead_encrypt()
+ */
+int ascon128a_aead_encrypt_iov
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a fragmented packet with ASCON-128a.
+ *
+ * \param out Array of fragments to receive the plaintext output.
+ * \param outcnt Number of fragments in \a out.
+ * \param in Array of fragments that contain the ciphertext to decrypt,
+ * not including the authentication tag.
+ * \param incnt Number of fragments in \a in.
+ * \param ad Array of fragments that contain the associated data.
+ * \param adcnt Number of fragments in \a ad.
+ * \param tag Points to the authentication tag to check, which must be
+ * ASCON128_TAG_SIZE bytes in length.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the total length of the \a out fragments is less than the
+ * total length of the \a in fragments.
+ *
+ * If the authentication tag is incorrect, then the plaintext that was
+ * written to \a out will be zeroed.
+ *
+ * \sa ascon128a_aead_encrypt_iov(), ascon128a_aead_decrypt()
+ */
+int ascon128a_aead_decrypt_iov
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     const unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts and authenticates a fragmented packet with ASCON-80pq.
+ *
+ * \param out Array of fragments to receive the ciphertext output.
+ * \param outcnt Number of fragments in \a out.
+ * \param in Array of fragments that contain the plaintext to encrypt.
+ * \param incnt Number of fragments in \a in.
+ * \param ad Array of fragments that contain the associated data.
+ * \param adcnt Number of fragments in \a ad.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON80PQ_TAG_SIZE bytes in length.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to encrypt the packet.
+ *
+ * \return 0 on success, or -2 if the total length of the \a out
+ * fragments is less than the total length of the \a in fragments.
+ *
+ * The output is the same as for ascon80pq_aead_encrypt() on the
+ * concatenation of the fragments, except that the tag is written to
+ * a separate buffer.  The fragment boundaries in \a out do not need
+ * to line up with those in \a in.
+ *
+ * \sa ascon80pq_aead_decrypt_iov(), ascon80pq_aead_encrypt()
+ */
+int ascon80pq_aead_encrypt_iov
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a fragmented packet with ASCON-80pq.
+ *
+ * \param out Array of fragments to receive the plaintext output.
+ * \param outcnt Number of fragments in \a out.
+ * \param in Array of fragments that contain the ciphertext to decrypt,
+ * not including the authentication tag.
+ * \param incnt Number of fragments in \a in.
+ * \param ad Array of fragments that contain the associated data.
+ * \param adcnt Number of fragments in \a ad.
+ * \param tag Points to the authentication tag to check, which must be
+ * ASCON80PQ_TAG_SIZE bytes in length.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or -2 if the total length of the \a out fragments is less than the
+ * total length of the \a in fragments.
+ *
+ * If the authentication tag is incorrect, then the plaintext that was
+ * written to \a out will be zeroed.
+ *
+ * \sa ascon80pq_aead_encrypt_iov(), ascon80pq_aead_decrypt()
+ */
+int ascon80pq_aead_decrypt_iov
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     const unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k);
+
 #ifdef __cplusplus
 }
 #endif
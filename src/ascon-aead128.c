@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2021 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "ascon-config.h"
+#include "ascon-latency.h"
+#include "ascon-sp800-232.h"
+#include "utility/ascon-aead-common.h"
+#include "utility/ascon-util-le.h"
+#include <string.h>
+
+#if ASCON_ENABLE_AEAD
+
+/**
+ * \brief Initialization vector for Ascon-AEAD128.
+ */
+#define ASCON_AEAD128_IV 0x00001000808c0001ULL
+
+/**
+ * \brief Initializes the Ascon-AEAD128 state with a key and nonce.
+ *
+ * \param state The ASCON state to be initialized.
+ * \param npub Points to the nonce.
+ * \param k Points to the key.
+ */
+static void ascon_aead128_start
+    (ascon_state_t *state, const unsigned char *npub, const unsigned char *k)
+{
+    /* Lay out the state with the words of the key and nonce byte-reversed
+     * so that it can be loaded with a single call in any back end */
+    unsigned char block[40];
+    be_store_word64(block, ASCON_AEAD128_IV);
+    ascon_le_reverse_8(block + 8, k);
+    ascon_le_reverse_8(block + 16, k + 8);
+    ascon_le_reverse_8(block + 24, npub);
+    ascon_le_reverse_8(block + 32, npub + 8);
+    ascon_init(state);
+    ascon_overwrite_bytes(state, block, 0, sizeof(block));
+    ascon_clean(block, sizeof(block));
+    ascon_permute(state, 0);
+    ascon_le_absorb_16(state, k, 24);
+}
+
+/**
+ * \brief Absorbs the associated data into the Ascon-AEAD128 state.
+ *
+ * \param state The ASCON state.
+ * \param ad Points to the associated data.
+ * \param adlen Length of the associated data, which must be non-zero.
+ */
+static void ascon_aead128_absorb
+    (ascon_state_t *state, const unsigned char *ad, size_t adlen)
+{
+    unsigned temp;
+    while (adlen >= ASCON_AEAD128_RATE) {
+        ascon_le_absorb_16(state, ad, 0);
+        ascon_permute(state, 4);
+        ad += ASCON_AEAD128_RATE;
+        adlen -= ASCON_AEAD128_RATE;
+    }
+    temp = (unsigned)adlen;
+    if (temp >= 8) {
+        ascon_le_absorb_8(state, ad, 0);
+        if (temp > 8)
+            ascon_le_absorb_partial(state, ad + 8, 8, temp - 8);
+    } else if (temp > 0) {
+        ascon_le_absorb_partial(state, ad, 0, temp);
+    }
+    ascon_le_pad(state, temp);
+    ascon_permute(state, 4);
+}
+
+/**
+ * \brief Finalizes the Ascon-AEAD128 state and squeezes out the tag.
+ *
+ * \param state The ASCON state.
+ * \param tag Points to the buffer to receive the tag.
+ * \param k Points to the key.
+ */
+static void ascon_aead128_finalize
+    (ascon_state_t *state, unsigned char *tag, const unsigned char *k)
+{
+    ascon_le_absorb_16(state, k, 16);
+    ascon_permute(state, 0);
+    ascon_le_absorb_16(state, k, 24);
+    ascon_le_squeeze_16(state, tag, 24);
+}
+
+void ascon_aead128_encrypt
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    unsigned temp;
+    ascon_latency_begin();
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + ASCON_AEAD128_TAG_SIZE;
+
+    /* Initialize the ASCON state */
+    ascon_aead128_start(&state, npub, k);
+
+    /* Absorb the associated data into the state */
+    if (adlen > 0)
+        ascon_aead128_absorb(&state, ad, adlen);
+
+    /* Separator between the associated data and the payload */
+    ascon_le_separator(&state);
+
+    /* Encrypt the plaintext to create the ciphertext */
+    while (mlen >= ASCON_AEAD128_RATE) {
+        ascon_le_encrypt_16(&state, c, m, 0);
+        ascon_permute(&state, 4);
+        c += ASCON_AEAD128_RATE;
+        m += ASCON_AEAD128_RATE;
+        mlen -= ASCON_AEAD128_RATE;
+    }
+    temp = (unsigned)mlen;
+    if (temp >= 8) {
+        ascon_le_encrypt_8(&state, c, m, 0);
+        if (temp > 8)
+            ascon_le_encrypt_partial(&state, c + 8, m + 8, 8, temp - 8);
+    } else if (temp > 0) {
+        ascon_le_encrypt_partial(&state, c, m, 0, temp);
+    }
+    ascon_le_pad(&state, temp);
+
+    /* Finalize and compute the authentication tag */
+    ascon_aead128_finalize(&state, c + temp, k);
+    ascon_free(&state);
+    ascon_latency_end(ASCON_LATENCY_AEAD);
+}
+
+int ascon_aead128_decrypt
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    unsigned char tag[ASCON_AEAD128_TAG_SIZE];
+    unsigned char *mtemp = m;
+    size_t len;
+    unsigned temp;
+    int result;
+    ascon_latency_begin();
+
+    /* Set the length of the returned plaintext */
+    if (clen < ASCON_AEAD128_TAG_SIZE)
+        return -1;
+    len = clen - ASCON_AEAD128_TAG_SIZE;
+    *mlen = len;
+
+    /* Initialize the ASCON state */
+    ascon_aead128_start(&state, npub, k);
+
+    /* Absorb the associated data into the state */
+    if (adlen > 0)
+        ascon_aead128_absorb(&state, ad, adlen);
+
+    /* Separator between the associated data and the payload */
+    ascon_le_separator(&state);
+
+    /* Decrypt the ciphertext to create the plaintext */
+    while (len >= ASCON_AEAD128_RATE) {
+        ascon_le_decrypt_16(&state, m, c, 0);
+        ascon_permute(&state, 4);
+        c += ASCON_AEAD128_RATE;
+        m += ASCON_AEAD128_RATE;
+        len -= ASCON_AEAD128_RATE;
+    }
+    temp = (unsigned)len;
+    if (temp >= 8) {
+        ascon_le_decrypt_8(&state, m, c, 0);
+        if (temp > 8)
+            ascon_le_decrypt_partial(&state, m + 8, c + 8, 8, temp - 8);
+    } else if (temp > 0) {
+        ascon_le_decrypt_partial(&state, m, c, 0, temp);
+    }
+    ascon_le_pad(&state, temp);
+
+    /* Finalize and check the authentication tag */
+    ascon_aead128_finalize(&state, tag, k);
+    result = ascon_aead_check_tag
+        (mtemp, *mlen, tag, c + temp, ASCON_AEAD128_TAG_SIZE);
+    ascon_clean(tag, sizeof(tag));
+    ascon_free(&state);
+    ascon_latency_end(ASCON_LATENCY_AEAD);
+    return result;
+}
+
+#endif /* ASCON_ENABLE_AEAD */
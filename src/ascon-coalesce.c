@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-coalesce.h"
+#include "utility/ascon-multi.h"
+#include <string.h>
+
+/**
+ * \def ASCON_COALESCE_THREADS
+ * \brief Define to 1 if requests may be submitted from several threads
+ * at once, or 0 if there is a single thread of execution.
+ */
+#if !defined(ASCON_COALESCE_THREADS)
+#if defined(ESP32) || defined(ESP_PLATFORM)
+#define ASCON_COALESCE_THREADS 1
+#elif !defined(ARDUINO) && (defined(__linux__) || defined(__APPLE__) || \
+    defined(__unix__) || defined(_WIN32))
+#define ASCON_COALESCE_THREADS 1
+#else
+#define ASCON_COALESCE_THREADS 0
+#endif
+#endif
+
+/* Atomic access to the queue of submitted requests.  The swap operation
+ * replaces the head of the queue with "desired" if it is "expected", and
+ * returns the previous head either way. */
+#if ASCON_COALESCE_THREADS && defined(_MSC_VER)
+#include <intrin.h>
+#define ascon_coalesce_queue_load(queue) \
+    ((ascon_coalesce_request_t *)_InterlockedCompareExchangePointer \
+        ((void * volatile *)(queue), 0, 0))
+#define ascon_coalesce_queue_take(queue) \
+    ((ascon_coalesce_request_t *)_InterlockedExchangePointer \
+        ((void * volatile *)(queue), 0))
+#define ascon_coalesce_queue_swap(queue, expected, desired) \
+    ((ascon_coalesce_request_t *)_InterlockedCompareExchangePointer \
+        ((void * volatile *)(queue), (desired), (expected)))
+#elif ASCON_COALESCE_THREADS
+#define ascon_coalesce_queue_load(queue) \
+    (__atomic_load_n((queue), __ATOMIC_RELAXED))
+#define ascon_coalesce_queue_take(queue) \
+    (__atomic_exchange_n((queue), 0, __ATOMIC_ACQUIRE))
+static ascon_coalesce_request_t *ascon_coalesce_queue_swap
+    (ascon_coalesce_request_t **queue, ascon_coalesce_request_t *expected,
+     ascon_coalesce_request_t *desired)
+{
+    __atomic_compare_exchange_n
+        (queue, &expected, desired, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    return expected;
+}
+#else
+#define ascon_coalesce_queue_load(queue) (*(queue))
+static ascon_coalesce_request_t *ascon_coalesce_queue_take
+    (ascon_coalesce_request_t **queue)
+{
+    ascon_coalesce_request_t *head = *queue;
+    *queue = 0;
+    return head;
+}
+static ascon_coalesce_request_t *ascon_coalesce_queue_swap
+    (ascon_coalesce_request_t **queue, ascon_coalesce_request_t *expected,
+     ascon_coalesce_request_t *desired)
+{
+    ascon_coalesce_request_t *head = *queue;
+    if (head == expected)
+        *queue = desired;
+    return head;
+}
+#endif
+
+int ascon_coalesce_init
+    (ascon_coalesce_t *sched, int op, unsigned long deadline,
+     ascon_coalesce_clock_t clock)
+{
+    switch (op) {
+#if ASCON_ENABLE_AEAD
+    case ASCON_COALESCE_ASCON128_ENCRYPT:
+    case ASCON_COALESCE_ASCON128_DECRYPT:
+    case ASCON_COALESCE_ASCON128A_ENCRYPT:
+    case ASCON_COALESCE_ASCON128A_DECRYPT:
+        break;
+#endif
+#if ASCON_ENABLE_HASH
+    case ASCON_COALESCE_HASH:
+    case ASCON_COALESCE_HASHA:
+        break;
+#endif
+    default: return -1;
+    }
+    sched->queue = 0;
+    sched->pending = 0;
+    sched->pending_tail = 0;
+    sched->pending_count = 0;
+    sched->lanes = ASCON_MULTI_LANES;
+    sched->op = op;
+    sched->deadline = deadline;
+    sched->clock = clock;
+    return 0;
+}
+
+void ascon_coalesce_free(ascon_coalesce_t *sched)
+{
+    if (sched) {
+        ascon_coalesce_poll(sched, 1);
+        sched->clock = 0;
+    }
+}
+
+void ascon_coalesce_submit
+    (ascon_coalesce_t *sched, ascon_coalesce_request_t *request)
+{
+    ascon_coalesce_request_t *head;
+    ascon_coalesce_request_t *prev;
+    request->submitted = (*(sched->clock))();
+    head = ascon_coalesce_queue_load(&(sched->queue));
+    for (;;) {
+        request->next = head;
+        prev = ascon_coalesce_queue_swap(&(sched->queue), head, request);
+        if (prev == head)
+            break;
+        head = prev;
+    }
+}
+
+/**
+ * \brief Moves the submitted requests onto the end of the pending list.
+ *
+ * \param sched The scheduler.
+ *
+ * The queue is a lock-free stack, so the requests are taken all at once
+ * and then reversed to put them back into the order of submission.
+ */
+static void ascon_coalesce_drain(ascon_coalesce_t *sched)
+{
+    ascon_coalesce_request_t *list;
+    ascon_coalesce_request_t *reversed = 0;
+    ascon_coalesce_request_t *tail;
+    ascon_coalesce_request_t *next;
+    unsigned count = 0;
+    list = ascon_coalesce_queue_take(&(sched->queue));
+    tail = list;
+    while (list) {
+        next = list->next;
+        list->next = reversed;
+        reversed = list;
+        list = next;
+        ++count;
+    }
+    if (!reversed)
+        return;
+    if (sched->pending_tail)
+        sched->pending_tail->next = reversed;
+    else
+        sched->pending = reversed;
+    sched->pending_tail = tail;
+    sched->pending_count += count;
+}
+
+/**
+ * \brief Dispatches requests from the front of the pending list as a
+ * single batch and then calls their callbacks.
+ *
+ * \param sched The scheduler.
+ * \param count Number of requests to dispatch, between 1 and
+ * ASCON_MULTI_LANES.
+ */
+static void ascon_coalesce_dispatch(ascon_coalesce_t *sched, unsigned count)
+{
+    ascon_coalesce_request_t *requests[ASCON_MULTI_LANES];
+#if ASCON_ENABLE_AEAD
+    ascon_aead_batch_t msgs[ASCON_MULTI_LANES];
+#endif
+#if ASCON_ENABLE_HASH
+    const unsigned char *in[ASCON_MULTI_LANES];
+    size_t inlen[ASCON_MULTI_LANES];
+    unsigned char out[ASCON_MULTI_LANES * ASCON_HASH_SIZE];
+#endif
+    ascon_coalesce_callback_t callback;
+    unsigned index;
+
+    /* Nothing to do if the batch is empty */
+    if (count == 0)
+        return;
+
+    /* Take the requests off the front of the pending list */
+    for (index = 0; index < count; ++index) {
+        requests[index] = sched->pending;
+        sched->pending = sched->pending->next;
+    }
+    if (!(sched->pending))
+        sched->pending_tail = 0;
+    sched->pending_count -= count;
+
+    /* Process the requests as a batch */
+    switch (sched->op) {
+#if ASCON_ENABLE_AEAD
+    case ASCON_COALESCE_ASCON128_ENCRYPT:
+    case ASCON_COALESCE_ASCON128_DECRYPT:
+    case ASCON_COALESCE_ASCON128A_ENCRYPT:
+    case ASCON_COALESCE_ASCON128A_DECRYPT:
+        for (index = 0; index < count; ++index)
+            msgs[index] = requests[index]->msg;
+        if (sched->op == ASCON_COALESCE_ASCON128_ENCRYPT)
+            ascon128_aead_encrypt_batch(msgs, count);
+        else if (sched->op == ASCON_COALESCE_ASCON128_DECRYPT)
+            ascon128_aead_decrypt_batch(msgs, count);
+        else if (sched->op == ASCON_COALESCE_ASCON128A_ENCRYPT)
+            ascon128a_aead_encrypt_batch(msgs, count);
+        else
+            ascon128a_aead_decrypt_batch(msgs, count);
+        for (index = 0; index < count; ++index) {
+            requests[index]->msg.outlen = msgs[index].outlen;
+            requests[index]->msg.result = msgs[index].result;
+        }
+        break;
+#endif
+#if ASCON_ENABLE_HASH
+    case ASCON_COALESCE_HASH:
+    case ASCON_COALESCE_HASHA:
+        for (index = 0; index < ASCON_MULTI_LANES; ++index) {
+            if (index < count) {
+                in[index] = requests[index]->msg.in;
+                inlen[index] = requests[index]->msg.inlen;
+            } else {
+                in[index] = 0;
+                inlen[index] = 0;
+            }
+        }
+        if (sched->op == ASCON_COALESCE_HASH)
+            ascon_hash_many(out, in, inlen, count);
+        else
+            ascon_hasha_many(out, in, inlen, count);
+        for (index = 0; index < count; ++index) {
+            memcpy(requests[index]->msg.out, out + index * ASCON_HASH_SIZE,
+                   ASCON_HASH_SIZE);
+            requests[index]->msg.outlen = ASCON_HASH_SIZE;
+            requests[index]->msg.result = 0;
+        }
+        break;
+#endif
+    default: break;
+    }
+
+    /* Report completion.  The callbacks may free or resubmit the
+     * requests, so the requests must not be touched afterwards. */
+    for (index = 0; index < count; ++index) {
+        callback = requests[index]->callback;
+        requests[index]->next = 0;
+        if (callback)
+            (*callback)(requests[index]);
+    }
+}
+
+unsigned ascon_coalesce_poll(ascon_coalesce_t *sched, int flush)
+{
+    unsigned completed = 0;
+    unsigned count;
+    ascon_coalesce_drain(sched);
+    while (sched->pending_count >= sched->lanes) {
+        ascon_coalesce_dispatch(sched, sched->lanes);
+        completed += sched->lanes;
+    }
+    count = sched->pending_count;
+    if (count > 0 && (flush || ((*(sched->clock))() -
+            sched->pending->submitted) >= sched->deadline)) {
+        ascon_coalesce_dispatch(sched, count);
+        completed += count;
+    }
+    return completed;
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_COALESCE_H
+#define ASCON_COALESCE_H
+
+/**
+ * \file ascon-coalesce.h
+ * \brief Gathers single requests into batches for the batch AEAD and
+ * hashing functions.
+ *
+ * The batch functions only help when the caller has several messages to
+ * hand at once.  A server that receives requests one at a time from many
+ * threads can instead submit each request to a coalescing scheduler with
+ * ascon_coalesce_submit().  A single dispatcher thread calls
+ * ascon_coalesce_poll() regularly, which hands the requests to the batch
+ * functions once there are enough of them to fill the lanes of the back
+ * end, or once the oldest request has waited for the deadline.
+ *
+ * Submission is lock-free and may be called from any number of threads
+ * at once.  Only one thread may call ascon_coalesce_poll() at a time.
+ * Completion of each request is reported through its callback, which is
+ * called on the dispatcher thread.
+ *
+ * The number of lanes depends on the back end; e.g. 8 with AVX-512,
+ * 4 with AVX2 or NEON, and 1 on back ends that permute one state at a
+ * time.  With a single lane, requests are dispatched as soon as they are
+ * polled because there is nothing to gain from waiting.
+ */
+
+#include "ascon-aead.h"
+#include "ascon-hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Encrypt requests with ASCON-128 */
+#define ASCON_COALESCE_ASCON128_ENCRYPT     0
+
+/** Decrypt requests with ASCON-128 */
+#define ASCON_COALESCE_ASCON128_DECRYPT     1
+
+/** Encrypt requests with ASCON-128a */
+#define ASCON_COALESCE_ASCON128A_ENCRYPT    2
+
+/** Decrypt requests with ASCON-128a */
+#define ASCON_COALESCE_ASCON128A_DECRYPT    3
+
+/** Hash requests with ASCON-HASH */
+#define ASCON_COALESCE_HASH                 4
+
+/** Hash requests with ASCON-HASHA */
+#define ASCON_COALESCE_HASHA                5
+
+/**
+ * \brief Clock that measures the age of requests in a coalescing scheduler.
+ *
+ * \return The current time in microseconds.  The value is allowed to
+ * wrap around.  The clock is called from the submitting threads, so it
+ * must be safe to call from any thread.
+ */
+typedef unsigned long (*ascon_coalesce_clock_t)(void);
+
+typedef struct ascon_coalesce_request_s ascon_coalesce_request_t;
+
+/**
+ * \brief Callback that is called when a request has been completed.
+ *
+ * \param request The request that was completed.  The callback may
+ * free or reuse the request.
+ */
+typedef void (*ascon_coalesce_callback_t)(ascon_coalesce_request_t *request);
+
+/**
+ * \brief A single request to a coalescing scheduler.
+ *
+ * For AEAD requests, \a msg is filled in in the same way as for
+ * ascon128_aead_encrypt_batch() and ascon128_aead_decrypt_batch().
+ *
+ * For hash requests, only the \a in, \a inlen, and \a out fields of
+ * \a msg are used, and \a out must have room for ASCON_HASH_SIZE bytes.
+ *
+ * The request and the buffers that it refers to must remain valid until
+ * the callback has been called.
+ */
+struct ascon_coalesce_request_s
+{
+    /** Description of the message, with the outputs filled in on exit */
+    ascon_aead_batch_t msg;
+
+    /** Callback to call when the request has been completed */
+    ascon_coalesce_callback_t callback;
+
+    /** Extra data for use by the callback */
+    void *user_data;
+
+    /** Time that the request was submitted, for internal use */
+    unsigned long submitted;
+
+    /** Next request in the queue, for internal use */
+    ascon_coalesce_request_t *next;
+};
+
+/**
+ * \brief State of a coalescing scheduler.
+ */
+typedef struct
+{
+    /** Requests that have been submitted but not yet polled, newest first */
+    ascon_coalesce_request_t *queue;
+
+    /** Requests that have been polled but not yet dispatched, oldest first */
+    ascon_coalesce_request_t *pending;
+
+    /** Last request in the pending list */
+    ascon_coalesce_request_t *pending_tail;
+
+    /** Number of requests in the pending list */
+    unsigned pending_count;
+
+    /** Number of lanes to fill before dispatching early */
+    unsigned lanes;
+
+    /** Operation to perform, ASCON_COALESCE_* */
+    int op;
+
+    /** Maximum time in microseconds that a request can wait for a batch */
+    unsigned long deadline;
+
+    /** Clock that measures the age of the requests */
+    ascon_coalesce_clock_t clock;
+
+} ascon_coalesce_t;
+
+/**
+ * \brief Initializes a coalescing scheduler.
+ *
+ * \param sched The scheduler to initialize.
+ * \param op The operation to perform on the requests, ASCON_COALESCE_*.
+ * \param deadline Maximum time in microseconds that a request waits for
+ * other requests to share its batch.  Zero dispatches all pending
+ * requests every time the scheduler is polled.
+ * \param clock Clock that measures the age of requests in microseconds.
+ *
+ * \return 0 on success, or -1 if \a op is not supported in this build.
+ *
+ * \sa ascon_coalesce_free()
+ */
+int ascon_coalesce_init
+    (ascon_coalesce_t *sched, int op, unsigned long deadline,
+     ascon_coalesce_clock_t clock);
+
+/**
+ * \brief Frees a coalescing scheduler after dispatching any requests
+ * that are still waiting.
+ *
+ * \param sched The scheduler to free.
+ *
+ * No other thread may submit requests to the scheduler once this
+ * function has been called.
+ */
+void ascon_coalesce_free(ascon_coalesce_t *sched);
+
+/**
+ * \brief Submits a request to a coalescing scheduler.
+ *
+ * \param sched The scheduler.
+ * \param request The request to submit.
+ *
+ * This function can be called from any thread at any time, including
+ * from the callback for another request.
+ *
+ * \sa ascon_coalesce_poll()
+ */
+void ascon_coalesce_submit
+    (ascon_coalesce_t *sched, ascon_coalesce_request_t *request);
+
+/**
+ * \brief Polls a coalescing scheduler and dispatches the requests that
+ * are ready.
+ *
+ * \param sched The scheduler.
+ * \param flush Non-zero to dispatch all pending requests regardless of
+ * their age.
+ *
+ * \return The number of requests that were completed.
+ *
+ * Full batches are dispatched straight away.  A partial batch is
+ * dispatched once its oldest request has waited for the deadline.
+ * The caller should poll at least as often as the deadline to keep
+ * the latency bounded.
+ */
+unsigned ascon_coalesce_poll(ascon_coalesce_t *sched, int flush);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
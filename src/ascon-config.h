@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_CONFIG_H
+#define ASCON_CONFIG_H
+
+/**
+ * \file ascon-config.h
+ * \brief Build profiles that select which parts of the library to compile.
+ *
+ * By default the whole library is compiled.  Smaller builds can be
+ * selected by defining one or more of the following in the build
+ * configuration, or by uncommenting them below:
+ *
+ * \li ASCON_PROFILE_AEAD_ONLY - AEAD modes only; no hashing, HMAC, KMAC,
+ * HKDF, PBKDF2, or PRF.  ASCON-XOF is kept for the PRNG.
+ * \li ASCON_PROFILE_HASH_ONLY - hashing and keyed hashing modes only;
+ * no AEAD, SIV, ISAP, or masked AEAD modes.
+ * \li ASCON_NO_MASKING - omit the masked AEAD modes and masked keys.
+ * \li ASCON_NO_ISAP - omit the ISAP-A AEAD modes.
+ * \li ASCON_SMALL - prefer smaller code over faster code.  The C back ends
+ * use a compact permutation with a rolled round loop, the multi-state and
+ * bulk permutation variants fall back to calling ascon_permute(), and the
+ * precomputed hash and XOF initialization vectors are computed at runtime.
+ * \li ASCON_STATS - count the permutation calls, rounds, and the bytes
+ * absorbed and squeezed by the AEAD and XOF modes.  The counters can be
+ * retrieved with ascon_stats_get().  Only intended for profiling.
+ * \li ASCON_LATENCY - record the latency of each AEAD, masked AEAD,
+ * hashing, PRNG, and TRNG call into histograms that can be retrieved
+ * with ascon_latency_get() or printed with ascon_latency_dump().
+ * \li ASCON_ACCEL - offload long runs of AEAD rate blocks to the ASCON
+ * hardware accelerator that was registered with ascon_accel_register().
+ * \li ASCON_FAST_RAM - place the permutation and the AEAD block loops in
+ * instruction RAM on platforms that run code from flash with wait states;
+ * e.g. IRAM on ESP32 and ESP8266, ".ramfunc" on SAMD51 and SAM3X8E,
+ * ".RamFunc" on STM32, and ".fastrun" (ITCM) on Teensy.  Define
+ * ASCON_RAM_SECTION to the name of the section to use on other platforms.
+ * \li ASCON_TRNG_DUE_RING_SIZE - on the Arduino Due, collect TRNG output
+ * from the TRNG interrupt into a ring buffer of this many 32-bit words
+ * (a power of two).  Random words are then served from the buffer, with
+ * polling used only when the buffer is empty.  The library then defines
+ * TRNG_Handler(), so the application must not define its own.
+ *
+ * Functions in omitted modules are still declared in the headers, but
+ * will fail to link if they are used.
+ */
+
+#if defined(HAVE_CONFIG_H)
+#include <config.h>
+#endif
+
+/* Uncomment one or more of these to select a build profile */
+/* #define ASCON_PROFILE_AEAD_ONLY 1 */
+/* #define ASCON_PROFILE_HASH_ONLY 1 */
+/* #define ASCON_NO_MASKING 1 */
+/* #define ASCON_NO_ISAP 1 */
+/* #define ASCON_SMALL 1 */
+/* #define ASCON_STATS 1 */
+/* #define ASCON_LATENCY 1 */
+/* #define ASCON_ACCEL 1 */
+/* #define ASCON_FAST_RAM 1 */
+
+#if defined(ASCON_PROFILE_AEAD_ONLY) && defined(ASCON_PROFILE_HASH_ONLY)
+#error "ASCON_PROFILE_AEAD_ONLY and ASCON_PROFILE_HASH_ONLY are exclusive"
+#endif
+
+/**
+ * \def ASCON_ENABLE_AEAD
+ * \brief Non-zero if the AEAD and SIV modes are compiled.
+ */
+#if !defined(ASCON_ENABLE_AEAD)
+#if defined(ASCON_PROFILE_HASH_ONLY)
+#define ASCON_ENABLE_AEAD 0
+#else
+#define ASCON_ENABLE_AEAD 1
+#endif
+#endif
+
+/**
+ * \def ASCON_ENABLE_HASH
+ * \brief Non-zero if the hashing and keyed hashing modes are compiled.
+ */
+#if !defined(ASCON_ENABLE_HASH)
+#if defined(ASCON_PROFILE_AEAD_ONLY)
+#define ASCON_ENABLE_HASH 0
+#else
+#define ASCON_ENABLE_HASH 1
+#endif
+#endif
+
+/**
+ * \def ASCON_ENABLE_ISAP
+ * \brief Non-zero if the ISAP-A AEAD modes are compiled.
+ */
+#if !defined(ASCON_ENABLE_ISAP)
+#if ASCON_ENABLE_AEAD && !defined(ASCON_NO_ISAP)
+#define ASCON_ENABLE_ISAP 1
+#else
+#define ASCON_ENABLE_ISAP 0
+#endif
+#endif
+
+/**
+ * \def ASCON_ENABLE_MASKING
+ * \brief Non-zero if the masked AEAD modes and masked keys are compiled.
+ */
+#if !defined(ASCON_ENABLE_MASKING)
+#if ASCON_ENABLE_AEAD && !defined(ASCON_NO_MASKING)
+#define ASCON_ENABLE_MASKING 1
+#else
+#define ASCON_ENABLE_MASKING 0
+#endif
+#endif
+
+#endif
@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_CONSTEXPR_H
+#define ASCON_CONSTEXPR_H
+
+/**
+ * \file ascon-constexpr.h
+ * \brief Compile-time versions of ASCON-HASH, ASCON-HASHA, ASCON-XOF,
+ * and ASCON-XOFA for use with constant strings.
+ *
+ * The functions in this file are C++14 constexpr functions that produce
+ * the same output as the runtime versions.  When the input is a constant,
+ * the digest is computed by the compiler and can be placed in flash memory,
+ * which avoids the cost of hashing fixed strings at startup:
+ *
+ * \code
+ * static constexpr Ascon::ConstDigest<ASCON_HASH_SIZE> cmd_reset =
+ *     Ascon::constHash("reset");
+ * \endcode
+ *
+ * The constexpr implementation is slow when the functions are called at
+ * runtime, so the regular ascon_hash() and related functions should be
+ * used for non-constant input.
+ *
+ * This header does nothing unless the compiler supports C++14 or better.
+ */
+
+#include "ascon-xof.h"
+
+#if defined(__cplusplus) && __cplusplus >= 201402L
+
+namespace Ascon
+{
+
+/**
+ * \brief Digest value that was computed at compile time.
+ *
+ * \tparam N Number of bytes in the digest.
+ */
+template <size_t N>
+struct ConstDigest
+{
+    /** Bytes of the digest */
+    unsigned char bytes[N];
+
+    /** \brief Returns byte \a i of the digest */
+    constexpr unsigned char operator[](size_t i) const { return bytes[i]; }
+
+    /** \brief Returns a pointer to the bytes of the digest */
+    constexpr const unsigned char *data() const { return bytes; }
+
+    /** \brief Returns the size of the digest in bytes */
+    constexpr size_t size() const { return N; }
+};
+
+/** \cond ascon_constexpr_internal */
+
+namespace ConstImpl
+{
+
+/* 64-bit version of the ASCON state, with no backend-specific layout */
+struct State
+{
+    uint64_t x[5];
+};
+
+constexpr uint64_t rotate(uint64_t x, unsigned bits)
+{
+    return (x >> bits) | (x << (64 - bits));
+}
+
+/* Runs the ASCON permutation from "first_round" up to round 11 */
+constexpr void permute(State &s, unsigned first_round)
+{
+    uint64_t x0 = s.x[0], x1 = s.x[1], x2 = s.x[2];
+    uint64_t x3 = s.x[3], x4 = s.x[4];
+    uint64_t t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0;
+    for (unsigned round = first_round; round < 12; ++round) {
+        /* Add the round constant to the state */
+        x2 ^= ((0x0FU - round) << 4) | round;
+
+        /* Substitution layer */
+        x0 ^= x4; x4 ^= x3; x2 ^= x1;
+        t0 = ~x0 & x1; t1 = ~x1 & x2; t2 = ~x2 & x3;
+        t3 = ~x3 & x4; t4 = ~x4 & x0;
+        x0 ^= t1; x1 ^= t2; x2 ^= t3; x3 ^= t4; x4 ^= t0;
+        x1 ^= x0; x0 ^= x4; x3 ^= x2; x2 = ~x2;
+
+        /* Linear diffusion layer */
+        x0 ^= rotate(x0, 19) ^ rotate(x0, 28);
+        x1 ^= rotate(x1, 61) ^ rotate(x1, 39);
+        x2 ^= rotate(x2, 1)  ^ rotate(x2, 6);
+        x3 ^= rotate(x3, 10) ^ rotate(x3, 17);
+        x4 ^= rotate(x4, 7)  ^ rotate(x4, 41);
+    }
+    s.x[0] = x0; s.x[1] = x1; s.x[2] = x2; s.x[3] = x3; s.x[4] = x4;
+}
+
+/* Hashes the input and squeezes N bytes of output */
+template <size_t N>
+constexpr ConstDigest<N> xof
+    (const char *in, size_t inlen, uint64_t iv, unsigned first_round)
+{
+    State s = {{iv, 0, 0, 0, 0}};
+    ConstDigest<N> out = {{0}};
+    size_t posn = 0;
+    size_t index = 0;
+
+    /* Initialize the state by permuting the IV */
+    permute(s, 0);
+
+    /* Absorb the input and pad the last block */
+    for (index = 0; index < inlen; ++index) {
+        s.x[0] ^= ((uint64_t)(unsigned char)(in[index])) << (56 - posn * 8);
+        if (++posn == ASCON_XOF_RATE) {
+            permute(s, first_round);
+            posn = 0;
+        }
+    }
+    s.x[0] ^= ((uint64_t)0x80U) << (56 - posn * 8);
+    permute(s, 0);
+
+    /* Squeeze out the output */
+    posn = 0;
+    for (index = 0; index < N; ++index) {
+        if (posn == ASCON_XOF_RATE) {
+            permute(s, first_round);
+            posn = 0;
+        }
+        out.bytes[index] = (unsigned char)(s.x[0] >> (56 - posn * 8));
+        ++posn;
+    }
+    return out;
+}
+
+/* Determines the length of a NUL-terminated string */
+constexpr size_t length(const char *str)
+{
+    size_t len = 0;
+    while (str[len] != '\0')
+        ++len;
+    return len;
+}
+
+} /* namespace ConstImpl */
+
+/** \endcond */
+
+/**
+ * \brief Hashes a constant string with ASCON-HASH at compile time.
+ *
+ * \param str Points to the string to hash.
+ * \param len Length of the string in bytes.
+ *
+ * \return The ASCON_HASH_SIZE bytes of the digest, the same as ascon_hash().
+ */
+constexpr ConstDigest<ASCON_HASH_SIZE> constHash(const char *str, size_t len)
+{
+    return ConstImpl::xof<ASCON_HASH_SIZE>
+        (str, len, 0x00400c0000000100ULL, 0);
+}
+
+/**
+ * \brief Hashes a NUL-terminated constant string with ASCON-HASH at
+ * compile time.
+ *
+ * \param str Points to the string to hash.  The NUL terminator is
+ * not included in the hash.
+ *
+ * \return The ASCON_HASH_SIZE bytes of the digest, the same as ascon_hash().
+ */
+constexpr ConstDigest<ASCON_HASH_SIZE> constHash(const char *str)
+{
+    return constHash(str, ConstImpl::length(str));
+}
+
+/**
+ * \brief Hashes a constant string with ASCON-HASHA at compile time.
+ *
+ * \param str Points to the string to hash.
+ * \param len Length of the string in bytes.
+ *
+ * \return The ASCON_HASHA_SIZE bytes of the digest, the same as
+ * ascon_hasha().
+ */
+constexpr ConstDigest<ASCON_HASHA_SIZE> constHasha
+    (const char *str, size_t len)
+{
+    return ConstImpl::xof<ASCON_HASHA_SIZE>
+        (str, len, 0x00400c0400000100ULL, 4);
+}
+
+/**
+ * \brief Hashes a NUL-terminated constant string with ASCON-HASHA at
+ * compile time.
+ *
+ * \param str Points to the string to hash.  The NUL terminator is
+ * not included in the hash.
+ *
+ * \return The ASCON_HASHA_SIZE bytes of the digest, the same as
+ * ascon_hasha().
+ */
+constexpr ConstDigest<ASCON_HASHA_SIZE> constHasha(const char *str)
+{
+    return constHasha(str, ConstImpl::length(str));
+}
+
+/**
+ * \brief Hashes a constant string with ASCON-XOF at compile time.
+ *
+ * \tparam N Number of bytes of output to generate.
+ * \param str Points to the string to hash.
+ * \param len Length of the string in bytes.
+ *
+ * \return The first N bytes of output, the same as calling
+ * ascon_xof_init(), ascon_xof_absorb(), and ascon_xof_squeeze().
+ */
+template <size_t N>
+constexpr ConstDigest<N> constXof(const char *str, size_t len)
+{
+    return ConstImpl::xof<N>(str, len, 0x00400c0000000000ULL, 0);
+}
+
+/**
+ * \brief Hashes a NUL-terminated constant string with ASCON-XOF at
+ * compile time.
+ *
+ * \tparam N Number of bytes of output to generate.
+ * \param str Points to the string to hash.  The NUL terminator is
+ * not included in the hash.
+ *
+ * \return The first N bytes of output.
+ */
+template <size_t N>
+constexpr ConstDigest<N> constXof(const char *str)
+{
+    return constXof<N>(str, ConstImpl::length(str));
+}
+
+/**
+ * \brief Hashes a constant string with ASCON-XOFA at compile time.
+ *
+ * \tparam N Number of bytes of output to generate.
+ * \param str Points to the string to hash.
+ * \param len Length of the string in bytes.
+ *
+ * \return The first N bytes of output, the same as calling
+ * ascon_xofa_init(), ascon_xofa_absorb(), and ascon_xofa_squeeze().
+ */
+template <size_t N>
+constexpr ConstDigest<N> constXofa(const char *str, size_t len)
+{
+    return ConstImpl::xof<N>(str, len, 0x00400c0400000000ULL, 4);
+}
+
+/**
+ * \brief Hashes a NUL-terminated constant string with ASCON-XOFA at
+ * compile time.
+ *
+ * \tparam N Number of bytes of output to generate.
+ * \param str Points to the string to hash.  The NUL terminator is
+ * not included in the hash.
+ *
+ * \return The first N bytes of output.
+ */
+template <size_t N>
+constexpr ConstDigest<N> constXofa(const char *str)
+{
+    return constXofa<N>(str, ConstImpl::length(str));
+}
+
+} /* namespace Ascon */
+
+#endif /* C++14 */
+
+#endif
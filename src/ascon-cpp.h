@@ -0,0 +1,613 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_CPP_H
+#define ASCON_CPP_H
+
+/**
+ * \file ascon-cpp.h
+ * \brief C++ template interface to the ASCON algorithms.
+ *
+ * The classes in this file are thin wrappers around the C API's.
+ * Each algorithm variant is described by a traits class such as
+ * Ascon::ASCON128a that binds the key size, rate, round counts, and
+ * implementation functions at compile time.  The templates then
+ * dispatch directly to the variant's functions with no runtime selection:
+ *
+ * \code
+ * Ascon::Aead<Ascon::ASCON128a> cipher;
+ * cipher.start(nonce, key, ad, adlen);
+ * cipher.encrypt(in, out, len);
+ * cipher.encryptFinalize(tag);
+ * \endcode
+ *
+ * The objects free their state automatically when they go out of scope,
+ * so it is not necessary to call the matching ascon_*_free() or
+ * ascon_*_abort() function when an operation is abandoned part-way through.
+ *
+ * This header is included by ASCON.h when compiling for C++.
+ */
+
+#include "ascon-aead.h"
+#include "ascon-hash.h"
+#include "ascon-permutation.h"
+#include "ascon-xof.h"
+
+#ifdef __cplusplus
+
+namespace Ascon
+{
+
+/**
+ * \brief Defines a traits class for one of the AEAD variants.
+ *
+ * \param name Name of the traits class.
+ * \param prefix Prefix on the C function names; e.g. ascon128.
+ * \param state Type of the incremental state; e.g. ascon128_state_t.
+ * \param key_size Size of the key in bytes.
+ * \param rate Rate of absorbing and squeezing in bytes.
+ * \param rounds_b Number of rounds between data blocks.
+ */
+#define ASCON_CPP_AEAD_TRAITS(name, prefix, state, key_size, rate, rounds_b) \
+    struct name \
+    { \
+        typedef state State; \
+        static const size_t KeySize = key_size; \
+        static const size_t NonceSize = 16; \
+        static const size_t TagSize = 16; \
+        static const size_t Rate = rate; \
+        static const unsigned RoundsA = 12; \
+        static const unsigned RoundsB = rounds_b; \
+        static void encrypt \
+            (unsigned char *c, size_t *clen, \
+             const unsigned char *m, size_t mlen, \
+             const unsigned char *ad, size_t adlen, \
+             const unsigned char *npub, const unsigned char *k) \
+        { \
+            prefix##_aead_encrypt(c, clen, m, mlen, ad, adlen, npub, k); \
+        } \
+        static int decrypt \
+            (unsigned char *m, size_t *mlen, \
+             const unsigned char *c, size_t clen, \
+             const unsigned char *ad, size_t adlen, \
+             const unsigned char *npub, const unsigned char *k) \
+        { \
+            return prefix##_aead_decrypt \
+                (m, mlen, c, clen, ad, adlen, npub, k); \
+        } \
+        static void start \
+            (State *s, const unsigned char *ad, size_t adlen, \
+             const unsigned char *npub, const unsigned char *k) \
+        { \
+            prefix##_aead_start(s, ad, adlen, npub, k); \
+        } \
+        static void startAuthData \
+            (State *s, const unsigned char *npub, const unsigned char *k) \
+        { \
+            prefix##_aead_start_ad(s, npub, k); \
+        } \
+        static void addAuthData \
+            (State *s, const unsigned char *ad, size_t adlen) \
+        { \
+            prefix##_aead_ad_update(s, ad, adlen); \
+        } \
+        static void finishAuthData(State *s) \
+        { \
+            prefix##_aead_ad_finish(s); \
+        } \
+        static void abort(State *s) { prefix##_aead_abort(s); } \
+        static void encryptBlock \
+            (State *s, const unsigned char *in, unsigned char *out, \
+             size_t len) \
+        { \
+            prefix##_aead_encrypt_block(s, in, out, len); \
+        } \
+        static void encryptFinalize(State *s, unsigned char *tag) \
+        { \
+            prefix##_aead_encrypt_finalize(s, tag); \
+        } \
+        static void decryptBlock \
+            (State *s, const unsigned char *in, unsigned char *out, \
+             size_t len) \
+        { \
+            prefix##_aead_decrypt_block(s, in, out, len); \
+        } \
+        static int decryptFinalize(State *s, const unsigned char *tag) \
+        { \
+            return prefix##_aead_decrypt_finalize(s, tag); \
+        } \
+    }
+
+/**
+ * \brief Defines a traits class for one of the hash or XOF variants.
+ *
+ * \param name Name of the traits class.
+ * \param prefix Prefix on the C function names; e.g. ascon_xof.
+ * \param state Type of the incremental state; e.g. ascon_xof_state_t.
+ * \param rounds_b Number of rounds between data blocks.
+ */
+#define ASCON_CPP_HASH_TRAITS(name, prefix, state, rounds_b) \
+    struct name \
+    { \
+        typedef state State; \
+        static const size_t HashSize = ASCON_HASH_SIZE; \
+        static const size_t Rate = ASCON_XOF_RATE; \
+        static const unsigned RoundsA = 12; \
+        static const unsigned RoundsB = rounds_b; \
+        static void hash \
+            (unsigned char *out, const unsigned char *in, size_t inlen) \
+        { \
+            prefix(out, in, inlen); \
+        } \
+        static void init(State *s) { prefix##_init(s); } \
+        static void reinit(State *s) { prefix##_reinit(s); } \
+        ASCON_CPP_HASH_TRAITS_INIT_FIXED(prefix) \
+        static void free(State *s) { prefix##_free(s); } \
+        static void copy(State *dest, const State *src) \
+        { \
+            prefix##_copy(dest, src); \
+        } \
+        ASCON_CPP_HASH_TRAITS_OPS(prefix) \
+    }
+
+/* Operations that differ between the hash and XOF variants */
+#define ASCON_CPP_HASH_TRAITS_INIT_FIXED(prefix)
+#define ASCON_CPP_HASH_TRAITS_OPS(prefix) \
+    static void update(State *s, const unsigned char *in, size_t inlen) \
+    { \
+        prefix##_update(s, in, inlen); \
+    } \
+    static void finalize(State *s, unsigned char *out) \
+    { \
+        prefix##_finalize(s, out); \
+    }
+
+/** \brief Traits for ASCON-128 */
+ASCON_CPP_AEAD_TRAITS(ASCON128, ascon128, ascon128_state_t,
+                      ASCON128_KEY_SIZE, ASCON128_RATE, 6);
+
+/** \brief Traits for ASCON-128a */
+ASCON_CPP_AEAD_TRAITS(ASCON128a, ascon128a, ascon128a_state_t,
+                      ASCON128_KEY_SIZE, ASCON128A_RATE, 8);
+
+/** \brief Traits for ASCON-80pq */
+ASCON_CPP_AEAD_TRAITS(ASCON80pq, ascon80pq, ascon80pq_state_t,
+                      ASCON80PQ_KEY_SIZE, ASCON80PQ_RATE, 6);
+
+/** \brief Traits for ASCON-HASH */
+ASCON_CPP_HASH_TRAITS(HASH, ascon_hash, ascon_hash_state_t, 12);
+
+/** \brief Traits for ASCON-HASHA */
+ASCON_CPP_HASH_TRAITS(HASHA, ascon_hasha, ascon_hasha_state_t, 8);
+
+#undef ASCON_CPP_HASH_TRAITS_INIT_FIXED
+#undef ASCON_CPP_HASH_TRAITS_OPS
+#define ASCON_CPP_HASH_TRAITS_INIT_FIXED(prefix) \
+    static void initFixed(State *s, size_t outlen) \
+    { \
+        prefix##_init_fixed(s, outlen); \
+    }
+#define ASCON_CPP_HASH_TRAITS_OPS(prefix) \
+    static void absorb(State *s, const unsigned char *in, size_t inlen) \
+    { \
+        prefix##_absorb(s, in, inlen); \
+    } \
+    static void squeeze(State *s, unsigned char *out, size_t outlen) \
+    { \
+        prefix##_squeeze(s, out, outlen); \
+    }
+
+/** \brief Traits for ASCON-XOF */
+ASCON_CPP_HASH_TRAITS(XOF, ascon_xof, ascon_xof_state_t, 12);
+
+/** \brief Traits for ASCON-XOFA */
+ASCON_CPP_HASH_TRAITS(XOFA, ascon_xofa, ascon_xofa_state_t, 8);
+
+#undef ASCON_CPP_AEAD_TRAITS
+#undef ASCON_CPP_HASH_TRAITS
+#undef ASCON_CPP_HASH_TRAITS_INIT_FIXED
+#undef ASCON_CPP_HASH_TRAITS_OPS
+
+/**
+ * \brief Authenticated encryption with one of the ASCON AEAD variants.
+ *
+ * \tparam Variant Traits class for the variant: ASCON128, ASCON128a,
+ * or ASCON80pq.
+ *
+ * The static encrypt() and decrypt() functions process entire packets.
+ * The other member functions wrap the incremental API for the variant.
+ * If the object is destroyed or restarted before the incremental
+ * operation is finalized, then the operation is aborted.
+ */
+template <typename Variant>
+class Aead
+{
+public:
+    /** \brief Size of the key in bytes */
+    static const size_t KeySize = Variant::KeySize;
+
+    /** \brief Size of the nonce in bytes */
+    static const size_t NonceSize = Variant::NonceSize;
+
+    /** \brief Size of the authentication tag in bytes */
+    static const size_t TagSize = Variant::TagSize;
+
+    /** \brief Rate of absorbing and squeezing in bytes */
+    static const size_t Rate = Variant::Rate;
+
+    /** \brief Constructs a new AEAD object with no operation in progress */
+    Aead() : active(false) {}
+
+    /** \brief Destroys this AEAD object, aborting any active operation */
+    ~Aead() { abort(); }
+
+    /**
+     * \brief Encrypts and authenticates a packet.
+     *
+     * The parameters are the same as for ascon128_aead_encrypt().
+     */
+    static void encrypt
+        (unsigned char *c, size_t *clen,
+         const unsigned char *m, size_t mlen,
+         const unsigned char *ad, size_t adlen,
+         const unsigned char *npub, const unsigned char *k)
+    {
+        Variant::encrypt(c, clen, m, mlen, ad, adlen, npub, k);
+    }
+
+    /**
+     * \brief Decrypts and authenticates a packet.
+     *
+     * The parameters and return value are the same as for
+     * ascon128_aead_decrypt().
+     */
+    static int decrypt
+        (unsigned char *m, size_t *mlen,
+         const unsigned char *c, size_t clen,
+         const unsigned char *ad, size_t adlen,
+         const unsigned char *npub, const unsigned char *k)
+    {
+        return Variant::decrypt(m, mlen, c, clen, ad, adlen, npub, k);
+    }
+
+    /**
+     * \brief Starts an incremental operation with all associated data
+     * supplied up front.
+     *
+     * \param npub Points to the nonce, NonceSize bytes in length.
+     * \param k Points to the key, KeySize bytes in length.
+     * \param ad Points to the associated data.
+     * \param adlen Number of bytes of associated data.
+     */
+    void start(const unsigned char *npub, const unsigned char *k,
+               const unsigned char *ad = 0, size_t adlen = 0)
+    {
+        abort();
+        Variant::start(&state, ad, adlen, npub, k);
+        active = true;
+    }
+
+    /**
+     * \brief Starts an incremental operation with associated data to be
+     * supplied by addAuthData().
+     *
+     * \param npub Points to the nonce, NonceSize bytes in length.
+     * \param k Points to the key, KeySize bytes in length.
+     *
+     * \sa addAuthData(), finishAuthData()
+     */
+    void startAuthData(const unsigned char *npub, const unsigned char *k)
+    {
+        abort();
+        Variant::startAuthData(&state, npub, k);
+        active = true;
+    }
+
+    /**
+     * \brief Adds more associated data to an operation that was started
+     * with startAuthData().
+     */
+    void addAuthData(const unsigned char *ad, size_t adlen)
+    {
+        Variant::addAuthData(&state, ad, adlen);
+    }
+
+    /** \brief Finishes the associated data from startAuthData() */
+    void finishAuthData() { Variant::finishAuthData(&state); }
+
+    /** \brief Encrypts a block of plaintext */
+    void encrypt(const unsigned char *in, unsigned char *out, size_t len)
+    {
+        Variant::encryptBlock(&state, in, out, len);
+    }
+
+    /**
+     * \brief Finalizes an encryption operation.
+     *
+     * \param tag Receives the TagSize bytes of the authentication tag.
+     */
+    void encryptFinalize(unsigned char *tag)
+    {
+        Variant::encryptFinalize(&state, tag);
+        active = false;
+    }
+
+    /** \brief Decrypts a block of ciphertext */
+    void decrypt(const unsigned char *in, unsigned char *out, size_t len)
+    {
+        Variant::decryptBlock(&state, in, out, len);
+    }
+
+    /**
+     * \brief Finalizes a decryption operation.
+     *
+     * \param tag Points to the TagSize bytes of the authentication tag.
+     *
+     * \return 0 if the tag is correct or -1 if the tag is incorrect.
+     */
+    int decryptFinalize(const unsigned char *tag)
+    {
+        active = false;
+        return Variant::decryptFinalize(&state, tag);
+    }
+
+    /** \brief Aborts the current operation, if any */
+    void abort()
+    {
+        if (active) {
+            Variant::abort(&state);
+            active = false;
+        }
+    }
+
+private:
+    typename Variant::State state;
+    bool active;
+
+    Aead(const Aead &);
+    Aead &operator=(const Aead &);
+};
+
+/**
+ * \brief Incremental hashing with ASCON-HASH or ASCON-HASHA.
+ *
+ * \tparam Variant Traits class for the variant: HASH or HASHA.
+ */
+template <typename Variant>
+class Hash
+{
+public:
+    /** \brief Size of the hash output in bytes */
+    static const size_t HashSize = Variant::HashSize;
+
+    /** \brief Constructs a new hash object, ready to accept input */
+    Hash() { Variant::init(&state); }
+
+    /** \brief Copies the state of another hash object */
+    Hash(const Hash &other) { Variant::copy(&state, &(other.state)); }
+
+    /** \brief Destroys this hash object */
+    ~Hash() { Variant::free(&state); }
+
+    /** \brief Hashes an entire buffer into \a out in one call */
+    static void hash(unsigned char *out, const unsigned char *in,
+                     size_t inlen)
+    {
+        Variant::hash(out, in, inlen);
+    }
+
+    /** \brief Adds more input data to the hash */
+    void update(const unsigned char *in, size_t inlen)
+    {
+        Variant::update(&state, in, inlen);
+    }
+
+    /**
+     * \brief Finalizes the hash and resets for a new hashing operation.
+     *
+     * \param out Receives the HashSize bytes of the hash value.
+     */
+    void finalize(unsigned char *out)
+    {
+        Variant::finalize(&state, out);
+        Variant::reinit(&state);
+    }
+
+    /** \brief Discards all input and restarts the hashing operation */
+    void reset() { Variant::reinit(&state); }
+
+private:
+    typename Variant::State state;
+
+    Hash &operator=(const Hash &);
+};
+
+/**
+ * \brief Incremental extensible output with ASCON-XOF or ASCON-XOFA.
+ *
+ * \tparam Variant Traits class for the variant: XOF or XOFA.
+ */
+template <typename Variant>
+class Xof
+{
+public:
+    /** \brief Rate of absorbing and squeezing in bytes */
+    static const size_t Rate = Variant::Rate;
+
+    /**
+     * \brief Constructs a new XOF object.
+     *
+     * \param outlen Fixed output length in bytes, or zero for
+     * arbitrary-length output.
+     */
+    explicit Xof(size_t outlen = 0) { Variant::initFixed(&state, outlen); }
+
+    /** \brief Copies the state of another XOF object */
+    Xof(const Xof &other) { Variant::copy(&state, &(other.state)); }
+
+    /** \brief Destroys this XOF object */
+    ~Xof() { Variant::free(&state); }
+
+    /** \brief Absorbs more input data into the XOF state */
+    void absorb(const unsigned char *in, size_t inlen)
+    {
+        Variant::absorb(&state, in, inlen);
+    }
+
+    /** \brief Squeezes output data from the XOF state */
+    void squeeze(unsigned char *out, size_t outlen)
+    {
+        Variant::squeeze(&state, out, outlen);
+    }
+
+    /**
+     * \brief Restarts the XOF operation.
+     *
+     * \param outlen Fixed output length in bytes, or zero for
+     * arbitrary-length output.
+     */
+    void reset(size_t outlen = 0)
+    {
+        Variant::free(&state);
+        Variant::initFixed(&state, outlen);
+    }
+
+private:
+    typename Variant::State state;
+
+    Xof &operator=(const Xof &);
+};
+
+/**
+ * \brief ASCON permutation state that is initialized on construction
+ * and freed on destruction.
+ *
+ * The state is acquired after construction.  It can be released for
+ * temporary storage with release() and then re-acquired with acquire()
+ * or with a Lock object.
+ */
+class State
+{
+public:
+    /** \brief Constructs and acquires a new permutation state */
+    State() : acquired(true) { ascon_init(&state); }
+
+    /** \brief Frees the permutation state */
+    ~State()
+    {
+        acquire();
+        ascon_free(&state);
+    }
+
+    /** \brief Returns a pointer to the underlying C state */
+    ascon_state_t *get() { return &state; }
+
+    /** \brief Permutes the state, starting at round \a first_round */
+    void permute(uint8_t first_round) { ascon_permute(&state, first_round); }
+
+    /** \brief Releases the state for temporary storage */
+    void release()
+    {
+        if (acquired) {
+            ascon_release(&state);
+            acquired = false;
+        }
+    }
+
+    /** \brief Re-acquires the state after a call to release() */
+    void acquire()
+    {
+        if (!acquired) {
+            ascon_acquire(&state);
+            acquired = true;
+        }
+    }
+
+private:
+    ascon_state_t state;
+    bool acquired;
+
+    State(const State &);
+    State &operator=(const State &);
+};
+
+/**
+ * \brief Acquires a permutation state for the lifetime of the object
+ * and then releases it again.
+ *
+ * \code
+ * Ascon::State state;
+ * state.release();
+ * ...
+ * {
+ *     Ascon::Lock lock(state);
+ *     state.permute(0);
+ * }
+ * \endcode
+ */
+class Lock
+{
+public:
+    /** \brief Acquires \a state */
+    explicit Lock(State &state) : s(state) { s.acquire(); }
+
+    /** \brief Releases the state */
+    ~Lock() { s.release(); }
+
+private:
+    State &s;
+
+    Lock(const Lock &);
+    Lock &operator=(const Lock &);
+};
+
+/**
+ * \brief Holds an acquire/release scope on a permutation state for the
+ * lifetime of the object.
+ *
+ * \sa ascon_acquire_scope()
+ */
+class Scope
+{
+public:
+    /** \brief Starts an acquire/release scope for \a state */
+    explicit Scope(ascon_state_t *state) : s(state)
+    {
+        ascon_acquire_scope(s);
+    }
+
+    /** \brief Ends the scope, if it has not already ended */
+    ~Scope() { ascon_release_scope(s); }
+
+private:
+    ascon_state_t *s;
+
+    Scope(const Scope &);
+    Scope &operator=(const Scope &);
+};
+
+} /* namespace Ascon */
+
+#endif /* __cplusplus */
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "ascon-config.h"
+#include "ascon-hash.h"
+#include "utility/ascon-util.h"
+
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Offset of the input offset within a checkpoint.
+ */
+#define ASCON_CHECKPOINT_OFFSET ASCON_XOF_SNAPSHOT_SIZE
+
+/**
+ * \brief Offset of the check value within a checkpoint.
+ */
+#define ASCON_CHECKPOINT_CHECK (ASCON_XOF_SNAPSHOT_SIZE + 8)
+
+/**
+ * \brief Computes the check value for a checkpoint.
+ *
+ * \param check Returns the 8 byte check value.
+ * \param checkpoint Points to the checkpoint.
+ *
+ * The check value is the first 8 bytes of ASCON-XOF over the snapshot
+ * and the offset.  It is not keyed; it only needs to detect a checkpoint
+ * that was torn by a power failure part-way through writing it.
+ */
+static void ascon_checkpoint_check
+    (unsigned char *check, const unsigned char *checkpoint)
+{
+    ascon_xof_state_t xof;
+    ascon_xof_init_fixed(&xof, 8);
+    ascon_xof_absorb(&xof, checkpoint, ASCON_CHECKPOINT_CHECK);
+    ascon_xof_squeeze(&xof, check, 8);
+    ascon_xof_free(&xof);
+}
+
+/**
+ * \brief Finishes a checkpoint after the snapshot has been written.
+ *
+ * \param offset Offset of the next input byte.
+ * \param checkpoint Points to the checkpoint.
+ */
+static void ascon_checkpoint_finish(uint64_t offset, unsigned char *checkpoint)
+{
+    le_store_word64(checkpoint + ASCON_CHECKPOINT_OFFSET, offset);
+    ascon_checkpoint_check(checkpoint + ASCON_CHECKPOINT_CHECK, checkpoint);
+}
+
+/**
+ * \brief Verifies the check value on a checkpoint.
+ *
+ * \param checkpoint Points to the checkpoint.
+ *
+ * \return Non-zero if the check value is correct, zero if not.
+ */
+static int ascon_checkpoint_verify(const unsigned char *checkpoint)
+{
+    unsigned char check[8];
+    unsigned char diff = 0;
+    unsigned index;
+    ascon_checkpoint_check(check, checkpoint);
+    for (index = 0; index < 8; ++index)
+        diff |= check[index] ^ checkpoint[ASCON_CHECKPOINT_CHECK + index];
+    return diff == 0;
+}
+
+void ascon_hash_checkpoint
+    (ascon_hash_state_t *state, uint64_t offset, unsigned char *checkpoint)
+{
+    ascon_xof_snapshot(&(state->xof), checkpoint);
+    ascon_checkpoint_finish(offset, checkpoint);
+}
+
+int ascon_hash_resume
+    (ascon_hash_state_t *state, uint64_t *offset,
+     const unsigned char *checkpoint)
+{
+    if (!ascon_checkpoint_verify(checkpoint))
+        return -1;
+    if (ascon_xof_restore(&(state->xof), checkpoint) < 0)
+        return -1;
+    *offset = le_load_word64(checkpoint + ASCON_CHECKPOINT_OFFSET);
+    return 0;
+}
+
+void ascon_hasha_checkpoint
+    (ascon_hasha_state_t *state, uint64_t offset, unsigned char *checkpoint)
+{
+    ascon_xofa_snapshot(&(state->xof), checkpoint);
+    ascon_checkpoint_finish(offset, checkpoint);
+}
+
+int ascon_hasha_resume
+    (ascon_hasha_state_t *state, uint64_t *offset,
+     const unsigned char *checkpoint)
+{
+    if (!ascon_checkpoint_verify(checkpoint))
+        return -1;
+    if (ascon_xofa_restore(&(state->xof), checkpoint) < 0)
+        return -1;
+    *offset = le_load_word64(checkpoint + ASCON_CHECKPOINT_OFFSET);
+    return 0;
+}
+
+#endif /* ASCON_ENABLE_HASH */
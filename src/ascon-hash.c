@@ -20,21 +20,38 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-hash.h"
+#include "ascon-latency.h"
 #include "utility/ascon-util-snp.h"
 #include <string.h>
 
+#if ASCON_ENABLE_HASH
+
 void ascon_hash(unsigned char *out, const unsigned char *in, size_t inlen)
 {
     ascon_hash_state_t state;
-    ascon_hash_init(&state);
-    ascon_xof_absorb(&(state.xof), in, inlen);
-    ascon_xof_squeeze(&(state.xof), out, ASCON_HASH_SIZE);
-    ascon_xof_free(&(state.xof));
+    ascon_hash_ex(out, in, inlen, &state);
+}
+
+void ascon_hash_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_hash_state_t *workspace)
+{
+    ascon_latency_begin();
+    ascon_hash_init(workspace);
+    ascon_xof_absorb(&(workspace->xof), in, inlen);
+    ascon_xof_squeeze(&(workspace->xof), out, ASCON_HASH_SIZE);
+    ascon_xof_free(&(workspace->xof));
+    ascon_latency_end(ASCON_LATENCY_HASH);
 }
 
 void ascon_hash_init(ascon_hash_state_t *state)
 {
+#if defined(ASCON_SMALL)
+    /* Compute the IV at runtime to avoid storing it */
+    ascon_xof_init_fixed(&(state->xof), ASCON_HASH_SIZE);
+#else
     /* IV for ASCON-HASH after processing it with the permutation */
 #if defined(ASCON_BACKEND_SLICED64)
     static uint64_t const iv[5] = {
@@ -68,6 +85,7 @@ void ascon_hash_init(ascon_hash_state_t *state)
 #endif
     state->xof.count = 0;
     state->xof.mode = 0;
+#endif
 }
 
 void ascon_hash_reinit(ascon_hash_state_t *state)
@@ -101,3 +119,22 @@ void ascon_hash_copy(ascon_hash_state_t *dest, const ascon_hash_state_t *src)
 {
     ascon_xof_copy(&(dest->xof), &(src->xof));
 }
+
+void ascon_hash_reset
+    (ascon_hash_state_t *state, const ascon_hash_state_t *tmpl)
+{
+    ascon_xof_reset(&(state->xof), &(tmpl->xof));
+}
+
+void ascon_hash_snapshot(ascon_hash_state_t *state, unsigned char *snapshot)
+{
+    ascon_xof_snapshot(&(state->xof), snapshot);
+}
+
+int ascon_hash_restore
+    (ascon_hash_state_t *state, const unsigned char *snapshot)
+{
+    return ascon_xof_restore(&(state->xof), snapshot);
+}
+
+#endif /* ASCON_ENABLE_HASH */
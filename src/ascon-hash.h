@@ -66,6 +66,23 @@ typedef struct
  */
 void ascon_hash(unsigned char *out, const unsigned char *in, size_t inlen);
 
+/**
+ * \brief Hashes a block of input data with ASCON-HASH using a caller-provided
+ * workspace instead of a state on the stack.
+ *
+ * \param out Buffer to receive the hash output which must be at least
+ * ASCON_HASH_SIZE bytes in length.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ * \param workspace Points to the state to use while hashing, which
+ * is freed before the function returns.
+ *
+ * \sa ascon_hash()
+ */
+void ascon_hash_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_hash_state_t *workspace);
+
 /**
  * \brief Initializes the state for an ASCON-HASH hashing operation.
  *
@@ -129,6 +146,123 @@ void ascon_hash_finalize(ascon_hash_state_t *state, unsigned char *out);
 void ascon_hash_copy
     (ascon_hash_state_t *dest, const ascon_hash_state_t *src);
 
+/**
+ * \brief Resets an ASCON-HASH state to a copy of a template state.
+ *
+ * \param state ASCON-HASH state to be reset, which must already be initialized.
+ * \param tmpl Template state to copy, such as a state that was saved just
+ * after initialization.
+ *
+ * Unlike ascon_hash_copy(), this reuses the destination without freeing and
+ * initializing it again, so a context can be recycled cheaply between
+ * messages in a tight loop.
+ *
+ * \sa ascon_hash_copy()
+ */
+void ascon_hash_reset
+    (ascon_hash_state_t *state, const ascon_hash_state_t *tmpl);
+
+/**
+ * \brief Saves a serialized snapshot of an ASCON-HASH state.
+ *
+ * \param state Hash state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \sa ascon_hash_restore(), ascon_xof_snapshot()
+ */
+void ascon_hash_snapshot(ascon_hash_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-HASH state from a serialized snapshot.
+ *
+ * \param state Hash state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not valid.
+ *
+ * \sa ascon_hash_snapshot()
+ */
+int ascon_hash_restore
+    (ascon_hash_state_t *state, const unsigned char *snapshot);
+
+/**
+ * \brief Size of a checkpoint for resuming an ASCON-HASH or ASCON-HASHA
+ * computation after an interruption.
+ *
+ * A checkpoint is made up of the ASCON_XOF_SNAPSHOT_SIZE byte snapshot,
+ * the 8 byte input offset in little-endian byte order, and an 8 byte
+ * check value that detects checkpoints that were only partially written.
+ */
+#define ASCON_HASH_CHECKPOINT_SIZE (ASCON_XOF_SNAPSHOT_SIZE + 16)
+
+/**
+ * \brief Saves a checkpoint of an ASCON-HASH state together with the
+ * number of input bytes that have been absorbed so far.
+ *
+ * \param state Hash state to checkpoint.
+ * \param offset Offset of the next input byte to be absorbed.
+ * \param checkpoint Buffer to receive the checkpoint, which must be at
+ * least ASCON_HASH_CHECKPOINT_SIZE bytes in length.
+ *
+ * This is intended for hashing large images in slow storage, such as a
+ * bootloader verifying firmware in SPI flash.  The checkpoint can be
+ * written to non-volatile memory every so often so that if power is lost,
+ * hashing can continue from the last checkpoint with ascon_hash_resume()
+ * rather than from the start of the image.  The checkpoint does not
+ * depend upon the back end, so it is still valid after the back end has
+ * changed.
+ *
+ * \sa ascon_hash_resume(), ascon_hash_snapshot()
+ */
+void ascon_hash_checkpoint
+    (ascon_hash_state_t *state, uint64_t offset, unsigned char *checkpoint);
+
+/**
+ * \brief Resumes an ASCON-HASH computation from a checkpoint.
+ *
+ * \param state Hash state to be initialized from the checkpoint.
+ * \param offset Returns the offset of the next input byte to be absorbed.
+ * \param checkpoint Points to the checkpoint, which must be
+ * ASCON_HASH_CHECKPOINT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the checkpoint is not valid, either
+ * because it was only partially written or because it is not an
+ * ASCON-HASH checkpoint.  The \a state is not initialized and \a offset
+ * is not modified if -1 is returned, so hashing should start again from
+ * the beginning of the input.
+ *
+ * The \a state will be initialized by this operation, so it must
+ * not previously have been initialized or it has already been freed.
+ *
+ * \sa ascon_hash_checkpoint()
+ */
+int ascon_hash_resume
+    (ascon_hash_state_t *state, uint64_t *offset,
+     const unsigned char *checkpoint);
+
+/**
+ * \brief Hashes a batch of independent messages with ASCON-HASH.
+ *
+ * \param out Buffer to receive the hash outputs, which must be at least
+ * \a count * ASCON_HASH_SIZE bytes in length.  The output for message i
+ * starts at offset i * ASCON_HASH_SIZE.
+ * \param in Array of pointers to the messages to be hashed.
+ * \param inlen Array of message lengths in bytes.
+ * \param count Number of messages to be hashed.
+ *
+ * The output for each message is the same as if ascon_hash() had been
+ * called on the message separately.  The messages may have different
+ * lengths.  On back ends that can permute several states at once,
+ * the messages are processed side by side.
+ *
+ * \sa ascon_hash()
+ */
+void ascon_hash_many
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count);
+
 /**
  * \brief Hashes a block of input data with ASCON-HASHA.
  *
@@ -141,6 +275,23 @@ void ascon_hash_copy
  */
 void ascon_hasha(unsigned char *out, const unsigned char *in, size_t inlen);
 
+/**
+ * \brief Hashes a block of input data with ASCON-HASHA using a caller-provided
+ * workspace instead of a state on the stack.
+ *
+ * \param out Buffer to receive the hash output which must be at least
+ * ASCON_HASH_SIZE bytes in length.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ * \param workspace Points to the state to use while hashing, which
+ * is freed before the function returns.
+ *
+ * \sa ascon_hasha()
+ */
+void ascon_hasha_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_hasha_state_t *workspace);
+
 /**
  * \brief Initializes the state for an ASCON-HASHA hashing operation.
  *
@@ -204,6 +355,99 @@ void ascon_hasha_finalize(ascon_hasha_state_t *state, unsigned char *out);
 void ascon_hasha_copy
     (ascon_hasha_state_t *dest, const ascon_hasha_state_t *src);
 
+/**
+ * \brief Resets an ASCON-HASHA state to a copy of a template state.
+ *
+ * \param state ASCON-HASHA state to be reset, which must already be initialized.
+ * \param tmpl Template state to copy, such as a state that was saved just
+ * after initialization.
+ *
+ * Unlike ascon_hasha_copy(), this reuses the destination without freeing and
+ * initializing it again, so a context can be recycled cheaply between
+ * messages in a tight loop.
+ *
+ * \sa ascon_hasha_copy()
+ */
+void ascon_hasha_reset
+    (ascon_hasha_state_t *state, const ascon_hasha_state_t *tmpl);
+
+/**
+ * \brief Saves a serialized snapshot of an ASCON-HASHA state.
+ *
+ * \param state Hash state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \sa ascon_hasha_restore(), ascon_xofa_snapshot()
+ */
+void ascon_hasha_snapshot(ascon_hasha_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-HASHA state from a serialized snapshot.
+ *
+ * \param state Hash state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not valid.
+ *
+ * \sa ascon_hasha_snapshot()
+ */
+int ascon_hasha_restore
+    (ascon_hasha_state_t *state, const unsigned char *snapshot);
+
+/**
+ * \brief Saves a checkpoint of an ASCON-HASHA state together with the
+ * number of input bytes that have been absorbed so far.
+ *
+ * \param state Hash state to checkpoint.
+ * \param offset Offset of the next input byte to be absorbed.
+ * \param checkpoint Buffer to receive the checkpoint, which must be at
+ * least ASCON_HASH_CHECKPOINT_SIZE bytes in length.
+ *
+ * \sa ascon_hasha_resume(), ascon_hash_checkpoint()
+ */
+void ascon_hasha_checkpoint
+    (ascon_hasha_state_t *state, uint64_t offset, unsigned char *checkpoint);
+
+/**
+ * \brief Resumes an ASCON-HASHA computation from a checkpoint.
+ *
+ * \param state Hash state to be initialized from the checkpoint.
+ * \param offset Returns the offset of the next input byte to be absorbed.
+ * \param checkpoint Points to the checkpoint, which must be
+ * ASCON_HASH_CHECKPOINT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the checkpoint is not a valid
+ * ASCON-HASHA checkpoint.
+ *
+ * \sa ascon_hasha_checkpoint()
+ */
+int ascon_hasha_resume
+    (ascon_hasha_state_t *state, uint64_t *offset,
+     const unsigned char *checkpoint);
+
+/**
+ * \brief Hashes a batch of independent messages with ASCON-HASHA.
+ *
+ * \param out Buffer to receive the hash outputs, which must be at least
+ * \a count * ASCON_HASHA_SIZE bytes in length.  The output for message i
+ * starts at offset i * ASCON_HASHA_SIZE.
+ * \param in Array of pointers to the messages to be hashed.
+ * \param inlen Array of message lengths in bytes.
+ * \param count Number of messages to be hashed.
+ *
+ * The output for each message is the same as if ascon_hasha() had been
+ * called on the message separately.  The messages may have different
+ * lengths.  On back ends that can permute several states at once,
+ * the messages are processed side by side.
+ *
+ * \sa ascon_hasha()
+ */
+void ascon_hasha_many
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
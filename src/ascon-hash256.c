@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "ascon-config.h"
+#include "ascon-latency.h"
+#include "ascon-sp800-232.h"
+#include "utility/ascon-util-snp.h"
+#include <string.h>
+
+#if ASCON_ENABLE_HASH
+
+#if defined(ASCON_SMALL)
+
+/**
+ * \brief Initialization vector for Ascon-Hash256.
+ */
+#define ASCON_HASH256_IV 0x0000080100cc0002ULL
+
+#else
+
+/* Initial state for Ascon-Hash256 after processing the IV with
+ * the permutation */
+#if defined(ASCON_BACKEND_SLICED64)
+static uint64_t const ascon_hash256_iv[5] = {
+    0x9b1e5494e934d681ULL, 0x4bc3a01e333751d2ULL,
+    0xae65396c6b34b81aULL, 0x3c7fd4a4d56a4db3ULL,
+    0x1a5c464906c5976dULL
+};
+#elif defined(ASCON_BACKEND_SLICED32)
+static uint32_t const ascon_hash256_iv[10] = {
+    0x56e696e1, 0xb308e498, 0x990657dc, 0x39c35509,
+    0x2b5a9644, 0xf46674e3, 0x6fe2f8b5, 0x678c872d,
+    0x4ea92b7b, 0x32121896
+};
+#else
+static uint8_t const ascon_hash256_iv[40] = {
+    0x9b, 0x1e, 0x54, 0x94, 0xe9, 0x34, 0xd6, 0x81,
+    0x4b, 0xc3, 0xa0, 0x1e, 0x33, 0x37, 0x51, 0xd2,
+    0xae, 0x65, 0x39, 0x6c, 0x6b, 0x34, 0xb8, 0x1a,
+    0x3c, 0x7f, 0xd4, 0xa4, 0xd5, 0x6a, 0x4d, 0xb3,
+    0x1a, 0x5c, 0x46, 0x49, 0x06, 0xc5, 0x97, 0x6d
+};
+#endif
+
+#endif /* ASCON_SMALL */
+
+void ascon_hash256(unsigned char *out, const unsigned char *in, size_t inlen)
+{
+    ascon_hash256_state_t state;
+    ascon_latency_begin();
+    ascon_hash256_init(&state);
+    ascon_xof128_absorb(&(state.xof), in, inlen);
+    ascon_xof128_squeeze(&(state.xof), out, ASCON_HASH256_SIZE);
+    ascon_xof128_free(&(state.xof));
+    ascon_latency_end(ASCON_LATENCY_HASH);
+}
+
+void ascon_hash256_init(ascon_hash256_state_t *state)
+{
+#if defined(ASCON_SMALL)
+    /* Compute the IV at runtime to avoid storing it */
+    uint8_t iv[8];
+    ascon_init(&(state->xof.state));
+    be_store_word64(iv, ASCON_HASH256_IV);
+    ascon_overwrite_bytes(&(state->xof.state), iv, 0, 8);
+    ascon_permute(&(state->xof.state), 0);
+    ascon_release(&(state->xof.state));
+#elif defined(ASCON_BACKEND_SLICED64)
+    memcpy(state->xof.state.S, ascon_hash256_iv, sizeof(ascon_hash256_iv));
+#elif defined(ASCON_BACKEND_SLICED32)
+    memcpy(state->xof.state.W, ascon_hash256_iv, sizeof(ascon_hash256_iv));
+#elif defined(ASCON_BACKEND_DIRECT_XOR)
+    memcpy(state->xof.state.B, ascon_hash256_iv, sizeof(ascon_hash256_iv));
+#else
+    ascon_init(&(state->xof.state));
+    ascon_overwrite_bytes
+        (&(state->xof.state), ascon_hash256_iv, 0, sizeof(ascon_hash256_iv));
+    ascon_release(&(state->xof.state));
+#endif
+    state->xof.count = 0;
+    state->xof.mode = 0;
+}
+
+void ascon_hash256_free(ascon_hash256_state_t *state)
+{
+    ascon_xof128_free(&(state->xof));
+}
+
+void ascon_hash256_update
+    (ascon_hash256_state_t *state, const unsigned char *in, size_t inlen)
+{
+    ascon_xof128_absorb(&(state->xof), in, inlen);
+}
+
+void ascon_hash256_finalize
+    (ascon_hash256_state_t *state, unsigned char *out)
+{
+    ascon_xof128_squeeze(&(state->xof), out, ASCON_HASH256_SIZE);
+}
+
+void ascon_hash256_copy
+    (ascon_hash256_state_t *dest, const ascon_hash256_state_t *src)
+{
+    ascon_xof128_copy(&(dest->xof), &(src->xof));
+}
+
+void ascon_hash256_reset
+    (ascon_hash256_state_t *state, const ascon_hash256_state_t *tmpl)
+{
+    ascon_xof128_reset(&(state->xof), &(tmpl->xof));
+}
+
+#endif /* ASCON_ENABLE_HASH */
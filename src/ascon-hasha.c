@@ -20,21 +20,38 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-hash.h"
+#include "ascon-latency.h"
 #include "utility/ascon-util-snp.h"
 #include <string.h>
 
+#if ASCON_ENABLE_HASH
+
 void ascon_hasha(unsigned char *out, const unsigned char *in, size_t inlen)
 {
     ascon_hasha_state_t state;
-    ascon_hasha_init(&state);
-    ascon_xofa_absorb(&(state.xof), in, inlen);
-    ascon_xofa_squeeze(&(state.xof), out, ASCON_HASH_SIZE);
-    ascon_xofa_free(&(state.xof));
+    ascon_hasha_ex(out, in, inlen, &state);
+}
+
+void ascon_hasha_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_hasha_state_t *workspace)
+{
+    ascon_latency_begin();
+    ascon_hasha_init(workspace);
+    ascon_xofa_absorb(&(workspace->xof), in, inlen);
+    ascon_xofa_squeeze(&(workspace->xof), out, ASCON_HASH_SIZE);
+    ascon_xofa_free(&(workspace->xof));
+    ascon_latency_end(ASCON_LATENCY_HASH);
 }
 
 void ascon_hasha_init(ascon_hasha_state_t *state)
 {
+#if defined(ASCON_SMALL)
+    /* Compute the IV at runtime to avoid storing it */
+    ascon_xofa_init_fixed(&(state->xof), ASCON_HASH_SIZE);
+#else
     /* IV for ASCON-HASHA after processing it with the permutation */
 #if defined(ASCON_BACKEND_SLICED64)
     static uint64_t const iv[5] = {
@@ -68,6 +85,7 @@ void ascon_hasha_init(ascon_hasha_state_t *state)
 #endif
     state->xof.count = 0;
     state->xof.mode = 0;
+#endif
 }
 
 void ascon_hasha_reinit(ascon_hasha_state_t *state)
@@ -101,3 +119,22 @@ void ascon_hasha_copy(ascon_hasha_state_t *dest, const ascon_hasha_state_t *src)
 {
     ascon_xofa_copy(&(dest->xof), &(src->xof));
 }
+
+void ascon_hasha_reset
+    (ascon_hasha_state_t *state, const ascon_hasha_state_t *tmpl)
+{
+    ascon_xofa_reset(&(state->xof), &(tmpl->xof));
+}
+
+void ascon_hasha_snapshot(ascon_hasha_state_t *state, unsigned char *snapshot)
+{
+    ascon_xofa_snapshot(&(state->xof), snapshot);
+}
+
+int ascon_hasha_restore
+    (ascon_hasha_state_t *state, const unsigned char *snapshot)
+{
+    return ascon_xofa_restore(&(state->xof), snapshot);
+}
+
+#endif /* ASCON_ENABLE_HASH */
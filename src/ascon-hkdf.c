@@ -20,12 +20,15 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-hkdf.h"
 #include "ascon-hmac.h"
 #include "ascon-utility.h"
 #include "utility/ascon-util.h"
 #include <string.h>
 
+#if ASCON_ENABLE_HASH
+
 /* The actual implementation is in the "ascon-hkdf-common.h" file */
 
 /* ASCON-HKDF */
@@ -36,4 +39,11 @@
 #define HKDF_HMAC_INIT ascon_hmac_init
 #define HKDF_HMAC_UPDATE ascon_hmac_update
 #define HKDF_HMAC_FINALIZE ascon_hmac_finalize
+#define HKDF_HMAC_KEY ascon_hmac_key_t
+#define HKDF_HMAC_INIT_KEY ascon_hmac_init_key
+#define HKDF_HMAC_FREE_KEY ascon_hmac_free_key
+#define HKDF_HMAC_INIT_PK ascon_hmac_init_pk
+#define HKDF_HMAC_FINAL_PK ascon_hmac_finalize_pk
 #include "utility/ascon-hkdf-common.h"
+
+#endif /* ASCON_ENABLE_HASH */
@@ -80,6 +80,27 @@ typedef struct
 
 } ascon_hkdfa_state_t;
 
+/**
+ * \brief Describes a single output for ascon_hkdf_expand_many() or
+ * ascon_hkdfa_expand_many().
+ */
+typedef struct
+{
+    /** Points to the bytes of the informational data for this output */
+    const unsigned char *info;
+
+    /** Number of bytes in the informational data */
+    size_t infolen;
+
+    /** Points to the output buffer to receive the key material */
+    unsigned char *out;
+
+    /** Number of bytes of key material to generate, maximum of
+     *  ASCON_HKDF_OUTPUT_SIZE * 255 bytes */
+    size_t outlen;
+
+} ascon_hkdf_output_t;
+
 /**
  * \brief Derives key material using ASCON-HKDF.
  *
@@ -136,6 +157,30 @@ int ascon_hkdf_expand
      const unsigned char *info, size_t infolen,
      unsigned char *out, size_t outlen);
 
+/**
+ * \brief Expands several independent outputs from a ASCON-HKDF state
+ * in a single call.
+ *
+ * \param state HKDF state containing the extracted key.
+ * \param outputs Points to the list of outputs to generate, each with
+ * its own informational data.
+ * \param count Number of entries in \a outputs.
+ *
+ * \return Zero on success or -1 if one of the output lengths is out of
+ * range.  Outputs that are out of range are filled with zeroes.
+ *
+ * Each output is generated as though ascon_hkdf_expand() had been called
+ * on a freshly extracted state with the output's informational data.
+ * The key blocks for the HMAC are absorbed only once and then shared
+ * between all of the outputs, which is faster than deriving each output
+ * separately.  The \a state is not modified.
+ *
+ * \sa ascon_hkdf_expand()
+ */
+int ascon_hkdf_expand_many
+    (const ascon_hkdf_state_t *state,
+     const ascon_hkdf_output_t *outputs, size_t count);
+
 /**
  * \brief Frees all sensitive material in a ASCON-HKDF state.
  *
@@ -143,6 +188,18 @@ int ascon_hkdf_expand
  */
 void ascon_hkdf_free(ascon_hkdf_state_t *state);
 
+/**
+ * \brief Resets an ASCON-HKDF state so that the next call to
+ * ascon_hkdf_expand() starts again from the first output block.
+ *
+ * \param state Points to the HKDF state.
+ *
+ * The pseudorandom key from ascon_hkdf_extract() is kept, so the same
+ * key can be expanded again with different info strings without
+ * repeating the extract step.
+ */
+void ascon_hkdf_reset(ascon_hkdf_state_t *state);
+
 /**
  * \brief Derives key material using ASCON-HKDFA.
  *
@@ -199,6 +256,30 @@ int ascon_hkdfa_expand
      const unsigned char *info, size_t infolen,
      unsigned char *out, size_t outlen);
 
+/**
+ * \brief Expands several independent outputs from a ASCON-HKDFA state
+ * in a single call.
+ *
+ * \param state HKDF state containing the extracted key.
+ * \param outputs Points to the list of outputs to generate, each with
+ * its own informational data.
+ * \param count Number of entries in \a outputs.
+ *
+ * \return Zero on success or -1 if one of the output lengths is out of
+ * range.  Outputs that are out of range are filled with zeroes.
+ *
+ * Each output is generated as though ascon_hkdfa_expand() had been called
+ * on a freshly extracted state with the output's informational data.
+ * The key blocks for the HMAC are absorbed only once and then shared
+ * between all of the outputs, which is faster than deriving each output
+ * separately.  The \a state is not modified.
+ *
+ * \sa ascon_hkdfa_expand()
+ */
+int ascon_hkdfa_expand_many
+    (const ascon_hkdfa_state_t *state,
+     const ascon_hkdf_output_t *outputs, size_t count);
+
 /**
  * \brief Frees all sensitive material in a ASCON-HKDFA state.
  *
@@ -206,6 +287,18 @@ int ascon_hkdfa_expand
  */
 void ascon_hkdfa_free(ascon_hkdfa_state_t *state);
 
+/**
+ * \brief Resets an ASCON-HKDFA state so that the next call to
+ * ascon_hkdfa_expand() starts again from the first output block.
+ *
+ * \param state Points to the HKDF state.
+ *
+ * The pseudorandom key from ascon_hkdfa_extract() is kept, so the same
+ * key can be expanded again with different info strings without
+ * repeating the extract step.
+ */
+void ascon_hkdfa_reset(ascon_hkdfa_state_t *state);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,10 +20,13 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-hmac.h"
 #include "ascon-utility.h"
 #include <string.h>
 
+#if ASCON_ENABLE_HASH
+
 /* The actual implementation is in the "ascon-hmac-common.h" file */
 
 /* ASCON-HMAC */
@@ -31,9 +34,16 @@
 #define HMAC_HASH_SIZE ASCON_HASH_SIZE
 #define HMAC_BLOCK_SIZE 64
 #define HMAC_STATE ascon_hmac_state_t
+#define HMAC_KEY ascon_hmac_key_t
 #define HMAC_HASH_INIT ascon_hash_init
 #define HMAC_HASH_REINIT ascon_hash_reinit
 #define HMAC_HASH_FREE ascon_hash_free
 #define HMAC_HASH_UPDATE ascon_hash_update
 #define HMAC_HASH_FINALIZE ascon_hash_finalize
+#define HMAC_HASH_COPY ascon_hash_copy
+#define HMAC_HASH_RESET ascon_hash_reset
+#define HMAC_HASH_SNAPSHOT ascon_hash_snapshot
+#define HMAC_HASH_RESTORE ascon_hash_restore
 #include "utility/ascon-hmac-common.h"
+
+#endif /* ASCON_ENABLE_HASH */
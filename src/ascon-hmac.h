@@ -66,6 +66,18 @@ typedef struct
 
 } ascon_hmac_state_t;
 
+/**
+ * \brief Pre-computed key information for ASCON-HMAC.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    ascon_hash_state_t inner;    /**< Hash state after the inner key block */
+    ascon_hash_state_t outer;    /**< Hash state after the outer key block */
+
+} ascon_hmac_key_t;
+
 /**
  * \brief State information for the ASCON-HMACA incremental mode.
  */
@@ -75,6 +87,18 @@ typedef struct
 
 } ascon_hmaca_state_t;
 
+/**
+ * \brief Pre-computed key information for ASCON-HMACA.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    ascon_hasha_state_t inner;    /**< Hash state after the inner key block */
+    ascon_hasha_state_t outer;    /**< Hash state after the outer key block */
+
+} ascon_hmaca_key_t;
+
 /**
  * \brief Computes a HMAC value using ASCON-HASH.
  *
@@ -157,6 +181,119 @@ void ascon_hmac_finalize
     (ascon_hmac_state_t *state, const unsigned char *key, size_t keylen,
      unsigned char *out);
 
+/**
+ * \brief Saves a serialized snapshot of an ASCON-HMAC state.
+ *
+ * \param state HMAC state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * The snapshot is derived from the key, so it must be protected
+ * in the same way as the key itself.  The key must still be supplied
+ * to ascon_hmac_finalize() after the state is restored.
+ *
+ * \sa ascon_hmac_restore()
+ */
+void ascon_hmac_snapshot(ascon_hmac_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-HMAC state from a serialized snapshot.
+ *
+ * \param state HMAC state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not valid.
+ *
+ * \sa ascon_hmac_snapshot()
+ */
+int ascon_hmac_restore
+    (ascon_hmac_state_t *state, const unsigned char *snapshot);
+
+/**
+ * \brief Initializes a pre-computed key for ASCON-HMAC.
+ *
+ * \param pk Points to the object to receive the pre-computed key value.
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * The inner and outer key blocks are absorbed once, which saves two
+ * key block absorptions for each message when the same key is used
+ * for many messages.
+ *
+ * \sa ascon_hmac_free_key(), ascon_hmac_pk(), ascon_hmac_init_pk()
+ */
+void ascon_hmac_init_key
+    (ascon_hmac_key_t *pk, const unsigned char *key, size_t keylen);
+
+/**
+ * \brief Frees a pre-computed key for ASCON-HMAC and destroys any
+ * sensitive material.
+ *
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon_hmac_init_key()
+ */
+void ascon_hmac_free_key(ascon_hmac_key_t *pk);
+
+/**
+ * \brief Computes a HMAC value using ASCON-HMAC and a pre-computed key.
+ *
+ * \param out Buffer to receive the output HMAC value; must be at least
+ * ASCON_HMAC_SIZE bytes in length.
+ * \param pk Points to the pre-computed key value.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ *
+ * \sa ascon_hmac_init_key()
+ */
+void ascon_hmac_pk
+    (unsigned char *out, const ascon_hmac_key_t *pk,
+     const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Initializes an incremental HMAC state using ASCON-HMAC and a
+ * pre-computed key.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon_hmac_update(), ascon_hmac_finalize_pk()
+ */
+void ascon_hmac_init_pk
+    (ascon_hmac_state_t *state, const ascon_hmac_key_t *pk);
+
+/**
+ * \brief Resets an incremental ASCON-HMAC state back to the start of a
+ * new message using a pre-computed key.
+ *
+ * \param state Points to the state to be reset, which must already
+ * be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * Unlike ascon_hmac_reinit(), the key is not absorbed again and the
+ * state is not freed and initialized again.
+ *
+ * \sa ascon_hmac_init_pk(), ascon_hmac_finalize_pk()
+ */
+void ascon_hmac_reset
+    (ascon_hmac_state_t *state, const ascon_hmac_key_t *pk);
+
+/**
+ * \brief Finalizes an incremental ASCON-HMAC state that was initialized
+ * with a pre-computed key.
+ *
+ * \param state HMAC state to squeeze the output data from.
+ * \param pk Points to the pre-computed key value.
+ * \param out Points to the output buffer to receive the HMAC value;
+ * must be at least ASCON_HMAC_SIZE bytes in length.
+ *
+ * \sa ascon_hmac_init_pk(), ascon_hmac_update()
+ */
+void ascon_hmac_finalize_pk
+    (ascon_hmac_state_t *state, const ascon_hmac_key_t *pk,
+     unsigned char *out);
+
 /**
  * \brief Computes a HMAC value using ASCON-HASHA.
  *
@@ -239,6 +376,119 @@ void ascon_hmaca_finalize
     (ascon_hmaca_state_t *state, const unsigned char *key, size_t keylen,
      unsigned char *out);
 
+/**
+ * \brief Saves a serialized snapshot of an ASCON-HMACA state.
+ *
+ * \param state HMAC state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * The snapshot is derived from the key, so it must be protected
+ * in the same way as the key itself.  The key must still be supplied
+ * to ascon_hmaca_finalize() after the state is restored.
+ *
+ * \sa ascon_hmaca_restore()
+ */
+void ascon_hmaca_snapshot(ascon_hmaca_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-HMACA state from a serialized snapshot.
+ *
+ * \param state HMAC state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not valid.
+ *
+ * \sa ascon_hmaca_snapshot()
+ */
+int ascon_hmaca_restore
+    (ascon_hmaca_state_t *state, const unsigned char *snapshot);
+
+/**
+ * \brief Initializes a pre-computed key for ASCON-HMACA.
+ *
+ * \param pk Points to the object to receive the pre-computed key value.
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * The inner and outer key blocks are absorbed once, which saves two
+ * key block absorptions for each message when the same key is used
+ * for many messages.
+ *
+ * \sa ascon_hmaca_free_key(), ascon_hmaca_pk(), ascon_hmaca_init_pk()
+ */
+void ascon_hmaca_init_key
+    (ascon_hmaca_key_t *pk, const unsigned char *key, size_t keylen);
+
+/**
+ * \brief Frees a pre-computed key for ASCON-HMACA and destroys any
+ * sensitive material.
+ *
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon_hmaca_init_key()
+ */
+void ascon_hmaca_free_key(ascon_hmaca_key_t *pk);
+
+/**
+ * \brief Computes a HMAC value using ASCON-HMACA and a pre-computed key.
+ *
+ * \param out Buffer to receive the output HMAC value; must be at least
+ * ASCON_HMACA_SIZE bytes in length.
+ * \param pk Points to the pre-computed key value.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ *
+ * \sa ascon_hmaca_init_key()
+ */
+void ascon_hmaca_pk
+    (unsigned char *out, const ascon_hmaca_key_t *pk,
+     const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Initializes an incremental HMAC state using ASCON-HMACA and a
+ * pre-computed key.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon_hmaca_update(), ascon_hmaca_finalize_pk()
+ */
+void ascon_hmaca_init_pk
+    (ascon_hmaca_state_t *state, const ascon_hmaca_key_t *pk);
+
+/**
+ * \brief Resets an incremental ASCON-HMACA state back to the start of a
+ * new message using a pre-computed key.
+ *
+ * \param state Points to the state to be reset, which must already
+ * be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * Unlike ascon_hmaca_reinit(), the key is not absorbed again and the
+ * state is not freed and initialized again.
+ *
+ * \sa ascon_hmaca_init_pk(), ascon_hmaca_finalize_pk()
+ */
+void ascon_hmaca_reset
+    (ascon_hmaca_state_t *state, const ascon_hmaca_key_t *pk);
+
+/**
+ * \brief Finalizes an incremental ASCON-HMACA state that was initialized
+ * with a pre-computed key.
+ *
+ * \param state HMAC state to squeeze the output data from.
+ * \param pk Points to the pre-computed key value.
+ * \param out Points to the output buffer to receive the HMAC value;
+ * must be at least ASCON_HMACA_SIZE bytes in length.
+ *
+ * \sa ascon_hmaca_init_pk(), ascon_hmaca_update()
+ */
+void ascon_hmaca_finalize_pk
+    (ascon_hmaca_state_t *state, const ascon_hmaca_key_t *pk,
+     unsigned char *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,10 +20,13 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-hmac.h"
 #include "ascon-utility.h"
 #include <string.h>
 
+#if ASCON_ENABLE_HASH
+
 /* The actual implementation is in the "ascon-hmac-common.h" file */
 
 /* ASCON-HMACA */
@@ -31,9 +34,16 @@
 #define HMAC_HASH_SIZE ASCON_HASHA_SIZE
 #define HMAC_BLOCK_SIZE 64
 #define HMAC_STATE ascon_hmaca_state_t
+#define HMAC_KEY ascon_hmaca_key_t
 #define HMAC_HASH_INIT ascon_hasha_init
 #define HMAC_HASH_REINIT ascon_hasha_reinit
 #define HMAC_HASH_FREE ascon_hasha_free
 #define HMAC_HASH_UPDATE ascon_hasha_update
 #define HMAC_HASH_FINALIZE ascon_hasha_finalize
+#define HMAC_HASH_COPY ascon_hasha_copy
+#define HMAC_HASH_RESET ascon_hasha_reset
+#define HMAC_HASH_SNAPSHOT ascon_hasha_snapshot
+#define HMAC_HASH_RESTORE ascon_hasha_restore
 #include "utility/ascon-hmac-common.h"
+
+#endif /* ASCON_ENABLE_HASH */
@@ -20,18 +20,25 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-isap.h"
 #include "ascon-utility.h"
 #include "utility/ascon-util-snp.h"
 #include "utility/ascon-aead-common.h"
+#include "utility/ascon-bulk.h"
 #include <string.h>
 
+#if ASCON_ENABLE_ISAP
+
 /* ISAP-A-128 */
 #define ISAP_ALG_NAME ascon128_isap
 #define ISAP_KEY_STATE ascon128_isap_aead_key_t
+#define ISAP_REKEY_CACHE ascon128_isap_rekey_cache_t
 #define ISAP_RATE (64 / 8)
 #define ISAP_sH 12
 #define ISAP_sE 12
 #define ISAP_sB 12
 #define ISAP_sK 12
 #include "utility/ascon-isap-common.h"
+
+#endif /* ASCON_ENABLE_ISAP */
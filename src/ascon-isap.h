@@ -47,6 +47,12 @@
  * using ascon128_isap_aead_load_key() or ascon128a_isap_aead_load_key().
  * This may avoid leakage when loading the key bits at runtime.
  *
+ * Re-keying for each packet still absorbs the nonce one bit at a time.
+ * When nonces share a common prefix, the *_encrypt_cached() and
+ * *_decrypt_cached() functions can use a small cache of re-keying
+ * states to skip over the prefix bits.  The cache can also be saved
+ * to non-volatile memory along with the pre-computed key.
+ *
  * References: https://isap.iaik.tugraz.at/
  */
 
@@ -94,6 +100,67 @@ typedef struct
 
 } ascon128_isap_aead_key_t;
 
+/**
+ * \brief Number of nonce prefixes that are held in an ISAP re-keying cache.
+ */
+#define ASCON_ISAP_REKEY_CACHE_ENTRIES 4
+
+/**
+ * \brief Size of an ISAP re-keying cache in its save format.
+ */
+#define ASCON_ISAP_SAVED_REKEY_CACHE_SIZE \
+    (4 + ASCON_ISAP_REKEY_CACHE_ENTRIES * (40 + ASCON_ISAP_NONCE_SIZE))
+
+/**
+ * \brief Re-keying cache for ISAP-A-128A.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Encryption re-keying states after absorbing each nonce prefix */
+    ascon_state_t states[ASCON_ISAP_REKEY_CACHE_ENTRIES];
+
+    /** Nonce prefixes that correspond to each entry in "states" */
+    unsigned char prefixes[ASCON_ISAP_REKEY_CACHE_ENTRIES]
+                          [ASCON_ISAP_NONCE_SIZE];
+
+    /** Number of leading nonce bytes in each prefix */
+    unsigned char prefix_len;
+
+    /** Number of entries that are currently in use */
+    unsigned char count;
+
+    /** Next entry to replace when a new prefix is added to a full cache */
+    unsigned char next;
+
+} ascon128a_isap_rekey_cache_t;
+
+/**
+ * \brief Re-keying cache for ISAP-A-128.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Encryption re-keying states after absorbing each nonce prefix */
+    ascon_state_t states[ASCON_ISAP_REKEY_CACHE_ENTRIES];
+
+    /** Nonce prefixes that correspond to each entry in "states" */
+    unsigned char prefixes[ASCON_ISAP_REKEY_CACHE_ENTRIES]
+                          [ASCON_ISAP_NONCE_SIZE];
+
+    /** Number of leading nonce bytes in each prefix */
+    unsigned char prefix_len;
+
+    /** Number of entries that are currently in use */
+    unsigned char count;
+
+    /** Next entry to replace when a new prefix is added to a full cache */
+    unsigned char next;
+
+} ascon128_isap_rekey_cache_t;
+
 /**
  * \brief Initializes a pre-computed key for ISAP-A-128A.
  *
@@ -200,6 +267,134 @@ int ascon128a_isap_aead_decrypt
      const unsigned char *npub,
      const ascon128a_isap_aead_key_t *pk);
 
+/**
+ * \brief Initializes a re-keying cache for ISAP-A-128A.
+ *
+ * \param cache Points to the cache to initialize.
+ * \param prefix_len Number of leading nonce bytes that are shared between
+ * the packets that will hit in the cache, between 1 and 15.
+ *
+ * \return 0 on success, or -2 if \a prefix_len is out of range.
+ *
+ * Re-keying the encryption key absorbs the nonce one bit at a time,
+ * with a permutation call for each bit.  When the packets use nonces
+ * that share long prefixes, such as a fixed device identifier followed
+ * by a message counter, the state after absorbing the prefix is the
+ * same from packet to packet.  The cache remembers the state for the
+ * last few prefixes so that only the remaining nonce bits need to be
+ * absorbed for each packet.
+ *
+ * A cache must only be used with the pre-computed key that it was
+ * first used with.  Its entries are as sensitive as the key itself.
+ *
+ * \sa ascon128a_isap_aead_encrypt_cached(),
+ * ascon128a_isap_aead_decrypt_cached(), ascon128a_isap_rekey_cache_free()
+ */
+int ascon128a_isap_rekey_cache_init
+    (ascon128a_isap_rekey_cache_t *cache, unsigned prefix_len);
+
+/**
+ * \brief Loads an ISAP-A-128A re-keying cache from a buffer that was
+ * previously saved with ascon128a_isap_rekey_cache_save().
+ *
+ * \param cache Points to the cache to load.
+ * \param buf Points to the buffer containing the saved cache.
+ *
+ * \return 0 on success, or -1 if the saved data is not a valid
+ * ISAP-A-128A re-keying cache.
+ *
+ * This can be used to keep the cache in non-volatile memory across a
+ * reboot alongside the key saved with ascon128a_isap_aead_save_key().
+ *
+ * \sa ascon128a_isap_rekey_cache_save()
+ */
+int ascon128a_isap_rekey_cache_load
+    (ascon128a_isap_rekey_cache_t *cache,
+     const unsigned char buf[ASCON_ISAP_SAVED_REKEY_CACHE_SIZE]);
+
+/**
+ * \brief Saves an ISAP-A-128A re-keying cache to a buffer.
+ *
+ * \param cache Points to the cache to save.
+ * \param buf Points to the buffer to receive the saved cache.
+ *
+ * \sa ascon128a_isap_rekey_cache_load()
+ */
+void ascon128a_isap_rekey_cache_save
+    (ascon128a_isap_rekey_cache_t *cache,
+     unsigned char buf[ASCON_ISAP_SAVED_REKEY_CACHE_SIZE]);
+
+/**
+ * \brief Frees an ISAP-A-128A re-keying cache.
+ *
+ * \param cache Points to the cache to free.
+ *
+ * \sa ascon128a_isap_rekey_cache_init()
+ */
+void ascon128a_isap_rekey_cache_free(ascon128a_isap_rekey_cache_t *cache);
+
+/**
+ * \brief Encrypts and authenticates a packet with ISAP-A-128A,
+ * pre-computed keys, and a re-keying cache.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ * \param cache Points to the re-keying cache for \a pk, which will be
+ * updated if the nonce prefix is not already present.
+ *
+ * The output is identical to that of ascon128a_isap_aead_encrypt().
+ *
+ * \sa ascon128a_isap_aead_decrypt_cached(), ascon128a_isap_rekey_cache_init()
+ */
+void ascon128a_isap_aead_encrypt_cached
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128a_isap_aead_key_t *pk,
+     ascon128a_isap_rekey_cache_t *cache);
+
+/**
+ * \brief Decrypts and authenticates a packet with ISAP-A-128A,
+ * pre-computed keys, and a re-keying cache.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ * \param cache Points to the re-keying cache for \a pk, which will be
+ * updated if the nonce prefix is not already present.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128a_isap_aead_encrypt_cached(), ascon128a_isap_rekey_cache_init()
+ */
+int ascon128a_isap_aead_decrypt_cached
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128a_isap_aead_key_t *pk,
+     ascon128a_isap_rekey_cache_t *cache);
+
 /**
  * \brief Initializes a pre-computed key for ISAP-A-128.
  *
@@ -306,6 +501,134 @@ int ascon128_isap_aead_decrypt
      const unsigned char *npub,
      const ascon128_isap_aead_key_t *pk);
 
+/**
+ * \brief Initializes a re-keying cache for ISAP-A-128.
+ *
+ * \param cache Points to the cache to initialize.
+ * \param prefix_len Number of leading nonce bytes that are shared between
+ * the packets that will hit in the cache, between 1 and 15.
+ *
+ * \return 0 on success, or -2 if \a prefix_len is out of range.
+ *
+ * Re-keying the encryption key absorbs the nonce one bit at a time,
+ * with a permutation call for each bit.  When the packets use nonces
+ * that share long prefixes, such as a fixed device identifier followed
+ * by a message counter, the state after absorbing the prefix is the
+ * same from packet to packet.  The cache remembers the state for the
+ * last few prefixes so that only the remaining nonce bits need to be
+ * absorbed for each packet.
+ *
+ * A cache must only be used with the pre-computed key that it was
+ * first used with.  Its entries are as sensitive as the key itself.
+ *
+ * \sa ascon128_isap_aead_encrypt_cached(),
+ * ascon128_isap_aead_decrypt_cached(), ascon128_isap_rekey_cache_free()
+ */
+int ascon128_isap_rekey_cache_init
+    (ascon128_isap_rekey_cache_t *cache, unsigned prefix_len);
+
+/**
+ * \brief Loads an ISAP-A-128 re-keying cache from a buffer that was
+ * previously saved with ascon128_isap_rekey_cache_save().
+ *
+ * \param cache Points to the cache to load.
+ * \param buf Points to the buffer containing the saved cache.
+ *
+ * \return 0 on success, or -1 if the saved data is not a valid
+ * ISAP-A-128 re-keying cache.
+ *
+ * This can be used to keep the cache in non-volatile memory across a
+ * reboot alongside the key saved with ascon128_isap_aead_save_key().
+ *
+ * \sa ascon128_isap_rekey_cache_save()
+ */
+int ascon128_isap_rekey_cache_load
+    (ascon128_isap_rekey_cache_t *cache,
+     const unsigned char buf[ASCON_ISAP_SAVED_REKEY_CACHE_SIZE]);
+
+/**
+ * \brief Saves an ISAP-A-128 re-keying cache to a buffer.
+ *
+ * \param cache Points to the cache to save.
+ * \param buf Points to the buffer to receive the saved cache.
+ *
+ * \sa ascon128_isap_rekey_cache_load()
+ */
+void ascon128_isap_rekey_cache_save
+    (ascon128_isap_rekey_cache_t *cache,
+     unsigned char buf[ASCON_ISAP_SAVED_REKEY_CACHE_SIZE]);
+
+/**
+ * \brief Frees an ISAP-A-128 re-keying cache.
+ *
+ * \param cache Points to the cache to free.
+ *
+ * \sa ascon128_isap_rekey_cache_init()
+ */
+void ascon128_isap_rekey_cache_free(ascon128_isap_rekey_cache_t *cache);
+
+/**
+ * \brief Encrypts and authenticates a packet with ISAP-A-128,
+ * pre-computed keys, and a re-keying cache.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ * \param cache Points to the re-keying cache for \a pk, which will be
+ * updated if the nonce prefix is not already present.
+ *
+ * The output is identical to that of ascon128_isap_aead_encrypt().
+ *
+ * \sa ascon128_isap_aead_decrypt_cached(), ascon128_isap_rekey_cache_init()
+ */
+void ascon128_isap_aead_encrypt_cached
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128_isap_aead_key_t *pk,
+     ascon128_isap_rekey_cache_t *cache);
+
+/**
+ * \brief Decrypts and authenticates a packet with ISAP-A-128,
+ * pre-computed keys, and a re-keying cache.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param pk Points to the pre-computed key value.
+ * \param cache Points to the re-keying cache for \a pk, which will be
+ * updated if the nonce prefix is not already present.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon128_isap_aead_encrypt_cached(), ascon128_isap_rekey_cache_init()
+ */
+int ascon128_isap_aead_decrypt_cached
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ascon128_isap_aead_key_t *pk,
+     ascon128_isap_rekey_cache_t *cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,10 +20,13 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-kmac.h"
 #include "ascon-utility.h"
 #include <string.h>
 
+#if ASCON_ENABLE_HASH
+
 /**
  * \brief Intializes a ASCON-KMAC context with the prefix pre-computed.
  *
@@ -59,4 +62,12 @@ static void ascon_kmac_init_precomputed(ascon_xof_state_t *state)
 #define KMAC_XOF_SQUEEZE ascon_xof_squeeze
 #define KMAC_XOF_PAD ascon_xof_pad
 #define KMAC_XOF_IS_ABSORBING(state) ((state)->mode == 0)
+#define KMAC_XOF_SNAPSHOT ascon_xof_snapshot
+#define KMAC_XOF_RESTORE ascon_xof_restore
+#define KMAC_XOF_COPY ascon_xof_copy
+#define KMAC_XOF_RESET ascon_xof_reset
+#define KMAC_KEY ascon_kmac_key_t
+#define KMAC_FIRST_ROUND 0
 #include "utility/ascon-kmac-common.h"
+
+#endif /* ASCON_ENABLE_HASH */
@@ -66,6 +66,17 @@ typedef struct
 
 } ascon_kmac_state_t;
 
+/**
+ * \brief Pre-computed key and customization string for ASCON-KMAC.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    ascon_xof_state_t xof; /**< State after the customization string and key */
+
+} ascon_kmac_key_t;
+
 /**
  * \brief State information for the ASCON-KMACA incremental mode.
  */
@@ -75,6 +86,17 @@ typedef struct
 
 } ascon_kmaca_state_t;
 
+/**
+ * \brief Pre-computed key and customization string for ASCON-KMACA.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    ascon_xofa_state_t xof; /**< State after the customization string and key */
+
+} ascon_kmaca_key_t;
+
 /**
  * \brief Computes a KMAC value using ASCON-XOF.
  *
@@ -192,6 +214,133 @@ void ascon_kmac_squeeze
 void ascon_kmac_finalize
     (ascon_kmac_state_t *state, unsigned char out[ASCON_KMAC_SIZE]);
 
+/**
+ * \brief Initializes a pre-computed key for ASCON-KMAC.
+ *
+ * \param pk Points to the object to receive the pre-computed key value.
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ *
+ * The customization string and key are absorbed once.  Each message
+ * then starts from a copy of the resulting state, which saves several
+ * permutation calls per message when the same key and customization
+ * string are used for many messages.
+ *
+ * \sa ascon_kmac_free_key(), ascon_kmac_pk(), ascon_kmac_init_pk()
+ */
+void ascon_kmac_init_key
+    (ascon_kmac_key_t *pk, const unsigned char *key, size_t keylen,
+     const unsigned char *custom, size_t customlen);
+
+/**
+ * \brief Frees a pre-computed key for ASCON-KMAC and destroys any
+ * sensitive material.
+ *
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon_kmac_init_key()
+ */
+void ascon_kmac_free_key(ascon_kmac_key_t *pk);
+
+/**
+ * \brief Computes a KMAC value using ASCON-KMAC and a pre-computed key.
+ *
+ * \param pk Points to the pre-computed key value.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ * \param out Buffer to receive the output KMAC value.
+ * \param outlen Length of the output KMAC value.
+ *
+ * \sa ascon_kmac_init_key()
+ */
+void ascon_kmac_pk
+    (const ascon_kmac_key_t *pk, const unsigned char *in, size_t inlen,
+     unsigned char *out, size_t outlen);
+
+/**
+ * \brief Initializes an incremental KMAC state using ASCON-KMAC and a
+ * pre-computed key.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * The state can then be used with the regular ASCON-KMAC functions
+ * in the same way as if ascon_kmac_init() had been called.
+ *
+ * \sa ascon_kmac_init_key(), ascon_kmac_absorb()
+ */
+void ascon_kmac_init_pk
+    (ascon_kmac_state_t *state, const ascon_kmac_key_t *pk);
+
+/**
+ * \brief Resets an incremental ASCON-KMAC state back to the start of a
+ * new message using a pre-computed key.
+ *
+ * \param state Points to the state to be reset, which must already
+ * be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * Unlike ascon_kmac_reinit(), the key and customization string are not
+ * absorbed again and the state is not freed and initialized again.
+ *
+ * \sa ascon_kmac_init_pk()
+ */
+void ascon_kmac_reset
+    (ascon_kmac_state_t *state, const ascon_kmac_key_t *pk);
+
+/**
+ * \brief Computes KMAC values for a batch of independent messages using
+ * ASCON-KMAC and a pre-computed key.
+ *
+ * \param pk Points to the pre-computed key value.
+ * \param out Buffer to receive the KMAC outputs, which must be at least
+ * \a count * \a outlen bytes in length.  The output for message i
+ * starts at offset i * \a outlen.
+ * \param outlen Length of each output KMAC value.
+ * \param in Array of pointers to the messages to be authenticated.
+ * \param inlen Array of message lengths in bytes.
+ * \param count Number of messages.
+ *
+ * The output for each message is the same as if ascon_kmac_pk() had
+ * been called on the message separately.  On back ends that can permute
+ * several states at once, the messages are processed side by side.
+ *
+ * \sa ascon_kmac_pk()
+ */
+void ascon_kmac_many
+    (const ascon_kmac_key_t *pk, unsigned char *out, size_t outlen,
+     const unsigned char * const *in, const size_t *inlen, size_t count);
+
+/**
+ * \brief Saves a serialized snapshot of an ASCON-KMAC state.
+ *
+ * \param state KMAC state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * The snapshot is derived from the key, so it must be protected
+ * in the same way as the key itself.
+ *
+ * \sa ascon_kmac_restore()
+ */
+void ascon_kmac_snapshot(ascon_kmac_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-KMAC state from a serialized snapshot.
+ *
+ * \param state KMAC state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not valid.
+ *
+ * \sa ascon_kmac_snapshot()
+ */
+int ascon_kmac_restore
+    (ascon_kmac_state_t *state, const unsigned char *snapshot);
+
 /**
  * \brief Computes a KMAC value using ASCON-XOFA.
  *
@@ -309,6 +458,133 @@ void ascon_kmaca_squeeze
 void ascon_kmaca_finalize
     (ascon_kmaca_state_t *state, unsigned char out[ASCON_KMACA_SIZE]);
 
+/**
+ * \brief Initializes a pre-computed key for ASCON-KMACA.
+ *
+ * \param pk Points to the object to receive the pre-computed key value.
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ *
+ * The customization string and key are absorbed once.  Each message
+ * then starts from a copy of the resulting state, which saves several
+ * permutation calls per message when the same key and customization
+ * string are used for many messages.
+ *
+ * \sa ascon_kmaca_free_key(), ascon_kmaca_pk(), ascon_kmaca_init_pk()
+ */
+void ascon_kmaca_init_key
+    (ascon_kmaca_key_t *pk, const unsigned char *key, size_t keylen,
+     const unsigned char *custom, size_t customlen);
+
+/**
+ * \brief Frees a pre-computed key for ASCON-KMACA and destroys any
+ * sensitive material.
+ *
+ * \param pk Points to the pre-computed key value.
+ *
+ * \sa ascon_kmaca_init_key()
+ */
+void ascon_kmaca_free_key(ascon_kmaca_key_t *pk);
+
+/**
+ * \brief Computes a KMAC value using ASCON-KMACA and a pre-computed key.
+ *
+ * \param pk Points to the pre-computed key value.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ * \param out Buffer to receive the output KMAC value.
+ * \param outlen Length of the output KMAC value.
+ *
+ * \sa ascon_kmaca_init_key()
+ */
+void ascon_kmaca_pk
+    (const ascon_kmaca_key_t *pk, const unsigned char *in, size_t inlen,
+     unsigned char *out, size_t outlen);
+
+/**
+ * \brief Initializes an incremental KMAC state using ASCON-KMACA and a
+ * pre-computed key.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * The state can then be used with the regular ASCON-KMACA functions
+ * in the same way as if ascon_kmaca_init() had been called.
+ *
+ * \sa ascon_kmaca_init_key(), ascon_kmaca_absorb()
+ */
+void ascon_kmaca_init_pk
+    (ascon_kmaca_state_t *state, const ascon_kmaca_key_t *pk);
+
+/**
+ * \brief Resets an incremental ASCON-KMACA state back to the start of a
+ * new message using a pre-computed key.
+ *
+ * \param state Points to the state to be reset, which must already
+ * be initialized.
+ * \param pk Points to the pre-computed key value.
+ *
+ * Unlike ascon_kmaca_reinit(), the key and customization string are not
+ * absorbed again and the state is not freed and initialized again.
+ *
+ * \sa ascon_kmaca_init_pk()
+ */
+void ascon_kmaca_reset
+    (ascon_kmaca_state_t *state, const ascon_kmaca_key_t *pk);
+
+/**
+ * \brief Computes KMAC values for a batch of independent messages using
+ * ASCON-KMACA and a pre-computed key.
+ *
+ * \param pk Points to the pre-computed key value.
+ * \param out Buffer to receive the KMAC outputs, which must be at least
+ * \a count * \a outlen bytes in length.  The output for message i
+ * starts at offset i * \a outlen.
+ * \param outlen Length of each output KMAC value.
+ * \param in Array of pointers to the messages to be authenticated.
+ * \param inlen Array of message lengths in bytes.
+ * \param count Number of messages.
+ *
+ * The output for each message is the same as if ascon_kmaca_pk() had
+ * been called on the message separately.  On back ends that can permute
+ * several states at once, the messages are processed side by side.
+ *
+ * \sa ascon_kmaca_pk()
+ */
+void ascon_kmaca_many
+    (const ascon_kmaca_key_t *pk, unsigned char *out, size_t outlen,
+     const unsigned char * const *in, const size_t *inlen, size_t count);
+
+/**
+ * \brief Saves a serialized snapshot of an ASCON-KMACA state.
+ *
+ * \param state KMAC state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * The snapshot is derived from the key, so it must be protected
+ * in the same way as the key itself.
+ *
+ * \sa ascon_kmaca_restore()
+ */
+void ascon_kmaca_snapshot(ascon_kmaca_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-KMACA state from a serialized snapshot.
+ *
+ * \param state KMAC state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not valid.
+ *
+ * \sa ascon_kmaca_snapshot()
+ */
+int ascon_kmaca_restore
+    (ascon_kmaca_state_t *state, const unsigned char *snapshot);
+
 #ifdef __cplusplus
 }
 #endif
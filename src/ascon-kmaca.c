@@ -20,10 +20,13 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-kmac.h"
 #include "ascon-utility.h"
 #include <string.h>
 
+#if ASCON_ENABLE_HASH
+
 /**
  * \brief Intializes a ASCON-KMACA context with the prefix pre-computed.
  *
@@ -59,4 +62,12 @@ static void ascon_kmaca_init_precomputed(ascon_xofa_state_t *state)
 #define KMAC_XOF_SQUEEZE ascon_xofa_squeeze
 #define KMAC_XOF_PAD ascon_xofa_pad
 #define KMAC_XOF_IS_ABSORBING(state) ((state)->mode == 0)
+#define KMAC_XOF_SNAPSHOT ascon_xofa_snapshot
+#define KMAC_XOF_RESTORE ascon_xofa_restore
+#define KMAC_XOF_COPY ascon_xofa_copy
+#define KMAC_XOF_RESET ascon_xofa_reset
+#define KMAC_KEY ascon_kmaca_key_t
+#define KMAC_FIRST_ROUND 4
 #include "utility/ascon-kmac-common.h"
+
+#endif /* ASCON_ENABLE_HASH */
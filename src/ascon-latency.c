@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-latency.h"
+#include <string.h>
+
+unsigned long ascon_latency_percentile
+    (const ascon_latency_histogram_t *hist, unsigned percent)
+{
+    uint64_t target, total;
+    unsigned long bound;
+    unsigned bucket;
+    if (!hist->count)
+        return 0;
+    if (percent > 100)
+        percent = 100;
+
+    /* Find the first bucket where the running total reaches the target */
+    target = ((uint64_t)(hist->count)) * percent;
+    total = 0;
+    for (bucket = 0; bucket < ASCON_LATENCY_BUCKETS; ++bucket) {
+        total += ((uint64_t)(hist->buckets[bucket])) * 100U;
+        if (total >= target && hist->buckets[bucket])
+            break;
+    }
+    if (bucket >= ASCON_LATENCY_BUCKETS - 1)
+        return hist->max;
+    bound = (((unsigned long)1) << bucket) - 1U;
+    return bound < hist->max ? bound : hist->max;
+}
+
+#if defined(ASCON_LATENCY)
+
+#include <stdio.h>
+
+static ascon_latency_clock_t ascon_latency_clock = 0;
+static ascon_latency_histogram_t ascon_latency_hist[ASCON_LATENCY_FAMILIES];
+
+/* Names of the families for ascon_latency_dump() */
+static const char * const ascon_latency_names[ASCON_LATENCY_FAMILIES] = {
+    "aead", "masked-aead", "hash", "prng", "trng"
+};
+
+void ascon_latency_set_clock(ascon_latency_clock_t clock)
+{
+    __atomic_store_n(&ascon_latency_clock, clock, __ATOMIC_RELEASE);
+}
+
+unsigned long ascon_latency_now(void)
+{
+    ascon_latency_clock_t clock =
+        __atomic_load_n(&ascon_latency_clock, __ATOMIC_ACQUIRE);
+    return clock ? (*clock)() : 0;
+}
+
+void ascon_latency_record(unsigned family, unsigned long start)
+{
+    ascon_latency_clock_t clock =
+        __atomic_load_n(&ascon_latency_clock, __ATOMIC_ACQUIRE);
+    ascon_latency_histogram_t *hist = &(ascon_latency_hist[family]);
+    unsigned long elapsed, max;
+    unsigned bucket;
+    if (!clock)
+        return;
+    elapsed = (*clock)() - start;
+
+    /* The bucket is the number of significant bits in the latency */
+    bucket = 0;
+    for (max = elapsed; max != 0 && bucket < ASCON_LATENCY_BUCKETS - 1;
+            max >>= 1) {
+        ++bucket;
+    }
+
+    /* Other threads and interrupts may be recording at the same time */
+    __atomic_fetch_add(&(hist->buckets[bucket]), 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&(hist->count), 1, __ATOMIC_RELAXED);
+    max = __atomic_load_n(&(hist->max), __ATOMIC_RELAXED);
+    while (elapsed > max) {
+        if (__atomic_compare_exchange_n
+                (&(hist->max), &max, elapsed, 1,
+                 __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+}
+
+void ascon_latency_get(unsigned family, ascon_latency_histogram_t *hist)
+{
+    unsigned bucket;
+    if (family >= ASCON_LATENCY_FAMILIES) {
+        memset(hist, 0, sizeof(ascon_latency_histogram_t));
+        return;
+    }
+    for (bucket = 0; bucket < ASCON_LATENCY_BUCKETS; ++bucket) {
+        hist->buckets[bucket] = __atomic_load_n
+            (&(ascon_latency_hist[family].buckets[bucket]), __ATOMIC_RELAXED);
+    }
+    hist->count = __atomic_load_n
+        (&(ascon_latency_hist[family].count), __ATOMIC_RELAXED);
+    hist->max = __atomic_load_n
+        (&(ascon_latency_hist[family].max), __ATOMIC_RELAXED);
+}
+
+void ascon_latency_reset(void)
+{
+    memset(ascon_latency_hist, 0, sizeof(ascon_latency_hist));
+}
+
+void ascon_latency_dump(ascon_latency_print_t print, void *arg)
+{
+    ascon_latency_histogram_t hist;
+    char line[80];
+    unsigned family;
+    (*print)(arg, "mode,family,calls,p50,p99,max");
+    for (family = 0; family < ASCON_LATENCY_FAMILIES; ++family) {
+        ascon_latency_get(family, &hist);
+        snprintf(line, sizeof(line), "latency,%s,%lu,%lu,%lu,%lu",
+                 ascon_latency_names[family], (unsigned long)(hist.count),
+                 ascon_latency_percentile(&hist, 50),
+                 ascon_latency_percentile(&hist, 99), hist.max);
+        (*print)(arg, line);
+    }
+}
+
+#else /* !ASCON_LATENCY */
+
+void ascon_latency_set_clock(ascon_latency_clock_t clock)
+{
+    (void)clock;
+}
+
+void ascon_latency_get(unsigned family, ascon_latency_histogram_t *hist)
+{
+    (void)family;
+    memset(hist, 0, sizeof(ascon_latency_histogram_t));
+}
+
+void ascon_latency_reset(void)
+{
+}
+
+void ascon_latency_dump(ascon_latency_print_t print, void *arg)
+{
+    (void)print;
+    (void)arg;
+}
+
+#endif /* !ASCON_LATENCY */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_LATENCY_H
+#define ASCON_LATENCY_H
+
+/**
+ * \file ascon-latency.h
+ * \brief Per-call latency histograms for the main API families.
+ *
+ * Average throughput hides jitter, and in control loops the worst case
+ * usually matters more than the average.  When the library is compiled
+ * with ASCON_LATENCY defined, the one-shot AEAD, masked AEAD, hashing,
+ * PRNG, and TRNG functions record how long each call took into a
+ * histogram for their family.  Each histogram has log-scaled buckets,
+ * where bucket b counts the calls that took between 2^(b-1) and
+ * 2^b - 1 ticks of the clock, so the p50 and p99 figures are rounded
+ * up to the next power of two less one.  The maximum is exact.
+ *
+ * Nothing is recorded until a clock has been supplied with
+ * ascon_latency_set_clock():
+ *
+ * \code
+ * static void print_line(void *arg, const char *line)
+ * {
+ *     Serial.println(line);
+ * }
+ *
+ * void setup()
+ * {
+ *     ascon_latency_set_clock(micros);
+ *     ...
+ * }
+ *
+ * // When the "latency" command is received on the serial port:
+ * ascon_latency_dump(print_line, 0);
+ * \endcode
+ *
+ * Without ASCON_LATENCY, the instrumentation compiles to nothing, the
+ * histograms are always empty, and ascon_latency_dump() prints nothing.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** AEAD encryption and decryption with ASCON-128, ASCON-128a,
+ *  ASCON-80pq, and Ascon-AEAD128 */
+#define ASCON_LATENCY_AEAD          0
+
+/** Masked AEAD encryption and decryption */
+#define ASCON_LATENCY_MASKED_AEAD   1
+
+/** One-shot hashing and XOF functions */
+#define ASCON_LATENCY_HASH          2
+
+/** Output generation from the pseudorandom number generator */
+#define ASCON_LATENCY_PRNG          3
+
+/** Output generation from the system's TRNG */
+#define ASCON_LATENCY_TRNG          4
+
+/** Number of API families that have histograms */
+#define ASCON_LATENCY_FAMILIES      5
+
+/** Number of buckets in each latency histogram */
+#define ASCON_LATENCY_BUCKETS       32
+
+/**
+ * \brief Clock that measures the latency of calls.
+ *
+ * \return The current time in any unit, usually microseconds or cycles.
+ * The value is allowed to wrap around.  The clock must be safe to call
+ * from every thread or interrupt that uses the library.
+ */
+typedef unsigned long (*ascon_latency_clock_t)(void);
+
+/**
+ * \brief Prints a line of output from ascon_latency_dump().
+ *
+ * \param arg Argument that was passed to ascon_latency_dump().
+ * \param line The line to print, without a line terminator.
+ */
+typedef void (*ascon_latency_print_t)(void *arg, const char *line);
+
+/**
+ * \brief Latency histogram for an API family.
+ */
+typedef struct
+{
+    /** Number of calls in each log-scaled bucket */
+    uint32_t buckets[ASCON_LATENCY_BUCKETS];
+
+    /** Total number of calls that were recorded */
+    uint32_t count;
+
+    /** Longest latency that was recorded */
+    unsigned long max;
+
+} ascon_latency_histogram_t;
+
+/**
+ * \brief Sets the clock to use to measure latency.
+ *
+ * \param clock The clock function, or NULL to stop recording.
+ */
+void ascon_latency_set_clock(ascon_latency_clock_t clock);
+
+/**
+ * \brief Gets a copy of the latency histogram for an API family.
+ *
+ * \param family The family, such as ASCON_LATENCY_AEAD.
+ * \param hist Returns the histogram.  It is cleared if \a family is
+ * out of range.
+ */
+void ascon_latency_get(unsigned family, ascon_latency_histogram_t *hist);
+
+/**
+ * \brief Resets all of the latency histograms.
+ */
+void ascon_latency_reset(void);
+
+/**
+ * \brief Estimates a percentile of the latency from a histogram.
+ *
+ * \param hist The histogram.
+ * \param percent The percentile between 0 and 100; e.g. 99 for p99.
+ *
+ * \return The upper bound of the bucket that contains the percentile,
+ * limited to the maximum latency.  Returns zero if the histogram is empty.
+ */
+unsigned long ascon_latency_percentile
+    (const ascon_latency_histogram_t *hist, unsigned percent);
+
+/**
+ * \brief Prints a summary of all latency histograms in CSV form.
+ *
+ * \param print Function to print each line.
+ * \param arg Argument to pass to \a print.
+ *
+ * The first line is the header "mode,family,calls,p50,p99,max", followed
+ * by one line for each family whose mode is "latency", with the times in
+ * the units of the clock.
+ */
+void ascon_latency_dump(ascon_latency_print_t print, void *arg);
+
+/** @cond ascon_latency */
+
+/* The instrumented functions call ascon_latency_begin() as the first
+ * statement after their declarations and ascon_latency_end() before the
+ * normal return.  Calls that are rejected by the parameter checks before
+ * any work is done are not recorded. */
+#if defined(ASCON_LATENCY)
+unsigned long ascon_latency_now(void);
+void ascon_latency_record(unsigned family, unsigned long start);
+#define ascon_latency_begin() \
+    unsigned long ascon_latency_start = ascon_latency_now()
+#define ascon_latency_end(family) \
+    ascon_latency_record((family), ascon_latency_start)
+#else
+#define ascon_latency_begin() do { ; } while (0)
+#define ascon_latency_end(family) do { ; } while (0)
+#endif
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -161,6 +161,232 @@ void ascon_masked_key_160_randomize(ascon_masked_key_160_t *masked);
 void ascon_masked_key_160_extract
     (const ascon_masked_key_160_t *masked, unsigned char *key);
 
+/**
+ * \brief State for refreshing the shares of a masked key a little at
+ * a time.
+ *
+ * ascon_masked_key_128_randomize() and ascon_masked_key_160_randomize()
+ * set up the random number source and refresh every word of the key in
+ * one call.  An idle hook or timer tick can instead call
+ * ascon_masked_key_128_refresh_step() or ascon_masked_key_160_refresh_step()
+ * with this state to refresh one word of the key per call, which keeps
+ * the key fresh continuously without delaying a pending encryption.
+ *
+ * The random number source is set up once by
+ * ascon_masked_key_refresh_init() and kept until
+ * ascon_masked_key_refresh_free() is called.  Each key should have its
+ * own refresh state, and the key must not be used by another thread
+ * while a step is in progress.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** Storage for the random number source, which is opaque */
+    uint64_t trng[8];
+
+    /** Index of the next word of the key to refresh */
+    unsigned next;
+
+} ascon_masked_key_refresh_t;
+
+/**
+ * \brief Initializes the state for refreshing a masked key incrementally.
+ *
+ * \param refresh The refresh state to initialize.
+ *
+ * \sa ascon_masked_key_refresh_free()
+ */
+void ascon_masked_key_refresh_init(ascon_masked_key_refresh_t *refresh);
+
+/**
+ * \brief Frees the state for refreshing a masked key incrementally and
+ * destroys any sensitive material in it.
+ *
+ * \param refresh The refresh state to free.
+ *
+ * \sa ascon_masked_key_refresh_init()
+ */
+void ascon_masked_key_refresh_free(ascon_masked_key_refresh_t *refresh);
+
+/**
+ * \brief Refreshes the shares of the next word of a masked 128-bit key.
+ *
+ * \param masked Points to the masked key to refresh.
+ * \param refresh Points to the refresh state for the key.
+ *
+ * \return 1 if this call refreshed the last word of the key, so that every
+ * word has been refreshed since the previous time 1 was returned,
+ * or 0 otherwise.
+ *
+ * \sa ascon_masked_key_128_randomize()
+ */
+int ascon_masked_key_128_refresh_step
+    (ascon_masked_key_128_t *masked, ascon_masked_key_refresh_t *refresh);
+
+/**
+ * \brief Refreshes the shares of the next word of a masked 160-bit key.
+ *
+ * \param masked Points to the masked key to refresh.
+ * \param refresh Points to the refresh state for the key.
+ *
+ * \return 1 if this call refreshed the last word of the key, so that every
+ * word has been refreshed since the previous time 1 was returned,
+ * or 0 otherwise.
+ *
+ * \sa ascon_masked_key_160_randomize()
+ */
+int ascon_masked_key_160_refresh_step
+    (ascon_masked_key_160_t *masked, ascon_masked_key_refresh_t *refresh);
+
+/**
+ * \brief Store of pre-masked 128-bit keys, indexed by key identifier.
+ *
+ * The key table is typically a "const" array that was produced ahead of
+ * time with ascon_masked_key_128_init() and placed in flash memory.
+ * Keys are looked up directly by their index in the table, so switching
+ * between keys is O(1) and never requires the plain version of the key.
+ *
+ * This structure should be treated as opaque.
+ */
+typedef struct
+{
+    const ascon_masked_key_128_t *keys; /**< Table of masked keys */
+    unsigned count;                     /**< Number of keys in the table */
+    unsigned char progmem;              /**< Non-zero for AVR PROGMEM */
+
+} ascon_masked_key_store_128_t;
+
+/**
+ * \brief Store of pre-masked 160-bit keys, indexed by key identifier.
+ *
+ * This structure should be treated as opaque.
+ *
+ * \sa ascon_masked_key_store_128_t
+ */
+typedef struct
+{
+    const ascon_masked_key_160_t *keys; /**< Table of masked keys */
+    unsigned count;                     /**< Number of keys in the table */
+    unsigned char progmem;              /**< Non-zero for AVR PROGMEM */
+
+} ascon_masked_key_store_160_t;
+
+/**
+ * \brief Initializes a store of pre-masked 128-bit keys.
+ *
+ * \param store The key store to initialize.
+ * \param keys Points to the table of masked keys, which must remain
+ * valid for as long as the store is in use.
+ * \param count Number of keys in the table.
+ *
+ * \sa ascon_masked_key_store_128_init_P()
+ */
+void ascon_masked_key_store_128_init
+    (ascon_masked_key_store_128_t *store,
+     const ascon_masked_key_128_t *keys, unsigned count);
+
+/**
+ * \brief Initializes a store of pre-masked 128-bit keys that reside
+ * in program memory.
+ *
+ * \param store The key store to initialize.
+ * \param keys Points to the table of masked keys in program memory.
+ * \param count Number of keys in the table.
+ *
+ * On AVR platforms the table must be declared with PROGMEM.  On all other
+ * platforms this is identical to ascon_masked_key_store_128_init() because
+ * flash memory is directly addressable.
+ */
+void ascon_masked_key_store_128_init_P
+    (ascon_masked_key_store_128_t *store,
+     const ascon_masked_key_128_t *keys, unsigned count);
+
+/**
+ * \brief Loads a key from a store of pre-masked 128-bit keys.
+ *
+ * \param store The key store to load from.
+ * \param id Identifier of the key, which is its index in the table.
+ * \param key Returns the loaded key, re-randomized with fresh shares.
+ *
+ * \return 0 on success, or -2 if \a id is out of range.
+ *
+ * The re-randomization ensures that the shares in RAM are never the same
+ * as the shares in flash, even if the same key is loaded many times.
+ */
+int ascon_masked_key_store_128_load
+    (const ascon_masked_key_store_128_t *store, unsigned id,
+     ascon_masked_key_128_t *key);
+
+/**
+ * \brief Gets a pointer to a key in a store of pre-masked 128-bit keys.
+ *
+ * \param store The key store to look up.
+ * \param id Identifier of the key, which is its index in the table.
+ *
+ * \return A pointer to the masked key, or NULL if \a id is out of range
+ * or the table is in AVR program memory.
+ *
+ * The masked AEAD functions copy the key and re-randomize their copy,
+ * so the returned pointer can be passed to them directly to avoid
+ * copying the key out of flash first.
+ */
+const ascon_masked_key_128_t *ascon_masked_key_store_128_get
+    (const ascon_masked_key_store_128_t *store, unsigned id);
+
+/**
+ * \brief Initializes a store of pre-masked 160-bit keys.
+ *
+ * \param store The key store to initialize.
+ * \param keys Points to the table of masked keys, which must remain
+ * valid for as long as the store is in use.
+ * \param count Number of keys in the table.
+ *
+ * \sa ascon_masked_key_store_160_init_P()
+ */
+void ascon_masked_key_store_160_init
+    (ascon_masked_key_store_160_t *store,
+     const ascon_masked_key_160_t *keys, unsigned count);
+
+/**
+ * \brief Initializes a store of pre-masked 160-bit keys that reside
+ * in program memory.
+ *
+ * \param store The key store to initialize.
+ * \param keys Points to the table of masked keys in program memory.
+ * \param count Number of keys in the table.
+ *
+ * \sa ascon_masked_key_store_128_init_P()
+ */
+void ascon_masked_key_store_160_init_P
+    (ascon_masked_key_store_160_t *store,
+     const ascon_masked_key_160_t *keys, unsigned count);
+
+/**
+ * \brief Loads a key from a store of pre-masked 160-bit keys.
+ *
+ * \param store The key store to load from.
+ * \param id Identifier of the key, which is its index in the table.
+ * \param key Returns the loaded key, re-randomized with fresh shares.
+ *
+ * \return 0 on success, or -2 if \a id is out of range.
+ */
+int ascon_masked_key_store_160_load
+    (const ascon_masked_key_store_160_t *store, unsigned id,
+     ascon_masked_key_160_t *key);
+
+/**
+ * \brief Gets a pointer to a key in a store of pre-masked 160-bit keys.
+ *
+ * \param store The key store to look up.
+ * \param id Identifier of the key, which is its index in the table.
+ *
+ * \return A pointer to the masked key, or NULL if \a id is out of range
+ * or the table is in AVR program memory.
+ */
+const ascon_masked_key_160_t *ascon_masked_key_store_160_get
+    (const ascon_masked_key_store_160_t *store, unsigned id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "ascon-config.h"
+#include "ascon-merkle.h"
+#include "utility/ascon-aead-common.h"
+#include <string.h>
+
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Gets a pointer to a specific node in a Merkle tree.
+ */
+#define ASCON_MERKLE_NODE(nodes, index) \
+    ((nodes) + (index) * ASCON_MERKLE_NODE_SIZE)
+
+size_t ascon_merkle_node_count(size_t num_leaves)
+{
+    size_t total = 0;
+    if (!num_leaves)
+        return 0;
+    while (num_leaves > 1) {
+        total += num_leaves;
+        num_leaves = (num_leaves + 1) / 2;
+    }
+    return total + 1;
+}
+
+int ascon_merkle_init
+    (ascon_merkle_tree_t *tree, unsigned char *nodes,
+     size_t num_leaves, int variant)
+{
+    if (!num_leaves ||
+            (variant != ASCON_MERKLE_HASH && variant != ASCON_MERKLE_HASHA)) {
+        return -1;
+    }
+    tree->nodes = nodes;
+    tree->num_leaves = num_leaves;
+    tree->variant = (unsigned char)variant;
+    return 0;
+}
+
+/**
+ * \brief Hashes a page to produce a leaf node.
+ *
+ * \param variant The Merkle tree variant.
+ * \param out Points to the leaf node to fill in.
+ * \param page Points to the page.
+ * \param pagelen Length of the page in bytes.
+ */
+static void ascon_merkle_leaf
+    (unsigned char variant, unsigned char *out,
+     const unsigned char *page, size_t pagelen)
+{
+    if (variant == ASCON_MERKLE_HASHA)
+        ascon_hasha(out, page, pagelen);
+    else
+        ascon_hash(out, page, pagelen);
+}
+
+/**
+ * \brief Hashes two child nodes to produce an interior node.
+ *
+ * \param variant The Merkle tree variant.
+ * \param out Points to the interior node to fill in, which may be the
+ * same as \a left or \a right.
+ * \param left Points to the left child.
+ * \param right Points to the right child.
+ */
+static void ascon_merkle_interior
+    (unsigned char variant, unsigned char *out,
+     const unsigned char *left, const unsigned char *right)
+{
+    if (variant == ASCON_MERKLE_HASHA) {
+        ascon_xofa_state_t state;
+        ascon_xofa_init(&state);
+        ascon_xofa_absorb(&state, left, ASCON_MERKLE_NODE_SIZE);
+        ascon_xofa_absorb(&state, right, ASCON_MERKLE_NODE_SIZE);
+        ascon_xofa_squeeze(&state, out, ASCON_MERKLE_NODE_SIZE);
+        ascon_xofa_free(&state);
+    } else {
+        ascon_xof_state_t state;
+        ascon_xof_init(&state);
+        ascon_xof_absorb(&state, left, ASCON_MERKLE_NODE_SIZE);
+        ascon_xof_absorb(&state, right, ASCON_MERKLE_NODE_SIZE);
+        ascon_xof_squeeze(&state, out, ASCON_MERKLE_NODE_SIZE);
+        ascon_xof_free(&state);
+    }
+}
+
+void ascon_merkle_build
+    (ascon_merkle_tree_t *tree, const unsigned char * const *pages,
+     const size_t *pagelen)
+{
+    unsigned char *nodes = tree->nodes;
+    size_t count = tree->num_leaves;
+    size_t base = 0;
+    size_t index;
+
+    /* Hash all of the leaves side by side */
+    if (tree->variant == ASCON_MERKLE_HASHA)
+        ascon_hasha_many(nodes, pages, pagelen, count);
+    else
+        ascon_hash_many(nodes, pages, pagelen, count);
+
+    /* Hash each level in turn until we reach the root */
+    while (count > 1) {
+        size_t next = base + count;
+        for (index = 0; (index + 1) < count; index += 2) {
+            ascon_merkle_interior
+                (tree->variant, ASCON_MERKLE_NODE(nodes, next + index / 2),
+                 ASCON_MERKLE_NODE(nodes, base + index),
+                 ASCON_MERKLE_NODE(nodes, base + index + 1));
+        }
+        if (index < count) {
+            /* Promote the odd node at the end of the level */
+            memcpy(ASCON_MERKLE_NODE(nodes, next + index / 2),
+                   ASCON_MERKLE_NODE(nodes, base + index),
+                   ASCON_MERKLE_NODE_SIZE);
+        }
+        base = next;
+        count = (count + 1) / 2;
+    }
+}
+
+int ascon_merkle_update
+    (ascon_merkle_tree_t *tree, size_t index,
+     const unsigned char *page, size_t pagelen)
+{
+    unsigned char *nodes = tree->nodes;
+    size_t count = tree->num_leaves;
+    size_t base = 0;
+    if (index >= count)
+        return -1;
+    ascon_merkle_leaf
+        (tree->variant, ASCON_MERKLE_NODE(nodes, index), page, pagelen);
+    while (count > 1) {
+        size_t next = base + count;
+        size_t sibling = index ^ 1;
+        unsigned char *parent = ASCON_MERKLE_NODE(nodes, next + index / 2);
+        if (sibling >= count) {
+            memcpy(parent, ASCON_MERKLE_NODE(nodes, base + index),
+                   ASCON_MERKLE_NODE_SIZE);
+        } else if (index & 1) {
+            ascon_merkle_interior
+                (tree->variant, parent,
+                 ASCON_MERKLE_NODE(nodes, base + sibling),
+                 ASCON_MERKLE_NODE(nodes, base + index));
+        } else {
+            ascon_merkle_interior
+                (tree->variant, parent,
+                 ASCON_MERKLE_NODE(nodes, base + index),
+                 ASCON_MERKLE_NODE(nodes, base + sibling));
+        }
+        base = next;
+        index /= 2;
+        count = (count + 1) / 2;
+    }
+    return 0;
+}
+
+int ascon_merkle_verify
+    (const ascon_merkle_tree_t *tree, size_t index,
+     const unsigned char *page, size_t pagelen,
+     const unsigned char *root)
+{
+    const unsigned char *nodes = tree->nodes;
+    unsigned char current[ASCON_MERKLE_NODE_SIZE];
+    size_t count = tree->num_leaves;
+    size_t base = 0;
+    int result;
+    if (index >= count)
+        return -1;
+    if (!root)
+        root = ascon_merkle_root(tree);
+    ascon_merkle_leaf(tree->variant, current, page, pagelen);
+    while (count > 1) {
+        size_t sibling = index ^ 1;
+        if (sibling >= count) {
+            /* Odd node at the end of the level is promoted as-is */
+        } else if (index & 1) {
+            ascon_merkle_interior
+                (tree->variant, current,
+                 ASCON_MERKLE_NODE(nodes, base + sibling), current);
+        } else {
+            ascon_merkle_interior
+                (tree->variant, current, current,
+                 ASCON_MERKLE_NODE(nodes, base + sibling));
+        }
+        base += count;
+        index /= 2;
+        count = (count + 1) / 2;
+    }
+    result = ascon_aead_check_tag(0, 0, current, root, sizeof(current));
+    ascon_clean(current, sizeof(current));
+    return result;
+}
+
+const unsigned char *ascon_merkle_root(const ascon_merkle_tree_t *tree)
+{
+    return ASCON_MERKLE_NODE
+        (tree->nodes, ascon_merkle_node_count(tree->num_leaves) - 1);
+}
+
+#endif /* ASCON_ENABLE_HASH */
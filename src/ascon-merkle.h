@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_MERKLE_H
+#define ASCON_MERKLE_H
+
+/**
+ * \file ascon-merkle.h
+ * \brief Merkle tree integrity checking for paged storage.
+ *
+ * A Merkle tree protects a store that is divided into pages, such as a
+ * configuration or log area in flash.  Each page is hashed to a leaf, and
+ * pairs of nodes are hashed together until a single root remains.  If the
+ * root is kept somewhere trusted, then any page can be verified, and any
+ * page can be updated, with only O(log n) hash operations instead of
+ * rehashing the whole store.
+ *
+ * Leaves are computed with ASCON-HASH (or ASCON-HASHA) over the page.
+ * Interior nodes are computed with ASCON-XOF (or ASCON-XOFA) over the left
+ * and right children, truncated to 32 bytes.  The two use different
+ * initialization vectors, so a leaf can never be confused with an interior
+ * node.  When a level has an odd number of nodes, the last node is
+ * promoted unchanged to the next level.
+ *
+ * The nodes are stored in a single array of ASCON_MERKLE_NODE_SIZE byte
+ * entries, which can be kept directly in flash.  The leaves come first in
+ * page order, followed by each level above them, with the root last.
+ * Use ascon_merkle_node_count() to determine the size of the array.
+ */
+
+#include "ascon-hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of a node in a Merkle tree.
+ */
+#define ASCON_MERKLE_NODE_SIZE 32
+
+/**
+ * \brief Merkle tree variant based on ASCON-HASH and ASCON-XOF.
+ */
+#define ASCON_MERKLE_HASH 0
+
+/**
+ * \brief Merkle tree variant based on ASCON-HASHA and ASCON-XOFA.
+ */
+#define ASCON_MERKLE_HASHA 1
+
+/**
+ * \brief State information for a Merkle tree.
+ */
+typedef struct
+{
+    unsigned char *nodes;   /**< Array of all nodes, with the root last */
+    size_t num_leaves;      /**< Number of pages in the store */
+    unsigned char variant;  /**< ASCON_MERKLE_HASH or ASCON_MERKLE_HASHA */
+
+} ascon_merkle_tree_t;
+
+/**
+ * \brief Determines the number of nodes in a Merkle tree.
+ *
+ * \param num_leaves Number of pages in the store.
+ *
+ * \return The number of nodes, which will be less than 2 * \a num_leaves.
+ * The node array must be this many times ASCON_MERKLE_NODE_SIZE bytes.
+ */
+size_t ascon_merkle_node_count(size_t num_leaves);
+
+/**
+ * \brief Initializes a Merkle tree over an existing node array.
+ *
+ * \param tree The Merkle tree to initialize.
+ * \param nodes Points to the node array.
+ * \param num_leaves Number of pages in the store, which must be non-zero.
+ * \param variant ASCON_MERKLE_HASH or ASCON_MERKLE_HASHA.
+ *
+ * \return 0 on success, or -1 if the parameters are invalid.
+ *
+ * The contents of \a nodes are not modified, so this can be used to
+ * attach to a tree that was previously built and saved to flash.
+ * Otherwise call ascon_merkle_build() to fill in the nodes.
+ */
+int ascon_merkle_init
+    (ascon_merkle_tree_t *tree, unsigned char *nodes,
+     size_t num_leaves, int variant);
+
+/**
+ * \brief Builds all of the nodes in a Merkle tree from the pages.
+ *
+ * \param tree The Merkle tree.
+ * \param pages Array of pointers to the pages.
+ * \param pagelen Array of page lengths in bytes.
+ *
+ * The leaves are hashed together with ascon_hash_many() or
+ * ascon_hasha_many(), so back ends that can permute several states at
+ * once will hash several pages side by side.
+ */
+void ascon_merkle_build
+    (ascon_merkle_tree_t *tree, const unsigned char * const *pages,
+     const size_t *pagelen);
+
+/**
+ * \brief Updates a Merkle tree after one page has been modified.
+ *
+ * \param tree The Merkle tree.
+ * \param index Index of the page that was modified.
+ * \param page Points to the new contents of the page.
+ * \param pagelen Length of the page in bytes.
+ *
+ * \return 0 on success, or -1 if \a index is out of range.
+ *
+ * Only the leaf and the nodes on the path from the leaf to the root
+ * are rewritten.
+ */
+int ascon_merkle_update
+    (ascon_merkle_tree_t *tree, size_t index,
+     const unsigned char *page, size_t pagelen);
+
+/**
+ * \brief Verifies a single page against a trusted Merkle tree root.
+ *
+ * \param tree The Merkle tree.
+ * \param index Index of the page to verify.
+ * \param page Points to the contents of the page.
+ * \param pagelen Length of the page in bytes.
+ * \param root Points to the ASCON_MERKLE_NODE_SIZE bytes of the trusted
+ * root, or NULL to compare against the root in the node array.
+ *
+ * \return 0 if the page is valid, or -1 if the page, its sibling nodes,
+ * or the root have been modified, or \a index is out of range.
+ *
+ * The page is hashed and then combined with the sibling nodes on the
+ * path to the root.  The node array itself does not need to be trusted
+ * as long as \a root is.
+ */
+int ascon_merkle_verify
+    (const ascon_merkle_tree_t *tree, size_t index,
+     const unsigned char *page, size_t pagelen,
+     const unsigned char *root);
+
+/**
+ * \brief Gets a pointer to the root of a Merkle tree.
+ *
+ * \param tree The Merkle tree.
+ *
+ * \return A pointer to the ASCON_MERKLE_NODE_SIZE bytes of the root,
+ * which is the last node in the node array.
+ */
+const unsigned char *ascon_merkle_root(const ascon_merkle_tree_t *tree);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-nonce.h"
+#include "ascon-random.h"
+#include "ascon-utility.h"
+#include "utility/ascon-util.h"
+#include <string.h>
+
+#if ASCON_ENABLE_AEAD
+
+/**
+ * \brief Saves the persistence record for a new reservation.
+ *
+ * \param state The nonce sequencer.
+ * \param count Number of counter values that are needed right now.
+ *
+ * \return 0 on success, or -1 on error.
+ */
+static int ascon_nonce_reserve(ascon_nonce_state_t *state, uint64_t count)
+{
+    unsigned char record[ASCON_NONCE_RECORD_SIZE];
+    uint64_t limit;
+    int result;
+
+    /* Check that the request will not wrap the counter around */
+    if (count > (~((uint64_t)0)) - state->counter)
+        return -1;
+
+    /* Nothing to do if there is no persistence or the values are reserved */
+    if (!(state->persist) || (state->counter + count) <= state->limit)
+        return 0;
+
+    /* Reserve the counter values that are needed plus another block */
+    limit = state->counter + count;
+    if (state->reserve <= (~((uint64_t)0)) - limit)
+        limit += state->reserve;
+    else
+        limit = ~((uint64_t)0);
+
+    /* The reservation must be saved before any of it is used */
+    memcpy(record, state->base, ASCON_NONCE_SIZE);
+    be_store_word64(record + ASCON_NONCE_SIZE, limit);
+    result = (*(state->persist))(state->arg, record);
+    ascon_clean(record, sizeof(record));
+    if (result != 0)
+        return -1;
+    state->limit = limit;
+    return 0;
+}
+
+/**
+ * \brief Combines the base with the next counter value to make a nonce.
+ *
+ * \param state The nonce sequencer.
+ * \param npub Points to the buffer to receive the nonce.
+ */
+static void ascon_nonce_generate
+    (ascon_nonce_state_t *state, unsigned char *npub)
+{
+    unsigned char ctr[8];
+    be_store_word64(ctr, state->counter);
+    memcpy(npub, state->base, ASCON_NONCE_SIZE - 8);
+    lw_xor_block_2_src(npub + ASCON_NONCE_SIZE - 8,
+                       state->base + ASCON_NONCE_SIZE - 8, ctr, 8);
+    ++(state->counter);
+}
+
+int ascon_nonce_init
+    (ascon_nonce_state_t *state, uint32_t reserve,
+     ascon_nonce_persist_t persist, void *arg)
+{
+    int ok = ascon_random(state->base, ASCON_NONCE_SIZE);
+    state->counter = 0;
+    state->limit = 0;
+    state->reserve = reserve ? reserve : ASCON_NONCE_DEFAULT_RESERVE;
+    state->persist = persist;
+    state->arg = arg;
+    return ok;
+}
+
+void ascon_nonce_restore
+    (ascon_nonce_state_t *state, const unsigned char *record,
+     uint32_t reserve, ascon_nonce_persist_t persist, void *arg)
+{
+    memcpy(state->base, record, ASCON_NONCE_SIZE);
+    state->counter = be_load_word64(record + ASCON_NONCE_SIZE);
+    state->limit = state->counter;
+    state->reserve = reserve ? reserve : ASCON_NONCE_DEFAULT_RESERVE;
+    state->persist = persist;
+    state->arg = arg;
+}
+
+void ascon_nonce_free(ascon_nonce_state_t *state)
+{
+    if (state)
+        ascon_clean(state, sizeof(ascon_nonce_state_t));
+}
+
+int ascon_nonce_next(ascon_nonce_state_t *state, unsigned char *npub)
+{
+    if (ascon_nonce_reserve(state, 1) < 0)
+        return -1;
+    ascon_nonce_generate(state, npub);
+    return 0;
+}
+
+int ascon_nonce_fill_batch
+    (ascon_nonce_state_t *state, ascon_aead_batch_t *msgs, size_t count,
+     unsigned char *nonces)
+{
+    if (ascon_nonce_reserve(state, count) < 0)
+        return -1;
+    while (count > 0) {
+        ascon_nonce_generate(state, nonces);
+        msgs->npub = nonces;
+        nonces += ASCON_NONCE_SIZE;
+        ++msgs;
+        --count;
+    }
+    return 0;
+}
+
+/* Header of a slot in a retransmission cache, which is followed by the
+ * ciphertext and tag of the frame.  The slot is empty if "last_used"
+ * is zero.  The size is a multiple of 8 so that the slots stay aligned. */
+typedef struct
+{
+    uint64_t seq;
+    uint32_t key_id;
+    uint32_t last_used;
+    uint64_t clen;
+    unsigned char npub[ASCON_NONCE_SIZE];
+
+} ascon_nonce_slot_t;
+
+/* Gets a pointer to a slot in a retransmission cache */
+#define ascon_nonce_cache_slot(cache, index) \
+    ((ascon_nonce_slot_t *)((cache)->slots + (index) * (cache)->slot_size))
+
+/**
+ * \brief Advances the clock of a retransmission cache.
+ *
+ * \param cache The retransmission cache.
+ *
+ * \return The new clock value to mark a slot as the most recently used.
+ */
+static uint32_t ascon_nonce_cache_tick(ascon_nonce_cache_t *cache)
+{
+    unsigned index;
+    if (cache->clock == 0xFFFFFFFFU) {
+        /* The clock has run out.  Start it again, keeping the frames
+         * but forgetting the order in which they were used */
+        for (index = 0; index < cache->num_slots; ++index) {
+            ascon_nonce_slot_t *slot = ascon_nonce_cache_slot(cache, index);
+            if (slot->last_used != 0)
+                slot->last_used = 1;
+        }
+        cache->clock = 1;
+    }
+    return ++(cache->clock);
+}
+
+unsigned ascon_nonce_cache_init
+    (ascon_nonce_cache_t *cache, void *buffer, size_t size, size_t max_mlen)
+{
+    cache->slots = (unsigned char *)buffer;
+    cache->max_clen = max_mlen + ASCON128_TAG_SIZE;
+    cache->slot_size = (sizeof(ascon_nonce_slot_t) + cache->max_clen + 7U) &
+                       ~((size_t)7);
+    cache->num_slots = buffer ? (unsigned)(size / cache->slot_size) : 0;
+    cache->clock = 0;
+    if (cache->num_slots > 0)
+        memset(buffer, 0, cache->num_slots * cache->slot_size);
+    return cache->num_slots;
+}
+
+void ascon_nonce_cache_free(ascon_nonce_cache_t *cache)
+{
+    unsigned index;
+    if (cache) {
+        for (index = 0; index < cache->num_slots; ++index) {
+            ascon_clean(ascon_nonce_cache_slot(cache, index),
+                        (unsigned)(cache->slot_size));
+        }
+        ascon_clean(cache, sizeof(ascon_nonce_cache_t));
+    }
+}
+
+int ascon_nonce_cache_encrypt
+    (ascon_nonce_cache_t *cache, ascon_nonce_state_t *state,
+     uint32_t key_id, uint64_t seq, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     unsigned char *npub, const unsigned char *k)
+{
+    ascon_nonce_slot_t *slot;
+    ascon_nonce_slot_t *victim = 0;
+    unsigned index;
+
+    /* Resend the frame from the cache if it is there, and look for the
+     * least recently used slot along the way in case it is not */
+    for (index = 0; index < cache->num_slots; ++index) {
+        slot = ascon_nonce_cache_slot(cache, index);
+        if (slot->last_used != 0 && slot->key_id == key_id &&
+                slot->seq == seq) {
+            *clen = (size_t)(slot->clen);
+            memcpy(c, slot + 1, *clen);
+            memcpy(npub, slot->npub, ASCON_NONCE_SIZE);
+            slot->last_used = ascon_nonce_cache_tick(cache);
+            return 1;
+        }
+        if (!victim || slot->last_used < victim->last_used)
+            victim = slot;
+    }
+
+    /* Encrypt the frame for the first time with a new nonce */
+    if (ascon_nonce_next(state, npub) < 0)
+        return -1;
+    ascon128a_aead_encrypt(c, clen, m, mlen, ad, adlen, npub, k);
+
+    /* Wipe the least recently used frame and put this one in its place */
+    if (victim && *clen <= cache->max_clen) {
+        ascon_clean(victim, (unsigned)(cache->slot_size));
+        victim->seq = seq;
+        victim->key_id = key_id;
+        victim->clen = *clen;
+        memcpy(victim->npub, npub, ASCON_NONCE_SIZE);
+        memcpy(victim + 1, c, *clen);
+        victim->last_used = ascon_nonce_cache_tick(cache);
+    }
+    return 0;
+}
+
+void ascon_nonce_cache_forget
+    (ascon_nonce_cache_t *cache, uint32_t key_id, uint64_t seq)
+{
+    unsigned index;
+    for (index = 0; index < cache->num_slots; ++index) {
+        ascon_nonce_slot_t *slot = ascon_nonce_cache_slot(cache, index);
+        if (slot->last_used != 0 && slot->key_id == key_id &&
+                slot->seq == seq) {
+            ascon_clean(slot, (unsigned)(cache->slot_size));
+        }
+    }
+}
+
+void ascon_nonce_cache_forget_key(ascon_nonce_cache_t *cache, uint32_t key_id)
+{
+    unsigned index;
+    for (index = 0; index < cache->num_slots; ++index) {
+        ascon_nonce_slot_t *slot = ascon_nonce_cache_slot(cache, index);
+        if (slot->last_used != 0 && slot->key_id == key_id)
+            ascon_clean(slot, (unsigned)(cache->slot_size));
+    }
+}
+
+#endif /* ASCON_ENABLE_AEAD */
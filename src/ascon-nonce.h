@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_NONCE_H
+#define ASCON_NONCE_H
+
+/**
+ * \file ascon-nonce.h
+ * \brief Nonce sequencer for the ASCON AEAD modes.
+ *
+ * The nonce sequencer derives unique 128-bit nonces from a random base
+ * plus a 64-bit monotonic counter.  The system random number source is
+ * only needed once to generate the base, not once per packet.
+ *
+ * Nonces must never repeat under the same key, including across
+ * reboots.  The sequencer supports this with a persistence hook.
+ * Before it hands out a nonce beyond the last saved reservation, it
+ * reserves a block of counter values and asks the application to save
+ * a small record to non-volatile memory.  On the next boot, the
+ * application restores the record and the sequencer carries on from
+ * the end of the reservation.  At most one block of counter values is
+ * skipped per reboot, and the non-volatile memory is only written once
+ * per block.
+ *
+ * Links that retransmit the same frame several times can put a
+ * retransmission cache in front of the sequencer.  The first time a
+ * frame is sent, ascon_nonce_cache_encrypt() takes a nonce from the
+ * sequencer, encrypts the frame with ASCON-128a, and keeps the nonce,
+ * ciphertext, and tag under the key identifier and sequence number of
+ * the frame.  Resending the frame copies them out of the cache instead
+ * of encrypting it again.  The cache lives in a buffer that is supplied
+ * by the application, and the least recently used frame is wiped and
+ * evicted when the buffer is full.
+ *
+ * \code
+ * static uint64_t cache_buffer[256 / 8];
+ * ascon_nonce_cache_t cache;
+ * ascon_nonce_cache_init(&cache, cache_buffer, sizeof(cache_buffer), 48);
+ * ...
+ * ascon_nonce_cache_encrypt
+ *     (&cache, &nonces, key_id, seq, c, &clen, m, mlen, ad, adlen, npub, k);
+ * ...
+ * // Once the frame has been acknowledged:
+ * ascon_nonce_cache_forget(&cache, key_id, seq);
+ * \endcode
+ */
+
+#include "ascon-aead.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of the nonces that are generated by the sequencer.
+ */
+#define ASCON_NONCE_SIZE 16
+
+/**
+ * \brief Size of the persistence record for a nonce sequencer.
+ */
+#define ASCON_NONCE_RECORD_SIZE 24
+
+/**
+ * \brief Default number of counter values to reserve each time the
+ * persistence record is saved.
+ */
+#define ASCON_NONCE_DEFAULT_RESERVE 1024
+
+/**
+ * \brief Callback that saves the persistence record of a nonce sequencer
+ * to non-volatile memory.
+ *
+ * \param arg Application-supplied argument that was passed when the
+ * sequencer was initialized.
+ * \param record Points to the ASCON_NONCE_RECORD_SIZE bytes of the record.
+ *
+ * \return Zero if the record was saved, or non-zero on failure.
+ * The sequencer will not produce nonces from the new reservation unless
+ * the record was saved successfully.
+ */
+typedef int (*ascon_nonce_persist_t)(void *arg, const unsigned char *record);
+
+/**
+ * \brief State information for a nonce sequencer.
+ *
+ * The application should treat this structure as opaque.
+ */
+typedef struct
+{
+    /** Random base that the counter is combined with */
+    unsigned char base[ASCON_NONCE_SIZE];
+
+    /** Next counter value to use */
+    uint64_t counter;
+
+    /** End of the counter values that have been reserved and saved */
+    uint64_t limit;
+
+    /** Number of counter values to reserve at a time */
+    uint32_t reserve;
+
+    /** Callback to save the persistence record, or NULL */
+    ascon_nonce_persist_t persist;
+
+    /** Argument to pass to the persistence callback */
+    void *arg;
+
+} ascon_nonce_state_t;
+
+/**
+ * \brief Initializes a nonce sequencer with a new random base.
+ *
+ * \param state The nonce sequencer to initialize.
+ * \param reserve Number of counter values to reserve at a time,
+ * or zero for ASCON_NONCE_DEFAULT_RESERVE.
+ * \param persist Callback to save the persistence record, or NULL if the
+ * sequencer does not need to survive reboots.
+ * \param arg Argument to pass to \a persist.
+ *
+ * \return Non-zero if the system random number source is working;
+ * zero if there is no system random number source or it has failed.
+ *
+ * Use a new sequencer each time a new key is established.
+ *
+ * \sa ascon_nonce_restore(), ascon_nonce_next()
+ */
+int ascon_nonce_init
+    (ascon_nonce_state_t *state, uint32_t reserve,
+     ascon_nonce_persist_t persist, void *arg);
+
+/**
+ * \brief Restores a nonce sequencer from a persistence record.
+ *
+ * \param state The nonce sequencer to restore.
+ * \param record Points to the ASCON_NONCE_RECORD_SIZE bytes of the record
+ * that was last saved by \a persist.
+ * \param reserve Number of counter values to reserve at a time,
+ * or zero for ASCON_NONCE_DEFAULT_RESERVE.
+ * \param persist Callback to save the persistence record.
+ * \param arg Argument to pass to \a persist.
+ *
+ * The counter resumes at the end of the saved reservation, so nonces
+ * that may have been used before the reboot will not be repeated.
+ *
+ * \sa ascon_nonce_init()
+ */
+void ascon_nonce_restore
+    (ascon_nonce_state_t *state, const unsigned char *record,
+     uint32_t reserve, ascon_nonce_persist_t persist, void *arg);
+
+/**
+ * \brief Frees a nonce sequencer and destroys any sensitive values.
+ *
+ * \param state The nonce sequencer to free.
+ */
+void ascon_nonce_free(ascon_nonce_state_t *state);
+
+/**
+ * \brief Generates the next nonce from a nonce sequencer.
+ *
+ * \param state The nonce sequencer.
+ * \param npub Points to a buffer to receive the ASCON_NONCE_SIZE bytes
+ * of the nonce.
+ *
+ * \return 0 on success, or -1 if the counter is exhausted or the
+ * persistence record could not be saved.  No nonce is generated on error.
+ */
+int ascon_nonce_next(ascon_nonce_state_t *state, unsigned char *npub);
+
+/**
+ * \brief Generates nonces for a batch of AEAD messages.
+ *
+ * \param state The nonce sequencer.
+ * \param msgs Points to the array of messages in the batch.
+ * \param count Number of messages in the batch.
+ * \param nonces Points to a buffer of count * ASCON_NONCE_SIZE bytes
+ * to hold the nonces, which must remain valid until the batch has
+ * been encrypted.
+ *
+ * \return 0 on success, or -1 if there are not enough counter values
+ * left or the persistence record could not be saved.  No nonces are
+ * generated on error.
+ *
+ * On success, the \a npub field of each message points to its nonce
+ * within \a nonces.  A single reservation covers the whole batch.
+ *
+ * \sa ascon128_aead_encrypt_batch(), ascon128a_aead_encrypt_batch()
+ */
+int ascon_nonce_fill_batch
+    (ascon_nonce_state_t *state, ascon_aead_batch_t *msgs, size_t count,
+     unsigned char *nonces);
+
+/**
+ * \brief Retransmission cache for frames that were encrypted with
+ * nonces from a sequencer.
+ *
+ * The application should treat this structure as opaque.
+ */
+typedef struct
+{
+    /** Buffer that holds the cached frames */
+    unsigned char *slots;
+
+    /** Size of each slot in the buffer, including its header */
+    size_t slot_size;
+
+    /** Largest ciphertext plus tag that fits in a slot */
+    size_t max_clen;
+
+    /** Number of slots in the buffer */
+    unsigned num_slots;
+
+    /** Clock for finding the least recently used slot */
+    uint32_t clock;
+
+} ascon_nonce_cache_t;
+
+/**
+ * \brief Initializes a retransmission cache.
+ *
+ * \param cache The retransmission cache to initialize.
+ * \param buffer Buffer to hold the cached frames, which must be aligned
+ * like a uint64_t and must remain valid until the cache is freed.
+ * \param size Size of \a buffer in bytes, which is the memory budget
+ * for the cache.
+ * \param max_mlen Length of the largest plaintext frame that should be
+ * cached.  Larger frames are still encrypted but are not cached.
+ *
+ * \return The number of frames that the cache can hold, which is zero
+ * if \a size is too small for even one frame.
+ *
+ * \sa ascon_nonce_cache_encrypt(), ascon_nonce_cache_free()
+ */
+unsigned ascon_nonce_cache_init
+    (ascon_nonce_cache_t *cache, void *buffer, size_t size, size_t max_mlen);
+
+/**
+ * \brief Frees a retransmission cache and destroys the cached frames.
+ *
+ * \param cache The retransmission cache to free.
+ */
+void ascon_nonce_cache_free(ascon_nonce_cache_t *cache);
+
+/**
+ * \brief Encrypts a frame with ASCON-128a, or copies it from the
+ * retransmission cache if it has been sent before.
+ *
+ * \param cache The retransmission cache.
+ * \param state The nonce sequencer for \a k.
+ * \param key_id Identifier for \a k, which must be different for every
+ * key that shares the cache.
+ * \param seq Sequence number of the frame.
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext frame to encrypt.
+ * \param mlen Length of the plaintext frame in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the frame but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to a buffer to receive the ASCON_NONCE_SIZE bytes
+ * of the nonce that the frame was encrypted with.
+ * \param k Points to the 16 bytes of the key to use to encrypt the frame.
+ *
+ * \return 1 if the frame was copied from the cache, 0 if it was
+ * encrypted with a new nonce, or -1 if the nonce sequencer could not
+ * produce a nonce.
+ *
+ * A frame that is found in the cache is not encrypted again, so \a m
+ * and \a ad are ignored.  The application must give a new sequence
+ * number to every frame with different contents; the cached frame is
+ * always sent as it was the first time.
+ *
+ * \sa ascon_nonce_cache_forget()
+ */
+int ascon_nonce_cache_encrypt
+    (ascon_nonce_cache_t *cache, ascon_nonce_state_t *state,
+     uint32_t key_id, uint64_t seq, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     unsigned char *npub, const unsigned char *k);
+
+/**
+ * \brief Wipes a frame from a retransmission cache, once it has been
+ * acknowledged.
+ *
+ * \param cache The retransmission cache.
+ * \param key_id Identifier for the key that the frame was encrypted with.
+ * \param seq Sequence number of the frame.
+ *
+ * It is not an error if the frame is not in the cache.
+ */
+void ascon_nonce_cache_forget
+    (ascon_nonce_cache_t *cache, uint32_t key_id, uint64_t seq);
+
+/**
+ * \brief Wipes all frames that were encrypted with a key from a
+ * retransmission cache.
+ *
+ * \param cache The retransmission cache.
+ * \param key_id Identifier for the key, which is being retired.
+ */
+void ascon_nonce_cache_forget_key(ascon_nonce_cache_t *cache, uint32_t key_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
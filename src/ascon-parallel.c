@@ -0,0 +1,553 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-parallel.h"
+#include "ascon-utility.h"
+#include "utility/ascon-aead-common.h"
+#include "utility/ascon-util.h"
+
+/**
+ * \def ASCON_PARALLEL_FREERTOS
+ * \brief Define to 1 to use a FreeRTOS task on the other core of a
+ * dual-core ESP32 as the helper.
+ *
+ * \def ASCON_PARALLEL_PTHREADS
+ * \brief Define to 1 to use a POSIX thread as the helper.
+ *
+ * These are selected automatically based on the platform.  Define
+ * ASCON_PARALLEL_NONE to always process batches on the calling task.
+ */
+#if defined(ESP32) || defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#if !defined(ASCON_PARALLEL_FREERTOS) && !defined(ASCON_PARALLEL_NONE) && \
+    portNUM_PROCESSORS > 1
+#define ASCON_PARALLEL_FREERTOS 1
+#endif
+#elif !defined(ARDUINO) && (defined(__linux__) || defined(__APPLE__) || \
+    defined(__unix__))
+#if !defined(ASCON_PARALLEL_PTHREADS) && !defined(ASCON_PARALLEL_NONE)
+#define ASCON_PARALLEL_PTHREADS 1
+#endif
+#include <pthread.h>
+#endif
+
+#if !defined(ASCON_PARALLEL_FREERTOS)
+#define ASCON_PARALLEL_FREERTOS 0
+#endif
+#if !defined(ASCON_PARALLEL_PTHREADS)
+#define ASCON_PARALLEL_PTHREADS 0
+#endif
+
+/**
+ * \def ASCON_PARALLEL_STACK_SIZE
+ * \brief Size of the stack for the FreeRTOS helper task in bytes.
+ */
+#if !defined(ASCON_PARALLEL_STACK_SIZE)
+#define ASCON_PARALLEL_STACK_SIZE 4096
+#endif
+
+typedef struct ascon_parallel_job_s ascon_parallel_job_t;
+
+/**
+ * \brief Processes a chunk of messages from a parallel job.
+ *
+ * \param job The job that is being processed.
+ * \param start Index of the first message in the chunk.
+ * \param count Number of messages in the chunk.
+ *
+ * \return 0 on success or -1 if at least one message failed.
+ */
+typedef int (*ascon_parallel_func_t)
+    (const ascon_parallel_job_t *job, size_t start, size_t count);
+
+/**
+ * \brief Information about a batch that is being processed in parallel.
+ */
+struct ascon_parallel_job_s
+{
+    /** Function that processes a chunk of messages */
+    ascon_parallel_func_t func;
+
+    /** Messages for AEAD batches */
+    ascon_aead_batch_t *msgs;
+
+    /** Output buffer for hash batches */
+    unsigned char *out;
+
+    /** Input messages for hash batches */
+    const unsigned char * const *in;
+
+    /** Input message lengths for hash batches */
+    const size_t *inlen;
+
+    /** Output buffer for counter mode */
+    unsigned char *ctr_out;
+
+    /** Input buffer for counter mode */
+    const unsigned char *ctr_in;
+
+    /** Length of the input for counter mode */
+    size_t ctr_len;
+
+    /** Nonce for counter mode */
+    const unsigned char *nonce;
+
+    /** Key for counter mode */
+    const unsigned char *key;
+
+    /** XOR of the counter mode segment tags, updated atomically */
+    uint64_t sum[2];
+
+    /** Total number of messages in the batch */
+    size_t count;
+
+    /** Index of the next message in the work queue, updated atomically */
+    size_t next;
+
+    /** Result from the helper task */
+    int helper_result;
+
+#if ASCON_PARALLEL_FREERTOS
+    /** Semaphore that is given when the helper task has finished */
+    SemaphoreHandle_t done;
+
+    /** Storage for the semaphore */
+    StaticSemaphore_t done_storage;
+#endif
+};
+
+/**
+ * \brief Pulls chunks off the work queue for a job until the job is done.
+ *
+ * \param job The job to process.
+ *
+ * \return 0 on success or -1 if at least one message failed.
+ */
+static int ascon_parallel_process(ascon_parallel_job_t *job)
+{
+    size_t start, count;
+    int result = 0;
+    for (;;) {
+#if ASCON_PARALLEL_FREERTOS || ASCON_PARALLEL_PTHREADS
+        start = __atomic_fetch_add
+            (&(job->next), ASCON_PARALLEL_CHUNK, __ATOMIC_RELAXED);
+#else
+        /* No helper, so the caller is the only one taking chunks */
+        start = job->next;
+        job->next += ASCON_PARALLEL_CHUNK;
+#endif
+        if (start >= job->count)
+            break;
+        count = job->count - start;
+        if (count > ASCON_PARALLEL_CHUNK)
+            count = ASCON_PARALLEL_CHUNK;
+        result |= (*(job->func))(job, start, count);
+    }
+    return result;
+}
+
+#if ASCON_PARALLEL_FREERTOS
+
+/* States for the lazy creation of the helper task */
+#define ASCON_PARALLEL_UNINIT   0
+#define ASCON_PARALLEL_STARTING 1
+#define ASCON_PARALLEL_READY    2
+#define ASCON_PARALLEL_FAILED   3
+
+static int ascon_parallel_state = ASCON_PARALLEL_UNINIT;
+static QueueHandle_t ascon_parallel_queue = 0;
+
+static void ascon_parallel_helper(void *arg)
+{
+    ascon_parallel_job_t *job;
+    (void)arg;
+    for (;;) {
+        if (xQueueReceive(ascon_parallel_queue, &job, portMAX_DELAY)) {
+            job->helper_result = ascon_parallel_process(job);
+            xSemaphoreGive(job->done);
+        }
+    }
+}
+
+/**
+ * \brief Starts the helper task if it is not already running.
+ *
+ * \return Non-zero if the helper task is ready to accept jobs.
+ *
+ * If two tasks try to start the helper at the same time, then one of
+ * them will process its batch by itself rather than waiting.
+ */
+static int ascon_parallel_start(void)
+{
+    int state = ASCON_PARALLEL_UNINIT;
+    if (__atomic_load_n(&ascon_parallel_state, __ATOMIC_ACQUIRE) ==
+            ASCON_PARALLEL_READY) {
+        return 1;
+    }
+    if (!__atomic_compare_exchange_n
+            (&ascon_parallel_state, &state, ASCON_PARALLEL_STARTING,
+             0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    ascon_parallel_queue = xQueueCreate(1, sizeof(ascon_parallel_job_t *));
+    if (ascon_parallel_queue &&
+            xTaskCreatePinnedToCore
+                (ascon_parallel_helper, "ascon", ASCON_PARALLEL_STACK_SIZE,
+                 0, uxTaskPriorityGet(0), 0,
+                 xPortGetCoreID() ? 0 : 1) == pdPASS) {
+        state = ASCON_PARALLEL_READY;
+    } else {
+        if (ascon_parallel_queue) {
+            vQueueDelete(ascon_parallel_queue);
+            ascon_parallel_queue = 0;
+        }
+        state = ASCON_PARALLEL_FAILED;
+    }
+    __atomic_store_n(&ascon_parallel_state, state, __ATOMIC_RELEASE);
+    return state == ASCON_PARALLEL_READY;
+}
+
+#elif ASCON_PARALLEL_PTHREADS
+
+static void *ascon_parallel_helper(void *arg)
+{
+    ascon_parallel_job_t *job = (ascon_parallel_job_t *)arg;
+    job->helper_result = ascon_parallel_process(job);
+    return 0;
+}
+
+#endif
+
+/**
+ * \brief Runs a job, using the helper task if possible.
+ *
+ * \param job The job to run.
+ *
+ * \return 0 on success or -1 if at least one message failed.
+ */
+static int ascon_parallel_run(ascon_parallel_job_t *job)
+{
+    int result;
+    job->next = 0;
+    job->helper_result = 0;
+    if (job->count < ASCON_PARALLEL_CHUNK * 2)
+        return (*(job->func))(job, 0, job->count);
+#if ASCON_PARALLEL_FREERTOS
+    if (ascon_parallel_start()) {
+        job->done = xSemaphoreCreateBinaryStatic(&(job->done_storage));
+        xQueueSend(ascon_parallel_queue, &job, portMAX_DELAY);
+        result = ascon_parallel_process(job);
+        xSemaphoreTake(job->done, portMAX_DELAY);
+        vSemaphoreDelete(job->done);
+        return result | job->helper_result;
+    }
+#elif ASCON_PARALLEL_PTHREADS
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, 0, ascon_parallel_helper, job) == 0) {
+            result = ascon_parallel_process(job);
+            pthread_join(thread, 0);
+            return result | job->helper_result;
+        }
+    }
+#endif
+    (void)result;
+    return ascon_parallel_process(job);
+}
+
+int ascon_parallel_is_available(void)
+{
+    return ASCON_PARALLEL_FREERTOS || ASCON_PARALLEL_PTHREADS;
+}
+
+#if ASCON_ENABLE_AEAD
+
+static int ascon128_encrypt_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    ascon128_aead_encrypt_batch(job->msgs + start, count);
+    return 0;
+}
+
+static int ascon128_decrypt_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    return ascon128_aead_decrypt_batch(job->msgs + start, count);
+}
+
+static int ascon128a_encrypt_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    ascon128a_aead_encrypt_batch(job->msgs + start, count);
+    return 0;
+}
+
+static int ascon128a_decrypt_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    return ascon128a_aead_decrypt_batch(job->msgs + start, count);
+}
+
+/**
+ * \brief Runs a parallel AEAD job.
+ *
+ * \param func Function that processes a chunk of messages.
+ * \param msgs Points to the messages.
+ * \param count Number of messages.
+ *
+ * \return 0 on success or -1 if at least one message failed.
+ */
+static int ascon_parallel_aead
+    (ascon_parallel_func_t func, ascon_aead_batch_t *msgs, size_t count)
+{
+    ascon_parallel_job_t job;
+    job.func = func;
+    job.msgs = msgs;
+    job.out = 0;
+    job.in = 0;
+    job.inlen = 0;
+    job.ctr_out = 0;
+    job.ctr_in = 0;
+    job.ctr_len = 0;
+    job.nonce = 0;
+    job.key = 0;
+    job.count = count;
+    return ascon_parallel_run(&job);
+}
+
+void ascon128_aead_encrypt_parallel(ascon_aead_batch_t *msgs, size_t count)
+{
+    ascon_parallel_aead(ascon128_encrypt_chunk, msgs, count);
+}
+
+int ascon128_aead_decrypt_parallel(ascon_aead_batch_t *msgs, size_t count)
+{
+    return ascon_parallel_aead(ascon128_decrypt_chunk, msgs, count);
+}
+
+void ascon128a_aead_encrypt_parallel(ascon_aead_batch_t *msgs, size_t count)
+{
+    ascon_parallel_aead(ascon128a_encrypt_chunk, msgs, count);
+}
+
+int ascon128a_aead_decrypt_parallel(ascon_aead_batch_t *msgs, size_t count)
+{
+    return ascon_parallel_aead(ascon128a_decrypt_chunk, msgs, count);
+}
+
+#endif /* ASCON_ENABLE_AEAD */
+
+#if ASCON_ENABLE_HASH
+
+static int ascon_hash_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    ascon_hash_many
+        (job->out + start * ASCON_HASH_SIZE, job->in + start,
+         job->inlen + start, count);
+    return 0;
+}
+
+static int ascon_hasha_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    ascon_hasha_many
+        (job->out + start * ASCON_HASH_SIZE, job->in + start,
+         job->inlen + start, count);
+    return 0;
+}
+
+/**
+ * \brief Runs a parallel hashing job.
+ *
+ * \param func Function that processes a chunk of messages.
+ * \param out Buffer to receive the hash outputs.
+ * \param in Array of pointers to the messages to be hashed.
+ * \param inlen Array of message lengths in bytes.
+ * \param count Number of messages.
+ */
+static void ascon_parallel_hash
+    (ascon_parallel_func_t func, unsigned char *out,
+     const unsigned char * const *in, const size_t *inlen, size_t count)
+{
+    ascon_parallel_job_t job;
+    job.func = func;
+    job.msgs = 0;
+    job.out = out;
+    job.in = in;
+    job.inlen = inlen;
+    job.ctr_out = 0;
+    job.ctr_in = 0;
+    job.ctr_len = 0;
+    job.nonce = 0;
+    job.key = 0;
+    job.count = count;
+    ascon_parallel_run(&job);
+}
+
+void ascon_hash_many_parallel
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count)
+{
+    ascon_parallel_hash(ascon_hash_chunk, out, in, inlen, count);
+}
+
+void ascon_hasha_many_parallel
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count)
+{
+    ascon_parallel_hash(ascon_hasha_chunk, out, in, inlen, count);
+}
+
+/**
+ * \brief Processes a chunk of segments for counter mode.
+ *
+ * \param job The job that is being processed.
+ * \param start Index of the first segment in the chunk.
+ * \param count Number of segments in the chunk.
+ * \param decrypt Non-zero to decrypt, or zero to encrypt.
+ *
+ * \return Always 0 because the job has already checked the length.
+ */
+static int ascon_prf_ctr_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count, int decrypt)
+{
+    ascon_parallel_job_t *j = (ascon_parallel_job_t *)job;
+    unsigned char sum[ASCON_PRF_CTR_TAG_SIZE] = {0};
+    size_t posn = start * ASCON_PRF_CTR_SEGMENT_SIZE;
+    size_t len = count * ASCON_PRF_CTR_SEGMENT_SIZE;
+    if (len > job->ctr_len - posn)
+        len = job->ctr_len - posn;
+    if (decrypt) {
+        ascon_prf_ctr_decrypt_segments
+            (job->ctr_out + posn, sum, job->ctr_in + posn, len, start,
+             job->nonce, job->key);
+    } else {
+        ascon_prf_ctr_encrypt_segments
+            (job->ctr_out + posn, sum, job->ctr_in + posn, len, start,
+             job->nonce, job->key);
+    }
+
+    /* The segment tags are combined with XOR, so the order in which
+     * the tasks add their partial sums does not matter */
+#if ASCON_PARALLEL_FREERTOS || ASCON_PARALLEL_PTHREADS
+    __atomic_fetch_xor(&(j->sum[0]), be_load_word64(sum), __ATOMIC_RELAXED);
+    __atomic_fetch_xor
+        (&(j->sum[1]), be_load_word64(sum + 8), __ATOMIC_RELAXED);
+#else
+    j->sum[0] ^= be_load_word64(sum);
+    j->sum[1] ^= be_load_word64(sum + 8);
+#endif
+    ascon_clean(sum, sizeof(sum));
+    return 0;
+}
+
+static int ascon_prf_ctr_encrypt_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    return ascon_prf_ctr_chunk(job, start, count, 0);
+}
+
+static int ascon_prf_ctr_decrypt_chunk
+    (const ascon_parallel_job_t *job, size_t start, size_t count)
+{
+    return ascon_prf_ctr_chunk(job, start, count, 1);
+}
+
+/**
+ * \brief Runs a parallel counter mode job.
+ *
+ * \param func Function that processes a chunk of segments.
+ * \param sum Buffer to receive the XOR of the segment tags.
+ * \param out Buffer to receive the output.
+ * \param in Points to the input.
+ * \param len Length of the input in bytes.
+ * \param nonce Points to the nonce.
+ * \param key Points to the key.
+ *
+ * \return 0 on success, or -1 if the input is too long.
+ */
+static int ascon_parallel_prf_ctr
+    (ascon_parallel_func_t func, unsigned char *sum,
+     unsigned char *out, const unsigned char *in, size_t len,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    ascon_parallel_job_t job;
+    if (((uint64_t)len) > ASCON_PRF_CTR_MAX_LENGTH)
+        return -1;
+    job.func = func;
+    job.msgs = 0;
+    job.out = 0;
+    job.in = 0;
+    job.inlen = 0;
+    job.ctr_out = out;
+    job.ctr_in = in;
+    job.ctr_len = len;
+    job.nonce = nonce;
+    job.key = key;
+    job.sum[0] = 0;
+    job.sum[1] = 0;
+    job.count = (len + ASCON_PRF_CTR_SEGMENT_SIZE - 1) /
+                ASCON_PRF_CTR_SEGMENT_SIZE;
+    ascon_parallel_run(&job);
+    be_store_word64(sum, job.sum[0]);
+    be_store_word64(sum + 8, job.sum[1]);
+    return 0;
+}
+
+int ascon_prf_ctr_encrypt_parallel
+    (unsigned char *c, unsigned char *tag,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    unsigned char sum[ASCON_PRF_CTR_TAG_SIZE];
+    if (ascon_parallel_prf_ctr
+            (ascon_prf_ctr_encrypt_chunk, sum, c, m, mlen, nonce, key) < 0)
+        return -1;
+    ascon_prf_ctr_final_tag(tag, sum, mlen, nonce, key);
+    ascon_clean(sum, sizeof(sum));
+    return 0;
+}
+
+int ascon_prf_ctr_decrypt_parallel
+    (unsigned char *m, const unsigned char *c, size_t clen,
+     const unsigned char *tag,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    unsigned char sum[ASCON_PRF_CTR_TAG_SIZE];
+    unsigned char tag2[ASCON_PRF_CTR_TAG_SIZE];
+    int result;
+    if (ascon_parallel_prf_ctr
+            (ascon_prf_ctr_decrypt_chunk, sum, m, c, clen, nonce, key) < 0)
+        return -1;
+    ascon_prf_ctr_final_tag(tag2, sum, clen, nonce, key);
+    result = ascon_aead_check_tag(m, clen, tag, tag2, sizeof(tag2));
+    ascon_clean(sum, sizeof(sum));
+    ascon_clean(tag2, sizeof(tag2));
+    return result;
+}
+
+#endif /* ASCON_ENABLE_HASH */
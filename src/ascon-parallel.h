@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_PARALLEL_H
+#define ASCON_PARALLEL_H
+
+/**
+ * \file ascon-parallel.h
+ * \brief Batch operations that are spread across multiple CPU cores.
+ *
+ * The functions in this file perform the same operations as the batch
+ * AEAD and hashing functions, but split the messages in the batch
+ * between the calling task and a helper task on another CPU core.
+ * Both tasks pull chunks of ASCON_PARALLEL_CHUNK messages from a
+ * shared work queue until the batch is exhausted, so messages of
+ * differing lengths are balanced automatically.
+ *
+ * On dual-core ESP32 systems, the helper is a FreeRTOS task that is
+ * pinned to the other core and created the first time it is needed.
+ * On host systems with POSIX threads, a helper thread is created for
+ * each batch.  On all other platforms, and for small batches, the
+ * functions simply call the regular batch functions.
+ *
+ * The messages in a batch must be independent of each other; i.e. the
+ * output buffer for one message must not overlap with the input or
+ * output buffers of any other message.
+ */
+
+#include "ascon-aead.h"
+#include "ascon-hash.h"
+#include "ascon-prf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \def ASCON_PARALLEL_CHUNK
+ * \brief Number of messages that a task takes from the work queue at
+ * a time.
+ *
+ * The default of 4 allows back ends that can permute four states at
+ * once to process each chunk side by side.  Batches with fewer than
+ * twice this many messages are processed on the calling task only.
+ */
+#if !defined(ASCON_PARALLEL_CHUNK)
+#define ASCON_PARALLEL_CHUNK 4
+#endif
+
+/**
+ * \brief Determine if the batch operations in this file can use
+ * more than one CPU core on this platform.
+ *
+ * \return Non-zero if multiple cores can be used, or zero if the
+ * operations are always performed on the calling task.
+ */
+int ascon_parallel_is_available(void);
+
+/**
+ * \brief Encrypts and authenticates a batch of independent messages
+ * with ASCON-128, using multiple CPU cores if available.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * \sa ascon128_aead_encrypt_batch()
+ */
+void ascon128_aead_encrypt_parallel(ascon_aead_batch_t *msgs, size_t count);
+
+/**
+ * \brief Decrypts and authenticates a batch of independent messages
+ * with ASCON-128, using multiple CPU cores if available.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * \return 0 if all messages were decrypted successfully, or -1 if the
+ * authentication tag was incorrect for at least one message.
+ *
+ * \sa ascon128_aead_decrypt_batch()
+ */
+int ascon128_aead_decrypt_parallel(ascon_aead_batch_t *msgs, size_t count);
+
+/**
+ * \brief Encrypts and authenticates a batch of independent messages
+ * with ASCON-128a, using multiple CPU cores if available.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * \sa ascon128a_aead_encrypt_batch()
+ */
+void ascon128a_aead_encrypt_parallel(ascon_aead_batch_t *msgs, size_t count);
+
+/**
+ * \brief Decrypts and authenticates a batch of independent messages
+ * with ASCON-128a, using multiple CPU cores if available.
+ *
+ * \param msgs Points to an array of message descriptions.
+ * \param count Number of messages in the array.
+ *
+ * \return 0 if all messages were decrypted successfully, or -1 if the
+ * authentication tag was incorrect for at least one message.
+ *
+ * \sa ascon128a_aead_decrypt_batch()
+ */
+int ascon128a_aead_decrypt_parallel(ascon_aead_batch_t *msgs, size_t count);
+
+/**
+ * \brief Hashes a batch of independent messages with ASCON-HASH,
+ * using multiple CPU cores if available.
+ *
+ * \param out Buffer to receive the hash outputs, which must be at least
+ * \a count * ASCON_HASH_SIZE bytes in length.
+ * \param in Array of pointers to the messages to be hashed.
+ * \param inlen Array of message lengths in bytes.
+ * \param count Number of messages to be hashed.
+ *
+ * \sa ascon_hash_many()
+ */
+void ascon_hash_many_parallel
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count);
+
+/**
+ * \brief Hashes a batch of independent messages with ASCON-HASHA,
+ * using multiple CPU cores if available.
+ *
+ * \param out Buffer to receive the hash outputs, which must be at least
+ * \a count * ASCON_HASH_SIZE bytes in length.
+ * \param in Array of pointers to the messages to be hashed.
+ * \param inlen Array of message lengths in bytes.
+ * \param count Number of messages to be hashed.
+ *
+ * \sa ascon_hasha_many()
+ */
+void ascon_hasha_many_parallel
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count);
+
+/**
+ * \brief Encrypts and authenticates a single large message with ASCON-PRF
+ * counter mode, using multiple CPU cores if available.
+ *
+ * \param c Buffer to receive the ciphertext, which may be the same as \a m.
+ * \param tag Buffer to receive the ASCON_PRF_CTR_TAG_SIZE bytes of the tag.
+ * \param m Points to the plaintext.
+ * \param mlen Length of the plaintext in bytes.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 on success, or -1 if \a mlen is greater than
+ * ASCON_PRF_CTR_MAX_LENGTH.
+ *
+ * The segments of the message are divided between the tasks, and the
+ * output is the same as for ascon_prf_ctr_encrypt().
+ *
+ * \sa ascon_prf_ctr_encrypt()
+ */
+int ascon_prf_ctr_encrypt_parallel
+    (unsigned char *c, unsigned char *tag,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *nonce, const unsigned char *key);
+
+/**
+ * \brief Decrypts and authenticates a single large message with ASCON-PRF
+ * counter mode, using multiple CPU cores if available.
+ *
+ * \param m Buffer to receive the plaintext, which may be the same as \a c.
+ * \param c Points to the ciphertext.
+ * \param clen Length of the ciphertext in bytes.
+ * \param tag Points to the ASCON_PRF_CTR_TAG_SIZE bytes of the tag.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 on success, or -1 if the tag is incorrect or \a clen is
+ * greater than ASCON_PRF_CTR_MAX_LENGTH.  The plaintext is cleared
+ * if the tag is incorrect.
+ *
+ * \sa ascon_prf_ctr_decrypt()
+ */
+int ascon_prf_ctr_decrypt_parallel
+    (unsigned char *m, const unsigned char *c, size_t clen,
+     const unsigned char *tag,
+     const unsigned char *nonce, const unsigned char *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -20,38 +20,103 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-pbkdf2.h"
 #include "ascon-hmac.h"
 #include "ascon-utility.h"
-#include "utility/ascon-util.h"
+#include "utility/ascon-multi.h"
+#include "utility/ascon-util-snp.h"
 #include <string.h>
 
-/* Implementation of the "F" function from RFC 8018, section 5.2 */
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Hashes a 32-byte message for each lane, starting from a
+ * HMAC key midstate.
+ *
+ * \param states Permutation states for the lanes.
+ * \param midstate The inner or outer HMAC key midstate to start from.
+ * \param data Points to the messages on input and the hash values
+ * on output, ASCON_HMAC_SIZE bytes for each lane.
+ * \param lanes Number of lanes.
+ *
+ * The key blocks are a multiple of the rate in size, so every lane
+ * starts on a block boundary and all lanes stay in lock step.
+ */
+static void ascon_pbkdf2_hash_lanes
+    (ascon_state_t **states, const ascon_hash_state_t *midstate,
+     unsigned char *data, unsigned lanes)
+{
+    unsigned index, posn;
+    for (index = 0; index < lanes; ++index)
+        ascon_copy(states[index], &(midstate->xof.state));
+    for (posn = 0; posn < ASCON_HMAC_SIZE; posn += ASCON_XOF_RATE) {
+        for (index = 0; index < lanes; ++index) {
+            ascon_absorb_8
+                (states[index], data + index * ASCON_HMAC_SIZE + posn, 0);
+        }
+        ascon_permute_multi(states, lanes, 0);
+    }
+    for (index = 0; index < lanes; ++index)
+        ascon_pad(states[index], 0);
+    for (posn = 0; posn < ASCON_HMAC_SIZE; posn += ASCON_XOF_RATE) {
+        ascon_permute_multi(states, lanes, 0);
+        for (index = 0; index < lanes; ++index) {
+            ascon_squeeze_8
+                (states[index], data + index * ASCON_HMAC_SIZE + posn, 0);
+        }
+    }
+}
+
+/**
+ * \brief Implementation of the "F" function from RFC 8018, section 5.2,
+ * for several output blocks at once.
+ *
+ * \param pk HMAC key that was pre-computed from the password.
+ * \param T Points to the output blocks, ASCON_HMAC_SIZE bytes per lane.
+ * \param U Points to a temporary buffer the same size as \a T.
+ * \param salt Points to the bytes of the salt.
+ * \param saltlen Number of bytes in the salt.
+ * \param count Number of iterations to perform.
+ * \param blocknum Block number for the first lane.
+ * \param lanes Number of lanes, between 1 and ASCON_MULTI_LANES.
+ */
 static void ascon_pbkdf2_f
-    (ascon_hmac_state_t *state, unsigned char *T, unsigned char *U,
-     const unsigned char *password, size_t passwordlen,
+    (const ascon_hmac_key_t *pk, unsigned char *T, unsigned char *U,
      const unsigned char *salt, size_t saltlen,
-     unsigned long count, unsigned long blocknum)
+     unsigned long count, unsigned long blocknum, unsigned lanes)
 {
+    ascon_hmac_state_t hmac;
+    ascon_state_t state[ASCON_MULTI_LANES];
+    ascon_state_t *states[ASCON_MULTI_LANES];
     unsigned char b[4];
-    be_store_word32(b, blocknum);
-    ascon_hmac_init(state, password, passwordlen);
-    ascon_hmac_update(state, salt, saltlen);
-    ascon_hmac_update(state, b, sizeof(b));
-    ascon_hmac_finalize(state, password, passwordlen, T);
-    if (count > 1) {
-        ascon_hmac_init(state, password, passwordlen);
-        ascon_hmac_update(state, T, ASCON_HMAC_SIZE);
-        ascon_hmac_finalize(state, password, passwordlen, U);
-        lw_xor_block(T, U, ASCON_HMAC_SIZE);
-        while (count > 2) {
-            ascon_hmac_init(state, password, passwordlen);
-            ascon_hmac_update(state, U, ASCON_HMAC_SIZE);
-            ascon_hmac_finalize(state, password, passwordlen, U);
-            lw_xor_block(T, U, ASCON_HMAC_SIZE);
-            --count;
-        }
+    unsigned index;
+
+    /* The first iteration includes the salt, which has a variable length */
+    for (index = 0; index < lanes; ++index) {
+        be_store_word32(b, blocknum + index);
+        ascon_hmac_init_pk(&hmac, pk);
+        ascon_hmac_update(&hmac, salt, saltlen);
+        ascon_hmac_update(&hmac, b, sizeof(b));
+        ascon_hmac_finalize_pk(&hmac, pk, U + index * ASCON_HMAC_SIZE);
+        ascon_hmac_free(&hmac);
+    }
+    memcpy(T, U, lanes * ASCON_HMAC_SIZE);
+
+    /* The remaining iterations hash a single block-aligned 32-byte value
+     * with the inner and then the outer key, for all lanes together */
+    for (index = 0; index < lanes; ++index) {
+        ascon_init(&(state[index]));
+        states[index] = &(state[index]);
     }
+    while (count > 1) {
+        ascon_pbkdf2_hash_lanes(states, &(pk->inner), U, lanes);
+        ascon_pbkdf2_hash_lanes(states, &(pk->outer), U, lanes);
+        lw_xor_block(T, U, lanes * ASCON_HMAC_SIZE);
+        --count;
+    }
+    for (index = 0; index < lanes; ++index)
+        ascon_free(&(state[index]));
 }
 
 void ascon_pbkdf2
@@ -59,25 +124,33 @@ void ascon_pbkdf2
      const unsigned char *password, size_t passwordlen,
      const unsigned char *salt, size_t saltlen, unsigned long count)
 {
-    ascon_hmac_state_t state;
-    unsigned char U[ASCON_HMAC_SIZE];
+    ascon_hmac_key_t pk;
+    unsigned char T[ASCON_HMAC_SIZE * ASCON_MULTI_LANES];
+    unsigned char U[ASCON_HMAC_SIZE * ASCON_MULTI_LANES];
     unsigned long blocknum = 1;
+    size_t blocks, len;
+    unsigned lanes;
+
+    /* Absorb the password-derived key blocks once for all iterations */
+    ascon_hmac_init_key(&pk, password, passwordlen);
+
+    /* Generate as many output blocks side by side as the back end allows */
     while (outlen > 0) {
-        if (outlen >= ASCON_HMAC_SIZE) {
-            ascon_pbkdf2_f(&state, out, U, password, passwordlen,
-                           salt, saltlen, count, blocknum);
-            out += ASCON_HMAC_SIZE;
-            outlen -= ASCON_HMAC_SIZE;
-        } else {
-            unsigned char T[ASCON_HMAC_SIZE];
-            ascon_pbkdf2_f(&state, T, U, password, passwordlen,
-                           salt, saltlen, count, blocknum);
-            memcpy(out, T, outlen);
-            ascon_clean(T, sizeof(T));
-            break;
-        }
-        ++blocknum;
+        blocks = (outlen + ASCON_HMAC_SIZE - 1) / ASCON_HMAC_SIZE;
+        lanes = (blocks < ASCON_MULTI_LANES) ? (unsigned)blocks
+                                             : ASCON_MULTI_LANES;
+        ascon_pbkdf2_f(&pk, T, U, salt, saltlen, count, blocknum, lanes);
+        len = lanes * ASCON_HMAC_SIZE;
+        if (len > outlen)
+            len = outlen;
+        memcpy(out, T, len);
+        out += len;
+        outlen -= len;
+        blocknum += lanes;
     }
-    ascon_clean(&state, sizeof(state));
+    ascon_hmac_free_key(&pk);
+    ascon_clean(T, sizeof(T));
     ascon_clean(U, sizeof(U));
 }
+
+#endif /* ASCON_ENABLE_HASH */
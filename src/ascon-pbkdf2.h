@@ -58,6 +58,11 @@ extern "C" {
  * ASCON_PBKDF2_SIZE bytes, but this limit is not checked.
  * The \a count value should be large enough to provide resistance
  * against dictionary attacks on the password.
+ *
+ * The HMAC key blocks for the password are absorbed once and reused for
+ * every iteration.  When more than one output block is requested, the
+ * blocks are generated side by side with the multi-state permutations
+ * if the back end supports them.
  */
 void ascon_pbkdf2
     (unsigned char *out, size_t outlen,
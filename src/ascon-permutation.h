@@ -23,6 +23,7 @@
 #ifndef ASCON_PERMUTATION_H
 #define ASCON_PERMUTATION_H
 
+#include "ascon-config.h"
 #include <stdint.h>
 #include <stddef.h>
 
@@ -104,6 +105,47 @@ void ascon_init(ascon_state_t *state);
  */
 void ascon_free(ascon_state_t *state);
 
+/**
+ * \brief Function that allocates a private permutation state.
+ *
+ * \param size Number of bytes to allocate.
+ *
+ * \return A pointer to the allocated memory or NULL if there is
+ * no memory available.
+ */
+typedef void *(*ascon_state_alloc_t)(size_t size);
+
+/**
+ * \brief Function that frees a private permutation state.
+ *
+ * \param ptr Points to the memory to be freed.
+ * \param size Number of bytes that were allocated.
+ */
+typedef void (*ascon_state_dealloc_t)(void *ptr, size_t size);
+
+/**
+ * \brief Sets the allocator to use for private permutation states.
+ *
+ * \param alloc Function that allocates a private state, or NULL to go
+ * back to the default allocator.
+ * \param dealloc Function that frees a private state, or NULL to go
+ * back to the default allocator.
+ *
+ * Back ends that need more than 40 bytes of state allocate the extra
+ * memory in ascon_init() and free it in ascon_free().  By default, the
+ * memory comes from a small static pool so that short operations do not
+ * cause any heap traffic.  This function replaces the pool with an
+ * application-supplied allocator, such as one that places the state in
+ * memory that an accelerator can reach.
+ *
+ * The allocator must be set before the first call to ascon_init() and it
+ * must not be changed while any permutation state is in use.
+ *
+ * The built-in back ends fit in 40 bytes and never call the allocator.
+ */
+void ascon_set_state_allocator
+    (ascon_state_alloc_t alloc, ascon_state_dealloc_t dealloc);
+
 /**
  * \brief Adds bytes to the ASCON state by XOR'ing them with existing bytes.
  *
@@ -212,6 +254,393 @@ void ascon_permute(ascon_state_t *state, uint8_t first_round);
  */
 #define ascon_permute6(state) ascon_permute((state), 6)
 
+/**
+ * \brief Permutes two independent ASCON states with a specified
+ * number of rounds.
+ *
+ * \param state0 The first ASCON state in "operational" form.
+ * \param state1 The second ASCON state in "operational" form.
+ * \param first_round The first round to execute, between 0 and 11.
+ * The number of rounds will be 12 - first_round.
+ *
+ * The result is the same as calling ascon_permute() on each state in turn.
+ * On back ends that support it, the rounds for the two states are
+ * interleaved to make better use of the CPU's execution units.
+ *
+ * Both states must be acquired and must be distinct objects.
+ *
+ * \sa ascon_permute(), ascon_permute_x4()
+ */
+void ascon_permute_x2
+    (ascon_state_t *state0, ascon_state_t *state1, uint8_t first_round);
+
+/**
+ * \brief Permutes four independent ASCON states with a specified
+ * number of rounds.
+ *
+ * \param state0 The first ASCON state in "operational" form.
+ * \param state1 The second ASCON state in "operational" form.
+ * \param state2 The third ASCON state in "operational" form.
+ * \param state3 The fourth ASCON state in "operational" form.
+ * \param first_round The first round to execute, between 0 and 11.
+ * The number of rounds will be 12 - first_round.
+ *
+ * The result is the same as calling ascon_permute() on each state in turn.
+ * On back ends that support it, the rounds for the four states are
+ * interleaved to make better use of the CPU's execution units.
+ *
+ * All states must be acquired and must be distinct objects.
+ *
+ * \sa ascon_permute(), ascon_permute_x2(), ascon_permute_x8()
+ */
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round);
+
+/**
+ * \brief Permutes eight independent ASCON states with a specified
+ * number of rounds.
+ *
+ * \param states Points to an array of eight pointers to the ASCON states
+ * to be permuted, in "operational" form.
+ * \param first_round The first round to execute, between 0 and 11.
+ * The number of rounds will be 12 - first_round.
+ *
+ * The result is the same as calling ascon_permute() on each state in turn.
+ * On back ends that support it, the rounds for the eight states are
+ * performed in parallel using vector instructions.
+ *
+ * All states must be acquired and must be distinct objects.
+ *
+ * \sa ascon_permute(), ascon_permute_x4()
+ */
+void ascon_permute_x8(ascon_state_t *states[8], uint8_t first_round);
+
+/** @cond ascon_state_xn_aligned */
+#if defined(__GNUC__) || defined(__clang__)
+#define ASCON_STATE_XN_ALIGNED __attribute__((aligned(64)))
+#else
+#define ASCON_STATE_XN_ALIGNED
+#endif
+/** @endcond */
+
+/**
+ * \brief Four independent ASCON permutation states in
+ * structure-of-arrays form.
+ *
+ * Word i of lane j is stored in S[i][j], so that vector back ends can
+ * load a word from all lanes at once rather than gathering it from
+ * separate ascon_state_t structures on every permutation call.
+ *
+ * Unlike ascon_state_t, the words are always in standard form: 64-bit
+ * integers with the first byte of each word in the high bits.  The lanes
+ * can be accessed directly or with ascon_state_x4_add_bytes() and the
+ * related functions.
+ */
+typedef struct
+{
+    uint64_t S[5][4] ASCON_STATE_XN_ALIGNED; /**< Words of the lanes */
+
+} ascon_state_x4_t;
+
+/**
+ * \brief Eight independent ASCON permutation states in
+ * structure-of-arrays form.
+ *
+ * \sa ascon_state_x4_t
+ */
+typedef struct
+{
+    uint64_t S[5][8] ASCON_STATE_XN_ALIGNED; /**< Words of the lanes */
+
+} ascon_state_x8_t;
+
+/**
+ * \brief Initializes all lanes of a four-lane state to zero.
+ *
+ * \param state The state to initialize.
+ *
+ * \sa ascon_state_x4_free()
+ */
+void ascon_state_x4_init(ascon_state_x4_t *state);
+
+/**
+ * \brief Destroys the contents of a four-lane state.
+ *
+ * \param state The state to free.
+ */
+void ascon_state_x4_free(ascon_state_x4_t *state);
+
+/**
+ * \brief Overwrites bytes in one lane of a four-lane state.
+ *
+ * \param state The state to write to.
+ * \param lane The lane to write to, between 0 and 3.
+ * \param data Points to the bytes to write.
+ * \param offset Offset into the lane, between 0 and 40 - size.
+ * \param size Number of bytes to write, between 0 and 40.
+ */
+void ascon_state_x4_overwrite_bytes
+    (ascon_state_x4_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size);
+
+/**
+ * \brief Adds bytes to one lane of a four-lane state by XOR'ing them
+ * with the existing bytes.
+ *
+ * \param state The state to add to.
+ * \param lane The lane to add to, between 0 and 3.
+ * \param data Points to the bytes to add.
+ * \param offset Offset into the lane, between 0 and 40 - size.
+ * \param size Number of bytes to add, between 0 and 40.
+ */
+void ascon_state_x4_add_bytes
+    (ascon_state_x4_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size);
+
+/**
+ * \brief Extracts bytes from one lane of a four-lane state.
+ *
+ * \param state The state to read from.
+ * \param lane The lane to read from, between 0 and 3.
+ * \param data Points to the buffer to receive the bytes.
+ * \param offset Offset into the lane, between 0 and 40 - size.
+ * \param size Number of bytes to extract, between 0 and 40.
+ */
+void ascon_state_x4_extract_bytes
+    (const ascon_state_x4_t *state, unsigned lane, uint8_t *data,
+     unsigned offset, unsigned size);
+
+/**
+ * \brief Permutes all lanes of a four-lane state with a specified
+ * number of rounds.
+ *
+ * \param state The state to permute.
+ * \param first_round The first round to execute, between 0 and 11.
+ * The number of rounds will be 12 - first_round.
+ *
+ * \sa ascon_permute_x4()
+ */
+void ascon_state_x4_permute(ascon_state_x4_t *state, uint8_t first_round);
+
+/**
+ * \brief Initializes all lanes of an eight-lane state to zero.
+ *
+ * \param state The state to initialize.
+ *
+ * \sa ascon_state_x8_free()
+ */
+void ascon_state_x8_init(ascon_state_x8_t *state);
+
+/**
+ * \brief Destroys the contents of an eight-lane state.
+ *
+ * \param state The state to free.
+ */
+void ascon_state_x8_free(ascon_state_x8_t *state);
+
+/**
+ * \brief Overwrites bytes in one lane of an eight-lane state.
+ *
+ * \param state The state to write to.
+ * \param lane The lane to write to, between 0 and 7.
+ * \param data Points to the bytes to write.
+ * \param offset Offset into the lane, between 0 and 40 - size.
+ * \param size Number of bytes to write, between 0 and 40.
+ */
+void ascon_state_x8_overwrite_bytes
+    (ascon_state_x8_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size);
+
+/**
+ * \brief Adds bytes to one lane of an eight-lane state by XOR'ing them
+ * with the existing bytes.
+ *
+ * \param state The state to add to.
+ * \param lane The lane to add to, between 0 and 7.
+ * \param data Points to the bytes to add.
+ * \param offset Offset into the lane, between 0 and 40 - size.
+ * \param size Number of bytes to add, between 0 and 40.
+ */
+void ascon_state_x8_add_bytes
+    (ascon_state_x8_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size);
+
+/**
+ * \brief Extracts bytes from one lane of an eight-lane state.
+ *
+ * \param state The state to read from.
+ * \param lane The lane to read from, between 0 and 7.
+ * \param data Points to the buffer to receive the bytes.
+ * \param offset Offset into the lane, between 0 and 40 - size.
+ * \param size Number of bytes to extract, between 0 and 40.
+ */
+void ascon_state_x8_extract_bytes
+    (const ascon_state_x8_t *state, unsigned lane, uint8_t *data,
+     unsigned offset, unsigned size);
+
+/**
+ * \brief Permutes all lanes of an eight-lane state with a specified
+ * number of rounds.
+ *
+ * \param state The state to permute.
+ * \param first_round The first round to execute, between 0 and 11.
+ * The number of rounds will be 12 - first_round.
+ *
+ * \sa ascon_permute_x8()
+ */
+void ascon_state_x8_permute(ascon_state_x8_t *state, uint8_t first_round);
+
+/**
+ * \brief Feature flag indicating that the back end interleaves the rounds
+ * of multiple states in ascon_permute_x2() and ascon_permute_x4().
+ */
+#define ASCON_FEATURE_INTERLEAVED   0x0001
+
+/**
+ * \brief Feature flag indicating that the back end keeps the state in
+ * registers across multiple blocks in the bulk AEAD operations.
+ */
+#define ASCON_FEATURE_BULK          0x0002
+
+/**
+ * \brief Feature flag indicating that ascon_permute_x4() is using AVX2.
+ */
+#define ASCON_FEATURE_AVX2          0x0004
+
+/**
+ * \brief Feature flag indicating that ascon_permute_x8() is using AVX-512.
+ */
+#define ASCON_FEATURE_AVX512        0x0008
+
+/**
+ * \brief Feature flag indicating that ascon_permute_x2() and
+ * ascon_permute_x4() are using ARM NEON.
+ */
+#define ASCON_FEATURE_NEON          0x0010
+
+/**
+ * \brief Feature flag indicating that the permutation and the AEAD block
+ * loops were placed in instruction RAM with ASCON_FAST_RAM.
+ */
+#define ASCON_FEATURE_FAST_RAM      0x0020
+
+/**
+ * \brief Feature flag indicating that ascon_permute_x2() and
+ * ascon_permute_x4() are using WebAssembly SIMD128.
+ */
+#define ASCON_FEATURE_WASM_SIMD     0x0040
+
+/**
+ * \brief Feature flag indicating that the multi-state permutations were
+ * bound by ascon_backend_calibrate() rather than by the CPU features.
+ */
+#define ASCON_FEATURE_CALIBRATED    0x0080
+
+/**
+ * \brief Feature flag indicating that ascon_permute_x4() is using the
+ * ARM M-profile Vector Extension (Helium).
+ */
+#define ASCON_FEATURE_MVE           0x0100
+
+/**
+ * \brief Gets the name of the permutation back end that was selected
+ * when the library was compiled.
+ *
+ * \return The name of the back end; e.g. "c64", "c32", "armv7m", "avr5".
+ *
+ * \sa ascon_backend_features()
+ */
+const char *ascon_backend_name(void);
+
+/**
+ * \brief Gets the features of the permutation back end that are in use.
+ *
+ * \return A bitmask of ASCON_FEATURE_* flags.
+ *
+ * The instruction set features of the CPU are probed the first time that
+ * this function or one of the multi-state permutations is called.  If the
+ * library was compiled with support for a feature that the CPU does not
+ * have, then the corresponding flag will not be set and the multi-state
+ * permutations will use the next best implementation instead.
+ *
+ * The single-state ascon_permute() function is always selected at
+ * compile time because the back end determines the "operational" form
+ * of the state.
+ *
+ * \sa ascon_backend_name()
+ */
+unsigned ascon_backend_features(void);
+
+/**
+ * \brief Maximum number of kernels that ascon_backend_calibrate() will
+ * report on.
+ */
+#define ASCON_CALIBRATION_MAX_RESULTS 8
+
+/**
+ * \brief Clock function for timing kernels in ascon_backend_calibrate().
+ *
+ * \return The current time in ticks of any unit; e.g. microseconds.
+ * The value may wrap around.
+ *
+ * The Arduino micros() function has this signature.
+ */
+typedef unsigned long (*ascon_calibrate_clock_t)(void);
+
+/**
+ * \brief Measurement of a single kernel by ascon_backend_calibrate().
+ */
+typedef struct
+{
+    /** Name of the kernel; e.g. "x4-avx2", "x4-x2", or "masked-x3" */
+    const char *name;
+
+    /** Number of states that were permuted with 12 rounds */
+    unsigned long permutations;
+
+    /** Number of clock ticks that the permutations took */
+    unsigned long elapsed;
+
+    /** Non-zero if the kernel is bound after calibration, or zero if it
+     *  lost to another kernel for the same operation.  Kernels that
+     *  have no alternative are always marked as selected. */
+    int selected;
+
+} ascon_calibration_t;
+
+/**
+ * \brief Times the compiled-in permutation kernels and binds the fastest
+ * kernel for each operation that can be selected at runtime.
+ *
+ * \param clock Function to call to get the current time.
+ * \param budget Number of clock ticks to spend timing each kernel.
+ * \param results Array to receive the measurements, or NULL.
+ * \param max_results Maximum number of entries to store in \a results.
+ *
+ * \return The number of entries that were stored in \a results.
+ *
+ * The kernels that can be selected at runtime are the AVX2 and AVX-512
+ * versions of ascon_permute_x4() and ascon_permute_x8() if the library
+ * was not compiled for those instruction sets.  If the CPU supports an
+ * instruction set but the fallback is faster, then the fallback is bound
+ * and the feature flag is cleared in ascon_backend_features().
+ *
+ * The single-state permutation and the masked permutations are timed and
+ * reported, but are not changed.  The form of the state depends upon the
+ * single-state back end, and the number of masking shares is a security
+ * choice for the application rather than a speed choice.
+ *
+ * This function is intended to be called once at startup, before any
+ * other threads are using the library.  Calibration is optional; if it
+ * is not called, then the kernels are bound from the CPU features.
+ *
+ * \sa ascon_backend_features()
+ */
+unsigned ascon_backend_calibrate
+    (ascon_calibrate_clock_t clock, unsigned long budget,
+     ascon_calibration_t *results, unsigned max_results);
+
 /**
  * \brief Temporarily releases access to any shared hardware resources
  * that a permutation state was using.
@@ -241,6 +670,46 @@ void ascon_release(ascon_state_t *state);
  */
 void ascon_acquire(ascon_state_t *state);
 
+/**
+ * \brief Acquires a released permutation state for a sequence of
+ * operations.
+ *
+ * \param state The ASCON state to be acquired.
+ *
+ * The incremental API's release the state after every call so that other
+ * tasks can use the shared hardware in between.  If acquiring the hardware
+ * is expensive, it is better to acquire the state once, perform many
+ * incremental operations, and then release it once:
+ *
+ * \code
+ * ascon128a_aead_start(&aead, ad, adlen, npub, k);
+ * ascon_acquire_scope(&(aead.state));
+ * for (...)
+ *     ascon128a_aead_encrypt_block(&aead, in, out, len);
+ * ascon128a_aead_encrypt_finalize(&aead, tag);
+ * \endcode
+ *
+ * Inside the scope, ascon_acquire() and ascon_release() do nothing for
+ * \a state.  The scope ends when ascon_release_scope() is called or the
+ * state is freed; e.g. because the incremental operation was finalized.
+ *
+ * Only one state can be in scope at a time.  Starting a scope for another
+ * state will end the previous scope.  On back ends where acquire and
+ * release do nothing, this function also does nothing.
+ *
+ * \sa ascon_release_scope()
+ */
+void ascon_acquire_scope(ascon_state_t *state);
+
+/**
+ * \brief Ends an acquire/release scope and releases the state.
+ *
+ * \param state The ASCON state that was passed to ascon_acquire_scope().
+ *
+ * \sa ascon_acquire_scope()
+ */
+void ascon_release_scope(ascon_state_t *state);
+
 /**
  * \brief Copies the entire ASCON permutation state from a source to a
  * destination.
@@ -252,6 +721,108 @@ void ascon_acquire(ascon_state_t *state);
  */
 void ascon_copy(ascon_state_t *dest, const ascon_state_t *src);
 
+/**
+ * \brief Statistics on the use of the ASCON permutation.
+ *
+ * The library only collects statistics if it was compiled with
+ * ASCON_STATS defined.  Otherwise the counters are always zero, and
+ * there is no cost to the permutation calls.
+ */
+typedef struct
+{
+    /** Number of calls to the permutation, with each state of a
+     *  multi-state permutation counted separately */
+    uint64_t permutations;
+
+    /** Total number of permutation rounds that were executed */
+    uint64_t rounds;
+
+    /** Number of bytes of data absorbed by the AEAD and XOF modes */
+    uint64_t absorbed;
+
+    /** Number of bytes of data squeezed by the AEAD and XOF modes */
+    uint64_t squeezed;
+
+} ascon_stats_t;
+
+/**
+ * \brief Gets the global permutation statistics.
+ *
+ * \param stats Returns the counters since the last call to
+ * ascon_stats_reset() or the start of the program.
+ *
+ * \sa ascon_stats_reset(), ascon_stats_select()
+ */
+void ascon_stats_get(ascon_stats_t *stats);
+
+/**
+ * \brief Resets the global permutation statistics to zero.
+ *
+ * \sa ascon_stats_get()
+ */
+void ascon_stats_reset(void);
+
+/**
+ * \brief Selects an application context to receive statistics in
+ * addition to the global counters.
+ *
+ * \param context Points to the context to receive the statistics,
+ * or NULL to only update the global counters.
+ *
+ * \return The previously selected context, or NULL if none.
+ *
+ * This can be used to profile the cost of a specific operation:
+ *
+ * \code
+ * ascon_stats_t stats = {0};
+ * ascon_stats_t *prev = ascon_stats_select(&stats);
+ * ascon128a_aead_encrypt(c, &clen, m, mlen, ad, adlen, npub, k);
+ * ascon_stats_select(prev);
+ * \endcode
+ *
+ * The statistics are not thread-safe.  On multi-threaded systems the
+ * counters should only be used to profile one thread at a time.
+ *
+ * \sa ascon_stats_get()
+ */
+ascon_stats_t *ascon_stats_select(ascon_stats_t *context);
+
+/** @cond ascon_stats */
+
+/* When statistics are enabled, the permutation entry points are wrapped
+ * with macros that count the calls on the caller's side.  The back ends
+ * define ASCON_STATS_INTERNAL so that the calls they make to each other
+ * are not counted twice. */
+#if defined(ASCON_STATS) && !defined(ASCON_STATS_INTERNAL)
+void ascon_stats_count_permute(unsigned count, uint8_t first_round);
+void ascon_stats_count_bytes(size_t absorbed, size_t squeezed);
+#define ascon_permute(state, first_round) \
+    (ascon_stats_count_permute(1, (first_round)), \
+     (ascon_permute)((state), (first_round)))
+#define ascon_permute_x2(state0, state1, first_round) \
+    (ascon_stats_count_permute(2, (first_round)), \
+     (ascon_permute_x2)((state0), (state1), (first_round)))
+#define ascon_permute_x4(state0, state1, state2, state3, first_round) \
+    (ascon_stats_count_permute(4, (first_round)), \
+     (ascon_permute_x4)((state0), (state1), (state2), (state3), \
+                        (first_round)))
+#define ascon_permute_x8(states, first_round) \
+    (ascon_stats_count_permute(8, (first_round)), \
+     (ascon_permute_x8)((states), (first_round)))
+#define ascon_state_x4_permute(state, first_round) \
+    (ascon_stats_count_permute(4, (first_round)), \
+     (ascon_state_x4_permute)((state), (first_round)))
+#define ascon_state_x8_permute(state, first_round) \
+    (ascon_stats_count_permute(8, (first_round)), \
+     (ascon_state_x8_permute)((state), (first_round)))
+#define ascon_stats_bytes(absorbed, squeezed) \
+    ascon_stats_count_bytes((absorbed), (squeezed))
+#else
+#define ascon_stats_bytes(absorbed, squeezed) do { ; } while (0)
+#endif
+
+/** @endcond */
+
 #ifdef __cplusplus
 }
 #endif
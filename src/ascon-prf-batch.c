@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-prf.h"
+#include "ascon-utility.h"
+#include "utility/ascon-multi.h"
+#include "utility/ascon-util-snp.h"
+
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Rate of absorption for input blocks.
+ */
+#define ASCON_PRF_RATE_IN 32
+
+int ascon_prf_short_batch
+    (unsigned char *out, size_t outlen,
+     const unsigned char * const *in, const size_t *inlen, size_t count,
+     const unsigned char *key)
+{
+    static unsigned char const iv[8] =
+        {0x80, 0x00, 0x4c, 0x80, 0x00, 0x00, 0x00, 0x00};
+    ascon_state_t base;
+    ascon_state_t state[ASCON_MULTI_LANES];
+    ascon_state_t *states[ASCON_MULTI_LANES];
+    unsigned char bits;
+    unsigned lanes, index;
+    size_t posn;
+
+    /* Validate all of the parameters before we generate any output */
+    if (outlen > ASCON_PRF_SHORT_MAX_OUTPUT_SIZE)
+        return -1;
+    for (posn = 0; posn < count; ++posn) {
+        if (inlen[posn] > ASCON_PRF_SHORT_MAX_INPUT_SIZE)
+            return -1;
+    }
+
+    /* Load the IV and key into a base state once for the whole batch */
+    ascon_init(&base);
+    ascon_overwrite_bytes(&base, iv, 0, 8);
+    ascon_overwrite_bytes(&base, key, 8, ASCON_PRF_SHORT_KEY_SIZE);
+    ascon_release(&base);
+    for (index = 0; index < ASCON_MULTI_LANES; ++index) {
+        ascon_init(&(state[index]));
+        states[index] = &(state[index]);
+    }
+
+    /* Process the inputs in groups of lanes */
+    while (count > 0) {
+        lanes = (count < ASCON_MULTI_LANES) ? (unsigned)count
+                                            : ASCON_MULTI_LANES;
+        for (index = 0; index < lanes; ++index) {
+            bits = (unsigned char)(inlen[index] * 8U);
+            ascon_copy(states[index], &base);
+            ascon_overwrite_bytes(states[index], &bits, 1, 1);
+            ascon_overwrite_bytes
+                (states[index], in[index], 24, (unsigned)(inlen[index]));
+        }
+        ascon_permute_multi(states, lanes, 0);
+        for (index = 0; index < lanes; ++index) {
+            ascon_absorb_16(states[index], key, 24);
+            ascon_squeeze_partial
+                (states[index], out + index * outlen, 24, (unsigned)outlen);
+        }
+        out += lanes * outlen;
+        in += lanes;
+        inlen += lanes;
+        count -= lanes;
+    }
+
+    /* Clean up */
+    for (index = 0; index < ASCON_MULTI_LANES; ++index)
+        ascon_free(&(state[index]));
+    ascon_acquire(&base);
+    ascon_free(&base);
+    return 0;
+}
+
+/* Information about an input that is being processed in a lane */
+typedef struct
+{
+    ascon_state_t state;
+    const unsigned char *in;
+    unsigned char *tag;
+    size_t len;
+    int squeezing;
+
+} ascon_mac_lane_t;
+
+/**
+ * \brief Advances a lane to the point where it next needs a permutation.
+ *
+ * \param lane The lane to advance.
+ *
+ * \return Zero if the lane needs a permutation, or 1 if the
+ * tag has been generated.
+ */
+static int ascon_mac_lane_step(ascon_mac_lane_t *lane)
+{
+    ascon_state_t *state = &(lane->state);
+    if (lane->squeezing) {
+        ascon_squeeze_16(state, lane->tag, 0);
+        return 1;
+    }
+    if (lane->len >= ASCON_PRF_RATE_IN) {
+        ascon_absorb_16(state, lane->in, 0);
+        ascon_absorb_16(state, lane->in + 16, 16);
+        lane->in += ASCON_PRF_RATE_IN;
+        lane->len -= ASCON_PRF_RATE_IN;
+    } else {
+        if (lane->len > 0)
+            ascon_absorb_partial(state, lane->in, 0, (unsigned)(lane->len));
+        ascon_pad(state, (unsigned)(lane->len));
+        ascon_separator(state);
+        lane->squeezing = 1;
+    }
+    return 0;
+}
+
+void ascon_mac_batch
+    (unsigned char *tags,
+     const unsigned char * const *in, const size_t *inlen, size_t count,
+     const unsigned char *key)
+{
+    ascon_prf_state_t base;
+    ascon_mac_lane_t lanes[ASCON_MULTI_LANES];
+    ascon_mac_lane_t *active[ASCON_MULTI_LANES];
+    ascon_state_t *states[ASCON_MULTI_LANES];
+    unsigned num_active = 0;
+    unsigned index;
+
+    /* Run the keyed initialization permutation once for the whole batch */
+    ascon_prf_fixed_init(&base, key, ASCON_MAC_TAG_SIZE);
+
+    /* Lanes that are not in use are kept at the end of the active list */
+    for (index = 0; index < ASCON_MULTI_LANES; ++index)
+        active[index] = &(lanes[index]);
+
+    for (;;) {
+        /* Fill up any empty lanes with new inputs */
+        while (num_active < ASCON_MULTI_LANES && count > 0) {
+            ascon_mac_lane_t *lane = active[num_active++];
+            ascon_init(&(lane->state));
+            ascon_copy(&(lane->state), &(base.state));
+            lane->in = *in++;
+            lane->tag = tags;
+            lane->len = *inlen++;
+            lane->squeezing = 0;
+            ascon_mac_lane_step(lane);
+            tags += ASCON_MAC_TAG_SIZE;
+            --count;
+        }
+        if (!num_active)
+            break;
+
+        /* Permute all active lanes */
+        for (index = 0; index < num_active; ++index)
+            states[index] = &(active[index]->state);
+        ascon_permute_multi(states, num_active, 0);
+
+        /* Advance all lanes to the next permutation and retire the
+         * lanes whose tags have been generated */
+        index = 0;
+        while (index < num_active) {
+            ascon_mac_lane_t *lane = active[index];
+            if (ascon_mac_lane_step(lane)) {
+                ascon_free(&(lane->state));
+                active[index] = active[--num_active];
+                active[num_active] = lane;
+            } else {
+                ++index;
+            }
+        }
+    }
+    ascon_prf_free(&base);
+}
+
+#endif /* ASCON_ENABLE_HASH */
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-prf.h"
+#include "ascon-utility.h"
+#include "utility/ascon-aead-common.h"
+#include "utility/ascon-multi.h"
+#include "utility/ascon-util.h"
+#include "utility/ascon-util-snp.h"
+#include <string.h>
+
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Determine if a range of the keystream is within the limit.
+ *
+ * \param offset Offset of the start of the range.
+ * \param len Length of the range.
+ */
+#define ascon_prf_ctr_in_range(offset, len) \
+    ((offset) <= ASCON_PRF_CTR_MAX_LENGTH && \
+     ((uint64_t)(len)) <= ASCON_PRF_CTR_MAX_LENGTH - (offset))
+
+int ascon_prf_ctr_xor
+    (unsigned char *out, const unsigned char *in, size_t len,
+     uint64_t offset, const unsigned char *nonce, const unsigned char *key)
+{
+    /* ASCON-PrfShort IV for a 128-bit input */
+    static unsigned char const iv[8] =
+        {0x80, 0x80, 0x4c, 0x80, 0x00, 0x00, 0x00, 0x00};
+    ascon_state_t base;
+    ascon_state_t state[ASCON_MULTI_LANES];
+    ascon_state_t *states[ASCON_MULTI_LANES];
+    unsigned char counter[4];
+    uint64_t block, blocks;
+    unsigned skip, chunk, lanes, index;
+
+    if (!ascon_prf_ctr_in_range(offset, len))
+        return -1;
+    if (!len)
+        return 0;
+
+    /* The IV, key, and nonce are the same for every block */
+    ascon_init(&base);
+    ascon_overwrite_bytes(&base, iv, 0, 8);
+    ascon_overwrite_bytes(&base, key, 8, ASCON_PRF_SHORT_KEY_SIZE);
+    ascon_overwrite_bytes(&base, nonce, 24, ASCON_PRF_CTR_NONCE_SIZE);
+    ascon_release(&base);
+    for (index = 0; index < ASCON_MULTI_LANES; ++index) {
+        ascon_init(&(state[index]));
+        states[index] = &(state[index]);
+    }
+
+    /* Generate the keystream blocks in groups of lanes */
+    block = offset / ASCON_PRF_CTR_BLOCK_SIZE;
+    skip = (unsigned)(offset % ASCON_PRF_CTR_BLOCK_SIZE);
+    blocks = ((uint64_t)len + skip + ASCON_PRF_CTR_BLOCK_SIZE - 1) /
+             ASCON_PRF_CTR_BLOCK_SIZE;
+    while (blocks > 0) {
+        lanes = (blocks < ASCON_MULTI_LANES) ? (unsigned)blocks
+                                             : ASCON_MULTI_LANES;
+        for (index = 0; index < lanes; ++index) {
+            be_store_word32(counter, (uint32_t)(block + index));
+            ascon_copy(states[index], &base);
+            ascon_overwrite_bytes(states[index], counter, 36, 4);
+        }
+        ascon_permute_multi(states, lanes, 0);
+        for (index = 0; index < lanes; ++index) {
+            ascon_absorb_16(states[index], key, 24);
+            chunk = ASCON_PRF_CTR_BLOCK_SIZE - skip;
+            if (chunk > len)
+                chunk = (unsigned)len;
+            ascon_extract_and_add_bytes
+                (states[index], in, out, 24 + skip, chunk);
+            in += chunk;
+            out += chunk;
+            len -= chunk;
+            skip = 0;
+        }
+        block += lanes;
+        blocks -= lanes;
+    }
+
+    /* Clean up */
+    for (index = 0; index < ASCON_MULTI_LANES; ++index)
+        ascon_free(&(state[index]));
+    ascon_acquire(&base);
+    ascon_free(&base);
+    return 0;
+}
+
+/**
+ * \brief Computes the tag for a segment and XOR's it into a sum.
+ *
+ * \param sum Points to the sum of the segment tags.
+ * \param c Points to the ciphertext of the segment.
+ * \param clen Length of the ciphertext of the segment.
+ * \param segment Index of the segment.
+ * \param nonce Points to the nonce.
+ * \param key Points to the key.
+ */
+static void ascon_prf_ctr_add_segment_tag
+    (unsigned char *sum, const unsigned char *c, size_t clen,
+     uint64_t segment, const unsigned char *nonce, const unsigned char *key)
+{
+    ascon_prf_state_t state;
+    unsigned char header[1 + ASCON_PRF_CTR_NONCE_SIZE + 8];
+    unsigned char tag[ASCON_PRF_CTR_TAG_SIZE];
+    header[0] = 0x00;
+    memcpy(header + 1, nonce, ASCON_PRF_CTR_NONCE_SIZE);
+    be_store_word64(header + 1 + ASCON_PRF_CTR_NONCE_SIZE, segment);
+    ascon_prf_fixed_init(&state, key, ASCON_PRF_CTR_TAG_SIZE);
+    ascon_prf_absorb(&state, header, sizeof(header));
+    ascon_prf_absorb(&state, c, clen);
+    ascon_prf_squeeze(&state, tag, sizeof(tag));
+    ascon_prf_free(&state);
+    lw_xor_block(sum, tag, sizeof(tag));
+    ascon_clean(tag, sizeof(tag));
+}
+
+/**
+ * \brief Encrypts or decrypts a range of segments.
+ *
+ * \param out Buffer to receive the output.
+ * \param sum Points to the sum of the segment tags.
+ * \param in Points to the input.
+ * \param len Length of the input.
+ * \param first_segment Index of the first segment in the range.
+ * \param nonce Points to the nonce.
+ * \param key Points to the key.
+ * \param decrypt Non-zero to decrypt, or zero to encrypt.
+ *
+ * \return 0 on success, or -1 if the range is too long.
+ */
+static int ascon_prf_ctr_segments
+    (unsigned char *out, unsigned char *sum,
+     const unsigned char *in, size_t len, uint64_t first_segment,
+     const unsigned char *nonce, const unsigned char *key, int decrypt)
+{
+    uint64_t offset;
+    size_t size;
+    if (first_segment > ASCON_PRF_CTR_MAX_LENGTH / ASCON_PRF_CTR_SEGMENT_SIZE)
+        return -1;
+    offset = first_segment * ASCON_PRF_CTR_SEGMENT_SIZE;
+    if (!ascon_prf_ctr_in_range(offset, len))
+        return -1;
+    while (len > 0) {
+        size = (len < ASCON_PRF_CTR_SEGMENT_SIZE) ? len
+                                                  : ASCON_PRF_CTR_SEGMENT_SIZE;
+        if (decrypt) {
+            /* Authenticate the ciphertext before it is overwritten */
+            ascon_prf_ctr_add_segment_tag
+                (sum, in, size, first_segment, nonce, key);
+            ascon_prf_ctr_xor(out, in, size, offset, nonce, key);
+        } else {
+            ascon_prf_ctr_xor(out, in, size, offset, nonce, key);
+            ascon_prf_ctr_add_segment_tag
+                (sum, out, size, first_segment, nonce, key);
+        }
+        out += size;
+        in += size;
+        len -= size;
+        offset += size;
+        ++first_segment;
+    }
+    return 0;
+}
+
+int ascon_prf_ctr_encrypt_segments
+    (unsigned char *c, unsigned char *sum,
+     const unsigned char *m, size_t mlen, uint64_t first_segment,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    return ascon_prf_ctr_segments
+        (c, sum, m, mlen, first_segment, nonce, key, 0);
+}
+
+int ascon_prf_ctr_decrypt_segments
+    (unsigned char *m, unsigned char *sum,
+     const unsigned char *c, size_t clen, uint64_t first_segment,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    return ascon_prf_ctr_segments
+        (m, sum, c, clen, first_segment, nonce, key, 1);
+}
+
+void ascon_prf_ctr_final_tag
+    (unsigned char *tag, const unsigned char *sum, uint64_t len,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    unsigned char data[1 + ASCON_PRF_CTR_NONCE_SIZE + 8 +
+                       ASCON_PRF_CTR_TAG_SIZE];
+    data[0] = 0x01;
+    memcpy(data + 1, nonce, ASCON_PRF_CTR_NONCE_SIZE);
+    be_store_word64(data + 1 + ASCON_PRF_CTR_NONCE_SIZE, len);
+    memcpy(data + 1 + ASCON_PRF_CTR_NONCE_SIZE + 8, sum,
+           ASCON_PRF_CTR_TAG_SIZE);
+    ascon_mac(tag, data, sizeof(data), key);
+    ascon_clean(data, sizeof(data));
+}
+
+int ascon_prf_ctr_encrypt
+    (unsigned char *c, unsigned char *tag,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    unsigned char sum[ASCON_PRF_CTR_TAG_SIZE] = {0};
+    if (ascon_prf_ctr_encrypt_segments(c, sum, m, mlen, 0, nonce, key) < 0)
+        return -1;
+    ascon_prf_ctr_final_tag(tag, sum, mlen, nonce, key);
+    ascon_clean(sum, sizeof(sum));
+    return 0;
+}
+
+int ascon_prf_ctr_decrypt
+    (unsigned char *m, const unsigned char *c, size_t clen,
+     const unsigned char *tag,
+     const unsigned char *nonce, const unsigned char *key)
+{
+    unsigned char sum[ASCON_PRF_CTR_TAG_SIZE] = {0};
+    unsigned char tag2[ASCON_PRF_CTR_TAG_SIZE];
+    int result;
+    if (ascon_prf_ctr_decrypt_segments(m, sum, c, clen, 0, nonce, key) < 0)
+        return -1;
+    ascon_prf_ctr_final_tag(tag2, sum, clen, nonce, key);
+    result = ascon_aead_check_tag(m, clen, tag, tag2, sizeof(tag2));
+    ascon_clean(sum, sizeof(sum));
+    ascon_clean(tag2, sizeof(tag2));
+    return result;
+}
+
+#endif /* ASCON_ENABLE_HASH */
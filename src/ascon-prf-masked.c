@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-prf-masked.h"
+#include "utility/ascon-aead-masked-common.h"
+#include "utility/ascon-util-snp.h"
+
+#if ASCON_ENABLE_MASKING
+
+/**
+ * \brief Rate of absorption for input blocks.
+ */
+#define ASCON_PRF_RATE_IN 32
+
+/**
+ * \brief Rate of squeezing for output blocks.
+ */
+#define ASCON_PRF_RATE_OUT 16
+
+/* Generate random words for use in permutation calls */
+static void ascon_masked_prf_refresh
+    (uint64_t *preserve, ascon_trng_state_t *trng)
+{
+#if ASCON_MASKED_KEY_SHARES == 2
+    preserve[0] = ascon_trng_generate_64(trng);
+#elif ASCON_MASKED_KEY_SHARES == 3
+    preserve[0] = ascon_trng_generate_64(trng);
+    preserve[1] = ascon_trng_generate_64(trng);
+#else
+    preserve[0] = ascon_trng_generate_64(trng);
+    preserve[1] = ascon_trng_generate_64(trng);
+    preserve[2] = ascon_trng_generate_64(trng);
+#endif
+}
+
+/* Squeezes output from a masked state in the key shares form */
+static void ascon_masked_prf_squeeze_key
+    (ascon_masked_state_t *state, unsigned char *out, size_t outlen,
+     uint64_t *preserve)
+{
+    unsigned char block[ASCON_PRF_RATE_OUT];
+    for (;;) {
+        ascon_masked_key_permute(state, 0, preserve);
+        ascon_masked_key_store(block, &(state->M[0]));
+        ascon_masked_key_store(block + 8, &(state->M[1]));
+        if (outlen <= ASCON_PRF_RATE_OUT) {
+            memcpy(out, block, outlen);
+            break;
+        }
+        memcpy(out, block, ASCON_PRF_RATE_OUT);
+        out += ASCON_PRF_RATE_OUT;
+        outlen -= ASCON_PRF_RATE_OUT;
+    }
+    ascon_clean(block, sizeof(block));
+}
+
+static void ascon_masked_prf_core
+    (unsigned char *out, size_t outlen, size_t fixedlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *k,
+     ascon_masked_state_t *state, ascon_state_t *state_x1,
+     ascon_trng_state_t *trng, ascon_masked_word_t *word, uint64_t *preserve)
+{
+    unsigned char iv[8] = {0x80, 0x80, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x00};
+    unsigned char block[ASCON_PRF_RATE_IN];
+    unsigned temp;
+
+    /* Format the IV and key into the initial state */
+#if !defined(__SIZEOF_SIZE_T__) || __SIZEOF_SIZE_T__ >= 4
+    if (fixedlen >= (((size_t)1) << 29))
+        fixedlen = 0; /* Too large, so switch to arbitrary-length output */
+#endif
+    be_store_word32(iv + 4, (uint32_t)(fixedlen * 8U));
+    ascon_masked_prf_refresh(preserve, trng);
+    ascon_masked_state_init(state);
+    ascon_masked_key_randomize(state, trng);
+    ascon_masked_key_load(word, iv, trng);
+    ascon_masked_key_xor(&(state->M[0]), word);
+    ascon_masked_key_xor(&(state->M[1]), &(k->k[0]));
+    ascon_masked_key_xor(&(state->M[2]), &(k->k[1]));
+    ascon_masked_key_permute(state, 0, preserve);
+
+    if (inlen < ASCON_PRF_RATE_IN) {
+        /* Short input: pad the single block and stay in key shares form
+         * for the rest of the computation, which saves converting the
+         * state to the data shares form and back */
+        temp = (unsigned)inlen;
+        memcpy(block, in, temp);
+        block[temp] = 0x80;
+        memset(block + temp + 1, 0, sizeof(block) - temp - 1);
+        ascon_masked_key_load(word, block, trng);
+        ascon_masked_key_xor(&(state->M[0]), word);
+        ascon_masked_key_load(word, block + 8, trng);
+        ascon_masked_key_xor(&(state->M[1]), word);
+        ascon_masked_key_load(word, block + 16, trng);
+        ascon_masked_key_xor(&(state->M[2]), word);
+        ascon_masked_key_load(word, block + 24, trng);
+        ascon_masked_key_xor(&(state->M[3]), word);
+        ascon_masked_word_separator(&(state->M[4]));
+        ascon_masked_prf_squeeze_key(state, out, outlen, preserve);
+        ascon_clean(block, sizeof(block));
+    } else {
+#if ASCON_MASKED_DATA_SHARES == 1
+        /* Convert into an unmasked state and absorb the input */
+        ascon_masked_aead_key_to_data(state, state_x1, 1, trng);
+        while (inlen >= ASCON_PRF_RATE_IN) {
+            ascon_absorb_16(state_x1, in, 0);
+            ascon_absorb_16(state_x1, in + 16, 16);
+            ascon_permute(state_x1, 0);
+            in += ASCON_PRF_RATE_IN;
+            inlen -= ASCON_PRF_RATE_IN;
+        }
+        temp = (unsigned)inlen;
+        if (temp > 0)
+            ascon_absorb_partial(state_x1, in, 0, temp);
+        ascon_pad(state_x1, temp);
+        ascon_separator(state_x1);
+
+        /* Squeeze out the output */
+        while (outlen >= ASCON_PRF_RATE_OUT) {
+            ascon_permute(state_x1, 0);
+            ascon_squeeze_16(state_x1, out, 0);
+            out += ASCON_PRF_RATE_OUT;
+            outlen -= ASCON_PRF_RATE_OUT;
+        }
+        if (outlen > 0) {
+            ascon_permute(state_x1, 0);
+            ascon_squeeze_partial(state_x1, out, 0, (unsigned)outlen);
+        }
+        ascon_free(state_x1);
+#else
+        /* Convert into the data shares form and absorb the input */
+        (void)state_x1;
+        ascon_masked_aead_key_to_data
+            (state, 0, ASCON_MASKED_DATA_SHARES, trng);
+        ascon_masked_aead_absorb_32
+            (state, in, inlen, 0, word, preserve, trng);
+        ascon_masked_word_separator(&(state->M[4]));
+
+        /* Squeeze out the output */
+        ascon_masked_aead_squeeze_16(state, out, outlen, 0, preserve);
+#endif
+    }
+
+    /* Clean up */
+    ascon_masked_state_free(state);
+    ascon_clean(word, sizeof(ascon_masked_word_t));
+    ascon_clean(preserve, sizeof(uint64_t) * (ASCON_MASKED_KEY_SHARES - 1));
+}
+
+static void ascon_masked_prf_fixed
+    (unsigned char *out, size_t outlen, size_t fixedlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key)
+{
+    ascon_masked_state_t state;
+#if ASCON_MASKED_DATA_SHARES == 1
+    ascon_state_t x1;
+    ascon_state_t *state_x1 = &x1;
+#else
+    ascon_state_t *state_x1 = 0;
+#endif
+    ascon_trng_state_t trng;
+    ascon_masked_word_t word;
+    uint64_t preserve[ASCON_MASKED_KEY_SHARES - 1];
+
+    ascon_trng_init(&trng);
+    ascon_masked_prf_core
+        (out, outlen, fixedlen, in, inlen, key,
+         &state, state_x1, &trng, &word, preserve);
+    ascon_trng_free(&trng);
+}
+
+void ascon_masked_prf
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key)
+{
+    ascon_masked_prf_fixed(out, outlen, 0, in, inlen, key);
+}
+
+int ascon_masked_prf_short
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key)
+{
+    unsigned char iv[8] = {0x80, 0x00, 0x4c, 0x80, 0x00, 0x00, 0x00, 0x00};
+    unsigned char block[ASCON_PRF_SHORT_MAX_INPUT_SIZE];
+    ascon_masked_state_t state;
+    ascon_trng_state_t trng;
+    ascon_masked_word_t word;
+    uint64_t preserve[ASCON_MASKED_KEY_SHARES - 1];
+    if (inlen > ASCON_PRF_SHORT_MAX_INPUT_SIZE)
+        return -1;
+    if (outlen > ASCON_PRF_SHORT_MAX_OUTPUT_SIZE)
+        return -1;
+
+    /* Format the IV, key, and input into the initial state */
+    iv[1] = (unsigned char)(inlen * 8U);
+    memcpy(block, in, inlen);
+    memset(block + inlen, 0, sizeof(block) - inlen);
+    ascon_trng_init(&trng);
+    ascon_masked_prf_refresh(preserve, &trng);
+    ascon_masked_state_init(&state);
+    ascon_masked_key_randomize(&state, &trng);
+    ascon_masked_key_load(&word, iv, &trng);
+    ascon_masked_key_xor(&(state.M[0]), &word);
+    ascon_masked_key_xor(&(state.M[1]), &(key->k[0]));
+    ascon_masked_key_xor(&(state.M[2]), &(key->k[1]));
+    ascon_masked_key_load(&word, block, &trng);
+    ascon_masked_key_xor(&(state.M[3]), &word);
+    ascon_masked_key_load(&word, block + 8, &trng);
+    ascon_masked_key_xor(&(state.M[4]), &word);
+
+    /* A single permutation call and then the key is added to the output */
+    ascon_masked_key_permute(&state, 0, preserve);
+    ascon_masked_key_xor(&(state.M[3]), &(key->k[0]));
+    ascon_masked_key_xor(&(state.M[4]), &(key->k[1]));
+    ascon_masked_key_store(block, &(state.M[3]));
+    ascon_masked_key_store(block + 8, &(state.M[4]));
+    memcpy(out, block, outlen);
+
+    /* Clean up */
+    ascon_masked_state_free(&state);
+    ascon_trng_free(&trng);
+    ascon_clean(block, sizeof(block));
+    ascon_clean(&word, sizeof(word));
+    ascon_clean(preserve, sizeof(preserve));
+    return 0;
+}
+
+void ascon_masked_mac
+    (unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key)
+{
+    ascon_masked_prf_fixed
+        (tag, ASCON_MAC_TAG_SIZE, ASCON_MAC_TAG_SIZE, in, inlen, key);
+}
+
+int ascon_masked_mac_verify
+    (const unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key)
+{
+    unsigned char tag2[ASCON_MAC_TAG_SIZE];
+    int result;
+    ascon_masked_mac(tag2, in, inlen, key);
+    result = ascon_aead_check_tag(0, 0, tag, tag2, sizeof(tag2));
+    ascon_clean(tag2, sizeof(tag2));
+    return result;
+}
+
+#endif /* ASCON_ENABLE_MASKING */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_PRF_MASKED_H
+#define ASCON_PRF_MASKED_H
+
+#include "ascon-prf.h"
+#include "ascon-masking.h"
+
+/**
+ * \file ascon-prf-masked.h
+ * \brief Masked ASCON-Prf, ASCON-PrfShort, and ASCON-Mac algorithms.
+ *
+ * These functions produce the same output as the unmasked versions in
+ * ascon-prf.h, but the key is supplied in masked form and the state
+ * is masked while the key is being absorbed.
+ *
+ * Inputs that fit in a single 32-byte block of ASCON-Prf, and all inputs
+ * to ASCON-PrfShort, are processed entirely with the number of key shares.
+ * Longer inputs are converted to the number of data shares after the
+ * key has been absorbed, in the same way as the masked AEAD modes.
+ *
+ * References: https://eprint.iacr.org/2021/1574
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Processes a masked key and input data with ASCON-Prf to
+ * produce a tag.
+ *
+ * \param out Buffer to receive the PRF tag which must be at least
+ * \a outlen bytes in length.
+ * \param outlen Length of the output buffer in bytes.  Recommended to be
+ * ASCON_PRF_TAG_SIZE.
+ * \param in Points to the input data to be processed.
+ * \param inlen Length of the input data in bytes.
+ * \param key Points to the masked 128-bit key.
+ *
+ * This function operates ASCON-Prf in unlimited output mode, with the
+ * output truncated at \a outlen bytes.
+ *
+ * \sa ascon_prf(), ascon_masked_mac()
+ */
+void ascon_masked_prf
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key);
+
+/**
+ * \brief Processes a masked key and input data with ASCON-PrfShort to
+ * produce a tag.
+ *
+ * \param out Buffer to receive the PRF tag which must be at least
+ * \a outlen bytes in length.
+ * \param outlen Length of the output buffer in bytes between 0 and
+ * ASCON_PRF_SHORT_MAX_OUTPUT_SIZE.
+ * \param in Points to the input data to be processed.
+ * \param inlen Length of the input data in bytes between 0 and
+ * ASCON_PRF_SHORT_MAX_INPUT_SIZE.
+ * \param key Points to the masked 128-bit key.
+ *
+ * \return 0 if the output was generated, or -1 if either \a outlen or
+ * \a inlen are out of range.
+ *
+ * \sa ascon_prf_short()
+ */
+int ascon_masked_prf_short
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key);
+
+/**
+ * \brief Processes a masked key and input data with ASCON-Mac to
+ * produce a tag.
+ *
+ * \param tag Buffer to receive the ASCON_PRF_TAG_SIZE bytes of the tag.
+ * \param in Points to the input data to be processed.
+ * \param inlen Length of the input data in bytes.
+ * \param key Points to the masked 128-bit key.
+ *
+ * \sa ascon_mac(), ascon_masked_mac_verify()
+ */
+void ascon_masked_mac
+    (unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key);
+
+/**
+ * \brief Verifies an ASCON-Mac tag value with a masked key.
+ *
+ * \param tag Buffer that contains the ASCON_PRF_TAG_SIZE bytes of the tag.
+ * \param in Points to the input data to be processed.
+ * \param inlen Length of the input data in bytes.
+ * \param key Points to the masked 128-bit key.
+ *
+ * \return 0 if the \a tag is correct or -1 if incorrect.
+ *
+ * \sa ascon_mac_verify(), ascon_masked_mac()
+ */
+int ascon_masked_mac_verify
+    (const unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_masked_key_128_t *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-prf.h"
+#include "ascon-utility.h"
+#include "utility/ascon-multi.h"
+#include "utility/ascon-util.h"
+#include "utility/ascon-util-snp.h"
+
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Size of the hash table output in bytes.
+ */
+#define ASCON_TABLE_HASH_SIZE 8
+
+void ascon_table_hash_init_key
+    (ascon_table_hash_key_t *pk, const unsigned char *key)
+{
+    static unsigned char const iv[8] =
+        {0x80, 0x00, 0x4c, 0x80, 0x00, 0x00, 0x00, 0x00};
+    ascon_prf_state_t prf;
+
+    /* Load the IV and key for ASCON-PrfShort.  The input length and the
+     * input itself are filled in separately for each call. */
+    ascon_init(&(pk->short_state));
+    ascon_overwrite_bytes(&(pk->short_state), iv, 0, 8);
+    ascon_overwrite_bytes
+        (&(pk->short_state), key, 8, ASCON_PRF_SHORT_KEY_SIZE);
+    ascon_release(&(pk->short_state));
+
+    /* Run the keyed initialization of ASCON-Prf once for long inputs */
+    ascon_prf_fixed_init(&prf, key, ASCON_TABLE_HASH_SIZE);
+    ascon_init(&(pk->long_state));
+    ascon_copy(&(pk->long_state), &(prf.state));
+    ascon_release(&(pk->long_state));
+    ascon_prf_free(&prf);
+
+    /* The PrfShort output is masked with the first half of the key */
+    pk->key0 = le_load_word64(key);
+}
+
+void ascon_table_hash_free_key(ascon_table_hash_key_t *pk)
+{
+    if (pk) {
+        ascon_acquire(&(pk->short_state));
+        ascon_free(&(pk->short_state));
+        ascon_acquire(&(pk->long_state));
+        ascon_free(&(pk->long_state));
+        ascon_clean(&(pk->key0), sizeof(pk->key0));
+    }
+}
+
+/**
+ * \brief Loads a short input into a state for ASCON-PrfShort.
+ *
+ * \param state The state to load, which has been initialized.
+ * \param pk Points to the pre-computed key.
+ * \param in Points to the input.
+ * \param inlen Length of the input, at most 16 bytes.
+ */
+static void ascon_table_hash_load_short
+    (ascon_state_t *state, const ascon_table_hash_key_t *pk,
+     const unsigned char *in, size_t inlen)
+{
+    unsigned char bits = (unsigned char)(inlen * 8U);
+    ascon_copy(state, &(pk->short_state));
+    ascon_overwrite_bytes(state, &bits, 1, 1);
+    ascon_overwrite_bytes(state, in, 24, (unsigned)inlen);
+}
+
+/**
+ * \brief Extracts the 64-bit ASCON-PrfShort output from a state.
+ *
+ * \param state The state after the permutation.
+ * \param pk Points to the pre-computed key.
+ *
+ * \return The hash value.
+ */
+static uint64_t ascon_table_hash_extract_short
+    (ascon_state_t *state, const ascon_table_hash_key_t *pk)
+{
+    unsigned char out[ASCON_TABLE_HASH_SIZE];
+    ascon_extract_bytes(state, out, 24, ASCON_TABLE_HASH_SIZE);
+    return le_load_word64(out) ^ pk->key0;
+}
+
+/**
+ * \brief Hashes a long input with ASCON-Prf from the pre-computed state.
+ *
+ * \param pk Points to the pre-computed key.
+ * \param in Points to the input.
+ * \param inlen Length of the input.
+ *
+ * \return The hash value.
+ */
+static uint64_t ascon_table_hash_long
+    (const ascon_table_hash_key_t *pk, const unsigned char *in, size_t inlen)
+{
+    ascon_prf_state_t prf;
+    unsigned char out[ASCON_TABLE_HASH_SIZE];
+    ascon_init(&(prf.state));
+    ascon_copy(&(prf.state), &(pk->long_state));
+    ascon_release(&(prf.state));
+    prf.count = 0;
+    prf.mode = 0;
+    ascon_prf_absorb(&prf, in, inlen);
+    ascon_prf_squeeze(&prf, out, ASCON_TABLE_HASH_SIZE);
+    ascon_prf_free(&prf);
+    return le_load_word64(out);
+}
+
+uint64_t ascon_table_hash
+    (const ascon_table_hash_key_t *pk, const unsigned char *in, size_t inlen)
+{
+    ascon_state_t state;
+    uint64_t hash;
+    if (inlen > ASCON_PRF_SHORT_MAX_INPUT_SIZE)
+        return ascon_table_hash_long(pk, in, inlen);
+    ascon_init(&state);
+    ascon_table_hash_load_short(&state, pk, in, inlen);
+    ascon_permute(&state, 0);
+    hash = ascon_table_hash_extract_short(&state, pk);
+    ascon_free(&state);
+    return hash;
+}
+
+void ascon_table_hash_batch
+    (uint64_t *out, const ascon_table_hash_key_t *pk,
+     const unsigned char * const *in, const size_t *inlen, size_t count)
+{
+    ascon_state_t state[ASCON_MULTI_LANES];
+    ascon_state_t *states[ASCON_MULTI_LANES];
+    uint64_t *outputs[ASCON_MULTI_LANES];
+    unsigned lanes = 0;
+    unsigned index;
+    for (index = 0; index < ASCON_MULTI_LANES; ++index) {
+        ascon_init(&(state[index]));
+        states[index] = &(state[index]);
+    }
+    for (;;) {
+        /* Gather short inputs into the lanes; long inputs are hashed
+         * on their own as they do not fit the lane structure */
+        while (lanes < ASCON_MULTI_LANES && count > 0) {
+            if (*inlen <= ASCON_PRF_SHORT_MAX_INPUT_SIZE) {
+                ascon_table_hash_load_short(states[lanes], pk, *in, *inlen);
+                outputs[lanes++] = out;
+            } else {
+                *out = ascon_table_hash_long(pk, *in, *inlen);
+            }
+            ++out;
+            ++in;
+            ++inlen;
+            --count;
+        }
+        if (!lanes)
+            break;
+        ascon_permute_multi(states, lanes, 0);
+        for (index = 0; index < lanes; ++index) {
+            *(outputs[index]) =
+                ascon_table_hash_extract_short(states[index], pk);
+        }
+        lanes = 0;
+    }
+    for (index = 0; index < ASCON_MULTI_LANES; ++index)
+        ascon_free(&(state[index]));
+}
+
+#endif /* ASCON_ENABLE_HASH */
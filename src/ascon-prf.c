@@ -20,11 +20,14 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-prf.h"
 #include "ascon-utility.h"
 #include "utility/ascon-util-snp.h"
 #include "utility/ascon-aead-common.h"
 
+#if ASCON_ENABLE_HASH
+
 /**
  * \brief Rate of absorption for input blocks.
  */
@@ -143,6 +146,17 @@ void ascon_prf_fixed_reinit
     ascon_prf_fixed_init(state, key, outlen);
 }
 
+void ascon_prf_reset(ascon_prf_state_t *state, const ascon_prf_state_t *tmpl)
+{
+    if (state != tmpl) {
+        ascon_acquire(&(state->state));
+        ascon_copy(&(state->state), &(tmpl->state));
+        ascon_release(&(state->state));
+        state->count = tmpl->count;
+        state->mode = tmpl->mode;
+    }
+}
+
 void ascon_prf_free(ascon_prf_state_t *state)
 {
     if (state) {
@@ -255,3 +269,5 @@ void ascon_prf_squeeze
     /* Release access to the shared hardware */
     ascon_release(&(state->state));
 }
+
+#endif /* ASCON_ENABLE_HASH */
@@ -212,6 +212,60 @@ int ascon_mac_verify
      const unsigned char *in, size_t inlen,
      const unsigned char *key);
 
+/**
+ * \brief Processes a batch of short inputs with ASCON-PrfShort under
+ * the same key.
+ *
+ * \param out Buffer to receive the PRF tags, which must be at least
+ * \a count * \a outlen bytes in length.  The tag for input i starts
+ * at offset i * \a outlen.
+ * \param outlen Length of each tag in bytes between 0 and
+ * ASCON_PRF_SHORT_MAX_OUTPUT_SIZE.
+ * \param in Array of pointers to the inputs.
+ * \param inlen Array of input lengths in bytes, each between 0 and
+ * ASCON_PRF_SHORT_MAX_INPUT_SIZE.
+ * \param count Number of inputs.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 if the outputs were generated, or -1 if \a outlen or any
+ * of the input lengths are out of range.  Nothing is generated if -1
+ * is returned.
+ *
+ * The output for each input is the same as if ascon_prf_short() had
+ * been called on the input separately.  The key is loaded into the
+ * permutation state once and the inputs are processed side by side
+ * with the multi-state permutations.
+ *
+ * \sa ascon_prf_short()
+ */
+int ascon_prf_short_batch
+    (unsigned char *out, size_t outlen,
+     const unsigned char * const *in, const size_t *inlen, size_t count,
+     const unsigned char *key);
+
+/**
+ * \brief Processes a batch of inputs with ASCON-Mac under the same key.
+ *
+ * \param tags Buffer to receive the tags, which must be at least
+ * \a count * ASCON_MAC_TAG_SIZE bytes in length.  The tag for input i
+ * starts at offset i * ASCON_MAC_TAG_SIZE.
+ * \param in Array of pointers to the inputs.
+ * \param inlen Array of input lengths in bytes.
+ * \param count Number of inputs.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * The output for each input is the same as if ascon_mac() had been
+ * called on the input separately.  The keyed initialization permutation
+ * is only run once for the whole batch, and the inputs are processed
+ * side by side with the multi-state permutations.
+ *
+ * \sa ascon_mac()
+ */
+void ascon_mac_batch
+    (unsigned char *tags,
+     const unsigned char * const *in, const size_t *inlen, size_t count,
+     const unsigned char *key);
+
 /**
  * \brief Initializes the state for an incremental ASCON-Prf operation.
  *
@@ -268,6 +322,23 @@ void ascon_prf_reinit(ascon_prf_state_t *state, const unsigned char *key);
 void ascon_prf_fixed_reinit
     (ascon_prf_state_t *state, const unsigned char *key, size_t outlen);
 
+/**
+ * \brief Resets an ASCON-Prf state to a copy of a keyed template state.
+ *
+ * \param state PRF state to be reset, which must already be initialized.
+ * \param tmpl Template state that was initialized with ascon_prf_init()
+ * or ascon_prf_fixed_init() and then left unused.
+ *
+ * Re-initializing with ascon_prf_reinit() runs the permutation on the key
+ * again.  Resetting from a template instead copies the keyed state
+ * without freeing or initializing the destination, which is cheaper when
+ * many short messages are authenticated with the same key.
+ *
+ * \sa ascon_prf_reinit()
+ */
+void ascon_prf_reset
+    (ascon_prf_state_t *state, const ascon_prf_state_t *tmpl);
+
 /**
  * \brief Frees the ASCON-Prf state and destroys any sensitive material.
  *
@@ -302,6 +373,274 @@ void ascon_prf_absorb
 void ascon_prf_squeeze
     (ascon_prf_state_t *state, unsigned char *out, size_t outlen);
 
+/* ---------------------------------------------------------------- */
+/*                  Keyed hashing for hash tables                   */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Pre-computed key for keyed hashing of hash table keys.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** IV and key loaded for ASCON-PrfShort, before the permutation */
+    ascon_state_t short_state;
+
+    /** ASCON-Prf state after the keyed initialization permutation */
+    ascon_state_t long_state;
+
+    /** First 8 bytes of the key as a little-endian word */
+    uint64_t key0;
+
+} ascon_table_hash_key_t;
+
+/**
+ * \brief Initializes a pre-computed key for hash table hashing.
+ *
+ * \param pk Points to the object to receive the pre-computed key.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * The key should be chosen at random when the hash table is created so
+ * that an attacker cannot choose inputs that collide, in the same way as
+ * SipHash is used to protect hash tables against flooding.
+ *
+ * \sa ascon_table_hash(), ascon_table_hash_free_key()
+ */
+void ascon_table_hash_init_key
+    (ascon_table_hash_key_t *pk, const unsigned char *key);
+
+/**
+ * \brief Frees a pre-computed hash table key and destroys any sensitive
+ * material.
+ *
+ * \param pk Points to the pre-computed key to free.
+ */
+void ascon_table_hash_free_key(ascon_table_hash_key_t *pk);
+
+/**
+ * \brief Hashes a hash table key with a pre-computed key to produce
+ * a 64-bit value.
+ *
+ * \param pk Points to the pre-computed key.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ *
+ * \return The 64-bit hash value.
+ *
+ * Inputs of up to ASCON_PRF_SHORT_MAX_INPUT_SIZE bytes, which covers
+ * integers, addresses, and most identifiers, take a single permutation
+ * with ASCON-PrfShort.  The result is the same as the first 8 bytes of
+ * ascon_prf_short() interpreted as a little-endian number.  Longer inputs
+ * are hashed with ASCON-Prf in fixed-length mode with an 8 byte output,
+ * starting from the pre-computed state so that the keyed initialization
+ * permutation is not repeated.
+ *
+ * \sa ascon_table_hash_batch()
+ */
+uint64_t ascon_table_hash
+    (const ascon_table_hash_key_t *pk, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Hashes a batch of hash table keys with a pre-computed key.
+ *
+ * \param out Array to receive the \a count hash values.
+ * \param pk Points to the pre-computed key.
+ * \param in Array of pointers to the inputs.
+ * \param inlen Array of input lengths in bytes.
+ * \param count Number of inputs.
+ *
+ * The output for each input is the same as if ascon_table_hash() had been
+ * called on the input separately.  Short inputs are processed side by
+ * side with the multi-state permutations, which helps when probing for
+ * several keys at once, such as the candidate slots for cuckoo hashing
+ * or a batch of lookups from a packet.
+ *
+ * \sa ascon_table_hash()
+ */
+void ascon_table_hash_batch
+    (uint64_t *out, const ascon_table_hash_key_t *pk,
+     const unsigned char * const *in, const size_t *inlen, size_t count);
+
+/* ---------------------------------------------------------------- */
+/*                     Counter-mode encryption                      */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Size of the nonce for ASCON-PRF counter mode in bytes.
+ */
+#define ASCON_PRF_CTR_NONCE_SIZE 12
+
+/**
+ * \brief Size of the authentication tag for ASCON-PRF counter mode in bytes.
+ */
+#define ASCON_PRF_CTR_TAG_SIZE 16
+
+/**
+ * \brief Size of the keystream blocks for ASCON-PRF counter mode in bytes.
+ */
+#define ASCON_PRF_CTR_BLOCK_SIZE 16
+
+/**
+ * \brief Size of the segments that are authenticated separately in
+ * ASCON-PRF counter mode.
+ */
+#define ASCON_PRF_CTR_SEGMENT_SIZE 4096
+
+/**
+ * \brief Maximum number of bytes that can be encrypted with a single
+ * nonce in ASCON-PRF counter mode, which is 64GiB.
+ */
+#define ASCON_PRF_CTR_MAX_LENGTH (((uint64_t)1) << 36)
+
+/**
+ * \brief XOR's a range of the ASCON-PRF counter mode keystream with
+ * a buffer.
+ *
+ * \param out Buffer to receive the output, which may be the same as \a in.
+ * \param in Points to the input to XOR with the keystream.
+ * \param len Number of bytes to XOR.
+ * \param offset Offset of the first byte in the keystream.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 on success, or -1 if the range extends past
+ * ASCON_PRF_CTR_MAX_LENGTH.
+ *
+ * Keystream block i is the 16 byte output of ASCON-PrfShort on the
+ * nonce followed by i as a 32-bit big-endian number.  Every block is
+ * independent of the others, so any range of the keystream can be
+ * generated directly and the blocks are computed side by side with the
+ * multi-state permutations.
+ *
+ * This function does not provide authentication by itself.
+ *
+ * \sa ascon_prf_ctr_encrypt()
+ */
+int ascon_prf_ctr_xor
+    (unsigned char *out, const unsigned char *in, size_t len,
+     uint64_t offset, const unsigned char *nonce, const unsigned char *key);
+
+/**
+ * \brief Encrypts a range of segments in ASCON-PRF counter mode and
+ * accumulates their authentication tags.
+ *
+ * \param c Buffer to receive the ciphertext, which may be the same as \a m.
+ * \param sum Points to ASCON_PRF_CTR_TAG_SIZE bytes that the segment tags
+ * are XOR'ed into.
+ * \param m Points to the plaintext of the segments.
+ * \param mlen Length of the plaintext in bytes.  This must be a multiple
+ * of ASCON_PRF_CTR_SEGMENT_SIZE unless the range ends at the end of
+ * the message.
+ * \param first_segment Index of the first segment in the range.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 on success, or -1 if the range extends past
+ * ASCON_PRF_CTR_MAX_LENGTH.
+ *
+ * The tag for segment i is the ASCON-Mac of a zero byte, the nonce,
+ * i as a 64-bit big-endian number, and the ciphertext of the segment.
+ * Because the tags are combined with XOR, the segments of a large
+ * message can be divided between threads or devices in any order,
+ * each with its own \a sum, and the sums XOR'ed together afterwards
+ * to be passed to ascon_prf_ctr_final_tag().
+ *
+ * \sa ascon_prf_ctr_decrypt_segments(), ascon_prf_ctr_final_tag()
+ */
+int ascon_prf_ctr_encrypt_segments
+    (unsigned char *c, unsigned char *sum,
+     const unsigned char *m, size_t mlen, uint64_t first_segment,
+     const unsigned char *nonce, const unsigned char *key);
+
+/**
+ * \brief Decrypts a range of segments in ASCON-PRF counter mode and
+ * accumulates their authentication tags.
+ *
+ * \param m Buffer to receive the plaintext, which may be the same as \a c.
+ * \param sum Points to ASCON_PRF_CTR_TAG_SIZE bytes that the segment tags
+ * are XOR'ed into.
+ * \param c Points to the ciphertext of the segments.
+ * \param clen Length of the ciphertext in bytes, not including the tag.
+ * This must be a multiple of ASCON_PRF_CTR_SEGMENT_SIZE unless the range
+ * ends at the end of the message.
+ * \param first_segment Index of the first segment in the range.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 on success, or -1 if the range extends past
+ * ASCON_PRF_CTR_MAX_LENGTH.
+ *
+ * The plaintext must not be used until the final tag has been computed
+ * with ascon_prf_ctr_final_tag() and checked against the received tag.
+ *
+ * \sa ascon_prf_ctr_encrypt_segments(), ascon_prf_ctr_final_tag()
+ */
+int ascon_prf_ctr_decrypt_segments
+    (unsigned char *m, unsigned char *sum,
+     const unsigned char *c, size_t clen, uint64_t first_segment,
+     const unsigned char *nonce, const unsigned char *key);
+
+/**
+ * \brief Computes the final authentication tag for ASCON-PRF counter mode.
+ *
+ * \param tag Buffer to receive the ASCON_PRF_CTR_TAG_SIZE bytes of the tag.
+ * \param sum Points to the XOR of the tags for all segments in the message.
+ * \param len Total length of the message in bytes.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * The final tag is the ASCON-Mac of a one byte, the nonce, \a len as
+ * a 64-bit big-endian number, and \a sum.
+ */
+void ascon_prf_ctr_final_tag
+    (unsigned char *tag, const unsigned char *sum, uint64_t len,
+     const unsigned char *nonce, const unsigned char *key);
+
+/**
+ * \brief Encrypts and authenticates a message with ASCON-PRF counter mode.
+ *
+ * \param c Buffer to receive the ciphertext, which may be the same as \a m.
+ * \param tag Buffer to receive the ASCON_PRF_CTR_TAG_SIZE bytes of the tag.
+ * \param m Points to the plaintext.
+ * \param mlen Length of the plaintext in bytes.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 on success, or -1 if \a mlen is greater than
+ * ASCON_PRF_CTR_MAX_LENGTH.
+ *
+ * The nonce must not be reused with the same key.  Associated data is
+ * not supported; use the AEAD modes in "ascon-aead.h" for that.
+ *
+ * \sa ascon_prf_ctr_decrypt(), ascon_prf_ctr_encrypt_parallel()
+ */
+int ascon_prf_ctr_encrypt
+    (unsigned char *c, unsigned char *tag,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *nonce, const unsigned char *key);
+
+/**
+ * \brief Decrypts and authenticates a message with ASCON-PRF counter mode.
+ *
+ * \param m Buffer to receive the plaintext, which may be the same as \a c.
+ * \param c Points to the ciphertext.
+ * \param clen Length of the ciphertext in bytes.
+ * \param tag Points to the ASCON_PRF_CTR_TAG_SIZE bytes of the tag.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ *
+ * \return 0 on success, or -1 if the tag is incorrect or \a clen is
+ * greater than ASCON_PRF_CTR_MAX_LENGTH.  The plaintext is cleared
+ * if the tag is incorrect.
+ *
+ * \sa ascon_prf_ctr_encrypt(), ascon_prf_ctr_decrypt_parallel()
+ */
+int ascon_prf_ctr_decrypt
+    (unsigned char *m, const unsigned char *c, size_t clen,
+     const unsigned char *tag,
+     const unsigned char *nonce, const unsigned char *key);
+
 #ifdef __cplusplus
 }
 #endif
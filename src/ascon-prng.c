@@ -20,8 +20,10 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-latency.h"
 #include "ascon-random.h"
 #include "ascon-utility.h"
+#include "utility/ascon-multi.h"
 #include "utility/ascon-trng.h"
 #include "utility/ascon-util-snp.h"
 
@@ -30,6 +32,11 @@
  */
 #define ASCON_RANDOM_RESEED_LIMIT 16384
 
+/**
+ * \brief Rate for squeezing output in the high-throughput modes.
+ */
+#define ASCON_RANDOM_FAST_RATE 16
+
 /**
  * \brief Re-keys the state of a pseudorandom number generator.
  *
@@ -58,6 +65,20 @@ static void ascon_random_rekey(ascon_random_state_t *state)
         ascon_xof_clear_rate(&(state->xof));
 }
 
+/**
+ * \brief Adds the number of generated bytes to the re-seed counter.
+ *
+ * \param state The pseudorandom number generator.
+ * \param outlen Number of bytes that were generated.
+ */
+static void ascon_random_count(ascon_random_state_t *state, size_t outlen)
+{
+    if (outlen < ASCON_RANDOM_RESEED_LIMIT)
+        state->counter += outlen;
+    else
+        state->counter = ASCON_RANDOM_RESEED_LIMIT;
+}
+
 int ascon_random_init(ascon_random_state_t *state)
 {
     unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
@@ -85,11 +106,13 @@ void ascon_random_free(ascon_random_state_t *state)
 void ascon_random_generate
     (ascon_random_state_t *state, unsigned char *out, size_t outlen)
 {
+    ascon_latency_begin();
     /* If there is no state, use the global ascon_random() function
      * so that we return something.  Safer than returning nothing
      * to the caller by accident and having them use that nothing. */
     if (!state) {
         ascon_random(out, outlen);
+        ascon_latency_end(ASCON_LATENCY_PRNG);
         return;
     }
 
@@ -99,13 +122,156 @@ void ascon_random_generate
 
     /* Squeeze data out of the PRNG state */
     ascon_xof_squeeze(&(state->xof), out, outlen);
-    if (outlen < ASCON_RANDOM_RESEED_LIMIT)
-        state->counter += outlen;
-    else
-        state->counter = ASCON_RANDOM_RESEED_LIMIT;
+    ascon_random_count(state, outlen);
 
     /* Re-key the PRNG to enforce forward security */
     ascon_random_rekey(state);
+    ascon_latency_end(ASCON_LATENCY_PRNG);
+}
+
+/**
+ * \brief Re-keys the state of a pseudorandom number generator after
+ * output has been squeezed with the high-throughput rate.
+ *
+ * \param state The ASCON permutation state, which must be acquired.
+ *
+ * This is the same as ascon_random_rekey() except that the rate is
+ * ASCON_RANDOM_FAST_RATE, so ceil(24 / 16) = 2 iterations are required.
+ */
+static void ascon_random_fast_rekey(ascon_state_t *state)
+{
+    ascon_overwrite_with_zeroes(state, 0, ASCON_RANDOM_FAST_RATE);
+    ascon_permute(state, 0);
+    ascon_overwrite_with_zeroes(state, 0, ASCON_RANDOM_FAST_RATE);
+    ascon_permute(state, 0);
+}
+
+/**
+ * \brief Converts a requested number of rounds into the first round
+ * for the permutation.
+ *
+ * \param rounds The requested number of rounds.
+ *
+ * \return The first round, clamped so that between ASCON_RANDOM_MIN_ROUNDS
+ * and 12 rounds are performed.
+ */
+static uint8_t ascon_random_first_round(unsigned rounds)
+{
+    if (rounds < ASCON_RANDOM_MIN_ROUNDS)
+        rounds = ASCON_RANDOM_MIN_ROUNDS;
+    else if (rounds > 12)
+        rounds = 12;
+    return (uint8_t)(12 - rounds);
+}
+
+void ascon_random_generate_fast
+    (ascon_random_state_t *state, unsigned char *out, size_t outlen,
+     unsigned rounds)
+{
+    uint8_t first_round = ascon_random_first_round(rounds);
+    size_t len = outlen;
+    ascon_latency_begin();
+
+    /* Fall back to the global function if there is no state */
+    if (!state) {
+        ascon_random(out, outlen);
+        ascon_latency_end(ASCON_LATENCY_PRNG);
+        return;
+    }
+
+    /* Force a re-seed if we have generated too many bytes so far */
+    if (state->counter >= ASCON_RANDOM_RESEED_LIMIT)
+        ascon_random_reseed(state);
+
+    /* Align on a block boundary and then squeeze full rate blocks
+     * directly into the output buffer */
+    ascon_xof_pad(&(state->xof));
+    ascon_acquire(&(state->xof.state));
+    while (len >= ASCON_RANDOM_FAST_RATE) {
+        ascon_permute(&(state->xof.state), first_round);
+        ascon_squeeze_16(&(state->xof.state), out, 0);
+        out += ASCON_RANDOM_FAST_RATE;
+        len -= ASCON_RANDOM_FAST_RATE;
+    }
+    if (len > 0) {
+        ascon_permute(&(state->xof.state), first_round);
+        ascon_squeeze_partial(&(state->xof.state), out, 0, (unsigned)len);
+    }
+
+    /* Re-key the PRNG to enforce forward security */
+    ascon_random_fast_rekey(&(state->xof.state));
+    ascon_release(&(state->xof.state));
+    ascon_random_count(state, outlen);
+    ascon_latency_end(ASCON_LATENCY_PRNG);
+}
+
+void ascon_random_generate_multi
+    (ascon_random_state_t *state, unsigned char *out, size_t outlen,
+     unsigned rounds)
+{
+    uint8_t first_round = ascon_random_first_round(rounds);
+    ascon_state_t lanes[ASCON_RANDOM_LANES];
+    ascon_state_t *states[ASCON_RANDOM_LANES];
+    size_t len = outlen;
+    unsigned char id;
+    unsigned index;
+    ascon_latency_begin();
+
+    /* Fall back to the global function if there is no state */
+    if (!state) {
+        ascon_random(out, outlen);
+        ascon_latency_end(ASCON_LATENCY_PRNG);
+        return;
+    }
+
+    /* Force a re-seed if we have generated too many bytes so far */
+    if (state->counter >= ASCON_RANDOM_RESEED_LIMIT)
+        ascon_random_reseed(state);
+
+    /* Derive the lanes from the main state, with the lane number in the
+     * capacity to separate them.  Then re-key the main state so that the
+     * lanes cannot be recovered from it afterwards. */
+    ascon_xof_pad(&(state->xof));
+    ascon_acquire(&(state->xof.state));
+    for (index = 0; index < ASCON_RANDOM_LANES; ++index) {
+        id = (unsigned char)(index + 1);
+        ascon_init(&(lanes[index]));
+        ascon_copy(&(lanes[index]), &(state->xof.state));
+        ascon_add_bytes(&(lanes[index]), &id, 39, 1);
+        states[index] = &(lanes[index]);
+    }
+    ascon_random_fast_rekey(&(state->xof.state));
+    ascon_release(&(state->xof.state));
+    ascon_random_count(state, outlen);
+
+    /* Squeeze the lanes into the output buffer */
+    ascon_permute_multi(states, ASCON_RANDOM_LANES, 0);
+    for (;;) {
+        if (len >= ASCON_RANDOM_FAST_RATE * ASCON_RANDOM_LANES) {
+            for (index = 0; index < ASCON_RANDOM_LANES; ++index) {
+                ascon_squeeze_16(states[index], out, 0);
+                out += ASCON_RANDOM_FAST_RATE;
+            }
+            len -= ASCON_RANDOM_FAST_RATE * ASCON_RANDOM_LANES;
+            if (!len)
+                break;
+            ascon_permute_multi(states, ASCON_RANDOM_LANES, first_round);
+        } else {
+            for (index = 0; index < ASCON_RANDOM_LANES && len > 0; ++index) {
+                unsigned temp = (len < ASCON_RANDOM_FAST_RATE)
+                              ? (unsigned)len : ASCON_RANDOM_FAST_RATE;
+                ascon_squeeze_partial(states[index], out, 0, temp);
+                out += temp;
+                len -= temp;
+            }
+            break;
+        }
+    }
+
+    /* Clean up */
+    for (index = 0; index < ASCON_RANDOM_LANES; ++index)
+        ascon_free(&(lanes[index]));
+    ascon_latency_end(ASCON_LATENCY_PRNG);
 }
 
 int ascon_random_reseed(ascon_random_state_t *state)
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-random.h"
+#include "ascon-utility.h"
+
+/**
+ * \def ASCON_RANDOM_THREADS
+ * \brief Define to 1 if the platform has threads and per-thread generators
+ * are required, or 0 if there is a single thread of execution.
+ */
+#if !defined(ASCON_RANDOM_THREADS)
+#if defined(ESP32) || defined(ESP_PLATFORM)
+#define ASCON_RANDOM_THREADS 1
+#elif !defined(ARDUINO) && (defined(__linux__) || defined(__APPLE__) || \
+    defined(__unix__) || defined(_WIN32))
+#define ASCON_RANDOM_THREADS 1
+#else
+#define ASCON_RANDOM_THREADS 0
+#endif
+#endif
+
+/* Storage class for thread-local data and atomic access to the epoch */
+#if ASCON_RANDOM_THREADS && defined(_MSC_VER)
+#include <intrin.h>
+#define ASCON_THREAD_LOCAL __declspec(thread)
+#define ascon_random_epoch_load() \
+    ((uint32_t)_InterlockedOr((volatile long *)&ascon_random_epoch, 0))
+#define ascon_random_epoch_next() \
+    (_InterlockedIncrement((volatile long *)&ascon_random_epoch))
+#elif ASCON_RANDOM_THREADS
+#define ASCON_THREAD_LOCAL __thread
+#define ascon_random_epoch_load() \
+    (__atomic_load_n(&ascon_random_epoch, __ATOMIC_ACQUIRE))
+#define ascon_random_epoch_next() \
+    (__atomic_fetch_add(&ascon_random_epoch, 1, __ATOMIC_RELEASE))
+#else
+#define ASCON_THREAD_LOCAL
+#define ascon_random_epoch_load() (ascon_random_epoch)
+#define ascon_random_epoch_next() (++ascon_random_epoch)
+#endif
+
+/**
+ * \brief Per-thread pseudorandom number generator.
+ */
+typedef struct
+{
+    /** Pseudorandom number generator for the thread */
+    ascon_random_state_t prng;
+
+    /** Value of the global epoch when the generator was last seeded */
+    uint32_t epoch;
+
+    /** Non-zero if the generator has been initialized */
+    unsigned char initialized;
+
+    /** Result from the system random number source at the last seeding */
+    unsigned char ok;
+
+} ascon_random_thread_state_t;
+
+/** Global epoch that is incremented to request a re-seed in all threads */
+static volatile uint32_t ascon_random_epoch = 0;
+
+/** Generator for the current thread */
+static ASCON_THREAD_LOCAL ascon_random_thread_state_t ascon_random_tls;
+
+int ascon_random_thread(unsigned char *out, size_t outlen)
+{
+    ascon_random_thread_state_t *state = &ascon_random_tls;
+    uint32_t epoch = ascon_random_epoch_load();
+    if (!(state->initialized)) {
+        state->ok = (ascon_random_init(&(state->prng)) != 0);
+        state->epoch = epoch;
+        state->initialized = 1;
+    } else if (state->epoch != epoch) {
+        state->ok = (ascon_random_reseed(&(state->prng)) != 0);
+        state->epoch = epoch;
+    }
+    ascon_random_generate(&(state->prng), out, outlen);
+    return state->ok;
+}
+
+void ascon_random_thread_reseed_all(void)
+{
+    ascon_random_epoch_next();
+}
+
+void ascon_random_thread_free(void)
+{
+    ascon_random_thread_state_t *state = &ascon_random_tls;
+    if (state->initialized) {
+        ascon_random_free(&(state->prng));
+        ascon_clean(state, sizeof(ascon_random_thread_state_t));
+    }
+}
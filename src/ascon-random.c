@@ -36,3 +36,12 @@ int ascon_random(unsigned char *out, size_t outlen)
     ascon_clean(seed, sizeof(seed));
     return ok ? 1 : 0;
 }
+
+int ascon_random_save_seed(void)
+{
+#if defined(ASCON_TRNG_NONE)
+    return ascon_trng_save_seed();
+#else
+    return 0;
+#endif
+}
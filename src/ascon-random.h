@@ -127,6 +127,73 @@ void ascon_random_free(ascon_random_state_t *state);
 void ascon_random_generate
     (ascon_random_state_t *state, unsigned char *out, size_t outlen);
 
+/**
+ * \brief Minimum number of permutation rounds that can be requested
+ * from ascon_random_generate_fast() and ascon_random_generate_multi().
+ *
+ * This is the same number of rounds that ASCON-128a and ASCON-XOFA use
+ * between 128-bit rate blocks.
+ */
+#define ASCON_RANDOM_MIN_ROUNDS 8
+
+/**
+ * \brief Number of lanes that are used by ascon_random_generate_multi().
+ */
+#define ASCON_RANDOM_LANES 4
+
+/**
+ * \brief Generates data from a pseudorandom number generator using a
+ * high-throughput squeezing mode.
+ *
+ * \param state The pseudorandom number generator state to use.
+ * \param out Points to a buffer to receive the random data.
+ * \param outlen Number of bytes of random data to generate.
+ * \param rounds Number of permutation rounds to perform between output
+ * blocks, between ASCON_RANDOM_MIN_ROUNDS and 12.  Values outside this
+ * range are clamped.
+ *
+ * This function squeezes 16 bytes of output per permutation directly
+ * into \a out instead of 8 bytes per permutation through ASCON-XOF.
+ * The SpongePRNG capacity is reduced from 256 bits to 192 bits, which
+ * is the same capacity as ASCON-128a.
+ *
+ * The output is not the same as ascon_random_generate(), but the state
+ * can be mixed freely with the other functions in this API.  Re-seeding
+ * and forward security re-keying at the end of the request are handled
+ * in the same way as ascon_random_generate().
+ *
+ * \sa ascon_random_generate(), ascon_random_generate_multi()
+ */
+void ascon_random_generate_fast
+    (ascon_random_state_t *state, unsigned char *out, size_t outlen,
+     unsigned rounds);
+
+/**
+ * \brief Generates a large amount of data from a pseudorandom number
+ * generator using several lanes in parallel.
+ *
+ * \param state The pseudorandom number generator state to use.
+ * \param out Points to a buffer to receive the random data.
+ * \param outlen Number of bytes of random data to generate.
+ * \param rounds Number of permutation rounds to perform between output
+ * blocks, between ASCON_RANDOM_MIN_ROUNDS and 12.  Values outside this
+ * range are clamped.
+ *
+ * This function derives ASCON_RANDOM_LANES independent sponge states
+ * from \a state and then re-keys \a state so that the lanes cannot be
+ * recovered from it later.  The lanes are squeezed in 16-byte blocks
+ * that are interleaved in \a out, using the multi-state permutation of
+ * the back end to permute all of the lanes at once.
+ *
+ * This is best suited to filling buffers of a kilobyte or more.
+ * For shorter requests, ascon_random_generate_fast() will be faster.
+ *
+ * \sa ascon_random_generate_fast()
+ */
+void ascon_random_generate_multi
+    (ascon_random_state_t *state, unsigned char *out, size_t outlen,
+     unsigned rounds);
+
 /**
  * \brief Explicitly re-seeds a pseudorandom number generator from the
  * system random number source.
@@ -192,6 +259,86 @@ void ascon_random_add_entropy
 void ascon_random_add_entropy_quick
     (ascon_random_state_t *state, uint64_t entropy);
 
+/**
+ * \brief Saves a seed for the system random number source to persistent
+ * storage so that the next boot starts with better entropy.
+ *
+ * \return Non-zero if the seed was saved; zero if the platform has a
+ * system TRNG or there is nowhere to save the seed.
+ *
+ * This is only useful on platforms without a TRNG, where the library
+ * otherwise seeds itself from timers alone.  Call it at shutdown or on a
+ * regular schedule; e.g. once an hour.  The seed is squeezed from the
+ * global PRNG, which is then re-keyed, so the saved seed reveals nothing
+ * about random data that is generated after the save.
+ *
+ * On the next boot, the saved seed is loaded, passed through ASCON-XOF,
+ * and mixed into the global PRNG.  A ratcheted replacement seed is written
+ * back straight away so that no seed is used twice.
+ *
+ * On AVR-based Arduino boards, define ASCON_SEED_EEPROM_ADDRESS to the
+ * EEPROM offset of a 32-byte area to hold the seed.  On other platforms,
+ * the application provides storage by defining the functions:
+ *
+ * \code
+ * int ascon_trng_load_seed(unsigned char *seed, size_t len);
+ * int ascon_trng_store_seed(const unsigned char *seed, size_t len);
+ * \endcode
+ *
+ * Each returns non-zero on success.  Writes happen once per boot and once
+ * per call to this function, so avoid calling it very often if the
+ * storage has limited write endurance.
+ */
+int ascon_random_save_seed(void);
+
+/**
+ * \brief Generates data from a pseudorandom number generator that is
+ * private to the calling thread.
+ *
+ * \param out Points to a buffer to receive the random data.
+ * \param outlen Number of bytes of random data to generate.
+ *
+ * \return Non-zero if the system random number source was working the
+ * last time that the calling thread's generator was seeded; zero if there
+ * is no system random number source or it has failed.
+ *
+ * The generator is created and seeded from the system random number source
+ * the first time that a thread calls this function.  After that, it is
+ * re-seeded automatically after every 16K of output in the same way as
+ * ascon_random_generate(), and whenever ascon_random_thread_reseed_all()
+ * has been called since the last request.  No locks are taken, so this
+ * is suitable for generating nonces at a high rate from many tasks.
+ *
+ * On platforms without threads, there is a single global generator.
+ *
+ * \sa ascon_random_thread_reseed_all(), ascon_random_thread_free()
+ */
+int ascon_random_thread(unsigned char *out, size_t outlen);
+
+/**
+ * \brief Schedules all per-thread pseudorandom number generators to be
+ * re-seeded from the system random number source.
+ *
+ * This function increments a global epoch counter atomically.  Each thread
+ * notices the change the next time that it calls ascon_random_thread()
+ * and re-seeds its generator at that point.  The calling thread does not
+ * wait for the other threads.
+ *
+ * \sa ascon_random_thread()
+ */
+void ascon_random_thread_reseed_all(void);
+
+/**
+ * \brief Destroys the pseudorandom number generator for the calling thread.
+ *
+ * Threads should call this before they exit so that the generator state
+ * does not linger in freed thread-local memory.  A new generator will be
+ * created if the thread calls ascon_random_thread() again afterwards.
+ *
+ * \sa ascon_random_thread()
+ */
+void ascon_random_thread_free(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-session.h"
+#include "utility/ascon-aead-common.h"
+#include "utility/ascon-util-snp.h"
+#include <string.h>
+
+#if ASCON_ENABLE_AEAD
+
+/**
+ * \brief Initialization vector for a duplex session, which has the same
+ * parameters as ASCON-128a.  The last byte is replaced with the direction.
+ */
+static uint8_t const ASCON_SESSION_IV[8] =
+    {0x80, 0x80, 0x0c, 0x08, 0x00, 0x00, 0x00, 0x00};
+
+/* Directions for the two states in a session */
+#define ASCON_SESSION_TO_RESPONDER 0x01
+#define ASCON_SESSION_TO_INITIATOR 0x02
+
+/**
+ * \brief Initializes the state for one direction of a session.
+ *
+ * \param state The state to initialize, which is released on exit.
+ * \param k Points to the session key.
+ * \param npub Points to the session nonce.
+ * \param direction The direction for the state.
+ */
+static void ascon_session_init_direction
+    (ascon_state_t *state, const unsigned char *k,
+     const unsigned char *npub, uint8_t direction)
+{
+    unsigned char iv[8];
+    memcpy(iv, ASCON_SESSION_IV, sizeof(iv));
+    iv[7] = direction;
+    ascon_init(state);
+    ascon_overwrite_bytes(state, iv, 0, 8);
+    ascon_overwrite_bytes(state, k, 8, ASCON_SESSION_KEY_SIZE);
+    ascon_overwrite_bytes(state, npub, 24, ASCON_SESSION_NONCE_SIZE);
+    ascon_permute(state, 0);
+    ascon_absorb_16(state, k, 24);
+    ascon_release(state);
+}
+
+void ascon_session_init
+    (ascon_session_state_t *state, const unsigned char *k,
+     const unsigned char *npub, int initiator)
+{
+    ascon_session_init_direction
+        (&(state->tx), k, npub, initiator ? ASCON_SESSION_TO_RESPONDER
+                                          : ASCON_SESSION_TO_INITIATOR);
+    ascon_session_init_direction
+        (&(state->rx), k, npub, initiator ? ASCON_SESSION_TO_INITIATOR
+                                          : ASCON_SESSION_TO_RESPONDER);
+}
+
+void ascon_session_free(ascon_session_state_t *state)
+{
+    if (state) {
+        ascon_acquire(&(state->tx));
+        ascon_free(&(state->tx));
+        ascon_acquire(&(state->rx));
+        ascon_free(&(state->rx));
+        ascon_clean(state, sizeof(ascon_session_state_t));
+    }
+}
+
+/**
+ * \brief Starts a message by absorbing the associated data, or by
+ * ratcheting the state if there is no associated data.
+ *
+ * \param state The state for the direction of the message.
+ * \param ad Points to the associated data.
+ * \param adlen Length of the associated data.
+ *
+ * The rate part of the state is public after the previous message's tag
+ * so it must pass through the permutation before it is used to encrypt.
+ */
+static void ascon_session_start
+    (ascon_state_t *state, const unsigned char *ad, size_t adlen)
+{
+    if (adlen > 0)
+        ascon_aead_absorb_16(state, ad, adlen, 4, 1);
+    else
+        ascon_permute(state, 4);
+    ascon_separator(state);
+}
+
+/**
+ * \brief Finishes a message and squeezes out the authentication tag.
+ *
+ * \param state The state for the direction of the message.
+ * \param partial Number of bytes in the last partial block of payload.
+ * \param tag Points to the buffer to receive the tag.
+ */
+static void ascon_session_finish
+    (ascon_state_t *state, unsigned char partial, unsigned char *tag)
+{
+    ascon_pad(state, partial);
+    ascon_separator(state);
+    ascon_permute(state, 4);
+    ascon_squeeze_16(state, tag, 0);
+}
+
+void ascon_session_encrypt
+    (ascon_session_state_t *state, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen)
+{
+    unsigned char partial;
+    *clen = mlen + ASCON_SESSION_TAG_SIZE;
+    ascon_acquire(&(state->tx));
+    ascon_session_start(&(state->tx), ad, adlen);
+    partial = ascon_aead_encrypt_16(&(state->tx), c, m, mlen, 4, 0);
+    ascon_session_finish(&(state->tx), partial, c + mlen);
+    ascon_release(&(state->tx));
+}
+
+int ascon_session_decrypt
+    (ascon_session_state_t *state, unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen)
+{
+    ascon_state_t backup;
+    unsigned char tag[ASCON_SESSION_TAG_SIZE];
+    unsigned char partial;
+    int result;
+
+    /* Set the length of the returned plaintext */
+    if (clen < ASCON_SESSION_TAG_SIZE)
+        return -1;
+    *mlen = clen - ASCON_SESSION_TAG_SIZE;
+
+    /* Save the receiving state in case the tag is incorrect */
+    ascon_init(&backup);
+    ascon_copy(&backup, &(state->rx));
+    ascon_release(&backup);
+
+    /* Decrypt the message and check the tag */
+    ascon_acquire(&(state->rx));
+    ascon_session_start(&(state->rx), ad, adlen);
+    partial = ascon_aead_decrypt_16(&(state->rx), m, c, *mlen, 4, 0);
+    ascon_session_finish(&(state->rx), partial, tag);
+    result = ascon_aead_check_tag(m, *mlen, tag, c + *mlen, sizeof(tag));
+
+    /* Roll back the receiving state if the message was rejected */
+    if (result < 0)
+        ascon_copy(&(state->rx), &backup);
+    ascon_release(&(state->rx));
+
+    /* Clean up */
+    ascon_clean(tag, sizeof(tag));
+    ascon_acquire(&backup);
+    ascon_free(&backup);
+    return result;
+}
+
+#endif /* ASCON_ENABLE_AEAD */
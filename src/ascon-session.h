@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_SESSION_H
+#define ASCON_SESSION_H
+
+/**
+ * \file ascon-session.h
+ * \brief Bidirectional duplex session for a series of short messages.
+ *
+ * A session encrypts and authenticates a continuous series of messages
+ * between two parties under a single key and session nonce.  Instead of
+ * initializing and finalizing the ASCON state for every message with
+ * 12 rounds each, the state carries on from one message to the next.
+ * Each message ends with a 16-byte authentication tag that is squeezed
+ * after 8 rounds, followed by an 8-round ratchet before the next
+ * message.  When the message has associated data, absorbing it serves
+ * as the ratchet instead.
+ *
+ * For a message of up to 15 bytes, this is 16 rounds of the permutation
+ * compared with 24 rounds for ASCON-128a, or 32 rounds if the message
+ * also has associated data.  The 12-round initialization is paid once
+ * per direction when the session is started.
+ *
+ * Each direction has its own state, so the two parties can send messages
+ * to each other in any interleaving.  Within a direction, every message
+ * depends on all of the messages before it, so messages must be
+ * delivered reliably and in order.  This makes replayed, reordered, or
+ * dropped messages fail to authenticate.  A message that fails to
+ * authenticate is discarded and the receiving state is rolled back so
+ * that the next genuine message can still be accepted.
+ *
+ * The session mode is a keyed duplex built from the same 8-round
+ * permutation calls as the payload blocks of ASCON-128a.  It is not
+ * one of the standardized ASCON modes.
+ *
+ * \code
+ * ascon_session_state_t session;
+ * ascon_session_init(&session, k, npub, 1);
+ * ascon_session_encrypt(&session, c, &clen, m, mlen, 0, 0);
+ * ...
+ * if (ascon_session_decrypt(&session, m, &mlen, c, clen, 0, 0) < 0) {
+ *     // reject the message
+ * }
+ * ...
+ * ascon_session_free(&session);
+ * \endcode
+ */
+
+#include "ascon-aead.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of the key for a duplex session.
+ */
+#define ASCON_SESSION_KEY_SIZE 16
+
+/**
+ * \brief Size of the session nonce for a duplex session.
+ */
+#define ASCON_SESSION_NONCE_SIZE 16
+
+/**
+ * \brief Size of the authentication tag on each message in a session.
+ */
+#define ASCON_SESSION_TAG_SIZE 16
+
+/**
+ * \brief State information for a bidirectional duplex session.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** State for messages that are sent to the other party */
+    ascon_state_t tx;
+
+    /** State for messages that are received from the other party */
+    ascon_state_t rx;
+
+} ascon_session_state_t;
+
+/**
+ * \brief Starts a bidirectional duplex session.
+ *
+ * \param state The session state to initialize.
+ * \param k Points to the 16 bytes of the session key.
+ * \param npub Points to the 16 bytes of the session nonce, which must be
+ * unique for each session under \a k.
+ * \param initiator Non-zero for the party that initiated the session,
+ * or zero for the responding party.  The two parties must choose
+ * opposite roles.
+ *
+ * \sa ascon_session_encrypt(), ascon_session_decrypt(),
+ * ascon_session_free()
+ */
+void ascon_session_init
+    (ascon_session_state_t *state, const unsigned char *k,
+     const unsigned char *npub, int initiator);
+
+/**
+ * \brief Frees a duplex session and destroys any sensitive material.
+ *
+ * \param state The session state to free.
+ */
+void ascon_session_free(ascon_session_state_t *state);
+
+/**
+ * \brief Encrypts and authenticates the next message in a session.
+ *
+ * \param state The session state.
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the message but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * \sa ascon_session_decrypt()
+ */
+void ascon_session_encrypt
+    (ascon_session_state_t *state, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen);
+
+/**
+ * \brief Decrypts and authenticates the next message in a session.
+ *
+ * \param state The session state.
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the message but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * If the authentication tag is incorrect, then the plaintext is zeroed
+ * and the receiving state is restored to what it was before the call.
+ *
+ * \sa ascon_session_encrypt()
+ */
+int ascon_session_decrypt
+    (ascon_session_state_t *state, unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
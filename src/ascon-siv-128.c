@@ -20,11 +20,14 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
 #include "ascon-siv.h"
 #include "utility/ascon-aead-common.h"
 #include "utility/ascon-util-snp.h"
 #include <string.h>
 
+#if ASCON_ENABLE_AEAD
+
 /**
  * \brief Initialization vector for ASCON-128-SIV, authentication phase.
  */
@@ -176,3 +179,180 @@ int ascon128_siv_decrypt
     ascon_free(&state);
     return result;
 }
+
+/**
+ * \brief Encrypts a fragment of data with an ASCON state and an 8-byte rate,
+ * continuing on from a previous fragment.
+ *
+ * \param state The state to encrypt with.
+ * \param dest Points to the destination buffer.
+ * \param src Points to the source buffer.
+ * \param len Length of the data to encrypt from \a src into \a dest.
+ * \param first_round First round of the permutation to apply each block.
+ * \param partial Amount of keystream that was used from the last block.
+ *
+ * \return The amount of keystream that was used from the final block.
+ */
+static unsigned char ascon_siv_encrypt_stream_8
+    (ascon_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t len, uint8_t first_round,
+     unsigned char partial)
+{
+    unsigned char block[8];
+
+    /* Use up the rest of the keystream from the previous block */
+    if (partial != 0) {
+        size_t temp = 8U - partial;
+        if (temp > len)
+            temp = len;
+        ascon_squeeze_partial(state, block, partial, temp);
+        lw_xor_block_2_src(dest, block, src, temp);
+        partial = (unsigned char)((partial + temp) & 7U);
+        dest += temp;
+        src += temp;
+        len -= temp;
+        if (partial != 0)
+            return partial;
+    }
+
+    /* Generate fresh keystream for the remaining data */
+    ascon_siv_encrypt_8(state, dest, src, len, first_round);
+    return (unsigned char)(len & 7U);
+}
+
+/**
+ * \brief Finishes the associated data in an ASCON-128-SIV authentication
+ * pass if it has not been finished already.
+ *
+ * \param state The incremental SIV state, which must be acquired.
+ */
+static void ascon128_siv_auth_finish_ad(ascon128_siv_state_t *state)
+{
+    if (!state->in_payload) {
+        /* Pad and permute the last block of associated data, if any */
+        if (state->has_ad) {
+            ascon_pad(&(state->state), state->posn);
+            ascon_permute(&(state->state), 6);
+        }
+
+        /* Separator between the associated data and the payload */
+        ascon_separator(&(state->state));
+        state->posn = 0;
+        state->in_payload = 1;
+    }
+}
+
+/**
+ * \brief Computes the ASCON-128-SIV authentication tag at the end of
+ * an incremental authentication pass.
+ *
+ * \param state The incremental SIV state, which must be acquired.
+ * \param tag Points to the buffer to receive the tag.
+ */
+static void ascon128_siv_auth_tag
+    (ascon128_siv_state_t *state, unsigned char *tag)
+{
+    ascon128_siv_auth_finish_ad(state);
+    ascon_pad(&(state->state), state->posn);
+    ascon_absorb_16(&(state->state), state->key, 8);
+    ascon_permute(&(state->state), 0);
+    ascon_absorb_16(&(state->state), state->key, 24);
+    ascon_squeeze_16(&(state->state), tag, 24);
+}
+
+void ascon128_siv_auth_start
+    (ascon128_siv_state_t *state, const unsigned char *npub,
+     const unsigned char *k)
+{
+    memcpy(state->key, k, ASCON128_KEY_SIZE);
+    ascon128_siv_init(&(state->state), npub, state->key, ASCON128_IV1);
+    ascon_release(&(state->state));
+    state->posn = 0;
+    state->has_ad = 0;
+    state->in_payload = 0;
+}
+
+void ascon128_siv_auth_ad_update
+    (ascon128_siv_state_t *state, const unsigned char *ad, size_t adlen)
+{
+    if (adlen > 0) {
+        ascon_acquire(&(state->state));
+        state->posn = ascon_aead_absorb_stream_8
+            (&(state->state), ad, adlen, 6, state->posn);
+        ascon_release(&(state->state));
+        state->has_ad = 1;
+    }
+}
+
+void ascon128_siv_auth_update
+    (ascon128_siv_state_t *state, const unsigned char *m, size_t mlen)
+{
+    ascon_acquire(&(state->state));
+    ascon128_siv_auth_finish_ad(state);
+    if (mlen > 0) {
+        state->posn = ascon_aead_absorb_stream_8
+            (&(state->state), m, mlen, 6, state->posn);
+    }
+    ascon_release(&(state->state));
+}
+
+void ascon128_siv_auth_finalize
+    (ascon128_siv_state_t *state, unsigned char *tag)
+{
+    ascon_acquire(&(state->state));
+    ascon128_siv_auth_tag(state, tag);
+    ascon_free(&(state->state));
+    ascon_clean(state, sizeof(ascon128_siv_state_t));
+}
+
+int ascon128_siv_auth_check
+    (ascon128_siv_state_t *state, const unsigned char *tag)
+{
+    unsigned char tag2[ASCON128_TAG_SIZE];
+    int result;
+    ascon_acquire(&(state->state));
+    ascon128_siv_auth_tag(state, tag2);
+    result = ascon_aead_check_tag(0, 0, tag2, tag, ASCON128_TAG_SIZE);
+    ascon_clean(tag2, sizeof(tag2));
+    ascon_free(&(state->state));
+    ascon_clean(state, sizeof(ascon128_siv_state_t));
+    return result;
+}
+
+void ascon128_siv_cipher_start
+    (ascon128_siv_state_t *state, const unsigned char *tag,
+     const unsigned char *k)
+{
+    memcpy(state->key, k, ASCON128_KEY_SIZE);
+    ascon128_siv_init(&(state->state), tag, state->key, ASCON128_IV2);
+    ascon_release(&(state->state));
+    state->posn = 0;
+    state->has_ad = 0;
+    state->in_payload = 1;
+}
+
+void ascon128_siv_cipher_block
+    (ascon128_siv_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len)
+{
+    ascon_acquire(&(state->state));
+    state->posn = ascon_siv_encrypt_stream_8
+        (&(state->state), out, in, len, 6, state->posn);
+    ascon_release(&(state->state));
+}
+
+void ascon128_siv_cipher_finish(ascon128_siv_state_t *state)
+{
+    ascon128_siv_abort(state);
+}
+
+void ascon128_siv_abort(ascon128_siv_state_t *state)
+{
+    if (state) {
+        ascon_acquire(&(state->state));
+        ascon_free(&(state->state));
+        ascon_clean(state, sizeof(ascon128_siv_state_t));
+    }
+}
+
+#endif /* ASCON_ENABLE_AEAD */
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-siv.h"
+#include "utility/ascon-aead-common.h"
+#include "utility/ascon-multi.h"
+#include "utility/ascon-util-snp.h"
+
+#if ASCON_ENABLE_AEAD
+
+/**
+ * \brief Initialization vector for ASCON-128-SIV, authentication phase.
+ */
+static uint8_t const ASCON128_IV1[8] =
+    {0x81, 0x40, 0x0c, 0x06, 0x00, 0x00, 0x00, 0x00};
+
+/**
+ * \brief Initialization vector for ASCON-128-SIV, encryption phase.
+ */
+static uint8_t const ASCON128_IV2[8] =
+    {0x82, 0x40, 0x0c, 0x06, 0x00, 0x00, 0x00, 0x00};
+
+/**
+ * \brief Number of keys to wrap or unwrap in lockstep.
+ */
+#define ASCON_SIV_WRAP_LANES ASCON_MULTI_LANES
+
+void ascon128_siv_init_kek
+    (ascon128_siv_kek_t *kek, const unsigned char *k,
+     const unsigned char *npub)
+{
+    /* The authentication pass always starts with the same KEK and nonce,
+     * so we can run the initialization permutation ahead of time */
+    ascon_init(&(kek->auth));
+    ascon_overwrite_bytes(&(kek->auth), ASCON128_IV1, 0, 8);
+    ascon_overwrite_bytes(&(kek->auth), k, 8, ASCON128_KEY_SIZE);
+    ascon_overwrite_bytes(&(kek->auth), npub, 24, ASCON128_NONCE_SIZE);
+    ascon_permute(&(kek->auth), 0);
+    ascon_absorb_16(&(kek->auth), k, 24);
+    ascon_release(&(kek->auth));
+
+    /* The encryption pass uses the tag as the nonce, so we can only
+     * pre-load the IV and the KEK.  The KEK is also absorbed from here
+     * when the authentication pass is finalized. */
+    ascon_init(&(kek->cipher));
+    ascon_overwrite_bytes(&(kek->cipher), ASCON128_IV2, 0, 8);
+    ascon_overwrite_bytes(&(kek->cipher), k, 8, ASCON128_KEY_SIZE);
+    ascon_release(&(kek->cipher));
+}
+
+void ascon128_siv_free_kek(ascon128_siv_kek_t *kek)
+{
+    if (kek) {
+        ascon_acquire(&(kek->auth));
+        ascon_free(&(kek->auth));
+        ascon_acquire(&(kek->cipher));
+        ascon_free(&(kek->cipher));
+    }
+}
+
+/**
+ * \brief Runs the authentication pass of ASCON-128-SIV over a group of
+ * keys in lockstep.
+ *
+ * \param states Points to the states to use for the lanes.
+ * \param lanes Number of lanes in the group.
+ * \param m Points to the plaintext key for the first lane.
+ * \param mstride Distance between the plaintext keys for each lane.
+ * \param keylen Length of each plaintext key, 16 or 20.
+ * \param tag Points to the buffer for the tag of the first lane.
+ * \param tagstride Distance between the tags for each lane.
+ * \param kek Points to the pre-computed key encryption key.
+ */
+static void ascon128_siv_wrap_auth
+    (ascon_state_t *states, unsigned lanes,
+     const unsigned char *m, size_t mstride, size_t keylen,
+     unsigned char *tag, size_t tagstride, const ascon128_siv_kek_t *kek)
+{
+    ascon_state_t *ptrs[ASCON_SIV_WRAP_LANES];
+    unsigned lane;
+    size_t posn;
+
+    /* Start from the pre-computed state; there is no associated data */
+    for (lane = 0; lane < lanes; ++lane) {
+        ptrs[lane] = &(states[lane]);
+        ascon_copy(&(states[lane]), &(kek->auth));
+        ascon_separator(&(states[lane]));
+    }
+
+    /* Absorb the full blocks of the plaintext key */
+    for (posn = 0; (posn + 8) <= keylen; posn += 8) {
+        for (lane = 0; lane < lanes; ++lane)
+            ascon_absorb_8(&(states[lane]), m + lane * mstride + posn, 0);
+        ascon_permute_multi(ptrs, lanes, 6);
+    }
+
+    /* Absorb and pad the last block, then compute the tag */
+    for (lane = 0; lane < lanes; ++lane) {
+        if (posn < keylen) {
+            ascon_absorb_partial
+                (&(states[lane]), m + lane * mstride + posn, 0,
+                 (unsigned)(keylen - posn));
+        }
+        ascon_pad(&(states[lane]), (unsigned)(keylen - posn));
+        ascon_absorb_state_16(&(states[lane]), &(kek->cipher), 8, 8);
+    }
+    ascon_permute_multi(ptrs, lanes, 0);
+    for (lane = 0; lane < lanes; ++lane) {
+        ascon_absorb_state_16(&(states[lane]), &(kek->cipher), 24, 8);
+        ascon_squeeze_16(&(states[lane]), tag + lane * tagstride, 24);
+    }
+}
+
+/**
+ * \brief Runs the encryption pass of ASCON-128-SIV over a group of
+ * keys in lockstep.
+ *
+ * \param states Points to the states to use for the lanes.
+ * \param lanes Number of lanes in the group.
+ * \param dest Points to the output for the first lane.
+ * \param deststride Distance between the outputs for each lane.
+ * \param src Points to the input for the first lane.
+ * \param srcstride Distance between the inputs for each lane.
+ * \param keylen Length of each key, 16 or 20.
+ * \param tag Points to the tag of the first lane.
+ * \param tagstride Distance between the tags for each lane.
+ * \param kek Points to the pre-computed key encryption key.
+ *
+ * This operates the ASCON permutation in OFB mode, which can be used to
+ * perform both encryption and decryption.
+ */
+static void ascon128_siv_wrap_cipher
+    (ascon_state_t *states, unsigned lanes,
+     unsigned char *dest, size_t deststride,
+     const unsigned char *src, size_t srcstride, size_t keylen,
+     const unsigned char *tag, size_t tagstride,
+     const ascon128_siv_kek_t *kek)
+{
+    ascon_state_t *ptrs[ASCON_SIV_WRAP_LANES];
+    unsigned char block[8];
+    unsigned lane;
+    size_t posn, len;
+
+    /* Initialize the states with the tags as the nonces */
+    for (lane = 0; lane < lanes; ++lane) {
+        ptrs[lane] = &(states[lane]);
+        ascon_copy(&(states[lane]), &(kek->cipher));
+        ascon_overwrite_bytes
+            (&(states[lane]), tag + lane * tagstride, 24, ASCON128_TAG_SIZE);
+    }
+    ascon_permute_multi(ptrs, lanes, 0);
+    for (lane = 0; lane < lanes; ++lane)
+        ascon_absorb_state_16(&(states[lane]), &(kek->cipher), 24, 8);
+
+    /* Generate the keystream and XOR it with the input */
+    for (posn = 0; posn < keylen; posn += 8) {
+        len = keylen - posn;
+        if (len > 8)
+            len = 8;
+        ascon_permute_multi(ptrs, lanes, 6);
+        for (lane = 0; lane < lanes; ++lane) {
+            ascon_squeeze_8(&(states[lane]), block, 0);
+            lw_xor_block_2_src
+                (dest + lane * deststride + posn, block,
+                 src + lane * srcstride + posn, len);
+        }
+    }
+    ascon_clean(block, sizeof(block));
+}
+
+int ascon128_siv_wrap_batch
+    (unsigned char *out, const unsigned char *in, size_t keylen,
+     size_t count, const ascon128_siv_kek_t *kek)
+{
+    ascon_state_t states[ASCON_SIV_WRAP_LANES];
+    size_t outlen = keylen + ASCON128_TAG_SIZE;
+    unsigned lanes, lane;
+
+    if (keylen != ASCON128_SIV_WRAP_KEY_SIZE &&
+            keylen != ASCON128_SIV_WRAP_LONG_KEY_SIZE)
+        return -1;
+    for (lane = 0; lane < ASCON_SIV_WRAP_LANES; ++lane)
+        ascon_init(&(states[lane]));
+    while (count > 0) {
+        lanes = (count < ASCON_SIV_WRAP_LANES) ? (unsigned)count
+                                               : ASCON_SIV_WRAP_LANES;
+        ascon128_siv_wrap_auth
+            (states, lanes, in, keylen, keylen, out + keylen, outlen, kek);
+        ascon128_siv_wrap_cipher
+            (states, lanes, out, outlen, in, keylen, keylen,
+             out + keylen, outlen, kek);
+        in += lanes * keylen;
+        out += lanes * outlen;
+        count -= lanes;
+    }
+    for (lane = 0; lane < ASCON_SIV_WRAP_LANES; ++lane)
+        ascon_free(&(states[lane]));
+    return 0;
+}
+
+int ascon128_siv_unwrap_batch
+    (unsigned char *out, const unsigned char *in, size_t keylen,
+     size_t count, const ascon128_siv_kek_t *kek, int *results)
+{
+    ascon_state_t states[ASCON_SIV_WRAP_LANES];
+    unsigned char tags[ASCON_SIV_WRAP_LANES][ASCON128_TAG_SIZE];
+    size_t inlen = keylen + ASCON128_TAG_SIZE;
+    unsigned lanes, lane;
+    int result = 0;
+    int check;
+
+    if (keylen != ASCON128_SIV_WRAP_KEY_SIZE &&
+            keylen != ASCON128_SIV_WRAP_LONG_KEY_SIZE)
+        return -2;
+    for (lane = 0; lane < ASCON_SIV_WRAP_LANES; ++lane)
+        ascon_init(&(states[lane]));
+    while (count > 0) {
+        lanes = (count < ASCON_SIV_WRAP_LANES) ? (unsigned)count
+                                               : ASCON_SIV_WRAP_LANES;
+        ascon128_siv_wrap_cipher
+            (states, lanes, out, keylen, in, inlen, keylen,
+             in + keylen, inlen, kek);
+        ascon128_siv_wrap_auth
+            (states, lanes, out, keylen, keylen, tags[0],
+             ASCON128_TAG_SIZE, kek);
+        for (lane = 0; lane < lanes; ++lane) {
+            check = ascon_aead_check_tag
+                (out + lane * keylen, keylen, tags[lane],
+                 in + lane * inlen + keylen, ASCON128_TAG_SIZE);
+            if (results)
+                *results++ = check;
+            result |= check;
+        }
+        in += lanes * inlen;
+        out += lanes * keylen;
+        count -= lanes;
+    }
+    for (lane = 0; lane < ASCON_SIV_WRAP_LANES; ++lane)
+        ascon_free(&(states[lane]));
+    ascon_clean(tags, sizeof(tags));
+    return result;
+}
+
+#endif /* ASCON_ENABLE_AEAD */
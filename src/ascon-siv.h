@@ -23,7 +23,7 @@
 #ifndef ASCON_SIV_H
 #define ASCON_SIV_H
 
-#include <stddef.h>
+#include "ascon-aead.h"
 
 /**
  * \file ascon-siv.h
@@ -212,6 +212,759 @@ int ascon80pq_siv_decrypt
      const unsigned char *npub,
      const unsigned char *k);
 
+/* ---------------------------------------------------------------- */
+/*           Incremental two-pass API's for the SIV modes           */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief State information for the incremental version of ASCON-128-SIV.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** ASCON permutation state */
+    ascon_state_t state;
+
+    /** Key to use to authenticate the payload during finalization */
+    unsigned char key[ASCON128_KEY_SIZE];
+
+    /** Position within the current block for partial blocks */
+    unsigned char posn;
+
+    /** Non-zero if associated data has been absorbed incrementally */
+    unsigned char has_ad;
+
+    /** Non-zero once the authentication pass has moved on to the payload */
+    unsigned char in_payload;
+
+} ascon128_siv_state_t;
+
+/**
+ * \brief Starts the authentication pass of ASCON-128-SIV in
+ * incremental mode.
+ *
+ * \param state State to initialize for ASCON-128-SIV operations.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use.
+ *
+ * SIV mode needs two passes over the plaintext: one pass to compute the
+ * authentication tag and a second pass to encrypt.  The incremental
+ * API allows both passes to be streamed from storage with a small
+ * fixed-size buffer rather than holding the entire plaintext in RAM.
+ *
+ * The following sequence can be used to encrypt a list of i plaintext
+ * message blocks (m) to produce i ciphertext message blocks (c)
+ * and an authentication tag (t):
+ *
+ * \code
+ * ascon128_siv_state_t state;
+ * ascon128_siv_auth_start(&state, npub, k);
+ * ascon128_siv_auth_ad_update(&state, ad, adlen);
+ * ascon128_siv_auth_update(&state, m1, m1_len);
+ * ...;
+ * ascon128_siv_auth_update(&state, mi, mi_len);
+ * ascon128_siv_auth_finalize(&state, t);
+ * ascon128_siv_cipher_start(&state, t, k);
+ * ascon128_siv_cipher_block(&state, m1, c1, m1_len);
+ * ...;
+ * ascon128_siv_cipher_block(&state, mi, ci, mi_len);
+ * ascon128_siv_cipher_finish(&state);
+ * \endcode
+ *
+ * Decryption performs the passes in the opposite order:
+ *
+ * \code
+ * ascon128_siv_state_t state;
+ * ascon128_siv_cipher_start(&state, t, k);
+ * ascon128_siv_cipher_block(&state, c1, m1, c1_len);
+ * ...;
+ * ascon128_siv_cipher_block(&state, ci, mi, ci_len);
+ * ascon128_siv_cipher_finish(&state);
+ * ascon128_siv_auth_start(&state, npub, k);
+ * ascon128_siv_auth_ad_update(&state, ad, adlen);
+ * ascon128_siv_auth_update(&state, m1, m1_len);
+ * ...;
+ * ascon128_siv_auth_update(&state, mi, mi_len);
+ * if (ascon128_siv_auth_check(&state, t) < 0)
+ *     ...; // decryption has failed!
+ * \endcode
+ *
+ * The plaintext from the decryption pass has not been authenticated yet.
+ * It should be written to scratch storage and must not be used until
+ * ascon128_siv_auth_check() succeeds.  This is unlike the one-shot
+ * ascon128_siv_decrypt() function which zeroes the plaintext on failure.
+ *
+ * The results are identical to ascon128_siv_encrypt() and
+ * ascon128_siv_decrypt() no matter how the data is split into chunks.
+ *
+ * \sa ascon128_siv_auth_ad_update(), ascon128_siv_auth_update(),
+ * ascon128_siv_auth_finalize(), ascon128_siv_auth_check(),
+ * ascon128_siv_cipher_start()
+ */
+void ascon128_siv_auth_start
+    (ascon128_siv_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an ASCON-128-SIV
+ * authentication pass.
+ *
+ * \param state State to use for ASCON-128-SIV operations.
+ * \param ad Buffer that contains the next chunk of associated data.
+ * \param adlen Length of the associated data chunk in bytes.
+ *
+ * All of the associated data must be supplied before the first call
+ * to ascon128_siv_auth_update().
+ *
+ * \sa ascon128_siv_auth_start(), ascon128_siv_auth_update()
+ */
+void ascon128_siv_auth_ad_update
+    (ascon128_siv_state_t *state, const unsigned char *ad, size_t adlen);
+
+/**
+ * \brief Absorbs more plaintext into an ASCON-128-SIV authentication pass.
+ *
+ * \param state State to use for ASCON-128-SIV operations.
+ * \param m Buffer that contains the next chunk of plaintext.
+ * \param mlen Length of the plaintext chunk in bytes.
+ *
+ * \sa ascon128_siv_auth_start(), ascon128_siv_auth_finalize(),
+ * ascon128_siv_auth_check()
+ */
+void ascon128_siv_auth_update
+    (ascon128_siv_state_t *state, const unsigned char *m, size_t mlen);
+
+/**
+ * \brief Finalizes an ASCON-128-SIV authentication pass and generates
+ * the authentication tag.
+ *
+ * \param state State to use for ASCON-128-SIV operations.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon128_siv_auth_update(), ascon128_siv_cipher_start()
+ */
+void ascon128_siv_auth_finalize
+    (ascon128_siv_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an ASCON-128-SIV authentication pass and checks
+ * the authentication tag.
+ *
+ * \param state State to use for ASCON-128-SIV operations.
+ * \param tag Points to the buffer containing the ciphertext's
+ * authentication tag.  Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon128_siv_auth_update(), ascon128_siv_auth_start()
+ */
+int ascon128_siv_auth_check
+    (ascon128_siv_state_t *state, const unsigned char *tag);
+
+/**
+ * \brief Starts the encryption or decryption pass of ASCON-128-SIV in
+ * incremental mode.
+ *
+ * \param state State to initialize for ASCON-128-SIV operations.
+ * \param tag Points to the 16 bytes of the authentication tag which
+ * acts as the synthetic nonce for the pass.
+ * \param k Points to the 16 bytes of the key to use.
+ *
+ * \sa ascon128_siv_cipher_block(), ascon128_siv_cipher_finish(),
+ * ascon128_siv_auth_start()
+ */
+void ascon128_siv_cipher_start
+    (ascon128_siv_state_t *state, const unsigned char *tag,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts or decrypts a block of data with ASCON-128-SIV in
+ * incremental mode.
+ *
+ * \param state State to use for ASCON-128-SIV operations.
+ * \param in Buffer that contains the input data.
+ * \param out Buffer to receive the output data.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the input and output data in bytes.
+ *
+ * Encryption and decryption are the same operation in SIV mode.
+ *
+ * \sa ascon128_siv_cipher_start(), ascon128_siv_cipher_finish()
+ */
+void ascon128_siv_cipher_block
+    (ascon128_siv_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finishes the encryption or decryption pass of ASCON-128-SIV.
+ *
+ * \param state State to finish.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon128_siv_cipher_start(), ascon128_siv_cipher_block()
+ */
+void ascon128_siv_cipher_finish(ascon128_siv_state_t *state);
+
+/**
+ * \brief Aborts use of ASCON-128-SIV in incremental mode.
+ *
+ * \param state State to abort.
+ *
+ * This function may be used any time after ascon128_siv_auth_start()
+ * or ascon128_siv_cipher_start() to abort the pass entirely and free
+ * the \a state.
+ */
+void ascon128_siv_abort(ascon128_siv_state_t *state);
+
+/**
+ * \brief State information for the incremental version of ASCON-128a-SIV.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** ASCON permutation state */
+    ascon_state_t state;
+
+    /** Key to use to authenticate the payload during finalization */
+    unsigned char key[ASCON128_KEY_SIZE];
+
+    /** Position within the current block for partial blocks */
+    unsigned char posn;
+
+    /** Non-zero if associated data has been absorbed incrementally */
+    unsigned char has_ad;
+
+    /** Non-zero once the authentication pass has moved on to the payload */
+    unsigned char in_payload;
+
+} ascon128a_siv_state_t;
+
+/**
+ * \brief Starts the authentication pass of ASCON-128a-SIV in
+ * incremental mode.
+ *
+ * \param state State to initialize for ASCON-128a-SIV operations.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use.
+ *
+ * SIV mode needs two passes over the plaintext: one pass to compute the
+ * authentication tag and a second pass to encrypt.  The incremental
+ * API allows both passes to be streamed from storage with a small
+ * fixed-size buffer rather than holding the entire plaintext in RAM.
+ *
+ * The following sequence can be used to encrypt a list of i plaintext
+ * message blocks (m) to produce i ciphertext message blocks (c)
+ * and an authentication tag (t):
+ *
+ * \code
+ * ascon128a_siv_state_t state;
+ * ascon128a_siv_auth_start(&state, npub, k);
+ * ascon128a_siv_auth_ad_update(&state, ad, adlen);
+ * ascon128a_siv_auth_update(&state, m1, m1_len);
+ * ...;
+ * ascon128a_siv_auth_update(&state, mi, mi_len);
+ * ascon128a_siv_auth_finalize(&state, t);
+ * ascon128a_siv_cipher_start(&state, t, k);
+ * ascon128a_siv_cipher_block(&state, m1, c1, m1_len);
+ * ...;
+ * ascon128a_siv_cipher_block(&state, mi, ci, mi_len);
+ * ascon128a_siv_cipher_finish(&state);
+ * \endcode
+ *
+ * Decryption performs the passes in the opposite order:
+ *
+ * \code
+ * ascon128a_siv_state_t state;
+ * ascon128a_siv_cipher_start(&state, t, k);
+ * ascon128a_siv_cipher_block(&state, c1, m1, c1_len);
+ * ...;
+ * ascon128a_siv_cipher_block(&state, ci, mi, ci_len);
+ * ascon128a_siv_cipher_finish(&state);
+ * ascon128a_siv_auth_start(&state, npub, k);
+ * ascon128a_siv_auth_ad_update(&state, ad, adlen);
+ * ascon128a_siv_auth_update(&state, m1, m1_len);
+ * ...;
+ * ascon128a_siv_auth_update(&state, mi, mi_len);
+ * if (ascon128a_siv_auth_check(&state, t) < 0)
+ *     ...; // decryption has failed!
+ * \endcode
+ *
+ * The plaintext from the decryption pass has not been authenticated yet.
+ * It should be written to scratch storage and must not be used until
+ * ascon128a_siv_auth_check() succeeds.  This is unlike the one-shot
+ * ascon128a_siv_decrypt() function which zeroes the plaintext on failure.
+ *
+ * The results are identical to ascon128a_siv_encrypt() and
+ * ascon128a_siv_decrypt() no matter how the data is split into chunks.
+ *
+ * \sa ascon128a_siv_auth_ad_update(), ascon128a_siv_auth_update(),
+ * ascon128a_siv_auth_finalize(), ascon128a_siv_auth_check(),
+ * ascon128a_siv_cipher_start()
+ */
+void ascon128a_siv_auth_start
+    (ascon128a_siv_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an ASCON-128a-SIV
+ * authentication pass.
+ *
+ * \param state State to use for ASCON-128a-SIV operations.
+ * \param ad Buffer that contains the next chunk of associated data.
+ * \param adlen Length of the associated data chunk in bytes.
+ *
+ * All of the associated data must be supplied before the first call
+ * to ascon128a_siv_auth_update().
+ *
+ * \sa ascon128a_siv_auth_start(), ascon128a_siv_auth_update()
+ */
+void ascon128a_siv_auth_ad_update
+    (ascon128a_siv_state_t *state, const unsigned char *ad, size_t adlen);
+
+/**
+ * \brief Absorbs more plaintext into an ASCON-128a-SIV authentication pass.
+ *
+ * \param state State to use for ASCON-128a-SIV operations.
+ * \param m Buffer that contains the next chunk of plaintext.
+ * \param mlen Length of the plaintext chunk in bytes.
+ *
+ * \sa ascon128a_siv_auth_start(), ascon128a_siv_auth_finalize(),
+ * ascon128a_siv_auth_check()
+ */
+void ascon128a_siv_auth_update
+    (ascon128a_siv_state_t *state, const unsigned char *m, size_t mlen);
+
+/**
+ * \brief Finalizes an ASCON-128a-SIV authentication pass and generates
+ * the authentication tag.
+ *
+ * \param state State to use for ASCON-128a-SIV operations.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon128a_siv_auth_update(), ascon128a_siv_cipher_start()
+ */
+void ascon128a_siv_auth_finalize
+    (ascon128a_siv_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an ASCON-128a-SIV authentication pass and checks
+ * the authentication tag.
+ *
+ * \param state State to use for ASCON-128a-SIV operations.
+ * \param tag Points to the buffer containing the ciphertext's
+ * authentication tag.  Must be at least ASCON128_TAG_SIZE bytes in length.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon128a_siv_auth_update(), ascon128a_siv_auth_start()
+ */
+int ascon128a_siv_auth_check
+    (ascon128a_siv_state_t *state, const unsigned char *tag);
+
+/**
+ * \brief Starts the encryption or decryption pass of ASCON-128a-SIV in
+ * incremental mode.
+ *
+ * \param state State to initialize for ASCON-128a-SIV operations.
+ * \param tag Points to the 16 bytes of the authentication tag which
+ * acts as the synthetic nonce for the pass.
+ * \param k Points to the 16 bytes of the key to use.
+ *
+ * \sa ascon128a_siv_cipher_block(), ascon128a_siv_cipher_finish(),
+ * ascon128a_siv_auth_start()
+ */
+void ascon128a_siv_cipher_start
+    (ascon128a_siv_state_t *state, const unsigned char *tag,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts or decrypts a block of data with ASCON-128a-SIV in
+ * incremental mode.
+ *
+ * \param state State to use for ASCON-128a-SIV operations.
+ * \param in Buffer that contains the input data.
+ * \param out Buffer to receive the output data.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the input and output data in bytes.
+ *
+ * Encryption and decryption are the same operation in SIV mode.
+ *
+ * \sa ascon128a_siv_cipher_start(), ascon128a_siv_cipher_finish()
+ */
+void ascon128a_siv_cipher_block
+    (ascon128a_siv_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finishes the encryption or decryption pass of ASCON-128a-SIV.
+ *
+ * \param state State to finish.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon128a_siv_cipher_start(), ascon128a_siv_cipher_block()
+ */
+void ascon128a_siv_cipher_finish(ascon128a_siv_state_t *state);
+
+/**
+ * \brief Aborts use of ASCON-128a-SIV in incremental mode.
+ *
+ * \param state State to abort.
+ *
+ * This function may be used any time after ascon128a_siv_auth_start()
+ * or ascon128a_siv_cipher_start() to abort the pass entirely and free
+ * the \a state.
+ */
+void ascon128a_siv_abort(ascon128a_siv_state_t *state);
+
+/**
+ * \brief State information for the incremental version of ASCON-80pq-SIV.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** ASCON permutation state */
+    ascon_state_t state;
+
+    /** Key to use to authenticate the payload during finalization */
+    unsigned char key[ASCON80PQ_KEY_SIZE];
+
+    /** Position within the current block for partial blocks */
+    unsigned char posn;
+
+    /** Non-zero if associated data has been absorbed incrementally */
+    unsigned char has_ad;
+
+    /** Non-zero once the authentication pass has moved on to the payload */
+    unsigned char in_payload;
+
+} ascon80pq_siv_state_t;
+
+/**
+ * \brief Starts the authentication pass of ASCON-80pq-SIV in
+ * incremental mode.
+ *
+ * \param state State to initialize for ASCON-80pq-SIV operations.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 20 bytes of the key to use.
+ *
+ * SIV mode needs two passes over the plaintext: one pass to compute the
+ * authentication tag and a second pass to encrypt.  The incremental
+ * API allows both passes to be streamed from storage with a small
+ * fixed-size buffer rather than holding the entire plaintext in RAM.
+ *
+ * The following sequence can be used to encrypt a list of i plaintext
+ * message blocks (m) to produce i ciphertext message blocks (c)
+ * and an authentication tag (t):
+ *
+ * \code
+ * ascon80pq_siv_state_t state;
+ * ascon80pq_siv_auth_start(&state, npub, k);
+ * ascon80pq_siv_auth_ad_update(&state, ad, adlen);
+ * ascon80pq_siv_auth_update(&state, m1, m1_len);
+ * ...;
+ * ascon80pq_siv_auth_update(&state, mi, mi_len);
+ * ascon80pq_siv_auth_finalize(&state, t);
+ * ascon80pq_siv_cipher_start(&state, t, k);
+ * ascon80pq_siv_cipher_block(&state, m1, c1, m1_len);
+ * ...;
+ * ascon80pq_siv_cipher_block(&state, mi, ci, mi_len);
+ * ascon80pq_siv_cipher_finish(&state);
+ * \endcode
+ *
+ * Decryption performs the passes in the opposite order:
+ *
+ * \code
+ * ascon80pq_siv_state_t state;
+ * ascon80pq_siv_cipher_start(&state, t, k);
+ * ascon80pq_siv_cipher_block(&state, c1, m1, c1_len);
+ * ...;
+ * ascon80pq_siv_cipher_block(&state, ci, mi, ci_len);
+ * ascon80pq_siv_cipher_finish(&state);
+ * ascon80pq_siv_auth_start(&state, npub, k);
+ * ascon80pq_siv_auth_ad_update(&state, ad, adlen);
+ * ascon80pq_siv_auth_update(&state, m1, m1_len);
+ * ...;
+ * ascon80pq_siv_auth_update(&state, mi, mi_len);
+ * if (ascon80pq_siv_auth_check(&state, t) < 0)
+ *     ...; // decryption has failed!
+ * \endcode
+ *
+ * The plaintext from the decryption pass has not been authenticated yet.
+ * It should be written to scratch storage and must not be used until
+ * ascon80pq_siv_auth_check() succeeds.  This is unlike the one-shot
+ * ascon80pq_siv_decrypt() function which zeroes the plaintext on failure.
+ *
+ * The results are identical to ascon80pq_siv_encrypt() and
+ * ascon80pq_siv_decrypt() no matter how the data is split into chunks.
+ *
+ * \sa ascon80pq_siv_auth_ad_update(), ascon80pq_siv_auth_update(),
+ * ascon80pq_siv_auth_finalize(), ascon80pq_siv_auth_check(),
+ * ascon80pq_siv_cipher_start()
+ */
+void ascon80pq_siv_auth_start
+    (ascon80pq_siv_state_t *state, const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Absorbs more associated data into an ASCON-80pq-SIV
+ * authentication pass.
+ *
+ * \param state State to use for ASCON-80pq-SIV operations.
+ * \param ad Buffer that contains the next chunk of associated data.
+ * \param adlen Length of the associated data chunk in bytes.
+ *
+ * All of the associated data must be supplied before the first call
+ * to ascon80pq_siv_auth_update().
+ *
+ * \sa ascon80pq_siv_auth_start(), ascon80pq_siv_auth_update()
+ */
+void ascon80pq_siv_auth_ad_update
+    (ascon80pq_siv_state_t *state, const unsigned char *ad, size_t adlen);
+
+/**
+ * \brief Absorbs more plaintext into an ASCON-80pq-SIV authentication pass.
+ *
+ * \param state State to use for ASCON-80pq-SIV operations.
+ * \param m Buffer that contains the next chunk of plaintext.
+ * \param mlen Length of the plaintext chunk in bytes.
+ *
+ * \sa ascon80pq_siv_auth_start(), ascon80pq_siv_auth_finalize(),
+ * ascon80pq_siv_auth_check()
+ */
+void ascon80pq_siv_auth_update
+    (ascon80pq_siv_state_t *state, const unsigned char *m, size_t mlen);
+
+/**
+ * \brief Finalizes an ASCON-80pq-SIV authentication pass and generates
+ * the authentication tag.
+ *
+ * \param state State to use for ASCON-80pq-SIV operations.
+ * \param tag Points to the buffer to receive the authentication tag.
+ * Must be at least ASCON80PQ_TAG_SIZE bytes in length.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon80pq_siv_auth_update(), ascon80pq_siv_cipher_start()
+ */
+void ascon80pq_siv_auth_finalize
+    (ascon80pq_siv_state_t *state, unsigned char *tag);
+
+/**
+ * \brief Finalizes an ASCON-80pq-SIV authentication pass and checks
+ * the authentication tag.
+ *
+ * \param state State to use for ASCON-80pq-SIV operations.
+ * \param tag Points to the buffer containing the ciphertext's
+ * authentication tag.  Must be at least ASCON80PQ_TAG_SIZE bytes in length.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon80pq_siv_auth_update(), ascon80pq_siv_auth_start()
+ */
+int ascon80pq_siv_auth_check
+    (ascon80pq_siv_state_t *state, const unsigned char *tag);
+
+/**
+ * \brief Starts the encryption or decryption pass of ASCON-80pq-SIV in
+ * incremental mode.
+ *
+ * \param state State to initialize for ASCON-80pq-SIV operations.
+ * \param tag Points to the 16 bytes of the authentication tag which
+ * acts as the synthetic nonce for the pass.
+ * \param k Points to the 20 bytes of the key to use.
+ *
+ * \sa ascon80pq_siv_cipher_block(), ascon80pq_siv_cipher_finish(),
+ * ascon80pq_siv_auth_start()
+ */
+void ascon80pq_siv_cipher_start
+    (ascon80pq_siv_state_t *state, const unsigned char *tag,
+     const unsigned char *k);
+
+/**
+ * \brief Encrypts or decrypts a block of data with ASCON-80pq-SIV in
+ * incremental mode.
+ *
+ * \param state State to use for ASCON-80pq-SIV operations.
+ * \param in Buffer that contains the input data.
+ * \param out Buffer to receive the output data.  Can be the
+ * same buffer as \a in.
+ * \param len Length of the input and output data in bytes.
+ *
+ * Encryption and decryption are the same operation in SIV mode.
+ *
+ * \sa ascon80pq_siv_cipher_start(), ascon80pq_siv_cipher_finish()
+ */
+void ascon80pq_siv_cipher_block
+    (ascon80pq_siv_state_t *state, const unsigned char *in,
+     unsigned char *out, size_t len);
+
+/**
+ * \brief Finishes the encryption or decryption pass of ASCON-80pq-SIV.
+ *
+ * \param state State to finish.
+ *
+ * The contents of \a state will be freed by this function, destroying
+ * any sensitive material that may be present.
+ *
+ * \sa ascon80pq_siv_cipher_start(), ascon80pq_siv_cipher_block()
+ */
+void ascon80pq_siv_cipher_finish(ascon80pq_siv_state_t *state);
+
+/**
+ * \brief Aborts use of ASCON-80pq-SIV in incremental mode.
+ *
+ * \param state State to abort.
+ *
+ * This function may be used any time after ascon80pq_siv_auth_start()
+ * or ascon80pq_siv_cipher_start() to abort the pass entirely and free
+ * the \a state.
+ */
+void ascon80pq_siv_abort(ascon80pq_siv_state_t *state);
+
+/* ---------------------------------------------------------------- */
+/*                Key wrapping with ASCON-128-SIV                   */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Size of the keys that can be wrapped with ascon128_siv_wrap_batch()
+ * for 128-bit keys.
+ */
+#define ASCON128_SIV_WRAP_KEY_SIZE 16
+
+/**
+ * \brief Size of the keys that can be wrapped with ascon128_siv_wrap_batch()
+ * for 160-bit keys.
+ */
+#define ASCON128_SIV_WRAP_LONG_KEY_SIZE 20
+
+/**
+ * \brief Pre-computed key encryption key (KEK) for wrapping keys with
+ * ASCON-128-SIV.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    /** State for the authentication pass after the KEK and nonce
+     *  have been absorbed */
+    ascon_state_t auth;
+
+    /** State for the encryption pass with the IV and KEK pre-loaded */
+    ascon_state_t cipher;
+
+} ascon128_siv_kek_t;
+
+/**
+ * \brief Initializes a pre-computed key encryption key for ASCON-128-SIV.
+ *
+ * \param kek Points to the object to receive the pre-computed KEK.
+ * \param k Points to the 16 bytes of the key encryption key.
+ * \param npub Points to the 16 bytes of the nonce to use for every key
+ * that is wrapped with \a kek.
+ *
+ * Because SIV mode is resistant to nonce reuse, it is safe to use the
+ * same nonce for every key.  An all-zero nonce is fine.  A different
+ * nonce can be used to separate domains; e.g. one nonce per key type.
+ *
+ * \sa ascon128_siv_free_kek(), ascon128_siv_wrap_batch()
+ */
+void ascon128_siv_init_kek
+    (ascon128_siv_kek_t *kek, const unsigned char *k,
+     const unsigned char *npub);
+
+/**
+ * \brief Frees a pre-computed key encryption key for ASCON-128-SIV and
+ * destroys any sensitive material.
+ *
+ * \param kek Points to the pre-computed KEK.
+ *
+ * \sa ascon128_siv_init_kek()
+ */
+void ascon128_siv_free_kek(ascon128_siv_kek_t *kek);
+
+/**
+ * \brief Wraps a batch of keys with ASCON-128-SIV.
+ *
+ * \param out Buffer to receive the wrapped keys, which must be at least
+ * \a count * (\a keylen + 16) bytes in length.
+ * \param in Points to the \a count keys to be wrapped, one after
+ * the other.
+ * \param keylen Length of each key; ASCON128_SIV_WRAP_KEY_SIZE or
+ * ASCON128_SIV_WRAP_LONG_KEY_SIZE.
+ * \param count Number of keys to wrap.
+ * \param kek Points to the pre-computed key encryption key.
+ *
+ * \return 0 if the keys were wrapped, or -1 if \a keylen is not supported.
+ *
+ * Each wrapped key is the same as the output of ascon128_siv_encrypt()
+ * for the key with no associated data and the nonce and key encryption
+ * key from \a kek.  The keys are wrapped in lockstep groups.  On back ends
+ * that can permute several states at once, each group is run through the
+ * multi-state permutations.
+ *
+ * \sa ascon128_siv_unwrap_batch(), ascon128_siv_init_kek()
+ */
+int ascon128_siv_wrap_batch
+    (unsigned char *out, const unsigned char *in, size_t keylen,
+     size_t count, const ascon128_siv_kek_t *kek);
+
+/**
+ * \brief Unwraps a batch of keys with ASCON-128-SIV.
+ *
+ * \param out Buffer to receive the unwrapped keys, which must be at least
+ * \a count * \a keylen bytes in length.
+ * \param in Points to the \a count wrapped keys, one after the other,
+ * each of which is \a keylen + 16 bytes in length.
+ * \param keylen Length of each unwrapped key; ASCON128_SIV_WRAP_KEY_SIZE
+ * or ASCON128_SIV_WRAP_LONG_KEY_SIZE.
+ * \param count Number of keys to unwrap.
+ * \param kek Points to the pre-computed key encryption key.
+ * \param results Points to an array of \a count entries to receive 0 or
+ * -1 for each key to indicate if its authentication tag was correct.
+ * May be NULL if the per-key results are not required.
+ *
+ * \return 0 if all keys were unwrapped, -1 if at least one of the
+ * authentication tags was incorrect, or -2 if \a keylen is not supported.
+ *
+ * The unwrapped form of a key with an incorrect tag is set to all-zeroes.
+ *
+ * \sa ascon128_siv_wrap_batch(), ascon128_siv_init_kek()
+ */
+int ascon128_siv_unwrap_batch
+    (unsigned char *out, const unsigned char *in, size_t keylen,
+     size_t count, const ascon128_siv_kek_t *kek, int *results);
+
 #ifdef __cplusplus
 }
 #endif
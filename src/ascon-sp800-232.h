@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#ifndef ASCON_SP800_232_H
+#define ASCON_SP800_232_H
+
+/**
+ * \file ascon-sp800-232.h
+ * \brief ASCON modes from the NIST SP 800-232 standard: Ascon-AEAD128,
+ * Ascon-Hash256, Ascon-XOF128, and Ascon-CXOF128.
+ *
+ * The standardized modes differ from the ASCON-128, ASCON-HASH, and
+ * ASCON-XOF modes elsewhere in this library.  They use new initialization
+ * vectors and padding, and they load data into the state in little-endian
+ * byte order.  Ascon-AEAD128 otherwise has the same shape as ASCON-128a.
+ * The outputs are not compatible with the earlier modes.
+ *
+ * The initial states for Ascon-Hash256 and Ascon-XOF128 are pre-computed
+ * for each back end, as are the initial states for Ascon-CXOF128 with
+ * no customization string.  Other customization strings can be absorbed
+ * once with ascon_cxof128_init_custom() and then reused for many messages.
+ *
+ * References: https://csrc.nist.gov/pubs/sp/800/232/final
+ */
+
+#include "ascon-permutation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of the key for Ascon-AEAD128.
+ */
+#define ASCON_AEAD128_KEY_SIZE 16
+
+/**
+ * \brief Size of the nonce for Ascon-AEAD128.
+ */
+#define ASCON_AEAD128_NONCE_SIZE 16
+
+/**
+ * \brief Size of the authentication tag for Ascon-AEAD128.
+ */
+#define ASCON_AEAD128_TAG_SIZE 16
+
+/**
+ * \brief Rate of absorbing and squeezing data for Ascon-AEAD128.
+ */
+#define ASCON_AEAD128_RATE 16
+
+/**
+ * \brief Size of the hash output for Ascon-Hash256.
+ */
+#define ASCON_HASH256_SIZE 32
+
+/**
+ * \brief Rate of absorbing and squeezing data for Ascon-Hash256,
+ * Ascon-XOF128, and Ascon-CXOF128.
+ */
+#define ASCON_XOF128_RATE 8
+
+/**
+ * \brief Maximum size of the customization string for Ascon-CXOF128.
+ */
+#define ASCON_CXOF128_MAX_CUSTOM_SIZE 256
+
+/**
+ * \brief State information for Ascon-XOF128 and Ascon-CXOF128
+ * incremental mode.
+ */
+typedef struct
+{
+    ascon_state_t state;    /**< Current hash state */
+    unsigned char count;    /**< Number of bytes in the current block */
+    unsigned char mode;     /**< Hash mode: 0 for absorb, 1 for squeeze */
+
+} ascon_xof128_state_t;
+
+/**
+ * \brief State information for Ascon-Hash256 incremental mode.
+ */
+typedef struct
+{
+    ascon_xof128_state_t xof;   /**< Internal Ascon-XOF128 style state */
+
+} ascon_hash256_state_t;
+
+/**
+ * \brief Pre-computed customization string for Ascon-CXOF128.
+ *
+ * This structure should be treated as opaque by the application.
+ */
+typedef struct
+{
+    ascon_state_t state;    /**< State after the customization string */
+
+} ascon_cxof128_custom_t;
+
+/**
+ * \brief Encrypts and authenticates a packet with Ascon-AEAD128.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output which includes
+ * the ciphertext and the 16 byte authentication tag.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to encrypt the packet.
+ *
+ * \sa ascon_aead128_decrypt()
+ */
+void ascon_aead128_encrypt
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Decrypts and authenticates a packet with Ascon-AEAD128.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication
+ * tag to decrypt.
+ * \param clen Length of the input data in bytes, which includes the
+ * ciphertext and the 16 byte authentication tag.
+ * \param ad Buffer that contains associated data to authenticate
+ * along with the packet but which does not need to be encrypted.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet which must
+ * be 16 bytes in length.
+ * \param k Points to the 16 bytes of the key to use to decrypt the packet.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect,
+ * or some other negative number if there was an error in the parameters.
+ *
+ * \sa ascon_aead128_encrypt()
+ */
+int ascon_aead128_decrypt
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k);
+
+/**
+ * \brief Hashes a block of input data with Ascon-Hash256.
+ *
+ * \param out Buffer to receive the hash output which must be at least
+ * ASCON_HASH256_SIZE bytes in length.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ *
+ * \sa ascon_hash256_init(), ascon_hash256_update(), ascon_hash256_finalize()
+ */
+void ascon_hash256(unsigned char *out, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Initializes the state for an Ascon-Hash256 hashing operation.
+ *
+ * \param state Hash state to be initialized.
+ *
+ * \sa ascon_hash256_update(), ascon_hash256_finalize(), ascon_hash256()
+ */
+void ascon_hash256_init(ascon_hash256_state_t *state);
+
+/**
+ * \brief Frees the Ascon-Hash256 state and destroys any sensitive material.
+ *
+ * \param state Hash state to be freed.
+ */
+void ascon_hash256_free(ascon_hash256_state_t *state);
+
+/**
+ * \brief Updates an Ascon-Hash256 state with more input data.
+ *
+ * \param state Hash state to be updated.
+ * \param in Points to the input data to be incorporated into the state.
+ * \param inlen Length of the input data to be incorporated into the state.
+ *
+ * \sa ascon_hash256_init(), ascon_hash256_finalize()
+ */
+void ascon_hash256_update
+    (ascon_hash256_state_t *state, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Returns the final hash value from an Ascon-Hash256 hashing operation.
+ *
+ * \param state Hash state to be finalized.
+ * \param out Points to the output buffer to receive the 32-byte hash value.
+ *
+ * \sa ascon_hash256_init(), ascon_hash256_update()
+ */
+void ascon_hash256_finalize
+    (ascon_hash256_state_t *state, unsigned char *out);
+
+/**
+ * \brief Clones a copy of an Ascon-Hash256 state.
+ *
+ * \param dest Destination hash state to copy into.
+ * \param src Source hash state to copy from.
+ *
+ * The destination will be initialized by this operation, so it must
+ * not previously have been initialized or it has already been freed.
+ * The source must be already initialized.
+ */
+void ascon_hash256_copy
+    (ascon_hash256_state_t *dest, const ascon_hash256_state_t *src);
+
+/**
+ * \brief Resets an Ascon-Hash256 state to a copy of a template state.
+ *
+ * \param state Ascon-Hash256 state to be reset, which must already be initialized.
+ * \param tmpl Template state to copy, such as a state that was saved just
+ * after initialization.
+ *
+ * Unlike ascon_hash256_copy(), this reuses the destination without freeing and
+ * initializing it again, so a context can be recycled cheaply between
+ * messages in a tight loop.
+ *
+ * \sa ascon_hash256_copy()
+ */
+void ascon_hash256_reset
+    (ascon_hash256_state_t *state, const ascon_hash256_state_t *tmpl);
+
+/**
+ * \brief Hashes a block of input data with Ascon-XOF128.
+ *
+ * \param out Buffer to receive the output which must be at least
+ * \a outlen bytes in length.
+ * \param outlen Number of bytes of output to generate.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ *
+ * \sa ascon_xof128_init(), ascon_xof128_absorb(), ascon_xof128_squeeze()
+ */
+void ascon_xof128
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Initializes the state for an Ascon-XOF128 hashing operation.
+ *
+ * \param state XOF state to be initialized.
+ *
+ * \sa ascon_xof128_absorb(), ascon_xof128_squeeze(), ascon_xof128()
+ */
+void ascon_xof128_init(ascon_xof128_state_t *state);
+
+/**
+ * \brief Frees an Ascon-XOF128 or Ascon-CXOF128 state and destroys any
+ * sensitive material.
+ *
+ * \param state XOF state to be freed.
+ */
+void ascon_xof128_free(ascon_xof128_state_t *state);
+
+/**
+ * \brief Aborbs more input data into an Ascon-XOF128 or
+ * Ascon-CXOF128 state.
+ *
+ * \param state XOF state to be updated.
+ * \param in Points to the input data to be absorbed into the state.
+ * \param inlen Length of the input data to be absorbed into the state.
+ *
+ * \sa ascon_xof128_init(), ascon_xof128_squeeze()
+ */
+void ascon_xof128_absorb
+    (ascon_xof128_state_t *state, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Squeezes output data from an Ascon-XOF128 or Ascon-CXOF128 state.
+ *
+ * \param state XOF state to squeeze the output data from.
+ * \param out Points to the output buffer to receive the squeezed data.
+ * \param outlen Number of bytes of data to squeeze out of the state.
+ *
+ * \sa ascon_xof128_init(), ascon_xof128_absorb()
+ */
+void ascon_xof128_squeeze
+    (ascon_xof128_state_t *state, unsigned char *out, size_t outlen);
+
+/**
+ * \brief Clones a copy of an Ascon-XOF128 or Ascon-CXOF128 state.
+ *
+ * \param dest Destination XOF state to copy into.
+ * \param src Source XOF state to copy from.
+ *
+ * The destination will be initialized by this operation, so it must
+ * not previously have been initialized or it has already been freed.
+ * The source must be already initialized.
+ */
+void ascon_xof128_copy
+    (ascon_xof128_state_t *dest, const ascon_xof128_state_t *src);
+
+/**
+ * \brief Resets an Ascon-XOF128 or Ascon-CXOF128 state to a copy of a template state.
+ *
+ * \param state Ascon-XOF128 or Ascon-CXOF128 state to be reset, which must already be initialized.
+ * \param tmpl Template state to copy, such as a state that was saved just
+ * after initialization with ascon_cxof128_init().
+ *
+ * Unlike ascon_xof128_copy(), this reuses the destination without freeing and
+ * initializing it again, so a context can be recycled cheaply between
+ * messages in a tight loop.
+ *
+ * \sa ascon_xof128_copy()
+ */
+void ascon_xof128_reset
+    (ascon_xof128_state_t *state, const ascon_xof128_state_t *tmpl);
+
+/**
+ * \brief Hashes a block of input data with Ascon-CXOF128.
+ *
+ * \param out Buffer to receive the output which must be at least
+ * \a outlen bytes in length.
+ * \param outlen Number of bytes of output to generate.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ * \param custom Points to the customization string.
+ * \param customlen Length of the customization string in bytes, which
+ * must be no more than ASCON_CXOF128_MAX_CUSTOM_SIZE.
+ *
+ * \return 0 on success, or -1 if \a customlen is too long.
+ *
+ * \sa ascon_cxof128_init(), ascon_cxof128_init_custom()
+ */
+int ascon_cxof128
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const unsigned char *custom, size_t customlen);
+
+/**
+ * \brief Initializes the state for an Ascon-CXOF128 hashing operation.
+ *
+ * \param state XOF state to be initialized.
+ * \param custom Points to the customization string.
+ * \param customlen Length of the customization string in bytes, which
+ * must be no more than ASCON_CXOF128_MAX_CUSTOM_SIZE.
+ *
+ * \return 0 on success, or -1 if \a customlen is too long.  The \a state
+ * is not initialized if -1 is returned.
+ *
+ * After initialization, use ascon_xof128_absorb() and
+ * ascon_xof128_squeeze() to process the message.
+ *
+ * \sa ascon_cxof128_init_custom()
+ */
+int ascon_cxof128_init
+    (ascon_xof128_state_t *state,
+     const unsigned char *custom, size_t customlen);
+
+/**
+ * \brief Pre-computes the state after absorbing a customization string
+ * for Ascon-CXOF128.
+ *
+ * \param pc Points to the object to receive the pre-computed state.
+ * \param custom Points to the customization string.
+ * \param customlen Length of the customization string in bytes, which
+ * must be no more than ASCON_CXOF128_MAX_CUSTOM_SIZE.
+ *
+ * \return 0 on success, or -1 if \a customlen is too long.  The \a pc
+ * object is not initialized if -1 is returned.
+ *
+ * Absorbing the customization string costs at least two permutation
+ * calls.  Applications that hash many messages with the same string
+ * can absorb it once and then start each message with
+ * ascon_cxof128_init_from_custom().
+ *
+ * \sa ascon_cxof128_init_from_custom(), ascon_cxof128_free_custom()
+ */
+int ascon_cxof128_init_custom
+    (ascon_cxof128_custom_t *pc,
+     const unsigned char *custom, size_t customlen);
+
+/**
+ * \brief Initializes the state for an Ascon-CXOF128 hashing operation
+ * from a pre-computed customization string.
+ *
+ * \param state XOF state to be initialized.
+ * \param pc Points to the pre-computed customization string.
+ *
+ * \sa ascon_cxof128_init_custom()
+ */
+void ascon_cxof128_init_from_custom
+    (ascon_xof128_state_t *state, const ascon_cxof128_custom_t *pc);
+
+/**
+ * \brief Frees a pre-computed customization string for Ascon-CXOF128.
+ *
+ * \param pc Points to the pre-computed customization string.
+ *
+ * \sa ascon_cxof128_init_custom()
+ */
+void ascon_cxof128_free_custom(ascon_cxof128_custom_t *pc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_STREAM_ADAPTER_H
+#define ASCON_STREAM_ADAPTER_H
+
+/**
+ * \file ascon-stream-adapter.h
+ * \brief Arduino Print and Stream adapters that encrypt or decrypt
+ * data on the fly with the incremental AEAD modes.
+ *
+ * AsconEncryptStream is a Print object that encrypts everything that
+ * is written to it and passes the ciphertext on to another Print object,
+ * such as a WiFiClient, File, or Serial.  The authentication tag is
+ * written after the ciphertext when end() is called:
+ *
+ * \code
+ * AsconEncryptStream<> enc(client);
+ * enc.begin(nonce, key);
+ * enc.print("Hello, World!");
+ * enc.end();
+ * \endcode
+ *
+ * AsconDecryptStream is a Stream object that reads ciphertext from
+ * another Stream and returns the plaintext.  The last ASCON128_TAG_SIZE
+ * bytes of the input are held back because they may be the tag.  Once
+ * all of the input has been received, end() checks the tag:
+ *
+ * \code
+ * AsconDecryptStream<> dec(client);
+ * dec.begin(nonce, key);
+ * while (more data expected) {
+ *     int ch = dec.read();
+ *     ...
+ * }
+ * if (dec.end() != 0) {
+ *     // Authentication failed; discard the plaintext that was read.
+ * }
+ * \endcode
+ *
+ * As with ascon128_aead_decrypt_block(), plaintext is returned before the
+ * tag has been checked.  The application must not act on the plaintext
+ * until end() reports success.
+ *
+ * Each adapter uses a single buffer of ASCON_STREAM_ADAPTER_BUFFER_SIZE
+ * bytes, plus room for the tag in the decryption case.
+ *
+ * This header does nothing unless compiling for Arduino with C++.
+ */
+
+#if defined(__cplusplus) && defined(ARDUINO)
+
+#include <Arduino.h>
+#include "ascon-cpp.h"
+#include "ascon-utility.h"
+
+/**
+ * \def ASCON_STREAM_ADAPTER_BUFFER_SIZE
+ * \brief Size of the data buffer in AsconEncryptStream and
+ * AsconDecryptStream.
+ *
+ * Data is encrypted or decrypted in chunks of up to this many bytes.
+ */
+#if !defined(ASCON_STREAM_ADAPTER_BUFFER_SIZE)
+#define ASCON_STREAM_ADAPTER_BUFFER_SIZE 32
+#endif
+
+/**
+ * \brief Print adapter that encrypts data with an ASCON AEAD variant.
+ *
+ * \tparam Variant The AEAD variant to use; default is Ascon::ASCON128a.
+ */
+template <typename Variant = Ascon::ASCON128a>
+class AsconEncryptStream : public Print
+{
+public:
+    /**
+     * \brief Constructs a new encryption adapter.
+     *
+     * \param out The Print object to write the ciphertext and tag to.
+     */
+    explicit AsconEncryptStream(Print &out) : output(out), len(0) {}
+
+    /**
+     * \brief Starts encrypting a new message.
+     *
+     * \param npub Points to the nonce, Variant::NonceSize bytes in length.
+     * \param k Points to the key, Variant::KeySize bytes in length.
+     * \param ad Points to the associated data for the message.
+     * \param adlen Number of bytes of associated data.
+     */
+    void begin(const unsigned char *npub, const unsigned char *k,
+               const unsigned char *ad = 0, size_t adlen = 0)
+    {
+        aead.start(npub, k, ad, adlen);
+        len = 0;
+    }
+
+    /**
+     * \brief Finishes the message, writing any buffered ciphertext and
+     * then the authentication tag to the output.
+     */
+    void end()
+    {
+        unsigned char tag[Variant::TagSize];
+        emit();
+        aead.encryptFinalize(tag);
+        output.write(tag, sizeof(tag));
+        ascon_clean(tag, sizeof(tag));
+    }
+
+    /** \brief Encrypts and writes a single byte */
+    size_t write(uint8_t b)
+    {
+        buffer[len++] = b;
+        if (len >= sizeof(buffer))
+            emit();
+        return 1;
+    }
+
+    /** \brief Encrypts and writes a buffer of bytes */
+    size_t write(const uint8_t *data, size_t size)
+    {
+        size_t total = size;
+        size_t chunk;
+        while (size > 0) {
+            chunk = sizeof(buffer) - len;
+            if (chunk > size)
+                chunk = size;
+            memcpy(buffer + len, data, chunk);
+            len += chunk;
+            data += chunk;
+            size -= chunk;
+            if (len >= sizeof(buffer))
+                emit();
+        }
+        return total;
+    }
+
+    /**
+     * \brief Encrypts and writes any buffered data and then flushes
+     * the output.
+     */
+    void flush()
+    {
+        emit();
+        output.flush();
+    }
+
+    using Print::write;
+
+private:
+    Ascon::Aead<Variant> aead;
+    Print &output;
+    unsigned char buffer[ASCON_STREAM_ADAPTER_BUFFER_SIZE];
+    size_t len;
+
+    void emit()
+    {
+        if (len > 0) {
+            aead.encrypt(buffer, buffer, len);
+            output.write(buffer, len);
+            len = 0;
+        }
+    }
+
+    AsconEncryptStream(const AsconEncryptStream &);
+    AsconEncryptStream &operator=(const AsconEncryptStream &);
+};
+
+/**
+ * \brief Stream adapter that decrypts data with an ASCON AEAD variant.
+ *
+ * \tparam Variant The AEAD variant to use; default is Ascon::ASCON128a.
+ */
+template <typename Variant = Ascon::ASCON128a>
+class AsconDecryptStream : public Stream
+{
+public:
+    /**
+     * \brief Constructs a new decryption adapter.
+     *
+     * \param in The Stream object to read the ciphertext and tag from.
+     */
+    explicit AsconDecryptStream(Stream &in)
+        : input(in), posn(0), plen(0), clen(0) {}
+
+    /**
+     * \brief Starts decrypting a new message.
+     *
+     * \param npub Points to the nonce, Variant::NonceSize bytes in length.
+     * \param k Points to the key, Variant::KeySize bytes in length.
+     * \param ad Points to the associated data for the message.
+     * \param adlen Number of bytes of associated data.
+     */
+    void begin(const unsigned char *npub, const unsigned char *k,
+               const unsigned char *ad = 0, size_t adlen = 0)
+    {
+        aead.start(npub, k, ad, adlen);
+        posn = plen = clen = 0;
+    }
+
+    /**
+     * \brief Finishes the message and checks the authentication tag.
+     *
+     * \return 0 if the tag is correct, or -1 if the tag is incorrect or
+     * the input was too short to contain a tag.
+     *
+     * Any plaintext that has not been read yet is discarded.  The input
+     * Stream must not have any further bytes for this message available.
+     */
+    int end()
+    {
+        int result;
+        fill();
+        if ((clen - plen) < Variant::TagSize) {
+            aead.abort();
+            result = -1;
+        } else {
+            /* Decrypt anything left before the tag, and then check it */
+            aead.decrypt(buffer + plen, buffer + plen,
+                         clen - plen - Variant::TagSize);
+            result = aead.decryptFinalize
+                (buffer + clen - Variant::TagSize);
+        }
+        ascon_clean(buffer, sizeof(buffer));
+        posn = plen = clen = 0;
+        return result;
+    }
+
+    /** \brief Returns the number of bytes of plaintext that are ready */
+    int available()
+    {
+        fill();
+        return (int)(plen - posn);
+    }
+
+    /** \brief Reads the next byte of plaintext, or -1 if none is ready */
+    int read()
+    {
+        fill();
+        if (posn < plen)
+            return buffer[posn++];
+        return -1;
+    }
+
+    /** \brief Peeks at the next byte of plaintext, or -1 if none is ready */
+    int peek()
+    {
+        fill();
+        if (posn < plen)
+            return buffer[posn];
+        return -1;
+    }
+
+    /** \brief Writing to a decryption stream is not supported */
+    size_t write(uint8_t b)
+    {
+        (void)b;
+        return 0;
+    }
+
+    /** \brief Does nothing; provided for compatibility with Stream */
+    void flush() {}
+
+    using Print::write;
+
+private:
+    Ascon::Aead<Variant> aead;
+    Stream &input;
+    unsigned char buffer
+        [ASCON_STREAM_ADAPTER_BUFFER_SIZE + Variant::TagSize];
+    size_t posn;    /* Position of the next plaintext byte to read */
+    size_t plen;    /* End of the decrypted plaintext in the buffer */
+    size_t clen;    /* End of the ciphertext in the buffer */
+
+    /* Reads more ciphertext and decrypts all but the last TagSize bytes */
+    void fill()
+    {
+        int ch;
+        if (posn < plen)
+            return;
+        if (plen > 0) {
+            memmove(buffer, buffer + plen, clen - plen);
+            clen -= plen;
+            posn = plen = 0;
+        }
+        while (clen < sizeof(buffer) && input.available() > 0) {
+            ch = input.read();
+            if (ch < 0)
+                break;
+            buffer[clen++] = (unsigned char)ch;
+        }
+        if (clen > Variant::TagSize) {
+            plen = clen - Variant::TagSize;
+            aead.decrypt(buffer, buffer, plen);
+        }
+    }
+
+    AsconDecryptStream(const AsconDecryptStream &);
+    AsconDecryptStream &operator=(const AsconDecryptStream &);
+};
+
+#endif /* __cplusplus && ARDUINO */
+
+#endif
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-config.h"
+#include "ascon-xof.h"
+#include "ascon-utility.h"
+#include "utility/ascon-multi.h"
+#include "utility/ascon-util-snp.h"
+
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Encodes an integer according to NIST SP 800-185.
+ *
+ * \param buf Buffer to receive the encoded value.
+ * \param value The value to be encoded.
+ * \param right Non-zero for right_encode(), zero for left_encode().
+ *
+ * \return The number of bytes that were written to \a buf.
+ */
+static size_t ascon_xof_tree_encode
+    (unsigned char buf[sizeof(uint64_t) + 1], uint64_t value, int right)
+{
+    uint64_t temp = value >> 8;
+    size_t size = 1;
+    size_t posn;
+    while (temp != 0) {
+        ++size;
+        temp >>= 8;
+    }
+    if (right) {
+        for (posn = 0; posn < size; ++posn)
+            buf[posn] = (unsigned char)(value >> ((size - posn - 1) * 8));
+        buf[size] = (unsigned char)size;
+    } else {
+        buf[0] = (unsigned char)size;
+        for (posn = 1; posn <= size; ++posn)
+            buf[posn] = (unsigned char)(value >> ((size - posn) * 8));
+    }
+    return size + 1;
+}
+
+/**
+ * \brief Hashes a group of whole chunks side by side.
+ *
+ * \param cvs Points to the buffer to receive the chaining values.
+ * \param in Points to the chunks to be hashed.
+ * \param count Number of chunks, between 1 and ASCON_MULTI_LANES.
+ * \param chunk_size Size of each chunk in bytes.
+ *
+ * All chunks are the same length, so the lanes stay in lock step and
+ * every permutation call can process all of them at once.
+ */
+static void ascon_xof_tree_hash_group
+    (unsigned char *cvs, const unsigned char *in,
+     unsigned count, size_t chunk_size)
+{
+    ascon_xof_state_t lanes[ASCON_MULTI_LANES];
+    ascon_state_t *states[ASCON_MULTI_LANES];
+    size_t posn;
+    unsigned index, temp;
+
+    /* Each leaf is an ASCON-HASH over its chunk */
+    for (index = 0; index < count; ++index) {
+        ascon_xof_init_fixed(&(lanes[index]), ASCON_HASH_SIZE);
+        ascon_acquire(&(lanes[index].state));
+        states[index] = &(lanes[index].state);
+    }
+
+    /* Absorb the full blocks of the chunks */
+    for (posn = 0; (chunk_size - posn) >= ASCON_XOF_RATE;
+            posn += ASCON_XOF_RATE) {
+        for (index = 0; index < count; ++index)
+            ascon_absorb_8(states[index], in + index * chunk_size + posn, 0);
+        ascon_permute_multi(states, count, 0);
+    }
+
+    /* Absorb the left-over partial blocks and pad */
+    temp = (unsigned)(chunk_size - posn);
+    for (index = 0; index < count; ++index) {
+        if (temp > 0) {
+            ascon_absorb_partial
+                (states[index], in + index * chunk_size + posn, 0, temp);
+        }
+        ascon_pad(states[index], temp);
+    }
+
+    /* Squeeze out the chaining values */
+    for (posn = 0; posn < ASCON_XOF_TREE_CV_SIZE; posn += ASCON_XOF_RATE) {
+        ascon_permute_multi(states, count, 0);
+        for (index = 0; index < count; ++index) {
+            ascon_squeeze_8
+                (states[index], cvs + index * ASCON_XOF_TREE_CV_SIZE + posn, 0);
+        }
+    }
+    for (index = 0; index < count; ++index)
+        ascon_free(states[index]);
+}
+
+void ascon_xof_tree_hash_chunks
+    (unsigned char *cvs, const unsigned char *in,
+     size_t count, size_t chunk_size)
+{
+    unsigned group;
+    if (!chunk_size)
+        chunk_size = ASCON_XOF_TREE_CHUNK_SIZE;
+    while (count > 0) {
+        group = (count < ASCON_MULTI_LANES) ? (unsigned)count
+                                            : ASCON_MULTI_LANES;
+        ascon_xof_tree_hash_group(cvs, in, group, chunk_size);
+        cvs += group * ASCON_XOF_TREE_CV_SIZE;
+        in += group * chunk_size;
+        count -= group;
+    }
+}
+
+void ascon_xof_tree
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen, size_t chunk_size)
+{
+    ascon_xof_tree_state_t state;
+    ascon_xof_tree_init(&state, chunk_size, outlen);
+    ascon_xof_tree_absorb(&state, in, inlen);
+    ascon_xof_tree_squeeze(&state, out, outlen);
+    ascon_xof_tree_free(&state);
+}
+
+void ascon_xof_tree_init
+    (ascon_xof_tree_state_t *state, size_t chunk_size, size_t outlen)
+{
+    unsigned char buf[sizeof(uint64_t) + 1];
+    size_t len;
+    if (!chunk_size)
+        chunk_size = ASCON_XOF_TREE_CHUNK_SIZE;
+
+    /* The root is an arbitrary-length ASCON-XOF, which has a different
+     * IV to the ASCON-HASH leaves, and starts with the chunk size */
+    ascon_xof_init(&(state->root));
+    len = ascon_xof_tree_encode(buf, chunk_size, 0);
+    ascon_xof_absorb(&(state->root), buf, len);
+    ascon_xof_init_fixed(&(state->leaf), ASCON_HASH_SIZE);
+    state->chunk_size = chunk_size;
+    state->leaf_posn = 0;
+    state->outlen = outlen;
+    state->leaves = 0;
+    state->mode = 0;
+}
+
+void ascon_xof_tree_free(ascon_xof_tree_state_t *state)
+{
+    if (state) {
+        ascon_xof_free(&(state->root));
+        ascon_xof_free(&(state->leaf));
+        state->leaf_posn = 0;
+        state->leaves = 0;
+        state->mode = 0;
+    }
+}
+
+/**
+ * \brief Finishes the current chunk and absorbs its chaining value
+ * into the root.
+ *
+ * \param state Tree hash state.
+ */
+static void ascon_xof_tree_finish_leaf(ascon_xof_tree_state_t *state)
+{
+    unsigned char cv[ASCON_XOF_TREE_CV_SIZE];
+    ascon_xof_squeeze(&(state->leaf), cv, sizeof(cv));
+    ascon_xof_absorb(&(state->root), cv, sizeof(cv));
+    ascon_xof_reinit_fixed(&(state->leaf), ASCON_HASH_SIZE);
+    ascon_clean(cv, sizeof(cv));
+    state->leaf_posn = 0;
+    ++(state->leaves);
+}
+
+void ascon_xof_tree_absorb
+    (ascon_xof_tree_state_t *state, const unsigned char *in, size_t inlen)
+{
+    unsigned char cvs[ASCON_XOF_TREE_CV_SIZE * ASCON_MULTI_LANES];
+    size_t temp;
+    unsigned count;
+
+    /* Cannot absorb more data once we are squeezing */
+    if (state->mode)
+        return;
+
+    /* Fill up the current partial chunk */
+    if (state->leaf_posn) {
+        temp = state->chunk_size - state->leaf_posn;
+        if (temp > inlen) {
+            ascon_xof_absorb(&(state->leaf), in, inlen);
+            state->leaf_posn += inlen;
+            return;
+        }
+        ascon_xof_absorb(&(state->leaf), in, temp);
+        ascon_xof_tree_finish_leaf(state);
+        in += temp;
+        inlen -= temp;
+    }
+
+    /* Hash groups of whole chunks directly from the input */
+    while (inlen >= state->chunk_size) {
+        temp = inlen / state->chunk_size;
+        count = (temp < ASCON_MULTI_LANES) ? (unsigned)temp
+                                           : ASCON_MULTI_LANES;
+        ascon_xof_tree_hash_group(cvs, in, count, state->chunk_size);
+        ascon_xof_absorb
+            (&(state->root), cvs, count * ASCON_XOF_TREE_CV_SIZE);
+        state->leaves += count;
+        in += count * state->chunk_size;
+        inlen -= count * state->chunk_size;
+    }
+    ascon_clean(cvs, sizeof(cvs));
+
+    /* Start a new partial chunk with the left-over input */
+    if (inlen > 0) {
+        ascon_xof_absorb(&(state->leaf), in, inlen);
+        state->leaf_posn = inlen;
+    }
+}
+
+void ascon_xof_tree_absorb_cvs
+    (ascon_xof_tree_state_t *state, const unsigned char *cvs, size_t count)
+{
+    if (state->mode || state->leaf_posn)
+        return;
+    ascon_xof_absorb(&(state->root), cvs, count * ASCON_XOF_TREE_CV_SIZE);
+    state->leaves += count;
+}
+
+void ascon_xof_tree_squeeze
+    (ascon_xof_tree_state_t *state, unsigned char *out, size_t outlen)
+{
+    unsigned char buf[sizeof(uint64_t) + 1];
+    size_t len;
+
+    /* Finalize the last chunk and the root encoding on the first call */
+    if (!state->mode) {
+        if (state->leaf_posn)
+            ascon_xof_tree_finish_leaf(state);
+        len = ascon_xof_tree_encode(buf, state->leaves, 1);
+        ascon_xof_absorb(&(state->root), buf, len);
+        len = ascon_xof_tree_encode(buf, state->outlen * 8ULL, 1);
+        ascon_xof_absorb(&(state->root), buf, len);
+        state->mode = 1;
+    }
+    ascon_xof_squeeze(&(state->root), out, outlen);
+}
+
+#endif /* ASCON_ENABLE_HASH */
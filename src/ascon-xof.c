@@ -20,20 +20,55 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
+#include "ascon-latency.h"
 #include "ascon-xof.h"
 #include "utility/ascon-util-snp.h"
+#include "utility/ascon-bulk.h"
 
 void ascon_xof(unsigned char *out, const unsigned char *in, size_t inlen)
 {
     ascon_xof_state_t state;
-    ascon_xof_init(&state);
-    ascon_xof_absorb(&state, in, inlen);
-    ascon_xof_squeeze(&state, out, ASCON_HASH_SIZE);
-    ascon_xof_free(&state);
+    ascon_xof_ex(out, in, inlen, &state);
+}
+
+void ascon_xof_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_xof_state_t *workspace)
+{
+    ascon_latency_begin();
+    ascon_xof_init(workspace);
+    ascon_xof_absorb(workspace, in, inlen);
+    ascon_xof_squeeze(workspace, out, ASCON_HASH_SIZE);
+    ascon_xof_free(workspace);
+    ascon_latency_end(ASCON_LATENCY_HASH);
+}
+
+/**
+ * \brief Initializes an ASCON-XOF state by running the permutation
+ * on a specific initialization vector.
+ *
+ * \param state The ASCON-XOF state to initialize.
+ * \param iv_word The initialization vector as a 64-bit word.
+ */
+static void ascon_xof_init_iv(ascon_xof_state_t *state, uint64_t iv_word)
+{
+    uint8_t iv[8];
+    ascon_init(&(state->state));
+    be_store_word64(iv, iv_word);
+    ascon_overwrite_bytes(&(state->state), iv, 0, 8);
+    ascon_permute(&(state->state), 0);
+    ascon_release(&(state->state));
+    state->count = 0;
+    state->mode = 0;
 }
 
 void ascon_xof_init(ascon_xof_state_t *state)
 {
+#if defined(ASCON_SMALL)
+    /* Compute the IV at runtime to avoid storing it */
+    ascon_xof_init_iv(state, 0x00400c0000000000ULL);
+#else
     /* IV for ASCON-XOF after processing it with the permutation */
 #if defined(ASCON_BACKEND_SLICED64)
     static uint64_t const iv[5] = {
@@ -67,8 +102,105 @@ void ascon_xof_init(ascon_xof_state_t *state)
 #endif
     state->count = 0;
     state->mode = 0;
+#endif
 }
 
+#if !defined(ASCON_SMALL)
+
+/* Pre-computed IV's for commonly-used fixed output lengths of
+ * 16, 24, and 64 bytes, after processing them with the permutation */
+#if defined(ASCON_BACKEND_SLICED64)
+static uint64_t const ascon_xof_fixed_iv[3][5] = {
+    {
+        0x1865fd08f8be5435ULL, 0xf2a787358536c6faULL,
+        0x57fe39d62bfc3238ULL, 0x59ab3ebc30d75ba6ULL,
+        0x6b0ebba1fa5c7611ULL
+    },
+    {
+        0x781635ef585e8142ULL, 0xa21e8b5edaa1012fULL,
+        0x166b3add047a9aa8ULL, 0x517df90d1038eaeeULL,
+        0xb569e49f3cebde66ULL
+    },
+    {
+        0x7245fcbcf6229ddaULL, 0x8b4e6e9d5f2fc23eULL,
+        0x8ef2bf160ce1267eULL, 0x6e6d92c9dfeb323eULL,
+        0xd46a9157a7ca9375ULL
+    }
+};
+#elif defined(ASCON_BACKEND_SLICED32)
+static uint32_t const ascon_xof_fixed_iv[3][10] = {
+    {
+        0x4bf0c6e7, 0x24e2ef04, 0xc33736ac, 0xdd94859f,
+        0xfe5e1e44, 0x1f697e56, 0xd1664fd2, 0x2f7e493d,
+        0x9251cee5, 0x73fcf250
+    },
+    {
+        0xc67bce18, 0x614f2381, 0x061ec113, 0xd3b3bc07,
+        0x694f2c40, 0x177a07be, 0xdfd3448a, 0x06e206ff,
+        0x79a769ea, 0xc6cb6fb5
+    },
+    {
+        0xcbe6e07c, 0x50eed5ab, 0x1aa7f386, 0xb37a3797,
+        0x2c76292e, 0xbdf12c57, 0xab49f946, 0x769abf57,
+        0xe85f385f, 0x8781db94
+    }
+};
+#else
+static uint8_t const ascon_xof_fixed_iv[3][40] = {
+    {
+        0x18, 0x65, 0xfd, 0x08, 0xf8, 0xbe, 0x54, 0x35,
+        0xf2, 0xa7, 0x87, 0x35, 0x85, 0x36, 0xc6, 0xfa,
+        0x57, 0xfe, 0x39, 0xd6, 0x2b, 0xfc, 0x32, 0x38,
+        0x59, 0xab, 0x3e, 0xbc, 0x30, 0xd7, 0x5b, 0xa6,
+        0x6b, 0x0e, 0xbb, 0xa1, 0xfa, 0x5c, 0x76, 0x11
+    },
+    {
+        0x78, 0x16, 0x35, 0xef, 0x58, 0x5e, 0x81, 0x42,
+        0xa2, 0x1e, 0x8b, 0x5e, 0xda, 0xa1, 0x01, 0x2f,
+        0x16, 0x6b, 0x3a, 0xdd, 0x04, 0x7a, 0x9a, 0xa8,
+        0x51, 0x7d, 0xf9, 0x0d, 0x10, 0x38, 0xea, 0xee,
+        0xb5, 0x69, 0xe4, 0x9f, 0x3c, 0xeb, 0xde, 0x66
+    },
+    {
+        0x72, 0x45, 0xfc, 0xbc, 0xf6, 0x22, 0x9d, 0xda,
+        0x8b, 0x4e, 0x6e, 0x9d, 0x5f, 0x2f, 0xc2, 0x3e,
+        0x8e, 0xf2, 0xbf, 0x16, 0x0c, 0xe1, 0x26, 0x7e,
+        0x6e, 0x6d, 0x92, 0xc9, 0xdf, 0xeb, 0x32, 0x3e,
+        0xd4, 0x6a, 0x91, 0x57, 0xa7, 0xca, 0x93, 0x75
+    }
+};
+#endif
+
+/**
+ * \brief Initializes an ASCON-XOF state from one of the pre-computed IV's.
+ *
+ * \param state The ASCON-XOF state to initialize.
+ * \param index Index of the pre-computed IV to use.
+ */
+static void ascon_xof_init_fixed_iv(ascon_xof_state_t *state, unsigned index)
+{
+#if defined(ASCON_BACKEND_SLICED64)
+    memcpy(state->state.S, ascon_xof_fixed_iv[index],
+           sizeof(ascon_xof_fixed_iv[0]));
+#elif defined(ASCON_BACKEND_SLICED32)
+    memcpy(state->state.W, ascon_xof_fixed_iv[index],
+           sizeof(ascon_xof_fixed_iv[0]));
+#elif defined(ASCON_BACKEND_DIRECT_XOR)
+    memcpy(state->state.B, ascon_xof_fixed_iv[index],
+           sizeof(ascon_xof_fixed_iv[0]));
+#else
+    ascon_init(&(state->state));
+    ascon_overwrite_bytes
+        (&(state->state), ascon_xof_fixed_iv[index], 0,
+         sizeof(ascon_xof_fixed_iv[0]));
+    ascon_release(&(state->state));
+#endif
+    state->count = 0;
+    state->mode = 0;
+}
+
+#endif /* !ASCON_SMALL */
+
 void ascon_xof_init_fixed(ascon_xof_state_t *state, size_t outlen)
 {
 #if !defined(__SIZEOF_SIZE_T__) || __SIZEOF_SIZE_T__ >= 4
@@ -78,7 +210,9 @@ void ascon_xof_init_fixed(ascon_xof_state_t *state, size_t outlen)
     if (outlen == 0U) {
         /* Output length of zero is equivalent to regular XOF */
         ascon_xof_init(state);
-    } else if (outlen == 32U) {
+    }
+#if !defined(ASCON_SMALL)
+    else if (outlen == 32U) {
         /* Output length of 32 is equivalent to ASCON-HASH */
 #if defined(ASCON_BACKEND_SLICED64)
         static uint64_t const iv[5] = {
@@ -112,17 +246,18 @@ void ascon_xof_init_fixed(ascon_xof_state_t *state, size_t outlen)
 #endif
         state->count = 0;
         state->mode = 0;
-    } else {
+    } else if (outlen == 16U) {
+        ascon_xof_init_fixed_iv(state, 0);
+    } else if (outlen == 24U) {
+        ascon_xof_init_fixed_iv(state, 1);
+    } else if (outlen == 64U) {
+        ascon_xof_init_fixed_iv(state, 2);
+    }
+#endif
+    else {
         /* For all other lengths, we need to run the permutation
          * to get the initial block for the XOF process */
-        uint8_t iv[8];
-        ascon_init(&(state->state));
-        be_store_word64(iv, 0x00400c0000000000ULL | (outlen * 8UL));
-        ascon_overwrite_bytes(&(state->state), iv, 0, 8);
-        ascon_permute(&(state->state), 0);
-        ascon_release(&(state->state));
-        state->count = 0;
-        state->mode = 0;
+        ascon_xof_init_iv(state, 0x00400c0000000000ULL | (outlen * 8UL));
     }
 }
 
@@ -163,6 +298,8 @@ void ascon_xof_absorb
 {
     unsigned temp;
 
+    ascon_stats_bytes(inlen, 0);
+
     /* Acquire access to shared hardware if necessary */
     ascon_acquire(&(state->state));
 
@@ -213,6 +350,8 @@ void ascon_xof_squeeze
 {
     unsigned temp;
 
+    ascon_stats_bytes(0, outlen);
+
     /* Acquire access to shared hardware if necessary */
     ascon_acquire(&(state->state));
 
@@ -239,12 +378,13 @@ void ascon_xof_squeeze
         state->count = 0;
     }
 
-    /* Handle full blocks */
-    while (outlen >= ASCON_XOF_RATE) {
-        ascon_permute(&(state->state), 0);
-        ascon_squeeze_8(&(state->state), out, 0);
-        out += ASCON_XOF_RATE;
-        outlen -= ASCON_XOF_RATE;
+    /* Handle full blocks, squeezing directly into the caller's buffer */
+    if (outlen >= ASCON_XOF_RATE) {
+        size_t blocks = outlen / ASCON_XOF_RATE;
+        ascon_squeeze_blocks
+            (&(state->state), out, blocks, ASCON_XOF_RATE, 0);
+        out += blocks * ASCON_XOF_RATE;
+        outlen -= blocks * ASCON_XOF_RATE;
     }
 
     /* Handle the left-over block */
@@ -293,3 +433,42 @@ void ascon_xof_copy(ascon_xof_state_t *dest, const ascon_xof_state_t *src)
         dest->mode = src->mode;
     }
 }
+
+void ascon_xof_reset(ascon_xof_state_t *state, const ascon_xof_state_t *tmpl)
+{
+    if (state != tmpl) {
+        ascon_acquire(&(state->state));
+        ascon_copy(&(state->state), &(tmpl->state));
+        ascon_release(&(state->state));
+        state->count = tmpl->count;
+        state->mode = tmpl->mode;
+    }
+}
+
+/* Identifies an ASCON-XOF state in a serialized snapshot */
+#define ASCON_XOF_SNAPSHOT_ID 0x01
+
+void ascon_xof_snapshot(ascon_xof_state_t *state, unsigned char *snapshot)
+{
+    snapshot[0] = ASCON_XOF_SNAPSHOT_ID;
+    ascon_acquire(&(state->state));
+    ascon_extract_bytes(&(state->state), snapshot + 1, 0, 40);
+    ascon_release(&(state->state));
+    snapshot[41] = state->count;
+    snapshot[42] = state->mode;
+}
+
+int ascon_xof_restore
+    (ascon_xof_state_t *state, const unsigned char *snapshot)
+{
+    if (snapshot[0] != ASCON_XOF_SNAPSHOT_ID ||
+            snapshot[41] >= ASCON_XOF_RATE || snapshot[42] > 1) {
+        return -1;
+    }
+    ascon_init(&(state->state));
+    ascon_overwrite_bytes(&(state->state), snapshot + 1, 0, 40);
+    ascon_release(&(state->state));
+    state->count = snapshot[41];
+    state->mode = snapshot[42];
+    return 0;
+}
@@ -54,6 +54,14 @@ extern "C" {
  */
 #define ASCON_XOF_RATE 8
 
+/**
+ * \brief Size of a serialized snapshot of an ASCON-XOF or ASCON-XOFA state.
+ *
+ * The same snapshot format is used for the hash, KMAC, and HMAC modes
+ * that are built on top of ASCON-XOF and ASCON-XOFA.
+ */
+#define ASCON_XOF_SNAPSHOT_SIZE 43
+
 /**
  * \brief State information for ASCON-XOF incremental mode.
  */
@@ -91,6 +99,23 @@ typedef struct
  */
 void ascon_xof(unsigned char *out, const unsigned char *in, size_t inlen);
 
+/**
+ * \brief Hashes a block of input data with ASCON-XOF using a caller-provided
+ * workspace instead of a state on the stack.
+ *
+ * \param out Buffer to receive the hash output which must be at least
+ * ASCON_HASH_SIZE bytes in length.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ * \param workspace Points to the state to use while hashing, which
+ * is freed before the function returns.
+ *
+ * \sa ascon_xof()
+ */
+void ascon_xof_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_xof_state_t *workspace);
+
 /**
  * \brief Initializes the state for an ASCON-XOF hashing operation.
  *
@@ -111,6 +136,10 @@ void ascon_xof_init(ascon_xof_state_t *state);
  * in a 32-bit word.  If \a outlen is greater than 536870911, it will be
  * replaced with zero to indicate arbitary-length output instead.
  *
+ * The initial states for output lengths of 0, 16, 24, 32, and 64 are
+ * pre-computed, so initialization is a simple copy for those lengths.
+ * Other lengths require an extra permutation call to set up the state.
+ *
  * \sa ascon_xof_init()
  */
 void ascon_xof_init_fixed(ascon_xof_state_t *state, size_t outlen);
@@ -212,6 +241,56 @@ void ascon_xof_clear_rate(ascon_xof_state_t *state);
  */
 void ascon_xof_copy(ascon_xof_state_t *dest, const ascon_xof_state_t *src);
 
+/**
+ * \brief Resets an ASCON-XOF state to a copy of a template state.
+ *
+ * \param state ASCON-XOF state to be reset, which must already be initialized.
+ * \param tmpl Template state to copy, such as a state that was saved just
+ * after initialization with ascon_xof_init_fixed() or after
+ * absorbing a common prefix.
+ *
+ * Unlike ascon_xof_copy(), this reuses the destination without freeing and
+ * initializing it again, so a context can be recycled cheaply between
+ * messages in a tight loop.
+ *
+ * \sa ascon_xof_copy()
+ */
+void ascon_xof_reset(ascon_xof_state_t *state, const ascon_xof_state_t *tmpl);
+
+/**
+ * \brief Saves a serialized snapshot of an ASCON-XOF state.
+ *
+ * \param state XOF state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * The snapshot is in a portable byte format that does not depend upon
+ * the back end, so it can be persisted to flash or sent to another
+ * device and restored later with ascon_xof_restore().  This is useful
+ * when many messages share a common prefix: absorb the prefix once,
+ * save the snapshot, and then resume from it for each message.
+ *
+ * \sa ascon_xof_restore(), ascon_xof_copy()
+ */
+void ascon_xof_snapshot(ascon_xof_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-XOF state from a serialized snapshot.
+ *
+ * \param state XOF state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not a valid ASCON-XOF
+ * snapshot.  The \a state is not initialized if -1 is returned.
+ *
+ * The \a state will be initialized by this operation, so it must
+ * not previously have been initialized or it has already been freed.
+ *
+ * \sa ascon_xof_snapshot()
+ */
+int ascon_xof_restore(ascon_xof_state_t *state, const unsigned char *snapshot);
+
 /**
  * \brief Hashes a block of input data with ASCON-XOFA and generates a
  * fixed-length 32 byte output.
@@ -227,6 +306,23 @@ void ascon_xof_copy(ascon_xof_state_t *dest, const ascon_xof_state_t *src);
  */
 void ascon_xofa(unsigned char *out, const unsigned char *in, size_t inlen);
 
+/**
+ * \brief Hashes a block of input data with ASCON-XOFA using a caller-provided
+ * workspace instead of a state on the stack.
+ *
+ * \param out Buffer to receive the hash output which must be at least
+ * ASCON_HASH_SIZE bytes in length.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ * \param workspace Points to the state to use while hashing, which
+ * is freed before the function returns.
+ *
+ * \sa ascon_xofa()
+ */
+void ascon_xofa_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_xofa_state_t *workspace);
+
 /**
  * \brief Initializes the state for an ASCON-XOFA hashing operation.
  *
@@ -247,6 +343,10 @@ void ascon_xofa_init(ascon_xofa_state_t *state);
  * in a 32-bit word.  If \a outlen is greater than 536870911, it will be
  * replaced with zero to indicate arbitary-length output instead.
  *
+ * The initial states for output lengths of 0, 16, 24, 32, and 64 are
+ * pre-computed, so initialization is a simple copy for those lengths.
+ * Other lengths require an extra permutation call to set up the state.
+ *
  * \sa ascon_xofa_init()
  */
 void ascon_xofa_init_fixed(ascon_xofa_state_t *state, size_t outlen);
@@ -348,6 +448,213 @@ void ascon_xofa_clear_rate(ascon_xofa_state_t *state);
  */
 void ascon_xofa_copy(ascon_xofa_state_t *dest, const ascon_xofa_state_t *src);
 
+/**
+ * \brief Resets an ASCON-XOFA state to a copy of a template state.
+ *
+ * \param state ASCON-XOFA state to be reset, which must already be initialized.
+ * \param tmpl Template state to copy, such as a state that was saved just
+ * after initialization with ascon_xofa_init_fixed() or after
+ * absorbing a common prefix.
+ *
+ * Unlike ascon_xofa_copy(), this reuses the destination without freeing and
+ * initializing it again, so a context can be recycled cheaply between
+ * messages in a tight loop.
+ *
+ * \sa ascon_xofa_copy()
+ */
+void ascon_xofa_reset
+    (ascon_xofa_state_t *state, const ascon_xofa_state_t *tmpl);
+
+/**
+ * \brief Saves a serialized snapshot of an ASCON-XOFA state.
+ *
+ * \param state XOF state to snapshot.
+ * \param snapshot Buffer to receive the snapshot, which must be at
+ * least ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * The snapshot is in a portable byte format that does not depend upon
+ * the back end, so it can be persisted to flash or sent to another
+ * device and restored later with ascon_xofa_restore().  This is useful
+ * when many messages share a common prefix: absorb the prefix once,
+ * save the snapshot, and then resume from it for each message.
+ *
+ * \sa ascon_xofa_restore(), ascon_xofa_copy()
+ */
+void ascon_xofa_snapshot(ascon_xofa_state_t *state, unsigned char *snapshot);
+
+/**
+ * \brief Restores an ASCON-XOFA state from a serialized snapshot.
+ *
+ * \param state XOF state to be initialized from the snapshot.
+ * \param snapshot Points to the snapshot, which must be
+ * ASCON_XOF_SNAPSHOT_SIZE bytes in length.
+ *
+ * \return 0 on success, or -1 if the snapshot is not a valid ASCON-XOFA
+ * snapshot.  The \a state is not initialized if -1 is returned.
+ *
+ * The \a state will be initialized by this operation, so it must
+ * not previously have been initialized or it has already been freed.
+ *
+ * \sa ascon_xofa_snapshot()
+ */
+int ascon_xofa_restore
+    (ascon_xofa_state_t *state, const unsigned char *snapshot);
+
+/* ---------------------------------------------------------------- */
+/*                 Tree hashing mode for large inputs               */
+/* ---------------------------------------------------------------- */
+
+/**
+ * \brief Default chunk size for the ASCON-XOF tree hashing mode.
+ */
+#define ASCON_XOF_TREE_CHUNK_SIZE 8192
+
+/**
+ * \brief Size of the chaining value for each chunk in the ASCON-XOF
+ * tree hashing mode.
+ */
+#define ASCON_XOF_TREE_CV_SIZE ASCON_HASH_SIZE
+
+/**
+ * \brief State information for the ASCON-XOF tree hashing mode.
+ *
+ * The input is split into fixed-size chunks that are hashed independently
+ * with ASCON-HASH to produce 32-byte chaining values.  The root is an
+ * ASCON-XOF hash over the encoded chunk size, all chaining values in order,
+ * the number of chunks, and the requested output length, in the style of
+ * ParallelHash from NIST SP 800-185.  The leaves and the root use different
+ * initialization vectors so that their domains are separated.
+ *
+ * Because the chunks are independent, they can be hashed with the
+ * multi-state permutations or on different threads and then combined
+ * with ascon_xof_tree_absorb_cvs().  The output is the same no matter
+ * how the chunks were hashed.
+ */
+typedef struct
+{
+    ascon_xof_state_t root; /**< Root XOF that absorbs the chaining values */
+    ascon_xof_state_t leaf; /**< Leaf hash for the current partial chunk */
+    size_t chunk_size;      /**< Size of each chunk in bytes */
+    size_t leaf_posn;       /**< Number of bytes in the current chunk */
+    size_t outlen;          /**< Output length, or 0 for arbitrary-length */
+    uint64_t leaves;        /**< Number of chunks that have been hashed */
+    unsigned char mode;     /**< Hash mode: 0 for absorb, 1 for squeeze */
+
+} ascon_xof_tree_state_t;
+
+/**
+ * \brief Hashes a block of input data with the ASCON-XOF tree hashing mode.
+ *
+ * \param out Buffer to receive the output.
+ * \param outlen Number of bytes of output to generate.
+ * \param in Points to the input data to be hashed.
+ * \param inlen Length of the input data in bytes.
+ * \param chunk_size Size of each chunk in bytes, or 0 to use the
+ * default of ASCON_XOF_TREE_CHUNK_SIZE.
+ *
+ * The output depends upon \a outlen and \a chunk_size, so all parties
+ * must agree on both values.
+ *
+ * \sa ascon_xof_tree_init(), ascon_xof_tree_absorb()
+ */
+void ascon_xof_tree
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen, size_t chunk_size);
+
+/**
+ * \brief Initializes the state for an ASCON-XOF tree hashing operation.
+ *
+ * \param state Tree hash state to be initialized.
+ * \param chunk_size Size of each chunk in bytes, or 0 to use the
+ * default of ASCON_XOF_TREE_CHUNK_SIZE.
+ * \param outlen The desired output length in bytes, or 0 for
+ * arbitrary-length output.
+ *
+ * \sa ascon_xof_tree_absorb(), ascon_xof_tree_squeeze()
+ */
+void ascon_xof_tree_init
+    (ascon_xof_tree_state_t *state, size_t chunk_size, size_t outlen);
+
+/**
+ * \brief Frees the ASCON-XOF tree hashing state and destroys any
+ * sensitive material.
+ *
+ * \param state Tree hash state to be freed.
+ */
+void ascon_xof_tree_free(ascon_xof_tree_state_t *state);
+
+/**
+ * \brief Absorbs more input data into an ASCON-XOF tree hashing state.
+ *
+ * \param state Tree hash state to be updated.
+ * \param in Points to the input data to be absorbed into the state.
+ * \param inlen Length of the input data to be absorbed into the state.
+ *
+ * Whole chunks that are aligned on a chunk boundary are hashed directly
+ * from \a in with the multi-state permutations.  Input cannot be absorbed
+ * once squeezing has started; any such input is ignored.
+ *
+ * \sa ascon_xof_tree_squeeze()
+ */
+void ascon_xof_tree_absorb
+    (ascon_xof_tree_state_t *state, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Absorbs chaining values for whole chunks that were
+ * hashed elsewhere.
+ *
+ * \param state Tree hash state to be updated.
+ * \param cvs Points to the chaining values, ASCON_XOF_TREE_CV_SIZE
+ * bytes for each chunk.
+ * \param count Number of chaining values to absorb.
+ *
+ * The state must be on a chunk boundary; i.e. the total amount of data
+ * absorbed by ascon_xof_tree_absorb() must be a multiple of the chunk
+ * size.  Otherwise the chaining values are ignored.
+ *
+ * \sa ascon_xof_tree_hash_chunks()
+ */
+void ascon_xof_tree_absorb_cvs
+    (ascon_xof_tree_state_t *state, const unsigned char *cvs, size_t count);
+
+/**
+ * \brief Squeezes output data from an ASCON-XOF tree hashing state.
+ *
+ * \param state Tree hash state to squeeze the output data from.
+ * \param out Points to the output buffer to receive the squeezed data.
+ * \param outlen Number of bytes of data to squeeze out of the state.
+ *
+ * The first call finalizes the last partial chunk and the root encoding.
+ * Subsequent calls continue squeezing from where the last call left off.
+ *
+ * \sa ascon_xof_tree_absorb()
+ */
+void ascon_xof_tree_squeeze
+    (ascon_xof_tree_state_t *state, unsigned char *out, size_t outlen);
+
+/**
+ * \brief Hashes a sequence of whole chunks to produce their chaining values.
+ *
+ * \param cvs Points to the buffer to receive the chaining values, which
+ * must be at least \a count * ASCON_XOF_TREE_CV_SIZE bytes in length.
+ * \param in Points to the chunks, which are \a count * \a chunk_size
+ * bytes in length.
+ * \param count Number of chunks to hash.
+ * \param chunk_size Size of each chunk in bytes, or 0 to use the
+ * default of ASCON_XOF_TREE_CHUNK_SIZE.
+ *
+ * This function has no shared state, so different threads can hash
+ * different ranges of chunks at the same time.  The chaining values
+ * are then passed to ascon_xof_tree_absorb_cvs() in chunk order.
+ * Within each call, the chunks are hashed side by side with the
+ * multi-state permutations if the back end supports them.
+ *
+ * \sa ascon_xof_tree_absorb_cvs()
+ */
+void ascon_xof_tree_hash_chunks
+    (unsigned char *cvs, const unsigned char *in,
+     size_t count, size_t chunk_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2021 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "ascon-config.h"
+#include "ascon-latency.h"
+#include "ascon-sp800-232.h"
+#include "utility/ascon-util-le.h"
+#include <string.h>
+
+#if ASCON_ENABLE_HASH
+
+/**
+ * \brief Initialization vector for Ascon-XOF128.
+ */
+#define ASCON_XOF128_IV 0x0000080000cc0003ULL
+
+/**
+ * \brief Initialization vector for Ascon-CXOF128.
+ */
+#define ASCON_CXOF128_IV 0x0000080000cc0004ULL
+
+/**
+ * \brief Index of the Ascon-XOF128 initial state in ascon_xof128_iv.
+ */
+#define ASCON_XOF128_INDEX 0
+
+/**
+ * \brief Index of the Ascon-CXOF128 initial state in ascon_xof128_iv,
+ * before the customization string is absorbed.
+ */
+#define ASCON_CXOF128_INDEX 1
+
+/**
+ * \brief Index of the Ascon-CXOF128 initial state in ascon_xof128_iv,
+ * after absorbing an empty customization string.
+ */
+#define ASCON_CXOF128_EMPTY_INDEX 2
+
+#if !defined(ASCON_SMALL)
+
+/* Pre-computed initial states for Ascon-XOF128 and Ascon-CXOF128,
+ * after processing the IV's with the permutation */
+#if defined(ASCON_BACKEND_SLICED64)
+static uint64_t const ascon_xof128_iv[3][5] = {
+    {
+        0xda82ce768d9447ebULL, 0xcc7ce6c75f1ef969ULL,
+        0xe7508fd780085631ULL, 0x0ee0ea53416b58ccULL,
+        0xe0547524db6f0bdeULL
+    },
+    {
+        0x675527c2a0e8de03ULL, 0x43d12d7dc0377bbcULL,
+        0xe9901dec426e81b5ULL, 0x2ab14907720780b6ULL,
+        0x8f3f1d02d432bc46ULL
+    },
+    {
+        0x500cccc894e3c9e8ULL, 0x5bed06f28f71248dULL,
+        0x3b03a0f930afd512ULL, 0x112ef093aa5c698bULL,
+        0x00c8356340a347f0ULL
+    }
+};
+#elif defined(ASCON_BACKEND_SLICED32)
+static uint32_t const ascon_xof128_iv[3][10] = {
+    {
+        0xc0ae36b9, 0xb9b5a81f, 0xaeabf6d9, 0xa6d933e6,
+        0xbc3f00e5, 0xd0b98214, 0x288d99ca, 0x3cf1072a,
+        0x8ef2db1e, 0xc044b73b
+    },
+    {
+        0xbf3808e1, 0x5059ceb1, 0x9d3f87d6, 0x1866857e,
+        0x947a8a17, 0xe82e178c, 0x0593c306, 0x7c21518d,
+        0x3770e46a, 0xb72185e1
+    },
+    {
+        0xc2a86998, 0x02aa8dae, 0xdb2c3d23, 0x3e1db44a,
+        0x510d43f4, 0x71ce4f81, 0x52c50e91, 0x07c9f26b,
+        0x087981bc, 0x0a450d1c
+    }
+};
+#else
+static uint8_t const ascon_xof128_iv[3][40] = {
+    {
+        0xda, 0x82, 0xce, 0x76, 0x8d, 0x94, 0x47, 0xeb,
+        0xcc, 0x7c, 0xe6, 0xc7, 0x5f, 0x1e, 0xf9, 0x69,
+        0xe7, 0x50, 0x8f, 0xd7, 0x80, 0x08, 0x56, 0x31,
+        0x0e, 0xe0, 0xea, 0x53, 0x41, 0x6b, 0x58, 0xcc,
+        0xe0, 0x54, 0x75, 0x24, 0xdb, 0x6f, 0x0b, 0xde
+    },
+    {
+        0x67, 0x55, 0x27, 0xc2, 0xa0, 0xe8, 0xde, 0x03,
+        0x43, 0xd1, 0x2d, 0x7d, 0xc0, 0x37, 0x7b, 0xbc,
+        0xe9, 0x90, 0x1d, 0xec, 0x42, 0x6e, 0x81, 0xb5,
+        0x2a, 0xb1, 0x49, 0x07, 0x72, 0x07, 0x80, 0xb6,
+        0x8f, 0x3f, 0x1d, 0x02, 0xd4, 0x32, 0xbc, 0x46
+    },
+    {
+        0x50, 0x0c, 0xcc, 0xc8, 0x94, 0xe3, 0xc9, 0xe8,
+        0x5b, 0xed, 0x06, 0xf2, 0x8f, 0x71, 0x24, 0x8d,
+        0x3b, 0x03, 0xa0, 0xf9, 0x30, 0xaf, 0xd5, 0x12,
+        0x11, 0x2e, 0xf0, 0x93, 0xaa, 0x5c, 0x69, 0x8b,
+        0x00, 0xc8, 0x35, 0x63, 0x40, 0xa3, 0x47, 0xf0
+    }
+};
+#endif
+
+#endif /* !ASCON_SMALL */
+
+/**
+ * \brief Initializes an ASCON state for Ascon-XOF128 or Ascon-CXOF128.
+ *
+ * \param state The ASCON state to initialize, which is left acquired.
+ * \param iv_word The initialization vector as a 64-bit word.
+ * \param index Index of the pre-computed state for \a iv_word.
+ */
+static void ascon_xof128_init_state
+    (ascon_state_t *state, uint64_t iv_word, unsigned index)
+{
+#if defined(ASCON_SMALL)
+    /* Compute the initial state at runtime to avoid storing it */
+    uint8_t iv[8];
+    (void)index;
+    ascon_init(state);
+    be_store_word64(iv, iv_word);
+    ascon_overwrite_bytes(state, iv, 0, 8);
+    ascon_permute(state, 0);
+#else
+    (void)iv_word;
+    ascon_init(state);
+#if defined(ASCON_BACKEND_SLICED64)
+    memcpy(state->S, ascon_xof128_iv[index], sizeof(ascon_xof128_iv[0]));
+#elif defined(ASCON_BACKEND_SLICED32)
+    memcpy(state->W, ascon_xof128_iv[index], sizeof(ascon_xof128_iv[0]));
+#elif defined(ASCON_BACKEND_DIRECT_XOR)
+    memcpy(state->B, ascon_xof128_iv[index], sizeof(ascon_xof128_iv[0]));
+#else
+    ascon_overwrite_bytes
+        (state, ascon_xof128_iv[index], 0, sizeof(ascon_xof128_iv[0]));
+#endif
+#endif
+}
+
+/**
+ * \brief Starts an Ascon-CXOF128 state and absorbs the customization string.
+ *
+ * \param state The ASCON state to initialize, which is left acquired.
+ * \param custom Points to the customization string.
+ * \param customlen Length of the customization string, which has already
+ * been checked against ASCON_CXOF128_MAX_CUSTOM_SIZE.
+ */
+static void ascon_cxof128_start
+    (ascon_state_t *state, const unsigned char *custom, size_t customlen)
+{
+    unsigned char block[8];
+    unsigned temp;
+
+#if !defined(ASCON_SMALL)
+    /* The empty customization string is pre-computed */
+    if (customlen == 0) {
+        ascon_xof128_init_state
+            (state, ASCON_CXOF128_IV, ASCON_CXOF128_EMPTY_INDEX);
+        return;
+    }
+#endif
+
+    /* Absorb the length of the customization string in bits */
+    ascon_xof128_init_state(state, ASCON_CXOF128_IV, ASCON_CXOF128_INDEX);
+    le_store_word64(block, ((uint64_t)customlen) * 8U);
+    ascon_le_absorb_8(state, block, 0);
+    ascon_permute(state, 0);
+
+    /* Absorb the customization string and pad it out to a full block */
+    while (customlen >= ASCON_XOF128_RATE) {
+        ascon_le_absorb_8(state, custom, 0);
+        ascon_permute(state, 0);
+        custom += ASCON_XOF128_RATE;
+        customlen -= ASCON_XOF128_RATE;
+    }
+    temp = (unsigned)customlen;
+    if (temp > 0)
+        ascon_le_absorb_partial(state, custom, 0, temp);
+    ascon_le_pad(state, temp);
+    ascon_permute(state, 0);
+}
+
+void ascon_xof128
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen)
+{
+    ascon_xof128_state_t state;
+    ascon_latency_begin();
+    ascon_xof128_init(&state);
+    ascon_xof128_absorb(&state, in, inlen);
+    ascon_xof128_squeeze(&state, out, outlen);
+    ascon_xof128_free(&state);
+    ascon_latency_end(ASCON_LATENCY_HASH);
+}
+
+void ascon_xof128_init(ascon_xof128_state_t *state)
+{
+    ascon_xof128_init_state
+        (&(state->state), ASCON_XOF128_IV, ASCON_XOF128_INDEX);
+    ascon_release(&(state->state));
+    state->count = 0;
+    state->mode = 0;
+}
+
+void ascon_xof128_free(ascon_xof128_state_t *state)
+{
+    if (state) {
+        ascon_acquire(&(state->state));
+        ascon_free(&(state->state));
+        state->count = 0;
+        state->mode = 0;
+    }
+}
+
+void ascon_xof128_absorb
+    (ascon_xof128_state_t *state, const unsigned char *in, size_t inlen)
+{
+    unsigned temp;
+
+    ascon_stats_bytes(inlen, 0);
+
+    /* Acquire access to shared hardware if necessary */
+    ascon_acquire(&(state->state));
+
+    /* If we were squeezing output, then go back to the absorb phase */
+    if (state->mode) {
+        state->mode = 0;
+        state->count = 0;
+        ascon_permute(&(state->state), 0);
+    }
+
+    /* Handle the partial left-over block from last time */
+    if (state->count) {
+        temp = ASCON_XOF128_RATE - state->count;
+        if (temp > inlen) {
+            temp = (unsigned)inlen;
+            ascon_le_absorb_partial(&(state->state), in, state->count, temp);
+            state->count += temp;
+            ascon_release(&(state->state));
+            return;
+        }
+        ascon_le_absorb_partial(&(state->state), in, state->count, temp);
+        state->count = 0;
+        in += temp;
+        inlen -= temp;
+        ascon_permute(&(state->state), 0);
+    }
+
+    /* Process full blocks that are aligned at state->count == 0 */
+    while (inlen >= ASCON_XOF128_RATE) {
+        ascon_le_absorb_8(&(state->state), in, 0);
+        in += ASCON_XOF128_RATE;
+        inlen -= ASCON_XOF128_RATE;
+        ascon_permute(&(state->state), 0);
+    }
+
+    /* Process the left-over block at the end of the input */
+    temp = (unsigned)inlen;
+    if (temp > 0)
+        ascon_le_absorb_partial(&(state->state), in, 0, temp);
+    state->count = temp;
+
+    /* Release access to the shared hardware */
+    ascon_release(&(state->state));
+}
+
+void ascon_xof128_squeeze
+    (ascon_xof128_state_t *state, unsigned char *out, size_t outlen)
+{
+    unsigned temp;
+
+    ascon_stats_bytes(0, outlen);
+
+    /* Acquire access to shared hardware if necessary */
+    ascon_acquire(&(state->state));
+
+    /* Pad the final input block if we were still in the absorb phase */
+    if (!state->mode) {
+        ascon_le_pad(&(state->state), state->count);
+        state->count = 0;
+        state->mode = 1;
+    }
+
+    /* Handle left-over partial blocks from last time */
+    if (state->count) {
+        temp = ASCON_XOF128_RATE - state->count;
+        if (temp > outlen) {
+            temp = (unsigned)outlen;
+            ascon_le_squeeze_partial
+                (&(state->state), out, state->count, temp);
+            state->count += temp;
+            ascon_release(&(state->state));
+            return;
+        }
+        ascon_le_squeeze_partial(&(state->state), out, state->count, temp);
+        out += temp;
+        outlen -= temp;
+        state->count = 0;
+    }
+
+    /* Handle full blocks, squeezing directly into the caller's buffer */
+    while (outlen >= ASCON_XOF128_RATE) {
+        ascon_permute(&(state->state), 0);
+        ascon_le_squeeze_8(&(state->state), out, 0);
+        out += ASCON_XOF128_RATE;
+        outlen -= ASCON_XOF128_RATE;
+    }
+
+    /* Handle the left-over block */
+    if (outlen > 0) {
+        temp = (unsigned)outlen;
+        ascon_permute(&(state->state), 0);
+        ascon_le_squeeze_partial(&(state->state), out, 0, temp);
+        state->count = temp;
+    }
+
+    /* Release access to the shared hardware */
+    ascon_release(&(state->state));
+}
+
+void ascon_xof128_copy
+    (ascon_xof128_state_t *dest, const ascon_xof128_state_t *src)
+{
+    if (dest != src) {
+        ascon_init(&(dest->state));
+        ascon_copy(&(dest->state), &(src->state));
+        ascon_release(&(dest->state));
+        dest->count = src->count;
+        dest->mode = src->mode;
+    }
+}
+
+void ascon_xof128_reset
+    (ascon_xof128_state_t *state, const ascon_xof128_state_t *tmpl)
+{
+    if (state != tmpl) {
+        ascon_acquire(&(state->state));
+        ascon_copy(&(state->state), &(tmpl->state));
+        ascon_release(&(state->state));
+        state->count = tmpl->count;
+        state->mode = tmpl->mode;
+    }
+}
+
+int ascon_cxof128
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const unsigned char *custom, size_t customlen)
+{
+    ascon_xof128_state_t state;
+    if (ascon_cxof128_init(&state, custom, customlen) < 0)
+        return -1;
+    ascon_xof128_absorb(&state, in, inlen);
+    ascon_xof128_squeeze(&state, out, outlen);
+    ascon_xof128_free(&state);
+    return 0;
+}
+
+int ascon_cxof128_init
+    (ascon_xof128_state_t *state,
+     const unsigned char *custom, size_t customlen)
+{
+    if (customlen > ASCON_CXOF128_MAX_CUSTOM_SIZE)
+        return -1;
+    ascon_cxof128_start(&(state->state), custom, customlen);
+    ascon_release(&(state->state));
+    state->count = 0;
+    state->mode = 0;
+    return 0;
+}
+
+int ascon_cxof128_init_custom
+    (ascon_cxof128_custom_t *pc,
+     const unsigned char *custom, size_t customlen)
+{
+    if (customlen > ASCON_CXOF128_MAX_CUSTOM_SIZE)
+        return -1;
+    ascon_cxof128_start(&(pc->state), custom, customlen);
+    ascon_release(&(pc->state));
+    return 0;
+}
+
+void ascon_cxof128_init_from_custom
+    (ascon_xof128_state_t *state, const ascon_cxof128_custom_t *pc)
+{
+    ascon_init(&(state->state));
+    ascon_copy(&(state->state), &(pc->state));
+    ascon_release(&(state->state));
+    state->count = 0;
+    state->mode = 0;
+}
+
+void ascon_cxof128_free_custom(ascon_cxof128_custom_t *pc)
+{
+    if (pc) {
+        ascon_acquire(&(pc->state));
+        ascon_free(&(pc->state));
+    }
+}
+
+#endif /* ASCON_ENABLE_HASH */
@@ -20,20 +20,55 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "ascon-config.h"
+#include "ascon-latency.h"
 #include "ascon-xof.h"
 #include "utility/ascon-util-snp.h"
+#include "utility/ascon-bulk.h"
 
 void ascon_xofa(unsigned char *out, const unsigned char *in, size_t inlen)
 {
     ascon_xofa_state_t state;
-    ascon_xofa_init(&state);
-    ascon_xofa_absorb(&state, in, inlen);
-    ascon_xofa_squeeze(&state, out, ASCON_HASH_SIZE);
-    ascon_xofa_free(&state);
+    ascon_xofa_ex(out, in, inlen, &state);
+}
+
+void ascon_xofa_ex
+    (unsigned char *out, const unsigned char *in, size_t inlen,
+     ascon_xofa_state_t *workspace)
+{
+    ascon_latency_begin();
+    ascon_xofa_init(workspace);
+    ascon_xofa_absorb(workspace, in, inlen);
+    ascon_xofa_squeeze(workspace, out, ASCON_HASH_SIZE);
+    ascon_xofa_free(workspace);
+    ascon_latency_end(ASCON_LATENCY_HASH);
+}
+
+/**
+ * \brief Initializes an ASCON-XOFA state by running the permutation
+ * on a specific initialization vector.
+ *
+ * \param state The ASCON-XOFA state to initialize.
+ * \param iv_word The initialization vector as a 64-bit word.
+ */
+static void ascon_xofa_init_iv(ascon_xofa_state_t *state, uint64_t iv_word)
+{
+    uint8_t iv[8];
+    ascon_init(&(state->state));
+    be_store_word64(iv, iv_word);
+    ascon_overwrite_bytes(&(state->state), iv, 0, 8);
+    ascon_permute(&(state->state), 0);
+    ascon_release(&(state->state));
+    state->count = 0;
+    state->mode = 0;
 }
 
 void ascon_xofa_init(ascon_xofa_state_t *state)
 {
+#if defined(ASCON_SMALL)
+    /* Compute the IV at runtime to avoid storing it */
+    ascon_xofa_init_iv(state, 0x00400c0400000000ULL);
+#else
     /* IV for ASCON-XOFA after processing it with the permutation */
 #if defined(ASCON_BACKEND_SLICED64)
     static uint64_t const iv[5] = {
@@ -67,8 +102,105 @@ void ascon_xofa_init(ascon_xofa_state_t *state)
 #endif
     state->count = 0;
     state->mode = 0;
+#endif
 }
 
+#if !defined(ASCON_SMALL)
+
+/* Pre-computed IV's for commonly-used fixed output lengths of
+ * 16, 24, and 64 bytes, after processing them with the permutation */
+#if defined(ASCON_BACKEND_SLICED64)
+static uint64_t const ascon_xofa_fixed_iv[3][5] = {
+    {
+        0xedac9f6f7f1b7f03ULL, 0x484cf573c4c300abULL,
+        0xab31f5aad93de0faULL, 0xe4fce06919bf8c3cULL,
+        0x5b1b180c77ecc2f9ULL
+    },
+    {
+        0x11c8c018693b7547ULL, 0xca63ce8d853c8638ULL,
+        0x7bf32f84d14a40b4ULL, 0xf97b060249f143faULL,
+        0x5a9d23804ee1dc55ULL
+    },
+    {
+        0x58d17b28149e2088ULL, 0x42d0faadfd137e08ULL,
+        0x09c1fdc9aa1f828bULL, 0xbfd399b9c0052f58ULL,
+        0xe3824244c493800bULL
+    }
+};
+#elif defined(ASCON_BACKEND_SLICED32)
+static uint32_t const ascon_xofa_fixed_iv[3][10] = {
+    {
+        0xb27bf5f1, 0xeeb77371, 0x8afda901, 0x22c5890f,
+        0x15f0d78c, 0xf4cfa6cf, 0xae895726, 0xcec62fa6,
+        0xd542fa8d, 0x33225e9e
+    },
+    {
+        0x588495fb, 0x0a826741, 0x89a33624, 0xb5ba8696,
+        0xdd32d886, 0x7d78830c, 0xdd209d9c, 0xe7112c1f,
+        0xc710a9ef, 0x3a583ca0
+    },
+    {
+        0xcdd06600, 0x28760b4a, 0x8cc3f5e0, 0x18fee172,
+        0x19f90701, 0x28eaf39b, 0x7d55833c, 0xf9ae8072,
+        0x908aa501, 0xd9108983
+    }
+};
+#else
+static uint8_t const ascon_xofa_fixed_iv[3][40] = {
+    {
+        0xed, 0xac, 0x9f, 0x6f, 0x7f, 0x1b, 0x7f, 0x03,
+        0x48, 0x4c, 0xf5, 0x73, 0xc4, 0xc3, 0x00, 0xab,
+        0xab, 0x31, 0xf5, 0xaa, 0xd9, 0x3d, 0xe0, 0xfa,
+        0xe4, 0xfc, 0xe0, 0x69, 0x19, 0xbf, 0x8c, 0x3c,
+        0x5b, 0x1b, 0x18, 0x0c, 0x77, 0xec, 0xc2, 0xf9
+    },
+    {
+        0x11, 0xc8, 0xc0, 0x18, 0x69, 0x3b, 0x75, 0x47,
+        0xca, 0x63, 0xce, 0x8d, 0x85, 0x3c, 0x86, 0x38,
+        0x7b, 0xf3, 0x2f, 0x84, 0xd1, 0x4a, 0x40, 0xb4,
+        0xf9, 0x7b, 0x06, 0x02, 0x49, 0xf1, 0x43, 0xfa,
+        0x5a, 0x9d, 0x23, 0x80, 0x4e, 0xe1, 0xdc, 0x55
+    },
+    {
+        0x58, 0xd1, 0x7b, 0x28, 0x14, 0x9e, 0x20, 0x88,
+        0x42, 0xd0, 0xfa, 0xad, 0xfd, 0x13, 0x7e, 0x08,
+        0x09, 0xc1, 0xfd, 0xc9, 0xaa, 0x1f, 0x82, 0x8b,
+        0xbf, 0xd3, 0x99, 0xb9, 0xc0, 0x05, 0x2f, 0x58,
+        0xe3, 0x82, 0x42, 0x44, 0xc4, 0x93, 0x80, 0x0b
+    }
+};
+#endif
+
+/**
+ * \brief Initializes an ASCON-XOFA state from one of the pre-computed IV's.
+ *
+ * \param state The ASCON-XOFA state to initialize.
+ * \param index Index of the pre-computed IV to use.
+ */
+static void ascon_xofa_init_fixed_iv(ascon_xofa_state_t *state, unsigned index)
+{
+#if defined(ASCON_BACKEND_SLICED64)
+    memcpy(state->state.S, ascon_xofa_fixed_iv[index],
+           sizeof(ascon_xofa_fixed_iv[0]));
+#elif defined(ASCON_BACKEND_SLICED32)
+    memcpy(state->state.W, ascon_xofa_fixed_iv[index],
+           sizeof(ascon_xofa_fixed_iv[0]));
+#elif defined(ASCON_BACKEND_DIRECT_XOR)
+    memcpy(state->state.B, ascon_xofa_fixed_iv[index],
+           sizeof(ascon_xofa_fixed_iv[0]));
+#else
+    ascon_init(&(state->state));
+    ascon_overwrite_bytes
+        (&(state->state), ascon_xofa_fixed_iv[index], 0,
+         sizeof(ascon_xofa_fixed_iv[0]));
+    ascon_release(&(state->state));
+#endif
+    state->count = 0;
+    state->mode = 0;
+}
+
+#endif /* !ASCON_SMALL */
+
 void ascon_xofa_init_fixed(ascon_xofa_state_t *state, size_t outlen)
 {
 #if !defined(__SIZEOF_SIZE_T__) || __SIZEOF_SIZE_T__ >= 4
@@ -78,7 +210,9 @@ void ascon_xofa_init_fixed(ascon_xofa_state_t *state, size_t outlen)
     if (outlen == 0U) {
         /* Output length of zero is equivalent to regular XOF */
         ascon_xofa_init(state);
-    } else if (outlen == 32U) {
+    }
+#if !defined(ASCON_SMALL)
+    else if (outlen == 32U) {
         /* Output length of 32 is equivalent to ASCON-HASHA */
 #if defined(ASCON_BACKEND_SLICED64)
         static uint64_t const iv[5] = {
@@ -112,17 +246,18 @@ void ascon_xofa_init_fixed(ascon_xofa_state_t *state, size_t outlen)
 #endif
         state->count = 0;
         state->mode = 0;
-    } else {
+    } else if (outlen == 16U) {
+        ascon_xofa_init_fixed_iv(state, 0);
+    } else if (outlen == 24U) {
+        ascon_xofa_init_fixed_iv(state, 1);
+    } else if (outlen == 64U) {
+        ascon_xofa_init_fixed_iv(state, 2);
+    }
+#endif
+    else {
         /* For all other lengths, we need to run the permutation
          * to get the initial block for the XOF process */
-        uint8_t iv[8];
-        ascon_init(&(state->state));
-        be_store_word64(iv, 0x00400c0400000000ULL | (outlen * 8UL));
-        ascon_overwrite_bytes(&(state->state), iv, 0, 8);
-        ascon_permute(&(state->state), 0);
-        ascon_release(&(state->state));
-        state->count = 0;
-        state->mode = 0;
+        ascon_xofa_init_iv(state, 0x00400c0400000000ULL | (outlen * 8UL));
     }
 }
 
@@ -163,6 +298,8 @@ void ascon_xofa_absorb
 {
     unsigned temp;
 
+    ascon_stats_bytes(inlen, 0);
+
     /* Acquire access to shared hardware if necessary */
     ascon_acquire(&(state->state));
 
@@ -213,6 +350,8 @@ void ascon_xofa_squeeze
 {
     unsigned temp;
 
+    ascon_stats_bytes(0, outlen);
+
     /* Acquire access to shared hardware if necessary */
     ascon_acquire(&(state->state));
 
@@ -241,12 +380,18 @@ void ascon_xofa_squeeze
         ascon_permute(&(state->state), 4);
     }
 
-    /* Handle full blocks */
-    while (outlen >= ASCON_XOF_RATE) {
+    /* Handle full blocks, squeezing directly into the caller's buffer.
+     * The state is permuted after each block rather than before, so the
+     * bulk operation handles the blocks after the first one. */
+    if (outlen >= ASCON_XOF_RATE) {
+        size_t blocks = outlen / ASCON_XOF_RATE;
         ascon_squeeze_8(&(state->state), out, 0);
+        ascon_squeeze_blocks
+            (&(state->state), out + ASCON_XOF_RATE, blocks - 1,
+             ASCON_XOF_RATE, 4);
         ascon_permute(&(state->state), 4);
-        out += ASCON_XOF_RATE;
-        outlen -= ASCON_XOF_RATE;
+        out += blocks * ASCON_XOF_RATE;
+        outlen -= blocks * ASCON_XOF_RATE;
     }
 
     /* Handle the left-over block */
@@ -294,3 +439,43 @@ void ascon_xofa_copy(ascon_xofa_state_t *dest, const ascon_xofa_state_t *src)
         dest->mode = src->mode;
     }
 }
+
+void ascon_xofa_reset
+    (ascon_xofa_state_t *state, const ascon_xofa_state_t *tmpl)
+{
+    if (state != tmpl) {
+        ascon_acquire(&(state->state));
+        ascon_copy(&(state->state), &(tmpl->state));
+        ascon_release(&(state->state));
+        state->count = tmpl->count;
+        state->mode = tmpl->mode;
+    }
+}
+
+/* Identifies an ASCON-XOFA state in a serialized snapshot */
+#define ASCON_XOFA_SNAPSHOT_ID 0x02
+
+void ascon_xofa_snapshot(ascon_xofa_state_t *state, unsigned char *snapshot)
+{
+    snapshot[0] = ASCON_XOFA_SNAPSHOT_ID;
+    ascon_acquire(&(state->state));
+    ascon_extract_bytes(&(state->state), snapshot + 1, 0, 40);
+    ascon_release(&(state->state));
+    snapshot[41] = state->count;
+    snapshot[42] = state->mode;
+}
+
+int ascon_xofa_restore
+    (ascon_xofa_state_t *state, const unsigned char *snapshot)
+{
+    if (snapshot[0] != ASCON_XOFA_SNAPSHOT_ID ||
+            snapshot[41] >= ASCON_XOF_RATE || snapshot[42] > 1) {
+        return -1;
+    }
+    ascon_init(&(state->state));
+    ascon_overwrite_bytes(&(state->state), snapshot + 1, 0, 40);
+    ascon_release(&(state->state));
+    state->count = snapshot[41];
+    state->mode = snapshot[42];
+    return 0;
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the underlying AEAD variant.
+ *
+ * AEAD_ALG_NAME        Name of the AEAD algorithm; e.g. ascon128_aead
+ * AEAD_IV              Initialization vector for the AEAD algorithm.
+ * AEAD_RATE            Number of bytes in the rate, 8 or 16.
+ * AEAD_FIRST_ROUND     First round of the permutation for each block.
+ *
+ * The key, nonce, and tag are assumed to be 16 bytes in size.
+ */
+#if defined(AEAD_ALG_NAME)
+
+#include "ascon-aead-common.h"
+#include "ascon-multi.h"
+#include "ascon-util-snp.h"
+#include "ascon-x64.h"
+
+#define AEAD_CONCAT_INNER(name,suffix) name##suffix
+#define AEAD_CONCAT(name,suffix) AEAD_CONCAT_INNER(name,suffix)
+
+#if AEAD_RATE == 16
+#define AEAD_ABSORB(state, data) ascon_absorb_16((state), (data), 0)
+#define AEAD_ENCRYPT(state, dest, src) ascon_encrypt_16((state), (dest), (src), 0)
+#define AEAD_DECRYPT(state, dest, src) ascon_decrypt_16((state), (dest), (src), 0)
+#else
+#define AEAD_ABSORB(state, data) ascon_absorb_8((state), (data), 0)
+#define AEAD_ENCRYPT(state, dest, src) ascon_encrypt_8((state), (dest), (src), 0)
+#define AEAD_DECRYPT(state, dest, src) ascon_decrypt_8((state), (dest), (src), 0)
+#endif
+
+/* Phases that a message goes through in a batch */
+#define AEAD_PHASE_INIT     0   /* Initialization permutation is done */
+#define AEAD_PHASE_AD       1   /* Absorbing associated data */
+#define AEAD_PHASE_AD_LAST  2   /* Last associated data block is done */
+#define AEAD_PHASE_TEXT     3   /* Encrypting or decrypting the payload */
+#define AEAD_PHASE_FINAL    4   /* Finalization permutation is done */
+
+/* Information about a message that is being processed in a lane */
+typedef struct
+{
+    ascon_state_t state;
+    ascon_aead_batch_t *msg;
+    const unsigned char *src;
+    unsigned char *dest;
+    size_t posn;
+    size_t len;
+    int phase;
+    uint8_t first_round;
+
+} AEAD_CONCAT(AEAD_ALG_NAME,_lane_t);
+
+/**
+ * \brief Starts processing a new message in a lane.
+ *
+ * \param lane The lane to use.
+ * \param msg The message to be processed.
+ * \param len Length of the payload to encrypt or decrypt.
+ */
+static void AEAD_CONCAT(AEAD_ALG_NAME,_lane_start)
+    (AEAD_CONCAT(AEAD_ALG_NAME,_lane_t) *lane,
+     ascon_aead_batch_t *msg, size_t len)
+{
+    ascon_init(&(lane->state));
+    ascon_overwrite_bytes(&(lane->state), AEAD_IV, 0, 8);
+    ascon_overwrite_bytes(&(lane->state), msg->k, 8, 16);
+    ascon_overwrite_bytes(&(lane->state), msg->npub, 24, 16);
+    lane->msg = msg;
+    lane->src = msg->in;
+    lane->dest = msg->out;
+    lane->posn = 0;
+    lane->len = len;
+    lane->phase = AEAD_PHASE_INIT;
+    lane->first_round = 0;
+}
+
+/**
+ * \brief Advances a lane to the point where it next needs a permutation.
+ *
+ * \param lane The lane to advance.
+ * \param decrypt Non-zero for decryption, zero for encryption.
+ *
+ * \return Zero if the lane needs a permutation, or 1 if the
+ * message has been fully processed.
+ */
+static int AEAD_CONCAT(AEAD_ALG_NAME,_lane_step)
+    (AEAD_CONCAT(AEAD_ALG_NAME,_lane_t) *lane, int decrypt)
+{
+    ascon_state_t *state = &(lane->state);
+    ascon_aead_batch_t *msg = lane->msg;
+    size_t remaining;
+    switch (lane->phase) {
+    case AEAD_PHASE_INIT:
+        ascon_absorb_16(state, msg->k, 24);
+        lane->first_round = AEAD_FIRST_ROUND;
+        if (msg->adlen > 0) {
+            lane->phase = AEAD_PHASE_AD;
+            break;
+        }
+        /* Fall through */
+
+    case AEAD_PHASE_AD_LAST:
+        ascon_separator(state);
+        lane->phase = AEAD_PHASE_TEXT;
+        break;
+    }
+    if (lane->phase == AEAD_PHASE_AD) {
+        /* Absorb the next block of associated data */
+        remaining = msg->adlen - lane->posn;
+        if (remaining >= AEAD_RATE) {
+            AEAD_ABSORB(state, msg->ad + lane->posn);
+            lane->posn += AEAD_RATE;
+        } else {
+            if (remaining > 0)
+                ascon_absorb_partial(state, msg->ad + lane->posn, 0, remaining);
+            ascon_pad(state, remaining);
+            lane->posn = 0;
+            lane->phase = AEAD_PHASE_AD_LAST;
+        }
+        return 0;
+    } else if (lane->phase == AEAD_PHASE_TEXT) {
+        /* Encrypt or decrypt the next block of the payload */
+        remaining = lane->len - lane->posn;
+        if (remaining >= AEAD_RATE) {
+            if (decrypt)
+                AEAD_DECRYPT(state, lane->dest, lane->src);
+            else
+                AEAD_ENCRYPT(state, lane->dest, lane->src);
+            lane->src += AEAD_RATE;
+            lane->dest += AEAD_RATE;
+            lane->posn += AEAD_RATE;
+            return 0;
+        }
+        if (remaining > 0) {
+            if (decrypt) {
+                ascon_decrypt_partial
+                    (state, lane->dest, lane->src, 0, remaining);
+            } else {
+                ascon_encrypt_partial
+                    (state, lane->dest, lane->src, 0, remaining);
+            }
+        }
+        ascon_pad(state, remaining);
+
+        /* Start the finalization process */
+        ascon_absorb_16(state, msg->k, AEAD_RATE);
+        lane->first_round = 0;
+        lane->phase = AEAD_PHASE_FINAL;
+        return 0;
+    }
+
+    /* Finalization permutation is done: generate or check the tag */
+    ascon_absorb_16(state, msg->k, 24);
+    if (decrypt) {
+        unsigned char tag[16];
+        ascon_squeeze_16(state, tag, 24);
+        msg->outlen = lane->len;
+        msg->result = ascon_aead_check_tag
+            (msg->out, lane->len, tag, msg->in + lane->len, 16);
+        ascon_clean(tag, sizeof(tag));
+    } else {
+        ascon_squeeze_16(state, msg->out + lane->len, 24);
+        msg->outlen = lane->len + 16;
+        msg->result = 0;
+    }
+    ascon_free(state);
+    return 1;
+}
+
+/**
+ * \brief Processes a batch of messages for encryption or decryption
+ * with the multi-state permutations.
+ *
+ * \param msgs Points to the messages.
+ * \param count Number of messages.
+ * \param decrypt Non-zero for decryption, zero for encryption.
+ *
+ * \return 0 if all messages were processed successfully, or -1 if
+ * at least one message failed.
+ */
+static int AEAD_CONCAT(AEAD_ALG_NAME,_batch_lanes)
+    (ascon_aead_batch_t *msgs, size_t count, int decrypt)
+{
+    AEAD_CONCAT(AEAD_ALG_NAME,_lane_t) lanes[ASCON_MULTI_LANES];
+    AEAD_CONCAT(AEAD_ALG_NAME,_lane_t) *active[ASCON_MULTI_LANES];
+    ascon_state_t *init[ASCON_MULTI_LANES];
+    ascon_state_t *block[ASCON_MULTI_LANES];
+    unsigned num_active = 0;
+    unsigned num_init, num_block, index;
+    int result = 0;
+    size_t len;
+
+    /* Lanes that are not in use are kept at the end of the active list */
+    for (index = 0; index < ASCON_MULTI_LANES; ++index)
+        active[index] = &(lanes[index]);
+
+    for (;;) {
+        /* Fill up any empty lanes with new messages */
+        while (num_active < ASCON_MULTI_LANES && count > 0) {
+            if (decrypt) {
+                /* Reject messages that are too short to contain a tag */
+                if (msgs->inlen < 16) {
+                    msgs->outlen = 0;
+                    msgs->result = -1;
+                    result = -1;
+                    ++msgs;
+                    --count;
+                    continue;
+                }
+                len = msgs->inlen - 16;
+            } else {
+                len = msgs->inlen;
+            }
+            AEAD_CONCAT(AEAD_ALG_NAME,_lane_start)
+                (active[num_active++], msgs, len);
+            ++msgs;
+            --count;
+        }
+        if (!num_active)
+            break;
+
+        /* Permute all active lanes, grouped by the number of rounds */
+        num_init = 0;
+        num_block = 0;
+        for (index = 0; index < num_active; ++index) {
+            if (active[index]->first_round == 0)
+                init[num_init++] = &(active[index]->state);
+            else
+                block[num_block++] = &(active[index]->state);
+        }
+        ascon_permute_multi(init, num_init, 0);
+        ascon_permute_multi(block, num_block, AEAD_FIRST_ROUND);
+
+        /* Advance all lanes to the next permutation and retire the
+         * lanes whose messages have been fully processed */
+        index = 0;
+        while (index < num_active) {
+            AEAD_CONCAT(AEAD_ALG_NAME,_lane_t) *lane = active[index];
+            if (AEAD_CONCAT(AEAD_ALG_NAME,_lane_step)(lane, decrypt)) {
+                result |= lane->msg->result;
+                active[index] = active[--num_active];
+                active[num_active] = lane;
+            } else {
+                ++index;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * \brief Processes a batch of messages for encryption or decryption.
+ *
+ * \param msgs Points to the messages.
+ * \param count Number of messages.
+ * \param decrypt Non-zero for decryption, zero for encryption.
+ *
+ * \return 0 if all messages were processed successfully, or -1 if
+ * at least one message failed.
+ */
+static int AEAD_CONCAT(AEAD_ALG_NAME,_batch)
+    (ascon_aead_batch_t *msgs, size_t count, int decrypt)
+{
+#if defined(ASCON_X64_LANES)
+    size_t done = 0;
+    size_t posn = 0;
+    size_t run;
+    int result = 0;
+
+    /* Groups of messages with the same lengths go to the bitsliced engine
+     * and the messages in between are processed a few lanes at a time.
+     * Decryption inputs that are too short for a tag are left to the
+     * lanes, which reject them. */
+    while ((count - posn) >= ASCON_X64_MIN_BATCH) {
+        run = 1;
+        if (!decrypt || msgs[posn].inlen >= 16) {
+            while (run < ASCON_X64_LANES && (posn + run) < count &&
+                   msgs[posn + run].inlen == msgs[posn].inlen &&
+                   msgs[posn + run].adlen == msgs[posn].adlen) {
+                ++run;
+            }
+        }
+        if (run < ASCON_X64_MIN_BATCH) {
+            posn += run;
+            continue;
+        }
+        if (done < posn) {
+            result |= AEAD_CONCAT(AEAD_ALG_NAME,_batch_lanes)
+                (msgs + done, posn - done, decrypt);
+        }
+        result |= ascon_x64_aead(msgs + posn, (unsigned)run, AEAD_IV,
+                                 AEAD_RATE, AEAD_FIRST_ROUND, decrypt);
+        posn += run;
+        done = posn;
+    }
+    if (done < count) {
+        result |= AEAD_CONCAT(AEAD_ALG_NAME,_batch_lanes)
+            (msgs + done, count - done, decrypt);
+    }
+    return result;
+#else
+    return AEAD_CONCAT(AEAD_ALG_NAME,_batch_lanes)(msgs, count, decrypt);
+#endif
+}
+
+void AEAD_CONCAT(AEAD_ALG_NAME,_encrypt_batch)
+    (ascon_aead_batch_t *msgs, size_t count)
+{
+    AEAD_CONCAT(AEAD_ALG_NAME,_batch)(msgs, count, 0);
+}
+
+int AEAD_CONCAT(AEAD_ALG_NAME,_decrypt_batch)
+    (ascon_aead_batch_t *msgs, size_t count)
+{
+    return AEAD_CONCAT(AEAD_ALG_NAME,_batch)(msgs, count, 1);
+}
+
+#endif /* AEAD_ALG_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the AEAD algorithm */
+#undef AEAD_ALG_NAME
+#undef AEAD_IV
+#undef AEAD_RATE
+#undef AEAD_FIRST_ROUND
+#undef AEAD_CONCAT_INNER
+#undef AEAD_CONCAT
+#undef AEAD_ABSORB
+#undef AEAD_ENCRYPT
+#undef AEAD_DECRYPT
+#undef AEAD_PHASE_INIT
+#undef AEAD_PHASE_AD
+#undef AEAD_PHASE_AD_LAST
+#undef AEAD_PHASE_TEXT
+#undef AEAD_PHASE_FINAL
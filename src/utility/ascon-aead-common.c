@@ -21,6 +21,7 @@
  */
 
 #include "ascon-aead-common.h"
+#include "ascon-bulk.h"
 #include "ascon-util-snp.h"
 
 int ascon_aead_check_tag
@@ -45,15 +46,16 @@ int ascon_aead_check_tag
     return ~accum;
 }
 
-void ascon_aead_absorb_8
+ASCON_HOT void ascon_aead_absorb_8
     (ascon_state_t *state, const unsigned char *data,
      size_t len, uint8_t first_round, int last_permute)
 {
-    while (len >= 8) {
-        ascon_absorb_8(state, data, 0);
-        ascon_permute(state, first_round);
-        data += 8;
-        len -= 8;
+    ascon_stats_bytes(len, 0);
+    if (len >= 8) {
+        size_t blocks = len / 8;
+        ascon_absorb_blocks(state, data, blocks, 8, first_round);
+        data += blocks * 8;
+        len -= blocks * 8;
     }
     if (len > 0)
         ascon_absorb_partial(state, data, 0, len);
@@ -62,15 +64,16 @@ void ascon_aead_absorb_8
         ascon_permute(state, first_round);
 }
 
-void ascon_aead_absorb_16
+ASCON_HOT void ascon_aead_absorb_16
     (ascon_state_t *state, const unsigned char *data,
      size_t len, uint8_t first_round, int last_permute)
 {
-    while (len >= 16) {
-        ascon_absorb_16(state, data, 0);
-        ascon_permute(state, first_round);
-        data += 16;
-        len -= 16;
+    ascon_stats_bytes(len, 0);
+    if (len >= 16) {
+        size_t blocks = len / 16;
+        ascon_absorb_blocks(state, data, blocks, 16, first_round);
+        data += blocks * 16;
+        len -= blocks * 16;
     }
     if (len > 0)
         ascon_absorb_partial(state, data, 0, len);
@@ -79,11 +82,77 @@ void ascon_aead_absorb_16
         ascon_permute(state, first_round);
 }
 
-unsigned char ascon_aead_encrypt_8
+unsigned char ascon_aead_absorb_stream_8
+    (ascon_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, unsigned char partial)
+{
+    ascon_stats_bytes(len, 0);
+    /* Deal with a partial left-over block from last time */
+    if (partial != 0) {
+        size_t temp = 8U - partial;
+        if (temp > len) {
+            ascon_absorb_partial(state, data, partial, len);
+            return (unsigned char)(partial + len);
+        }
+        ascon_absorb_partial(state, data, partial, temp);
+        ascon_permute(state, first_round);
+        data += temp;
+        len -= temp;
+    }
+
+    /* Deal with full rate blocks */
+    if (len >= 8) {
+        size_t blocks = len / 8;
+        ascon_absorb_blocks(state, data, blocks, 8, first_round);
+        data += blocks * 8;
+        len -= blocks * 8;
+    }
+
+    /* Deal with the partial left-over block on the end */
+    if (len > 0)
+        ascon_absorb_partial(state, data, 0, len);
+    return (unsigned char)len;
+}
+
+unsigned char ascon_aead_absorb_stream_16
+    (ascon_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, unsigned char partial)
+{
+    ascon_stats_bytes(len, 0);
+    /* Deal with a partial left-over block from last time */
+    if (partial != 0) {
+        size_t temp = 16U - partial;
+        if (temp > len) {
+            ascon_absorb_partial(state, data, partial, len);
+            return (unsigned char)(partial + len);
+        }
+        ascon_absorb_partial(state, data, partial, temp);
+        ascon_permute(state, first_round);
+        data += temp;
+        len -= temp;
+    }
+
+    /* Deal with full rate blocks */
+    if (len >= 16) {
+        size_t blocks = len / 16;
+        ascon_absorb_blocks(state, data, blocks, 16, first_round);
+        data += blocks * 16;
+        len -= blocks * 16;
+    }
+
+    /* Deal with the partial left-over block on the end */
+    if (len > 0)
+        ascon_absorb_partial(state, data, 0, len);
+    return (unsigned char)len;
+}
+
+ASCON_HOT unsigned char ascon_aead_encrypt_8
     (ascon_state_t *state, unsigned char *dest,
      const unsigned char *src, size_t len, uint8_t first_round,
      unsigned char partial)
 {
+    ascon_stats_bytes(len, len);
+
     /* Deal with a partial left-over block from last time */
     if (partial != 0) {
         size_t temp = 8U - partial;
@@ -99,12 +168,12 @@ unsigned char ascon_aead_encrypt_8
     }
 
     /* Deal with full rate blocks */
-    while (len >= 8) {
-        ascon_encrypt_8(state, dest, src, 0);
-        ascon_permute(state, first_round);
-        dest += 8;
-        src += 8;
-        len -= 8;
+    if (len >= 8) {
+        size_t blocks = len / 8;
+        ascon_encrypt_blocks(state, dest, src, blocks, 8, first_round);
+        dest += blocks * 8;
+        src += blocks * 8;
+        len -= blocks * 8;
     }
 
     /* Deal with the partial left-over block on the end */
@@ -113,11 +182,13 @@ unsigned char ascon_aead_encrypt_8
     return (unsigned char)len;
 }
 
-unsigned char ascon_aead_encrypt_16
+ASCON_HOT unsigned char ascon_aead_encrypt_16
     (ascon_state_t *state, unsigned char *dest,
      const unsigned char *src, size_t len, uint8_t first_round,
      unsigned char partial)
 {
+    ascon_stats_bytes(len, len);
+
     /* Deal with a partial left-over block from last time */
     if (partial != 0) {
         size_t temp = 16U - partial;
@@ -133,12 +204,12 @@ unsigned char ascon_aead_encrypt_16
     }
 
     /* Deal with full rate blocks */
-    while (len >= 16) {
-        ascon_encrypt_16(state, dest, src, 0);
-        ascon_permute(state, first_round);
-        dest += 16;
-        src += 16;
-        len -= 16;
+    if (len >= 16) {
+        size_t blocks = len / 16;
+        ascon_encrypt_blocks(state, dest, src, blocks, 16, first_round);
+        dest += blocks * 16;
+        src += blocks * 16;
+        len -= blocks * 16;
     }
 
     /* Deal with the partial left-over block on the end */
@@ -147,11 +218,13 @@ unsigned char ascon_aead_encrypt_16
     return (unsigned char)len;
 }
 
-unsigned char ascon_aead_decrypt_8
+ASCON_HOT unsigned char ascon_aead_decrypt_8
     (ascon_state_t *state, unsigned char *dest,
      const unsigned char *src, size_t len, uint8_t first_round,
      unsigned char partial)
 {
+    ascon_stats_bytes(len, len);
+
     /* Deal with a partial left-over block from last time */
     if (partial != 0) {
         size_t temp = 8U - partial;
@@ -167,12 +240,12 @@ unsigned char ascon_aead_decrypt_8
     }
 
     /* Deal with full rate blocks */
-    while (len >= 8) {
-        ascon_decrypt_8(state, dest, src, 0);
-        ascon_permute(state, first_round);
-        dest += 8;
-        src += 8;
-        len -= 8;
+    if (len >= 8) {
+        size_t blocks = len / 8;
+        ascon_decrypt_blocks(state, dest, src, blocks, 8, first_round);
+        dest += blocks * 8;
+        src += blocks * 8;
+        len -= blocks * 8;
     }
 
     /* Deal with the partial left-over block on the end */
@@ -181,11 +254,13 @@ unsigned char ascon_aead_decrypt_8
     return (unsigned char)len;
 }
 
-unsigned char ascon_aead_decrypt_16
+ASCON_HOT unsigned char ascon_aead_decrypt_16
     (ascon_state_t *state, unsigned char *dest,
      const unsigned char *src, size_t len, uint8_t first_round,
      unsigned char partial)
 {
+    ascon_stats_bytes(len, len);
+
     /* Deal with a partial left-over block from last time */
     if (partial != 0) {
         size_t temp = 16U - partial;
@@ -201,12 +276,12 @@ unsigned char ascon_aead_decrypt_16
     }
 
     /* Deal with full rate blocks */
-    while (len >= 16) {
-        ascon_decrypt_16(state, dest, src, 0);
-        ascon_permute(state, first_round);
-        dest += 16;
-        src += 16;
-        len -= 16;
+    if (len >= 16) {
+        size_t blocks = len / 16;
+        ascon_decrypt_blocks(state, dest, src, blocks, 16, first_round);
+        dest += blocks * 16;
+        src += blocks * 16;
+        len -= blocks * 16;
     }
 
     /* Deal with the partial left-over block on the end */
@@ -214,3 +289,21 @@ unsigned char ascon_aead_decrypt_16
         ascon_decrypt_partial(state, dest, src, 0, len);
     return (unsigned char)len;
 }
+
+unsigned char ascon_aead_verify_8
+    (ascon_state_t *state, const unsigned char *src, size_t len,
+     uint8_t first_round)
+{
+    ascon_stats_bytes(len, 0);
+    /* Decryption leaves the ciphertext in the rate, so overwriting the
+     * rate with the ciphertext gives the same state as decryption */
+    while (len >= 8) {
+        ascon_overwrite_bytes(state, src, 0, 8);
+        ascon_permute(state, first_round);
+        src += 8;
+        len -= 8;
+    }
+    if (len > 0)
+        ascon_overwrite_bytes(state, src, 0, (unsigned)len);
+    return (unsigned char)len;
+}
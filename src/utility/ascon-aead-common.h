@@ -76,6 +76,48 @@ void ascon_aead_absorb_16
     (ascon_state_t *state, const unsigned char *data,
      size_t len, uint8_t first_round, int last_permute);
 
+/**
+ * \brief Absorbs a fragment of data into an ASCON state with an 8-byte rate,
+ * continuing on from a previous fragment.
+ *
+ * \param state The state to absorb the data into.
+ * \param data Points to the data to be absorbed.
+ * \param len Length of the data to be absorbed.
+ * \param first_round First round of the permutation to apply each block.
+ * \param partial Non-zero if the first byte to be absorbed should
+ * start partway through the first block.
+ *
+ * \return Partial block length for the last block.
+ *
+ * The final block is not padded or permuted.  Once all fragments have
+ * been absorbed, the caller should pad the state at the returned
+ * partial position and then permute it.
+ */
+unsigned char ascon_aead_absorb_stream_8
+    (ascon_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, unsigned char partial);
+
+/**
+ * \brief Absorbs a fragment of data into an ASCON state with a 16-byte rate,
+ * continuing on from a previous fragment.
+ *
+ * \param state The state to absorb the data into.
+ * \param data Points to the data to be absorbed.
+ * \param len Length of the data to be absorbed.
+ * \param first_round First round of the permutation to apply each block.
+ * \param partial Non-zero if the first byte to be absorbed should
+ * start partway through the first block.
+ *
+ * \return Partial block length for the last block.
+ *
+ * The final block is not padded or permuted.  Once all fragments have
+ * been absorbed, the caller should pad the state at the returned
+ * partial position and then permute it.
+ */
+unsigned char ascon_aead_absorb_stream_16
+    (ascon_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, unsigned char partial);
+
 /**
  * \brief Encrypts a block of data with an ASCON state and an 8-byte rate.
  *
@@ -148,4 +190,19 @@ unsigned char ascon_aead_decrypt_16
      const unsigned char *src, size_t len, uint8_t first_round,
      unsigned char partial);
 
+/**
+ * \brief Absorbs ciphertext into an ASCON state with an 8-byte rate
+ * in the same way as decryption, but without producing the plaintext.
+ *
+ * \param state The state to absorb the ciphertext into.
+ * \param src Points to the ciphertext.
+ * \param len Length of the ciphertext in bytes.
+ * \param first_round First round of the permutation to apply each block.
+ *
+ * \return Partial block length for the last block.
+ */
+unsigned char ascon_aead_verify_8
+    (ascon_state_t *state, const unsigned char *src, size_t len,
+     uint8_t first_round);
+
 #endif
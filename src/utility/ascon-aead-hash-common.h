@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the hash algorithm that is combined
+ * with ASCON-128a.  The helper functions in ascon-aead-hash.c
+ * must also have been defined.
+ *
+ * AEAD_HASH_NAME       Name of the encrypt-and-hash function.
+ * AEAD_UNHASH_NAME     Name of the decrypt-and-hash function.
+ * HASH_ALG_NAME        Name of the hash algorithm; e.g. ascon_hash
+ * HASH_STATE_TYPE      Type of the incremental hash state.
+ * HASH_FIRST_ROUND     First round of the hash permutation between blocks.
+ */
+#if defined(AEAD_HASH_NAME)
+
+#define HASH_CONCAT_INNER(name,suffix) name##suffix
+#define HASH_CONCAT(name,suffix) HASH_CONCAT_INNER(name,suffix)
+
+void AEAD_HASH_NAME
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned char *hash)
+{
+    ascon_state_t aead;
+    HASH_STATE_TYPE h;
+    size_t full = mlen & ~((size_t)15);
+    unsigned char partial;
+
+    /* Set the length of the returned ciphertext */
+    *clen = mlen + ASCON128_TAG_SIZE;
+
+    /* Initialize both states and then process the full blocks of the
+     * payload with the AEAD and hash states side by side */
+    ascon128a_aead_hash_start(&aead, ad, adlen, npub, k);
+    HASH_CONCAT(HASH_ALG_NAME,_init)(&h);
+    ascon_acquire(&(h.xof.state));
+    ascon128a_aead_hash_encrypt_blocks
+        (&aead, &(h.xof.state), c, m, full, HASH_FIRST_ROUND);
+    ascon_release(&(h.xof.state));
+
+    /* Hash the left-over plaintext before it can be overwritten by
+     * in-place encryption, then encrypt it and compute the tag */
+    HASH_CONCAT(HASH_ALG_NAME,_update)(&h, m + full, mlen - full);
+    HASH_CONCAT(HASH_ALG_NAME,_finalize)(&h, hash);
+    partial = ascon_aead_encrypt_16
+        (&aead, c + full, m + full, mlen - full, 4, 0);
+    ascon128a_aead_hash_finish(&aead, partial, k, c + mlen);
+}
+
+int AEAD_UNHASH_NAME
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k, unsigned char *hash)
+{
+    ascon_state_t aead;
+    HASH_STATE_TYPE h;
+    unsigned char tag[ASCON128_TAG_SIZE];
+    size_t len, full;
+    unsigned char partial;
+    int result;
+
+    /* Set the length of the returned plaintext */
+    if (clen < ASCON128_TAG_SIZE)
+        return -1;
+    len = clen - ASCON128_TAG_SIZE;
+    full = len & ~((size_t)15);
+    *mlen = len;
+
+    /* Initialize both states and then process the full blocks of the
+     * payload with the AEAD and hash states side by side */
+    ascon128a_aead_hash_start(&aead, ad, adlen, npub, k);
+    HASH_CONCAT(HASH_ALG_NAME,_init)(&h);
+    ascon_acquire(&(h.xof.state));
+    ascon128a_aead_hash_decrypt_blocks
+        (&aead, &(h.xof.state), m, c, full, HASH_FIRST_ROUND);
+    ascon_release(&(h.xof.state));
+
+    /* Decrypt the left-over ciphertext and hash the plaintext */
+    partial = ascon_aead_decrypt_16
+        (&aead, m + full, c + full, len - full, 4, 0);
+    ascon128a_aead_hash_finish(&aead, partial, k, tag);
+    HASH_CONCAT(HASH_ALG_NAME,_update)(&h, m + full, len - full);
+    HASH_CONCAT(HASH_ALG_NAME,_finalize)(&h, hash);
+
+    /* Check the tag and destroy the plaintext and hash if incorrect */
+    result = ascon_aead_check_tag(m, len, tag, c + len, ASCON128_TAG_SIZE);
+    if (result != 0)
+        ascon_clean(hash, ASCON_HASH_SIZE);
+    ascon_clean(tag, sizeof(tag));
+    return result;
+}
+
+#endif /* AEAD_HASH_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the hash algorithm */
+#undef AEAD_HASH_NAME
+#undef AEAD_UNHASH_NAME
+#undef HASH_ALG_NAME
+#undef HASH_STATE_TYPE
+#undef HASH_FIRST_ROUND
+#undef HASH_CONCAT_INNER
+#undef HASH_CONCAT
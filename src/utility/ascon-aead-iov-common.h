@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the underlying AEAD variant.
+ *
+ * AEAD_ALG_NAME        Name of the AEAD algorithm; e.g. ascon128_aead
+ * AEAD_STATE_TYPE      Type of the incremental state; e.g. ascon128_state_t
+ *
+ * The associated data and payload are processed with the incremental
+ * functions for the algorithm so that partial blocks are carried across
+ * fragment boundaries.
+ */
+#if defined(AEAD_ALG_NAME)
+
+#include "../ascon-aead.h"
+#include <string.h>
+
+#define AEAD_CONCAT_INNER(name,suffix) name##suffix
+#define AEAD_CONCAT(name,suffix) AEAD_CONCAT_INNER(name,suffix)
+
+static size_t AEAD_CONCAT(AEAD_ALG_NAME,_iov_length)
+    (const ascon_iovec_t *iov, size_t count)
+{
+    size_t len = 0;
+    while (count > 0) {
+        len += iov->len;
+        ++iov;
+        --count;
+    }
+    return len;
+}
+
+static void AEAD_CONCAT(AEAD_ALG_NAME,_iov_start)
+    (AEAD_STATE_TYPE *state, const ascon_iovec_t *ad, size_t adcnt,
+     const unsigned char *npub, const unsigned char *k)
+{
+    AEAD_CONCAT(AEAD_ALG_NAME,_start_ad)(state, npub, k);
+    while (adcnt > 0) {
+        AEAD_CONCAT(AEAD_ALG_NAME,_ad_update)(state, ad->data, ad->len);
+        ++ad;
+        --adcnt;
+    }
+    AEAD_CONCAT(AEAD_ALG_NAME,_ad_finish)(state);
+}
+
+static void AEAD_CONCAT(AEAD_ALG_NAME,_iov_process)
+    (AEAD_STATE_TYPE *state, const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt, int decrypt)
+{
+    size_t inposn = 0;
+    size_t outposn = 0;
+    size_t len;
+
+    /* Walk the input and output fragments in parallel, processing the
+     * largest chunk that fits within both the current fragments */
+    while (incnt > 0 && outcnt > 0) {
+        len = in->len - inposn;
+        if (len > (out->len - outposn))
+            len = out->len - outposn;
+        if (len > 0) {
+            if (decrypt) {
+                AEAD_CONCAT(AEAD_ALG_NAME,_decrypt_block)
+                    (state, in->data + inposn, out->data + outposn, len);
+            } else {
+                AEAD_CONCAT(AEAD_ALG_NAME,_encrypt_block)
+                    (state, in->data + inposn, out->data + outposn, len);
+            }
+            inposn += len;
+            outposn += len;
+        }
+        if (inposn >= in->len) {
+            ++in;
+            --incnt;
+            inposn = 0;
+        }
+        if (outposn >= out->len) {
+            ++out;
+            --outcnt;
+            outposn = 0;
+        }
+    }
+}
+
+int AEAD_CONCAT(AEAD_ALG_NAME,_encrypt_iov)
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k)
+{
+    AEAD_STATE_TYPE state;
+
+    /* The output fragments must be able to hold all of the input */
+    if (AEAD_CONCAT(AEAD_ALG_NAME,_iov_length)(out, outcnt) <
+            AEAD_CONCAT(AEAD_ALG_NAME,_iov_length)(in, incnt))
+        return -2;
+
+    /* Encrypt the payload fragments and generate the tag */
+    AEAD_CONCAT(AEAD_ALG_NAME,_iov_start)(&state, ad, adcnt, npub, k);
+    AEAD_CONCAT(AEAD_ALG_NAME,_iov_process)
+        (&state, out, outcnt, in, incnt, 0);
+    AEAD_CONCAT(AEAD_ALG_NAME,_encrypt_finalize)(&state, tag);
+    return 0;
+}
+
+int AEAD_CONCAT(AEAD_ALG_NAME,_decrypt_iov)
+    (const ascon_iovec_t *out, size_t outcnt,
+     const ascon_iovec_t *in, size_t incnt,
+     const ascon_iovec_t *ad, size_t adcnt,
+     const unsigned char *tag, const unsigned char *npub,
+     const unsigned char *k)
+{
+    AEAD_STATE_TYPE state;
+    size_t len;
+    int result;
+
+    /* The output fragments must be able to hold all of the input */
+    len = AEAD_CONCAT(AEAD_ALG_NAME,_iov_length)(in, incnt);
+    if (AEAD_CONCAT(AEAD_ALG_NAME,_iov_length)(out, outcnt) < len)
+        return -2;
+
+    /* Decrypt the payload fragments and check the tag */
+    AEAD_CONCAT(AEAD_ALG_NAME,_iov_start)(&state, ad, adcnt, npub, k);
+    AEAD_CONCAT(AEAD_ALG_NAME,_iov_process)
+        (&state, out, outcnt, in, incnt, 1);
+    result = AEAD_CONCAT(AEAD_ALG_NAME,_decrypt_finalize)(&state, tag);
+
+    /* Destroy the plaintext if the tag match failed */
+    if (result != 0) {
+        while (len > 0 && outcnt > 0) {
+            if (out->len < len) {
+                memset(out->data, 0, out->len);
+                len -= out->len;
+            } else {
+                memset(out->data, 0, len);
+                len = 0;
+            }
+            ++out;
+            --outcnt;
+        }
+    }
+    return result;
+}
+
+#endif /* AEAD_ALG_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the AEAD algorithm */
+#undef AEAD_ALG_NAME
+#undef AEAD_STATE_TYPE
+#undef AEAD_CONCAT_INNER
+#undef AEAD_CONCAT
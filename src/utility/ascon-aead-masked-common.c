@@ -20,194 +20,93 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "../ascon-config.h"
 #include "utility/ascon-aead-masked-common.h"
 
-/* Not needed if we won't be masking associated data and plaintext */
-#if ASCON_MASKED_DATA_SHARES != 1
+#if ASCON_ENABLE_MASKING
 
-void ascon_masked_aead_absorb_8
-    (ascon_masked_state_t *state, const unsigned char *data,
-     size_t len, uint8_t first_round, ascon_masked_word_t *word,
-     uint64_t *preserve, ascon_trng_state_t *trng)
-{
-    while (len >= 8) {
-        ascon_masked_data_load(word, data, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_permute(state, first_round, preserve);
-        data += 8;
-        len -= 8;
-    }
-    if (len > 0) {
-        ascon_masked_data_load_partial(word, data, len, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-    }
-    ascon_masked_word_pad(&(state->M[0]), len);
-    ascon_masked_data_permute(state, first_round, preserve);
-}
+/* The incremental state structures in the public API reserve opaque
+ * storage for the internal masked state and TRNG; check that it fits */
+typedef int ascon_masked_inc_state_check
+    [(sizeof(ascon_masked_state_t) <=
+        sizeof(((ascon128_masked_state_t *)0)->M) &&
+      sizeof(ascon_trng_state_t) <=
+        sizeof(((ascon128_masked_state_t *)0)->trng)) ? 1 : -1];
+typedef int ascon_masked_workspace_check
+    [(sizeof(ascon_masked_state_t) <=
+        sizeof(((ascon_masked_aead_workspace_t *)0)->M) &&
+      sizeof(ascon_masked_word_t) <=
+        sizeof(((ascon_masked_aead_workspace_t *)0)->word) &&
+      sizeof(ascon_trng_state_t) <=
+        sizeof(((ascon_masked_aead_workspace_t *)0)->trng)) ? 1 : -1];
 
-void ascon_masked_aead_absorb_16
-    (ascon_masked_state_t *state, const unsigned char *data,
-     size_t len, uint8_t first_round, ascon_masked_word_t *word,
-     uint64_t *preserve, ascon_trng_state_t *trng)
-{
-    while (len >= 16) {
-        ascon_masked_data_load(word, data, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_load(word, data + 8, trng);
-        ascon_masked_data_xor(&(state->M[1]), word);
-        ascon_masked_data_permute(state, first_round, preserve);
-        data += 16;
-        len -= 16;
-    }
-    if (len >= 8) {
-        ascon_masked_data_load(word, data, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        data += 8;
-        len -= 8;
-        if (len > 0) {
-            ascon_masked_data_load_partial(word, data, len, trng);
-            ascon_masked_data_xor(&(state->M[1]), word);
-        }
-        ascon_masked_word_pad(&(state->M[1]), len);
-    } else {
-        if (len > 0) {
-            ascon_masked_data_load_partial(word, data, len, trng);
-            ascon_masked_data_xor(&(state->M[0]), word);
-        }
-        ascon_masked_word_pad(&(state->M[0]), len);
-    }
-    ascon_masked_data_permute(state, first_round, preserve);
-}
+/* Generate the versions of the data functions for every number of data
+ * shares that is supported, to allow selecting the number at runtime */
+#define MASKED_DATA_X x2
+#include "utility/ascon-aead-masked-data-common.h"
+#if ASCON_MASKED_KEY_SHARES >= 3
+#define MASKED_DATA_X x3
+#include "utility/ascon-aead-masked-data-common.h"
+#endif
+#if ASCON_MASKED_KEY_SHARES >= 4
+#define MASKED_DATA_X x4
+#include "utility/ascon-aead-masked-data-common.h"
+#endif
 
-void ascon_masked_aead_encrypt_8
-    (ascon_masked_state_t *state, unsigned char *dest,
-     const unsigned char *src, size_t len, uint8_t first_round,
-     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+void ascon_masked_aead_key_to_data
+    (ascon_masked_state_t *state, ascon_state_t *state_x1,
+     unsigned shares, ascon_trng_state_t *trng)
 {
-    while (len >= 8) {
-        ascon_masked_data_load(word, src, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_store(dest, &(state->M[0]));
-        ascon_masked_data_permute(state, first_round, preserve);
-        dest += 8;
-        src += 8;
-        len -= 8;
-    }
-    if (len > 0) {
-        ascon_masked_data_load_partial(word, src, len, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_store_partial(dest, len, &(state->M[0]));
+#if ASCON_MASKED_KEY_SHARES == 2
+    /* The key is already in two-share form, so no randomness is needed */
+    (void)trng;
+#endif
+    if (shares == 1) {
+        ascon_copy_key_to_x1(state_x1, state);
+    } else if (shares == 2) {
+        ascon_copy_key_to_x2(state, trng);
+#if ASCON_MASKED_KEY_SHARES >= 3
+    } else if (shares == 3) {
+        ascon_copy_key_to_x3(state, trng);
+#endif
+#if ASCON_MASKED_KEY_SHARES >= 4
+    } else {
+        ascon_copy_key_to_x4(state, trng);
+#endif
     }
-    ascon_masked_word_pad(&(state->M[0]), len);
 }
 
-void ascon_masked_aead_encrypt_16
-    (ascon_masked_state_t *state, unsigned char *dest,
-     const unsigned char *src, size_t len, uint8_t first_round,
-     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+void ascon_masked_aead_data_to_key
+    (ascon_masked_state_t *state, ascon_state_t *state_x1,
+     unsigned shares, ascon_trng_state_t *trng)
 {
-    while (len >= 16) {
-        ascon_masked_data_load(word, src, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_load(word, src + 8, trng);
-        ascon_masked_data_xor(&(state->M[1]), word);
-        ascon_masked_data_store(dest, &(state->M[0]));
-        ascon_masked_data_store(dest + 8, &(state->M[1]));
-        ascon_masked_data_permute(state, first_round, preserve);
-        dest += 16;
-        src += 16;
-        len -= 16;
-    }
-    if (len >= 8) {
-        ascon_masked_data_load(word, src, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_store(dest, &(state->M[0]));
-        dest += 8;
-        src += 8;
-        len -= 8;
-        if (len > 0) {
-            ascon_masked_data_load_partial(word, src, len, trng);
-            ascon_masked_data_xor(&(state->M[1]), word);
-            ascon_masked_data_store_partial(dest, len, &(state->M[1]));
-        }
-        ascon_masked_word_pad(&(state->M[1]), len);
+    if (shares == 1) {
+        ascon_copy_key_from_x1(state, state_x1, trng);
+    } else if (shares == 2) {
+        ascon_copy_key_from_x2(state, trng);
+#if ASCON_MASKED_KEY_SHARES >= 3
+    } else if (shares == 3) {
+        ascon_copy_key_from_x3(state, trng);
+#endif
+#if ASCON_MASKED_KEY_SHARES >= 4
     } else {
-        if (len > 0) {
-            ascon_masked_data_load_partial(word, src, len, trng);
-            ascon_masked_data_xor(&(state->M[0]), word);
-            ascon_masked_data_store_partial(dest, len, &(state->M[0]));
-        }
-        ascon_masked_word_pad(&(state->M[0]), len);
+        ascon_copy_key_from_x4(state, trng);
+#endif
     }
 }
 
-void ascon_masked_aead_decrypt_8
-    (ascon_masked_state_t *state, unsigned char *dest,
-     const unsigned char *src, size_t len, uint8_t first_round,
-     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+void ascon_masked_aead_workspace_init(ascon_masked_aead_workspace_t *workspace)
 {
-    while (len >= 8) {
-        ascon_masked_data_load(word, src, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_store(dest, &(state->M[0]));
-        state->M[0] = *word;
-        ascon_masked_data_permute(state, first_round, preserve);
-        dest += 8;
-        src += 8;
-        len -= 8;
-    }
-    if (len > 0) {
-        ascon_masked_data_load_partial(word, src, len, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_store_partial(dest, len, &(state->M[0]));
-        ascon_masked_data_replace(&(state->M[0]), word, len);
-    }
-    ascon_masked_word_pad(&(state->M[0]), len);
+    memset(workspace, 0, sizeof(ascon_masked_aead_workspace_t));
+    ascon_trng_init(ascon_masked_inc_trng(workspace));
 }
 
-void ascon_masked_aead_decrypt_16
-    (ascon_masked_state_t *state, unsigned char *dest,
-     const unsigned char *src, size_t len, uint8_t first_round,
-     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+void ascon_masked_aead_workspace_free(ascon_masked_aead_workspace_t *workspace)
 {
-    while (len >= 16) {
-        ascon_masked_data_load(word, src, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_store(dest, &(state->M[0]));
-        state->M[0] = *word;
-        ascon_masked_data_load(word, src + 8, trng);
-        ascon_masked_data_xor(&(state->M[1]), word);
-        ascon_masked_data_store(dest + 8, &(state->M[1]));
-        state->M[1] = *word;
-        ascon_masked_data_permute(state, first_round, preserve);
-        dest += 16;
-        src += 16;
-        len -= 16;
-    }
-    if (len >= 8) {
-        ascon_masked_data_load(word, src, trng);
-        ascon_masked_data_xor(&(state->M[0]), word);
-        ascon_masked_data_store(dest, &(state->M[0]));
-        state->M[0] = *word;
-        dest += 8;
-        src += 8;
-        len -= 8;
-        if (len > 0) {
-            ascon_masked_data_load_partial(word, src, len, trng);
-            ascon_masked_data_xor(&(state->M[1]), word);
-            ascon_masked_data_store_partial(dest, len, &(state->M[1]));
-            ascon_masked_data_replace(&(state->M[1]), word, len);
-        }
-        ascon_masked_word_pad(&(state->M[1]), len);
-    } else {
-        if (len > 0) {
-            ascon_masked_data_load_partial(word, src, len, trng);
-            ascon_masked_data_xor(&(state->M[0]), word);
-            ascon_masked_data_store_partial(dest, len, &(state->M[0]));
-            ascon_masked_data_replace(&(state->M[0]), word, len);
-        }
-        ascon_masked_word_pad(&(state->M[0]), len);
+    if (workspace) {
+        ascon_trng_free(ascon_masked_inc_trng(workspace));
+        ascon_clean(workspace, sizeof(ascon_masked_aead_workspace_t));
     }
 }
 
-#endif /* ASCON_MASKED_DATA_SHARES != 1 */
+#endif /* ASCON_ENABLE_MASKING */
@@ -32,6 +32,50 @@
 #include "utility/ascon-util.h"
 #include <string.h>
 
+/**
+ * \def ascon_masked_aead_default(name)
+ * \brief Maps the name of one of the masked data functions below to the
+ * version for ASCON_MASKED_DATA_SHARES.
+ *
+ * The masked data functions are instantiated for every number of data
+ * shares between 2 and ASCON_MASKED_KEY_SHARES with the number of shares
+ * as a suffix on the name; e.g. ascon_masked_aead_absorb_8_x3().  This
+ * allows contexts to select the number of data shares at runtime.
+ * The names without a suffix refer to the version for the default
+ * number of data shares that was selected by the build configuration.
+ */
+#if ASCON_MASKED_DATA_SHARES == 3
+#define ascon_masked_aead_default(name) name##_x3
+#elif ASCON_MASKED_DATA_SHARES == 4
+#define ascon_masked_aead_default(name) name##_x4
+#else
+#define ascon_masked_aead_default(name) name##_x2
+#endif
+#define ascon_masked_aead_absorb_8 \
+    ascon_masked_aead_default(ascon_masked_aead_absorb_8)
+#define ascon_masked_aead_absorb_16 \
+    ascon_masked_aead_default(ascon_masked_aead_absorb_16)
+#define ascon_masked_aead_absorb_32 \
+    ascon_masked_aead_default(ascon_masked_aead_absorb_32)
+#define ascon_masked_aead_squeeze_16 \
+    ascon_masked_aead_default(ascon_masked_aead_squeeze_16)
+#define ascon_masked_aead_encrypt_blocks_8 \
+    ascon_masked_aead_default(ascon_masked_aead_encrypt_blocks_8)
+#define ascon_masked_aead_encrypt_8 \
+    ascon_masked_aead_default(ascon_masked_aead_encrypt_8)
+#define ascon_masked_aead_encrypt_blocks_16 \
+    ascon_masked_aead_default(ascon_masked_aead_encrypt_blocks_16)
+#define ascon_masked_aead_encrypt_16 \
+    ascon_masked_aead_default(ascon_masked_aead_encrypt_16)
+#define ascon_masked_aead_decrypt_blocks_8 \
+    ascon_masked_aead_default(ascon_masked_aead_decrypt_blocks_8)
+#define ascon_masked_aead_decrypt_8 \
+    ascon_masked_aead_default(ascon_masked_aead_decrypt_8)
+#define ascon_masked_aead_decrypt_blocks_16 \
+    ascon_masked_aead_default(ascon_masked_aead_decrypt_blocks_16)
+#define ascon_masked_aead_decrypt_16 \
+    ascon_masked_aead_default(ascon_masked_aead_decrypt_16)
+
 /**
  * \brief Absorbs data into a masked ASCON state with an 8-byte rate.
  *
@@ -64,6 +108,36 @@ void ascon_masked_aead_absorb_16
      size_t len, uint8_t first_round, ascon_masked_word_t *word,
      uint64_t *preserve, ascon_trng_state_t *trng);
 
+/**
+ * \brief Absorbs data into a masked ASCON state with a 32-byte rate.
+ * \param state The state to absorb the data into.
+ * \param data Points to the data to be absorbed.
+ * \param len Length of the data to be absorbed.
+ * \param first_round First round of the permutation to apply each block.
+ * \param word Points to temporary storage for a masked word.
+ * \param preserve Preserved randomness from the previous step.
+ * \param trng TRNG to use to generate randomness to mask the data.
+ * The final padded block is not permuted, so that the caller can add a
+ * domain separator before the permutation.
+ */
+void ascon_masked_aead_absorb_32
+    (ascon_masked_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, ascon_masked_word_t *word,
+     uint64_t *preserve, ascon_trng_state_t *trng);
+
+/**
+ * \brief Squeezes data out of a masked ASCON state with a 16-byte rate.
+ * \param state The state to squeeze the data from.
+ * \param dest Points to the destination buffer.
+ * \param len Length of the data to squeeze.
+ * \param first_round First round of the permutation to apply each block.
+ * \param preserve Preserved randomness from the previous step.
+ * The state is permuted before each block is squeezed.
+ */
+void ascon_masked_aead_squeeze_16
+    (ascon_masked_state_t *state, unsigned char *dest, size_t len,
+     uint8_t first_round, uint64_t *preserve);
+
 /**
  * \brief Encrypts a block of data with a masked ASCON state and an 8-byte rate.
  *
@@ -132,6 +206,230 @@ void ascon_masked_aead_decrypt_16
      const unsigned char *src, size_t len, uint8_t first_round,
      ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng);
 
+/**
+ * \brief Encrypts full blocks of data with a masked ASCON state and
+ * an 8-byte rate.
+ *
+ * \param state The state to encrypt with.
+ * \param dest Points to the destination buffer.
+ * \param src Points to the source buffer.
+ * \param blocks Number of 8-byte blocks to encrypt.
+ * \param first_round First round of the permutation to apply each block.
+ * \param word Points to temporary storage for a masked word.
+ * \param preserve Preserved randomness from the previous step.
+ * \param trng TRNG to use to generate randomness to mask the data.
+ *
+ * The state is permuted after each block and no padding is added.
+ */
+void ascon_masked_aead_encrypt_blocks_8
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng);
+
+/**
+ * \brief Encrypts full blocks of data with a masked ASCON state and
+ * a 16-byte rate.
+ *
+ * \param state The state to encrypt with.
+ * \param dest Points to the destination buffer.
+ * \param src Points to the source buffer.
+ * \param blocks Number of 16-byte blocks to encrypt.
+ * \param first_round First round of the permutation to apply each block.
+ * \param word Points to temporary storage for a masked word.
+ * \param preserve Preserved randomness from the previous step.
+ * \param trng TRNG to use to generate randomness to mask the data.
+ *
+ * The state is permuted after each block and no padding is added.
+ */
+void ascon_masked_aead_encrypt_blocks_16
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng);
+
+/**
+ * \brief Decrypts full blocks of data with a masked ASCON state and
+ * an 8-byte rate.
+ *
+ * \param state The state to decrypt with.
+ * \param dest Points to the destination buffer.
+ * \param src Points to the source buffer.
+ * \param blocks Number of 8-byte blocks to decrypt.
+ * \param first_round First round of the permutation to apply each block.
+ * \param word Points to temporary storage for a masked word.
+ * \param preserve Preserved randomness from the previous step.
+ * \param trng TRNG to use to generate randomness to mask the data.
+ *
+ * The state is permuted after each block and no padding is added.
+ */
+void ascon_masked_aead_decrypt_blocks_8
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng);
+
+/**
+ * \brief Decrypts full blocks of data with a masked ASCON state and
+ * a 16-byte rate.
+ *
+ * \param state The state to decrypt with.
+ * \param dest Points to the destination buffer.
+ * \param src Points to the source buffer.
+ * \param blocks Number of 16-byte blocks to decrypt.
+ * \param first_round First round of the permutation to apply each block.
+ * \param word Points to temporary storage for a masked word.
+ * \param preserve Preserved randomness from the previous step.
+ * \param trng TRNG to use to generate randomness to mask the data.
+ *
+ * The state is permuted after each block and no padding is added.
+ */
+void ascon_masked_aead_decrypt_blocks_16
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng);
+
+/**
+ * \brief Declares the masked data functions for a specific number of
+ * data shares.
+ *
+ * \param x Suffix for the number of shares; e.g. x2.
+ */
+#define ascon_masked_aead_declare(x) \
+    void ascon_masked_aead_absorb_8_##x \
+        (ascon_masked_state_t *state, const unsigned char *data, \
+         size_t len, uint8_t first_round, ascon_masked_word_t *word, \
+         uint64_t *preserve, ascon_trng_state_t *trng); \
+    void ascon_masked_aead_absorb_16_##x \
+        (ascon_masked_state_t *state, const unsigned char *data, \
+         size_t len, uint8_t first_round, ascon_masked_word_t *word, \
+         uint64_t *preserve, ascon_trng_state_t *trng); \
+    void ascon_masked_aead_absorb_32_##x \
+        (ascon_masked_state_t *state, const unsigned char *data, \
+         size_t len, uint8_t first_round, ascon_masked_word_t *word, \
+         uint64_t *preserve, ascon_trng_state_t *trng); \
+    void ascon_masked_aead_squeeze_16_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, size_t len, \
+         uint8_t first_round, uint64_t *preserve); \
+    void ascon_masked_aead_encrypt_blocks_8_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t blocks, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng); \
+    void ascon_masked_aead_encrypt_8_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t len, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng); \
+    void ascon_masked_aead_encrypt_blocks_16_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t blocks, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng); \
+    void ascon_masked_aead_encrypt_16_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t len, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng); \
+    void ascon_masked_aead_decrypt_blocks_8_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t blocks, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng); \
+    void ascon_masked_aead_decrypt_8_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t len, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng); \
+    void ascon_masked_aead_decrypt_blocks_16_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t blocks, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng); \
+    void ascon_masked_aead_decrypt_16_##x \
+        (ascon_masked_state_t *state, unsigned char *dest, \
+         const unsigned char *src, size_t len, uint8_t first_round, \
+         ascon_masked_word_t *word, uint64_t *preserve, \
+         ascon_trng_state_t *trng);
+
+ascon_masked_aead_declare(x2)
+#if ASCON_MASKED_KEY_SHARES >= 3
+ascon_masked_aead_declare(x3)
+#endif
+#if ASCON_MASKED_KEY_SHARES >= 4
+ascon_masked_aead_declare(x4)
+#endif
+
+/**
+ * \def ascon_masked_aead_dispatch(shares, name, args)
+ * \brief Calls the version of a masked data function for a number of
+ * data shares that is selected at runtime.
+ *
+ * \param shares Number of data shares, between 2 and ASCON_MASKED_KEY_SHARES.
+ * \param name Name of the function without a suffix.
+ * \param args Parenthesized list of arguments to the function.
+ */
+#if ASCON_MASKED_KEY_SHARES >= 4
+#define ascon_masked_aead_dispatch(shares, name, args) \
+    do { \
+        if ((shares) == 2) \
+            name##_x2 args; \
+        else if ((shares) == 3) \
+            name##_x3 args; \
+        else \
+            name##_x4 args; \
+    } while (0)
+#elif ASCON_MASKED_KEY_SHARES >= 3
+#define ascon_masked_aead_dispatch(shares, name, args) \
+    do { \
+        if ((shares) == 2) \
+            name##_x2 args; \
+        else \
+            name##_x3 args; \
+    } while (0)
+#else
+#define ascon_masked_aead_dispatch(shares, name, args) \
+    do { \
+        name##_x2 args; \
+    } while (0)
+#endif
+
+/**
+ * \brief Converts a masked state from the key shares form into the
+ * data shares form for a number of data shares that is selected at runtime.
+ *
+ * \param state The masked state to convert.
+ * \param state_x1 Unmasked state to convert into if \a shares is 1.
+ * \param shares Number of data shares, between 1 and ASCON_MASKED_KEY_SHARES.
+ * \param trng TRNG to use to generate randomness for the conversion.
+ */
+void ascon_masked_aead_key_to_data
+    (ascon_masked_state_t *state, ascon_state_t *state_x1,
+     unsigned shares, ascon_trng_state_t *trng);
+
+/**
+ * \brief Converts a masked state from the data shares form back into the
+ * key shares form for a number of data shares that is selected at runtime.
+ *
+ * \param state The masked state to convert.
+ * \param state_x1 Unmasked state to convert from if \a shares is 1.
+ * \param shares Number of data shares, between 1 and ASCON_MASKED_KEY_SHARES.
+ * \param trng TRNG to use to generate randomness for the conversion.
+ */
+void ascon_masked_aead_data_to_key
+    (ascon_masked_state_t *state, ascon_state_t *state_x1,
+     unsigned shares, ascon_trng_state_t *trng);
+
+/**
+ * \brief Gets the internal masked ASCON state from an incremental
+ * masked AEAD state.
+ */
+#define ascon_masked_inc_state(state) \
+    ((ascon_masked_state_t *)((state)->M))
+
+/**
+ * \brief Gets the internal TRNG state from an incremental masked AEAD state.
+ */
+#define ascon_masked_inc_trng(state) \
+    ((ascon_trng_state_t *)((state)->trng))
+
 /** @cond masked_aead_utils */
 
 #if ASCON_MASKED_KEY_SHARES == 2
@@ -208,63 +506,6 @@ void ascon_masked_aead_decrypt_16
 
 #endif /* ASCON_MASKED_KEY_SHARES == 4 */
 
-#if ASCON_MASKED_DATA_SHARES == 1
-
-/* Masking is not needed with 1 data share */
-
-#elif ASCON_MASKED_DATA_SHARES == 2
-
-#define ascon_masked_data_load(word, data, trng) \
-    ascon_masked_word_x2_load((word), (data), (trng))
-#define ascon_masked_data_load_partial(word, data, len, trng) \
-    ascon_masked_word_x2_load_partial((word), (data), len, (trng))
-#define ascon_masked_data_store(data, word) \
-    ascon_masked_word_x2_store((data), (word))
-#define ascon_masked_data_store_partial(data, len, word) \
-    ascon_masked_word_x2_store_partial((data), (len), (word))
-#define ascon_masked_data_xor(dest, src) \
-    ascon_masked_word_x2_xor((dest), (src))
-#define ascon_masked_data_permute(state, first_round, preserve) \
-    ascon_x2_permute((state), (first_round), (preserve))
-#define ascon_masked_data_replace(dest, src, size) \
-    ascon_masked_word_x2_replace((dest), (src), (size))
-
-#elif ASCON_MASKED_DATA_SHARES == 3
-
-#define ascon_masked_data_load(word, data, trng) \
-    ascon_masked_word_x3_load((word), (data), (trng))
-#define ascon_masked_data_load_partial(word, data, len, trng) \
-    ascon_masked_word_x3_load_partial((word), (data), len, (trng))
-#define ascon_masked_data_store(data, word) \
-    ascon_masked_word_x3_store((data), (word))
-#define ascon_masked_data_store_partial(data, len, word) \
-    ascon_masked_word_x3_store_partial((data), (len), (word))
-#define ascon_masked_data_xor(dest, src) \
-    ascon_masked_word_x3_xor((dest), (src))
-#define ascon_masked_data_permute(state, first_round, preserve) \
-    ascon_x3_permute((state), (first_round), (preserve))
-#define ascon_masked_data_replace(dest, src, size) \
-    ascon_masked_word_x3_replace((dest), (src), (size))
-
-#else /* ASCON_MASKED_DATA_SHARES == 4 */
-
-#define ascon_masked_data_load(word, data, trng) \
-    ascon_masked_word_x4_load((word), (data), (trng))
-#define ascon_masked_data_load_partial(word, data, len, trng) \
-    ascon_masked_word_x4_load_partial((word), (data), len, (trng))
-#define ascon_masked_data_store(data, word) \
-    ascon_masked_word_x4_store((data), (word))
-#define ascon_masked_data_store_partial(data, len, word) \
-    ascon_masked_word_x4_store_partial((data), (len), (word))
-#define ascon_masked_data_xor(dest, src) \
-    ascon_masked_word_x4_xor((dest), (src))
-#define ascon_masked_data_permute(state, first_round, preserve) \
-    ascon_x4_permute((state), (first_round), (preserve))
-#define ascon_masked_data_replace(dest, src, size) \
-    ascon_masked_word_x4_replace((dest), (src), (size))
-
-#endif /* ASCON_MASKED_DATA_SHARES == 4 */
-
 /** @endcond */
 
 #endif
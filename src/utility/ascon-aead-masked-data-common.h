@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the number of data shares.
+ *
+ * MASKED_DATA_X        Masked state variant to use; e.g. x2, x3, or x4
+ *
+ * The functions that are generated have MASKED_DATA_X as a suffix on
+ * their names; e.g. ascon_masked_aead_absorb_8_x2().
+ */
+#if defined(MASKED_DATA_X)
+
+#define MASKED_CONCAT_INNER(prefix,x,suffix) prefix##x##suffix
+#define MASKED_CONCAT(prefix,x,suffix) MASKED_CONCAT_INNER(prefix,x,suffix)
+#define MASKED_NAME_INNER(prefix,name,x) prefix##name##_##x
+#define MASKED_NAME(prefix,name,x) MASKED_NAME_INNER(prefix,name,x)
+#define MASKED_DATA_NAME(name) \
+    MASKED_NAME(ascon_masked_aead_,name,MASKED_DATA_X)
+
+#define ascon_masked_data_load(word, data, trng) \
+    MASKED_CONCAT(ascon_masked_word_,MASKED_DATA_X,_load) \
+        ((word), (data), (trng))
+#define ascon_masked_data_load_partial(word, data, len, trng) \
+    MASKED_CONCAT(ascon_masked_word_,MASKED_DATA_X,_load_partial) \
+        ((word), (data), (len), (trng))
+#define ascon_masked_data_store(data, word) \
+    MASKED_CONCAT(ascon_masked_word_,MASKED_DATA_X,_store) \
+        ((data), (word))
+#define ascon_masked_data_store_partial(data, len, word) \
+    MASKED_CONCAT(ascon_masked_word_,MASKED_DATA_X,_store_partial) \
+        ((data), (len), (word))
+#define ascon_masked_data_xor(dest, src) \
+    MASKED_CONCAT(ascon_masked_word_,MASKED_DATA_X,_xor) \
+        ((dest), (src))
+#define ascon_masked_data_permute(state, first_round, preserve) \
+    MASKED_CONCAT(ascon_,MASKED_DATA_X,_permute) \
+        ((state), (first_round), (preserve))
+#define ascon_masked_data_replace(dest, src, size) \
+    MASKED_CONCAT(ascon_masked_word_,MASKED_DATA_X,_replace) \
+        ((dest), (src), (size))
+
+void MASKED_DATA_NAME(absorb_8)
+    (ascon_masked_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, ascon_masked_word_t *word,
+     uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    while (len >= 8) {
+        ascon_masked_data_load(word, data, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_permute(state, first_round, preserve);
+        data += 8;
+        len -= 8;
+    }
+    if (len > 0) {
+        ascon_masked_data_load_partial(word, data, len, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+    }
+    ascon_masked_word_pad(&(state->M[0]), len);
+    ascon_masked_data_permute(state, first_round, preserve);
+}
+
+void MASKED_DATA_NAME(absorb_16)
+    (ascon_masked_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, ascon_masked_word_t *word,
+     uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    while (len >= 16) {
+        ascon_masked_data_load(word, data, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_load(word, data + 8, trng);
+        ascon_masked_data_xor(&(state->M[1]), word);
+        ascon_masked_data_permute(state, first_round, preserve);
+        data += 16;
+        len -= 16;
+    }
+    if (len >= 8) {
+        ascon_masked_data_load(word, data, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        data += 8;
+        len -= 8;
+        if (len > 0) {
+            ascon_masked_data_load_partial(word, data, len, trng);
+            ascon_masked_data_xor(&(state->M[1]), word);
+        }
+        ascon_masked_word_pad(&(state->M[1]), len);
+    } else {
+        if (len > 0) {
+            ascon_masked_data_load_partial(word, data, len, trng);
+            ascon_masked_data_xor(&(state->M[0]), word);
+        }
+        ascon_masked_word_pad(&(state->M[0]), len);
+    }
+    ascon_masked_data_permute(state, first_round, preserve);
+}
+
+void MASKED_DATA_NAME(absorb_32)
+    (ascon_masked_state_t *state, const unsigned char *data,
+     size_t len, uint8_t first_round, ascon_masked_word_t *word,
+     uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    unsigned index;
+    while (len >= 32) {
+        ascon_masked_data_load(word, data, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_load(word, data + 8, trng);
+        ascon_masked_data_xor(&(state->M[1]), word);
+        ascon_masked_data_load(word, data + 16, trng);
+        ascon_masked_data_xor(&(state->M[2]), word);
+        ascon_masked_data_load(word, data + 24, trng);
+        ascon_masked_data_xor(&(state->M[3]), word);
+        ascon_masked_data_permute(state, first_round, preserve);
+        data += 32;
+        len -= 32;
+    }
+    for (index = 0; len >= 8; ++index) {
+        ascon_masked_data_load(word, data, trng);
+        ascon_masked_data_xor(&(state->M[index]), word);
+        data += 8;
+        len -= 8;
+    }
+    if (len > 0) {
+        ascon_masked_data_load_partial(word, data, len, trng);
+        ascon_masked_data_xor(&(state->M[index]), word);
+    }
+    ascon_masked_word_pad(&(state->M[index]), len);
+}
+
+void MASKED_DATA_NAME(squeeze_16)
+    (ascon_masked_state_t *state, unsigned char *dest, size_t len,
+     uint8_t first_round, uint64_t *preserve)
+{
+    while (len >= 16) {
+        ascon_masked_data_permute(state, first_round, preserve);
+        ascon_masked_data_store(dest, &(state->M[0]));
+        ascon_masked_data_store(dest + 8, &(state->M[1]));
+        dest += 16;
+        len -= 16;
+    }
+    if (len > 0) {
+        ascon_masked_data_permute(state, first_round, preserve);
+        if (len >= 8) {
+            ascon_masked_data_store(dest, &(state->M[0]));
+            ascon_masked_data_store_partial(dest + 8, len - 8, &(state->M[1]));
+        } else {
+            ascon_masked_data_store_partial(dest, len, &(state->M[0]));
+        }
+    }
+}
+
+void MASKED_DATA_NAME(encrypt_blocks_8)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    while (blocks > 0) {
+        ascon_masked_data_load(word, src, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_store(dest, &(state->M[0]));
+        ascon_masked_data_permute(state, first_round, preserve);
+        dest += 8;
+        src += 8;
+        --blocks;
+    }
+}
+
+void MASKED_DATA_NAME(encrypt_8)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t len, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    if (len >= 8) {
+        size_t blocks = len / 8;
+        MASKED_DATA_NAME(encrypt_blocks_8)
+            (state, dest, src, blocks, first_round, word, preserve, trng);
+        dest += blocks * 8;
+        src += blocks * 8;
+        len -= blocks * 8;
+    }
+    if (len > 0) {
+        ascon_masked_data_load_partial(word, src, len, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_store_partial(dest, len, &(state->M[0]));
+    }
+    ascon_masked_word_pad(&(state->M[0]), len);
+}
+
+void MASKED_DATA_NAME(encrypt_blocks_16)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    while (blocks > 0) {
+        ascon_masked_data_load(word, src, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_load(word, src + 8, trng);
+        ascon_masked_data_xor(&(state->M[1]), word);
+        ascon_masked_data_store(dest, &(state->M[0]));
+        ascon_masked_data_store(dest + 8, &(state->M[1]));
+        ascon_masked_data_permute(state, first_round, preserve);
+        dest += 16;
+        src += 16;
+        --blocks;
+    }
+}
+
+void MASKED_DATA_NAME(encrypt_16)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t len, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    if (len >= 16) {
+        size_t blocks = len / 16;
+        MASKED_DATA_NAME(encrypt_blocks_16)
+            (state, dest, src, blocks, first_round, word, preserve, trng);
+        dest += blocks * 16;
+        src += blocks * 16;
+        len -= blocks * 16;
+    }
+    if (len >= 8) {
+        ascon_masked_data_load(word, src, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_store(dest, &(state->M[0]));
+        dest += 8;
+        src += 8;
+        len -= 8;
+        if (len > 0) {
+            ascon_masked_data_load_partial(word, src, len, trng);
+            ascon_masked_data_xor(&(state->M[1]), word);
+            ascon_masked_data_store_partial(dest, len, &(state->M[1]));
+        }
+        ascon_masked_word_pad(&(state->M[1]), len);
+    } else {
+        if (len > 0) {
+            ascon_masked_data_load_partial(word, src, len, trng);
+            ascon_masked_data_xor(&(state->M[0]), word);
+            ascon_masked_data_store_partial(dest, len, &(state->M[0]));
+        }
+        ascon_masked_word_pad(&(state->M[0]), len);
+    }
+}
+
+void MASKED_DATA_NAME(decrypt_blocks_8)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    while (blocks > 0) {
+        ascon_masked_data_load(word, src, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_store(dest, &(state->M[0]));
+        state->M[0] = *word;
+        ascon_masked_data_permute(state, first_round, preserve);
+        dest += 8;
+        src += 8;
+        --blocks;
+    }
+}
+
+void MASKED_DATA_NAME(decrypt_8)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t len, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    if (len >= 8) {
+        size_t blocks = len / 8;
+        MASKED_DATA_NAME(decrypt_blocks_8)
+            (state, dest, src, blocks, first_round, word, preserve, trng);
+        dest += blocks * 8;
+        src += blocks * 8;
+        len -= blocks * 8;
+    }
+    if (len > 0) {
+        ascon_masked_data_load_partial(word, src, len, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_store_partial(dest, len, &(state->M[0]));
+        ascon_masked_data_replace(&(state->M[0]), word, len);
+    }
+    ascon_masked_word_pad(&(state->M[0]), len);
+}
+
+void MASKED_DATA_NAME(decrypt_blocks_16)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t blocks, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    while (blocks > 0) {
+        ascon_masked_data_load(word, src, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_store(dest, &(state->M[0]));
+        state->M[0] = *word;
+        ascon_masked_data_load(word, src + 8, trng);
+        ascon_masked_data_xor(&(state->M[1]), word);
+        ascon_masked_data_store(dest + 8, &(state->M[1]));
+        state->M[1] = *word;
+        ascon_masked_data_permute(state, first_round, preserve);
+        dest += 16;
+        src += 16;
+        --blocks;
+    }
+}
+
+void MASKED_DATA_NAME(decrypt_16)
+    (ascon_masked_state_t *state, unsigned char *dest,
+     const unsigned char *src, size_t len, uint8_t first_round,
+     ascon_masked_word_t *word, uint64_t *preserve, ascon_trng_state_t *trng)
+{
+    if (len >= 16) {
+        size_t blocks = len / 16;
+        MASKED_DATA_NAME(decrypt_blocks_16)
+            (state, dest, src, blocks, first_round, word, preserve, trng);
+        dest += blocks * 16;
+        src += blocks * 16;
+        len -= blocks * 16;
+    }
+    if (len >= 8) {
+        ascon_masked_data_load(word, src, trng);
+        ascon_masked_data_xor(&(state->M[0]), word);
+        ascon_masked_data_store(dest, &(state->M[0]));
+        state->M[0] = *word;
+        dest += 8;
+        src += 8;
+        len -= 8;
+        if (len > 0) {
+            ascon_masked_data_load_partial(word, src, len, trng);
+            ascon_masked_data_xor(&(state->M[1]), word);
+            ascon_masked_data_store_partial(dest, len, &(state->M[1]));
+            ascon_masked_data_replace(&(state->M[1]), word, len);
+        }
+        ascon_masked_word_pad(&(state->M[1]), len);
+    } else {
+        if (len > 0) {
+            ascon_masked_data_load_partial(word, src, len, trng);
+            ascon_masked_data_xor(&(state->M[0]), word);
+            ascon_masked_data_store_partial(dest, len, &(state->M[0]));
+            ascon_masked_data_replace(&(state->M[0]), word, len);
+        }
+        ascon_masked_word_pad(&(state->M[0]), len);
+    }
+}
+
+#endif /* MASKED_DATA_X */
+
+/* Now undefine everything so that we can include this file again for
+ * another number of data shares */
+#undef MASKED_DATA_X
+#undef MASKED_CONCAT_INNER
+#undef MASKED_CONCAT
+#undef MASKED_NAME_INNER
+#undef MASKED_NAME
+#undef MASKED_DATA_NAME
+#undef ascon_masked_data_load
+#undef ascon_masked_data_load_partial
+#undef ascon_masked_data_store
+#undef ascon_masked_data_store_partial
+#undef ascon_masked_data_xor
+#undef ascon_masked_data_permute
+#undef ascon_masked_data_replace
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the underlying AEAD variant.
+ *
+ * AEAD_ALG_NAME        Name of the AEAD algorithm; e.g. ascon128_aead
+ * AEAD_RATE            Rate of the AEAD mode in bytes; 8 or 16.
+ * AEAD_FIRST_ROUND     First round of the permutation between blocks.
+ * AEAD_INIT(s,n,k)     Initializes state s with the nonce n and key k.
+ * AEAD_FINALIZE(s,k)   Absorbs the key k into state s during finalization
+ *                      and runs the 12-round permutation.
+ *
+ * The nonce and tag are assumed to be 16 bytes in size and the tag is
+ * squeezed from offset 24 of the state.
+ *
+ * Because the payload and associated data are at most two blocks of
+ * ASCON-128 or one block of ASCON-128a, the block loops are unrolled
+ * and padding is applied by copying the data into a zeroed buffer that
+ * is absorbed with full-word operations.
+ */
+#if defined(AEAD_ALG_NAME)
+
+#include "ascon-aead-common.h"
+#include "ascon-util-snp.h"
+#include <string.h>
+
+#define AEAD_CONCAT_INNER(name,suffix) name##suffix
+#define AEAD_CONCAT(name,suffix) AEAD_CONCAT_INNER(name,suffix)
+
+#if AEAD_RATE == 8
+#define AEAD_ABSORB_BLOCK(s,d)          ascon_absorb_8((s), (d), 0)
+#define AEAD_ENCRYPT_BLOCK(s,dest,src)  ascon_encrypt_8((s), (dest), (src), 0)
+#define AEAD_DECRYPT_BLOCK(s,dest,src)  ascon_decrypt_8((s), (dest), (src), 0)
+#define AEAD_SQUEEZE_BLOCK(s,d)         ascon_squeeze_8((s), (d), 0)
+#else
+#define AEAD_ABSORB_BLOCK(s,d)          ascon_absorb_16((s), (d), 0)
+#define AEAD_ENCRYPT_BLOCK(s,dest,src)  ascon_encrypt_16((s), (dest), (src), 0)
+#define AEAD_DECRYPT_BLOCK(s,dest,src)  ascon_decrypt_16((s), (dest), (src), 0)
+#define AEAD_SQUEEZE_BLOCK(s,d)         ascon_squeeze_16((s), (d), 0)
+#endif
+
+/* Size of the padding buffer, which holds ASCON_AEAD_SHORT_MAX bytes
+ * of data plus padding rounded up to a multiple of the rate */
+#define AEAD_SHORT_BUFSIZE \
+    (((ASCON_AEAD_SHORT_MAX / AEAD_RATE) + 1) * AEAD_RATE)
+
+/**
+ * \brief Initializes the state and absorbs up to ASCON_AEAD_SHORT_MAX
+ * bytes of associated data.
+ *
+ * \param state The state to initialize.
+ * \param buf Padding buffer of AEAD_SHORT_BUFSIZE bytes.
+ * \param ad Points to the associated data.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the nonce.
+ * \param k Points to the key.
+ */
+static void AEAD_CONCAT(AEAD_ALG_NAME,_short_start)
+    (ascon_state_t *state, unsigned char *buf,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub, const unsigned char *k)
+{
+    AEAD_INIT(state, npub, k);
+    if (adlen > 0) {
+        memcpy(buf, ad, adlen);
+        memset(buf + adlen, 0, AEAD_SHORT_BUFSIZE - adlen);
+        buf[adlen] = 0x80;
+        AEAD_ABSORB_BLOCK(state, buf);
+        ascon_permute(state, AEAD_FIRST_ROUND);
+        if (adlen >= AEAD_RATE) {
+            AEAD_ABSORB_BLOCK(state, buf + AEAD_RATE);
+            ascon_permute(state, AEAD_FIRST_ROUND);
+#if AEAD_RATE == 8
+            if (adlen >= 16U) {
+                AEAD_ABSORB_BLOCK(state, buf + 16);
+                ascon_permute(state, AEAD_FIRST_ROUND);
+            }
+#endif
+        }
+    }
+    ascon_separator(state);
+}
+
+int AEAD_CONCAT(AEAD_ALG_NAME,_encrypt_short)
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    unsigned char buf[AEAD_SHORT_BUFSIZE];
+    unsigned char out[AEAD_SHORT_BUFSIZE];
+
+    /* Validate the parameters */
+    if (mlen > ASCON_AEAD_SHORT_MAX || adlen > ASCON_AEAD_SHORT_MAX)
+        return -2;
+    *clen = mlen + ASCON128_TAG_SIZE;
+
+    /* Initialize the state and absorb the associated data */
+    AEAD_CONCAT(AEAD_ALG_NAME,_short_start)(&state, buf, ad, adlen, npub, k);
+
+    /* Pad the plaintext and encrypt it.  The padding byte is absorbed
+     * along with the last block and then discarded from the output. */
+    memcpy(buf, m, mlen);
+    memset(buf + mlen, 0, AEAD_SHORT_BUFSIZE - mlen);
+    buf[mlen] = 0x80;
+    AEAD_ENCRYPT_BLOCK(&state, out, buf);
+    if (mlen >= AEAD_RATE) {
+        ascon_permute(&state, AEAD_FIRST_ROUND);
+        AEAD_ENCRYPT_BLOCK(&state, out + AEAD_RATE, buf + AEAD_RATE);
+#if AEAD_RATE == 8
+        if (mlen >= 16U) {
+            ascon_permute(&state, AEAD_FIRST_ROUND);
+            AEAD_ENCRYPT_BLOCK(&state, out + 16, buf + 16);
+        }
+#endif
+    }
+    memcpy(c, out, mlen);
+
+    /* Finalize and compute the authentication tag */
+    AEAD_FINALIZE(&state, k);
+    ascon_squeeze_16(&state, c + mlen, 24);
+    ascon_free(&state);
+    ascon_clean(buf, sizeof(buf));
+    ascon_clean(out, sizeof(out));
+    return 0;
+}
+
+int AEAD_CONCAT(AEAD_ALG_NAME,_decrypt_short)
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const unsigned char *k)
+{
+    ascon_state_t state;
+    unsigned char buf[AEAD_SHORT_BUFSIZE];
+    unsigned char tag[ASCON128_TAG_SIZE];
+    size_t len, full, index;
+    int result;
+
+    /* Validate the parameters */
+    if (clen < ASCON128_TAG_SIZE)
+        return -1;
+    len = clen - ASCON128_TAG_SIZE;
+    if (len > ASCON_AEAD_SHORT_MAX || adlen > ASCON_AEAD_SHORT_MAX)
+        return -2;
+    *mlen = len;
+
+    /* Initialize the state and absorb the associated data */
+    AEAD_CONCAT(AEAD_ALG_NAME,_short_start)(&state, buf, ad, adlen, npub, k);
+
+    /* Decrypt the full blocks directly */
+    full = 0;
+    if (len >= AEAD_RATE) {
+        AEAD_DECRYPT_BLOCK(&state, m, c);
+        ascon_permute(&state, AEAD_FIRST_ROUND);
+        full = AEAD_RATE;
+#if AEAD_RATE == 8
+        if (len >= 16U) {
+            AEAD_DECRYPT_BLOCK(&state, m + 8, c + 8);
+            ascon_permute(&state, AEAD_FIRST_ROUND);
+            full = 16;
+        }
+#endif
+    }
+
+    /* Decrypt the last partial block by squeezing the key stream,
+     * then absorb the padded plaintext to replace the ciphertext bytes
+     * in the state and add the padding at the same time */
+    AEAD_SQUEEZE_BLOCK(&state, buf);
+    for (index = 0; index < (len - full); ++index)
+        buf[index] ^= c[full + index];
+    memset(buf + index, 0, AEAD_RATE - index);
+    buf[index] = 0x80;
+    memcpy(m + full, buf, index);
+    AEAD_ABSORB_BLOCK(&state, buf);
+
+    /* Finalize and check the authentication tag */
+    AEAD_FINALIZE(&state, k);
+    ascon_squeeze_16(&state, tag, 24);
+    result = ascon_aead_check_tag(m, len, tag, c + len, ASCON128_TAG_SIZE);
+    ascon_free(&state);
+    ascon_clean(buf, sizeof(buf));
+    ascon_clean(tag, sizeof(tag));
+    return result;
+}
+
+#endif /* AEAD_ALG_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the AEAD algorithm */
+#undef AEAD_ALG_NAME
+#undef AEAD_RATE
+#undef AEAD_FIRST_ROUND
+#undef AEAD_INIT
+#undef AEAD_FINALIZE
+#undef AEAD_CONCAT_INNER
+#undef AEAD_CONCAT
+#undef AEAD_ABSORB_BLOCK
+#undef AEAD_ENCRYPT_BLOCK
+#undef AEAD_DECRYPT_BLOCK
+#undef AEAD_SQUEEZE_BLOCK
+#undef AEAD_SHORT_BUFSIZE
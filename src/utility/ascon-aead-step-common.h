@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the underlying AEAD variant.
+ *
+ * AEAD_ALG_NAME        Name of the AEAD algorithm; e.g. ascon128_aead
+ * AEAD_STATE_TYPE      Type of the incremental state; e.g. ascon128_state_t
+ * AEAD_RATE            Rate of absorbing and squeezing; e.g. 8
+ *
+ * Each step hands a bounded amount of data to the regular incremental
+ * block functions, which take care of the partial block bookkeeping.
+ */
+#if defined(AEAD_ALG_NAME)
+
+#include "../ascon-aead.h"
+
+#define AEAD_CONCAT_INNER(name,suffix) name##suffix
+#define AEAD_CONCAT(name,suffix) AEAD_CONCAT_INNER(name,suffix)
+
+/* Determine how many bytes to process in the next step.  If the state
+ * is part-way through a rate block, then stop at the end of that block
+ * so that the following steps are aligned on rate block boundaries. */
+static size_t AEAD_CONCAT(AEAD_ALG_NAME,_step_size)
+    (const AEAD_STATE_TYPE *state, const ascon_aead_step_t *step,
+     unsigned max_blocks)
+{
+    size_t len;
+    if (!max_blocks)
+        return step->remaining;
+    len = ((size_t)max_blocks) * AEAD_RATE - state->posn;
+    if (len > step->remaining)
+        len = step->remaining;
+    return len;
+}
+
+size_t AEAD_CONCAT(AEAD_ALG_NAME,_encrypt_step)
+    (AEAD_STATE_TYPE *state, ascon_aead_step_t *step, unsigned max_blocks)
+{
+    size_t len = AEAD_CONCAT(AEAD_ALG_NAME,_step_size)
+        (state, step, max_blocks);
+    if (len > 0) {
+        AEAD_CONCAT(AEAD_ALG_NAME,_encrypt_block)
+            (state, step->in, step->out, len);
+        step->in += len;
+        step->out += len;
+        step->remaining -= len;
+        step->done += len;
+    }
+    return step->remaining;
+}
+
+size_t AEAD_CONCAT(AEAD_ALG_NAME,_decrypt_step)
+    (AEAD_STATE_TYPE *state, ascon_aead_step_t *step, unsigned max_blocks)
+{
+    size_t len = AEAD_CONCAT(AEAD_ALG_NAME,_step_size)
+        (state, step, max_blocks);
+    if (len > 0) {
+        AEAD_CONCAT(AEAD_ALG_NAME,_decrypt_block)
+            (state, step->in, step->out, len);
+        step->in += len;
+        step->out += len;
+        step->remaining -= len;
+        step->done += len;
+    }
+    return step->remaining;
+}
+
+#endif /* AEAD_ALG_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the AEAD algorithm */
+#undef AEAD_ALG_NAME
+#undef AEAD_STATE_TYPE
+#undef AEAD_RATE
+#undef AEAD_CONCAT_INNER
+#undef AEAD_CONCAT
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the underlying AEAD variant.
+ *
+ * STREAM_ALG_NAME      Name of the AEAD algorithm; e.g. ascon128
+ * STREAM_STATE_TYPE    Type of the stream state; e.g. ascon128_stream_state_t
+ * STREAM_TAG_SIZE      Size of the authentication tag; e.g. 16
+ *
+ * Each segment is encrypted or decrypted with the one-shot functions
+ * for the algorithm, using a nonce that is derived from the stream's
+ * nonce prefix, the segment counter, and the last segment flag.
+ */
+#if defined(STREAM_ALG_NAME)
+
+#include "../ascon-aead-stream.h"
+#include "../ascon-utility.h"
+#include <string.h>
+
+#define STREAM_CONCAT_INNER(name,suffix) name##suffix
+#define STREAM_CONCAT(name,suffix) STREAM_CONCAT_INNER(name,suffix)
+
+int STREAM_CONCAT(STREAM_ALG_NAME,_stream_init)
+    (STREAM_STATE_TYPE *state, size_t segment_size,
+     const unsigned char *prefix, const unsigned char *k)
+{
+    if (!segment_size)
+        return -2;
+    memcpy(state->key, k, sizeof(state->key));
+    memcpy(state->nonce, prefix, ASCON_STREAM_PREFIX_SIZE);
+    memset(state->nonce + ASCON_STREAM_PREFIX_SIZE, 0,
+           sizeof(state->nonce) - ASCON_STREAM_PREFIX_SIZE);
+    state->segment_size = segment_size;
+    state->counter = 0;
+    state->finished = 0;
+    return 0;
+}
+
+/**
+ * \brief Checks the length of a segment and sets up its nonce.
+ *
+ * \param state The stream state.
+ * \param index Index of the segment within the stream.
+ * \param len Length of the plaintext in the segment.
+ * \param last Non-zero if this is the last segment of the stream.
+ *
+ * \return 0 if the segment is valid, or -2 if it is not.
+ */
+static int STREAM_CONCAT(STREAM_ALG_NAME,_stream_nonce)
+    (STREAM_STATE_TYPE *state, uint32_t index, size_t len, int last)
+{
+    unsigned char *n = state->nonce + ASCON_STREAM_PREFIX_SIZE;
+    if (len > state->segment_size)
+        return -2;
+    if (!last && (len != state->segment_size || index == 0xFFFFFFFFU))
+        return -2;
+    n[0] = (unsigned char)(index >> 24);
+    n[1] = (unsigned char)(index >> 16);
+    n[2] = (unsigned char)(index >> 8);
+    n[3] = (unsigned char)index;
+    n[4] = last ? 1 : 0;
+    return 0;
+}
+
+int STREAM_CONCAT(STREAM_ALG_NAME,_stream_encrypt)
+    (STREAM_STATE_TYPE *state, unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen, int last)
+{
+    if (state->finished)
+        return -2;
+    if (STREAM_CONCAT(STREAM_ALG_NAME,_stream_nonce)
+            (state, state->counter, mlen, last) < 0)
+        return -2;
+    STREAM_CONCAT(STREAM_ALG_NAME,_aead_encrypt)
+        (c, clen, m, mlen, ad, adlen, state->nonce, state->key);
+    if (last)
+        state->finished = 1;
+    else
+        ++(state->counter);
+    return 0;
+}
+
+int STREAM_CONCAT(STREAM_ALG_NAME,_stream_decrypt_at)
+    (STREAM_STATE_TYPE *state, uint32_t index,
+     unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last)
+{
+    int result;
+    *mlen = 0;
+    if (clen < STREAM_TAG_SIZE)
+        return -2;
+    result = STREAM_CONCAT(STREAM_ALG_NAME,_stream_nonce)
+        (state, index, clen - STREAM_TAG_SIZE, last);
+    if (result < 0)
+        return result;
+    return STREAM_CONCAT(STREAM_ALG_NAME,_aead_decrypt)
+        (m, mlen, c, clen, ad, adlen, state->nonce, state->key);
+}
+
+int STREAM_CONCAT(STREAM_ALG_NAME,_stream_decrypt)
+    (STREAM_STATE_TYPE *state, unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen, int last)
+{
+    int result;
+    if (state->finished) {
+        *mlen = 0;
+        return -2;
+    }
+    result = STREAM_CONCAT(STREAM_ALG_NAME,_stream_decrypt_at)
+        (state, state->counter, m, mlen, c, clen, ad, adlen, last);
+    if (result < 0)
+        return result;
+    if (last)
+        state->finished = 1;
+    else
+        ++(state->counter);
+    return 0;
+}
+
+void STREAM_CONCAT(STREAM_ALG_NAME,_stream_seek)
+    (STREAM_STATE_TYPE *state, uint32_t index)
+{
+    state->counter = index;
+    state->finished = 0;
+}
+
+int STREAM_CONCAT(STREAM_ALG_NAME,_stream_finish)(STREAM_STATE_TYPE *state)
+{
+    int result = state->finished ? 0 : -1;
+    ascon_clean(state, sizeof(STREAM_STATE_TYPE));
+    return result;
+}
+
+#endif /* STREAM_ALG_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the AEAD algorithm */
+#undef STREAM_ALG_NAME
+#undef STREAM_STATE_TYPE
+#undef STREAM_TAG_SIZE
+#undef STREAM_CONCAT_INNER
+#undef STREAM_CONCAT
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-state versions of the ASCON permutation for x86-64 systems that
+ * use AVX2 and AVX-512 instructions to permute 4 or 8 states at once. */
+
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
+#include "ascon-multi.h"
+#include "ascon-util.h"
+
+#if defined(ASCON_BACKEND_AVX2) || defined(ASCON_BACKEND_AVX512)
+#include "ascon-vec.h"
+#include <immintrin.h>
+#endif
+
+#if defined(ASCON_BACKEND_AVX2)
+
+#define ascon_ror_avx2(x, n) \
+    _mm256_or_si256(_mm256_srli_epi64((x), (n)), \
+                    _mm256_slli_epi64((x), 64 - (n)))
+
+/* Loads word i from each of the four states into a vector */
+#define ascon_load_avx2(i) \
+    _mm256_set_epi64x \
+        ((long long)(state3->S[(i)]), (long long)(state2->S[(i)]), \
+         (long long)(state1->S[(i)]), (long long)(state0->S[(i)]))
+
+/* Stores the lanes of a vector back into word i of each state */
+#define ascon_store_avx2(i, x) \
+    do { \
+        _mm256_storeu_si256((__m256i *)temp, (x)); \
+        state0->S[(i)] = temp[0]; \
+        state1->S[(i)] = temp[1]; \
+        state2->S[(i)] = temp[2]; \
+        state3->S[(i)] = temp[3]; \
+    } while (0)
+
+__attribute__((target("avx2")))
+static void ascon_permute_x4_avx2
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    __m256i x0 = ascon_load_avx2(0);
+    __m256i x1 = ascon_load_avx2(1);
+    __m256i x2 = _mm256_xor_si256(ascon_load_avx2(2), ones);
+    __m256i x3 = ascon_load_avx2(3);
+    __m256i x4 = ascon_load_avx2(4);
+    uint64_t temp[4];
+    while (first_round < 12) {
+        ascon_vec_round
+            (__m256i, _mm256_xor_si256, _mm256_andnot_si256, ascon_ror_avx2,
+             x0, x1, x2, x3, x4,
+             _mm256_set1_epi64x((long long)(ascon_vec_rc[first_round])));
+        ++first_round;
+    }
+    ascon_store_avx2(0, x0);
+    ascon_store_avx2(1, x1);
+    ascon_store_avx2(2, _mm256_xor_si256(x2, ones));
+    ascon_store_avx2(3, x3);
+    ascon_store_avx2(4, x4);
+}
+
+/* Permutes four lanes of a structure-of-arrays state.  Each word of the
+ * four lanes is already contiguous, so it is loaded with one instruction */
+__attribute__((target("avx2")))
+static void ascon_permute_soa_x4_avx2
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    __m256i x0 = _mm256_loadu_si256((const __m256i *)S);
+    __m256i x1 = _mm256_loadu_si256((const __m256i *)(S + stride));
+    __m256i x2 = _mm256_xor_si256
+        (_mm256_loadu_si256((const __m256i *)(S + stride * 2)), ones);
+    __m256i x3 = _mm256_loadu_si256((const __m256i *)(S + stride * 3));
+    __m256i x4 = _mm256_loadu_si256((const __m256i *)(S + stride * 4));
+    while (first_round < 12) {
+        ascon_vec_round
+            (__m256i, _mm256_xor_si256, _mm256_andnot_si256, ascon_ror_avx2,
+             x0, x1, x2, x3, x4,
+             _mm256_set1_epi64x((long long)(ascon_vec_rc[first_round])));
+        ++first_round;
+    }
+    _mm256_storeu_si256((__m256i *)S, x0);
+    _mm256_storeu_si256((__m256i *)(S + stride), x1);
+    _mm256_storeu_si256
+        ((__m256i *)(S + stride * 2), _mm256_xor_si256(x2, ones));
+    _mm256_storeu_si256((__m256i *)(S + stride * 3), x3);
+    _mm256_storeu_si256((__m256i *)(S + stride * 4), x4);
+}
+
+#if defined(__AVX2__)
+
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    ascon_permute_x4_avx2(state0, state1, state2, state3, first_round);
+}
+
+void ascon_permute_soa_x4
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    ascon_permute_soa_x4_avx2(S, stride, first_round);
+}
+
+#else /* !__AVX2__ */
+
+/* The implementation is bound the first time ascon_permute_x4() is called,
+ * after which every call goes straight to the implementation */
+
+typedef void (*ascon_permute_x4_t)
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round);
+
+static void ascon_permute_x4_probe
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round);
+
+static ascon_permute_x4_t ascon_permute_x4_impl = ascon_permute_x4_probe;
+
+static void ascon_permute_x4_x2
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    ascon_permute_x2(state0, state1, first_round);
+    ascon_permute_x2(state2, state3, first_round);
+}
+
+static void ascon_permute_x4_probe
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    if (ascon_backend_features() & ASCON_FEATURE_AVX2)
+        ascon_permute_x4_impl = ascon_permute_x4_avx2;
+    else
+        ascon_permute_x4_impl = ascon_permute_x4_x2;
+    (*ascon_permute_x4_impl)(state0, state1, state2, state3, first_round);
+}
+
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    (*ascon_permute_x4_impl)(state0, state1, state2, state3, first_round);
+}
+
+typedef void (*ascon_permute_soa_x4_t)
+    (uint64_t *S, unsigned stride, uint8_t first_round);
+
+static void ascon_permute_soa_x4_probe
+    (uint64_t *S, unsigned stride, uint8_t first_round);
+
+static ascon_permute_soa_x4_t ascon_permute_soa_x4_impl =
+    ascon_permute_soa_x4_probe;
+
+static void ascon_permute_soa_x4_c
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    ascon_permute_soa_generic(S, stride, 4, first_round);
+}
+
+static void ascon_permute_soa_x4_probe
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    if (ascon_backend_features() & ASCON_FEATURE_AVX2)
+        ascon_permute_soa_x4_impl = ascon_permute_soa_x4_avx2;
+    else
+        ascon_permute_soa_x4_impl = ascon_permute_soa_x4_c;
+    (*ascon_permute_soa_x4_impl)(S, stride, first_round);
+}
+
+void ascon_permute_soa_x4
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    (*ascon_permute_soa_x4_impl)(S, stride, first_round);
+}
+
+#endif /* !__AVX2__ */
+
+#endif /* ASCON_BACKEND_AVX2 */
+
+#if defined(ASCON_BACKEND_AVX512)
+
+/* Loads word i from each of the eight states into a vector */
+#define ascon_load_avx512(i) \
+    _mm512_set_epi64 \
+        ((long long)(states[7]->S[(i)]), (long long)(states[6]->S[(i)]), \
+         (long long)(states[5]->S[(i)]), (long long)(states[4]->S[(i)]), \
+         (long long)(states[3]->S[(i)]), (long long)(states[2]->S[(i)]), \
+         (long long)(states[1]->S[(i)]), (long long)(states[0]->S[(i)]))
+
+/* Stores the lanes of a vector back into word i of each state */
+#define ascon_store_avx512(i, x) \
+    do { \
+        _mm512_storeu_si512((void *)temp, (x)); \
+        for (index = 0; index < 8; ++index) \
+            states[index]->S[(i)] = temp[index]; \
+    } while (0)
+
+__attribute__((target("avx512f")))
+static void ascon_permute_x8_avx512
+    (ascon_state_t *states[8], uint8_t first_round)
+{
+    const __m512i ones = _mm512_set1_epi64(-1);
+    __m512i x0 = ascon_load_avx512(0);
+    __m512i x1 = ascon_load_avx512(1);
+    __m512i x2 = _mm512_xor_si512(ascon_load_avx512(2), ones);
+    __m512i x3 = ascon_load_avx512(3);
+    __m512i x4 = ascon_load_avx512(4);
+    uint64_t temp[8];
+    int index;
+    while (first_round < 12) {
+        ascon_vec_round
+            (__m512i, _mm512_xor_si512, _mm512_andnot_si512, _mm512_ror_epi64,
+             x0, x1, x2, x3, x4,
+             _mm512_set1_epi64((long long)(ascon_vec_rc[first_round])));
+        ++first_round;
+    }
+    ascon_store_avx512(0, x0);
+    ascon_store_avx512(1, x1);
+    ascon_store_avx512(2, _mm512_xor_si512(x2, ones));
+    ascon_store_avx512(3, x3);
+    ascon_store_avx512(4, x4);
+}
+
+/* Permutes all lanes of an eight-lane structure-of-arrays state */
+__attribute__((target("avx512f")))
+static void ascon_permute_soa_x8_avx512(uint64_t *S, uint8_t first_round)
+{
+    const __m512i ones = _mm512_set1_epi64(-1);
+    __m512i x0 = _mm512_loadu_si512((const void *)S);
+    __m512i x1 = _mm512_loadu_si512((const void *)(S + 8));
+    __m512i x2 = _mm512_xor_si512
+        (_mm512_loadu_si512((const void *)(S + 16)), ones);
+    __m512i x3 = _mm512_loadu_si512((const void *)(S + 24));
+    __m512i x4 = _mm512_loadu_si512((const void *)(S + 32));
+    while (first_round < 12) {
+        ascon_vec_round
+            (__m512i, _mm512_xor_si512, _mm512_andnot_si512, _mm512_ror_epi64,
+             x0, x1, x2, x3, x4,
+             _mm512_set1_epi64((long long)(ascon_vec_rc[first_round])));
+        ++first_round;
+    }
+    _mm512_storeu_si512((void *)S, x0);
+    _mm512_storeu_si512((void *)(S + 8), x1);
+    _mm512_storeu_si512((void *)(S + 16), _mm512_xor_si512(x2, ones));
+    _mm512_storeu_si512((void *)(S + 24), x3);
+    _mm512_storeu_si512((void *)(S + 32), x4);
+}
+
+#if defined(__AVX512F__)
+
+void ascon_permute_x8(ascon_state_t *states[8], uint8_t first_round)
+{
+    ascon_permute_x8_avx512(states, first_round);
+}
+
+void ascon_permute_soa_x8(uint64_t *S, uint8_t first_round)
+{
+    ascon_permute_soa_x8_avx512(S, first_round);
+}
+
+#else /* !__AVX512F__ */
+
+typedef void (*ascon_permute_x8_t)
+    (ascon_state_t *states[8], uint8_t first_round);
+
+static void ascon_permute_x8_probe
+    (ascon_state_t *states[8], uint8_t first_round);
+
+static ascon_permute_x8_t ascon_permute_x8_impl = ascon_permute_x8_probe;
+
+static void ascon_permute_x8_x4(ascon_state_t *states[8], uint8_t first_round)
+{
+    ascon_permute_x4(states[0], states[1], states[2], states[3], first_round);
+    ascon_permute_x4(states[4], states[5], states[6], states[7], first_round);
+}
+
+static void ascon_permute_x8_probe
+    (ascon_state_t *states[8], uint8_t first_round)
+{
+    if (ascon_backend_features() & ASCON_FEATURE_AVX512)
+        ascon_permute_x8_impl = ascon_permute_x8_avx512;
+    else
+        ascon_permute_x8_impl = ascon_permute_x8_x4;
+    (*ascon_permute_x8_impl)(states, first_round);
+}
+
+void ascon_permute_x8(ascon_state_t *states[8], uint8_t first_round)
+{
+    (*ascon_permute_x8_impl)(states, first_round);
+}
+
+typedef void (*ascon_permute_soa_x8_t)(uint64_t *S, uint8_t first_round);
+
+static void ascon_permute_soa_x8_probe(uint64_t *S, uint8_t first_round);
+
+static ascon_permute_soa_x8_t ascon_permute_soa_x8_impl =
+    ascon_permute_soa_x8_probe;
+
+static void ascon_permute_soa_x8_x4(uint64_t *S, uint8_t first_round)
+{
+    ascon_permute_soa_x4(S, 8, first_round);
+    ascon_permute_soa_x4(S + 4, 8, first_round);
+}
+
+static void ascon_permute_soa_x8_probe(uint64_t *S, uint8_t first_round)
+{
+    if (ascon_backend_features() & ASCON_FEATURE_AVX512)
+        ascon_permute_soa_x8_impl = ascon_permute_soa_x8_avx512;
+    else
+        ascon_permute_soa_x8_impl = ascon_permute_soa_x8_x4;
+    (*ascon_permute_soa_x8_impl)(S, first_round);
+}
+
+void ascon_permute_soa_x8(uint64_t *S, uint8_t first_round)
+{
+    (*ascon_permute_soa_x8_impl)(S, first_round);
+}
+
+#endif /* !__AVX512F__ */
+
+#endif /* ASCON_BACKEND_AVX512 */
+
+/* Point the implementations back at the probe functions so that they are
+ * bound again from the features the next time that they are called */
+void ascon_multi_rebind(void)
+{
+#if defined(ASCON_BACKEND_AVX2) && !defined(__AVX2__)
+    ascon_permute_x4_impl = ascon_permute_x4_probe;
+    ascon_permute_soa_x4_impl = ascon_permute_soa_x4_probe;
+#endif
+#if defined(ASCON_BACKEND_AVX512) && !defined(__AVX512F__)
+    ascon_permute_x8_impl = ascon_permute_x8_probe;
+    ascon_permute_soa_x8_impl = ascon_permute_soa_x8_probe;
+#endif
+}
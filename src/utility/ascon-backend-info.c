@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Information about the permutation back end that was selected at compile
+ * time, and the CPU features that were detected at runtime. */
+
+#include "ascon-multi.h"
+
+const char *ascon_backend_name(void)
+{
+#if defined(ASCON_BACKEND_C64_DIRECT_XOR)
+    return "direct-xor";
+#elif defined(ASCON_BACKEND_C64)
+    return "c64";
+#elif defined(ASCON_BACKEND_C32)
+    return "c32";
+#elif defined(ASCON_BACKEND_AVR5)
+    return "avr5";
+#elif defined(ASCON_BACKEND_ARMV7M)
+    return "armv7m";
+#elif defined(ASCON_BACKEND_ARMV6M)
+    return "armv6m";
+#elif defined(ASCON_BACKEND_XTENSA)
+    return "xtensa";
+#elif defined(ASCON_BACKEND_RISCV32)
+    return "riscv32";
+#else
+    return "unknown";
+#endif
+}
+
+/* Set in the cached features once the CPU has been probed */
+#define ASCON_FEATURE_PROBED 0x8000
+
+/* Cached features of the back end, or zero if not probed yet.  If two
+ * threads race to probe the CPU, then they will both store the same value */
+static volatile unsigned ascon_features = 0;
+
+/* Features that have been turned off or on by calibration */
+static volatile unsigned ascon_features_cleared = 0;
+static volatile unsigned ascon_features_set = 0;
+
+unsigned ascon_backend_features(void)
+{
+    unsigned features = ascon_features;
+    if (!features) {
+        features = ASCON_FEATURE_PROBED;
+#if defined(ASCON_BACKEND_INTERLEAVED)
+        features |= ASCON_FEATURE_INTERLEAVED;
+#endif
+#if defined(ASCON_BACKEND_BULK)
+        features |= ASCON_FEATURE_BULK;
+#endif
+#if (defined(ASCON_BACKEND_AVX2) && !defined(__AVX2__)) || \
+    (defined(ASCON_BACKEND_AVX512) && !defined(__AVX512F__))
+        __builtin_cpu_init();
+#endif
+#if defined(ASCON_BACKEND_AVX2)
+#if defined(__AVX2__)
+        features |= ASCON_FEATURE_AVX2;
+#else
+        if (__builtin_cpu_supports("avx2"))
+            features |= ASCON_FEATURE_AVX2;
+#endif
+#endif
+#if defined(ASCON_BACKEND_AVX512)
+#if defined(__AVX512F__)
+        features |= ASCON_FEATURE_AVX512;
+#else
+        if (__builtin_cpu_supports("avx512f"))
+            features |= ASCON_FEATURE_AVX512;
+#endif
+#endif
+#if defined(ASCON_BACKEND_NEON)
+        features |= ASCON_FEATURE_NEON;
+#endif
+#if defined(ASCON_BACKEND_WASM_SIMD)
+        features |= ASCON_FEATURE_WASM_SIMD;
+#endif
+#if defined(ASCON_BACKEND_MVE)
+        features |= ASCON_FEATURE_MVE;
+#endif
+#if defined(ASCON_RAM_SECTION)
+        features |= ASCON_FEATURE_FAST_RAM;
+#endif
+        ascon_features = features;
+    }
+    features &= ~(ASCON_FEATURE_PROBED | ascon_features_cleared);
+    return features | ascon_features_set;
+}
+
+void ascon_backend_override(unsigned clear, unsigned set)
+{
+    ascon_features_cleared = clear;
+    ascon_features_set = set;
+    ascon_multi_rebind();
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Generic versions of the bulk operations for back ends that do not
+ * provide their own.  These call ascon_permute() for each block. */
+
+/* These are the CPU versions that ASCON_ACCEL falls back to */
+#define ASCON_ACCEL_INTERNAL 1
+
+#include "ascon-bulk.h"
+#include "ascon-util-snp.h"
+
+#if !defined(ASCON_BACKEND_BULK)
+
+ASCON_HOT void ascon_absorb_blocks
+    (ascon_state_t *state, const unsigned char *data, size_t blocks,
+     unsigned rate, uint8_t first_round)
+{
+    if (rate == 16) {
+        while (blocks > 0) {
+            ascon_absorb_16(state, data, 0);
+            ascon_permute(state, first_round);
+            data += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            ascon_absorb_8(state, data, 0);
+            ascon_permute(state, first_round);
+            data += 8;
+            --blocks;
+        }
+    }
+}
+
+ASCON_HOT void ascon_encrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round)
+{
+    if (rate == 16) {
+        while (blocks > 0) {
+            ascon_encrypt_16(state, dest, src, 0);
+            ascon_permute(state, first_round);
+            dest += 16;
+            src += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            ascon_encrypt_8(state, dest, src, 0);
+            ascon_permute(state, first_round);
+            dest += 8;
+            src += 8;
+            --blocks;
+        }
+    }
+}
+
+ASCON_HOT void ascon_decrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round)
+{
+    if (rate == 16) {
+        while (blocks > 0) {
+            ascon_decrypt_16(state, dest, src, 0);
+            ascon_permute(state, first_round);
+            dest += 16;
+            src += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            ascon_decrypt_8(state, dest, src, 0);
+            ascon_permute(state, first_round);
+            dest += 8;
+            src += 8;
+            --blocks;
+        }
+    }
+}
+
+ASCON_HOT void ascon_squeeze_blocks
+    (ascon_state_t *state, unsigned char *dest, size_t blocks,
+     unsigned rate, uint8_t first_round)
+{
+    if (rate == 16) {
+        while (blocks > 0) {
+            ascon_permute(state, first_round);
+            ascon_squeeze_16(state, dest, 0);
+            dest += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            ascon_permute(state, first_round);
+            ascon_squeeze_8(state, dest, 0);
+            dest += 8;
+            --blocks;
+        }
+    }
+}
+
+void ascon_absorb_bits
+    (ascon_state_t *state, const unsigned char *data, unsigned bits,
+     uint8_t first_round)
+{
+    unsigned bit;
+    for (bit = 0; bit < bits; ++bit) {
+        ascon_absorb_bit(state, data[bit / 8], bit % 8);
+        ascon_permute(state, first_round);
+    }
+}
+
+#endif /* !ASCON_BACKEND_BULK */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_BULK_H
+#define ASCON_BULK_H
+
+/* Bulk operations that absorb, encrypt, or decrypt several rate blocks
+ * in a row, permuting the state after each block. */
+
+#include "../ascon-permutation.h"
+#include "ascon-select-backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Absorbs a number of full rate blocks into an ASCON state.
+ *
+ * \param state The ASCON state in "operational" form.
+ * \param data Points to the data to be absorbed.
+ * \param blocks Number of blocks of \a rate bytes to absorb.
+ * \param rate Number of bytes in each block, 8 or 16.
+ * \param first_round First round of the permutation to apply each block.
+ *
+ * The state is permuted after each block, including the last one.
+ */
+void ascon_absorb_blocks
+    (ascon_state_t *state, const unsigned char *data, size_t blocks,
+     unsigned rate, uint8_t first_round);
+
+/**
+ * \brief Encrypts a number of full rate blocks with an ASCON state.
+ *
+ * \param state The ASCON state in "operational" form.
+ * \param dest Points to the destination buffer.
+ * \param src Points to the source buffer.  May be the same as \a dest.
+ * \param blocks Number of blocks of \a rate bytes to encrypt.
+ * \param rate Number of bytes in each block, 8 or 16.
+ * \param first_round First round of the permutation to apply each block.
+ *
+ * The state is permuted after each block, including the last one.
+ */
+void ascon_encrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round);
+
+/**
+ * \brief Decrypts a number of full rate blocks with an ASCON state.
+ *
+ * \param state The ASCON state in "operational" form.
+ * \param dest Points to the destination buffer.
+ * \param src Points to the source buffer.  May be the same as \a dest.
+ * \param blocks Number of blocks of \a rate bytes to decrypt.
+ * \param rate Number of bytes in each block, 8 or 16.
+ * \param first_round First round of the permutation to apply each block.
+ *
+ * The state is permuted after each block, including the last one.
+ */
+void ascon_decrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round);
+
+/**
+ * \brief Squeezes a number of full rate blocks out of an ASCON state.
+ *
+ * \param state The ASCON state in "operational" form.
+ * \param dest Points to the destination buffer.
+ * \param blocks Number of blocks of \a rate bytes to squeeze.
+ * \param rate Number of bytes in each block, 8 or 16.
+ * \param first_round First round of the permutation to apply each block.
+ *
+ * The state is permuted before each block is squeezed, which is the
+ * order used by the XOF modes after the padding has been absorbed.
+ */
+void ascon_squeeze_blocks
+    (ascon_state_t *state, unsigned char *dest, size_t blocks,
+     unsigned rate, uint8_t first_round);
+
+/**
+ * \brief Absorbs a number of single bits into an ASCON state.
+ *
+ * \param state The ASCON state in "operational" form.
+ * \param data Points to the data containing the bits to be absorbed,
+ * starting with the most significant bit of the first byte.
+ * \param bits Number of bits to absorb.
+ * \param first_round First round of the permutation to apply each bit.
+ *
+ * Each bit is XOR'ed into the first bit of the state, which is then
+ * permuted, including after the last bit.  This is the inner loop of
+ * the ISAP re-keying function.
+ */
+void ascon_absorb_bits
+    (ascon_state_t *state, const unsigned char *data, unsigned bits,
+     uint8_t first_round);
+
+/* When the library is compiled with ASCON_ACCEL, long runs of blocks are
+ * offloaded to the hardware accelerator from "ascon-accel.h" if there is
+ * one.  The versions above still handle the runs that stay on the CPU. */
+#if defined(ASCON_ACCEL) && !defined(ASCON_ACCEL_INTERNAL)
+void ascon_accel_absorb_blocks
+    (ascon_state_t *state, const unsigned char *data, size_t blocks,
+     unsigned rate, uint8_t first_round);
+void ascon_accel_encrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round);
+void ascon_accel_decrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round);
+#define ascon_absorb_blocks(state, data, blocks, rate, first_round) \
+    ascon_accel_absorb_blocks \
+        ((state), (data), (blocks), (rate), (first_round))
+#define ascon_encrypt_blocks(state, dest, src, blocks, rate, first_round) \
+    ascon_accel_encrypt_blocks \
+        ((state), (dest), (src), (blocks), (rate), (first_round))
+#define ascon_decrypt_blocks(state, dest, src, blocks, rate, first_round) \
+    ascon_accel_decrypt_blocks \
+        ((state), (dest), (src), (blocks), (rate), (first_round))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,6 +23,9 @@
 /* Plain C implementation of the ASCON permutation for systems with a
  * 32-bit native word size. */
 
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
 #include "../ascon-permutation.h"
 #include "ascon-select-backend.h"
 #include "ascon-sliced32.h"
@@ -33,22 +36,109 @@
 #define ROUND_CONSTANT_PAIR(rc1, rc2) \
     (~((uint32_t)(rc1))), (~((uint32_t)(rc2)))
 
-void ascon_permute(ascon_state_t *state, uint8_t first_round)
+static const uint32_t RC[12 * 2] = {
+    ROUND_CONSTANT_PAIR(12, 12),
+    ROUND_CONSTANT_PAIR( 9, 12),
+    ROUND_CONSTANT_PAIR(12,  9),
+    ROUND_CONSTANT_PAIR( 9,  9),
+    ROUND_CONSTANT_PAIR( 6, 12),
+    ROUND_CONSTANT_PAIR( 3, 12),
+    ROUND_CONSTANT_PAIR( 6,  9),
+    ROUND_CONSTANT_PAIR( 3,  9),
+    ROUND_CONSTANT_PAIR(12,  6),
+    ROUND_CONSTANT_PAIR( 9,  6),
+    ROUND_CONSTANT_PAIR(12,  3),
+    ROUND_CONSTANT_PAIR( 9,  3)
+};
+
+#if defined(ASCON_SMALL)
+
+/* Size-optimized version of the permutation.  The state is kept in an
+ * array so that the s-box and the linear diffusion layer can be applied
+ * to each half and each row in a loop rather than being unrolled. */
+
+/* Rotation amounts for each row of the linear diffusion layer */
+static const uint8_t ROT[5][2] = {
+    {19, 28}, {61, 39}, {1, 6}, {10, 17}, {7, 41}
+};
+
+/* Rotates a 32-bit word right by between 0 and 31 bits */
+#define ror32(x, bits) (((x) >> (bits)) | ((x) << ((32 - (bits)) & 31)))
+
+/* Adds a sliced 64-bit word rotated right by "bits" to x[0] and x[1] */
+static void ascon_add_rotated
+    (uint32_t *x, uint32_t e, uint32_t o, unsigned bits)
+{
+    unsigned half = bits >> 1;
+    if (bits & 1) {
+        x[0] ^= ror32(o, half);
+        x[1] ^= ror32(e, half + 1);
+    } else {
+        x[0] ^= ror32(e, half);
+        x[1] ^= ror32(o, half);
+    }
+}
+
+ASCON_HOT void ascon_permute(ascon_state_t *state, uint8_t first_round)
+{
+    const uint32_t *rc = RC + first_round * 2;
+    uint32_t x[10];
+    uint32_t t[5];
+    uint32_t e, o;
+    unsigned index, row;
+
+    /* Load the state and invert x2 as for the unrolled version below */
+    for (index = 0; index < 10; ++index)
+        x[index] = state->W[index];
+    x[4] = ~x[4];
+    x[5] = ~x[5];
+
+    /* Perform all permutation rounds */
+    while (first_round < 12) {
+        /* Add the round constants for this round to the state */
+        x[4] ^= rc[0];
+        x[5] ^= rc[1];
+        rc += 2;
+
+        /* Substitution layer on the even and then the odd half.
+         * Row "row" of half "index" is at x[row * 2 + index]. */
+        for (index = 0; index < 2; ++index) {
+            uint32_t *y = x + index;
+            y[0] ^= y[8];
+            y[8] ^= y[6];
+            y[4] ^= y[2];
+            for (row = 0; row < 5; ++row)
+                t[row] = (~y[row * 2]) & y[((row + 1) % 5) * 2];
+            for (row = 0; row < 5; ++row)
+                y[row * 2] ^= t[(row + 1) % 5];
+            y[2] ^= y[0];
+            y[0] ^= y[8];
+            y[6] ^= y[4];
+        }
+
+        /* Linear diffusion layer */
+        for (row = 0; row < 5; ++row) {
+            e = x[row * 2];
+            o = x[row * 2 + 1];
+            ascon_add_rotated(x + row * 2, e, o, ROT[row][0]);
+            ascon_add_rotated(x + row * 2, e, o, ROT[row][1]);
+        }
+
+        /* Move onto the next round */
+        ++first_round;
+    }
+
+    /* Apply the final NOT to x2 and write the state back */
+    x[4] = ~x[4];
+    x[5] = ~x[5];
+    for (index = 0; index < 10; ++index)
+        state->W[index] = x[index];
+}
+
+#else /* !ASCON_SMALL */
+
+ASCON_HOT void ascon_permute(ascon_state_t *state, uint8_t first_round)
 {
-    static const uint32_t RC[12 * 2] = {
-        ROUND_CONSTANT_PAIR(12, 12),
-        ROUND_CONSTANT_PAIR( 9, 12),
-        ROUND_CONSTANT_PAIR(12,  9),
-        ROUND_CONSTANT_PAIR( 9,  9),
-        ROUND_CONSTANT_PAIR( 6, 12),
-        ROUND_CONSTANT_PAIR( 3, 12),
-        ROUND_CONSTANT_PAIR( 6,  9),
-        ROUND_CONSTANT_PAIR( 3,  9),
-        ROUND_CONSTANT_PAIR(12,  6),
-        ROUND_CONSTANT_PAIR( 9,  6),
-        ROUND_CONSTANT_PAIR(12,  3),
-        ROUND_CONSTANT_PAIR( 9,  3)
-    };
     const uint32_t *rc = RC + first_round * 2;
     uint32_t t0, t1, t2, t3, t4;
 
@@ -138,4 +228,6 @@ void ascon_permute(ascon_state_t *state, uint8_t first_round)
     state->W[9] = x4_o;
 }
 
+#endif /* !ASCON_SMALL */
+
 #endif /* ASCON_BACKEND_C32 */
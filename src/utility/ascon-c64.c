@@ -23,8 +23,15 @@
 /* Plain C implementation of the ASCON permutation for systems with a
  * 64-bit or better native word size. */
 
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
+/* The bulk operations here are the CPU versions for ASCON_ACCEL */
+#define ASCON_ACCEL_INTERNAL 1
+
 #include "../ascon-permutation.h"
 #include "ascon-select-backend.h"
+#include "ascon-bulk.h"
 #include "ascon-util.h"
 
 #if defined(ASCON_BACKEND_C64) || defined(ASCON_BACKEND_C64_DIRECT_XOR)
@@ -32,77 +39,304 @@
 #define ROUND_CONSTANT(round)   \
         (~(uint64_t)(((0x0F - (round)) << 4) | (round)))
 
-void ascon_permute(ascon_state_t *state, uint8_t first_round)
-{
-    static const uint64_t RC[12] = {
-        ROUND_CONSTANT(0),
-        ROUND_CONSTANT(1),
-        ROUND_CONSTANT(2),
-        ROUND_CONSTANT(3),
-        ROUND_CONSTANT(4),
-        ROUND_CONSTANT(5),
-        ROUND_CONSTANT(6),
-        ROUND_CONSTANT(7),
-        ROUND_CONSTANT(8),
-        ROUND_CONSTANT(9),
-        ROUND_CONSTANT(10),
-        ROUND_CONSTANT(11)
-    };
-    uint64_t t0, t1, t2, t3, t4;
+static const uint64_t RC[12] = {
+    ROUND_CONSTANT(0),
+    ROUND_CONSTANT(1),
+    ROUND_CONSTANT(2),
+    ROUND_CONSTANT(3),
+    ROUND_CONSTANT(4),
+    ROUND_CONSTANT(5),
+    ROUND_CONSTANT(6),
+    ROUND_CONSTANT(7),
+    ROUND_CONSTANT(8),
+    ROUND_CONSTANT(9),
+    ROUND_CONSTANT(10),
+    ROUND_CONSTANT(11)
+};
+
+/* Loads the words of a state into the local variables x0, x1, ..., x4.
+ * The x2 word is inverted as it is loaded; see ascon_round() below. */
 #if defined(ASCON_BACKEND_C64_DIRECT_XOR)
-    uint64_t x0 = be_load_word64(state->B);
-    uint64_t x1 = be_load_word64(state->B + 8);
-    uint64_t x2 = be_load_word64(state->B + 16);
-    uint64_t x3 = be_load_word64(state->B + 24);
-    uint64_t x4 = be_load_word64(state->B + 32);
+#define ascon_load_state(state, x) \
+    do { \
+        x##0 = be_load_word64((state)->B); \
+        x##1 = be_load_word64((state)->B + 8); \
+        x##2 = ~be_load_word64((state)->B + 16); \
+        x##3 = be_load_word64((state)->B + 24); \
+        x##4 = be_load_word64((state)->B + 32); \
+    } while (0)
+#define ascon_store_state(state, x) \
+    do { \
+        be_store_word64((state)->B,      x##0); \
+        be_store_word64((state)->B +  8, x##1); \
+        be_store_word64((state)->B + 16, ~x##2); \
+        be_store_word64((state)->B + 24, x##3); \
+        be_store_word64((state)->B + 32, x##4); \
+    } while (0)
 #else
-    uint64_t x0 = state->S[0];
-    uint64_t x1 = state->S[1];
-    uint64_t x2 = state->S[2];
-    uint64_t x3 = state->S[3];
-    uint64_t x4 = state->S[4];
+#define ascon_load_state(state, x) \
+    do { \
+        x##0 = (state)->S[0]; \
+        x##1 = (state)->S[1]; \
+        x##2 = ~((state)->S[2]); \
+        x##3 = (state)->S[3]; \
+        x##4 = (state)->S[4]; \
+    } while (0)
+#define ascon_store_state(state, x) \
+    do { \
+        (state)->S[0] = x##0; \
+        (state)->S[1] = x##1; \
+        (state)->S[2] = ~x##2; \
+        (state)->S[3] = x##3; \
+        (state)->S[4] = x##4; \
+    } while (0)
 #endif
-    x2 = ~x2;
+
+/* Performs a single round of the permutation on the words x0, ..., x4 */
+#define ascon_round(x, rc) \
+    do { \
+        uint64_t t0, t1, t2, t3, t4; \
+        \
+        /* Add the round constant to the state */ \
+        x##2 ^= (rc); \
+        \
+        /* Substitution layer - apply the s-box using bit-slicing \
+         * according to the algorithm recommended in the specification. \
+         * \
+         * The final "x2 = ~x2" term will be implicitly performed \
+         * by the inverted round constant for the next round. \
+         */ \
+        x##0 ^= x##4;   x##4 ^= x##3;   x##2 ^= x##1; \
+        t0 = ~x##0;     t1 = ~x##1;     t2 = ~x##2; \
+        t3 = ~x##3;     t4 = ~x##4; \
+        t0 &= x##1;     t1 &= x##2;     t2 &= x##3; \
+        t3 &= x##4;     t4 &= x##0; \
+        x##0 ^= t1;     x##1 ^= t2;     x##2 ^= t3; \
+        x##3 ^= t4;     x##4 ^= t0; \
+        x##1 ^= x##0;   x##0 ^= x##4;   x##3 ^= x##2; /* x2 = ~x2; */ \
+        \
+        /* Linear diffusion layer */ \
+        x##0 ^= rightRotate19_64(x##0) ^ rightRotate28_64(x##0); \
+        x##1 ^= rightRotate61_64(x##1) ^ rightRotate39_64(x##1); \
+        x##2 ^= rightRotate1_64(x##2)  ^ rightRotate6_64(x##2); \
+        x##3 ^= rightRotate10_64(x##3) ^ rightRotate17_64(x##3); \
+        x##4 ^= rightRotate7_64(x##4)  ^ rightRotate41_64(x##4); \
+    } while (0)
+
+void ascon_permute(ascon_state_t *state, uint8_t first_round)
+{
+    uint64_t x0, x1, x2, x3, x4;
+    ascon_load_state(state, x);
     while (first_round < 12) {
-        /* Add the round constant to the state */
-        x2 ^= RC[first_round];
-
-        /* Substitution layer - apply the s-box using bit-slicing
-         * according to the algorithm recommended in the specification.
-         *
-         * The final "x2 = ~x2" term will be implicitly performed
-         * by the inverted round constant for the next round.
-         */
-        x0 ^= x4;   x4 ^= x3;   x2 ^= x1;
-        t0 = ~x0;   t1 = ~x1;   t2 = ~x2;   t3 = ~x3;   t4 = ~x4;
-        t0 &= x1;   t1 &= x2;   t2 &= x3;   t3 &= x4;   t4 &= x0;
-        x0 ^= t1;   x1 ^= t2;   x2 ^= t3;   x3 ^= t4;   x4 ^= t0;
-        x1 ^= x0;   x0 ^= x4;   x3 ^= x2;   /* x2 = ~x2; */
-
-        /* Linear diffusion layer */
-        x0 ^= rightRotate19_64(x0) ^ rightRotate28_64(x0);
-        x1 ^= rightRotate61_64(x1) ^ rightRotate39_64(x1);
-        x2 ^= rightRotate1_64(x2)  ^ rightRotate6_64(x2);
-        x3 ^= rightRotate10_64(x3) ^ rightRotate17_64(x3);
-        x4 ^= rightRotate7_64(x4)  ^ rightRotate41_64(x4);
-
-        /* Move onto the next round */
+        ascon_round(x, RC[first_round]);
         ++first_round;
     }
-    x2 = ~x2;
-#if defined(ASCON_BACKEND_C64_DIRECT_XOR)
-    be_store_word64(state->B,      x0);
-    be_store_word64(state->B +  8, x1);
-    be_store_word64(state->B + 16, x2);
-    be_store_word64(state->B + 24, x3);
-    be_store_word64(state->B + 32, x4);
-#else
-    state->S[0] = x0;
-    state->S[1] = x1;
-    state->S[2] = x2;
-    state->S[3] = x3;
-    state->S[4] = x4;
-#endif
+    ascon_store_state(state, x);
 }
 
+/* The multi-state versions run the rounds for each state side by side.
+ * The states are independent so there are no data dependencies between
+ * the instructions for each state, which gives out-of-order and
+ * superscalar CPU's more opportunities to execute them in parallel. */
+
+#if defined(ASCON_BACKEND_INTERLEAVED) && \
+    !defined(ASCON_BACKEND_NEON) && !defined(ASCON_BACKEND_WASM_SIMD)
+
+void ascon_permute_x2
+    (ascon_state_t *state0, ascon_state_t *state1, uint8_t first_round)
+{
+    uint64_t a0, a1, a2, a3, a4;
+    uint64_t b0, b1, b2, b3, b4;
+    uint64_t rc;
+    ascon_load_state(state0, a);
+    ascon_load_state(state1, b);
+    while (first_round < 12) {
+        rc = RC[first_round];
+        ascon_round(a, rc);
+        ascon_round(b, rc);
+        ++first_round;
+    }
+    ascon_store_state(state0, a);
+    ascon_store_state(state1, b);
+}
+
+#endif /* ASCON_BACKEND_INTERLEAVED && !NEON && !WASM_SIMD */
+
+#if defined(ASCON_BACKEND_INTERLEAVED) && \
+    !defined(ASCON_BACKEND_AVX2) && !defined(ASCON_BACKEND_NEON) && \
+    !defined(ASCON_BACKEND_WASM_SIMD)
+
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    uint64_t a0, a1, a2, a3, a4;
+    uint64_t b0, b1, b2, b3, b4;
+    uint64_t c0, c1, c2, c3, c4;
+    uint64_t d0, d1, d2, d3, d4;
+    uint64_t rc;
+    ascon_load_state(state0, a);
+    ascon_load_state(state1, b);
+    ascon_load_state(state2, c);
+    ascon_load_state(state3, d);
+    while (first_round < 12) {
+        rc = RC[first_round];
+        ascon_round(a, rc);
+        ascon_round(b, rc);
+        ascon_round(c, rc);
+        ascon_round(d, rc);
+        ++first_round;
+    }
+    ascon_store_state(state0, a);
+    ascon_store_state(state1, b);
+    ascon_store_state(state2, c);
+    ascon_store_state(state3, d);
+}
+
+#endif /* ASCON_BACKEND_INTERLEAVED && !AVX2 && !NEON && !WASM_SIMD */
+
+#if defined(ASCON_BACKEND_BULK)
+
+/* The bulk operations keep the state in local variables for the whole
+ * run of blocks rather than loading and storing it around every call to
+ * ascon_permute().  The rate words are x0 and x1 in big-endian order. */
+
+/* Performs the rounds of the permutation from "first_round" onwards */
+#define ascon_rounds(x, first_round) \
+    do { \
+        uint8_t round; \
+        for (round = (first_round); round < 12; ++round) \
+            ascon_round(x, RC[round]); \
+    } while (0)
+
+void ascon_absorb_blocks
+    (ascon_state_t *state, const unsigned char *data, size_t blocks,
+     unsigned rate, uint8_t first_round)
+{
+    uint64_t x0, x1, x2, x3, x4;
+    ascon_load_state(state, x);
+    if (rate == 16) {
+        while (blocks > 0) {
+            x0 ^= be_load_word64(data);
+            x1 ^= be_load_word64(data + 8);
+            ascon_rounds(x, first_round);
+            data += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            x0 ^= be_load_word64(data);
+            ascon_rounds(x, first_round);
+            data += 8;
+            --blocks;
+        }
+    }
+    ascon_store_state(state, x);
+}
+
+void ascon_encrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round)
+{
+    uint64_t x0, x1, x2, x3, x4;
+    ascon_load_state(state, x);
+    if (rate == 16) {
+        while (blocks > 0) {
+            x0 ^= be_load_word64(src);
+            x1 ^= be_load_word64(src + 8);
+            be_store_word64(dest, x0);
+            be_store_word64(dest + 8, x1);
+            ascon_rounds(x, first_round);
+            dest += 16;
+            src += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            x0 ^= be_load_word64(src);
+            be_store_word64(dest, x0);
+            ascon_rounds(x, first_round);
+            dest += 8;
+            src += 8;
+            --blocks;
+        }
+    }
+    ascon_store_state(state, x);
+}
+
+void ascon_decrypt_blocks
+    (ascon_state_t *state, unsigned char *dest, const unsigned char *src,
+     size_t blocks, unsigned rate, uint8_t first_round)
+{
+    uint64_t x0, x1, x2, x3, x4;
+    uint64_t c0, c1;
+    ascon_load_state(state, x);
+    if (rate == 16) {
+        while (blocks > 0) {
+            c0 = be_load_word64(src);
+            c1 = be_load_word64(src + 8);
+            be_store_word64(dest, x0 ^ c0);
+            be_store_word64(dest + 8, x1 ^ c1);
+            x0 = c0;
+            x1 = c1;
+            ascon_rounds(x, first_round);
+            dest += 16;
+            src += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            c0 = be_load_word64(src);
+            be_store_word64(dest, x0 ^ c0);
+            x0 = c0;
+            ascon_rounds(x, first_round);
+            dest += 8;
+            src += 8;
+            --blocks;
+        }
+    }
+    ascon_store_state(state, x);
+}
+
+void ascon_squeeze_blocks
+    (ascon_state_t *state, unsigned char *dest, size_t blocks,
+     unsigned rate, uint8_t first_round)
+{
+    uint64_t x0, x1, x2, x3, x4;
+    ascon_load_state(state, x);
+    if (rate == 16) {
+        while (blocks > 0) {
+            ascon_rounds(x, first_round);
+            be_store_word64(dest, x0);
+            be_store_word64(dest + 8, x1);
+            dest += 16;
+            --blocks;
+        }
+    } else {
+        while (blocks > 0) {
+            ascon_rounds(x, first_round);
+            be_store_word64(dest, x0);
+            dest += 8;
+            --blocks;
+        }
+    }
+    ascon_store_state(state, x);
+}
+
+void ascon_absorb_bits
+    (ascon_state_t *state, const unsigned char *data, unsigned bits,
+     uint8_t first_round)
+{
+    uint64_t x0, x1, x2, x3, x4;
+    unsigned bit;
+    ascon_load_state(state, x);
+    for (bit = 0; bit < bits; ++bit) {
+        x0 ^= ((uint64_t)((data[bit / 8] << (bit % 8)) & 0x80)) << 56;
+        ascon_rounds(x, first_round);
+    }
+    ascon_store_state(state, x);
+}
+
+#endif /* ASCON_BACKEND_BULK */
+
 #endif /* ASCON_BACKEND_C64 */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Boot-time calibration of the permutation kernels.  The kernels are
+ * timed with a clock that is supplied by the application, and the fastest
+ * multi-state permutations are bound through ascon_backend_override(). */
+
+/* Permutation calls made during calibration are not counted in the
+ * statistics */
+#define ASCON_STATS_INTERNAL 1
+
+#include "ascon-multi.h"
+#if ASCON_ENABLE_MASKING
+#include "ascon-masked-state.h"
+#include "ascon-masked-config.h"
+#endif
+#include <string.h>
+
+/* Identifiers for the kernels that can be timed */
+#define ASCON_KERNEL_X1         0
+#define ASCON_KERNEL_X4         1
+#define ASCON_KERNEL_X8         2
+#define ASCON_KERNEL_MASKED_X2  3
+#define ASCON_KERNEL_MASKED_X3  4
+#define ASCON_KERNEL_MASKED_X4  5
+
+/* Number of kernel calls between reads of the clock */
+#define ASCON_CALIBRATE_CALLS 8
+
+/* Working state for the calibration */
+typedef struct
+{
+    ascon_calibrate_clock_t clock;
+    unsigned long budget;
+    ascon_state_t states[8];
+    ascon_state_t *ptrs[8];
+#if ASCON_ENABLE_MASKING
+    ascon_masked_state_t masked;
+    uint64_t preserve[3];
+#endif
+    ascon_calibration_t results[ASCON_CALIBRATION_MAX_RESULTS];
+    unsigned count;
+
+} ascon_calibrate_state_t;
+
+/* Runs a kernel and returns the number of states that were permuted */
+static unsigned long ascon_calibrate_run
+    (ascon_calibrate_state_t *cal, int kernel)
+{
+    ascon_state_t **s = cal->ptrs;
+    switch (kernel) {
+    case ASCON_KERNEL_X1:
+        ascon_permute(s[0], 0);
+        return 1;
+    case ASCON_KERNEL_X4:
+        ascon_permute_x4(s[0], s[1], s[2], s[3], 0);
+        return 4;
+    case ASCON_KERNEL_X8:
+        ascon_permute_x8(s, 0);
+        return 8;
+#if ASCON_ENABLE_MASKING
+    case ASCON_KERNEL_MASKED_X2:
+        ascon_x2_permute(&(cal->masked), 0, cal->preserve);
+        return 1;
+#if ASCON_MASKED_KEY_SHARES >= 3
+    case ASCON_KERNEL_MASKED_X3:
+        ascon_x3_permute(&(cal->masked), 0, cal->preserve);
+        return 1;
+#endif
+#if ASCON_MASKED_KEY_SHARES >= 4
+    case ASCON_KERNEL_MASKED_X4:
+        ascon_x4_permute(&(cal->masked), 0, cal->preserve);
+        return 1;
+#endif
+#endif
+    default: break;
+    }
+    return 0;
+}
+
+/* Times a kernel for the budget and records the result */
+static ascon_calibration_t *ascon_calibrate_time
+    (ascon_calibrate_state_t *cal, int kernel, const char *name)
+{
+    ascon_calibration_t *result = &(cal->results[cal->count++]);
+    unsigned long start, elapsed, permutations;
+    unsigned index;
+
+    /* Warm up the caches and the branch predictors first */
+    ascon_calibrate_run(cal, kernel);
+
+    /* Run the kernel in groups of calls until the budget has elapsed */
+    permutations = 0;
+    start = (*(cal->clock))();
+    do {
+        for (index = 0; index < ASCON_CALIBRATE_CALLS; ++index)
+            permutations += ascon_calibrate_run(cal, kernel);
+        elapsed = (*(cal->clock))() - start;
+    } while (elapsed < cal->budget);
+
+    result->name = name;
+    result->permutations = permutations;
+    result->elapsed = elapsed;
+    result->selected = 1;
+    return result;
+}
+
+#if (defined(ASCON_BACKEND_AVX2) && !defined(__AVX2__)) || \
+    (defined(ASCON_BACKEND_AVX512) && !defined(__AVX512F__))
+
+/* Determine if result "a" has a higher permutation rate than "b" */
+static int ascon_calibrate_faster
+    (const ascon_calibration_t *a, const ascon_calibration_t *b)
+{
+    return ((uint64_t)(a->permutations)) * b->elapsed >
+           ((uint64_t)(b->permutations)) * a->elapsed;
+}
+
+/* Times a kernel with and without a feature and returns the feature
+ * if the version without it is faster, or zero otherwise */
+static unsigned ascon_calibrate_choose
+    (ascon_calibrate_state_t *cal, int kernel, unsigned feature,
+     unsigned cleared, const char *with_name, const char *without_name)
+{
+    ascon_calibration_t *with;
+    ascon_calibration_t *without;
+    ascon_backend_override(cleared, ASCON_FEATURE_CALIBRATED);
+    with = ascon_calibrate_time(cal, kernel, with_name);
+    ascon_backend_override(cleared | feature, ASCON_FEATURE_CALIBRATED);
+    without = ascon_calibrate_time(cal, kernel, without_name);
+    if (ascon_calibrate_faster(without, with)) {
+        with->selected = 0;
+        return feature;
+    }
+    without->selected = 0;
+    return 0;
+}
+
+#endif
+
+unsigned ascon_backend_calibrate
+    (ascon_calibrate_clock_t clock, unsigned long budget,
+     ascon_calibration_t *results, unsigned max_results)
+{
+    ascon_calibrate_state_t cal;
+    unsigned cleared = 0;
+    unsigned features;
+    unsigned index;
+
+    /* Set up the states to permute */
+    memset(&cal, 0, sizeof(cal));
+    cal.clock = clock;
+    cal.budget = budget ? budget : 1;
+    for (index = 0; index < 8; ++index) {
+        ascon_init(&(cal.states[index]));
+        cal.ptrs[index] = &(cal.states[index]);
+    }
+#if ASCON_ENABLE_MASKING
+    ascon_masked_state_init(&(cal.masked));
+#endif
+
+    /* Start from the features of the CPU without any previous override */
+    ascon_backend_override(0, 0);
+    features = ascon_backend_features();
+    (void)features;
+
+    /* The single-state permutation is always selected at compile time */
+    ascon_calibrate_time(&cal, ASCON_KERNEL_X1, "x1");
+
+    /* Choose between AVX2 and pairs of ascon_permute_x2() for four states */
+#if defined(ASCON_BACKEND_AVX2) && !defined(__AVX2__)
+    if (features & ASCON_FEATURE_AVX2) {
+        cleared |= ascon_calibrate_choose
+            (&cal, ASCON_KERNEL_X4, ASCON_FEATURE_AVX2, cleared,
+             "x4-avx2", "x4-x2");
+    } else
+#endif
+    {
+        ascon_calibrate_time(&cal, ASCON_KERNEL_X4, "x4");
+    }
+
+    /* Choose between AVX-512 and pairs of ascon_permute_x4() for eight
+     * states, using the version of ascon_permute_x4() chosen above */
+#if defined(ASCON_BACKEND_AVX512) && !defined(__AVX512F__)
+    if (features & ASCON_FEATURE_AVX512) {
+        cleared |= ascon_calibrate_choose
+            (&cal, ASCON_KERNEL_X8, ASCON_FEATURE_AVX512, cleared,
+             "x8-avx512", "x8-x4");
+    } else
+#endif
+    {
+        ascon_calibrate_time(&cal, ASCON_KERNEL_X8, "x8");
+    }
+
+    /* Bind the winners */
+    ascon_backend_override(cleared, ASCON_FEATURE_CALIBRATED);
+
+    /* Report on the masked permutations without changing anything */
+#if ASCON_ENABLE_MASKING
+    ascon_calibrate_time(&cal, ASCON_KERNEL_MASKED_X2, "masked-x2");
+#if ASCON_MASKED_KEY_SHARES >= 3
+    ascon_calibrate_time(&cal, ASCON_KERNEL_MASKED_X3, "masked-x3");
+#endif
+#if ASCON_MASKED_KEY_SHARES >= 4
+    ascon_calibrate_time(&cal, ASCON_KERNEL_MASKED_X4, "masked-x4");
+#endif
+    ascon_masked_state_free(&(cal.masked));
+#endif
+
+    /* Clean up and return the results to the caller */
+    for (index = 0; index < 8; ++index)
+        ascon_free(&(cal.states[index]));
+    if (!results)
+        return 0;
+    if (max_results > cal.count)
+        max_results = cal.count;
+    memcpy(results, cal.results, max_results * sizeof(ascon_calibration_t));
+    return max_results;
+}
@@ -57,6 +57,7 @@ void ascon_init(ascon_state_t *state)
 
 void ascon_free(ascon_state_t *state)
 {
+    ascon_scope_end(state);
 #if defined(ASCON_CHECK_ACQUIRE_RELEASE)
     if (!acquired) {
         fprintf(stderr, "acquire and release operations are not balanced\n");
@@ -136,6 +137,7 @@ void ascon_extract_and_overwrite_bytes
 
 void ascon_release(ascon_state_t *state)
 {
+    ascon_scope_elide(state);
     /* Not needed in this implementation */
     (void)state;
 #if defined(ASCON_CHECK_ACQUIRE_RELEASE)
@@ -149,6 +151,7 @@ void ascon_release(ascon_state_t *state)
 
 void ascon_acquire(ascon_state_t *state)
 {
+    ascon_scope_elide(state);
     /* Not needed in this implementation */
     (void)state;
 #if defined(ASCON_CHECK_ACQUIRE_RELEASE)
@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* We expect a number of macros to be defined before this file
+ * is included to configure the underlying hash variant.
+ *
+ * HASH_ALG_NAME        Name of the hash algorithm; e.g. ascon_hash
+ * HASH_XOF_STATE       Type of the underlying XOF state.
+ * HASH_XOF_INIT_FIXED  Name of the XOF fixed-length initialization function.
+ * HASH_FIRST_ROUND     First round of the permutation between blocks.
+ *                      The permutation after padding always has 12 rounds.
+ *
+ * The hash output is assumed to be ASCON_HASH_SIZE bytes in size.
+ */
+#if defined(HASH_ALG_NAME)
+
+#include "ascon-multi.h"
+#include "ascon-util-snp.h"
+#include "ascon-x64.h"
+#include "../ascon-utility.h"
+#include <string.h>
+
+#define HASH_CONCAT_INNER(name,suffix) name##suffix
+#define HASH_CONCAT(name,suffix) HASH_CONCAT_INNER(name,suffix)
+
+#if defined(ASCON_SOA_LANES) && HASH_FIRST_ROUND == 0
+
+/* Every permutation has 12 rounds, so all lanes can be permuted together
+ * in a structure-of-arrays state without gathering and scattering the
+ * words of separate states on each call.  Lanes without a message are
+ * permuted along with the others, which costs nothing extra. */
+
+#if ASCON_SOA_LANES == 8
+#define HASH_SOA_STATE ascon_state_x8_t
+#define HASH_SOA_PERMUTE ascon_state_x8_permute
+#else
+#define HASH_SOA_STATE ascon_state_x4_t
+#define HASH_SOA_PERMUTE ascon_state_x4_permute
+#endif
+
+/* Information about a message that is being hashed in a lane */
+typedef struct
+{
+    const unsigned char *in;
+    unsigned char *out;
+    size_t len;
+    unsigned posn;
+    int squeezing;
+    int active;
+
+} HASH_CONCAT(HASH_ALG_NAME,_soa_lane_t);
+
+void HASH_CONCAT(HASH_ALG_NAME,_many)
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count)
+{
+    HASH_CONCAT(HASH_ALG_NAME,_soa_lane_t) lanes[ASCON_SOA_LANES];
+    HASH_SOA_STATE soa;
+    HASH_XOF_STATE xof;
+    uint64_t iv[5];
+    unsigned char block[40];
+    unsigned num_active = 0;
+    unsigned index, word;
+
+    /* Get the state after the initial permutation in standard form */
+    HASH_XOF_INIT_FIXED(&xof, ASCON_HASH_SIZE);
+    ascon_acquire(&(xof.state));
+    ascon_extract_bytes(&(xof.state), block, 0, 40);
+    ascon_free(&(xof.state));
+    for (word = 0; word < 5; ++word)
+        iv[word] = be_load_word64(block + word * 8);
+
+    /* All lanes start out empty */
+    for (index = 0; index < ASCON_SOA_LANES; ++index)
+        lanes[index].active = 0;
+    memset(&soa, 0, sizeof(soa));
+
+    for (;;) {
+        /* Fill up any empty lanes with new messages and absorb the next
+         * block of input, pad the last block, or squeeze the output */
+        for (index = 0; index < ASCON_SOA_LANES; ++index) {
+            HASH_CONCAT(HASH_ALG_NAME,_soa_lane_t) *lane = &(lanes[index]);
+            uint64_t *x0 = &(soa.S[0][index]);
+            if (lane->active && lane->squeezing) {
+                be_store_word64(lane->out + lane->posn, *x0);
+                lane->posn += ASCON_XOF_RATE;
+                if (lane->posn < ASCON_HASH_SIZE)
+                    continue;
+                lane->active = 0;
+                --num_active;
+            }
+            if (!lane->active) {
+                if (count == 0)
+                    continue;
+                for (word = 0; word < 5; ++word)
+                    soa.S[word][index] = iv[word];
+                lane->in = *in++;
+                lane->out = out;
+                lane->len = *inlen++;
+                lane->posn = 0;
+                lane->squeezing = 0;
+                lane->active = 1;
+                out += ASCON_HASH_SIZE;
+                --count;
+                ++num_active;
+            }
+            if (lane->len >= ASCON_XOF_RATE) {
+                *x0 ^= be_load_word64(lane->in);
+                lane->in += ASCON_XOF_RATE;
+                lane->len -= ASCON_XOF_RATE;
+            } else {
+                memset(block, 0, 8);
+                if (lane->len > 0)
+                    memcpy(block, lane->in, lane->len);
+                block[lane->len] = 0x80;
+                *x0 ^= be_load_word64(block);
+                lane->squeezing = 1;
+            }
+        }
+        if (!num_active)
+            break;
+
+        /* Permute all lanes together */
+        HASH_SOA_PERMUTE(&soa, 0);
+    }
+    ascon_clean(&soa, sizeof(soa));
+    ascon_clean(block, sizeof(block));
+}
+
+#undef HASH_SOA_STATE
+#undef HASH_SOA_PERMUTE
+
+#else /* !ASCON_SOA_LANES || HASH_FIRST_ROUND != 0 */
+
+/* Information about a message that is being hashed in a lane */
+typedef struct
+{
+    HASH_XOF_STATE xof;
+    const unsigned char *in;
+    unsigned char *out;
+    size_t len;
+    unsigned posn;
+    int squeezing;
+    uint8_t first_round;
+
+} HASH_CONCAT(HASH_ALG_NAME,_lane_t);
+
+/**
+ * \brief Advances a lane to the point where it next needs a permutation.
+ *
+ * \param lane The lane to advance.
+ *
+ * \return Zero if the lane needs a permutation, or 1 if the
+ * message has been fully hashed.
+ */
+static int HASH_CONCAT(HASH_ALG_NAME,_lane_step)
+    (HASH_CONCAT(HASH_ALG_NAME,_lane_t) *lane)
+{
+    ascon_state_t *state = &(lane->xof.state);
+    if (!lane->squeezing) {
+        /* Absorb the next block of input, or pad the last block */
+        if (lane->len >= ASCON_XOF_RATE) {
+            ascon_absorb_8(state, lane->in, 0);
+            lane->in += ASCON_XOF_RATE;
+            lane->len -= ASCON_XOF_RATE;
+            lane->first_round = HASH_FIRST_ROUND;
+        } else {
+            if (lane->len > 0) {
+                ascon_absorb_partial
+                    (state, lane->in, 0, (unsigned)(lane->len));
+            }
+            ascon_pad(state, (unsigned)(lane->len));
+            lane->squeezing = 1;
+            lane->first_round = 0;
+        }
+        return 0;
+    }
+
+    /* Squeeze out the next block of the hash value */
+    ascon_squeeze_8(state, lane->out + lane->posn, 0);
+    lane->posn += ASCON_XOF_RATE;
+    if (lane->posn >= ASCON_HASH_SIZE) {
+        ascon_free(state);
+        return 1;
+    }
+    lane->first_round = HASH_FIRST_ROUND;
+    return 0;
+}
+
+/**
+ * \brief Hashes a list of messages with the multi-state permutations.
+ *
+ * \param out Buffer to receive the hash value of each message in turn.
+ * \param in Points to the messages.
+ * \param inlen Points to the lengths of the messages.
+ * \param count Number of messages.
+ */
+static void HASH_CONCAT(HASH_ALG_NAME,_many_lanes)
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count)
+{
+    HASH_CONCAT(HASH_ALG_NAME,_lane_t) lanes[ASCON_MULTI_LANES];
+    HASH_CONCAT(HASH_ALG_NAME,_lane_t) *active[ASCON_MULTI_LANES];
+    ascon_state_t *full[ASCON_MULTI_LANES];
+    ascon_state_t *reduced[ASCON_MULTI_LANES];
+    unsigned num_active = 0;
+    unsigned num_full, num_reduced, index;
+
+    /* Lanes that are not in use are kept at the end of the active list */
+    for (index = 0; index < ASCON_MULTI_LANES; ++index)
+        active[index] = &(lanes[index]);
+
+    for (;;) {
+        /* Fill up any empty lanes with new messages.  The IV has already
+         * been permuted, so the first block can be absorbed immediately */
+        while (num_active < ASCON_MULTI_LANES && count > 0) {
+            HASH_CONCAT(HASH_ALG_NAME,_lane_t) *lane = active[num_active++];
+            HASH_XOF_INIT_FIXED(&(lane->xof), ASCON_HASH_SIZE);
+            ascon_acquire(&(lane->xof.state));
+            lane->in = *in++;
+            lane->out = out;
+            lane->len = *inlen++;
+            lane->posn = 0;
+            lane->squeezing = 0;
+            HASH_CONCAT(HASH_ALG_NAME,_lane_step)(lane);
+            out += ASCON_HASH_SIZE;
+            --count;
+        }
+        if (!num_active)
+            break;
+
+        /* Permute all active lanes, grouped by the number of rounds */
+        num_full = 0;
+        num_reduced = 0;
+        for (index = 0; index < num_active; ++index) {
+            if (active[index]->first_round == 0)
+                full[num_full++] = &(active[index]->xof.state);
+            else
+                reduced[num_reduced++] = &(active[index]->xof.state);
+        }
+        ascon_permute_multi(full, num_full, 0);
+        ascon_permute_multi(reduced, num_reduced, HASH_FIRST_ROUND);
+
+        /* Advance all lanes to the next permutation and retire the
+         * lanes whose messages have been fully hashed */
+        index = 0;
+        while (index < num_active) {
+            HASH_CONCAT(HASH_ALG_NAME,_lane_t) *lane = active[index];
+            if (HASH_CONCAT(HASH_ALG_NAME,_lane_step)(lane)) {
+                active[index] = active[--num_active];
+                active[num_active] = lane;
+            } else {
+                ++index;
+            }
+        }
+    }
+}
+
+void HASH_CONCAT(HASH_ALG_NAME,_many)
+    (unsigned char *out, const unsigned char * const *in,
+     const size_t *inlen, size_t count)
+{
+#if defined(ASCON_X64_LANES)
+    HASH_XOF_STATE xof;
+    uint64_t iv[5];
+    unsigned char block[40];
+    size_t done = 0;
+    size_t posn = 0;
+    size_t run;
+    unsigned word;
+
+    /* Get the state after the initial permutation in standard form */
+    if (count >= ASCON_X64_MIN_BATCH) {
+        HASH_XOF_INIT_FIXED(&xof, ASCON_HASH_SIZE);
+        ascon_acquire(&(xof.state));
+        ascon_extract_bytes(&(xof.state), block, 0, 40);
+        ascon_free(&(xof.state));
+        for (word = 0; word < 5; ++word)
+            iv[word] = be_load_word64(block + word * 8);
+        ascon_clean(block, sizeof(block));
+    }
+
+    /* Groups of messages with the same length go to the bitsliced engine
+     * and the messages in between are hashed a few lanes at a time */
+    while ((count - posn) >= ASCON_X64_MIN_BATCH) {
+        run = 1;
+        while (run < ASCON_X64_LANES && (posn + run) < count &&
+               inlen[posn + run] == inlen[posn]) {
+            ++run;
+        }
+        if (run < ASCON_X64_MIN_BATCH) {
+            posn += run;
+            continue;
+        }
+        if (done < posn) {
+            HASH_CONCAT(HASH_ALG_NAME,_many_lanes)
+                (out + done * ASCON_HASH_SIZE, in + done, inlen + done,
+                 posn - done);
+        }
+        ascon_x64_hash(out + posn * ASCON_HASH_SIZE, in + posn, inlen[posn],
+                       (unsigned)run, iv, HASH_FIRST_ROUND);
+        posn += run;
+        done = posn;
+    }
+    if (done < count) {
+        HASH_CONCAT(HASH_ALG_NAME,_many_lanes)
+            (out + done * ASCON_HASH_SIZE, in + done, inlen + done,
+             count - done);
+    }
+#else
+    HASH_CONCAT(HASH_ALG_NAME,_many_lanes)(out, in, inlen, count);
+#endif
+}
+
+#endif /* !ASCON_SOA_LANES || HASH_FIRST_ROUND != 0 */
+
+#endif /* HASH_ALG_NAME */
+
+/* Now undefine everything so that we can include this file again for
+ * another variant on the hash algorithm */
+#undef HASH_ALG_NAME
+#undef HASH_XOF_STATE
+#undef HASH_XOF_INIT_FIXED
+#undef HASH_FIRST_ROUND
+#undef HASH_CONCAT_INNER
+#undef HASH_CONCAT
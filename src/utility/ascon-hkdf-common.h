@@ -33,6 +33,13 @@
  * HKDF_HMAC_INIT       Name of the HMAC initialization function.
  * HKDF_HMAC_UPDATE     Name of the HMAC update function.
  * HKDF_HMAC_FINALIZE   Name of the HMAC finalization function.
+ * HKDF_HMAC_KEY        Type for a pre-computed HMAC key.
+ * HKDF_HMAC_INIT_KEY   Name of the HMAC key pre-computation function.
+ * HKDF_HMAC_FREE_KEY   Name of the HMAC function to free a pre-computed key.
+ * HKDF_HMAC_INIT_PK    Name of the HMAC initialization function that
+ *                      uses a pre-computed key.
+ * HKDF_HMAC_FINAL_PK   Name of the HMAC finalization function that
+ *                      uses a pre-computed key.
  */
 #if defined(HKDF_ALG_NAME)
 
@@ -116,11 +123,63 @@ int HKDF_CONCAT(HKDF_ALG_NAME,_expand)
     return 0;
 }
 
+int HKDF_CONCAT(HKDF_ALG_NAME,_expand_many)
+    (const HKDF_STATE *state, const ascon_hkdf_output_t *outputs, size_t count)
+{
+    HKDF_HMAC_KEY pk;
+    HKDF_HMAC_STATE hmac;
+    unsigned char block[HKDF_HMAC_SIZE];
+    unsigned char counter;
+    unsigned char *out;
+    size_t outlen, len;
+    int result = 0;
+
+    /* Absorb the inner and outer key blocks for the PRK only once */
+    HKDF_HMAC_INIT_KEY(&pk, state->prk, sizeof(state->prk));
+
+    /* Generate each of the outputs, restarting the counter each time */
+    for (; count > 0; --count, ++outputs) {
+        out = outputs->out;
+        outlen = outputs->outlen;
+        if (outlen > (size_t)(HKDF_HMAC_SIZE * 255)) {
+            memset(out, 0, outlen);
+            result = -1;
+            continue;
+        }
+        counter = 1;
+        while (outlen > 0) {
+            HKDF_HMAC_INIT_PK(&hmac, &pk);
+            if (counter != 1)
+                HKDF_HMAC_UPDATE(&hmac, block, sizeof(block));
+            HKDF_HMAC_UPDATE(&hmac, outputs->info, outputs->infolen);
+            HKDF_HMAC_UPDATE(&hmac, &counter, 1);
+            HKDF_HMAC_FINAL_PK(&hmac, &pk, block);
+            ++counter;
+            len = HKDF_HMAC_SIZE;
+            if (len > outlen)
+                len = outlen;
+            memcpy(out, block, len);
+            out += len;
+            outlen -= len;
+        }
+    }
+    HKDF_HMAC_FREE_KEY(&pk);
+    ascon_clean(&hmac, sizeof(hmac));
+    ascon_clean(block, sizeof(block));
+    return result;
+}
+
 void HKDF_CONCAT(HKDF_ALG_NAME,_free)(HKDF_STATE *state)
 {
     ascon_clean(state, sizeof(HKDF_STATE));
 }
 
+void HKDF_CONCAT(HKDF_ALG_NAME,_reset)(HKDF_STATE *state)
+{
+    state->counter = 1;
+    state->posn = HKDF_HMAC_SIZE;
+}
+
 #endif /* HKDF_ALG_NAME */
 
 /* Now undefine everything so that we can include this file again for
@@ -132,3 +191,8 @@ void HKDF_CONCAT(HKDF_ALG_NAME,_free)(HKDF_STATE *state)
 #undef HKDF_HMAC_INIT
 #undef HKDF_HMAC_UPDATE
 #undef HKDF_HMAC_FINALIZE
+#undef HKDF_HMAC_KEY
+#undef HKDF_HMAC_INIT_KEY
+#undef HKDF_HMAC_FREE_KEY
+#undef HKDF_HMAC_INIT_PK
+#undef HKDF_HMAC_FINAL_PK
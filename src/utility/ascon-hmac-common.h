@@ -30,11 +30,16 @@
  * HMAC_HASH_SIZE       Size of the hash output for the underlying algorithm.
  * HMAC_BLOCK_SIZE      Size of the formatted key block for HMAC.
  * HMAC_STATE           Type for the HMAC state; e.g. ascon_hmac_state_t
+ * HMAC_KEY             Type for the pre-computed key; e.g. ascon_hmac_key_t
  * HMAC_HASH_INIT       Name of the hash initialization function.
  * HMAC_HASH_REINIT     Name of the hash re-initialization function.
  * HMAC_HASH_FREE       Name of the hash state free function.
  * HMAC_HASH_UPDATE     Name of the hash update function.
  * HMAC_HASH_FINALIZE   Name of the hash finalization function.
+ * HMAC_HASH_COPY       Name of the hash state copy function.
+ * HMAC_HASH_RESET      Name of the hash state reset-from-template function.
+ * HMAC_HASH_SNAPSHOT   Name of the hash snapshot function.
+ * HMAC_HASH_RESTORE    Name of the hash snapshot restore function.
  */
 #if defined(HMAC_ALG_NAME)
 
@@ -172,6 +177,74 @@ void HMAC_CONCAT(HMAC_ALG_NAME,_finalize)
     ascon_clean(temp, sizeof(temp));
 }
 
+void HMAC_CONCAT(HMAC_ALG_NAME,_snapshot)
+    (HMAC_STATE *state, unsigned char *snapshot)
+{
+    HMAC_HASH_SNAPSHOT(&(state->hash), snapshot);
+}
+
+int HMAC_CONCAT(HMAC_ALG_NAME,_restore)
+    (HMAC_STATE *state, const unsigned char *snapshot)
+{
+    return HMAC_HASH_RESTORE(&(state->hash), snapshot);
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_init_key)
+    (HMAC_KEY *pk, const unsigned char *key, size_t keylen)
+{
+    HMAC_STATE state;
+    HMAC_HASH_INIT(&(state.hash));
+    HMAC_CONCAT(HMAC_ALG_NAME,_absorb_key)(&state, key, keylen, HMAC_IPAD);
+    HMAC_HASH_COPY(&(pk->inner), &(state.hash));
+    HMAC_HASH_REINIT(&(state.hash));
+    HMAC_CONCAT(HMAC_ALG_NAME,_absorb_key)(&state, key, keylen, HMAC_OPAD);
+    HMAC_HASH_COPY(&(pk->outer), &(state.hash));
+    HMAC_HASH_FREE(&(state.hash));
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_free_key)(HMAC_KEY *pk)
+{
+    if (pk) {
+        HMAC_HASH_FREE(&(pk->inner));
+        HMAC_HASH_FREE(&(pk->outer));
+    }
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_pk)
+    (unsigned char *out, const HMAC_KEY *pk,
+     const unsigned char *in, size_t inlen)
+{
+    HMAC_STATE state;
+    HMAC_HASH_COPY(&(state.hash), &(pk->inner));
+    HMAC_HASH_UPDATE(&(state.hash), in, inlen);
+    HMAC_CONCAT(HMAC_ALG_NAME,_finalize_pk)(&state, pk, out);
+    HMAC_HASH_FREE(&(state.hash));
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_init_pk)
+    (HMAC_STATE *state, const HMAC_KEY *pk)
+{
+    HMAC_HASH_COPY(&(state->hash), &(pk->inner));
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_reset)
+    (HMAC_STATE *state, const HMAC_KEY *pk)
+{
+    HMAC_HASH_RESET(&(state->hash), &(pk->inner));
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_finalize_pk)
+    (HMAC_STATE *state, const HMAC_KEY *pk, unsigned char *out)
+{
+    unsigned char temp[HMAC_HASH_SIZE];
+    HMAC_HASH_FINALIZE(&(state->hash), temp);
+    HMAC_HASH_FREE(&(state->hash));
+    HMAC_HASH_COPY(&(state->hash), &(pk->outer));
+    HMAC_HASH_UPDATE(&(state->hash), temp, HMAC_HASH_SIZE);
+    HMAC_HASH_FINALIZE(&(state->hash), out);
+    ascon_clean(temp, sizeof(temp));
+}
+
 #endif /* HMAC_ALG_NAME */
 
 /* Now undefine everything so that we can include this file again for
@@ -180,10 +253,16 @@ void HMAC_CONCAT(HMAC_ALG_NAME,_finalize)
 #undef HMAC_HASH_SIZE
 #undef HMAC_BLOCK_SIZE
 #undef HMAC_STATE
+#undef HMAC_KEY
 #undef HMAC_HASH_INIT
 #undef HMAC_HASH_REINIT
+#undef HMAC_HASH_FREE
 #undef HMAC_HASH_UPDATE
 #undef HMAC_HASH_FINALIZE
+#undef HMAC_HASH_COPY
+#undef HMAC_HASH_RESET
+#undef HMAC_HASH_SNAPSHOT
+#undef HMAC_HASH_RESTORE
 #undef HMAC_CONCAT_INNER
 #undef HMAC_CONCAT
 #undef HMAC_IPAD
@@ -25,6 +25,7 @@
  *
  * ISAP_ALG_NAME        Name of the ISAP algorithm; e.g. isap_keccak_128
  * ISAP_KEY_STATE       Type for the pre-computed key state
+ * ISAP_REKEY_CACHE     Type for the re-keying cache
  * ISAP_RATE            Number of bytes in the rate for hashing and encryption.
  * ISAP_sH              Number of rounds for hashing.
  * ISAP_sE              Number of rounds for encryption.
@@ -45,37 +46,6 @@
 #define ISAP_CONCAT_INNER(name,suffix) name##suffix
 #define ISAP_CONCAT(name,suffix) ISAP_CONCAT_INNER(name,suffix)
 
-#if defined(ASCON_BACKEND_DIRECT_XOR)
-
-#define ISAP_ADD_BIT(state, value, bit) \
-    do { \
-        (state)->B[0] ^= ((value) << (bit)) & 0x80; \
-    } while (0)
-
-#elif defined(ASCON_BACKEND_SLICED32)
-
-#define ISAP_ADD_BIT(state, value, bit) \
-    do { \
-        (state)->W[1] ^= (((uint32_t)(value)) << (24 + (bit))) & 0x80000000U; \
-    } while (0)
-
-#elif defined(ASCON_BACKEND_SLICED64)
-
-#define ISAP_ADD_BIT(state, value, bit) \
-    do { \
-        (state)->S[0] ^= (((uint64_t)(value)) << (56 + (bit))) & 0x8000000000000000ULL; \
-    } while (0)
-
-#else
-
-#define ISAP_ADD_BIT(state, value, bit) \
-    do { \
-        uint8_t absorb = (uint8_t)(((value) << (bit)) & 0x80); \
-        ascon_add_bytes((state), &absorb, 0, 1); \
-    } while (0)
-
-#endif
-
 /* IV string for initialising the associated data */
 static unsigned char const ISAP_CONCAT(ISAP_ALG_NAME,_IV_A)
         [ISAP_STATE_SIZE - ISAP_NONCE_SIZE] = {
@@ -97,6 +67,28 @@ static unsigned char const ISAP_CONCAT(ISAP_ALG_NAME,_IV_KE)
     ISAP_sH, ISAP_sB, ISAP_sE, ISAP_sK
 };
 
+/**
+ * \brief Absorbs the bits of the re-keying data into an ISAP state.
+ *
+ * \param state The permutation state to be re-keyed.
+ * \param data Points to the data to be absorbed to perform the re-keying.
+ * \param start Index of the first byte in \a data to absorb.
+ * \param data_len Length of the data to be absorbed.
+ *
+ * The output key will be left in the leading bytes of \a state.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_rekey_bits)
+    (ascon_state_t *state, const unsigned char *data,
+     unsigned start, unsigned data_len)
+{
+    /* Absorb all of the bits of the data buffer one by one, keeping
+     * the state in registers where the back end allows it */
+    ascon_absorb_bits
+        (state, data + start, (data_len - start) * 8 - 1, 12 - ISAP_sB);
+    ascon_absorb_bit(state, data[data_len - 1], 7);
+    ascon_permute(state, 12 - ISAP_sK);
+}
+
 /**
  * \brief Re-keys the ISAP permutation state.
  *
@@ -111,19 +103,55 @@ static void ISAP_CONCAT(ISAP_ALG_NAME,_rekey)
     (ascon_state_t *state, const ascon_state_t *pk,
      const unsigned char *data, unsigned data_len)
 {
-    unsigned bit, num_bits;
-
     /* Initialize the state with the key and IV from "pk" */
     ascon_copy(state, pk);
 
-    /* Absorb all of the bits of the data buffer one by one */
-    num_bits = data_len * 8 - 1;
-    for (bit = 0; bit < num_bits; ++bit) {
-        ISAP_ADD_BIT(state, data[bit / 8], bit % 8);
-        ascon_permute(state, 12 - ISAP_sB);
+    /* Absorb the data to complete the re-keying process */
+    ISAP_CONCAT(ISAP_ALG_NAME,_rekey_bits)(state, data, 0, data_len);
+}
+
+/**
+ * \brief Re-keys the ISAP permutation state for encryption using a cache
+ * of the states after absorbing common nonce prefixes.
+ *
+ * \param state The permutation state to be re-keyed.
+ * \param pk Points to the pre-computed key information.
+ * \param cache Points to the re-keying cache.
+ * \param npub Points to the 128-bit nonce.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_rekey_cached)
+    (ascon_state_t *state, const ISAP_KEY_STATE *pk,
+     ISAP_REKEY_CACHE *cache, const unsigned char *npub)
+{
+    unsigned index;
+
+    /* Look for the nonce prefix in the cache.  The nonce is public
+     * so there is no need to do this in constant time. */
+    for (index = 0; index < cache->count; ++index) {
+        if (!memcmp(cache->prefixes[index], npub, cache->prefix_len))
+            break;
     }
-    ISAP_ADD_BIT(state, data[bit / 8], bit % 8);
-    ascon_permute(state, 12 - ISAP_sK);
+
+    /* Absorb the prefix into a new entry if it is not present */
+    if (index >= cache->count) {
+        index = cache->next;
+        cache->next = (unsigned char)
+            ((index + 1) % ASCON_ISAP_REKEY_CACHE_ENTRIES);
+        if (cache->count < ASCON_ISAP_REKEY_CACHE_ENTRIES)
+            ++(cache->count);
+        memcpy(cache->prefixes[index], npub, cache->prefix_len);
+        ascon_acquire(&(cache->states[index]));
+        ascon_copy(&(cache->states[index]), &(pk->ke));
+        ascon_absorb_bits
+            (&(cache->states[index]), npub, cache->prefix_len * 8,
+             12 - ISAP_sB);
+        ascon_release(&(cache->states[index]));
+    }
+
+    /* Absorb the rest of the nonce starting from the cached state */
+    ascon_copy(state, &(cache->states[index]));
+    ISAP_CONCAT(ISAP_ALG_NAME,_rekey_bits)
+        (state, npub, cache->prefix_len, ISAP_NONCE_SIZE);
 }
 
 /**
@@ -131,18 +159,24 @@ static void ISAP_CONCAT(ISAP_ALG_NAME,_rekey)
  *
  * \param state ISAP permutation state.
  * \param pk Points to the pre-computed key information.
+ * \param cache Points to the re-keying cache, or NULL if none.
  * \param npub Points to the 128-bit nonce for the ISAP cipher.
  * \param c Buffer to receive the output ciphertext.
  * \param m Buffer to receive the input plaintext.
  * \param mlen Length of the input plaintext.
  */
 static void ISAP_CONCAT(ISAP_ALG_NAME,_encrypt)
-    (ascon_state_t *state, const ISAP_KEY_STATE *pk, const unsigned char *npub,
-     unsigned char *c, const unsigned char *m, size_t mlen)
+    (ascon_state_t *state, const ISAP_KEY_STATE *pk, ISAP_REKEY_CACHE *cache,
+     const unsigned char *npub, unsigned char *c, const unsigned char *m,
+     size_t mlen)
 {
     /* Set up the re-keyed encryption key and nonce in the state */
-    ISAP_CONCAT(ISAP_ALG_NAME,_rekey)
-        (state, &(pk->ke), npub, ISAP_NONCE_SIZE);
+    if (cache) {
+        ISAP_CONCAT(ISAP_ALG_NAME,_rekey_cached)(state, pk, cache, npub);
+    } else {
+        ISAP_CONCAT(ISAP_ALG_NAME,_rekey)
+            (state, &(pk->ke), npub, ISAP_NONCE_SIZE);
+    }
     ascon_overwrite_bytes
         (state, npub, ISAP_STATE_SIZE - ISAP_NONCE_SIZE, ISAP_NONCE_SIZE);
 
@@ -282,12 +316,25 @@ void ISAP_CONCAT(ISAP_ALG_NAME,_aead_free)(ISAP_KEY_STATE *pk)
     }
 }
 
-void ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt)
+/**
+ * \brief Encrypts and authenticates a packet with ISAP.
+ *
+ * \param c Buffer to receive the output.
+ * \param clen On exit, set to the length of the output.
+ * \param m Buffer that contains the plaintext message to encrypt.
+ * \param mlen Length of the plaintext message in bytes.
+ * \param ad Buffer that contains associated data.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet.
+ * \param pk Points to the pre-computed key value.
+ * \param cache Points to the re-keying cache, or NULL if none.
+ */
+static void ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt_inner)
     (unsigned char *c, size_t *clen,
      const unsigned char *m, size_t mlen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
-     const ISAP_KEY_STATE *pk)
+     const ISAP_KEY_STATE *pk, ISAP_REKEY_CACHE *cache)
 {
     ascon_state_t state;
 
@@ -296,7 +343,7 @@ void ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt)
 
     /* Encrypt the plaintext to produce the ciphertext */
     ascon_init(&state);
-    ISAP_CONCAT(ISAP_ALG_NAME,_encrypt)(&state, pk, npub, c, m, mlen);
+    ISAP_CONCAT(ISAP_ALG_NAME,_encrypt)(&state, pk, cache, npub, c, m, mlen);
 
     /* Authenticate the associated data and ciphertext to generate the tag */
     ISAP_CONCAT(ISAP_ALG_NAME,_mac)
@@ -304,12 +351,27 @@ void ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt)
     ascon_free(&state);
 }
 
-int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt)
+/**
+ * \brief Decrypts and authenticates a packet with ISAP.
+ *
+ * \param m Buffer to receive the plaintext message on output.
+ * \param mlen Receives the length of the plaintext message on output.
+ * \param c Buffer that contains the ciphertext and authentication tag.
+ * \param clen Length of the input data in bytes.
+ * \param ad Buffer that contains associated data.
+ * \param adlen Length of the associated data in bytes.
+ * \param npub Points to the public nonce for the packet.
+ * \param pk Points to the pre-computed key value.
+ * \param cache Points to the re-keying cache, or NULL if none.
+ *
+ * \return 0 on success, -1 if the authentication tag was incorrect.
+ */
+static int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt_inner)
     (unsigned char *m, size_t *mlen,
      const unsigned char *c, size_t clen,
      const unsigned char *ad, size_t adlen,
      const unsigned char *npub,
-     const ISAP_KEY_STATE *pk)
+     const ISAP_KEY_STATE *pk, ISAP_REKEY_CACHE *cache)
 {
     ascon_state_t state;
     unsigned char tag[ISAP_TAG_SIZE];
@@ -326,7 +388,7 @@ int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt)
         (&state, pk, npub, ad, adlen, c, *mlen, tag);
 
     /* Decrypt the ciphertext to produce the plaintext */
-    ISAP_CONCAT(ISAP_ALG_NAME,_encrypt)(&state, pk, npub, m, c, *mlen);
+    ISAP_CONCAT(ISAP_ALG_NAME,_encrypt)(&state, pk, cache, npub, m, c, *mlen);
 
     /* Check the authentication tag */
     result = ascon_aead_check_tag(m, *mlen, tag, c + *mlen, ISAP_TAG_SIZE);
@@ -335,12 +397,137 @@ int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt)
     return result;
 }
 
+
+void ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt)
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ISAP_KEY_STATE *pk)
+{
+    ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt_inner)
+        (c, clen, m, mlen, ad, adlen, npub, pk, 0);
+}
+
+int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt)
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ISAP_KEY_STATE *pk)
+{
+    return ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt_inner)
+        (m, mlen, c, clen, ad, adlen, npub, pk, 0);
+}
+
+int ISAP_CONCAT(ISAP_ALG_NAME,_rekey_cache_init)
+    (ISAP_REKEY_CACHE *cache, unsigned prefix_len)
+{
+    unsigned index;
+    memset(cache, 0, sizeof(ISAP_REKEY_CACHE));
+    if (prefix_len < 1 || prefix_len >= ISAP_NONCE_SIZE)
+        return -2;
+    for (index = 0; index < ASCON_ISAP_REKEY_CACHE_ENTRIES; ++index) {
+        ascon_init(&(cache->states[index]));
+        ascon_release(&(cache->states[index]));
+    }
+    cache->prefix_len = (unsigned char)prefix_len;
+    return 0;
+}
+
+int ISAP_CONCAT(ISAP_ALG_NAME,_rekey_cache_load)
+    (ISAP_REKEY_CACHE *cache,
+     const unsigned char buf[ASCON_ISAP_SAVED_REKEY_CACHE_SIZE])
+{
+    const unsigned char *entry = buf + 4;
+    unsigned index;
+
+    /* Validate the header, which identifies the ISAP variant */
+    if (buf[0] != ISAP_sB || buf[1] != ISAP_sE ||
+            buf[2] < 1 || buf[2] >= ISAP_NONCE_SIZE ||
+            buf[3] > ASCON_ISAP_REKEY_CACHE_ENTRIES) {
+        return -1;
+    }
+
+    /* Load the entries back into the permutation states */
+    ISAP_CONCAT(ISAP_ALG_NAME,_rekey_cache_init)(cache, buf[2]);
+    for (index = 0; index < buf[3]; ++index) {
+        ascon_acquire(&(cache->states[index]));
+        ascon_overwrite_bytes
+            (&(cache->states[index]), entry, 0, ISAP_STATE_SIZE);
+        ascon_release(&(cache->states[index]));
+        memcpy(cache->prefixes[index], entry + ISAP_STATE_SIZE,
+               ISAP_NONCE_SIZE);
+        entry += ISAP_STATE_SIZE + ISAP_NONCE_SIZE;
+    }
+    cache->count = buf[3];
+    cache->next = (unsigned char)(buf[3] % ASCON_ISAP_REKEY_CACHE_ENTRIES);
+    return 0;
+}
+
+void ISAP_CONCAT(ISAP_ALG_NAME,_rekey_cache_save)
+    (ISAP_REKEY_CACHE *cache,
+     unsigned char buf[ASCON_ISAP_SAVED_REKEY_CACHE_SIZE])
+{
+    unsigned char *entry = buf + 4;
+    unsigned index;
+    memset(buf, 0, ASCON_ISAP_SAVED_REKEY_CACHE_SIZE);
+    buf[0] = ISAP_sB;
+    buf[1] = ISAP_sE;
+    buf[2] = cache->prefix_len;
+    buf[3] = cache->count;
+    for (index = 0; index < cache->count; ++index) {
+        ascon_acquire(&(cache->states[index]));
+        ascon_extract_bytes
+            (&(cache->states[index]), entry, 0, ISAP_STATE_SIZE);
+        ascon_release(&(cache->states[index]));
+        memcpy(entry + ISAP_STATE_SIZE, cache->prefixes[index],
+               ISAP_NONCE_SIZE);
+        entry += ISAP_STATE_SIZE + ISAP_NONCE_SIZE;
+    }
+}
+
+void ISAP_CONCAT(ISAP_ALG_NAME,_rekey_cache_free)(ISAP_REKEY_CACHE *cache)
+{
+    unsigned index;
+    if (cache) {
+        for (index = 0; index < ASCON_ISAP_REKEY_CACHE_ENTRIES; ++index) {
+            ascon_acquire(&(cache->states[index]));
+            ascon_free(&(cache->states[index]));
+        }
+        ascon_clean(cache, sizeof(ISAP_REKEY_CACHE));
+    }
+}
+
+void ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt_cached)
+    (unsigned char *c, size_t *clen,
+     const unsigned char *m, size_t mlen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ISAP_KEY_STATE *pk, ISAP_REKEY_CACHE *cache)
+{
+    ISAP_CONCAT(ISAP_ALG_NAME,_aead_encrypt_inner)
+        (c, clen, m, mlen, ad, adlen, npub, pk, cache);
+}
+
+int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt_cached)
+    (unsigned char *m, size_t *mlen,
+     const unsigned char *c, size_t clen,
+     const unsigned char *ad, size_t adlen,
+     const unsigned char *npub,
+     const ISAP_KEY_STATE *pk, ISAP_REKEY_CACHE *cache)
+{
+    return ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt_inner)
+        (m, mlen, c, clen, ad, adlen, npub, pk, cache);
+}
+
 #endif /* ISAP_ALG_NAME */
 
 /* Now undefine everything so that we can include this file again for
  * another variant on the ISAP algorithm */
 #undef ISAP_ALG_NAME
 #undef ISAP_KEY_STATE
+#undef ISAP_REKEY_CACHE
 #undef ISAP_RATE
 #undef ISAP_sH
 #undef ISAP_sE
@@ -349,4 +536,3 @@ int ISAP_CONCAT(ISAP_ALG_NAME,_aead_decrypt)
 #undef ISAP_STATE_SIZE
 #undef ISAP_CONCAT_INNER
 #undef ISAP_CONCAT
-#undef ISAP_ADD_BIT
@@ -39,9 +39,19 @@
  *                      multiple of the rate block size.
  * KMAC_XOF_IS_ABSORBING(state) Checks to see if the underlying XOF state
  *                      is still in absorbing mode.
+ * KMAC_XOF_SNAPSHOT    Name of the XOF snapshot function.
+ * KMAC_XOF_RESTORE     Name of the XOF snapshot restore function.
+ * KMAC_XOF_COPY        Name of the XOF state copy function.
+ * KMAC_XOF_RESET       Name of the XOF state reset-from-template function.
+ * KMAC_KEY             Type for the pre-computed key; e.g. ascon_kmac_key_t
+ * KMAC_FIRST_ROUND     First round of the permutation between blocks.
+ *                      The permutation after padding always has 12 rounds.
  */
 #if defined(KMAC_ALG_NAME)
 
+#include "ascon-multi.h"
+#include "ascon-util-snp.h"
+
 #define KMAC_CONCAT_INNER(name,suffix) name##suffix
 #define KMAC_CONCAT(name,suffix) KMAC_CONCAT_INNER(name,suffix)
 
@@ -200,6 +210,199 @@ void KMAC_CONCAT(KMAC_ALG_NAME,_finalize)
     KMAC_XOF_SQUEEZE(&(state->xof), out, KMAC_SIZE);
 }
 
+void KMAC_CONCAT(KMAC_ALG_NAME,_snapshot)
+    (KMAC_STATE *state, unsigned char *snapshot)
+{
+    KMAC_XOF_SNAPSHOT(&(state->xof), snapshot);
+}
+
+int KMAC_CONCAT(KMAC_ALG_NAME,_restore)
+    (KMAC_STATE *state, const unsigned char *snapshot)
+{
+    return KMAC_XOF_RESTORE(&(state->xof), snapshot);
+}
+
+void KMAC_CONCAT(KMAC_ALG_NAME,_init_key)
+    (KMAC_KEY *pk, const unsigned char *key, size_t keylen,
+     const unsigned char *custom, size_t customlen)
+{
+    KMAC_STATE state;
+    KMAC_CONCAT(KMAC_ALG_NAME,_init)(&state, key, keylen, custom, customlen);
+    KMAC_XOF_COPY(&(pk->xof), &(state.xof));
+    KMAC_CONCAT(KMAC_ALG_NAME,_free)(&state);
+}
+
+void KMAC_CONCAT(KMAC_ALG_NAME,_free_key)(KMAC_KEY *pk)
+{
+    if (pk)
+        KMAC_XOF_FREE(&(pk->xof));
+}
+
+void KMAC_CONCAT(KMAC_ALG_NAME,_init_pk)
+    (KMAC_STATE *state, const KMAC_KEY *pk)
+{
+    KMAC_XOF_COPY(&(state->xof), &(pk->xof));
+}
+
+void KMAC_CONCAT(KMAC_ALG_NAME,_reset)
+    (KMAC_STATE *state, const KMAC_KEY *pk)
+{
+    KMAC_XOF_RESET(&(state->xof), &(pk->xof));
+}
+
+void KMAC_CONCAT(KMAC_ALG_NAME,_pk)
+    (const KMAC_KEY *pk, const unsigned char *in, size_t inlen,
+     unsigned char *out, size_t outlen)
+{
+    KMAC_STATE state;
+    KMAC_XOF_COPY(&(state.xof), &(pk->xof));
+    KMAC_XOF_ABSORB(&(state.xof), in, inlen);
+    KMAC_CONCAT(KMAC_ALG_NAME,_set_output_length)(&state, outlen);
+    KMAC_XOF_SQUEEZE(&(state.xof), out, outlen);
+    KMAC_CONCAT(KMAC_ALG_NAME,_free)(&state);
+}
+
+/* Information about a message that is being authenticated in a lane */
+typedef struct
+{
+    KMAC_STATE kmac;
+    const unsigned char *in;
+    unsigned char *out;
+    size_t len;
+    size_t outlen;
+    unsigned char tail[KMAC_RATE * 2];
+    int in_tail;
+    int squeezing;
+    uint8_t first_round;
+
+} KMAC_CONCAT(KMAC_ALG_NAME,_lane_t);
+
+/**
+ * \brief Advances a lane to the point where it next needs a permutation.
+ *
+ * \param lane The lane to advance.
+ *
+ * \return Zero if the lane needs a permutation, or 1 if the
+ * message has been fully authenticated.
+ *
+ * When the input is down to its last partial block, the rest of it is
+ * copied into the lane's tail buffer along with the encoded output
+ * length, and then the tail buffer is absorbed like the input.
+ */
+static int KMAC_CONCAT(KMAC_ALG_NAME,_lane_step)
+    (KMAC_CONCAT(KMAC_ALG_NAME,_lane_t) *lane)
+{
+    ascon_state_t *state = &(lane->kmac.xof.state);
+    if (!lane->squeezing) {
+        if (lane->len < KMAC_RATE && !lane->in_tail) {
+            unsigned char buf[sizeof(uint64_t) + 1];
+            size_t len = KMAC_CONCAT(KMAC_ALG_NAME,_encode_length)
+                (buf, lane->outlen);
+            memcpy(lane->tail, lane->in, lane->len);
+            memcpy(lane->tail + lane->len, buf + 1, len - 1);
+            lane->tail[lane->len + len - 1] = buf[0];
+            lane->in = lane->tail;
+            lane->len += len;
+            lane->in_tail = 1;
+        }
+        if (lane->len >= KMAC_RATE) {
+            ascon_absorb_8(state, lane->in, 0);
+            lane->in += KMAC_RATE;
+            lane->len -= KMAC_RATE;
+            lane->first_round = KMAC_FIRST_ROUND;
+        } else {
+            if (lane->len > 0) {
+                ascon_absorb_partial
+                    (state, lane->in, 0, (unsigned)(lane->len));
+            }
+            ascon_pad(state, (unsigned)(lane->len));
+            lane->squeezing = 1;
+            lane->first_round = 0;
+        }
+        return 0;
+    }
+
+    /* Squeeze out the next block of the KMAC value */
+    if (lane->outlen > KMAC_RATE) {
+        ascon_squeeze_8(state, lane->out, 0);
+        lane->out += KMAC_RATE;
+        lane->outlen -= KMAC_RATE;
+        lane->first_round = KMAC_FIRST_ROUND;
+        return 0;
+    }
+    ascon_squeeze_partial(state, lane->out, 0, (unsigned)(lane->outlen));
+    ascon_free(state);
+    ascon_clean(lane->tail, sizeof(lane->tail));
+    return 1;
+}
+
+void KMAC_CONCAT(KMAC_ALG_NAME,_many)
+    (const KMAC_KEY *pk, unsigned char *out, size_t outlen,
+     const unsigned char * const *in, const size_t *inlen, size_t count)
+{
+    KMAC_CONCAT(KMAC_ALG_NAME,_lane_t) lanes[ASCON_MULTI_LANES];
+    KMAC_CONCAT(KMAC_ALG_NAME,_lane_t) *active[ASCON_MULTI_LANES];
+    ascon_state_t *full[ASCON_MULTI_LANES];
+    ascon_state_t *reduced[ASCON_MULTI_LANES];
+    unsigned num_active = 0;
+    unsigned num_full, num_reduced, index;
+
+    /* Zero-length outputs need no work at all */
+    if (!outlen)
+        return;
+
+    /* Lanes that are not in use are kept at the end of the active list */
+    for (index = 0; index < ASCON_MULTI_LANES; ++index)
+        active[index] = &(lanes[index]);
+
+    for (;;) {
+        /* Fill up any empty lanes with new messages.  The pre-computed
+         * state is aligned on a block boundary and has been permuted,
+         * so the first block can be absorbed immediately */
+        while (num_active < ASCON_MULTI_LANES && count > 0) {
+            KMAC_CONCAT(KMAC_ALG_NAME,_lane_t) *lane = active[num_active++];
+            KMAC_XOF_COPY(&(lane->kmac.xof), &(pk->xof));
+            ascon_acquire(&(lane->kmac.xof.state));
+            lane->in = *in++;
+            lane->out = out;
+            lane->len = *inlen++;
+            lane->outlen = outlen;
+            lane->in_tail = 0;
+            lane->squeezing = 0;
+            KMAC_CONCAT(KMAC_ALG_NAME,_lane_step)(lane);
+            out += outlen;
+            --count;
+        }
+        if (!num_active)
+            break;
+
+        /* Permute all active lanes, grouped by the number of rounds */
+        num_full = 0;
+        num_reduced = 0;
+        for (index = 0; index < num_active; ++index) {
+            if (active[index]->first_round == 0)
+                full[num_full++] = &(active[index]->kmac.xof.state);
+            else
+                reduced[num_reduced++] = &(active[index]->kmac.xof.state);
+        }
+        ascon_permute_multi(full, num_full, 0);
+        ascon_permute_multi(reduced, num_reduced, KMAC_FIRST_ROUND);
+
+        /* Advance all lanes to the next permutation and retire the
+         * lanes whose messages have been fully authenticated */
+        index = 0;
+        while (index < num_active) {
+            KMAC_CONCAT(KMAC_ALG_NAME,_lane_t) *lane = active[index];
+            if (KMAC_CONCAT(KMAC_ALG_NAME,_lane_step)(lane)) {
+                active[index] = active[--num_active];
+                active[num_active] = lane;
+            } else {
+                ++index;
+            }
+        }
+    }
+}
+
 #endif /* KMAC_ALG_NAME */
 
 /* Now undefine everything so that we can include this file again for
@@ -214,5 +417,11 @@ void KMAC_CONCAT(KMAC_ALG_NAME,_finalize)
 #undef KMAC_XOF_SQUEEZE
 #undef KMAC_XOF_PAD
 #undef KMAC_XOF_IS_ABSORBING
+#undef KMAC_XOF_SNAPSHOT
+#undef KMAC_XOF_RESTORE
+#undef KMAC_XOF_COPY
+#undef KMAC_XOF_RESET
+#undef KMAC_KEY
+#undef KMAC_FIRST_ROUND
 #undef KMAC_CONCAT_INNER
 #undef KMAC_CONCAT
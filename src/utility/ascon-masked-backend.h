@@ -23,19 +23,34 @@
 #ifndef ASCON_MASKED_BACKEND_H
 #define ASCON_MASKED_BACKEND_H
 
+#include "../ascon-config.h"
 #include "ascon-select-backend.h"
 #include "ascon-masked-config.h"
 
 /* Select the default back end to use for the masked ASCON permutation,
  * and any properties we can use to optimize use of the permutation. */
 
-#if defined(ASCON_BACKEND_AVR5)
+#if !ASCON_ENABLE_MASKING
+
+/* Masking is disabled in the build profile, so no masked backend */
+
+#elif defined(ASCON_BACKEND_AVR5)
 
 /* Masked backend for AVR5 based systems */
 #define ASCON_MASKED_X2_BACKEND_AVR5 1
 #define ASCON_MASKED_X3_BACKEND_AVR5 1
 #define ASCON_MASKED_WORD_BACKEND_DIRECT_XOR 1
 
+#elif defined(ASCON_BACKEND_ARMV7M)
+
+/* Masked backend for ARMv7-M and ARMv8-M based systems.  The x2 and x3
+ * permutations are in assembly code; x4 uses the 32-bit sliced C version. */
+#define ASCON_MASKED_X2_BACKEND_ARMV7M 1
+#define ASCON_MASKED_X3_BACKEND_ARMV7M 1
+#define ASCON_MASKED_X4_BACKEND_C32 1
+#define ASCON_MASKED_WORD_BACKEND_C32 1
+#define ASCON_MASKED_BACKEND_SLICED32 1
+
 #elif defined(ASCON_BACKEND_SLICED32)
 
 /* Use the 32-bit sliced backend for masking if we were using the
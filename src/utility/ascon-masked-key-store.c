@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "../ascon-config.h"
+#include "../ascon-masking.h"
+#include "../ascon-utility.h"
+#include "ascon-masked-state.h"
+#include <string.h>
+
+#if ASCON_ENABLE_MASKING
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#endif
+
+/* Copies a masked key out of the table, taking program memory into account */
+#if defined(__AVR__)
+#define ascon_masked_key_store_copy(store, key, id) \
+    do { \
+        if ((store)->progmem) { \
+            memcpy_P((key), (store)->keys + (id), sizeof(*(key))); \
+        } else { \
+            memcpy((key), (store)->keys + (id), sizeof(*(key))); \
+        } \
+    } while (0)
+#else
+#define ascon_masked_key_store_copy(store, key, id) \
+    memcpy((key), (store)->keys + (id), sizeof(*(key)))
+#endif
+
+void ascon_masked_key_store_128_init
+    (ascon_masked_key_store_128_t *store,
+     const ascon_masked_key_128_t *keys, unsigned count)
+{
+    store->keys = keys;
+    store->count = count;
+    store->progmem = 0;
+}
+
+void ascon_masked_key_store_128_init_P
+    (ascon_masked_key_store_128_t *store,
+     const ascon_masked_key_128_t *keys, unsigned count)
+{
+    store->keys = keys;
+    store->count = count;
+#if defined(__AVR__)
+    store->progmem = 1;
+#else
+    store->progmem = 0;
+#endif
+}
+
+int ascon_masked_key_store_128_load
+    (const ascon_masked_key_store_128_t *store, unsigned id,
+     ascon_masked_key_128_t *key)
+{
+    ascon_trng_state_t trng;
+    if (id >= store->count)
+        return -2;
+    ascon_masked_key_store_copy(store, key, id);
+    ascon_trng_init(&trng);
+    ascon_masked_key_128_randomize_with_trng(key, &trng);
+    ascon_trng_free(&trng);
+    return 0;
+}
+
+const ascon_masked_key_128_t *ascon_masked_key_store_128_get
+    (const ascon_masked_key_store_128_t *store, unsigned id)
+{
+    if (id >= store->count || store->progmem)
+        return 0;
+    return store->keys + id;
+}
+
+void ascon_masked_key_store_160_init
+    (ascon_masked_key_store_160_t *store,
+     const ascon_masked_key_160_t *keys, unsigned count)
+{
+    store->keys = keys;
+    store->count = count;
+    store->progmem = 0;
+}
+
+void ascon_masked_key_store_160_init_P
+    (ascon_masked_key_store_160_t *store,
+     const ascon_masked_key_160_t *keys, unsigned count)
+{
+    store->keys = keys;
+    store->count = count;
+#if defined(__AVR__)
+    store->progmem = 1;
+#else
+    store->progmem = 0;
+#endif
+}
+
+int ascon_masked_key_store_160_load
+    (const ascon_masked_key_store_160_t *store, unsigned id,
+     ascon_masked_key_160_t *key)
+{
+    ascon_trng_state_t trng;
+    if (id >= store->count)
+        return -2;
+    ascon_masked_key_store_copy(store, key, id);
+    ascon_trng_init(&trng);
+    ascon_masked_key_160_randomize_with_trng(key, &trng);
+    ascon_trng_free(&trng);
+    return 0;
+}
+
+const ascon_masked_key_160_t *ascon_masked_key_store_160_get
+    (const ascon_masked_key_store_160_t *store, unsigned id)
+{
+    if (id >= store->count || store->progmem)
+        return 0;
+    return store->keys + id;
+}
+
+#endif /* ASCON_ENABLE_MASKING */
@@ -20,11 +20,14 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "../ascon-config.h"
 #include "../ascon-masking.h"
 #include "../ascon-utility.h"
 #include "ascon-masked-word.h"
 #include <string.h>
 
+#if ASCON_ENABLE_MASKING
+
 void ascon_masked_key_128_init
     (ascon_masked_key_128_t *masked, const unsigned char *key)
 {
@@ -185,13 +188,13 @@ void ascon_masked_key_160_randomize_with_trng
     }
 #elif ASCON_MASKED_KEY_SHARES == 3
     for (index = 0; index < 6; ++index) {
-        ascon_masked_word_x2_randomize
+        ascon_masked_word_x3_randomize
             ((ascon_masked_word_t *)&(masked->k[index]),
              (ascon_masked_word_t *)&(masked->k[index]), trng);
     }
 #else
     for (index = 0; index < 6; ++index) {
-        ascon_masked_word_x2_randomize
+        ascon_masked_word_x4_randomize
             ((ascon_masked_word_t *)&(masked->k[index]),
              (ascon_masked_word_t *)&(masked->k[index]), trng);
     }
@@ -232,3 +235,75 @@ void ascon_masked_key_160_extract
         (key + 16, 4, (const ascon_masked_word_t *)&(masked->k[2]));
 #endif
 }
+
+/* The refresh state reserves opaque storage for the TRNG; check that it fits */
+typedef int ascon_masked_key_refresh_check
+    [(sizeof(ascon_trng_state_t) <=
+        sizeof(((ascon_masked_key_refresh_t *)0)->trng)) ? 1 : -1];
+
+/**
+ * \brief Gets the internal TRNG state from a refresh state.
+ */
+#define ascon_masked_key_refresh_trng(refresh) \
+    ((ascon_trng_state_t *)((refresh)->trng))
+
+void ascon_masked_key_refresh_init(ascon_masked_key_refresh_t *refresh)
+{
+    ascon_trng_init(ascon_masked_key_refresh_trng(refresh));
+    refresh->next = 0;
+}
+
+void ascon_masked_key_refresh_free(ascon_masked_key_refresh_t *refresh)
+{
+    if (refresh) {
+        ascon_trng_free(ascon_masked_key_refresh_trng(refresh));
+        ascon_clean(refresh, sizeof(ascon_masked_key_refresh_t));
+    }
+}
+
+/**
+ * \brief Refreshes the shares of the next word of a masked key.
+ *
+ * \param words Points to the words of the masked key.
+ * \param count Number of words in the masked key.
+ * \param refresh Points to the refresh state.
+ *
+ * \return 1 if the last word was refreshed, or 0 otherwise.
+ */
+static int ascon_masked_key_refresh_word
+    (ascon_masked_key_word_t *words, unsigned count,
+     ascon_masked_key_refresh_t *refresh)
+{
+    ascon_masked_word_t *word;
+    if (refresh->next >= count)
+        refresh->next = 0;
+    word = (ascon_masked_word_t *)&(words[refresh->next]);
+#if ASCON_MASKED_KEY_SHARES == 2
+    ascon_masked_word_x2_randomize
+        (word, word, ascon_masked_key_refresh_trng(refresh));
+#elif ASCON_MASKED_KEY_SHARES == 3
+    ascon_masked_word_x3_randomize
+        (word, word, ascon_masked_key_refresh_trng(refresh));
+#else
+    ascon_masked_word_x4_randomize
+        (word, word, ascon_masked_key_refresh_trng(refresh));
+#endif
+    if (++(refresh->next) < count)
+        return 0;
+    refresh->next = 0;
+    return 1;
+}
+
+int ascon_masked_key_128_refresh_step
+    (ascon_masked_key_128_t *masked, ascon_masked_key_refresh_t *refresh)
+{
+    return ascon_masked_key_refresh_word(masked->k, 2, refresh);
+}
+
+int ascon_masked_key_160_refresh_step
+    (ascon_masked_key_160_t *masked, ascon_masked_key_refresh_t *refresh)
+{
+    return ascon_masked_key_refresh_word(masked->k, 6, refresh);
+}
+
+#endif /* ASCON_ENABLE_MASKING */
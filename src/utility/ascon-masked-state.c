@@ -20,12 +20,15 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "../ascon-config.h"
 #include "ascon-masked-state.h"
 #include "ascon-masked-backend.h"
 #include "utility/ascon-util-snp.h"
 #include "../ascon-utility.h"
 #include <string.h>
 
+#if ASCON_ENABLE_MASKING
+
 void ascon_masked_state_init(ascon_masked_state_t *state)
 {
     memset(state, 0, sizeof(ascon_masked_state_t));
@@ -278,3 +281,5 @@ void ascon_x4_copy_from_x4
 }
 
 #endif /* ASCON_MASKED_MAX_SHARES >= 4 */
+
+#endif /* ASCON_ENABLE_MASKING */
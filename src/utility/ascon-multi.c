@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Generic versions of the multi-state permutation functions for back ends
+ * that cannot permute several states side by side, and helpers for the
+ * batch API's. */
+
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
+#include "ascon-multi.h"
+
+#if !defined(ASCON_BACKEND_INTERLEAVED)
+
+void ascon_permute_x2
+    (ascon_state_t *state0, ascon_state_t *state1, uint8_t first_round)
+{
+    ascon_permute(state0, first_round);
+    ascon_permute(state1, first_round);
+}
+
+#endif /* !ASCON_BACKEND_INTERLEAVED */
+
+#if !defined(ASCON_BACKEND_INTERLEAVED) && !defined(ASCON_BACKEND_MVE)
+
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    ascon_permute(state0, first_round);
+    ascon_permute(state1, first_round);
+    ascon_permute(state2, first_round);
+    ascon_permute(state3, first_round);
+}
+
+#endif /* !ASCON_BACKEND_INTERLEAVED && !ASCON_BACKEND_MVE */
+
+#if !defined(ASCON_BACKEND_AVX512)
+
+void ascon_permute_x8(ascon_state_t *states[8], uint8_t first_round)
+{
+    ascon_permute_x4(states[0], states[1], states[2], states[3], first_round);
+    ascon_permute_x4(states[4], states[5], states[6], states[7], first_round);
+}
+
+#endif /* !ASCON_BACKEND_AVX512 */
+
+void ascon_permute_multi
+    (ascon_state_t **states, unsigned count, uint8_t first_round)
+{
+    while (count >= 8) {
+        ascon_permute_x8(states, first_round);
+        states += 8;
+        count -= 8;
+    }
+    if (count >= 4) {
+        ascon_permute_x4
+            (states[0], states[1], states[2], states[3], first_round);
+        states += 4;
+        count -= 4;
+    }
+    if (count >= 2) {
+        ascon_permute_x2(states[0], states[1], first_round);
+        states += 2;
+        count -= 2;
+    }
+    if (count > 0)
+        ascon_permute(states[0], first_round);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_MULTI_H
+#define ASCON_MULTI_H
+
+/* Utilities for processing several independent permutation states
+ * side by side in the batch API's. */
+
+#include "../ascon-permutation.h"
+#include "ascon-select-backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \def ASCON_MULTI_LANES
+ * \brief Maximum number of states that a batch operation should have
+ * in flight at once to make best use of the back end.
+ */
+#if defined(ASCON_BACKEND_AVX512)
+#define ASCON_MULTI_LANES 8
+#elif defined(ASCON_BACKEND_INTERLEAVED) || defined(ASCON_BACKEND_NEON) || \
+      defined(ASCON_BACKEND_WASM_SIMD) || defined(ASCON_BACKEND_MVE)
+#define ASCON_MULTI_LANES 4
+#else
+#define ASCON_MULTI_LANES 1
+#endif
+
+/**
+ * \def ASCON_SOA_LANES
+ * \brief Number of lanes in the structure-of-arrays states that the batch
+ * operations should use.
+ *
+ * This is only defined if the back end has vector kernels that permute
+ * the structure-of-arrays form directly.  Otherwise the batch operations
+ * are better off permuting only the lanes that are in use.
+ */
+#if defined(ASCON_BACKEND_AVX512)
+#define ASCON_SOA_LANES 8
+#elif defined(ASCON_BACKEND_AVX2) || defined(ASCON_BACKEND_NEON)
+#define ASCON_SOA_LANES 4
+#endif
+
+/**
+ * \def ASCON_X64_LANES
+ * \brief Number of messages in each group of the transposed bitsliced
+ * engine in "ascon-x64.h", if it is compiled.
+ *
+ * The engine is used for batches of uniform-length messages on 64-bit
+ * back ends that have no vector kernels.  Define ASCON_NO_X64 to leave
+ * it out.
+ */
+#if defined(ASCON_BACKEND_C64) && !defined(ASCON_SOA_LANES) && \
+    !defined(ASCON_SMALL) && !defined(ASCON_STATS) && !defined(ASCON_NO_X64)
+#define ASCON_X64_LANES 64
+#endif
+
+/**
+ * \brief Permutes lanes of a structure-of-arrays state one at a time
+ * with portable C code.
+ *
+ * \param S Points to word 0 of the first lane.
+ * \param stride Distance between consecutive words of a lane.
+ * \param lanes Number of lanes to permute.
+ * \param first_round The first round to execute, between 0 and 11.
+ */
+void ascon_permute_soa_generic
+    (uint64_t *S, unsigned stride, unsigned lanes, uint8_t first_round);
+
+/**
+ * \brief Permutes four lanes of a structure-of-arrays state.
+ *
+ * \param S Points to word 0 of the first lane.
+ * \param stride Distance between consecutive words of a lane.
+ * \param first_round The first round to execute, between 0 and 11.
+ */
+void ascon_permute_soa_x4
+    (uint64_t *S, unsigned stride, uint8_t first_round);
+
+/**
+ * \brief Permutes all lanes of an eight-lane structure-of-arrays state.
+ *
+ * \param S Points to word 0 of the first lane.
+ * \param first_round The first round to execute, between 0 and 11.
+ */
+void ascon_permute_soa_x8(uint64_t *S, uint8_t first_round);
+
+/**
+ * \brief Permutes a list of independent states with the same number
+ * of rounds, using the best multi-state permutation for each group.
+ *
+ * \param states Points to the list of states.
+ * \param count Number of states in the list.
+ * \param first_round The first round to execute, between 0 and 11.
+ */
+void ascon_permute_multi
+    (ascon_state_t **states, unsigned count, uint8_t first_round);
+
+/**
+ * \brief Overrides the features that were probed from the CPU and
+ * rebinds the multi-state permutations.
+ *
+ * \param clear Features to remove from ascon_backend_features().
+ * \param set Features to add to ascon_backend_features().
+ *
+ * Each call replaces the previous override.
+ */
+void ascon_backend_override(unsigned clear, unsigned set);
+
+/**
+ * \brief Forgets the multi-state permutations that were bound at runtime
+ * so that they are bound again from ascon_backend_features() on the
+ * next call.
+ *
+ * This does nothing if the multi-state permutations were selected
+ * at compile time.
+ */
+void ascon_multi_rebind(void);
+
+#if defined(ASCON_STATS) && !defined(ASCON_STATS_INTERNAL)
+#define ascon_permute_multi(states, count, first_round) \
+    (ascon_stats_count_permute((count), (first_round)), \
+     (ascon_permute_multi)((states), (count), (first_round)))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
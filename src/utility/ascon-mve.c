@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-state version of the ASCON permutation for ARMv8.1-M systems with
+ * the M-profile Vector Extension (Helium); e.g. ARM Cortex M55 and M85.
+ * MVE only has 32-bit lanes, so the states are kept in the bit-sliced
+ * form of the ARMv7-M back end and each vector holds the same 32-bit
+ * word from 4 states.
+ *
+ * This has not been run on hardware or a simulator yet, so it is only
+ * compiled if ASCON_MVE is defined.  Without it, ascon_permute_x4() on
+ * ARMv8.1-M is the generic version built on the ARMv7-M assembly code. */
+
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
+#include "../ascon-permutation.h"
+#include "ascon-select-backend.h"
+
+#if defined(ASCON_BACKEND_MVE)
+
+#include <arm_mve.h>
+
+/* Round constants for the even and odd halves, inverted to apply the
+ * "x2 = ~x2" step of the s-box in the same way as the c32 back end */
+#define ROUND_CONSTANT_PAIR(rc1, rc2) \
+    (~((uint32_t)(rc1))), (~((uint32_t)(rc2)))
+
+static const uint32_t RC[12 * 2] = {
+    ROUND_CONSTANT_PAIR(12, 12),
+    ROUND_CONSTANT_PAIR( 9, 12),
+    ROUND_CONSTANT_PAIR(12,  9),
+    ROUND_CONSTANT_PAIR( 9,  9),
+    ROUND_CONSTANT_PAIR( 6, 12),
+    ROUND_CONSTANT_PAIR( 3, 12),
+    ROUND_CONSTANT_PAIR( 6,  9),
+    ROUND_CONSTANT_PAIR( 3,  9),
+    ROUND_CONSTANT_PAIR(12,  6),
+    ROUND_CONSTANT_PAIR( 9,  6),
+    ROUND_CONSTANT_PAIR(12,  3),
+    ROUND_CONSTANT_PAIR( 9,  3)
+};
+
+/* The vbic instruction computes "a & ~b" so the arguments are reversed */
+#define ascon_andnot_mve(a, b) vbicq_u32((b), (a))
+
+/* Right rotation composed from a left shift and a shift-right-insert */
+#define ascon_ror_mve(x, n) vsriq_n_u32(vshlq_n_u32((x), 32 - (n)), (x), (n))
+
+/* Loads word i from four states into a vector */
+#define ascon_load_mve(s0, s1, s2, s3, i, x) \
+    do { \
+        lanes[0] = (s0)->W[(i)]; \
+        lanes[1] = (s1)->W[(i)]; \
+        lanes[2] = (s2)->W[(i)]; \
+        lanes[3] = (s3)->W[(i)]; \
+        (x) = vld1q_u32(lanes); \
+    } while (0)
+
+/* Stores the lanes of a vector back into word i of four states */
+#define ascon_store_mve(s0, s1, s2, s3, i, x) \
+    do { \
+        vst1q_u32(lanes, (x)); \
+        (s0)->W[(i)] = lanes[0]; \
+        (s1)->W[(i)] = lanes[1]; \
+        (s2)->W[(i)] = lanes[2]; \
+        (s3)->W[(i)] = lanes[3]; \
+    } while (0)
+
+/* Substitution layer on one half of the state */
+#define ascon_sbox_mve(x0, x1, x2, x3, x4) \
+    do { \
+        x0 = veorq_u32(x0, x4); \
+        x4 = veorq_u32(x4, x3); \
+        x2 = veorq_u32(x2, x1); \
+        t0 = ascon_andnot_mve(x0, x1); \
+        t1 = ascon_andnot_mve(x1, x2); \
+        t2 = ascon_andnot_mve(x2, x3); \
+        t3 = ascon_andnot_mve(x3, x4); \
+        t4 = ascon_andnot_mve(x4, x0); \
+        x0 = veorq_u32(x0, t1); \
+        x1 = veorq_u32(x1, t2); \
+        x2 = veorq_u32(x2, t3); \
+        x3 = veorq_u32(x3, t4); \
+        x4 = veorq_u32(x4, t0); \
+        x1 = veorq_u32(x1, x0); \
+        x0 = veorq_u32(x0, x4); \
+        x3 = veorq_u32(x3, x2); \
+        /* x2 = ~x2; */ \
+    } while (0)
+
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    const uint32_t *rc = RC + first_round * 2;
+    uint32x4_t x0_e, x1_e, x2_e, x3_e, x4_e;
+    uint32x4_t x0_o, x1_o, x2_o, x3_o, x4_o;
+    uint32x4_t t0, t1, t2, t3, t4;
+    uint32_t lanes[4];
+
+    /* Load the states into vectors and invert x2 before the rounds */
+    ascon_load_mve(state0, state1, state2, state3, 0, x0_e);
+    ascon_load_mve(state0, state1, state2, state3, 1, x0_o);
+    ascon_load_mve(state0, state1, state2, state3, 2, x1_e);
+    ascon_load_mve(state0, state1, state2, state3, 3, x1_o);
+    ascon_load_mve(state0, state1, state2, state3, 4, x2_e);
+    ascon_load_mve(state0, state1, state2, state3, 5, x2_o);
+    ascon_load_mve(state0, state1, state2, state3, 6, x3_e);
+    ascon_load_mve(state0, state1, state2, state3, 7, x3_o);
+    ascon_load_mve(state0, state1, state2, state3, 8, x4_e);
+    ascon_load_mve(state0, state1, state2, state3, 9, x4_o);
+    x2_e = vmvnq_u32(x2_e);
+    x2_o = vmvnq_u32(x2_o);
+
+    /* Perform all permutation rounds */
+    while (first_round < 12) {
+        /* Add the round constants for this round to the states */
+        x2_e = veorq_u32(x2_e, vdupq_n_u32(rc[0]));
+        x2_o = veorq_u32(x2_o, vdupq_n_u32(rc[1]));
+        rc += 2;
+
+        /* Substitution layer */
+        ascon_sbox_mve(x0_e, x1_e, x2_e, x3_e, x4_e);
+        ascon_sbox_mve(x0_o, x1_o, x2_o, x3_o, x4_o);
+
+        /* Linear diffusion layer */
+        /* x0 ^= rightRotate19_64(x0) ^ rightRotate28_64(x0); */
+        t0 = veorq_u32(x0_e, ascon_ror_mve(x0_o, 4));
+        t1 = veorq_u32(x0_o, ascon_ror_mve(x0_e, 5));
+        x0_e = veorq_u32(x0_e, ascon_ror_mve(t1, 9));
+        x0_o = veorq_u32(x0_o, ascon_ror_mve(t0, 10));
+        /* x1 ^= rightRotate61_64(x1) ^ rightRotate39_64(x1); */
+        t0 = veorq_u32(x1_e, ascon_ror_mve(x1_e, 11));
+        t1 = veorq_u32(x1_o, ascon_ror_mve(x1_o, 11));
+        x1_e = veorq_u32(x1_e, ascon_ror_mve(t1, 19));
+        x1_o = veorq_u32(x1_o, ascon_ror_mve(t0, 20));
+        /* x2 ^= rightRotate1_64(x2)  ^ rightRotate6_64(x2); */
+        t0 = veorq_u32(x2_e, ascon_ror_mve(x2_o, 2));
+        t1 = veorq_u32(x2_o, ascon_ror_mve(x2_e, 3));
+        x2_e = veorq_u32(x2_e, t1);
+        x2_o = veorq_u32(x2_o, ascon_ror_mve(t0, 1));
+        /* x3 ^= rightRotate10_64(x3) ^ rightRotate17_64(x3); */
+        t0 = veorq_u32(x3_e, ascon_ror_mve(x3_o, 3));
+        t1 = veorq_u32(x3_o, ascon_ror_mve(x3_e, 4));
+        x3_e = veorq_u32(x3_e, ascon_ror_mve(t0, 5));
+        x3_o = veorq_u32(x3_o, ascon_ror_mve(t1, 5));
+        /* x4 ^= rightRotate7_64(x4)  ^ rightRotate41_64(x4); */
+        t0 = veorq_u32(x4_e, ascon_ror_mve(x4_e, 17));
+        t1 = veorq_u32(x4_o, ascon_ror_mve(x4_o, 17));
+        x4_e = veorq_u32(x4_e, ascon_ror_mve(t1, 3));
+        x4_o = veorq_u32(x4_o, ascon_ror_mve(t0, 4));
+
+        /* Move onto the next round */
+        ++first_round;
+    }
+
+    /* Apply the final NOT to x2 and write the vectors back to the states */
+    x2_e = vmvnq_u32(x2_e);
+    x2_o = vmvnq_u32(x2_o);
+    ascon_store_mve(state0, state1, state2, state3, 0, x0_e);
+    ascon_store_mve(state0, state1, state2, state3, 1, x0_o);
+    ascon_store_mve(state0, state1, state2, state3, 2, x1_e);
+    ascon_store_mve(state0, state1, state2, state3, 3, x1_o);
+    ascon_store_mve(state0, state1, state2, state3, 4, x2_e);
+    ascon_store_mve(state0, state1, state2, state3, 5, x2_o);
+    ascon_store_mve(state0, state1, state2, state3, 6, x3_e);
+    ascon_store_mve(state0, state1, state2, state3, 7, x3_o);
+    ascon_store_mve(state0, state1, state2, state3, 8, x4_e);
+    ascon_store_mve(state0, state1, state2, state3, 9, x4_o);
+}
+
+#endif /* ASCON_BACKEND_MVE */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-state versions of the ASCON permutation for aarch64 systems that
+ * use NEON instructions to permute 2 states per vector register. */
+
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
+#include "../ascon-permutation.h"
+#include "ascon-select-backend.h"
+
+#if defined(ASCON_BACKEND_NEON)
+
+#include "ascon-vec.h"
+#include <arm_neon.h>
+
+/* The vbic instruction computes "a & ~b" so the arguments are reversed */
+#define ascon_andnot_neon(a, b) vbicq_u64((b), (a))
+
+/* Right rotation composed from a left shift and a shift-right-insert */
+#define ascon_ror_neon(x, n) vsriq_n_u64(vshlq_n_u64((x), 64 - (n)), (x), (n))
+
+/* NEON has no 64-bit "not" instruction, but the 8-bit one does the same */
+#define ascon_not_neon(x) \
+    vreinterpretq_u64_u8(vmvnq_u8(vreinterpretq_u8_u64((x))))
+
+/* Loads word i from two states into a vector */
+#define ascon_load_neon(s0, s1, i) \
+    vcombine_u64(vcreate_u64((s0)->S[(i)]), vcreate_u64((s1)->S[(i)]))
+
+/* Stores the lanes of a vector back into word i of two states */
+#define ascon_store_neon(s0, s1, i, x) \
+    do { \
+        (s0)->S[(i)] = vgetq_lane_u64((x), 0); \
+        (s1)->S[(i)] = vgetq_lane_u64((x), 1); \
+    } while (0)
+
+/* Loads a pair of states into the vectors x0, ..., x4, inverting x2 */
+#define ascon_load_pair(s0, s1, x) \
+    do { \
+        x##0 = ascon_load_neon((s0), (s1), 0); \
+        x##1 = ascon_load_neon((s0), (s1), 1); \
+        x##2 = ascon_not_neon(ascon_load_neon((s0), (s1), 2)); \
+        x##3 = ascon_load_neon((s0), (s1), 3); \
+        x##4 = ascon_load_neon((s0), (s1), 4); \
+    } while (0)
+
+/* Stores the vectors x0, ..., x4 back into a pair of states */
+#define ascon_store_pair(s0, s1, x) \
+    do { \
+        ascon_store_neon((s0), (s1), 0, x##0); \
+        ascon_store_neon((s0), (s1), 1, x##1); \
+        ascon_store_neon((s0), (s1), 2, ascon_not_neon(x##2)); \
+        ascon_store_neon((s0), (s1), 3, x##3); \
+        ascon_store_neon((s0), (s1), 4, x##4); \
+    } while (0)
+
+/* Performs a single round on the vectors x0, ..., x4 */
+#define ascon_round_neon(x, rc) \
+    ascon_vec_round(uint64x2_t, veorq_u64, ascon_andnot_neon, \
+                    ascon_ror_neon, x##0, x##1, x##2, x##3, x##4, (rc))
+
+void ascon_permute_x2
+    (ascon_state_t *state0, ascon_state_t *state1, uint8_t first_round)
+{
+    uint64x2_t a0, a1, a2, a3, a4;
+    uint64x2_t rc;
+    ascon_load_pair(state0, state1, a);
+    while (first_round < 12) {
+        rc = vdupq_n_u64(ascon_vec_rc[first_round]);
+        ascon_round_neon(a, rc);
+        ++first_round;
+    }
+    ascon_store_pair(state0, state1, a);
+}
+
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    /* Two pairs of states are interleaved to keep both of the NEON
+     * execution pipelines busy on typical Cortex-A cores */
+    uint64x2_t a0, a1, a2, a3, a4;
+    uint64x2_t b0, b1, b2, b3, b4;
+    uint64x2_t rc;
+    ascon_load_pair(state0, state1, a);
+    ascon_load_pair(state2, state3, b);
+    while (first_round < 12) {
+        rc = vdupq_n_u64(ascon_vec_rc[first_round]);
+        ascon_round_neon(a, rc);
+        ascon_round_neon(b, rc);
+        ++first_round;
+    }
+    ascon_store_pair(state0, state1, a);
+    ascon_store_pair(state2, state3, b);
+}
+
+/* Loads a pair of lanes from a structure-of-arrays state into the
+ * vectors x0, ..., x4, inverting x2 */
+#define ascon_load_soa(S, stride, x) \
+    do { \
+        x##0 = vld1q_u64((S)); \
+        x##1 = vld1q_u64((S) + (stride)); \
+        x##2 = ascon_not_neon(vld1q_u64((S) + (stride) * 2)); \
+        x##3 = vld1q_u64((S) + (stride) * 3); \
+        x##4 = vld1q_u64((S) + (stride) * 4); \
+    } while (0)
+
+/* Stores the vectors x0, ..., x4 back into a pair of lanes */
+#define ascon_store_soa(S, stride, x) \
+    do { \
+        vst1q_u64((S), x##0); \
+        vst1q_u64((S) + (stride), x##1); \
+        vst1q_u64((S) + (stride) * 2, ascon_not_neon(x##2)); \
+        vst1q_u64((S) + (stride) * 3, x##3); \
+        vst1q_u64((S) + (stride) * 4, x##4); \
+    } while (0)
+
+void ascon_permute_soa_x4
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    uint64x2_t a0, a1, a2, a3, a4;
+    uint64x2_t b0, b1, b2, b3, b4;
+    uint64x2_t rc;
+    ascon_load_soa(S, stride, a);
+    ascon_load_soa(S + 2, stride, b);
+    while (first_round < 12) {
+        rc = vdupq_n_u64(ascon_vec_rc[first_round]);
+        ascon_round_neon(a, rc);
+        ascon_round_neon(b, rc);
+        ++first_round;
+    }
+    ascon_store_soa(S, stride, a);
+    ascon_store_soa(S + 2, stride, b);
+}
+
+#endif /* ASCON_BACKEND_NEON */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/* Acquire/release scopes that are shared by all of the back ends */
+
+#include "../ascon-permutation.h"
+#include "ascon-select-backend.h"
+#include "ascon-util-snp.h"
+
+#if defined(ASCON_SCOPE_TRACKING)
+
+ascon_state_t *ascon_scope_state = 0;
+
+void ascon_acquire_scope(ascon_state_t *state)
+{
+    if (ascon_scope_state == state)
+        return;
+    if (ascon_scope_state)
+        ascon_release_scope(ascon_scope_state);
+    ascon_acquire(state);
+    ascon_scope_state = state;
+}
+
+void ascon_release_scope(ascon_state_t *state)
+{
+    if (state && ascon_scope_state == state) {
+        ascon_scope_state = 0;
+        ascon_release(state);
+    }
+}
+
+#else /* !ASCON_SCOPE_TRACKING */
+
+void ascon_acquire_scope(ascon_state_t *state)
+{
+    /* Acquire and release are free on this back end, so the operations
+     * inside the scope can acquire and release the state as usual */
+    (void)state;
+}
+
+void ascon_release_scope(ascon_state_t *state)
+{
+    (void)state;
+}
+
+#endif /* !ASCON_SCOPE_TRACKING */
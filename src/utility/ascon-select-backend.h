@@ -23,8 +23,44 @@
 #ifndef ASCON_SELECT_BACKEND_H
 #define ASCON_SELECT_BACKEND_H
 
+#include "../ascon-config.h"
+
 /* Select the default back end to use for the ASCON permutation,
- * and any properties we can use to optimize use of the permutation. */
+ * and any properties we can use to optimize use of the permutation.
+ *
+ * ASCON_BACKEND_INTERLEAVED is defined if the back end provides its own
+ * versions of ascon_permute_x2() and ascon_permute_x4() that run the
+ * states side by side.  Otherwise a generic version is used that
+ * permutes the states one after the other.
+ *
+ * ASCON_BACKEND_AVX2 and ASCON_BACKEND_AVX512 are defined if the back end
+ * provides versions of ascon_permute_x4() and ascon_permute_x8() that
+ * use AVX2 and AVX-512 vector instructions respectively.
+ *
+ * ASCON_BACKEND_NEON is defined if the back end provides versions of
+ * ascon_permute_x2() and ascon_permute_x4() that use ARM NEON.
+ *
+ * ASCON_BACKEND_WASM_SIMD is defined if the back end provides versions of
+ * ascon_permute_x2() and ascon_permute_x4() that use WebAssembly SIMD128.
+ *
+ * ASCON_BACKEND_MVE is defined if the back end provides a version of
+ * ascon_permute_x4() that uses the ARM M-profile Vector Extension (Helium).
+ *
+ * ASCON_BACKEND_BULK is defined if the back end provides its own versions
+ * of ascon_absorb_blocks(), ascon_encrypt_blocks(), ascon_decrypt_blocks(),
+ * ascon_squeeze_blocks(), and ascon_absorb_bits() that keep the state in
+ * registers between blocks.
+ * Otherwise a generic version is used that calls ascon_permute() for
+ * each block.
+ *
+ * ASCON_BACKEND_PRIVATE_SIZE is defined to the size of the back end's
+ * private state if it needs more than the 40 bytes in ascon_state_t.
+ * The extra state is allocated with ascon_state_pool_alloc().
+ *
+ * ASCON_BACKEND_SHARED is defined if ascon_acquire() and ascon_release()
+ * bind and unbind shared hardware, which makes them expensive enough
+ * to track ascon_acquire_scope() so that each block does not pay
+ * for them. */
 
 #if defined(ASCON_FORCE_C32)
 
@@ -37,31 +73,61 @@
 /* Force the use of the "c64" backend for testing purposes */
 #define ASCON_BACKEND_C64 1
 #define ASCON_BACKEND_SLICED64 1
+#define ASCON_BACKEND_INTERLEAVED 1
+#define ASCON_BACKEND_BULK 1
 
 #elif defined(ASCON_FORCE_DIRECT_XOR) || defined(ASCON_FORCE_GENERIC)
 
 /* Force the use of the "direct xor" backend for testing purposes */
 #define ASCON_BACKEND_C64_DIRECT_XOR 1
 #define ASCON_BACKEND_DIRECT_XOR 1
+#define ASCON_BACKEND_INTERLEAVED 1
+#define ASCON_BACKEND_BULK 1
+
+#elif defined(__AVR__) && defined(__AVR_TINY__)
+
+/* Reduced-core AVR devices (avrtiny; e.g. ATtiny10 and ATtiny40) only
+ * have registers r16 to r31 and lack LDD, STD, and MOVW, so they cannot
+ * run the AVR5 assembly code.  Use the portable 32-bit C backend. */
+#define ASCON_BACKEND_C32 1
+#define ASCON_BACKEND_SLICED32 1
 
 #elif defined(__AVR__) && __AVR_ARCH__ >= 5
 
-/* AVR5 assembly code backend */
+/* AVR5 assembly code backend.  This is also used for the AVRxt cores in
+ * megaAVR 0-series and tinyAVR 0/1/2-series devices (__AVR_ARCH__ == 103),
+ * which have a superset of the AVR5 instructions. */
 #define ASCON_BACKEND_AVR5 1
 #define ASCON_BACKEND_DIRECT_XOR 1
 
+#elif defined(__ARM_ARCH_ISA_THUMB) && __ARM_ARCH == 8 && \
+      defined(__ARM_FEATURE_MVE)
+
+/* ARMv8.1-M systems with Helium; e.g. ARM Cortex M55 and M85.  The ARMv7-M
+ * assembly code is used for single states.  The MVE version of
+ * ascon_permute_x4() has not been run on hardware or a simulator yet,
+ * so it is opt-in: define ASCON_MVE to use it for 4 states at once. */
+#define ASCON_BACKEND_ARMV7M 1
+#define ASCON_BACKEND_SLICED32 1
+#define ASCON_BACKEND_BULK 1
+#if defined(ASCON_MVE) && !defined(ASCON_NO_MVE)
+#define ASCON_BACKEND_MVE 1
+#endif
+
 #elif defined(__ARM_ARCH_ISA_THUMB) && __ARM_ARCH == 8 && defined(__ARM_ARCH_8M__)
 
 /* Assembly backend for ARMv8-M systems; e.g. ARM Cortex M33 */
 /* This can actually use the same backend as ARMv7-M systems */
 #define ASCON_BACKEND_ARMV7M 1
 #define ASCON_BACKEND_SLICED32 1
+#define ASCON_BACKEND_BULK 1
 
 #elif defined(__ARM_ARCH_ISA_THUMB) && __ARM_ARCH == 7
 
 /* Assembly backend for ARMv7-M systems; e.g. ARM Cortex M3, M4, and M7 */
 #define ASCON_BACKEND_ARMV7M 1
 #define ASCON_BACKEND_SLICED32 1
+#define ASCON_BACKEND_BULK 1
 
 #elif defined(__ARM_ARCH_ISA_THUMB) && __ARM_ARCH == 6
 
@@ -71,13 +137,42 @@
 
 #elif defined(__XTENSA__)
 
-/* Assembly backend for Xtensa-based systems */
+/* Assembly backend for Xtensa-based systems.  The PIE vector instructions
+ * of the ESP32-S3 are not used: they have no 64-bit lanes or rotations,
+ * so the permutation would need the 32-bit sliced form with several
+ * shifts and SAR updates per rotation, and the same assembly code must
+ * also build for the ESP32 and ESP32-S2, which lack PIE. */
 #define ASCON_BACKEND_XTENSA 1
 #define ASCON_BACKEND_SLICED64 1
+/* ASCON_BACKEND_BULK is not defined yet: the block and squeeze loops use
+ * the generic versions that call ascon_permute() for each block until
+ * there are Xtensa kernels that keep the state in registers, which need
+ * to cover both the windowed and the CALL0 ABIs. */
 #if !defined(__XTENSA_WINDOWED_ABI__)
 #define ASCON_BACKEND_FREE 1
 #endif
 
+#elif defined(__riscv) && __riscv_xlen == 32 && !defined(__riscv_32e)
+
+/* Assembly backend for 32-bit RISC-V systems; e.g. ESP32-C3 and ESP32-C6 */
+#define ASCON_BACKEND_RISCV32 1
+#define ASCON_BACKEND_SLICED32 1
+
+#elif defined(__wasm__)
+
+/* WebAssembly has native 64-bit integer operations even on wasm32,
+ * so the 64-bit C backend is faster than bit-slicing into 32-bit words */
+#define ASCON_BACKEND_C64 1
+#define ASCON_BACKEND_SLICED64 1
+#define ASCON_BACKEND_INTERLEAVED 1
+#define ASCON_BACKEND_BULK 1
+
+/* If the compiler is targeting SIMD128 (e.g. "-msimd128" with clang or
+ * emscripten), then the multi-state permutations can use it */
+#if defined(__wasm_simd128__) && !defined(ASCON_NO_WASM_SIMD)
+#define ASCON_BACKEND_WASM_SIMD 1
+#endif
+
 #elif defined(__x86_64) || defined(__x86_64__) || \
       defined(__aarch64__) || defined(__ARM_ARCH_ISA_A64) || \
       defined(_M_AMD64) || defined(_M_X64) || defined(_M_IA64) || \
@@ -86,6 +181,23 @@
 /* C backend for 64-bit systems with words in host byte order */
 #define ASCON_BACKEND_C64 1
 #define ASCON_BACKEND_SLICED64 1
+#define ASCON_BACKEND_INTERLEAVED 1
+#define ASCON_BACKEND_BULK 1
+
+/* On x86-64 systems with GCC or clang, the multi-state permutations can
+ * use AVX2 and AVX-512 if the CPU supports them.  The CPU is checked at
+ * runtime unless the compiler is already targeting the instruction set. */
+#if (defined(__x86_64) || defined(__x86_64__)) && \
+    (defined(__GNUC__) || defined(__clang__)) && !defined(ASCON_NO_AVX)
+#define ASCON_BACKEND_AVX2 1
+#define ASCON_BACKEND_AVX512 1
+#endif
+
+/* On aarch64 systems, the multi-state permutations can use NEON */
+#if (defined(__aarch64__) || defined(__ARM_ARCH_ISA_A64)) && \
+    (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(ASCON_NO_NEON)
+#define ASCON_BACKEND_NEON 1
+#endif
 
 #else
 
@@ -95,4 +207,52 @@
 
 #endif
 
+/* Size-optimized builds use the generic multi-state and bulk operations,
+ * which call ascon_permute() rather than having their own copies of the
+ * permutation rounds. */
+#if defined(ASCON_SMALL)
+#undef ASCON_BACKEND_INTERLEAVED
+#undef ASCON_BACKEND_BULK
+#undef ASCON_BACKEND_AVX2
+#undef ASCON_BACKEND_AVX512
+#undef ASCON_BACKEND_NEON
+#undef ASCON_BACKEND_WASM_SIMD
+#undef ASCON_BACKEND_MVE
+#endif
+
+/* The bulk operations have their own copies of the permutation rounds,
+ * so disable them when collecting statistics on the permutation calls */
+#if defined(ASCON_STATS)
+#undef ASCON_BACKEND_BULK
+#endif
+
+/* Select the section to place the permutation and the AEAD block kernels
+ * in if ASCON_FAST_RAM is defined.  This avoids flash wait states and
+ * cache misses on platforms that execute from external or slow flash.
+ * ASCON_RAM_SECTION can also be defined directly to pick a section that
+ * the platform's linker script maps into instruction RAM. */
+#if defined(ASCON_FAST_RAM) && !defined(ASCON_RAM_SECTION)
+#if defined(ESP8266)
+#define ASCON_RAM_SECTION ".iram.text"
+#elif defined(ESP32) || defined(ESP_PLATFORM)
+#define ASCON_RAM_SECTION ".iram1"
+#elif defined(TEENSYDUINO)
+#define ASCON_RAM_SECTION ".fastrun"
+#elif defined(ARDUINO_ARCH_RP2040) || defined(PICO_BOARD)
+#define ASCON_RAM_SECTION ".time_critical"
+#elif defined(ARDUINO_ARCH_STM32) || defined(USE_HAL_DRIVER)
+#define ASCON_RAM_SECTION ".RamFunc"
+#elif defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_SAM) || \
+      defined(__SAMD51__) || defined(__SAM3X8E__)
+#define ASCON_RAM_SECTION ".ramfunc"
+#endif
+#endif
+
+/* ASCON_HOT marks C functions that should be placed in RAM */
+#if defined(ASCON_RAM_SECTION) && !defined(__ASSEMBLER__)
+#define ASCON_HOT __attribute__((section(ASCON_RAM_SECTION)))
+#else
+#define ASCON_HOT
+#endif
+
 #endif
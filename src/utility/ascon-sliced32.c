@@ -41,6 +41,7 @@ void ascon_init(ascon_state_t *state)
 
 void ascon_free(ascon_state_t *state)
 {
+    ascon_scope_end(state);
     if (state) {
         ascon_backend_free(state);
         ascon_clean(state, sizeof(ascon_state_t));
@@ -260,12 +261,14 @@ void ascon_extract_and_overwrite_bytes
 
 void ascon_release(ascon_state_t *state)
 {
+    ascon_scope_elide(state);
     /* Not needed in this implementation */
     (void)state;
 }
 
 void ascon_acquire(ascon_state_t *state)
 {
+    ascon_scope_elide(state);
     /* Not needed in this implementation */
     (void)state;
 }
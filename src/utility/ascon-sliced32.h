@@ -63,6 +63,87 @@
         ascon_bit_permute_step((x), 0x0000ff00, 8); \
     } while (0)
 
+/* Versions of the bit permutation step, separate, and combine operations
+ * that process the two halves of a 64-bit word at once, which gives two
+ * independent dependency chains that the compiler can interleave. */
+#define ascon_bit_permute_step_pair(_x, _y, mask, shift) \
+    do { \
+        uint32_t m_ = (mask); \
+        uint32_t x = (_x); \
+        uint32_t y = (_y); \
+        uint32_t tx = ((x >> (shift)) ^ x) & m_; \
+        uint32_t ty = ((y >> (shift)) ^ y) & m_; \
+        (_x) = (x ^ tx) ^ (tx << (shift)); \
+        (_y) = (y ^ ty) ^ (ty << (shift)); \
+    } while (0)
+#define ascon_separate_pair(x, y) \
+    do { \
+        ascon_bit_permute_step_pair((x), (y), 0x22222222, 1); \
+        ascon_bit_permute_step_pair((x), (y), 0x0c0c0c0c, 2); \
+        ascon_bit_permute_step_pair((x), (y), 0x00f000f0, 4); \
+        ascon_bit_permute_step_pair((x), (y), 0x0000ff00, 8); \
+    } while (0)
+#define ascon_combine_pair(x, y) \
+    do { \
+        ascon_bit_permute_step_pair((x), (y), 0x0000aaaa, 15); \
+        ascon_bit_permute_step_pair((x), (y), 0x0000cccc, 14); \
+        ascon_bit_permute_step_pair((x), (y), 0x0000f0f0, 12); \
+        ascon_bit_permute_step_pair((x), (y), 0x0000ff00, 8); \
+    } while (0)
+
+/* Merges the separated halves of a 64-bit word into the even and odd
+ * words of the sliced form, and splits them apart again */
+#define ascon_sliced_even(high, low) (((high) << 16) | ((low) & 0x0000FFFFU))
+#define ascon_sliced_odd(high, low)  (((high) & 0xFFFF0000U) | ((low) >> 16))
+#define ascon_sliced_high(even, odd) (((even) >> 16) | ((odd) & 0xFFFF0000U))
+#define ascon_sliced_low(even, odd)  (((even) & 0x0000FFFFU) | ((odd) << 16))
+
+#if defined(ASCON_BACKEND_ARMV6M)
+
+/* ARMv6-M has assembly versions of the conversions in ascon-asm-armv6m.S.
+ * Inlining the C versions would expand to about 100 Thumb-1 instructions
+ * with literal pool loads at every use, and the data may be unaligned,
+ * which needs byte loads and stores on ARMv6-M anyway. */
+uint64_t ascon_sliced32_load(const unsigned char *data);
+void ascon_sliced32_store(unsigned char *data, uint32_t even, uint32_t odd);
+
+#define ascon_sliced_load(data, even, odd) \
+    do { \
+        uint64_t v_ = ascon_sliced32_load((data)); \
+        (even) = (uint32_t)v_; \
+        (odd) = (uint32_t)(v_ >> 32); \
+    } while (0)
+#define ascon_sliced_store(data, even, odd) \
+    ascon_sliced32_store((data), (even), (odd))
+
+#else
+
+/* Loads 8 bytes in big-endian byte order and converts them into the
+ * even and odd words of the sliced form */
+#define ascon_sliced_load(data, even, odd) \
+    do { \
+        uint32_t high = be_load_word32((data)); \
+        uint32_t low  = be_load_word32((data) + 4); \
+        ascon_separate_pair(high, low); \
+        (even) = ascon_sliced_even(high, low); \
+        (odd) = ascon_sliced_odd(high, low); \
+    } while (0)
+
+/* Converts the even and odd words of the sliced form back into 8 bytes
+ * in big-endian byte order and stores them */
+#define ascon_sliced_store(data, even, odd) \
+    do { \
+        uint32_t e_ = (even); \
+        uint32_t o_ = (odd); \
+        uint32_t high = ascon_sliced_high(e_, o_); \
+        uint32_t low  = ascon_sliced_low(e_, o_); \
+        ascon_combine_pair(high, low); \
+        be_store_word32((data), high); \
+        be_store_word32((data) + 4, low); \
+    } while (0)
+
+#endif
+
 /** @endcond */
 
 /**
@@ -76,12 +157,8 @@
 #define ascon_set_sliced(state, data, offset) \
     do { \
         ascon_state_t *s = (state); \
-        uint32_t high = be_load_word32((data)); \
-        uint32_t low  = be_load_word32((data) + 4); \
-        ascon_separate(high); \
-        ascon_separate(low); \
-        s->W[(offset) * 2] = (high << 16) | (low & 0x0000FFFFU); \
-        s->W[(offset) * 2 + 1] = (high & 0xFFFF0000U) | (low >> 16); \
+        ascon_sliced_load((data), s->W[(offset) * 2], \
+                          s->W[(offset) * 2 + 1]); \
     } while (0)
 
 /*
@@ -97,10 +174,9 @@
         ascon_state_t *s = (state); \
         uint32_t high = (uint32_t)((value) >> 32); \
         uint32_t low  = (uint32_t)(value); \
-        ascon_separate(high); \
-        ascon_separate(low); \
-        s->W[(offset) * 2] = (high << 16) | (low & 0x0000FFFFU); \
-        s->W[(offset) * 2 + 1] = (high & 0xFFFF0000U) | (low >> 16); \
+        ascon_separate_pair(high, low); \
+        s->W[(offset) * 2] = ascon_sliced_even(high, low); \
+        s->W[(offset) * 2 + 1] = ascon_sliced_odd(high, low); \
     } while (0)
 
 /**
@@ -114,12 +190,10 @@
 #define ascon_absorb_sliced(state, data, offset) \
     do { \
         ascon_state_t *s = (state); \
-        uint32_t high = be_load_word32((data)); \
-        uint32_t low  = be_load_word32((data) + 4); \
-        ascon_separate(high); \
-        ascon_separate(low); \
-        s->W[(offset) * 2] ^= (high << 16) | (low & 0x0000FFFFU); \
-        s->W[(offset) * 2 + 1] ^= (high & 0xFFFF0000U) | (low >> 16); \
+        uint32_t even, odd; \
+        ascon_sliced_load((data), even, odd); \
+        s->W[(offset) * 2] ^= even; \
+        s->W[(offset) * 2 + 1] ^= odd; \
     } while (0)
 
 /**
@@ -135,10 +209,9 @@
         ascon_state_t *s = (state); \
         uint32_t high = (uint32_t)((value) >> 32); \
         uint32_t low  = (uint32_t)(value); \
-        ascon_separate(high); \
-        ascon_separate(low); \
-        s->W[(offset) * 2] ^= (high << 16) | (low & 0x0000FFFFU); \
-        s->W[(offset) * 2 + 1] ^= (high & 0xFFFF0000U) | (low >> 16); \
+        ascon_separate_pair(high, low); \
+        s->W[(offset) * 2] ^= ascon_sliced_even(high, low); \
+        s->W[(offset) * 2 + 1] ^= ascon_sliced_odd(high, low); \
     } while (0)
 
 /**
@@ -190,15 +263,8 @@
 #define ascon_squeeze_sliced(state, data, offset) \
     do { \
         const ascon_state_t *s = (state); \
-        uint32_t high, low; \
-        high = (s->W[(offset) * 2] >> 16) | \
-               (s->W[(offset) * 2 + 1] & 0xFFFF0000U); \
-        low  = (s->W[(offset) * 2] & 0x0000FFFFU) | \
-               (s->W[(offset) * 2 + 1] << 16); \
-        ascon_combine(high); \
-        ascon_combine(low); \
-        be_store_word32((data), high); \
-        be_store_word32((data) + 4, low); \
+        ascon_sliced_store((data), s->W[(offset) * 2], \
+                           s->W[(offset) * 2 + 1]); \
     } while (0)
 
 /**
@@ -212,13 +278,11 @@
 #define ascon_squeeze_word64(state, value, offset) \
     do { \
         const ascon_state_t *s = (state); \
-        uint32_t high, low; \
-        high = (s->W[(offset) * 2] >> 16) | \
-               (s->W[(offset) * 2 + 1] & 0xFFFF0000U); \
-        low  = (s->W[(offset) * 2] & 0x0000FFFFU) | \
-               (s->W[(offset) * 2 + 1] << 16); \
-        ascon_combine(high); \
-        ascon_combine(low); \
+        uint32_t even = s->W[(offset) * 2]; \
+        uint32_t odd = s->W[(offset) * 2 + 1]; \
+        uint32_t high = ascon_sliced_high(even, odd); \
+        uint32_t low  = ascon_sliced_low(even, odd); \
+        ascon_combine_pair(high, low); \
         (value) = (((uint64_t)high) << 32) | low; \
     } while (0)
 
@@ -233,21 +297,8 @@
  */
 #define ascon_encrypt_sliced(state, c, m, offset) \
     do { \
-        ascon_state_t *s = (state); \
-        uint32_t high = be_load_word32((m)); \
-        uint32_t low  = be_load_word32((m) + 4); \
-        ascon_separate(high); \
-        ascon_separate(low); \
-        s->W[(offset) * 2] ^= (high << 16) | (low & 0x0000FFFFU); \
-        s->W[(offset) * 2 + 1] ^= (high & 0xFFFF0000U) | (low >> 16); \
-        high = (s->W[(offset) * 2] >> 16) | \
-               (s->W[(offset) * 2 + 1] & 0xFFFF0000U); \
-        low  = (s->W[(offset) * 2] & 0x0000FFFFU) | \
-               (s->W[(offset) * 2 + 1] << 16); \
-        ascon_combine(high); \
-        ascon_combine(low); \
-        be_store_word32((c), high); \
-        be_store_word32((c) + 4, low); \
+        ascon_absorb_sliced((state), (m), (offset)); \
+        ascon_squeeze_sliced((state), (c), (offset)); \
     } while (0)
 
 /**
@@ -262,21 +313,13 @@
 #define ascon_decrypt_sliced(state, m, c, offset) \
     do { \
         ascon_state_t *s = (state); \
-        uint32_t high, low, high2, low2; \
-        high = be_load_word32((c)); \
-        low  = be_load_word32((c) + 4); \
-        ascon_separate(high); \
-        ascon_separate(low); \
-        high2 = high ^ ((s->W[(offset) * 2] >> 16) | \
-                        (s->W[(offset) * 2 + 1] & 0xFFFF0000U)); \
-        low2 = low ^ ((s->W[(offset) * 2] & 0x0000FFFFU) | \
-                      (s->W[(offset) * 2 + 1] << 16)); \
-        s->W[(offset) * 2] = (high << 16) | (low & 0x0000FFFFU); \
-        s->W[(offset) * 2 + 1] = (high & 0xFFFF0000U) | (low >> 16); \
-        ascon_combine(high2); \
-        ascon_combine(low2); \
-        be_store_word32((m), high2); \
-        be_store_word32((m) + 4, low2); \
+        uint32_t even, odd, m_even, m_odd; \
+        ascon_sliced_load((c), even, odd); \
+        m_even = s->W[(offset) * 2] ^ even; \
+        m_odd = s->W[(offset) * 2 + 1] ^ odd; \
+        s->W[(offset) * 2] = even; \
+        s->W[(offset) * 2 + 1] = odd; \
+        ascon_sliced_store((m), m_even, m_odd); \
     } while (0)
 
 /**
@@ -292,19 +335,90 @@
 #define ascon_decrypt_sliced_no_insert(state, m, c, offset) \
     do { \
         const ascon_state_t *s = (state); \
-        uint32_t high, low; \
-        high = be_load_word32((c)); \
-        low  = be_load_word32((c) + 4); \
-        ascon_separate(high); \
-        ascon_separate(low); \
-        high ^= ((s->W[(offset) * 2] >> 16) | \
-                 (s->W[(offset) * 2 + 1] & 0xFFFF0000U)); \
-        low  ^= ((s->W[(offset) * 2] & 0x0000FFFFU) | \
-                 (s->W[(offset) * 2 + 1] << 16)); \
-        ascon_combine(high); \
-        ascon_combine(low); \
-        be_store_word32((m), high); \
-        be_store_word32((m) + 4, low); \
+        uint32_t even, odd; \
+        ascon_sliced_load((c), even, odd); \
+        even ^= s->W[(offset) * 2]; \
+        odd ^= s->W[(offset) * 2 + 1]; \
+        ascon_sliced_store((m), even, odd); \
+    } while (0)
+
+/**
+ * \brief Absorbs 16 bytes of data into the ASCON state in sliced form.
+ *
+ * \param state The ASCON state for the data to be absorbed into.
+ * \param data Points to 16 bytes of data in big-endian byte order to absorb.
+ * \param offset Offset of the first 64-bit word within the state to absorb
+ * at, between 0 and 3.
+ *
+ * Both 64-bit words are converted before either is absorbed so that the
+ * conversion of one can overlap with the other.
+ */
+#define ascon_absorb16_sliced(state, data, offset) \
+    do { \
+        ascon_state_t *s = (state); \
+        uint32_t even0, odd0, even1, odd1; \
+        ascon_sliced_load((data), even0, odd0); \
+        ascon_sliced_load((data) + 8, even1, odd1); \
+        s->W[(offset) * 2] ^= even0; \
+        s->W[(offset) * 2 + 1] ^= odd0; \
+        s->W[(offset) * 2 + 2] ^= even1; \
+        s->W[(offset) * 2 + 3] ^= odd1; \
+    } while (0)
+
+/**
+ * \brief Squeezes 16 bytes of data from the ASCON state in sliced form.
+ *
+ * \param state The ASCON state to extract the data from.
+ * \param data Points to the 16 bytes to be extracted from the state.
+ * \param offset Offset of the first 64-bit word within the state to
+ * extract, between 0 and 3.
+ */
+#define ascon_squeeze16_sliced(state, data, offset) \
+    do { \
+        ascon_squeeze_sliced((state), (data), (offset)); \
+        ascon_squeeze_sliced((state), (data) + 8, (offset) + 1); \
+    } while (0)
+
+/**
+ * \brief Encrypts 16 bytes of data using the ASCON state in sliced form.
+ *
+ * \param state The ASCON state.
+ * \param c Points to 16 bytes of output ciphertext in big-endian byte order.
+ * \param m Points to 16 bytes of input plaintext in big-endian byte order.
+ * \param offset Offset of the first 64-bit word within the state to absorb
+ * and squeeze at, between 0 and 3.
+ */
+#define ascon_encrypt16_sliced(state, c, m, offset) \
+    do { \
+        ascon_absorb16_sliced((state), (m), (offset)); \
+        ascon_squeeze16_sliced((state), (c), (offset)); \
+    } while (0)
+
+/**
+ * \brief Decrypts 16 bytes of data using the ASCON state in sliced form.
+ *
+ * \param state The ASCON state.
+ * \param m Points to 16 bytes of output plaintext in big-endian byte order.
+ * \param c Points to 16 bytes of input ciphertext in big-endian byte order.
+ * \param offset Offset of the first 64-bit word within the state to absorb
+ * and squeeze at, between 0 and 3.
+ */
+#define ascon_decrypt16_sliced(state, m, c, offset) \
+    do { \
+        ascon_state_t *s = (state); \
+        uint32_t even0, odd0, even1, odd1; \
+        ascon_sliced_load((c), even0, odd0); \
+        ascon_sliced_load((c) + 8, even1, odd1); \
+        even0 ^= s->W[(offset) * 2]; \
+        odd0 ^= s->W[(offset) * 2 + 1]; \
+        even1 ^= s->W[(offset) * 2 + 2]; \
+        odd1 ^= s->W[(offset) * 2 + 3]; \
+        s->W[(offset) * 2] ^= even0; \
+        s->W[(offset) * 2 + 1] ^= odd0; \
+        s->W[(offset) * 2 + 2] ^= even1; \
+        s->W[(offset) * 2 + 3] ^= odd1; \
+        ascon_sliced_store((m), even0, odd0); \
+        ascon_sliced_store((m) + 8, even1, odd1); \
     } while (0)
 
 #endif /* ASCON_BACKEND_SLICED32 */
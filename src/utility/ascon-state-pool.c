@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "ascon-state-pool.h"
+#include "../ascon-permutation.h"
+#include "../ascon-utility.h"
+#include <stdlib.h>
+
+/* Allocator that was registered by the application, if any */
+static ascon_state_alloc_t ascon_state_custom_alloc = 0;
+static ascon_state_dealloc_t ascon_state_custom_dealloc = 0;
+
+void ascon_set_state_allocator
+    (ascon_state_alloc_t alloc, ascon_state_dealloc_t dealloc)
+{
+    if (alloc && dealloc) {
+        ascon_state_custom_alloc = alloc;
+        ascon_state_custom_dealloc = dealloc;
+    } else {
+        ascon_state_custom_alloc = 0;
+        ascon_state_custom_dealloc = 0;
+    }
+}
+
+#if defined(ASCON_BACKEND_PRIVATE_SIZE)
+
+#if ASCON_STATE_POOL_SIZE > 255
+#error "ASCON_STATE_POOL_SIZE is too large"
+#endif
+
+#if ASCON_STATE_POOL_SIZE > 0
+
+/* Entry in the static arena, aligned for the back end's word accesses */
+typedef union
+{
+    unsigned char data[ASCON_BACKEND_PRIVATE_SIZE];
+    uint64_t align64;
+    void *align_ptr;
+
+} ascon_state_pool_entry_t;
+
+static ascon_state_pool_entry_t ascon_state_pool[ASCON_STATE_POOL_SIZE];
+
+/* The free list is stored as offsets so that the zero-initialized arena
+ * starts out with every entry on the list.  The successor of entry i is
+ * i + 1 + ascon_state_pool_link[i], and ASCON_STATE_POOL_SIZE marks the
+ * end of the list.
+ *
+ * The head of the list holds the index of the first free entry in the
+ * low 8 bits and a modification count in the other bits.  The count
+ * changes on every update, which stops an ABA race from corrupting
+ * the list when an entry is popped and pushed again between the load
+ * and the compare-and-swap in another thread. */
+static int16_t ascon_state_pool_link[ASCON_STATE_POOL_SIZE];
+static uint32_t ascon_state_pool_head = 0;
+
+#endif /* ASCON_STATE_POOL_SIZE > 0 */
+
+void *ascon_state_pool_alloc(void)
+{
+#if ASCON_STATE_POOL_SIZE > 0
+    uint32_t head, next;
+    unsigned index;
+#endif
+
+    /* Use the application's allocator if one was registered */
+    if (ascon_state_custom_alloc)
+        return (*ascon_state_custom_alloc)(ASCON_BACKEND_PRIVATE_SIZE);
+
+#if ASCON_STATE_POOL_SIZE > 0
+    /* Pop the first entry off the free list */
+    head = __atomic_load_n(&ascon_state_pool_head, __ATOMIC_ACQUIRE);
+    for (;;) {
+        index = head & 0xFFU;
+        if (index >= ASCON_STATE_POOL_SIZE)
+            break; /* The arena is empty */
+        next = index + 1 + ascon_state_pool_link[index];
+        next |= (head + 0x100U) & ~((uint32_t)0xFFU);
+        if (__atomic_compare_exchange_n
+                (&ascon_state_pool_head, &head, next, 1,
+                 __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return ascon_state_pool[index].data;
+        }
+    }
+#endif
+
+    /* Fall back to the heap if the arena has run out */
+#if defined(ASCON_STATE_POOL_NO_MALLOC)
+    return 0;
+#else
+    return malloc(ASCON_BACKEND_PRIVATE_SIZE);
+#endif
+}
+
+void ascon_state_pool_free(void *ptr)
+{
+#if ASCON_STATE_POOL_SIZE > 0
+    uint32_t head, next;
+    unsigned index;
+#endif
+
+    if (!ptr)
+        return;
+    ascon_clean(ptr, ASCON_BACKEND_PRIVATE_SIZE);
+    if (ascon_state_custom_dealloc) {
+        (*ascon_state_custom_dealloc)(ptr, ASCON_BACKEND_PRIVATE_SIZE);
+        return;
+    }
+
+#if ASCON_STATE_POOL_SIZE > 0
+    /* Push the entry back onto the free list if it came from the arena */
+    if ((ascon_state_pool_entry_t *)ptr >= ascon_state_pool &&
+            (ascon_state_pool_entry_t *)ptr <
+                (ascon_state_pool + ASCON_STATE_POOL_SIZE)) {
+        index = (unsigned)((ascon_state_pool_entry_t *)ptr - ascon_state_pool);
+        head = __atomic_load_n(&ascon_state_pool_head, __ATOMIC_ACQUIRE);
+        do {
+            ascon_state_pool_link[index] =
+                (int16_t)((int)(head & 0xFFU) - (int)index - 1);
+            next = ((head + 0x100U) & ~((uint32_t)0xFFU)) | index;
+        } while (!__atomic_compare_exchange_n
+                    (&ascon_state_pool_head, &head, next, 1,
+                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+        return;
+    }
+#endif
+
+#if !defined(ASCON_STATE_POOL_NO_MALLOC)
+    free(ptr);
+#endif
+}
+
+#endif /* ASCON_BACKEND_PRIVATE_SIZE */
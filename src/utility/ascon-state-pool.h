@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_STATE_POOL_H
+#define ASCON_STATE_POOL_H
+
+/**
+ * \file ascon-state-pool.h
+ * \brief Allocation of private permutation state for back ends that need
+ * more than 40 bytes.
+ *
+ * This is not a public API and should only be used by the library itself.
+ *
+ * A back end that needs a larger private structure defines
+ * ASCON_BACKEND_PRIVATE_SIZE to the size of that structure and
+ * ASCON_BACKEND_INIT / ASCON_BACKEND_FREE.  Its ascon_backend_init()
+ * calls ascon_state_pool_alloc() and stores the result in P[0], and
+ * its ascon_backend_free() calls ascon_state_pool_free().
+ *
+ * Structures come from a static arena of ASCON_STATE_POOL_SIZE entries that
+ * is managed as a lock-free free list.  If the application has registered
+ * an allocator with ascon_set_state_allocator(), then that is used instead.
+ * If the arena runs out, the structure is allocated with malloc() unless
+ * ASCON_STATE_POOL_NO_MALLOC is defined.
+ */
+
+#include "ascon-select-backend.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \def ASCON_STATE_POOL_SIZE
+ * \brief Number of private permutation states in the static arena.
+ */
+#if !defined(ASCON_STATE_POOL_SIZE)
+#define ASCON_STATE_POOL_SIZE 4
+#endif
+
+#if defined(ASCON_BACKEND_PRIVATE_SIZE)
+
+/**
+ * \brief Allocates a private permutation state of
+ * ASCON_BACKEND_PRIVATE_SIZE bytes.
+ *
+ * \return A pointer to the state, or NULL if no memory is available.
+ */
+void *ascon_state_pool_alloc(void);
+
+/**
+ * \brief Cleans and frees a private permutation state.
+ *
+ * \param ptr Pointer to the state from ascon_state_pool_alloc().
+ * May be NULL.
+ */
+void ascon_state_pool_free(void *ptr);
+
+#endif /* ASCON_BACKEND_PRIVATE_SIZE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
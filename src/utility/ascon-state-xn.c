@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-lane states in structure-of-arrays form.  Word i of lane j is at
+ * S[i * stride + j], and the words are always in standard form.  Back ends
+ * with vector instructions provide their own ascon_permute_soa_x4() and
+ * ascon_permute_soa_x8(), and the portable versions are here. */
+
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
+#include "ascon-multi.h"
+#include "ascon-util.h"
+#include "ascon-vec.h"
+#include "../ascon-utility.h"
+#include <string.h>
+
+/* Operations on scalar words for ascon_vec_round() */
+#define ascon_xor_soa(a, b) ((a) ^ (b))
+#define ascon_andnot_soa(a, b) ((~(a)) & (b))
+#define ascon_ror_soa(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+void ascon_permute_soa_generic
+    (uint64_t *S, unsigned stride, unsigned lanes, uint8_t first_round)
+{
+    uint64_t x0, x1, x2, x3, x4;
+    uint8_t round;
+    while (lanes > 0) {
+        x0 = S[0];
+        x1 = S[stride];
+        x2 = ~S[stride * 2];
+        x3 = S[stride * 3];
+        x4 = S[stride * 4];
+        for (round = first_round; round < 12; ++round) {
+            ascon_vec_round
+                (uint64_t, ascon_xor_soa, ascon_andnot_soa, ascon_ror_soa,
+                 x0, x1, x2, x3, x4, ascon_vec_rc[round]);
+        }
+        S[0] = x0;
+        S[stride] = x1;
+        S[stride * 2] = ~x2;
+        S[stride * 3] = x3;
+        S[stride * 4] = x4;
+        ++S;
+        --lanes;
+    }
+}
+
+#if !defined(ASCON_BACKEND_AVX2) && !defined(ASCON_BACKEND_NEON)
+
+void ascon_permute_soa_x4
+    (uint64_t *S, unsigned stride, uint8_t first_round)
+{
+    ascon_permute_soa_generic(S, stride, 4, first_round);
+}
+
+#endif
+
+#if !defined(ASCON_BACKEND_AVX512)
+
+void ascon_permute_soa_x8(uint64_t *S, uint8_t first_round)
+{
+    ascon_permute_soa_x4(S, 8, first_round);
+    ascon_permute_soa_x4(S + 4, 8, first_round);
+}
+
+#endif
+
+/**
+ * \brief Overwrites or adds bytes in one lane of a structure-of-arrays
+ * state.
+ *
+ * \param S Points to word 0 of the lane.
+ * \param stride Distance between consecutive words of the lane.
+ * \param data Points to the bytes.
+ * \param offset Offset into the lane.
+ * \param size Number of bytes.
+ * \param add Non-zero to XOR the bytes with the lane, or zero to
+ * overwrite the bytes in the lane.
+ */
+static void ascon_state_xn_set_bytes
+    (uint64_t *S, unsigned stride, const uint8_t *data,
+     unsigned offset, unsigned size, int add)
+{
+    uint64_t *word;
+    unsigned shift;
+    while (size > 0) {
+        word = S + (offset / 8U) * stride;
+        if ((offset % 8U) == 0 && size >= 8) {
+            if (add)
+                *word ^= be_load_word64(data);
+            else
+                *word = be_load_word64(data);
+            data += 8;
+            offset += 8;
+            size -= 8;
+        } else {
+            shift = 56U - (offset % 8U) * 8U;
+            if (!add)
+                *word &= ~(((uint64_t)0xFFU) << shift);
+            *word ^= ((uint64_t)(*data++)) << shift;
+            ++offset;
+            --size;
+        }
+    }
+}
+
+/**
+ * \brief Extracts bytes from one lane of a structure-of-arrays state.
+ *
+ * \param S Points to word 0 of the lane.
+ * \param stride Distance between consecutive words of the lane.
+ * \param data Points to the buffer to receive the bytes.
+ * \param offset Offset into the lane.
+ * \param size Number of bytes.
+ */
+static void ascon_state_xn_extract_bytes
+    (const uint64_t *S, unsigned stride, uint8_t *data,
+     unsigned offset, unsigned size)
+{
+    const uint64_t *word;
+    while (size > 0) {
+        word = S + (offset / 8U) * stride;
+        if ((offset % 8U) == 0 && size >= 8) {
+            be_store_word64(data, *word);
+            data += 8;
+            offset += 8;
+            size -= 8;
+        } else {
+            *data++ = (uint8_t)(*word >> (56U - (offset % 8U) * 8U));
+            ++offset;
+            --size;
+        }
+    }
+}
+
+void ascon_state_x4_init(ascon_state_x4_t *state)
+{
+    memset(state, 0, sizeof(ascon_state_x4_t));
+}
+
+void ascon_state_x4_free(ascon_state_x4_t *state)
+{
+    if (state)
+        ascon_clean(state, sizeof(ascon_state_x4_t));
+}
+
+void ascon_state_x4_overwrite_bytes
+    (ascon_state_x4_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size)
+{
+    ascon_state_xn_set_bytes(&(state->S[0][lane]), 4, data, offset, size, 0);
+}
+
+void ascon_state_x4_add_bytes
+    (ascon_state_x4_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size)
+{
+    ascon_state_xn_set_bytes(&(state->S[0][lane]), 4, data, offset, size, 1);
+}
+
+void ascon_state_x4_extract_bytes
+    (const ascon_state_x4_t *state, unsigned lane, uint8_t *data,
+     unsigned offset, unsigned size)
+{
+    ascon_state_xn_extract_bytes(&(state->S[0][lane]), 4, data, offset, size);
+}
+
+void ascon_state_x4_permute(ascon_state_x4_t *state, uint8_t first_round)
+{
+    ascon_permute_soa_x4(&(state->S[0][0]), 4, first_round);
+}
+
+void ascon_state_x8_init(ascon_state_x8_t *state)
+{
+    memset(state, 0, sizeof(ascon_state_x8_t));
+}
+
+void ascon_state_x8_free(ascon_state_x8_t *state)
+{
+    if (state)
+        ascon_clean(state, sizeof(ascon_state_x8_t));
+}
+
+void ascon_state_x8_overwrite_bytes
+    (ascon_state_x8_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size)
+{
+    ascon_state_xn_set_bytes(&(state->S[0][lane]), 8, data, offset, size, 0);
+}
+
+void ascon_state_x8_add_bytes
+    (ascon_state_x8_t *state, unsigned lane, const uint8_t *data,
+     unsigned offset, unsigned size)
+{
+    ascon_state_xn_set_bytes(&(state->S[0][lane]), 8, data, offset, size, 1);
+}
+
+void ascon_state_x8_extract_bytes
+    (const ascon_state_x8_t *state, unsigned lane, uint8_t *data,
+     unsigned offset, unsigned size)
+{
+    ascon_state_xn_extract_bytes(&(state->S[0][lane]), 8, data, offset, size);
+}
+
+void ascon_state_x8_permute(ascon_state_x8_t *state, uint8_t first_round)
+{
+    ascon_permute_soa_x8(&(state->S[0][0]), first_round);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Statistics on the use of the ASCON permutation, for profiling */
+
+#include "../ascon-permutation.h"
+#include <string.h>
+
+#if defined(ASCON_STATS)
+
+static ascon_stats_t ascon_stats_global;
+static ascon_stats_t *ascon_stats_context = 0;
+
+void ascon_stats_count_permute(unsigned count, uint8_t first_round)
+{
+    unsigned rounds = count * (12U - first_round);
+    ascon_stats_global.permutations += count;
+    ascon_stats_global.rounds += rounds;
+    if (ascon_stats_context) {
+        ascon_stats_context->permutations += count;
+        ascon_stats_context->rounds += rounds;
+    }
+}
+
+void ascon_stats_count_bytes(size_t absorbed, size_t squeezed)
+{
+    ascon_stats_global.absorbed += absorbed;
+    ascon_stats_global.squeezed += squeezed;
+    if (ascon_stats_context) {
+        ascon_stats_context->absorbed += absorbed;
+        ascon_stats_context->squeezed += squeezed;
+    }
+}
+
+void ascon_stats_get(ascon_stats_t *stats)
+{
+    memcpy(stats, &ascon_stats_global, sizeof(ascon_stats_t));
+}
+
+void ascon_stats_reset(void)
+{
+    memset(&ascon_stats_global, 0, sizeof(ascon_stats_t));
+}
+
+ascon_stats_t *ascon_stats_select(ascon_stats_t *context)
+{
+    ascon_stats_t *prev = ascon_stats_context;
+    ascon_stats_context = context;
+    return prev;
+}
+
+#else /* !ASCON_STATS */
+
+void ascon_stats_get(ascon_stats_t *stats)
+{
+    memset(stats, 0, sizeof(ascon_stats_t));
+}
+
+void ascon_stats_reset(void)
+{
+}
+
+ascon_stats_t *ascon_stats_select(ascon_stats_t *context)
+{
+    (void)context;
+    return 0;
+}
+
+#endif /* !ASCON_STATS */
@@ -21,26 +21,87 @@
  */
 
 #include "ascon-trng.h"
+#include "../ascon-latency.h"
 #include <string.h>
 
 #if defined(ASCON_TRNG_DUE)
 
 #include <Arduino.h>
 
+/* Define ASCON_TRNG_DUE_RING_SIZE to a power of two to collect TRNG words
+ * in the background from the TRNG interrupt.  Requests for random words
+ * are then served from the ring buffer without waiting, falling back to
+ * polling the TRNG only when the buffer is empty.  The default is zero,
+ * which always polls the TRNG and leaves the interrupt alone. */
+#if !defined(ASCON_TRNG_DUE_RING_SIZE)
+#define ASCON_TRNG_DUE_RING_SIZE 0
+#endif
+#if (ASCON_TRNG_DUE_RING_SIZE & (ASCON_TRNG_DUE_RING_SIZE - 1)) != 0
+#error "ASCON_TRNG_DUE_RING_SIZE must be a power of two"
+#endif
+
 static int volatile due_init_done = 0;
 
+#if ASCON_TRNG_DUE_RING_SIZE > 0
+
+/* Ring buffer of TRNG words.  The interrupt handler is the only writer
+ * of due_ring_head and the application is the only writer of
+ * due_ring_tail, so no locking is needed.  The indices run freely and
+ * are masked when the buffer is accessed. */
+static uint32_t volatile due_ring[ASCON_TRNG_DUE_RING_SIZE];
+static unsigned volatile due_ring_head = 0;
+static unsigned volatile due_ring_tail = 0;
+
+#define DUE_RING_MASK (ASCON_TRNG_DUE_RING_SIZE - 1)
+
+void TRNG_Handler(void)
+{
+    unsigned head = due_ring_head;
+    if ((REG_TRNG_ISR & TRNG_ISR_DATRDY) != 0) {
+        if ((head - due_ring_tail) < ASCON_TRNG_DUE_RING_SIZE) {
+            due_ring[head & DUE_RING_MASK] = REG_TRNG_ODATA;
+            due_ring_head = head + 1;
+        } else {
+            /* The buffer is full, so stop collecting until a word is used */
+            REG_TRNG_IDR = TRNG_IDR_DATRDY;
+        }
+    }
+}
+
+static inline int ascon_trng_ring_take(uint32_t *x)
+{
+    unsigned tail = due_ring_tail;
+    if (tail == due_ring_head)
+        return 0;
+    *x = due_ring[tail & DUE_RING_MASK];
+    due_ring[tail & DUE_RING_MASK] = 0;
+    due_ring_tail = tail + 1;
+
+    /* There is now room in the buffer, so resume collecting */
+    REG_TRNG_IER = TRNG_IER_DATRDY;
+    return 1;
+}
+
+#endif /* ASCON_TRNG_DUE_RING_SIZE > 0 */
+
 static inline void ascon_trng_init_internal(void)
 {
     if (!due_init_done) {
         /* Once-only initialization of the TRNG peripheral */
         pmc_enable_periph_clk(ID_TRNG);
         REG_TRNG_CR = TRNG_CR_KEY(0x524E47) | TRNG_CR_ENABLE;
+#if ASCON_TRNG_DUE_RING_SIZE > 0
+        REG_TRNG_IER = TRNG_IER_DATRDY;
+        NVIC_ClearPendingIRQ(TRNG_IRQn);
+        NVIC_EnableIRQ(TRNG_IRQn);
+#else
         REG_TRNG_IDR = TRNG_IDR_DATRDY;
+#endif
         due_init_done = 1;
     }
 }
 
-static inline int ascon_trng_generate_word(uint32_t *x)
+static inline int ascon_trng_poll_word(uint32_t *x)
 {
     /* SAM3X8E's TRNG returns a new random word every 84 clock cycles.
      * If the TRNG is not ready after 100 iterations, assume it has failed. */
@@ -55,10 +116,29 @@ static inline int ascon_trng_generate_word(uint32_t *x)
     return 1;
 }
 
+static inline int ascon_trng_generate_word(uint32_t *x)
+{
+#if ASCON_TRNG_DUE_RING_SIZE > 0
+    int ok;
+    if (ascon_trng_ring_take(x))
+        return 1;
+
+    /* The buffer has run dry.  Mask the interrupt while polling so that
+     * the handler does not take the word that we are waiting for. */
+    NVIC_DisableIRQ(TRNG_IRQn);
+    ok = ascon_trng_poll_word(x);
+    NVIC_EnableIRQ(TRNG_IRQn);
+    return ok;
+#else
+    return ascon_trng_poll_word(x);
+#endif
+}
+
 int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
     uint32_t x;
     int ok = 1;
+    ascon_latency_begin();
     ascon_trng_init_internal();
     while (outlen >= sizeof(x)) {
         if (!ascon_trng_generate_word(&x))
@@ -72,6 +152,7 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
             ok = 0;
         memcpy(out, &x, outlen);
     }
+    ascon_latency_end(ASCON_LATENCY_TRNG);
     return ok;
 }
 
@@ -79,6 +160,11 @@ int ascon_trng_init(ascon_trng_state_t *state)
 {
     uint32_t x;
 
+    /* No randomness pool until one is attached */
+    state->pool = 0;
+    state->pool_size = 0;
+    state->pool_count = 0;
+
     /* Make sure that the peripheral is initialized */
     ascon_trng_init_internal();
 
@@ -88,13 +174,13 @@ int ascon_trng_init(ascon_trng_state_t *state)
 
 void ascon_trng_free(ascon_trng_state_t *state)
 {
-    (void)state;
+    ascon_trng_detach_pool(state);
 }
 
 uint32_t ascon_trng_generate_32(ascon_trng_state_t *state)
 {
     uint32_t word;
-    (void)state;
+    ascon_trng_pool_take_32(state, word);
     ascon_trng_generate_word(&word);
     return word;
 }
@@ -102,7 +188,8 @@ uint32_t ascon_trng_generate_32(ascon_trng_state_t *state)
 uint64_t ascon_trng_generate_64(ascon_trng_state_t *state)
 {
     uint32_t low, high;
-    (void)state;
+    uint64_t x;
+    ascon_trng_pool_take_64(state, x);
     ascon_trng_generate_word(&low);
     ascon_trng_generate_word(&high);
     return ((uint64_t)low) | (((uint64_t)high) << 32);
@@ -110,7 +197,10 @@ uint64_t ascon_trng_generate_64(ascon_trng_state_t *state)
 
 int ascon_trng_reseed(ascon_trng_state_t *state)
 {
-    return ascon_trng_init(state);
+    uint32_t x;
+    (void)state;
+    ascon_trng_init_internal();
+    return ascon_trng_generate_word(&x);
 }
 
 #endif /* ASCON_TRNG_DUE */
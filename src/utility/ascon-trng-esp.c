@@ -21,6 +21,7 @@
  */
 
 #include "ascon-trng.h"
+#include "../ascon-latency.h"
 #include <string.h>
 
 #if defined(ASCON_TRNG_ESP)
@@ -37,6 +38,7 @@ extern uint32_t esp_random(void);
 int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
     uint32_t x;
+    ascon_latency_begin();
     while (outlen >= sizeof(x)) {
         x = esp_random();
         memcpy(out, &x, sizeof(x));
@@ -47,31 +49,39 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
         x = esp_random();
         memcpy(out, &x, outlen);
     }
+    ascon_latency_end(ASCON_LATENCY_TRNG);
     return 1; /* Assume that it works */
 }
 //! [snippet_trng_generate]
 
 int ascon_trng_init(ascon_trng_state_t *state)
 {
+    /* No randomness pool until one is attached */
+    state->pool = 0;
+    state->pool_size = 0;
+    state->pool_count = 0;
+
     /* Assume that it works */
     return 1;
 }
 
 void ascon_trng_free(ascon_trng_state_t *state)
 {
-    (void)state;
+    ascon_trng_detach_pool(state);
 }
 
 //! [snippet_trng_generate_32]
 uint32_t ascon_trng_generate_32(ascon_trng_state_t *state)
 {
-    (void)state;
+    uint32_t x;
+    ascon_trng_pool_take_32(state, x);
     return esp_random();
 }
 
 uint64_t ascon_trng_generate_64(ascon_trng_state_t *state)
 {
-    (void)state;
+    uint64_t x;
+    ascon_trng_pool_take_64(state, x);
     return ((uint64_t)esp_random()) | (((uint64_t)esp_random()) << 32);
 }
 //! [snippet_trng_generate_32]
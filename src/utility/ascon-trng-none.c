@@ -21,7 +21,9 @@
  */
 
 #include "ascon-trng.h"
+#include "../ascon-latency.h"
 #include "../ascon-utility.h"
+#include "../ascon-xof.h"
 #include <string.h>
 
 #if defined(ASCON_TRNG_NONE)
@@ -38,6 +40,10 @@
 #if defined(HAVE_SYS_TIME_H)
 #include <sys/time.h>
 #endif
+#if defined(ARDUINO) && defined(__AVR__) && defined(ASCON_SEED_EEPROM_ADDRESS)
+#include <avr/eeprom.h>
+#define ASCON_SEED_EEPROM 1
+#endif
 
 #if !defined(ASCON_TRNG_MIXER)
 #error "Mixer is required if there is no known TRNG on the system"
@@ -79,6 +85,91 @@ int ascon_trng_get_bytes_is_good(void)
     return 0;
 }
 
+int ascon_trng_load_seed(unsigned char *seed, size_t len) __attribute__((weak));
+int ascon_trng_store_seed(const unsigned char *seed, size_t len) __attribute__((weak));
+
+/**
+ * \brief Escape hatch that allows applications to load a seed that was
+ * saved in persistent storage by the previous boot.
+ *
+ * \param seed Buffer to fill with the saved seed.
+ * \param len Number of bytes in the seed, which is ASCON_SYSTEM_SEED_SIZE.
+ *
+ * \return Non-zero if the seed was loaded or zero if there is no saved seed.
+ *
+ * On AVR-based Arduino boards, defining ASCON_SEED_EEPROM_ADDRESS to an
+ * EEPROM offset will load the seed from that location by default.
+ */
+int ascon_trng_load_seed(unsigned char *seed, size_t len)
+{
+#if defined(ASCON_SEED_EEPROM)
+    eeprom_read_block(seed, (const void *)(ASCON_SEED_EEPROM_ADDRESS), len);
+    return 1;
+#else
+    (void)seed;
+    (void)len;
+    return 0;
+#endif
+}
+
+/**
+ * \brief Escape hatch that allows applications to save a seed to
+ * persistent storage for use by the next boot.
+ *
+ * \param seed Points to the seed to be saved.
+ * \param len Number of bytes in the seed, which is ASCON_SYSTEM_SEED_SIZE.
+ *
+ * \return Non-zero if the seed was saved or zero if there is nowhere to
+ * save the seed.
+ *
+ * On AVR-based Arduino boards, defining ASCON_SEED_EEPROM_ADDRESS to an
+ * EEPROM offset will save the seed to that location by default.
+ */
+int ascon_trng_store_seed(const unsigned char *seed, size_t len)
+{
+#if defined(ASCON_SEED_EEPROM)
+    eeprom_update_block(seed, (void *)(ASCON_SEED_EEPROM_ADDRESS), len);
+    return 1;
+#else
+    (void)seed;
+    (void)len;
+    return 0;
+#endif
+}
+
+/**
+ * \brief Loads the seed that was saved by the previous boot and ratchets
+ * the saved seed forward.
+ *
+ * \param seed Returns the seed to mix into the global PRNG.
+ *
+ * \return Non-zero if a saved seed was loaded.
+ *
+ * The saved seed is passed through ASCON-XOF to produce both the seed
+ * for this boot and the replacement seed that is written back to storage
+ * straight away.  If the device resets before ascon_random_save_seed()
+ * is called, the next boot will not see the same seed again.  Recovering
+ * the stored seed does not reveal the seeds that were used previously.
+ */
+static int ascon_trng_load_saved_seed
+    (unsigned char seed[ASCON_SYSTEM_SEED_SIZE])
+{
+    static unsigned char const label[] = "ascon-saved-seed";
+    unsigned char next[ASCON_SYSTEM_SEED_SIZE];
+    ascon_xof_state_t xof;
+    if (!ascon_trng_load_seed(seed, ASCON_SYSTEM_SEED_SIZE))
+        return 0;
+    ascon_xof_init(&xof);
+    ascon_xof_absorb(&xof, label, sizeof(label) - 1);
+    ascon_xof_absorb(&xof, seed, ASCON_SYSTEM_SEED_SIZE);
+    ascon_xof_squeeze(&xof, seed, ASCON_SYSTEM_SEED_SIZE);
+    ascon_xof_squeeze(&xof, next, sizeof(next));
+    ascon_xof_free(&xof);
+    ascon_trng_store_seed(next, sizeof(next));
+    ascon_clean(next, sizeof(next));
+    return 1;
+}
+
 /*
  * Global PRNG that collects what little entropy we can get from timers.
  *
@@ -180,10 +271,16 @@ static int ascon_trng_global_init(unsigned char seed[ASCON_SYSTEM_SEED_SIZE])
 {
     int ok = 0;
 
-    /* Acquire access to the global PRNG object */
+    /* Acquire access to the global PRNG object.  On first use, fold
+     * in the seed that was saved by the previous boot if there is one. */
     if (!global_prng_initialized) {
+        int have_saved = ascon_trng_load_saved_seed(seed);
         global_prng_initialized = 1;
         ascon_init(&global_prng);
+        if (have_saved) {
+            ascon_add_bytes(&global_prng, seed, 8, ASCON_SYSTEM_SEED_SIZE);
+            ascon_permute6(&global_prng);
+        }
     } else {
         ascon_acquire(&global_prng);
     }
@@ -203,14 +300,17 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
     unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
     int ok;
+    ascon_latency_begin();
 
     /* If the application has declared ascon_trng_get_bytes() to be good,
      * then use it directly rather than run a global PRNG.  We fall through
      * if ascon_trng_get_bytes() subsequently fails anyway. */
     if (ascon_trng_get_bytes_is_good()) {
         ok = ascon_trng_get_bytes(out, outlen);
-        if (ok)
+        if (ok) {
+            ascon_latency_end(ASCON_LATENCY_TRNG);
             return 1;
+        }
     }
 
     /* Re-seed and squeeze some data out of the global PRNG */
@@ -222,6 +322,28 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
     ascon_permute6(&global_prng);
     ascon_release(&global_prng);
     ascon_clean(seed, sizeof(seed));
+    ascon_latency_end(ASCON_LATENCY_TRNG);
+    return ok;
+}
+
+int ascon_trng_save_seed(void)
+{
+    unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
+    int ok;
+
+    /* Re-seed the global PRNG and squeeze out the seed to be saved */
+    ascon_trng_global_init(seed);
+    ascon_trng_squeeze(&global_prng, seed, sizeof(seed));
+
+    /* Re-key the global PRNG so that the saved seed cannot be used
+     * to recover any of the output that follows */
+    ascon_overwrite_with_zeroes(&global_prng, 0, 8);
+    ascon_permute6(&global_prng);
+    ascon_release(&global_prng);
+
+    /* Save the seed for the next boot */
+    ok = ascon_trng_store_seed(seed, sizeof(seed));
+    ascon_clean(seed, sizeof(seed));
     return ok;
 }
 
@@ -254,11 +376,15 @@ int ascon_trng_init(ascon_trng_state_t *state)
     ascon_release(&(state->prng));
     ascon_clean(seed, sizeof(seed));
     state->posn = 0;
+    state->pool = 0;
+    state->pool_size = 0;
+    state->pool_count = 0;
     return ok;
 }
 
 void ascon_trng_free(ascon_trng_state_t *state)
 {
+    ascon_trng_detach_pool(state);
     ascon_acquire(&(state->prng));
     ascon_free(&(state->prng));
 }
@@ -266,9 +392,10 @@ void ascon_trng_free(ascon_trng_state_t *state)
 uint32_t ascon_trng_generate_32(ascon_trng_state_t *state)
 {
     uint32_t x;
+    ascon_trng_pool_take_32(state, x);
     ascon_acquire(&(state->prng));
     if ((state->posn + sizeof(uint32_t)) > ASCON_TRNG_MIXER_RATE) {
-        ascon_permute6(&(state->prng));
+        ascon_permute(&(state->prng), ASCON_TRNG_MIXER_FIRST_ROUND);
         state->posn = 0;
     }
 #if defined(ASCON_BACKEND_SLICED32) || defined(ASCON_BACKEND_SLICED64) || \
@@ -288,10 +415,11 @@ uint32_t ascon_trng_generate_32(ascon_trng_state_t *state)
 uint64_t ascon_trng_generate_64(ascon_trng_state_t *state)
 {
     uint64_t x;
+    ascon_trng_pool_take_64(state, x);
     ascon_acquire(&(state->prng));
     if ((state->posn + sizeof(uint64_t)) > ASCON_TRNG_MIXER_RATE ||
             (state->posn % 8U) != 0) {
-        ascon_permute6(&(state->prng));
+        ascon_permute(&(state->prng), ASCON_TRNG_MIXER_FIRST_ROUND);
         state->posn = 0;
     }
 #if defined(ASCON_BACKEND_SLICED32) || defined(ASCON_BACKEND_SLICED64) || \
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ascon-trng.h"
+#include "../ascon-utility.h"
+
+/* The randomness pool is common to all random number sources */
+
+void ascon_trng_attach_pool
+    (ascon_trng_state_t *state, uint32_t *pool, unsigned size)
+{
+    state->pool = pool;
+    state->pool_size = size;
+    state->pool_count = 0;
+}
+
+void ascon_trng_refill_pool(ascon_trng_state_t *state)
+{
+    uint32_t *pool = state->pool;
+    unsigned count = state->pool_count;
+    unsigned size = state->pool_size;
+    uint64_t x;
+
+    /* Hide the pool while we refill it so that the generate functions
+     * draw directly from the random number source */
+    state->pool_count = 0;
+
+    /* Generate 64 bits at a time so that PRNG-based sources can squeeze
+     * a whole rate block out of the PRNG for each call */
+    while ((count + 2) <= size) {
+        x = ascon_trng_generate_64(state);
+        pool[count] = (uint32_t)x;
+        pool[count + 1] = (uint32_t)(x >> 32);
+        count += 2;
+    }
+    if (count < size)
+        pool[count++] = ascon_trng_generate_32(state);
+    state->pool_count = count;
+}
+
+void ascon_trng_detach_pool(ascon_trng_state_t *state)
+{
+    if (state->pool) {
+        ascon_clean(state->pool, state->pool_size * sizeof(uint32_t));
+        state->pool = 0;
+        state->pool_size = 0;
+        state->pool_count = 0;
+    }
+}
@@ -57,6 +57,40 @@ extern "C" {
  */
 #define ASCON_SYSTEM_SEED_SIZE 32
 
+#if defined(ASCON_TRNG_MIXER)
+
+/**
+ * \def ASCON_TRNG_MIXER_RATE
+ * \brief Number of bytes of masking material to squeeze out of the local
+ * PRNG state between permutations.
+ *
+ * The local PRNG in ascon_trng_state_t only generates masking material.
+ * Seeding, reseeding, and whitening of the system source go through the
+ * global PRNG as before.  By default the local PRNG has the same shape
+ * as the ASCON-128a duplex, with a 16 byte rate and 8-round permutations.
+ * That is a third fewer rounds per byte of masking material than an
+ * 8 byte rate with 6-round permutations.  The rate may be overridden at
+ * compile time with 8, 16, or 24.
+ */
+#if !defined(ASCON_TRNG_MIXER_RATE)
+#define ASCON_TRNG_MIXER_RATE 16U
+#endif
+
+/**
+ * \def ASCON_TRNG_MIXER_FIRST_ROUND
+ * \brief First round of the permutation that is used to generate
+ * masking material from the local PRNG, between 0 and 11.
+ */
+#if !defined(ASCON_TRNG_MIXER_FIRST_ROUND)
+#define ASCON_TRNG_MIXER_FIRST_ROUND 4
+#endif
+
+#if (ASCON_TRNG_MIXER_RATE % 8) != 0 || ASCON_TRNG_MIXER_RATE > 24
+#error "ASCON_TRNG_MIXER_RATE must be 8, 16, or 24"
+#endif
+
+#endif /* ASCON_TRNG_MIXER */
+
 /**
  * \brief State of the random number source.
  */
@@ -69,11 +103,18 @@ typedef struct
     /** PRNG state for whitening poor random number sources.  Also used on
      *  systems without a fast "get random word" operation for masking. */
     ascon_state_t prng;
-
-    /** Rate of squeezing data out of the PRNG state */
-    #define ASCON_TRNG_MIXER_RATE 8U
 #endif
 
+    /** Optional pool of prefilled random words to use for masking
+     *  before falling back to the random number source, or NULL */
+    uint32_t *pool;
+
+    /** Total number of words in the pool */
+    unsigned pool_size;
+
+    /** Number of words in the pool that have not been used yet */
+    unsigned pool_count;
+
 } ascon_trng_state_t;
 
 /**
@@ -145,6 +186,103 @@ uint64_t ascon_trng_generate_64(ascon_trng_state_t *state);
  */
 int ascon_trng_reseed(ascon_trng_state_t *state);
 
+/**
+ * \brief Saves a seed to persistent storage for use by the next boot.
+ *
+ * \return Non-zero if the seed was saved, or zero if there is no
+ * persistent storage for the seed.
+ *
+ * This is only implemented when there is no system TRNG,
+ * i.e. when ASCON_TRNG_NONE is defined.
+ */
+int ascon_trng_save_seed(void);
+
+/**
+ * \brief Attaches a randomness pool to a random number source.
+ *
+ * \param state State information for the source.
+ * \param pool Points to the pool of words, which must remain valid for
+ * as long as it is attached to \a state.
+ * \param size Number of 32-bit words in the pool.
+ *
+ * The pool starts off empty.  Call ascon_trng_refill_pool() to fill it
+ * in bulk when the application is not on a time-critical path; e.g.
+ * between packets.  While there are words in the pool,
+ * ascon_trng_generate_32() and ascon_trng_generate_64() will use them
+ * rather than the random number source which makes the latency of
+ * masking operations lower and more predictable.  When the pool runs
+ * dry, those functions fall back to the random number source.
+ *
+ * Each word is cleared from the pool after it has been used.
+ *
+ * \sa ascon_trng_refill_pool(), ascon_trng_detach_pool()
+ */
+void ascon_trng_attach_pool
+    (ascon_trng_state_t *state, uint32_t *pool, unsigned size);
+
+/**
+ * \brief Refills the used words in the randomness pool from the
+ * random number source.
+ *
+ * \param state State information for the source.
+ *
+ * This function does nothing if no pool is attached to \a state.
+ *
+ * \sa ascon_trng_attach_pool()
+ */
+void ascon_trng_refill_pool(ascon_trng_state_t *state);
+
+/**
+ * \brief Detaches the randomness pool from a random number source
+ * and destroys any unused words that remain in the pool.
+ *
+ * \param state State information for the source.
+ *
+ * \sa ascon_trng_attach_pool()
+ */
+void ascon_trng_detach_pool(ascon_trng_state_t *state);
+
+/**
+ * \brief Takes a 32-bit word from the randomness pool if there is one.
+ *
+ * \param state State information for the source.
+ * \param x Variable to set to the next word from the pool.
+ *
+ * This is intended for use by the implementations of
+ * ascon_trng_generate_32() in the random number source back ends.
+ */
+#define ascon_trng_pool_take_32(state, x) \
+    do { \
+        if ((state)->pool_count > 0) { \
+            unsigned _index = --((state)->pool_count); \
+            (x) = (state)->pool[_index]; \
+            (state)->pool[_index] = 0; \
+            return (x); \
+        } \
+    } while (0)
+
+/**
+ * \brief Takes a 64-bit word from the randomness pool if there are at
+ * least two 32-bit words left in the pool.
+ *
+ * \param state State information for the source.
+ * \param x Variable to set to the next word from the pool.
+ *
+ * This is intended for use by the implementations of
+ * ascon_trng_generate_64() in the random number source back ends.
+ */
+#define ascon_trng_pool_take_64(state, x) \
+    do { \
+        if ((state)->pool_count >= 2) { \
+            unsigned _index = ((state)->pool_count -= 2); \
+            (x) = ((uint64_t)((state)->pool[_index])) | \
+                 (((uint64_t)((state)->pool[_index + 1])) << 32); \
+            (state)->pool[_index] = 0; \
+            (state)->pool[_index + 1] = 0; \
+            return (x); \
+        } \
+    } while (0)
+
 #ifdef __cplusplus
 }
 #endif
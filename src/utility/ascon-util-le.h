@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#ifndef ASCON_UTIL_LE_H
+#define ASCON_UTIL_LE_H
+
+/*
+ * Utilities for absorbing and squeezing data in the little-endian byte
+ * order of the NIST SP 800-232 modes.
+ *
+ * The rest of the library uses the big-endian byte order of the original
+ * ASCON submission.  The 64-bit words of the state are the same in both,
+ * so the little-endian forms reverse the bytes in each word before
+ * handing them to the macros in "ascon-util-snp.h".  The SLICED64
+ * back end loads and stores the words directly instead.
+ *
+ * Partial operations must not cross a word boundary.  As for the
+ * big-endian versions, these utilities are not suitable for the
+ * public-facing API.
+ */
+
+#include "ascon-util-snp.h"
+
+/* Reverses the bytes of a 64-bit word between the two byte orders */
+#define ascon_le_reverse_8(dest, src) \
+    be_store_word64((dest), le_load_word64((src)))
+
+#if defined(ASCON_BACKEND_SLICED64)
+
+#define ascon_le_absorb_8(state, data, offset) \
+    ((state)->S[(offset) / 8] ^= le_load_word64((data)))
+#define ascon_le_squeeze_8(state, data, offset) \
+    le_store_word64((data), (state)->S[(offset) / 8])
+#define ascon_le_encrypt_8(state, dest, src, offset) \
+    do { \
+        (state)->S[(offset) / 8] ^= le_load_word64((src)); \
+        le_store_word64((dest), (state)->S[(offset) / 8]); \
+    } while (0)
+#define ascon_le_decrypt_8(state, dest, src, offset) \
+    do { \
+        uint64_t word = le_load_word64((src)); \
+        le_store_word64((dest), word ^ (state)->S[(offset) / 8]); \
+        (state)->S[(offset) / 8] = word; \
+    } while (0)
+#define ascon_le_pad(state, offset) \
+    ((state)->S[(offset) / 8] ^= (0x01ULL << (((offset) & 7) * 8)))
+
+#else /* !ASCON_BACKEND_SLICED64 */
+
+#define ascon_le_absorb_8(state, data, offset) \
+    do { \
+        uint8_t le_temp[8]; \
+        ascon_le_reverse_8(le_temp, (data)); \
+        ascon_absorb_8((state), le_temp, (offset)); \
+    } while (0)
+#define ascon_le_squeeze_8(state, data, offset) \
+    do { \
+        uint8_t le_temp[8]; \
+        ascon_squeeze_8((state), le_temp, (offset)); \
+        ascon_le_reverse_8((data), le_temp); \
+    } while (0)
+#define ascon_le_encrypt_8(state, dest, src, offset) \
+    do { \
+        ascon_le_absorb_8((state), (src), (offset)); \
+        ascon_le_squeeze_8((state), (dest), (offset)); \
+    } while (0)
+#define ascon_le_decrypt_8(state, dest, src, offset) \
+    do { \
+        uint8_t le_block[8]; \
+        ascon_le_squeeze_8((state), le_block, (offset)); \
+        lw_xor_block_2_src(le_block, le_block, (src), 8); \
+        memcpy((dest), le_block, 8); \
+        ascon_le_absorb_8((state), le_block, (offset)); \
+    } while (0)
+#define ascon_le_pad(state, offset) \
+    do { \
+        uint8_t le_padding = 0x01; \
+        ascon_add_bytes \
+            ((state), &le_padding, ((offset) & ~7U) + 7 - ((offset) & 7), 1); \
+    } while (0)
+
+#endif /* !ASCON_BACKEND_SLICED64 */
+
+/* The domain separator is the top bit of the last word, which is the
+ * same bit as big-endian padding at offset 32 */
+#define ascon_le_separator(state) ascon_pad((state), 32)
+
+#define ascon_le_absorb_16(state, data, offset) \
+    do { \
+        ascon_le_absorb_8((state), (data), (offset)); \
+        ascon_le_absorb_8((state), (data) + 8, (offset) + 8); \
+    } while (0)
+#define ascon_le_squeeze_16(state, data, offset) \
+    do { \
+        ascon_le_squeeze_8((state), (data), (offset)); \
+        ascon_le_squeeze_8((state), (data) + 8, (offset) + 8); \
+    } while (0)
+#define ascon_le_encrypt_16(state, dest, src, offset) \
+    do { \
+        ascon_le_encrypt_8((state), (dest), (src), (offset)); \
+        ascon_le_encrypt_8((state), (dest) + 8, (src) + 8, (offset) + 8); \
+    } while (0)
+#define ascon_le_decrypt_16(state, dest, src, offset) \
+    do { \
+        ascon_le_decrypt_8((state), (dest), (src), (offset)); \
+        ascon_le_decrypt_8((state), (dest) + 8, (src) + 8, (offset) + 8); \
+    } while (0)
+
+/* Partial operations go through a zero-padded copy of the word so that
+ * the bytes outside the range are not modified */
+#define ascon_le_absorb_partial(state, data, offset, count) \
+    do { \
+        uint8_t le_part[8] = {0, 0, 0, 0, 0, 0, 0, 0}; \
+        memcpy(le_part + ((offset) & 7), (data), (count)); \
+        ascon_le_absorb_8((state), le_part, (offset) & ~7U); \
+    } while (0)
+#define ascon_le_squeeze_partial(state, data, offset, count) \
+    do { \
+        uint8_t le_part[8]; \
+        ascon_le_squeeze_8((state), le_part, (offset) & ~7U); \
+        memcpy((data), le_part + ((offset) & 7), (count)); \
+    } while (0)
+#define ascon_le_encrypt_partial(state, dest, src, offset, count) \
+    do { \
+        uint8_t le_part[8] = {0, 0, 0, 0, 0, 0, 0, 0}; \
+        memcpy(le_part + ((offset) & 7), (src), (count)); \
+        ascon_le_absorb_8((state), le_part, (offset) & ~7U); \
+        ascon_le_squeeze_8((state), le_part, (offset) & ~7U); \
+        memcpy((dest), le_part + ((offset) & 7), (count)); \
+    } while (0)
+#define ascon_le_decrypt_partial(state, dest, src, offset, count) \
+    do { \
+        uint8_t le_part[8]; \
+        uint8_t le_plain[8] = {0, 0, 0, 0, 0, 0, 0, 0}; \
+        ascon_le_squeeze_8((state), le_part, (offset) & ~7U); \
+        lw_xor_block_2_src \
+            (le_plain + ((offset) & 7), le_part + ((offset) & 7), \
+             (src), (count)); \
+        memcpy((dest), le_plain + ((offset) & 7), (count)); \
+        ascon_le_absorb_8((state), le_plain, (offset) & ~7U); \
+    } while (0)
+
+#endif
@@ -45,33 +45,41 @@
     ((state)->W[((offset) / 8) * 2 + 1] ^= \
             (0x80000000U >> (((offset) & 7) * 4)))
 
+/* ascon_absorb_bit() XOR's bit "bit" of "value", counting down from the
+ * most significant bit, into the first bit of the state */
+#define ascon_absorb_bit(state, value, bit) \
+    ((state)->W[1] ^= (((uint32_t)(value)) << (24 + (bit))) & 0x80000000U)
+
 #define ascon_absorb_8(state, data, offset) \
     ascon_absorb_sliced((state), (data), (offset) / 8)
 #define ascon_absorb_16(state, data, offset) \
-    do { \
-        ascon_absorb_sliced((state), (data), (offset) / 8); \
-        ascon_absorb_sliced((state), (data) + 8, (offset) / 8 + 1); \
-    } while (0)
+    ascon_absorb16_sliced((state), (data), (offset) / 8)
 #define ascon_absorb_partial(state, data, offset, count) \
     ascon_add_bytes((state), (data), (offset), (count))
+#define ascon_absorb_state_8(state, src, offset, src_offset) \
+    do { \
+        (state)->W[(offset) / 4] ^= (src)->W[(src_offset) / 4]; \
+        (state)->W[(offset) / 4 + 1] ^= (src)->W[(src_offset) / 4 + 1]; \
+    } while (0)
+#define ascon_absorb_state_16(state, src, offset, src_offset) \
+    do { \
+        (state)->W[(offset) / 4] ^= (src)->W[(src_offset) / 4]; \
+        (state)->W[(offset) / 4 + 1] ^= (src)->W[(src_offset) / 4 + 1]; \
+        (state)->W[(offset) / 4 + 2] ^= (src)->W[(src_offset) / 4 + 2]; \
+        (state)->W[(offset) / 4 + 3] ^= (src)->W[(src_offset) / 4 + 3]; \
+    } while (0)
 
 #define ascon_squeeze_8(state, data, offset) \
     ascon_squeeze_sliced((state), (data), (offset) / 8)
 #define ascon_squeeze_16(state, data, offset) \
-    do { \
-        ascon_squeeze_sliced((state), (data), (offset) / 8); \
-        ascon_squeeze_sliced((state), (data) + 8, (offset) / 8 + 1); \
-    } while (0)
+    ascon_squeeze16_sliced((state), (data), (offset) / 8)
 #define ascon_squeeze_partial(state, data, offset, count) \
     ascon_extract_bytes((state), (data), (offset), (count))
 
 #define ascon_encrypt_8(state, dest, src, offset) \
     ascon_encrypt_sliced((state), (dest), (src), (offset) / 8)
 #define ascon_encrypt_16(state, dest, src, offset) \
-    do { \
-        ascon_encrypt_sliced((state), (dest), (src), (offset) / 8); \
-        ascon_encrypt_sliced((state), (dest) + 8, (src) + 8, (offset) / 8 + 1); \
-    } while (0)
+    ascon_encrypt16_sliced((state), (dest), (src), (offset) / 8)
 #define ascon_encrypt_partial(state, dest, src, offset, count) \
     do { \
         ascon_add_bytes((state), (src), (offset), (count)); \
@@ -81,10 +89,7 @@
 #define ascon_decrypt_8(state, dest, src, offset) \
     ascon_decrypt_sliced((state), (dest), (src), (offset) / 8)
 #define ascon_decrypt_16(state, dest, src, offset) \
-    do { \
-        ascon_decrypt_sliced((state), (dest), (src), (offset) / 8); \
-        ascon_decrypt_sliced((state), (dest) + 8, (src) + 8, (offset) / 8 + 1); \
-    } while (0)
+    ascon_decrypt16_sliced((state), (dest), (src), (offset) / 8)
 #define ascon_decrypt_partial(state, dest, src, offset, count) \
     ascon_extract_and_overwrite_bytes((state), (src), (dest), (offset), (count))
 
@@ -94,6 +99,9 @@
 #define ascon_pad(state, offset) \
     ((state)->S[(offset) / 8] ^= \
             (0x8000000000000000ULL >> (((offset) & 7) * 8)))
+#define ascon_absorb_bit(state, value, bit) \
+    ((state)->S[0] ^= (((uint64_t)(value)) << (56 + (bit))) & \
+            0x8000000000000000ULL)
 
 #define ascon_absorb_8(state, data, offset) \
     ((state)->S[(offset) / 8] ^= be_load_word64((data)))
@@ -104,6 +112,13 @@
     } while (0)
 #define ascon_absorb_partial(state, data, offset, count) \
     ascon_add_bytes((state), (data), (offset), (count))
+#define ascon_absorb_state_8(state, src, offset, src_offset) \
+    ((state)->S[(offset) / 8] ^= (src)->S[(src_offset) / 8])
+#define ascon_absorb_state_16(state, src, offset, src_offset) \
+    do { \
+        (state)->S[(offset) / 8] ^= (src)->S[(src_offset) / 8]; \
+        (state)->S[(offset) / 8 + 1] ^= (src)->S[(src_offset) / 8 + 1]; \
+    } while (0)
 
 #define ascon_squeeze_8(state, data, offset) \
     be_store_word64((data), (state)->S[(offset) / 8])
@@ -155,6 +170,8 @@
 
 #define ascon_separator(state) ((state)->B[39] ^= 0x01)
 #define ascon_pad(state, offset) ((state)->B[(offset)] ^= 0x80)
+#define ascon_absorb_bit(state, value, bit) \
+    ((state)->B[0] ^= ((value) << (bit)) & 0x80)
 
 #define ascon_absorb_8(state, data, offset) \
     lw_xor_block((state)->B + (offset), (data), 8)
@@ -162,6 +179,10 @@
     lw_xor_block((state)->B + (offset), (data), 16)
 #define ascon_absorb_partial(state, data, offset, count) \
     lw_xor_block((state)->B + (offset), (data), (count))
+#define ascon_absorb_state_8(state, src, offset, src_offset) \
+    lw_xor_block((state)->B + (offset), (src)->B + (src_offset), 8)
+#define ascon_absorb_state_16(state, src, offset, src_offset) \
+    lw_xor_block((state)->B + (offset), (src)->B + (src_offset), 16)
 
 #define ascon_squeeze_8(state, data, offset) \
     memcpy((data), (state)->B + (offset), 8)
@@ -196,6 +217,11 @@
         uint8_t padding = 0x80; \
         ascon_add_bytes((state), &padding, (offset), 1); \
     } while (0)
+#define ascon_absorb_bit(state, value, bit) \
+    do { \
+        uint8_t absorb = (uint8_t)(((value) << (bit)) & 0x80); \
+        ascon_add_bytes((state), &absorb, 0, 1); \
+    } while (0)
 
 #define ascon_absorb_8(state, data, offset) \
     ascon_add_bytes((state), (data), (offset), 8)
@@ -203,6 +229,20 @@
     ascon_add_bytes((state), (data), (offset), 16)
 #define ascon_absorb_partial(state, data, offset, count) \
     ascon_add_bytes((state), (data), (offset), (count))
+#define ascon_absorb_state_8(state, src, offset, src_offset) \
+    do { \
+        uint8_t temp[8]; \
+        ascon_extract_bytes((src), temp, (src_offset), 8); \
+        ascon_add_bytes((state), temp, (offset), 8); \
+        ascon_clean(temp, sizeof(temp)); \
+    } while (0)
+#define ascon_absorb_state_16(state, src, offset, src_offset) \
+    do { \
+        uint8_t temp[16]; \
+        ascon_extract_bytes((src), temp, (src_offset), 16); \
+        ascon_add_bytes((state), temp, (offset), 16); \
+        ascon_clean(temp, sizeof(temp)); \
+    } while (0)
 
 #define ascon_squeeze_8(state, data, offset) \
     ascon_extract_bytes((state), (data), (offset), 8)
@@ -260,4 +300,43 @@ void ascon_backend_free(ascon_state_t *state);
 #define ascon_backend_free(state) do { ; } while (0)
 #endif
 
+/* Acquire/release scopes are tracked if the back end binds shared hardware
+ * in ascon_acquire() and ascon_release(), or if we are checking that
+ * acquire and release operations are balanced. */
+#if defined(ASCON_BACKEND_SHARED) || defined(ASCON_CHECK_ACQUIRE_RELEASE)
+#define ASCON_SCOPE_TRACKING 1
+
+/**
+ * \brief Points to the state that is currently acquired by
+ * ascon_acquire_scope(), or NULL if there is no active scope.
+ */
+extern ascon_state_t *ascon_scope_state;
+
+/**
+ * \brief Returns early from ascon_acquire() or ascon_release() if the
+ * state is held by an acquire/release scope.
+ *
+ * \param state The ASCON permutation state.
+ */
+#define ascon_scope_elide(state) \
+    do { \
+        if ((state) == ascon_scope_state) \
+            return; \
+    } while (0)
+
+/**
+ * \brief Ends the acquire/release scope for a state that is being freed.
+ *
+ * \param state The ASCON permutation state.
+ */
+#define ascon_scope_end(state) \
+    do { \
+        if ((state) == ascon_scope_state) \
+            ascon_scope_state = 0; \
+    } while (0)
+#else
+#define ascon_scope_elide(state) do { ; } while (0)
+#define ascon_scope_end(state) do { ; } while (0)
+#endif
+
 #endif
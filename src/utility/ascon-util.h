@@ -64,6 +64,88 @@
 
 /* Helper macros to load and store values while converting endian-ness */
 
+/* Determine if the CPU can access 32-bit and 64-bit words at any alignment
+ * and the compiler has byte-swap intrinsics.  If so, the endian conversion
+ * macros below use a single native load or store plus a byte swap instead
+ * of assembling the word one byte at a time.  Define LW_UTIL_NO_UNALIGNED
+ * in your compiler flags to force the byte-at-a-time versions. */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(LW_UTIL_NO_UNALIGNED) && \
+    (defined(__x86_64) || defined(__x86_64__) || \
+     defined(__i386) || defined(__i386__) || \
+     defined(__aarch64__) || defined(__ARM_FEATURE_UNALIGNED) || \
+     defined(__powerpc64__))
+#define LW_UTIL_UNALIGNED_OK 1
+#endif
+
+#if LW_UTIL_UNALIGNED_OK
+
+/* Load and store native words.  The memcpy() calls compile down to single
+ * load or store instructions because unaligned access is allowed */
+STATIC_INLINE uint32_t lw_load_native32(const void *ptr)
+{
+    uint32_t x;
+    __builtin_memcpy(&x, ptr, sizeof(x));
+    return x;
+}
+STATIC_INLINE void lw_store_native32(void *ptr, uint32_t x)
+{
+    __builtin_memcpy(ptr, &x, sizeof(x));
+}
+STATIC_INLINE uint64_t lw_load_native64(const void *ptr)
+{
+    uint64_t x;
+    __builtin_memcpy(&x, ptr, sizeof(x));
+    return x;
+}
+STATIC_INLINE void lw_store_native64(void *ptr, uint64_t x)
+{
+    __builtin_memcpy(ptr, &x, sizeof(x));
+}
+
+#if defined(LW_UTIL_LITTLE_ENDIAN)
+#define lw_to_be32(x) (__builtin_bswap32((x)))
+#define lw_to_le32(x) (x)
+#define lw_to_be64(x) (__builtin_bswap64((x)))
+#define lw_to_le64(x) (x)
+#else
+#define lw_to_be32(x) (x)
+#define lw_to_le32(x) (__builtin_bswap32((x)))
+#define lw_to_be64(x) (x)
+#define lw_to_le64(x) (__builtin_bswap64((x)))
+#endif
+
+/* Load a big-endian 32-bit word from a byte buffer */
+#define be_load_word32(ptr) (lw_to_be32(lw_load_native32((ptr))))
+
+/* Store a big-endian 32-bit word into a byte buffer */
+#define be_store_word32(ptr, x) \
+    (lw_store_native32((ptr), lw_to_be32((uint32_t)(x))))
+
+/* Load a little-endian 32-bit word from a byte buffer */
+#define le_load_word32(ptr) (lw_to_le32(lw_load_native32((ptr))))
+
+/* Store a little-endian 32-bit word into a byte buffer */
+#define le_store_word32(ptr, x) \
+    (lw_store_native32((ptr), lw_to_le32((uint32_t)(x))))
+
+/* Load a big-endian 64-bit word from a byte buffer */
+#define be_load_word64(ptr) (lw_to_be64(lw_load_native64((ptr))))
+
+/* Store a big-endian 64-bit word into a byte buffer */
+#define be_store_word64(ptr, x) \
+    (lw_store_native64((ptr), lw_to_be64((uint64_t)(x))))
+
+/* Load a little-endian 64-bit word from a byte buffer */
+#define le_load_word64(ptr) (lw_to_le64(lw_load_native64((ptr))))
+
+/* Store a little-endian 64-bit word into a byte buffer */
+#define le_store_word64(ptr, x) \
+    (lw_store_native64((ptr), lw_to_le64((uint64_t)(x))))
+
+#else /* !LW_UTIL_UNALIGNED_OK */
+
+
 /* Load a big-endian 32-bit word from a byte buffer */
 #define be_load_word32(ptr) \
     ((((uint32_t)((ptr)[0])) << 24) | \
@@ -98,11 +180,6 @@
         (ptr)[3] = (uint8_t)(_x >> 24); \
     } while (0)
 
-/* Reverses the bytes in a 32-bit word */
-#define reverse_word32(x) \
-    (((x) >> 24) | (((x) >> 8) & 0x0000FF00U) | \
-     (((x) << 8) & 0x00FF0000U) | ((x) << 24))
-
 /* Load a big-endian 64-bit word from a byte buffer */
 #define be_load_word64(ptr) \
     ((((uint64_t)((ptr)[0])) << 56) | \
@@ -153,6 +230,13 @@
         (ptr)[7] = (uint8_t)(_x >> 56); \
     } while (0)
 
+#endif /* !LW_UTIL_UNALIGNED_OK */
+
+/* Reverses the bytes in a 32-bit word */
+#define reverse_word32(x) \
+    (((x) >> 24) | (((x) >> 8) & 0x0000FF00U) | \
+     (((x) << 8) & 0x00FF0000U) | ((x) << 24))
+
 /* Load a big-endian 16-bit word from a byte buffer */
 #define be_load_word16(ptr) \
     ((((uint16_t)((ptr)[0])) << 8) | \
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_VEC_H
+#define ASCON_VEC_H
+
+/* Common definitions for the back ends that permute several states in
+ * parallel with vector instructions.  Each 64-bit lane of a vector holds
+ * the corresponding word from a different state, so the round function
+ * is a direct translation of the one in "ascon-c64.c". */
+
+#if defined(__OPENCL_VERSION__)
+/* OpenCL C has no <stdint.h>, but ulong is always 64 bits in size.
+ * This allows the GPU kernel in "gpu/ascon-opencl.cl" to share the
+ * round constants and the round function with the CPU back ends. */
+typedef ulong uint64_t;
+#define ASCON_VEC_CONST __constant
+#else
+#include <stdint.h>
+#define ASCON_VEC_CONST static const
+#endif
+
+#define ROUND_CONSTANT(round)   \
+        (~(uint64_t)(((0x0F - (round)) << 4) | (round)))
+
+ASCON_VEC_CONST uint64_t ascon_vec_rc[12] = {
+    ROUND_CONSTANT(0),
+    ROUND_CONSTANT(1),
+    ROUND_CONSTANT(2),
+    ROUND_CONSTANT(3),
+    ROUND_CONSTANT(4),
+    ROUND_CONSTANT(5),
+    ROUND_CONSTANT(6),
+    ROUND_CONSTANT(7),
+    ROUND_CONSTANT(8),
+    ROUND_CONSTANT(9),
+    ROUND_CONSTANT(10),
+    ROUND_CONSTANT(11)
+};
+
+/* Performs a single round of the permutation on the vectors x0, ..., x4.
+ * As in "ascon-c64.c", x2 is kept inverted between rounds and the
+ * inversion is folded into the round constant. */
+#define ascon_vec_round(type, xor, andnot, ror, x0, x1, x2, x3, x4, rc) \
+    do { \
+        type t0, t1, t2, t3, t4; \
+        \
+        /* Add the round constant to the state */ \
+        x2 = xor(x2, (rc)); \
+        \
+        /* Substitution layer */ \
+        x0 = xor(x0, x4);   x4 = xor(x4, x3);   x2 = xor(x2, x1); \
+        t0 = andnot(x0, x1);    t1 = andnot(x1, x2); \
+        t2 = andnot(x2, x3);    t3 = andnot(x3, x4); \
+        t4 = andnot(x4, x0); \
+        x0 = xor(x0, t1);   x1 = xor(x1, t2);   x2 = xor(x2, t3); \
+        x3 = xor(x3, t4);   x4 = xor(x4, t0); \
+        x1 = xor(x1, x0);   x0 = xor(x0, x4);   x3 = xor(x3, x2); \
+        \
+        /* Linear diffusion layer */ \
+        x0 = xor(x0, xor(ror(x0, 19), ror(x0, 28))); \
+        x1 = xor(x1, xor(ror(x1, 61), ror(x1, 39))); \
+        x2 = xor(x2, xor(ror(x2, 1),  ror(x2, 6))); \
+        x3 = xor(x3, xor(ror(x3, 10), ror(x3, 17))); \
+        x4 = xor(x4, xor(ror(x4, 7),  ror(x4, 41))); \
+    } while (0)
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Multi-state versions of the ASCON permutation for WebAssembly that
+ * use SIMD128 instructions to permute 2 states per vector register. */
+
+/* Permutation calls within the back end are not counted in the statistics */
+#define ASCON_STATS_INTERNAL 1
+
+#include "../ascon-permutation.h"
+#include "ascon-select-backend.h"
+
+#if defined(ASCON_BACKEND_WASM_SIMD)
+
+#include "ascon-vec.h"
+#include <wasm_simd128.h>
+
+/* wasm_v128_andnot() computes "a & ~b" so the arguments are reversed */
+#define ascon_andnot_wasm(a, b) wasm_v128_andnot((b), (a))
+
+/* There is no vector rotate, so compose it from two shifts */
+#define ascon_ror_wasm(x, n) \
+    wasm_v128_or(wasm_u64x2_shr((x), (n)), wasm_i64x2_shl((x), 64 - (n)))
+
+/* Loads word i from two states into a vector */
+#define ascon_load_wasm(s0, s1, i) \
+    wasm_u64x2_make((s0)->S[(i)], (s1)->S[(i)])
+
+/* Stores the lanes of a vector back into word i of two states */
+#define ascon_store_wasm(s0, s1, i, x) \
+    do { \
+        (s0)->S[(i)] = wasm_u64x2_extract_lane((x), 0); \
+        (s1)->S[(i)] = wasm_u64x2_extract_lane((x), 1); \
+    } while (0)
+
+/* Loads a pair of states into the vectors x0, ..., x4, inverting x2 */
+#define ascon_load_pair(s0, s1, x) \
+    do { \
+        x##0 = ascon_load_wasm((s0), (s1), 0); \
+        x##1 = ascon_load_wasm((s0), (s1), 1); \
+        x##2 = wasm_v128_not(ascon_load_wasm((s0), (s1), 2)); \
+        x##3 = ascon_load_wasm((s0), (s1), 3); \
+        x##4 = ascon_load_wasm((s0), (s1), 4); \
+    } while (0)
+
+/* Stores the vectors x0, ..., x4 back into a pair of states */
+#define ascon_store_pair(s0, s1, x) \
+    do { \
+        ascon_store_wasm((s0), (s1), 0, x##0); \
+        ascon_store_wasm((s0), (s1), 1, x##1); \
+        ascon_store_wasm((s0), (s1), 2, wasm_v128_not(x##2)); \
+        ascon_store_wasm((s0), (s1), 3, x##3); \
+        ascon_store_wasm((s0), (s1), 4, x##4); \
+    } while (0)
+
+/* Performs a single round on the vectors x0, ..., x4 */
+#define ascon_round_wasm(x, rc) \
+    ascon_vec_round(v128_t, wasm_v128_xor, ascon_andnot_wasm, \
+                    ascon_ror_wasm, x##0, x##1, x##2, x##3, x##4, (rc))
+
+void ascon_permute_x2
+    (ascon_state_t *state0, ascon_state_t *state1, uint8_t first_round)
+{
+    v128_t a0, a1, a2, a3, a4;
+    v128_t rc;
+    ascon_load_pair(state0, state1, a);
+    while (first_round < 12) {
+        rc = wasm_u64x2_splat(ascon_vec_rc[first_round]);
+        ascon_round_wasm(a, rc);
+        ++first_round;
+    }
+    ascon_store_pair(state0, state1, a);
+}
+
+void ascon_permute_x4
+    (ascon_state_t *state0, ascon_state_t *state1,
+     ascon_state_t *state2, ascon_state_t *state3, uint8_t first_round)
+{
+    /* Two pairs of states are interleaved to hide the latency of the
+     * vector instructions once the runtime has compiled them to native
+     * SSE or NEON code */
+    v128_t a0, a1, a2, a3, a4;
+    v128_t b0, b1, b2, b3, b4;
+    v128_t rc;
+    ascon_load_pair(state0, state1, a);
+    ascon_load_pair(state2, state3, b);
+    while (first_round < 12) {
+        rc = wasm_u64x2_splat(ascon_vec_rc[first_round]);
+        ascon_round_wasm(a, rc);
+        ascon_round_wasm(b, rc);
+        ++first_round;
+    }
+    ascon_store_pair(state0, state1, a);
+    ascon_store_pair(state2, state3, b);
+}
+
+#endif /* ASCON_BACKEND_WASM_SIMD */
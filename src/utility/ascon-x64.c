@@ -0,0 +1,442 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Transposed bitsliced engine for batches of 64 messages at a time on
+ * 64-bit CPUs.  The state holds one word for every bit position of the
+ * five state words, so it is in the standard form of the specification
+ * and the round constants are XOR'ed into the low bit-planes of x2. */
+
+#include "ascon-x64.h"
+#include "ascon-aead-common.h"
+#include "ascon-util.h"
+#include "../ascon-utility.h"
+#include <string.h>
+
+#if defined(ASCON_X64_LANES)
+
+/* Spreads bit b of a word across all lanes of a bit-plane */
+#define ascon_x64_spread(word, b) ((uint64_t)0 - (((word) >> (b)) & 1U))
+
+/* Bit-plane that holds the padding bit for byte "posn" of a word */
+#define ascon_x64_pad_bit(posn) (63U - ((posn) % 8U) * 8U)
+
+/* Linear diffusion layer for word i.  Rotating right by r moves bit
+ * (b + r) % 64 to bit b, so each rotation selects another bit-plane.
+ * The S-box output is stored twice in T so that the indexes do not wrap
+ * around, which lets the compiler vectorize the loop. */
+#define ascon_x64_linear(i, r0, r1) \
+    do { \
+        for (b = 0; b < 64; ++b) { \
+            state->S[(i)][b] = \
+                T[(i)][b] ^ T[(i)][b + (r0)] ^ T[(i)][b + (r1)]; \
+        } \
+    } while (0)
+
+void ascon_x64_permute(ascon_state_x64_t *state, uint8_t first_round)
+{
+    uint64_t T[5][128];
+    uint64_t x0, x1, x2, x3, x4;
+    uint64_t t0, t1, t2, t3, t4;
+    unsigned b, rc;
+    for (; first_round < 12; ++first_round) {
+        /* Add the round constant to the low byte of x2 */
+        rc = ((0x0FU - first_round) << 4) | first_round;
+        for (b = 0; b < 8; ++b)
+            state->S[2][b] ^= ascon_x64_spread(rc, b);
+
+        /* Substitution layer on all messages, one bit position at a time */
+        for (b = 0; b < 64; ++b) {
+            x0 = state->S[0][b];
+            x1 = state->S[1][b];
+            x2 = state->S[2][b];
+            x3 = state->S[3][b];
+            x4 = state->S[4][b];
+            x0 ^= x4;
+            x4 ^= x3;
+            x2 ^= x1;
+            t0 = (~x0) & x1;
+            t1 = (~x1) & x2;
+            t2 = (~x2) & x3;
+            t3 = (~x3) & x4;
+            t4 = (~x4) & x0;
+            x0 ^= t1;
+            x1 ^= t2;
+            x2 ^= t3;
+            x3 ^= t4;
+            x4 ^= t0;
+            x1 ^= x0;
+            x0 ^= x4;
+            x3 ^= x2;
+            T[0][b] = T[0][b + 64] = x0;
+            T[1][b] = T[1][b + 64] = x1;
+            T[2][b] = T[2][b + 64] = ~x2;
+            T[3][b] = T[3][b + 64] = x3;
+            T[4][b] = T[4][b + 64] = x4;
+        }
+
+        /* Linear diffusion layer */
+        ascon_x64_linear(0, 19, 28);
+        ascon_x64_linear(1, 61, 39);
+        ascon_x64_linear(2,  1,  6);
+        ascon_x64_linear(3, 10, 17);
+        ascon_x64_linear(4,  7, 41);
+    }
+}
+
+void ascon_x64_transpose(uint64_t m[64])
+{
+    /* Swap the off-diagonal blocks of 32 x 32 bits, then 16 x 16 bits
+     * within each of the quarters, and so on down to single bits.  The
+     * inner loop runs over consecutive rows so that it vectorizes. */
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    uint64_t t;
+    unsigned j, k, base;
+    for (j = 32; j != 0; j >>= 1, mask ^= (mask << j)) {
+        for (base = 0; base < 64; base += j * 2) {
+            for (k = base; k < (base + j); ++k) {
+                t = ((m[k] >> j) ^ m[k + j]) & mask;
+                m[k] ^= t << j;
+                m[k + j] ^= t;
+            }
+        }
+    }
+}
+
+/**
+ * \brief Loads a big-endian word from up to 8 bytes of data.
+ *
+ * \param data Points to the data.
+ * \param size Number of bytes to load, between 0 and 8.  Missing bytes
+ * at the end of the word are set to zero.
+ *
+ * \return The word.
+ */
+static uint64_t ascon_x64_load_word(const unsigned char *data, unsigned size)
+{
+    uint64_t word = 0;
+    unsigned posn;
+    if (size == 8)
+        return be_load_word64(data);
+    for (posn = 0; posn < size; ++posn)
+        word |= ((uint64_t)(data[posn])) << (56U - posn * 8U);
+    return word;
+}
+
+/**
+ * \brief Stores the first bytes of a big-endian word.
+ *
+ * \param data Points to the buffer to store to.
+ * \param word The word to store.
+ * \param size Number of bytes to store, between 0 and 8.
+ */
+static void ascon_x64_store_word
+    (unsigned char *data, uint64_t word, unsigned size)
+{
+    unsigned posn;
+    if (size == 8) {
+        be_store_word64(data, word);
+        return;
+    }
+    for (posn = 0; posn < size; ++posn)
+        data[posn] = (unsigned char)(word >> (56U - posn * 8U));
+}
+
+/**
+ * \brief Loads a word of data from each message and transposes the
+ * words into bit-planes.
+ *
+ * \param planes Returns the bit-planes.
+ * \param ptrs Points to the messages.
+ * \param offset Offset of the word within each message.
+ * \param size Number of bytes in the word, between 0 and 8.
+ * \param count Number of messages.  The remaining lanes are zero.
+ */
+static void ascon_x64_gather
+    (uint64_t planes[64], const unsigned char * const *ptrs,
+     size_t offset, unsigned size, unsigned count)
+{
+    unsigned j;
+    for (j = 0; j < count; ++j)
+        planes[j] = ascon_x64_load_word(ptrs[j] + offset, size);
+    for (; j < 64; ++j)
+        planes[j] = 0;
+    ascon_x64_transpose(planes);
+}
+
+/**
+ * \brief Transposes bit-planes into words and stores a word into
+ * each message.
+ *
+ * \param planes The bit-planes, which are destroyed.
+ * \param ptrs Points to the messages.
+ * \param offset Offset of the word within each message.
+ * \param size Number of bytes in the word, between 0 and 8.
+ * \param count Number of messages.
+ */
+static void ascon_x64_scatter
+    (uint64_t planes[64], unsigned char * const *ptrs,
+     size_t offset, unsigned size, unsigned count)
+{
+    unsigned j;
+    ascon_x64_transpose(planes);
+    for (j = 0; j < count; ++j)
+        ascon_x64_store_word(ptrs[j] + offset, planes[j], size);
+}
+
+/**
+ * \brief Sets a word of a bitsliced state to the same value in all lanes.
+ *
+ * \param planes The bit-planes of the word.
+ * \param word The value.
+ */
+static void ascon_x64_set_all(uint64_t planes[64], uint64_t word)
+{
+    unsigned b;
+    for (b = 0; b < 64; ++b)
+        planes[b] = ascon_x64_spread(word, b);
+}
+
+/**
+ * \brief XOR's one set of bit-planes into another.
+ *
+ * \param dest The destination bit-planes.
+ * \param src The source bit-planes.
+ */
+static void ascon_x64_xor(uint64_t dest[64], const uint64_t src[64])
+{
+    unsigned b;
+    for (b = 0; b < 64; ++b)
+        dest[b] ^= src[b];
+}
+
+/**
+ * \brief Absorbs up to one rate block from each message into a
+ * bitsliced state.
+ *
+ * \param state The state.
+ * \param ptrs Points to the messages.
+ * \param offset Offset of the block within each message.
+ * \param size Number of bytes to absorb, up to \a rate.
+ * \param rate Number of bytes in the rate, 8 or 16.
+ * \param count Number of messages.
+ */
+static void ascon_x64_absorb
+    (ascon_state_x64_t *state, const unsigned char * const *ptrs,
+     size_t offset, unsigned size, unsigned rate, unsigned count)
+{
+    unsigned word, len;
+    for (word = 0; word * 8U < rate && word * 8U < size; ++word) {
+        len = size - word * 8U;
+        if (len > 8)
+            len = 8;
+        ascon_x64_gather(state->W[0], ptrs, offset + word * 8U, len, count);
+        ascon_x64_xor(state->S[word], state->W[0]);
+    }
+}
+
+/**
+ * \brief Pads a partial block in all lanes of a bitsliced state.
+ *
+ * \param state The state.
+ * \param posn Number of bytes in the partial block.
+ */
+static void ascon_x64_pad(ascon_state_x64_t *state, unsigned posn)
+{
+    uint64_t *plane = &(state->S[posn / 8U][ascon_x64_pad_bit(posn)]);
+    *plane = ~(*plane);
+}
+
+void ascon_x64_hash
+    (unsigned char *out, const unsigned char * const *in, size_t inlen,
+     unsigned count, const uint64_t iv[5], uint8_t first_round)
+{
+    ascon_state_x64_t state;
+    size_t posn = 0;
+    unsigned word, j;
+
+    /* Every lane starts with the same initial state */
+    for (word = 0; word < 5; ++word)
+        ascon_x64_set_all(state.S[word], iv[word]);
+
+    /* Absorb the full blocks and then the padded last block */
+    while ((inlen - posn) >= ASCON_XOF_RATE) {
+        ascon_x64_absorb(&state, in, posn, 8, 8, count);
+        ascon_x64_permute(&state, first_round);
+        posn += ASCON_XOF_RATE;
+    }
+    ascon_x64_absorb(&state, in, posn, (unsigned)(inlen - posn), 8, count);
+    ascon_x64_pad(&state, (unsigned)(inlen - posn));
+    ascon_x64_permute(&state, 0);
+
+    /* Squeeze out the hash values */
+    for (posn = 0; posn < ASCON_HASH_SIZE; posn += ASCON_XOF_RATE) {
+        if (posn > 0)
+            ascon_x64_permute(&state, first_round);
+        memcpy(state.W[0], state.S[0], sizeof(state.W[0]));
+        ascon_x64_transpose(state.W[0]);
+        for (j = 0; j < count; ++j)
+            be_store_word64(out + j * ASCON_HASH_SIZE + posn, state.W[0][j]);
+    }
+    ascon_clean(&state, sizeof(state));
+}
+
+#if ASCON_ENABLE_AEAD
+
+/**
+ * \brief Encrypts or decrypts up to one rate block of each message
+ * with a bitsliced state.
+ *
+ * \param state The state.
+ * \param in Points to the input of each message.
+ * \param out Points to the output of each message.
+ * \param offset Offset of the block within each message.
+ * \param size Number of bytes to process, up to \a rate.
+ * \param rate Number of bytes in the rate, 8 or 16.
+ * \param count Number of messages.
+ * \param decrypt Non-zero for decryption, zero for encryption.
+ */
+static void ascon_x64_crypt
+    (ascon_state_x64_t *state, const unsigned char * const *in,
+     unsigned char * const *out, size_t offset, unsigned size,
+     unsigned rate, unsigned count, int decrypt)
+{
+    uint64_t *data = state->W[0];
+    uint64_t *planes = state->W[1];
+    uint64_t *x;
+    unsigned word, len, b;
+    for (word = 0; word * 8U < rate && word * 8U < size; ++word) {
+        len = size - word * 8U;
+        if (len > 8)
+            len = 8;
+        x = state->S[word];
+        ascon_x64_gather(data, in, offset + word * 8U, len, count);
+        if (decrypt) {
+            /* The plaintext is the state XOR the ciphertext, and the
+             * ciphertext replaces the leading bytes of the state */
+            for (b = 0; b < 64; ++b)
+                planes[b] = x[b] ^ data[b];
+            for (b = 64U - len * 8U; b < 64; ++b)
+                x[b] = data[b];
+        } else {
+            /* The ciphertext is the state after absorbing the plaintext */
+            ascon_x64_xor(x, data);
+            memcpy(planes, x, sizeof(state->W[1]));
+        }
+        ascon_x64_scatter(planes, out, offset + word * 8U, len, count);
+    }
+}
+
+int ascon_x64_aead
+    (ascon_aead_batch_t *msgs, unsigned count, const uint8_t iv[8],
+     unsigned rate, uint8_t first_round, int decrypt)
+{
+    ascon_state_x64_t state;
+    uint64_t key[2][64];
+    uint64_t tag[2][64];
+    const unsigned char *in[ASCON_X64_LANES];
+    unsigned char *out[ASCON_X64_LANES];
+    unsigned char tag_bytes[16];
+    size_t adlen = msgs[0].adlen;
+    size_t len = msgs[0].inlen - (decrypt ? 16 : 0);
+    size_t posn;
+    unsigned j;
+    int result = 0;
+
+    /* Initialize the state with the IV, key, and nonce of each message */
+    ascon_x64_set_all(state.S[0], be_load_word64(iv));
+    for (j = 0; j < count; ++j)
+        in[j] = msgs[j].k;
+    ascon_x64_gather(key[0], in, 0, 8, count);
+    ascon_x64_gather(key[1], in, 8, 8, count);
+    memcpy(state.S[1], key[0], sizeof(key[0]));
+    memcpy(state.S[2], key[1], sizeof(key[1]));
+    for (j = 0; j < count; ++j)
+        in[j] = msgs[j].npub;
+    ascon_x64_gather(state.S[3], in, 0, 8, count);
+    ascon_x64_gather(state.S[4], in, 8, 8, count);
+    ascon_x64_permute(&state, 0);
+    ascon_x64_xor(state.S[3], key[0]);
+    ascon_x64_xor(state.S[4], key[1]);
+
+    /* Absorb the associated data */
+    if (adlen > 0) {
+        for (j = 0; j < count; ++j)
+            in[j] = msgs[j].ad;
+        for (posn = 0; (adlen - posn) >= rate; posn += rate) {
+            ascon_x64_absorb(&state, in, posn, rate, rate, count);
+            ascon_x64_permute(&state, first_round);
+        }
+        ascon_x64_absorb
+            (&state, in, posn, (unsigned)(adlen - posn), rate, count);
+        ascon_x64_pad(&state, (unsigned)(adlen - posn));
+        ascon_x64_permute(&state, first_round);
+    }
+
+    /* Separator between the associated data and the payload */
+    state.S[4][0] = ~(state.S[4][0]);
+
+    /* Encrypt or decrypt the payload */
+    for (j = 0; j < count; ++j) {
+        in[j] = msgs[j].in;
+        out[j] = msgs[j].out;
+    }
+    for (posn = 0; (len - posn) >= rate; posn += rate) {
+        ascon_x64_crypt(&state, in, out, posn, rate, rate, count, decrypt);
+        ascon_x64_permute(&state, first_round);
+    }
+    ascon_x64_crypt
+        (&state, in, out, posn, (unsigned)(len - posn), rate, count, decrypt);
+    ascon_x64_pad(&state, (unsigned)(len - posn));
+
+    /* Finalize and compute the tags */
+    ascon_x64_xor(state.S[rate / 8U], key[0]);
+    ascon_x64_xor(state.S[rate / 8U + 1U], key[1]);
+    ascon_x64_permute(&state, 0);
+    ascon_x64_xor(state.S[3], key[0]);
+    ascon_x64_xor(state.S[4], key[1]);
+    memcpy(tag, state.S[3], sizeof(tag));
+    ascon_x64_transpose(tag[0]);
+    ascon_x64_transpose(tag[1]);
+    for (j = 0; j < count; ++j) {
+        be_store_word64(tag_bytes, tag[0][j]);
+        be_store_word64(tag_bytes + 8, tag[1][j]);
+        if (decrypt) {
+            msgs[j].outlen = len;
+            msgs[j].result = ascon_aead_check_tag
+                (msgs[j].out, len, tag_bytes, msgs[j].in + len, 16);
+            result |= msgs[j].result;
+        } else {
+            memcpy(msgs[j].out + len, tag_bytes, 16);
+            msgs[j].outlen = len + 16;
+            msgs[j].result = 0;
+        }
+    }
+    ascon_clean(&state, sizeof(state));
+    ascon_clean(key, sizeof(key));
+    ascon_clean(tag, sizeof(tag));
+    ascon_clean(tag_bytes, sizeof(tag_bytes));
+    return result;
+}
+
+#endif /* ASCON_ENABLE_AEAD */
+
+#endif /* ASCON_X64_LANES */
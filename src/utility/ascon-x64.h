@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_X64_H
+#define ASCON_X64_H
+
+/* Transposed bitsliced engine that permutes 64 states at once for the
+ * batch API's.  Bit j of every word belongs to message j, so the state
+ * is 320 words: one for each bit position of each of the five words of
+ * the ASCON state.  The S-box becomes plain word operations and the
+ * rotations in the linear layer become a choice of which words to XOR,
+ * which is faster than permuting the states separately once a group is
+ * nearly full on 64-bit CPUs without wide SIMD.  All messages in a group
+ * must have the same length so that they need the same permutations at
+ * the same time. */
+
+#include "ascon-multi.h"
+#include "../ascon-aead.h"
+#include "../ascon-xof.h"
+
+#if defined(ASCON_X64_LANES)
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \def ASCON_X64_MIN_BATCH
+ * \brief Minimum number of uniform-length messages for which the
+ * transposed bitsliced engine is faster than processing the messages
+ * one at a time.
+ *
+ * Every group costs the same as a full group of ASCON_X64_LANES messages.
+ */
+#if !defined(ASCON_X64_MIN_BATCH)
+#define ASCON_X64_MIN_BATCH 56
+#endif
+
+/**
+ * \brief State of the transposed bitsliced engine.
+ *
+ * Bit j of S[i][b] is bit b of word i of the state for message j, where
+ * the words are in the standard big-endian form of the specification.
+ */
+typedef struct
+{
+    uint64_t S[5][64];  /**< Bit-planes for each word of the state */
+    uint64_t W[2][64];  /**< Scratch bit-planes for the message data */
+
+} ascon_state_x64_t;
+
+/**
+ * \brief Permutes all 64 states of a transposed bitsliced state.
+ *
+ * \param state The state to permute.
+ * \param first_round The first round to execute, between 0 and 11.
+ */
+void ascon_x64_permute(ascon_state_x64_t *state, uint8_t first_round);
+
+/**
+ * \brief Transposes a 64 x 64 matrix of bits in place.
+ *
+ * \param m The rows of the matrix.
+ *
+ * On exit, bit j of m[b] is bit b of m[j] on entry.  This converts 64
+ * words, one per message, into 64 bit-planes and vice versa.
+ */
+void ascon_x64_transpose(uint64_t m[64]);
+
+/**
+ * \brief Hashes a group of messages of the same length with the
+ * transposed bitsliced engine.
+ *
+ * \param out Buffer to receive the ASCON_HASH_SIZE byte hash value of
+ * each message in turn.
+ * \param in Points to the messages.
+ * \param inlen Length of every message in bytes.
+ * \param count Number of messages, between 1 and ASCON_X64_LANES.
+ * \param iv Initial state of the hash after the first permutation,
+ * in standard form.
+ * \param first_round First round of the permutation between blocks.
+ */
+void ascon_x64_hash
+    (unsigned char *out, const unsigned char * const *in, size_t inlen,
+     unsigned count, const uint64_t iv[5], uint8_t first_round);
+
+#if ASCON_ENABLE_AEAD
+
+/**
+ * \brief Encrypts or decrypts a group of messages with ASCON-128 or
+ * ASCON-128a using the transposed bitsliced engine.
+ *
+ * \param msgs Points to the messages, which must all have the same
+ * input and associated data lengths.  Decryption inputs must be at
+ * least 16 bytes in length.
+ * \param count Number of messages, between 1 and ASCON_X64_LANES.
+ * \param iv Initialization vector for the algorithm.
+ * \param rate Number of bytes in the rate, 8 or 16.
+ * \param first_round First round of the permutation for each block.
+ * \param decrypt Non-zero for decryption, zero for encryption.
+ *
+ * \return 0 if all messages were processed successfully, or -1 if
+ * the tag of at least one message failed to verify.
+ */
+int ascon_x64_aead
+    (ascon_aead_batch_t *msgs, unsigned count, const uint8_t iv[8],
+     unsigned rate, uint8_t first_round, int decrypt);
+
+#endif /* ASCON_ENABLE_AEAD */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASCON_X64_LANES */
+
+#endif